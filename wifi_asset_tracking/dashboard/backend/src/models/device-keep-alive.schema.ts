@@ -11,6 +11,14 @@ export class KeepAlive {
   @Prop()
   interval: number[];
 
+  // Device clock offset and uncertainty in ms, RTC drift in ppm
+  @Prop({ type: Object })
+  clock: { offset: number; uncertainty: number; drift: number };
+
+  // Set from IoT Hub connection state events, unset when they are not routed
+  @Prop({ type: Boolean })
+  connected: boolean;
+
   @Prop({ type: Date, default: Date.now() })
   createdAt: Date;
 
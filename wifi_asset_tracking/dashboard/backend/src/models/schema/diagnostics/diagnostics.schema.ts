@@ -0,0 +1,21 @@
+import { Prop, Schema, SchemaFactory } from '@nestjs/mongoose';
+
+export type DiagnosticsSchema = Diagnostics & Document;
+
+@Schema()
+export class Diagnostics {
+  @Prop({ required: true })
+  timestamp: Date;
+
+  @Prop({ required: true })
+  version: number;
+
+  // Index of the first metric of this part in the firmware snapshot
+  @Prop({ required: true })
+  first: number;
+
+  @Prop({ type: Map, of: Number, required: true })
+  metrics: Map<string, number>;
+}
+
+export const DiagnosticsSchema = SchemaFactory.createForClass(Diagnostics);
@@ -0,0 +1,24 @@
+import { Prop, Schema, SchemaFactory } from '@nestjs/mongoose';
+
+export type LinkSchema = Link & Document;
+
+@Schema()
+export class Link {
+  @Prop({ required: true })
+  timestamp: Date;
+
+  @Prop({ required: true })
+  state: string;
+
+  // Mean of the device RSSI window, absent when no sample was taken
+  @Prop()
+  rssi: number;
+
+  @Prop({ required: true })
+  downtime: number;
+
+  @Prop({ required: true })
+  losses: number;
+}
+
+export const LinkSchema = SchemaFactory.createForClass(Link);
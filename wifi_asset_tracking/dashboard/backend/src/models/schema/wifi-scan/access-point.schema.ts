@@ -0,0 +1,17 @@
+import { Prop, Schema, SchemaFactory } from '@nestjs/mongoose';
+
+export type AccessPointSchema = AccessPoint & Document;
+
+@Schema({ _id: false })
+export class AccessPoint {
+  @Prop({ required: true })
+  bssid: string;
+
+  @Prop({ required: true })
+  rssi: number;
+
+  @Prop({ required: true })
+  channel: number;
+}
+
+export const AccessPointSchema = SchemaFactory.createForClass(AccessPoint);
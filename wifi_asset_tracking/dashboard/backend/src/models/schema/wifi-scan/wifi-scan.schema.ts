@@ -0,0 +1,16 @@
+import { Prop, Schema, SchemaFactory } from '@nestjs/mongoose';
+import { AccessPoint, AccessPointSchema } from './access-point.schema';
+
+export type WifiScanSchema = WifiScan & Document;
+
+@Schema()
+export class WifiScan {
+  @Prop({ required: true })
+  timestamp: Date;
+
+  // Sent instead of a position when GNSS has no fix, strongest first
+  @Prop({ type: [AccessPointSchema], required: true })
+  accessPoints: AccessPoint[];
+}
+
+export const WifiScanSchema = SchemaFactory.createForClass(WifiScan);
@@ -2,6 +2,9 @@ import { Prop, Schema, SchemaFactory } from '@nestjs/mongoose';
 import { Document } from 'mongoose';
 import { Heat } from './schema/heat/heat.schema';
 import { Wifi } from './schema/wifi/wifi.schema';
+import { WifiScan } from './schema/wifi-scan/wifi-scan.schema';
+import { Link } from './schema/link/link.schema';
+import { Diagnostics } from './schema/diagnostics/diagnostics.schema';
 import { Gps } from './schema/gps/gps.schema';
 import { AccelGyroData } from './schema/AccelGyroData/accel-gyro-data.schema';
 import { HydratedDocument } from 'mongoose';
@@ -10,6 +13,9 @@ export enum SENSOR_TYPE {
   heat = 'heat',
   gps = 'gps',
   wifi = 'wifi',
+  wifiscan = 'wifiscan',
+  link = 'link',
+  diag = 'diag',
   imu = 'imu',
   temperature = 'temperature',
   humidity = 'humidity',
@@ -24,6 +30,15 @@ export class Telemetry {
   @Prop({ type: Wifi })
   wifi: Wifi;
 
+  @Prop({ type: WifiScan })
+  wifiScan: WifiScan;
+
+  @Prop({ type: Link })
+  link: Link;
+
+  @Prop({ type: Diagnostics })
+  diagnostics: Diagnostics;
+
   @Prop({ type: Gps })
   gps: Gps;
 
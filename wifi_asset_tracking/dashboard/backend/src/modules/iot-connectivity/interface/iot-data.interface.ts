@@ -1,3 +1,6 @@
+import { IWifiScanAccessPoint } from '../../../utilities/common/wifi-scan-decoder';
+import { IDiagnosticsPart } from '../../../utilities/common/diagnostics-decoder';
+
 interface IBody {
   temperature: number;
 }
@@ -41,6 +44,20 @@ export interface IDeviceData {
     ssid: string;
     'signal-strength': number;
   };
+  wifiScan?: {
+    timestamp: Date;
+    accessPoints: IWifiScanAccessPoint[];
+  };
+  link?: {
+    timestamp: Date;
+    state: string;
+    rssi?: number;
+    downtime: number;
+    losses: number;
+  };
+  diagnostics?: IDiagnosticsPart & {
+    timestamp: Date;
+  };
   heat?: {
     temperature: {
       value: number;
@@ -66,4 +83,9 @@ export interface IDeviceData {
     imu: number;
     gps: number;
   };
+  clockData?: {
+    offset: number;
+    uncertainty: number;
+    drift: number;
+  };
 }
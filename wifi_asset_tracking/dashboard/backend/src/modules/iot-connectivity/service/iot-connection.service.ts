@@ -18,6 +18,9 @@ import { IDeviceData } from '../interface/iot-data.interface';
 import { EventEmitter2 } from '@nestjs/event-emitter';
 import { Cron } from '@nestjs/schedule';
 import { getTimeDifference, millisToSeconds } from '../../../utilities/common/helper';
+import { decodeTelemetryBody } from '../../../utilities/common/telemetry-decompressor';
+import { decodeWifiScan } from '../../../utilities/common/wifi-scan-decoder';
+import { decodeDiagnostics } from '../../../utilities/common/diagnostics-decoder';
 import { SensorTimestamp, SensorTimestampSchema } from '../../../models/device-sensor-timestamp.schema';
 import { Messages, Time } from '../../../utilities/constants';
 const { ContainerClient } = require('@azure/storage-blob');
@@ -75,7 +78,7 @@ export class IoTService {
 
   @Cron('*/01 * * * * *') //running every 01 sec
   async handleCron() {
-    //disconnect when no message received from deive from past 30 sec
+    //disconnect when the device presence is lost
     await this.checkDeviceKeepAlive();
 
     //Destroy all the prev session after the 3 minutes of session ended
@@ -222,8 +225,31 @@ export class IoTService {
   }
 
   async resetInterval() {
+    // Sampling intervals are device state and only change with a device heartbeat
     await this.sensorTimestampModel.deleteOne();
-    await this.KeepAliveModel.findOneAndUpdate({ $set: { interval: [] } });
+  }
+
+  async updateDevicePresence(connected: boolean): Promise<void> {
+    await this.KeepAliveModel.findOneAndUpdate(
+      {},
+      { $set: { connected, updatedAt: new Date() } },
+      {
+        upsert: true,
+      },
+    );
+    await this.sensorTimestampModel.findOneAndUpdate(
+      {},
+      {
+        $set: { 'status.device': connected },
+      },
+      {
+        upsert: true,
+      },
+    );
+
+    if (!connected) {
+      this.eventEmitter.emit('onConnectDisconnect', { type: 'deviceDisconnected' });
+    }
   }
 
   subscribeEvent() {
@@ -247,6 +273,15 @@ export class IoTService {
               return;
             }
 
+            //Device presence follows the MQTT keep-alive through IoT Hub connection state events
+            if (systemProperties?.['iothub-message-source'] === 'deviceConnectionStateEvents') {
+              if (systemProperties?.['iothub-connection-device-id'] === deviceConfig.DEFAULT_DEVICE_ID) {
+                await this.updateDevicePresence(events[0]?.properties?.opType === 'deviceConnected');
+              }
+              await context.updateCheckpoint(events[events.length - 1]);
+              return;
+            }
+
             let isSessionActive = await this.getCurrentSession();
             this.logger.log('isSessionActive', isSessionActive);
             if (!isSessionActive) return;
@@ -269,7 +304,7 @@ export class IoTService {
               return;
             }
 
-            const body: Partial<IDeviceData> = events[0]?.body;
+            const body: Partial<IDeviceData> = decodeTelemetryBody(events[0]?.body);
 
             // console.log('body==========', body);
             //Check if session is active
@@ -303,7 +338,12 @@ export class IoTService {
                     await this.setupInitialListenerTime();
                     await this.KeepAliveModel.findOneAndUpdate(
                       { deviceId: deviceData.deviceId },
-                      { $set: { interval: payload?.intervalData } },
+                      {
+                        $set: {
+                          interval: payload?.intervalData,
+                          ...(payload?.clockData && { clock: payload.clockData }),
+                        },
+                      },
                     );
                   } else {
                     await this.updateLatestSensorData(payload, deviceData.deviceId);
@@ -428,10 +468,14 @@ export class IoTService {
 
       let diffInSec = millisToSeconds(timeDiff);
       // this.logger.log('diffInSec', diffInSec);
-      //Destroy session when no message received from last 30 sec
+      //Connection state events decide when they are routed, otherwise the device
+      //is lost when neither telemetry nor heartbeat arrived for the presence timeout
+      if (lastmessage.connected !== undefined && lastmessage.connected !== null) {
+        return false;
+      }
       const sensorTimestampData = await this.sensorTimestampModel.findOne();
       const sensorStatus = sensorTimestampData?.status;
-      if (Number(diffInSec) > 30 && sensorStatus?.device) {
+      if (Number(diffInSec) > Time.devicePresenceTimeoutInSeconds && sensorStatus?.device) {
         let payload = {
           type: 'deviceDisconnected',
         };
@@ -557,6 +601,30 @@ export class IoTService {
         payload.type = data.msgtype;
         break;
 
+      case 'wifiscan':
+        payload.wifiScan = {
+          accessPoints: decodeWifiScan(data[data.msgtype]),
+          timestamp: new Date(data.timestamp),
+        };
+        payload.type = data.msgtype;
+        break;
+
+      case 'link':
+        payload.link = {
+          ...data[data.msgtype],
+          timestamp: new Date(data.timestamp),
+        };
+        payload.type = data.msgtype;
+        break;
+
+      case 'diag':
+        payload.diagnostics = {
+          ...decodeDiagnostics(data[data.msgtype]),
+          timestamp: new Date(data.timestamp),
+        };
+        payload.type = data.msgtype;
+        break;
+
       case 'keep-alive':
         const { wifiSamplingInterval, heatSamplingInterval, imuSamplingInterval, gpsSamplingInterval } = Time;
         payload.intervalData = {
@@ -565,6 +633,10 @@ export class IoTService {
           imu: data.interval[2] * imuSamplingInterval,
           gps: data.interval[3] * gpsSamplingInterval,
         };
+        // Time quality is only sent once the device clock follows network time
+        if (data.clock) {
+          payload.clockData = { ...data.clock };
+        }
         payload.type = data.msgtype;
         break;
     }
@@ -154,6 +154,47 @@ describe('IoTService', () => {
       expect(result.wifi['timestamp']).toBeInstanceOf(Date);
     });
 
+    it('should parse "wifiscan" data correctly', () => {
+      const data = {
+        msgtype: 'wifiscan',
+        timestamp: new Date().toISOString(),
+        wifiscan: 'AQEAG2MAAAHYCw==',
+      };
+      const result = service.parseIoTData(data);
+      expect(result.type).toBe('wifiscan');
+      expect(result.wifiScan.accessPoints).toEqual([{ bssid: '00:1B:63:00:00:01', rssi: -40, channel: 11 }]);
+      expect(result.wifiScan.timestamp).toBeInstanceOf(Date);
+    });
+
+    it('should parse "link" data correctly', () => {
+      const data = {
+        msgtype: 'link',
+        timestamp: new Date().toISOString(),
+        link: { state: 'up', rssi: -58, downtime: 4200, losses: 1 },
+      };
+      const result = service.parseIoTData(data);
+      expect(result.type).toBe('link');
+      expect(result.link.state).toBe('up');
+      expect(result.link.rssi).toBe(-58);
+      expect(result.link.downtime).toBe(4200);
+      expect(result.link.losses).toBe(1);
+      expect(result.link.timestamp).toBeInstanceOf(Date);
+    });
+
+    it('should parse "diag" data correctly', () => {
+      const data = {
+        msgtype: 'diag',
+        timestamp: new Date().toISOString(),
+        diag: { version: 4, first: 13, values: [3600, 1, 4, 0, 2, 41000, 38000, 180] },
+      };
+      const result = service.parseIoTData(data);
+      expect(result.type).toBe('diag');
+      expect(result.diagnostics.first).toBe(13);
+      expect(result.diagnostics.metrics.uptime).toBe(3600);
+      expect(result.diagnostics.metrics.minStack).toBe(180);
+      expect(result.diagnostics.timestamp).toBeInstanceOf(Date);
+    });
+
     it('should parse "imu" data correctly', () => {
       const data = {
         msgtype: 'imu',
@@ -182,6 +223,19 @@ describe('IoTService', () => {
       expect(result?.intervalData?.heat).toEqual(data.interval[1] * Time.heatSamplingInterval);
       expect(result?.intervalData?.imu).toEqual(data.interval[2] * Time.imuSamplingInterval);
       expect(result?.intervalData?.gps).toEqual(data.interval[3] * Time.gpsSamplingInterval);
+      expect(result.clockData).toBeUndefined();
+    });
+
+    it('should parse time quality of "keep-alive" data', () => {
+      const data = {
+        msgtype: 'keep-alive',
+        timestamp: new Date().toISOString(),
+        interval: [1, 2, 3, 4],
+        clock: { offset: -12, uncertainty: 35, drift: 41.25 },
+      };
+      const result = service.parseIoTData(data);
+
+      expect(result.clockData).toEqual({ offset: -12, uncertainty: 35, drift: 41.25 });
     });
 
     it('should handle unknown message types gracefully', () => {
@@ -195,18 +249,20 @@ describe('IoTService', () => {
   });
 
   describe('checkDeviceKeepAlive', () => {
-    it('should not destroy session if last message is within 30 seconds', async () => {
+    const presenceTimeout = Time.devicePresenceTimeoutInSeconds * 1000;
+
+    it('should not destroy session if last message is within the presence timeout', async () => {
       const now = new Date();
-      mockKeepAliveModel.findOne.mockResolvedValueOnce({ updatedAt: new Date(now.getTime() - 29000) });
+      mockKeepAliveModel.findOne.mockResolvedValueOnce({ updatedAt: new Date(now.getTime() - presenceTimeout + 1000) });
 
       const destroyUserSessionSpy = jest.spyOn(service, 'destroyUserSession');
       await service.checkDeviceKeepAlive();
       expect(destroyUserSessionSpy).not.toHaveBeenCalled();
     });
 
-    it('should destroy session if last message is older than 30 seconds', async () => {
+    it('should destroy session if last message is older than the presence timeout', async () => {
       const now = new Date();
-      mockKeepAliveModel.findOne.mockResolvedValueOnce({ updatedAt: new Date(now.getTime() - 31000) });
+      mockKeepAliveModel.findOne.mockResolvedValueOnce({ updatedAt: new Date(now.getTime() - presenceTimeout - 1000) });
       mockSensorTimestampModel.findOne.mockResolvedValueOnce({ status: { device: true } });
 
       const destroyUserSessionSpy = jest.spyOn(service, 'destroyUserSession');
@@ -214,6 +270,18 @@ describe('IoTService', () => {
       expect(mockSensorTimestampModel.findOneAndUpdate).toHaveBeenCalled();
     });
 
+    it('should keep presence from connection state events regardless of silence', async () => {
+      const now = new Date();
+      mockKeepAliveModel.findOne.mockResolvedValueOnce({
+        connected: true,
+        updatedAt: new Date(now.getTime() - presenceTimeout - 1000),
+      });
+
+      const result = await service.checkDeviceKeepAlive();
+      expect(result).toBe(false);
+      expect(mockSensorTimestampModel.findOne).not.toHaveBeenCalled();
+    });
+
     it('should not attempt to destroy session if no keep-alive message is found', async () => {
       mockKeepAliveModel.findOne.mockResolvedValueOnce(null);
 
@@ -355,11 +423,34 @@ describe('IoTService', () => {
   });
 
   describe('resetInterval', () => {
-    it('should delete sensorTimstamp data and reset interval in keepAlive', async () => {
+    it('should delete sensorTimstamp data and keep the device intervals', async () => {
       await service.resetInterval();
 
       expect(mockSensorTimestampModel.deleteOne).toHaveBeenCalled();
-      expect(mockKeepAliveModel.findOneAndUpdate).toHaveBeenCalledWith({ $set: { interval: [] } });
+      expect(mockKeepAliveModel.findOneAndUpdate).not.toHaveBeenCalled();
+    });
+  });
+
+  describe('updateDevicePresence', () => {
+    it('should mark the device connected', async () => {
+      await service.updateDevicePresence(true);
+
+      expect(mockKeepAliveModel.findOneAndUpdate).toHaveBeenCalledWith(
+        {},
+        { $set: { connected: true, updatedAt: expect.any(Date) } },
+        { upsert: true },
+      );
+      expect(mockSensorTimestampModel.findOneAndUpdate).toHaveBeenCalledWith(
+        {},
+        { $set: { 'status.device': true } },
+        { upsert: true },
+      );
+    });
+
+    it('should notify the dashboard when the device disconnects', async () => {
+      await service.updateDevicePresence(false);
+
+      expect(mockEventEmitter.emit).toHaveBeenCalledWith('onConnectDisconnect', { type: 'deviceDisconnected' });
     });
   });
 
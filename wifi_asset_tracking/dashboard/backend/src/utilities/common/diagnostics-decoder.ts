@@ -0,0 +1,42 @@
+import { Diagnostics } from '../constants/diagnostics.constant';
+
+export interface IDiagnosticsPart {
+  version: number;
+  first: number;
+  metrics: Record<string, number>;
+}
+
+// Metric names in firmware snapshot order, histogram buckets as name_le<bound> and name_gt<bound>
+const metricNames = (): { name: string; signed: boolean }[] => [
+  ...Diagnostics.counters.map((name) => ({ name, signed: false })),
+  ...Diagnostics.gauges.map((name) => ({ name, signed: true })),
+  ...Diagnostics.histograms.flatMap(({ name, bounds }) => [
+    ...bounds.map((bound) => ({ name: `${name}_le${bound}`, signed: false })),
+    { name: `${name}_gt${bounds[bounds.length - 1]}`, signed: false },
+  ]),
+];
+
+// Values of one "diag" message, a snapshot is split over messages with the same timestamp
+export const decodeDiagnostics = (diag: { version: number; first: number; values: number[] }): IDiagnosticsPart => {
+  const names = metricNames();
+
+  if (
+    !diag ||
+    diag.version !== Diagnostics.schemaVersion ||
+    !Number.isInteger(diag.first) ||
+    !Array.isArray(diag.values) ||
+    diag.first < 0 ||
+    diag.first + diag.values.length > names.length
+  ) {
+    throw new Error('Unsupported diagnostics');
+  }
+
+  const metrics: Record<string, number> = {};
+  diag.values.forEach((value, index) => {
+    const { name, signed } = names[diag.first + index];
+    // Firmware sends every value as int32, counters past INT32_MAX come back unsigned
+    metrics[name] = signed ? value : value >>> 0;
+  });
+
+  return { version: diag.version, first: diag.first, metrics };
+};
@@ -0,0 +1,71 @@
+import { Compression } from '../constants/compression.constant';
+
+// Telemetry compressed by the firmware starts with the magic byte, which can
+// never start a JSON document, followed by the format version
+export const isCompressedTelemetry = (body: unknown): body is Uint8Array => {
+  return (
+    body instanceof Uint8Array &&
+    body.length > Compression.headerSize &&
+    body[0] === Compression.magic &&
+    body[1] === Compression.formatVersion
+  );
+};
+
+export const decompressTelemetry = (input: Uint8Array): Buffer => {
+  const { dictionary, headerSize, minMatch, offsetBits } = Compression;
+  const lengthMask = (1 << (16 - offsetBits)) - 1;
+  const output: number[] = [];
+  let flags = 0;
+  let itemCount = 8;
+  let index = headerSize;
+
+  if (!isCompressedTelemetry(input)) {
+    throw new Error('Not a compressed telemetry message');
+  }
+
+  while (index < input.length) {
+    if (itemCount === 8) {
+      flags = input[index++];
+      itemCount = 0;
+      continue;
+    }
+
+    if (flags & (1 << itemCount)) {
+      if (index + 2 > input.length) {
+        throw new Error('Truncated back reference in compressed telemetry');
+      }
+      const reference = (input[index] << 8) | input[index + 1];
+      const distance = (reference >> (16 - offsetBits)) + 1;
+      let length = (reference & lengthMask) + minMatch;
+      index += 2;
+
+      if (distance > output.length + dictionary.length) {
+        throw new Error('Back reference out of range in compressed telemetry');
+      }
+
+      // Byte by byte, the copy may overlap its own output or start in the dictionary
+      while (length--) {
+        output.push(
+          distance > output.length
+            ? dictionary[dictionary.length - (distance - output.length)]
+            : output[output.length - distance],
+        );
+      }
+    } else {
+      output.push(input[index++]);
+    }
+
+    itemCount++;
+  }
+
+  return Buffer.from(output);
+};
+
+// Returns the JSON body of a device message, compressed or not
+export const decodeTelemetryBody = <T>(body: T | Uint8Array): T => {
+  if (!isCompressedTelemetry(body)) {
+    return body as T;
+  }
+
+  return JSON.parse(decompressTelemetry(body).toString('utf8'));
+};
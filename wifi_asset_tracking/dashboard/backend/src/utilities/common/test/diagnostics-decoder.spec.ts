@@ -0,0 +1,57 @@
+import { decodeDiagnostics } from '../diagnostics-decoder';
+
+describe('Diagnostics decoder', () => {
+  it('names counters from the first value', () => {
+    const part = decodeDiagnostics({ version: 4, first: 0, values: [120, 2, 0, 118, 0, 3, 115, 1] });
+    expect(part.first).toBe(0);
+    expect(part.metrics.sensorSamples).toBe(120);
+    expect(part.metrics.sensorQueueDrops).toBe(2);
+    expect(part.metrics.published).toBe(115);
+    expect(part.metrics.publishFailures).toBe(1);
+  });
+
+  it('keeps gauges signed and restores unsigned counters', () => {
+    const part = decodeDiagnostics({ version: 4, first: 8, values: [-1, 2, 3, 4, 1, 3600, 0, 4] });
+    expect(part.metrics.publishThrottled).toBe(4294967295);
+    expect(part.metrics.recoveryAttempts).toBe(4);
+    expect(part.metrics.recoveryFailures).toBe(1);
+    expect(part.metrics.uptime).toBe(3600);
+    expect(part.metrics.sensorQueuePeak).toBe(4);
+
+    const rssi = decodeDiagnostics({ version: 4, first: 21, values: [-61, 1, 2, 5, 1, 30000] });
+    expect(rssi.metrics.rssi).toBe(-61);
+    expect(rssi.metrics.supervisorRestarts).toBe(1);
+    expect(rssi.metrics.resetReason).toBe(2);
+    expect(rssi.metrics.resetTask).toBe(5);
+    expect(rssi.metrics.recoveryPending).toBe(1);
+    expect(rssi.metrics.recoveryBackoff).toBe(30000);
+  });
+
+  it('names histogram buckets by bound', () => {
+    const part = decodeDiagnostics({ version: 4, first: 27, values: [5, 9, 1, 0, 0, 2, 40, 3, 0, 0, 0, 0] });
+    expect(part.metrics.publishLatency_le100).toBe(5);
+    expect(part.metrics.publishLatency_gt15000).toBe(2);
+    expect(part.metrics.publishTime_le10).toBe(40);
+    expect(Object.keys(part.metrics)).toHaveLength(12);
+  });
+
+  it('names sample latency buckets', () => {
+    const part = decodeDiagnostics({ version: 4, first: 39, values: [7, 1, 0, 0, 0, 0, 0, 3, 4, 0, 0, 1] });
+    expect(part.metrics.sampleHandoff_le10).toBe(7);
+    expect(part.metrics.sampleLatency_le500).toBe(3);
+    expect(part.metrics.sampleLatency_gt15000).toBe(1);
+  });
+
+  it('names recovery time buckets', () => {
+    const part = decodeDiagnostics({ version: 4, first: 51, values: [0, 2, 1, 0, 0, 0] });
+    expect(part.metrics.recoveryTime_le5000).toBe(2);
+    expect(part.metrics.recoveryTime_le30000).toBe(1);
+    expect(part.metrics.recoveryTime_gt600000).toBe(0);
+  });
+
+  it('rejects an unknown schema version or out of range values', () => {
+    expect(() => decodeDiagnostics({ version: 3, first: 0, values: [1] })).toThrow();
+    expect(() => decodeDiagnostics({ version: 4, first: 55, values: [1, 2, 3] })).toThrow();
+    expect(() => decodeDiagnostics({ version: 4, first: -1, values: [1] })).toThrow();
+  });
+});
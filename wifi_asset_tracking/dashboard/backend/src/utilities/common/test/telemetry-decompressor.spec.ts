@@ -0,0 +1,54 @@
+import { Compression } from '../../constants';
+import { decodeTelemetryBody, decompressTelemetry, isCompressedTelemetry } from '../telemetry-decompressor';
+
+// Produced by sl_compress_message of the firmware
+const vectors = [
+  {
+    compressed:
+      'f50103073f073f30352d3134540031303a32313a3037302e313235073f073d3234182e3331074f074334312e0030327d7d',
+    message:
+      '{"msgtype":"heat","timestamp":"2024-05-14T10:21:07.125Z","heat":{"temperature":{"value":24.31,"unit":"C"},"humidity":41.02}}',
+  },
+  {
+    compressed:
+      'f50103173f073f30352d3134540031303a32313a3037302e313235073118bd4134003a32423a42303a4324313a02b0354518b76f6680666963652d617019470034377d7d',
+    message:
+      '{"msgtype":"wifi","timestamp":"2024-05-14T10:21:07.125Z","wifi":{"macid":"A4:2B:B0:C1:10:5E","ssid":"office-ap","rssi":-47}}',
+  },
+  {
+    compressed:
+      'f501030b7f072f352d3134543180303a32313a303807208e3207210cf80860312c2d005040322c302e39380d0730482e33300181313001803000355d7d',
+    message:
+      '{"msgtype":"imu","timestamp":"2024-05-14T10:21:08.002Z","accelero":[0.01,-0.02,0.98],"gyro":[0.30,-0.10,0.05]}',
+  },
+  {
+    compressed: 'f5010311cf072f352d3134543100303a32313a30392e7e350723134f134f134f134b01117d007d',
+    message:
+      '{"msgtype":"gps","timestamp":"2024-05-14T10:21:09.500Z","gps":{"latitude":null,"longitude":null,"altitude":null,"satellites":null}}',
+  },
+];
+
+describe('telemetry decompressor', () => {
+  it('keeps the firmware dictionary size', () => {
+    expect(Compression.dictionary.length).toBe(514);
+  });
+
+  it.each(vectors)('restores $message', ({ compressed, message }) => {
+    expect(decompressTelemetry(Buffer.from(compressed, 'hex')).toString('utf8')).toBe(message);
+  });
+
+  it('parses a compressed body', () => {
+    const body = decodeTelemetryBody(Buffer.from(vectors[0].compressed, 'hex'));
+    expect(body).toEqual(JSON.parse(vectors[0].message));
+  });
+
+  it('returns an uncompressed body unchanged', () => {
+    const body = { msgtype: 'keep-alive', 'keep-alive': 'yes' };
+    expect(decodeTelemetryBody(body)).toBe(body);
+    expect(isCompressedTelemetry(Buffer.from(JSON.stringify(body)))).toBe(false);
+  });
+
+  it('rejects a back reference out of range', () => {
+    expect(() => decompressTelemetry(Buffer.from('f50101ffff', 'hex'))).toThrow();
+  });
+});
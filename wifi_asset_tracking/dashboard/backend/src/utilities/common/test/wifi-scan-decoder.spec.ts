@@ -0,0 +1,24 @@
+import { decodeWifiScan } from '../wifi-scan-decoder';
+
+// Produced by sl_wifi_fingerprint_encode of the firmware
+const sixAccessPoints = 'AQYAG2MC/Q3hBQAbYwLuBuACABtjAEXr1wIAG2MAFNzVAwAbYwK81dQHABtjAH4F0Aw=';
+
+describe('Wi-Fi scan decoder', () => {
+  it('restores access points strongest first', () => {
+    const accessPoints = decodeWifiScan(sixAccessPoints);
+    expect(accessPoints).toHaveLength(6);
+    expect(accessPoints[0]).toEqual({ bssid: '00:1B:63:02:FD:0D', rssi: -31, channel: 5 });
+    expect(accessPoints[5]).toEqual({ bssid: '00:1B:63:00:7E:05', rssi: -48, channel: 12 });
+  });
+
+  it('rejects an unknown format version', () => {
+    const binary = Buffer.from(sixAccessPoints, 'base64');
+    binary[0] = 0x02;
+    expect(() => decodeWifiScan(binary.toString('base64'))).toThrow();
+  });
+
+  it('rejects a truncated scan', () => {
+    expect(() => decodeWifiScan(Buffer.from(sixAccessPoints, 'base64').subarray(0, 40).toString('base64'))).toThrow();
+    expect(() => decodeWifiScan('not base64!')).toThrow();
+  });
+});
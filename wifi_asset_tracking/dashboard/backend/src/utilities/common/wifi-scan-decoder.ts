@@ -0,0 +1,42 @@
+import { WifiScan } from '../constants/wifi-scan.constant';
+
+export interface IWifiScanAccessPoint {
+  bssid: string;
+  rssi: number;
+  channel: number;
+}
+
+// Access points of a "wifiscan" message, strongest first as selected by the firmware
+export const decodeWifiScan = (text: string): IWifiScanAccessPoint[] => {
+  const { bssidSize, entrySize, formatVersion, headerSize, maxAccessPoints } = WifiScan;
+
+  if (typeof text !== 'string' || !/^[A-Za-z0-9+/]+={0,2}$/.test(text) || text.length % 4 !== 0) {
+    throw new Error('Malformed Wi-Fi scan');
+  }
+
+  const binary = Buffer.from(text, 'base64');
+  const count = binary[1];
+
+  if (
+    binary.length < headerSize ||
+    binary[0] !== formatVersion ||
+    count === 0 ||
+    count > maxAccessPoints ||
+    binary.length !== headerSize + count * entrySize
+  ) {
+    throw new Error('Unsupported Wi-Fi scan');
+  }
+
+  const accessPoints: IWifiScanAccessPoint[] = [];
+  for (let offset = headerSize; offset < binary.length; offset += entrySize) {
+    accessPoints.push({
+      bssid: Array.from(binary.subarray(offset, offset + bssidSize), (octet) =>
+        octet.toString(16).padStart(2, '0').toUpperCase(),
+      ).join(':'),
+      rssi: binary.readInt8(offset + bssidSize),
+      channel: binary[offset + bssidSize + 1],
+    });
+  }
+
+  return accessPoints;
+};
@@ -0,0 +1,24 @@
+// Must match sl_wifi_asset_tracking_compress.c of the firmware byte for byte,
+// a change there comes with a new formatVersion
+const dictionary =
+  '{"msgtype":"session","session":"new"}' +
+  '{"msgtype":"keep-alive","timestamp":"2024-01-01T00:00:00.000Z",' +
+  '"keep-alive":"yes","interval":[60,5,1,60]}' +
+  '{"msgtype":"wifi","timestamp":"","wifi":{"macid":' +
+  '"00:00:00:00:00:00","ssid":"","rssi":-' +
+  '{"msgtype":"gps","timestamp":"","gps":{"latitude":null,' +
+  '"longitude":null,"altitude":null,"satellites":' +
+  '{"msgtype":"imu","timestamp":"","accelero":[null,null,null],' +
+  '"gyro":[' +
+  '{"msgtype":"heat","timestamp":"2024-01-01T00:00:00.000Z",' +
+  '"heat":{"temperature":{"value":null,"unit":"C"},"humidity":';
+
+export const Compression = {
+  contentEncoding: 'sl-lz77',
+  magic: 0xf5,
+  formatVersion: 0x01,
+  headerSize: 2,
+  minMatch: 3,
+  offsetBits: 12,
+  dictionary: Buffer.from(dictionary, 'latin1'),
+};
@@ -0,0 +1,44 @@
+// Must match the metric enums of sl_wifi_asset_tracking_metrics.h of the
+// firmware, a change there comes with a new schemaVersion
+export const Diagnostics = {
+  schemaVersion: 4,
+  counters: [
+    'sensorSamples',
+    'sensorQueueDrops',
+    'sensorReadFailures',
+    'jsonMessages',
+    'jsonFailures',
+    'laneDrops',
+    'published',
+    'publishFailures',
+    'publishThrottled',
+    'wifiConnects',
+    'cloudConnects',
+    'recoveryAttempts',
+    'recoveryFailures',
+  ],
+  gauges: [
+    'uptime',
+    'sensorQueueDepth',
+    'sensorQueuePeak',
+    'laneDepth',
+    'lanePeak',
+    'freeHeap',
+    'minFreeHeap',
+    'minStack',
+    'rssi',
+    'supervisorRestarts',
+    'resetReason',
+    'resetTask',
+    'recoveryPending',
+    'recoveryBackoff',
+  ],
+  // Upper bounds in ms of all buckets but the last one
+  histograms: [
+    { name: 'publishLatency', bounds: [100, 500, 1000, 5000, 15000] },
+    { name: 'publishTime', bounds: [10, 50, 100, 250, 1000] },
+    { name: 'sampleHandoff', bounds: [10, 50, 100, 500, 1000] },
+    { name: 'sampleLatency', bounds: [100, 500, 1000, 5000, 15000] },
+    { name: 'recoveryTime', bounds: [1000, 5000, 30000, 120000, 600000] },
+  ],
+};
@@ -1,7 +1,10 @@
 import { Azure } from './azure.constant';
+import { Compression } from './compression.constant';
+import { Diagnostics } from './diagnostics.constant';
 import { Messages } from './messages.constant';
 import { LoggerTransports } from './logger.transport.constant';
 import deviceConfig from './device-config';
 import { Time } from './time.constants';
+import { WifiScan } from './wifi-scan.constant';
 
-export { Azure, LoggerTransports, Messages, Time, deviceConfig };
+export { Azure, Compression, Diagnostics, LoggerTransports, Messages, Time, WifiScan, deviceConfig };
@@ -6,4 +6,7 @@ export const Time = {
   gpsSamplingInterval: 2,
   OneYearInMilliseconds: 31536000000, // 1 year
   sessionTimerInMinutes: 60,
+  // Fallback when IoT Hub connection state events are not routed: two missed
+  // device heartbeats (HEARTBEAT_MAX_INTERVAL of the firmware) and a margin
+  devicePresenceTimeoutInSeconds: 1830,
 };
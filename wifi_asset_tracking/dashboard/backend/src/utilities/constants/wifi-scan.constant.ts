@@ -0,0 +1,9 @@
+// Must match sl_wifi_asset_tracking_wifi_fingerprint.h of the firmware,
+// a change there comes with a new formatVersion
+export const WifiScan = {
+  formatVersion: 0x01,
+  headerSize: 2,
+  bssidSize: 6,
+  entrySize: 8,
+  maxAccessPoints: 6,
+};
@@ -0,0 +1,98 @@
+/***************************************************************************/ /**
+ * @file FreeRTOS.h
+ * @brief Host stand-in for the FreeRTOS kernel subset used by the
+ * application, tasks are POSIX threads
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define configTICK_RATE_HZ                   1000   ///< Nominal rate, like the board configuration
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2     ///< Notification values per task
+#define configMAX_TASK_NAME_LEN              32     ///< Longest task name kept
+#define configGENERATE_RUN_TIME_STATS        0      ///< No run time counters on host
+#define configUSE_TRACE_FACILITY             0      ///< No uxTaskGetSystemState on host
+#define configUSE_TICKLESS_IDLE              0      ///< Host threads keep the tick
+
+/// Ticks advance at the rate of the board tick clock, which is
+/// TIMER_CLOCK_OFFSET times configTICK_RATE_HZ
+#define HOST_FREERTOS_TICKS_PER_SECOND       1240
+
+#define portMAX_DELAY                        ((TickType_t)0xFFFFFFFFUL) ///< Wait forever
+#define portTICK_PERIOD_MS                   ((TickType_t)1000 / configTICK_RATE_HZ) ///< Nominal tick period
+#define pdMS_TO_TICKS(ms) \
+  ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000U))           ///< Nominal ms to ticks
+
+#define pdFALSE                              ((BaseType_t)0)
+#define pdTRUE                               ((BaseType_t)1)
+#define pdFAIL                               pdFALSE
+#define pdPASS                               pdTRUE
+
+/// Critical sections are one recursive lock shared by every task
+#define taskENTER_CRITICAL()                 vHostEnterCritical()
+#define taskEXIT_CRITICAL()                  vHostExitCritical()
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+typedef uint32_t TickType_t;         ///< Tick count
+typedef long BaseType_t;             ///< Signed result of kernel calls
+typedef unsigned long UBaseType_t;   ///< Unsigned result of kernel calls
+typedef uint32_t StackType_t;        ///< Stack word
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to enter the critical section, nests.
+ ******************************************************************************/
+void vHostEnterCritical(void);
+
+/**************************************************************************/ /**
+ * @brief Function to leave the critical section.
+ ******************************************************************************/
+void vHostExitCritical(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get the free heap, the host heap is not bounded.
+ * @return SIZE_MAX.
+ ******************************************************************************/
+size_t xPortGetFreeHeapSize(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get the least free heap since start.
+ * @return SIZE_MAX.
+ ******************************************************************************/
+size_t xPortGetMinimumEverFreeHeapSize(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_FREERTOS_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,51 @@
+/***************************************************************************/ /**
+ * @file azure_iot_hub_client.h
+ * @brief Host stand-in for the Azure IoT Hub client types used by the
+ * application headers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef AZURE_IOT_HUB_CLIENT_H
+#define AZURE_IOT_HUB_CLIENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for the IoT Hub client, the host tools never use it
+typedef struct {
+  uint32_t reserved;            ///< Placeholder
+} AzureIoTHubClient_t;
+
+/// @brief Structure for a message property bag, the host tools never use it
+typedef struct {
+  uint8_t *buffer;              ///< Property buffer
+  uint32_t length;              ///< Used bytes of buffer
+} AzureIoTMessageProperties_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AZURE_IOT_HUB_CLIENT_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
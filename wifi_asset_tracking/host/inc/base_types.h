@@ -0,0 +1,37 @@
+/***************************************************************************/ /**
+ * @file base_types.h
+ * @brief Host stand-in for the base types of the device headers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef BASE_TYPES_H
+#define BASE_TYPES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASE_TYPES_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
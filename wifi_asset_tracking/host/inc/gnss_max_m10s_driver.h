@@ -0,0 +1,95 @@
+/***************************************************************************/ /**
+ * @file gnss_max_m10s_driver.h
+ * @brief Host stand-in for the MAX-M10S GNSS receiver driver,
+ * fixes come from sl_host_driver_stubs.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef GNSS_MAX_M10S_DRIVER_H
+#define GNSS_MAX_M10S_DRIVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define GNSS_POLL_MAX_TIMEOUT                1100   ///< In ms, wait for one receiver answer
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for receiver output protocols
+typedef enum {
+  SL_MAX_M10S_PROTOCOL_UBX = 0,   ///< UBX binary protocol
+  SL_MAX_M10S_PROTOCOL_NMEA,      ///< NMEA sentences
+} sl_max_m10s_protocol_type_t;
+
+/// @brief Structure for the NAV-PVT fields read by the application
+typedef struct {
+  int32_t lon;                  ///< Longitude, 1e-7 degree
+  int32_t lat;                  ///< Latitude, 1e-7 degree
+  int32_t hMSL;                 ///< Height above mean sea level, mm
+  uint8_t numSV;                ///< Satellites used
+  uint8_t fixType;              ///< 0 none, 2 2D, 3 3D
+} sl_ubx_nav_pvt_data_t;
+
+/// @brief Structure for a NAV-PVT packet
+typedef struct {
+  sl_ubx_nav_pvt_data_t data;   ///< Latest solution
+} sl_ubx_nav_pvt_t;
+
+/// @brief Structure for driver configuration
+typedef struct {
+  sl_max_m10s_protocol_type_t protocol_type;  ///< Output protocol
+  sl_ubx_nav_pvt_t *packetUBXNAVPVT;          ///< Latest NAV-PVT packet
+} sl_max_m10s_cfg_data_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to read the fix type.
+ * @param[in] cfg : driver configuration.
+ * @param[in] timeout : in ms, unused on host.
+ * @param[out] fix_type : 0 none, 2 2D, 3 3D.
+ * @return SL_STATUS_OK, SL_STATUS_FAIL for an injected read failure.
+ ******************************************************************************/
+sl_status_t gnss_max_m10s_get_fix_type(sl_max_m10s_cfg_data_t *cfg,
+                                       uint16_t timeout,
+                                       uint8_t *fix_type);
+
+/**************************************************************************/ /**
+ * @brief Function to read a position, kept in cfg->packetUBXNAVPVT.
+ * @param[in] cfg : driver configuration.
+ * @param[in] timeout : in ms, unused on host.
+ * @return SL_STATUS_OK, SL_STATUS_FAIL for an injected read failure.
+ ******************************************************************************/
+sl_status_t gnss_max_m10s_get_nav_pvt(sl_max_m10s_cfg_data_t *cfg,
+                                      uint16_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNSS_MAX_M10S_DRIVER_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,100 @@
+/***************************************************************************/ /**
+ * @file queue.h
+ * @brief Host stand-in for FreeRTOS queues
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef INC_QUEUE_H
+#define INC_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <FreeRTOS.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define xQueueSend(queue, item, wait) \
+  xQueueGenericSend((queue), (item), (wait), queueSEND_TO_BACK)     ///< Copy an item to the back
+#define xQueueSendToBack(queue, item, wait) \
+  xQueueGenericSend((queue), (item), (wait), queueSEND_TO_BACK)     ///< Copy an item to the back
+#define xQueueSendToFront(queue, item, wait) \
+  xQueueGenericSend((queue), (item), (wait), queueSEND_TO_FRONT)    ///< Copy an item to the front
+
+#define queueSEND_TO_BACK                    ((BaseType_t)0)
+#define queueSEND_TO_FRONT                   ((BaseType_t)1)
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Opaque queue, semaphores are queues of empty items
+typedef struct QueueDefinition *QueueHandle_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to create a queue.
+ * @return queue, NULL when out of memory.
+ ******************************************************************************/
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+
+/**************************************************************************/ /**
+ * @brief Function to delete a queue nobody waits on.
+ ******************************************************************************/
+void vQueueDelete(QueueHandle_t queue);
+
+/**************************************************************************/ /**
+ * @brief Function to copy an item into a queue.
+ * @return pdPASS, or pdFAIL when the queue stayed full for wait ticks.
+ ******************************************************************************/
+BaseType_t xQueueGenericSend(QueueHandle_t queue,
+                             const void *item,
+                             TickType_t wait,
+                             BaseType_t position);
+
+/**************************************************************************/ /**
+ * @brief Function to take the front item of a queue.
+ * @return pdPASS, or pdFAIL when the queue stayed empty for wait ticks.
+ ******************************************************************************/
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait);
+
+/**************************************************************************/ /**
+ * @brief Function to copy the front item of a queue without taking it.
+ * @return pdPASS, or pdFAIL when the queue stayed empty for wait ticks.
+ ******************************************************************************/
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t wait);
+
+/**************************************************************************/ /**
+ * @brief Function to get the items in a queue.
+ ******************************************************************************/
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+/**************************************************************************/ /**
+ * @brief Function to get the free slots of a queue.
+ ******************************************************************************/
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_QUEUE_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,66 @@
+/***************************************************************************/ /**
+ * @file semphr.h
+ * @brief Host stand-in for FreeRTOS semaphores and mutexes
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <queue.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define xSemaphoreTake(semaphore, wait) \
+  xQueueReceive((semaphore), NULL, (wait))                          ///< Take a count
+#define xSemaphoreGive(semaphore) \
+  xQueueGenericSend((semaphore), NULL, 0, queueSEND_TO_BACK)        ///< Give a count back
+#define vSemaphoreDelete(semaphore) \
+  vQueueDelete(semaphore)                                           ///< Delete a semaphore
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+typedef QueueHandle_t SemaphoreHandle_t;  ///< Semaphore, a queue of empty items
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to create a mutex, available at start. There is no
+ * priority inheritance on host.
+ * @return mutex, NULL when out of memory.
+ ******************************************************************************/
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+
+/**************************************************************************/ /**
+ * @brief Function to create a binary semaphore, taken at start.
+ * @return semaphore, NULL when out of memory.
+ ******************************************************************************/
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEMAPHORE_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,49 @@
+/***************************************************************************/ /**
+ * @file sl_host_driver_stubs.h
+ * @brief Behaviour of the host sensor driver stubs
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_HOST_DRIVER_STUBS_H_
+#define SL_HOST_DRIVER_STUBS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to set how the stubbed Si7021, BMI270 and MAX-M10S reads
+ * behave. A read blocks the calling task like a blocking I2C transfer.
+ * @param[in] read_time_us : duration of one driver read.
+ * @param[in] failure_per_mille : share of reads which fail, 0 to 1000.
+ * @param[in] seed : seed of readings and failures, same seed same run.
+ ******************************************************************************/
+void sl_host_driver_stubs_configure(uint32_t read_time_us,
+                                    uint32_t failure_per_mille,
+                                    uint32_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_HOST_DRIVER_STUBS_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,53 @@
+/***************************************************************************/ /**
+ * @file sl_host_freertos.h
+ * @brief Host only calls of the FreeRTOS stand-in
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_HOST_FREERTOS_H_
+#define SL_HOST_FREERTOS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to wait until a task returned or deleted itself, then
+ * release it. Tasks on host may end, the harness stops them this way.
+ * @param[in] task : task to wait for, invalid afterwards.
+ ******************************************************************************/
+void sl_host_freertos_join(TaskHandle_t task);
+
+/**************************************************************************/ /**
+ * @brief Function to convert ticks into microseconds at the host tick rate.
+ * @param[in] ticks : tick count or difference.
+ * @return microseconds.
+ ******************************************************************************/
+uint64_t sl_host_freertos_ticks_to_us(TickType_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_HOST_FREERTOS_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
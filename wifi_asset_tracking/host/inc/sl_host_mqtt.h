@@ -0,0 +1,150 @@
+/***************************************************************************/ /**
+ * @file sl_host_mqtt.h
+ * @brief Minimal MQTT 3.1.1 client used by host tools over the transport
+ * interface
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_HOST_MQTT_H_
+#define SL_HOST_MQTT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <sl_wifi_asset_tracking_transport.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_MQTT_TX_BUFFER_SIZE             512    ///< Largest packet a client sends
+#define HOST_MQTT_RX_BUFFER_SIZE             64     ///< Largest packet body a client keeps, acknowledgements only
+#define HOST_MQTT_ACK_TIMEOUT_MS             10000  ///< In ms, CONNACK / PUBACK wait, matches TRANSPORT_MQTT_CONNACK_RECV_TIMEOUT_MS
+#define HOST_MQTT_MAX_REMAINING_LENGTH_BYTES 4      ///< Maximum bytes of MQTT remaining length
+
+#define HOST_MQTT_PACKET_CONNECT             0x10   ///< CONNECT fixed header
+#define HOST_MQTT_PACKET_CONNACK             0x20   ///< CONNACK fixed header
+#define HOST_MQTT_PACKET_PUBLISH             0x30   ///< PUBLISH fixed header, flags in low nibble
+#define HOST_MQTT_PACKET_PUBACK              0x40   ///< PUBACK fixed header
+#define HOST_MQTT_PACKET_PINGREQ             0xC0   ///< PINGREQ fixed header
+#define HOST_MQTT_PACKET_PINGRESP            0xD0   ///< PINGRESP fixed header
+#define HOST_MQTT_PACKET_DISCONNECT          0xE0   ///< DISCONNECT fixed header
+#define HOST_MQTT_PACKET_TYPE_MASK           0xF0   ///< Packet type bits of fixed header
+
+/// Telemetry topic and property bag used by the Azure IoT Hub client
+#define HOST_MQTT_TELEMETRY_TOPIC_FORMAT \
+  "devices/%s/messages/events/$.ct=application%%2Fjson&$.ce=us-ascii"
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one MQTT client connection
+typedef struct {
+  const sl_transport_interface_t *transport;      ///< Connected transport
+  uint16_t next_packet_id;                        ///< Packet identifier of next QoS 1 publish
+  uint8_t tx_buffer[HOST_MQTT_TX_BUFFER_SIZE];    ///< Outgoing packet
+  uint8_t rx_buffer[HOST_MQTT_RX_BUFFER_SIZE];    ///< Body of last received packet
+} sl_host_mqtt_client_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to send CONNECT on a connected transport and wait for
+ * CONNACK.
+ * @param[in] client : client state.
+ * @param[in] transport : connected transport.
+ * @param[in] client_id : MQTT client identifier, i.e. device ID.
+ * @param[in] username : MQTT user name, NULL for none.
+ * @param[in] keep_alive : In seconds, MQTT keep alive.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_TIMEOUT - on CONNACK timeout
+ * -  \ref SL_STATUS_FAIL - on transport failure or connection refused
+ ******************************************************************************/
+sl_status_t sl_host_mqtt_connect(sl_host_mqtt_client_t *client,
+                                 const sl_transport_interface_t *transport,
+                                 const char *client_id,
+                                 const char *username,
+                                 uint16_t keep_alive);
+
+/**************************************************************************/ /**
+ * @brief Function to send PUBLISH.
+ * @param[in] client : client state.
+ * @param[in] topic : topic name.
+ * @param[in] payload : message payload.
+ * @param[in] payload_len : length of payload.
+ * @param[in] qos : 0 or 1.
+ * @param[out] packet_id : packet identifier of QoS 1 publish, may be NULL.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on oversized packet or transport failure
+ ******************************************************************************/
+sl_status_t sl_host_mqtt_publish(sl_host_mqtt_client_t *client,
+                                 const char *topic,
+                                 const uint8_t *payload,
+                                 uint32_t payload_len,
+                                 uint8_t qos,
+                                 uint16_t *packet_id);
+
+/**************************************************************************/ /**
+ * @brief Function to wait for PUBACK of a QoS 1 publish.
+ * @param[in] client : client state.
+ * @param[in] packet_id : packet identifier returned by publish.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_TIMEOUT - on PUBACK timeout
+ * -  \ref SL_STATUS_FAIL - on transport failure
+ ******************************************************************************/
+sl_status_t sl_host_mqtt_wait_puback(sl_host_mqtt_client_t *client,
+                                     uint16_t packet_id);
+
+/**************************************************************************/ /**
+ * @brief Function to send DISCONNECT and close the transport.
+ * @param[in] client : client state.
+ ******************************************************************************/
+void sl_host_mqtt_disconnect(sl_host_mqtt_client_t *client);
+
+/**************************************************************************/ /**
+ * @brief Function to encode MQTT remaining length.
+ * @param[out] buffer : output of at least HOST_MQTT_MAX_REMAINING_LENGTH_BYTES.
+ * @param[in] length : remaining length.
+ * @return number of bytes written.
+ ******************************************************************************/
+uint32_t sl_host_mqtt_encode_remaining_length(uint8_t *buffer, uint32_t length);
+
+/**************************************************************************/ /**
+ * @brief Function to decode MQTT fixed header from a partial stream.
+ * @param[in] buffer : received bytes starting at a fixed header.
+ * @param[in] buffer_len : number of received bytes.
+ * @param[out] remaining_length : decoded remaining length.
+ * @param[out] header_len : length of fixed header.
+ * @return true if the fixed header is complete and valid.
+ ******************************************************************************/
+bool sl_host_mqtt_decode_fixed_header(const uint8_t *buffer,
+                                      uint32_t buffer_len,
+                                      uint32_t *remaining_length,
+                                      uint32_t *header_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_HOST_MQTT_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,55 @@
+/***************************************************************************/ /**
+ * @file sl_host_payload.h
+ * @brief Telemetry messages in the JSON schema published by the firmware
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_HOST_PAYLOAD_H_
+#define SL_HOST_PAYLOAD_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_PAYLOAD_MAX_SIZE                200    ///< Matches MAX_JSON_MESSAGE_SIZE of firmware
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to build one telemetry message of a virtual device. Message
+ * types rotate like the firmware sensor tasks: heat, imu, gps, keep-alive.
+ * @param[out] buffer : output of HOST_PAYLOAD_MAX_SIZE bytes.
+ * @param[in] device_index : virtual device number, seeds the readings.
+ * @param[in] sequence : message number of the device.
+ * @return length of the message, 0 on failure.
+ ******************************************************************************/
+uint32_t sl_host_payload_build(char *buffer,
+                               uint32_t device_index,
+                               uint32_t sequence);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_HOST_PAYLOAD_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
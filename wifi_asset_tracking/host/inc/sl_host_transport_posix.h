@@ -0,0 +1,72 @@
+/***************************************************************************/ /**
+ * @file sl_host_transport_posix.h
+ * @brief POSIX TCP/TLS socket backend of the application transport interface
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_HOST_TRANSPORT_POSIX_H_
+#define SL_HOST_TRANSPORT_POSIX_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <sl_wifi_asset_tracking_transport.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_TRANSPORT_RECV_TIMEOUT_MS       2000   ///< In ms, matches TRANSPORT_SEND_RECV_TIMEOUT_MS of firmware
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one POSIX socket connection
+typedef struct {
+  int socket_id;               ///< Connected socket, -1 when closed
+  bool use_tls;                ///< Wrap the socket in TLS (needs TLS=1 build)
+  bool verify_peer;            ///< Verify server certificate against system CAs
+  uint32_t recv_timeout_ms;    ///< Receive timeout, recv returns 0 on expiry
+  void *ssl_context;           ///< OpenSSL SSL_CTX, TLS builds only
+  void *ssl;                   ///< OpenSSL SSL, TLS builds only
+} sl_host_transport_posix_context_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to fill a transport interface with the POSIX backend.
+ * One interface and context pair represents one connection.
+ * @param[out] transport : transport interface to fill.
+ * @param[out] context : connection state bound to the interface.
+ * @param[in] use_tls : true to wrap the TCP connection in TLS.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when TLS is requested but not built in
+ ******************************************************************************/
+sl_status_t sl_host_transport_posix_init(sl_transport_interface_t *transport,
+                                         sl_host_transport_posix_context_t *context,
+                                         bool use_tls);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_HOST_TRANSPORT_POSIX_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
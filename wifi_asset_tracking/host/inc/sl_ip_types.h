@@ -0,0 +1,59 @@
+/***************************************************************************/ /**
+ * @file sl_ip_types.h
+ * @brief Host stand-in for the IP address types used by the
+ * application headers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_IP_TYPES_H
+#define SL_IP_TYPES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for IP address types
+typedef enum {
+  SL_IPV4 = (1 << 2),           ///< IPv4 address
+  SL_IPV6 = (1 << 3),           ///< IPv6 address
+} sl_ip_address_type_t;
+
+/// @brief Structure for an IP address
+typedef struct {
+  union {
+    struct {
+      uint8_t bytes[4];         ///< IPv4 address octets
+    } v4;                       ///< IPv4 address
+    struct {
+      uint32_t value[4];        ///< IPv6 address words
+    } v6;                       ///< IPv6 address
+  } ip;                         ///< Address
+  sl_ip_address_type_t type;    ///< SL_IPV4 or SL_IPV6
+} sl_ip_address_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_IP_TYPES_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
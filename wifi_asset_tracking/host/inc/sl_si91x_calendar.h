@@ -0,0 +1,91 @@
+/***************************************************************************/ /**
+ * @file sl_si91x_calendar.h
+ * @brief Host stand-in for the calendar RTC driver, the calendar
+ * follows the host UTC clock
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SI91X_CALENDAR_H
+#define SL_SI91X_CALENDAR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for months
+typedef enum {
+  January = 1,
+  February,
+  March,
+  April,
+  May,
+  June,
+  July,
+  August,
+  September,
+  October,
+  November,
+  December,
+} sl_calendar_month_t;
+
+/// @brief Enum for days of the week
+typedef enum {
+  Sunday = 0,
+  Monday,
+  Tuesday,
+  Wednesday,
+  Thursday,
+  Friday,
+  Saturday,
+} sl_calendar_days_of_week_t;
+
+/// @brief Structure for calendar date and time
+typedef struct {
+  uint8_t Century;                        ///< Century digit, 2 for 20xx
+  uint8_t Year;                           ///< Year of the century
+  sl_calendar_month_t Month;              ///< Month
+  sl_calendar_days_of_week_t DayOfWeek;   ///< Day of the week
+  uint8_t Day;                            ///< Day of the month
+  uint8_t Hour;                           ///< Hour
+  uint8_t Minute;                         ///< Minute
+  uint8_t Second;                         ///< Second
+  uint16_t MilliSeconds;                  ///< Millisecond
+} sl_calendar_datetime_config_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to read the calendar.
+ * @param[out] config : current date and time.
+ * @return SL_STATUS_OK, SL_STATUS_FAIL when config is NULL.
+ ******************************************************************************/
+sl_status_t sl_si91x_calendar_get_date_time(sl_calendar_datetime_config_t *config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_SI91X_CALENDAR_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
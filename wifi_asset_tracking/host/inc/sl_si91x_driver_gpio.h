@@ -0,0 +1,36 @@
+/***************************************************************************/ /**
+ * @file sl_si91x_driver_gpio.h
+ * @brief Host stand-in for the GPIO driver, nothing of it is
+ * used on host
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SI91X_DRIVER_GPIO_H
+#define SL_SI91X_DRIVER_GPIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sl_status.h>
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_SI91X_DRIVER_GPIO_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,46 @@
+/***************************************************************************/ /**
+ * @file sl_si91x_i2c.h
+ * @brief Host stand-in for the I2C driver types used by the
+ * application headers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SI91X_I2C_H
+#define SL_SI91X_I2C_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for I2C instances
+typedef enum {
+  SL_I2C0 = 0,                  ///< I2C 0 instance
+  SL_I2C1,                      ///< I2C 1 instance
+  SL_I2C2,                      ///< ULP I2C instance
+  SL_I2C_LAST,                  ///< Number of instances
+} sl_i2c_instance_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_SI91X_I2C_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
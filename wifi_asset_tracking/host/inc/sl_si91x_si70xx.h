@@ -0,0 +1,70 @@
+/***************************************************************************/ /**
+ * @file sl_si91x_si70xx.h
+ * @brief Host stand-in for the Si70xx temperature and RH sensor
+ * driver, readings come from sl_host_driver_stubs.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_SI91X_SI70XX_H
+#define SL_SI91X_SI70XX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sl_status.h>
+#include <sl_si91x_i2c.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SI7021_ADDR                          0x40   ///< I2C address of the Si7021
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for electronic ID bytes
+typedef enum {
+  SL_EID_FIRST_BYTE = 0,        ///< First ID byte
+  SL_EID_SECOND_BYTE,           ///< Second ID byte, holds the device type
+} sl_eid_type_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to read relative humidity and the temperature measured
+ * with it.
+ * @param[in] i2c_instance : I2C instance.
+ * @param[in] addr : sensor address.
+ * @param[out] humid_data : in %RH.
+ * @param[out] temp_data : in degree Celsius.
+ * @return SL_STATUS_OK, SL_STATUS_FAIL for an injected read failure.
+ ******************************************************************************/
+sl_status_t sl_si91x_si70xx_read_temp_from_rh(sl_i2c_instance_t i2c_instance,
+                                              uint8_t addr,
+                                              uint32_t *humid_data,
+                                              int32_t *temp_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_SI91X_SI70XX_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,49 @@
+/***************************************************************************/ /**
+ * @file sl_status.h
+ * @brief Subset of SDK status codes used by host builds of application modules
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_STATUS_H
+#define SL_STATUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SL_STATUS_OK                         ((sl_status_t)0x0000)  ///< No error
+#define SL_STATUS_FAIL                       ((sl_status_t)0x0001)  ///< Generic error
+#define SL_STATUS_BUSY                       ((sl_status_t)0x0004)  ///< Resource busy, try later
+#define SL_STATUS_TIMEOUT                    ((sl_status_t)0x0007)  ///< Operation timed out
+#define SL_STATUS_ALLOCATION_FAILED          ((sl_status_t)0x0019)  ///< Memory allocation failed
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+typedef uint32_t sl_status_t;  ///< Status code type
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_STATUS_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,63 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_types.h
+ * @brief Host stand-in for the Wi-Fi types used by the application
+ * headers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_TYPES_H
+#define SL_WIFI_TYPES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for scan types
+typedef enum {
+  SL_WIFI_SCAN_TYPE_ACTIVE = 0,   ///< Active scan
+  SL_WIFI_SCAN_TYPE_PASSIVE,      ///< Passive scan
+  SL_WIFI_SCAN_TYPE_ADV_SCAN,     ///< Background scan, keeps the connection
+} sl_wifi_scan_type_t;
+
+/// @brief Structure for an SSID
+typedef struct {
+  uint8_t value[32];            ///< SSID octets
+  uint8_t length;               ///< Used octets
+} sl_wifi_ssid_t;
+
+/// @brief Structure for one scanned access point
+typedef struct {
+  uint8_t rf_channel;           ///< Channel
+  uint8_t security_mode;        ///< Security mode
+  uint8_t rssi;                 ///< Signal strength, magnitude in dBm
+  uint8_t network_type;         ///< Network type
+  uint8_t ssid[34];             ///< Terminated SSID
+  uint8_t bssid[6];             ///< BSSID
+} sl_wifi_scan_info_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_TYPES_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,66 @@
+/***************************************************************************/ /**
+ * @file sparkfun_bmi270.h
+ * @brief Host stand-in for the BMI270 IMU driver, readings come
+ * from sl_host_driver_stubs.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SPARKFUN_BMI270_H
+#define SPARKFUN_BMI270_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for driver configuration
+typedef struct {
+  uint8_t i2c_address;          ///< I2C address of the sensor
+} bmi270_cfg_data_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to read the accelerometer.
+ * @param[in] cfg : driver configuration.
+ * @param[out] acc : x, y, z in g.
+ * @return SL_STATUS_OK, SL_STATUS_FAIL for an injected read failure.
+ ******************************************************************************/
+sl_status_t sparkfun_bmi270_read_acc_reading(bmi270_cfg_data_t *cfg, double *acc);
+
+/**************************************************************************/ /**
+ * @brief Function to read the gyroscope.
+ * @param[in] cfg : driver configuration.
+ * @param[out] gyro : x, y, z in degree per second.
+ * @return SL_STATUS_OK, SL_STATUS_FAIL for an injected read failure.
+ ******************************************************************************/
+sl_status_t sparkfun_bmi270_read_gyro_reading(bmi270_cfg_data_t *cfg,
+                                              double *gyro);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPARKFUN_BMI270_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,142 @@
+/***************************************************************************/ /**
+ * @file task.h
+ * @brief Host stand-in for FreeRTOS tasks and task notifications
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <FreeRTOS.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define xTaskNotifyGive(task) \
+  xTaskGenericNotify((task), 0, 0, eIncrement, NULL)                ///< Count a wake-up on index 0
+#define ulTaskNotifyTake(clear_on_exit, wait) \
+  ulTaskGenericNotifyTake(0, (clear_on_exit), (wait))               ///< Wait for wake-ups on index 0
+#define xTaskNotifyIndexed(task, index, value, action) \
+  xTaskGenericNotify((task), (index), (value), (action), NULL)      ///< Update a notification value
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Opaque task, a POSIX thread on host
+typedef struct tskTaskControlBlock *TaskHandle_t;
+
+/// @brief Task entry function
+typedef void (*TaskFunction_t)(void *parameter);
+
+/// @brief Enum for the update of a notification value
+typedef enum {
+  eNoAction = 0,                ///< Only wake the task
+  eSetBits,                     ///< OR the value in
+  eIncrement,                   ///< Add one
+  eSetValueWithOverwrite,       ///< Replace the value
+  eSetValueWithoutOverwrite,    ///< Replace the value when nothing is pending
+} eNotifyAction;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to start a task on its own thread. Stack depth and
+ * priority are kept for the caller only, the host scheduler runs tasks in
+ * parallel.
+ * @return pdPASS, or pdFAIL when the thread could not be started.
+ ******************************************************************************/
+BaseType_t xTaskCreate(TaskFunction_t function,
+                       const char *name,
+                       uint32_t stack_depth,
+                       void *parameter,
+                       UBaseType_t priority,
+                       TaskHandle_t *handle);
+
+/**************************************************************************/ /**
+ * @brief Function to end a task. Only NULL, the calling task, is supported;
+ * the handle stays valid until sl_host_freertos_join.
+ ******************************************************************************/
+void vTaskDelete(TaskHandle_t task);
+
+/**************************************************************************/ /**
+ * @brief Function to block the calling task.
+ * @param[in] ticks : ticks to wait.
+ ******************************************************************************/
+void vTaskDelay(TickType_t ticks);
+
+/**************************************************************************/ /**
+ * @brief Function to get the ticks since the kernel was started.
+ ******************************************************************************/
+TickType_t xTaskGetTickCount(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get the calling task, NULL outside tasks.
+ ******************************************************************************/
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get the name of a task, NULL for the calling task.
+ ******************************************************************************/
+char *pcTaskGetName(TaskHandle_t task);
+
+/**************************************************************************/ /**
+ * @brief Function to get the least unused stack, not measured on host.
+ * @return 0.
+ ******************************************************************************/
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+/**************************************************************************/ /**
+ * @brief Function to update a notification value of a task and wake it.
+ * @param[in] previous : value before the update, may be NULL.
+ * @return pdFAIL only for eSetValueWithoutOverwrite on a pending value.
+ ******************************************************************************/
+BaseType_t xTaskGenericNotify(TaskHandle_t task,
+                              UBaseType_t index,
+                              uint32_t value,
+                              eNotifyAction action,
+                              uint32_t *previous);
+
+/**************************************************************************/ /**
+ * @brief Function to wait until a notification value is non-zero.
+ * @return value before it was cleared or decremented, 0 on timeout.
+ ******************************************************************************/
+uint32_t ulTaskGenericNotifyTake(UBaseType_t index,
+                                 BaseType_t clear_on_exit,
+                                 TickType_t wait);
+
+/**************************************************************************/ /**
+ * @brief Function to wait for a notification on an index.
+ * @return pdTRUE when notified, pdFALSE on timeout.
+ ******************************************************************************/
+BaseType_t xTaskNotifyWaitIndexed(UBaseType_t index,
+                                  uint32_t clear_on_entry,
+                                  uint32_t clear_on_exit,
+                                  uint32_t *value,
+                                  TickType_t wait);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TASK_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,43 @@
+/***************************************************************************/ /**
+ * @file timers.h
+ * @brief Host stand-in for FreeRTOS software timers, only the handle
+ * type for headers which keep timer handles
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef TIMERS_H
+#define TIMERS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <FreeRTOS.h>
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Opaque timer, no timer service runs on host
+typedef struct tmrTimerControl *TimerHandle_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMERS_H */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,306 @@
+/***************************************************************************/ /**
+ * @file sl_host_broker.c
+ * @brief Local MQTT broker stand-in acknowledging CONNECT and QoS 1 PUBLISH
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sl_host_mqtt.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_BROKER_DEFAULT_PORT             1883   ///< Plain MQTT port
+#define HOST_BROKER_MAX_CONNECTIONS          4096   ///< Maximum simultaneous clients
+#define HOST_BROKER_BUFFER_SIZE              2048   ///< Per client receive buffer
+#define HOST_BROKER_REPORT_PERIOD_MS         5000   ///< In ms, statistics print period
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one client connection of the broker
+typedef struct {
+  uint32_t buffer_len;                      ///< Bytes of partial packets
+  uint8_t buffer[HOST_BROKER_BUFFER_SIZE];  ///< Received, not yet parsed bytes
+} sl_host_broker_client_t;
+
+/// Set by SIGINT / SIGTERM
+static volatile sig_atomic_t sl_host_broker_stop;
+
+/// Print payloads of received PUBLISH packets
+static int sl_host_broker_verbose;
+
+/// Received PUBLISH packets and payload bytes
+static uint64_t sl_host_broker_publish_count;
+static uint64_t sl_host_broker_payload_bytes;
+
+/**************************************************************************/ /**
+ * @brief Signal handler requesting shutdown.
+ ******************************************************************************/
+static void sl_host_broker_on_signal(int signal_number)
+{
+  (void)signal_number;
+  sl_host_broker_stop = 1;
+}
+
+/**************************************************************************/ /**
+ * @brief Handle one complete packet of a client.
+ * @return 0 to keep the connection, -1 to close it.
+ ******************************************************************************/
+static int sl_host_broker_handle_packet(int socket_id,
+                                        const uint8_t *packet,
+                                        uint32_t header_len,
+                                        uint32_t body_len)
+{
+  const uint8_t connack[] = { HOST_MQTT_PACKET_CONNACK, 0x02, 0x00, 0x00 };
+  const uint8_t pingresp[] = { HOST_MQTT_PACKET_PINGRESP, 0x00 };
+  uint8_t puback[] = { HOST_MQTT_PACKET_PUBACK, 0x02, 0x00, 0x00 };
+  const uint8_t *body = &packet[header_len];
+  uint32_t topic_len;
+  uint32_t offset;
+  uint8_t qos;
+
+  switch (packet[0] & HOST_MQTT_PACKET_TYPE_MASK) {
+    case HOST_MQTT_PACKET_CONNECT:
+      return (sizeof(connack)
+              == send(socket_id, connack, sizeof(connack), MSG_NOSIGNAL))
+             ? 0 : -1;
+
+    case HOST_MQTT_PACKET_PUBLISH:
+      if (body_len < 2) {
+        return -1;
+      }
+      qos = (packet[0] >> 1) & 0x03;
+      topic_len = ((uint32_t)body[0] << 8) | body[1];
+      offset = 2 + topic_len + ((qos > 0) ? 2 : 0);
+      if (offset > body_len) {
+        return -1;
+      }
+
+      sl_host_broker_publish_count++;
+      sl_host_broker_payload_bytes += body_len - offset;
+
+      if (sl_host_broker_verbose) {
+        printf("%.*s : %.*s\n",
+               (int)topic_len,
+               (const char *)&body[2],
+               (int)(body_len - offset),
+               (const char *)&body[offset]);
+      }
+
+      if (qos > 0) {
+        puback[2] = body[2 + topic_len];
+        puback[3] = body[3 + topic_len];
+        return (sizeof(puback)
+                == send(socket_id, puback, sizeof(puback), MSG_NOSIGNAL))
+               ? 0 : -1;
+      }
+      return 0;
+
+    case HOST_MQTT_PACKET_PINGREQ:
+      return (sizeof(pingresp)
+              == send(socket_id, pingresp, sizeof(pingresp), MSG_NOSIGNAL))
+             ? 0 : -1;
+
+    case HOST_MQTT_PACKET_DISCONNECT:
+      return -1;
+
+    default:
+      /// Subscriptions are not needed by the telemetry path
+      return 0;
+  }
+}
+
+/**************************************************************************/ /**
+ * @brief Read available bytes of a client and handle complete packets.
+ * @return 0 to keep the connection, -1 to close it.
+ ******************************************************************************/
+static int sl_host_broker_service_client(int socket_id,
+                                         sl_host_broker_client_t *client)
+{
+  uint32_t remaining_length;
+  uint32_t header_len;
+  uint32_t packet_len;
+  ssize_t recv_bytes;
+
+  recv_bytes = recv(socket_id,
+                    &client->buffer[client->buffer_len],
+                    sizeof(client->buffer) - client->buffer_len,
+                    0);
+  if (recv_bytes <= 0) {
+    return -1;
+  }
+  client->buffer_len += (uint32_t)recv_bytes;
+
+  while (sl_host_mqtt_decode_fixed_header(client->buffer,
+                                          client->buffer_len,
+                                          &remaining_length,
+                                          &header_len)) {
+    packet_len = header_len + remaining_length;
+    if (packet_len > sizeof(client->buffer)) {
+      printf("sl_host_broker : packet of %u bytes too large\n", packet_len);
+      return -1;
+    }
+    if (packet_len > client->buffer_len) {
+      break;
+    }
+
+    if (0 != sl_host_broker_handle_packet(socket_id,
+                                          client->buffer,
+                                          header_len,
+                                          remaining_length)) {
+      return -1;
+    }
+
+    memmove(client->buffer,
+            &client->buffer[packet_len],
+            client->buffer_len - packet_len);
+    client->buffer_len -= packet_len;
+  }
+
+  return 0;
+}
+
+/**************************************************************************/ /**
+ * @brief Broker stand-in entry point.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  static struct pollfd poll_list[HOST_BROKER_MAX_CONNECTIONS + 1];
+  static sl_host_broker_client_t *clients[HOST_BROKER_MAX_CONNECTIONS + 1];
+  struct sockaddr_in address = { 0 };
+  uint16_t port = HOST_BROKER_DEFAULT_PORT;
+  uint64_t last_count = 0;
+  nfds_t poll_count = 1;
+  nfds_t index;
+  int listen_id;
+  int client_id;
+  int option = 1;
+  int ready;
+
+  while (-1 != (option = getopt(argc, argv, "p:vh"))) {
+    switch (option) {
+      case 'p':
+        port = (uint16_t)atoi(optarg);
+        break;
+      case 'v':
+        sl_host_broker_verbose = 1;
+        break;
+      default:
+        printf("usage: %s [-p port] [-v]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  signal(SIGINT, sl_host_broker_on_signal);
+  signal(SIGTERM, sl_host_broker_on_signal);
+
+  listen_id = socket(AF_INET, SOCK_STREAM, 0);
+  option = 1;
+  setsockopt(listen_id, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+  if ((0 != bind(listen_id, (struct sockaddr *)&address, sizeof(address)))
+      || (0 != listen(listen_id, SOMAXCONN))) {
+    printf("sl_host_broker : cannot listen on port %u: %s\n",
+           port,
+           strerror(errno));
+    return 1;
+  }
+
+  printf("sl_host_broker : listening on port %u\n", port);
+  fflush(stdout);
+
+  poll_list[0].fd = listen_id;
+  poll_list[0].events = POLLIN;
+
+  while (!sl_host_broker_stop) {
+    ready = poll(poll_list, poll_count, HOST_BROKER_REPORT_PERIOD_MS);
+
+    if (ready < 0) {
+      continue;
+    }
+
+    if (0 == ready) {
+      if (sl_host_broker_publish_count != last_count) {
+        printf("sl_host_broker : clients %lu, publish %llu\n",
+               (unsigned long)(poll_count - 1),
+               (unsigned long long)sl_host_broker_publish_count);
+        fflush(stdout);
+        last_count = sl_host_broker_publish_count;
+      }
+      continue;
+    }
+
+    if (poll_list[0].revents & POLLIN) {
+      client_id = accept(listen_id, NULL, NULL);
+      if (client_id >= 0) {
+        if (poll_count > HOST_BROKER_MAX_CONNECTIONS) {
+          close(client_id);
+        } else {
+          option = 1;
+          setsockopt(client_id,
+                     IPPROTO_TCP,
+                     TCP_NODELAY,
+                     &option,
+                     sizeof(option));
+          clients[poll_count] = calloc(1, sizeof(sl_host_broker_client_t));
+          poll_list[poll_count].fd = client_id;
+          poll_list[poll_count].events = POLLIN;
+          poll_list[poll_count].revents = 0;
+          poll_count++;
+        }
+      }
+    }
+
+    for (index = 1; index < poll_count; ++index) {
+      if (0 == (poll_list[index].revents & (POLLIN | POLLHUP | POLLERR))) {
+        continue;
+      }
+
+      if ((NULL != clients[index])
+          && (0 == sl_host_broker_service_client(poll_list[index].fd,
+                                                 clients[index]))) {
+        continue;
+      }
+
+      /// Close and fill the hole with the last connection
+      close(poll_list[index].fd);
+      free(clients[index]);
+      poll_count--;
+      poll_list[index] = poll_list[poll_count];
+      clients[index] = clients[poll_count];
+      clients[poll_count] = NULL;
+      index--;
+    }
+  }
+
+  printf("sl_host_broker : publish %llu, payload bytes %llu\n",
+         (unsigned long long)sl_host_broker_publish_count,
+         (unsigned long long)sl_host_broker_payload_bytes);
+
+  close(listen_id);
+  return 0;
+}
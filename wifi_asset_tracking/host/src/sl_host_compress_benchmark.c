@@ -0,0 +1,194 @@
+/***************************************************************************/ /**
+ * @file sl_host_compress_benchmark.c
+ * @brief Ratio and speed of the telemetry compressor on firmware messages
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sl_wifi_asset_tracking_compress.h>
+#include <sl_host_payload.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HOST_BENCHMARK_HAS_CYCLES            1      ///< Time stamp counter available
+#else
+#define HOST_BENCHMARK_HAS_CYCLES            0      ///< Time stamp counter not available
+#endif
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_BENCHMARK_DEFAULT_MESSAGES      100000 ///< Messages compressed per run
+#define HOST_BENCHMARK_DEVICES               16     ///< Virtual devices the messages come from
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for time and cycles spent in one direction
+typedef struct {
+  uint64_t nanoseconds;   ///< Wall clock time
+  uint64_t cycles;        ///< Time stamp counter ticks, 0 when not available
+} sl_host_benchmark_cost_t;
+
+/**************************************************************************/ /**
+ * @brief Read wall clock in ns.
+ ******************************************************************************/
+static uint64_t sl_host_benchmark_now_ns(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000ull) + (uint64_t)now.tv_nsec;
+}
+
+/**************************************************************************/ /**
+ * @brief Read time stamp counter.
+ ******************************************************************************/
+static uint64_t sl_host_benchmark_cycles(void)
+{
+#if HOST_BENCHMARK_HAS_CYCLES
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/**************************************************************************/ /**
+ * @brief Print cost per input byte of one direction.
+ ******************************************************************************/
+static void sl_host_benchmark_print_cost(const char *name,
+                                         const sl_host_benchmark_cost_t *cost,
+                                         uint64_t bytes)
+{
+  printf("%-19s: %.2f ns/byte", name, (double)cost->nanoseconds / bytes);
+  if (HOST_BENCHMARK_HAS_CYCLES) {
+    printf(", %.2f cycles/byte", (double)cost->cycles / bytes);
+  }
+  printf("\n");
+}
+
+/**************************************************************************/ /**
+ * @brief Compressor benchmark entry point.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  static uint8_t restored[COMPRESS_MAX_INPUT_SIZE];
+  static uint8_t compressed[COMPRESS_BOUND(COMPRESS_MAX_INPUT_SIZE)];
+  char message[HOST_PAYLOAD_MAX_SIZE];
+  sl_host_benchmark_cost_t compress_cost = { 0 };
+  sl_host_benchmark_cost_t decompress_cost = { 0 };
+  uint32_t message_count = HOST_BENCHMARK_DEFAULT_MESSAGES;
+  uint64_t input_bytes = 0;
+  uint64_t output_bytes = 0;
+  uint64_t compressed_count = 0;
+  uint64_t start_ns;
+  uint64_t start_cycles;
+  uint32_t message_len;
+  uint32_t compressed_len;
+  uint32_t restored_len;
+  uint32_t index;
+  int verbose = 0;
+  int option;
+
+  while (-1 != (option = getopt(argc, argv, "n:vh"))) {
+    switch (option) {
+      case 'n':
+        message_count = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'v':
+        verbose = 1;
+        break;
+      default:
+        printf("usage: %s [-n messages] [-v]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  for (index = 0; index < message_count; ++index) {
+    message_len = sl_host_payload_build(message,
+                                        index % HOST_BENCHMARK_DEVICES,
+                                        index / HOST_BENCHMARK_DEVICES);
+    if (0 == message_len) {
+      printf("sl_host_compress_benchmark : payload build failed\n");
+      return 1;
+    }
+    input_bytes += message_len;
+
+    start_ns = sl_host_benchmark_now_ns();
+    start_cycles = sl_host_benchmark_cycles();
+    if (SL_STATUS_OK != sl_compress_message((const uint8_t *)message,
+                                            message_len,
+                                            compressed,
+                                            sizeof(compressed),
+                                            &compressed_len)) {
+      /// Firmware sends such a message uncompressed
+      compress_cost.cycles += sl_host_benchmark_cycles() - start_cycles;
+      compress_cost.nanoseconds += sl_host_benchmark_now_ns() - start_ns;
+      output_bytes += message_len;
+      continue;
+    }
+    compress_cost.cycles += sl_host_benchmark_cycles() - start_cycles;
+    compress_cost.nanoseconds += sl_host_benchmark_now_ns() - start_ns;
+
+    start_ns = sl_host_benchmark_now_ns();
+    start_cycles = sl_host_benchmark_cycles();
+    if ((SL_STATUS_OK != sl_decompress_message(compressed,
+                                               compressed_len,
+                                               restored,
+                                               sizeof(restored),
+                                               &restored_len))
+        || (restored_len != message_len)
+        || (0 != memcmp(restored, message, message_len))) {
+      printf("sl_host_compress_benchmark : round trip failed for %.*s\n",
+             (int)message_len,
+             message);
+      return 1;
+    }
+    decompress_cost.cycles += sl_host_benchmark_cycles() - start_cycles;
+    decompress_cost.nanoseconds += sl_host_benchmark_now_ns() - start_ns;
+
+    compressed_count++;
+    output_bytes += compressed_len;
+
+    if (verbose && (index < 8)) {
+      printf("%3u -> %3u bytes : %.*s\n",
+             message_len,
+             compressed_len,
+             (int)message_len,
+             message);
+    }
+  }
+
+  if (0 == input_bytes) {
+    return 1;
+  }
+
+  printf("messages           : %u, %llu compressed\n",
+         message_count,
+         (unsigned long long)compressed_count);
+  printf("bytes              : %llu -> %llu\n",
+         (unsigned long long)input_bytes,
+         (unsigned long long)output_bytes);
+  printf("ratio              : %.2f (%.1f%% saved)\n",
+         (double)input_bytes / output_bytes,
+         100.0 * (double)(input_bytes - output_bytes) / input_bytes);
+  sl_host_benchmark_print_cost("compress", &compress_cost, input_bytes);
+  sl_host_benchmark_print_cost("decompress", &decompress_cost, input_bytes);
+
+  return 0;
+}
@@ -0,0 +1,272 @@
+/***************************************************************************/ /**
+ * @file sl_host_driver_stubs.c
+ * @brief Sensor driver and calendar stubs for the host build of the
+ * application
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <math.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include <sl_si91x_si70xx.h>
+#include <sl_si91x_calendar.h>
+#include <sl_wifi_asset_tracking_clock.h>
+#include <sparkfun_bmi270.h>
+#include <gnss_max_m10s_driver.h>
+#include <sl_host_driver_stubs.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_STUB_DEFAULT_READ_TIME_US       2000   ///< Si7021 conversion and I2C transfer
+#define HOST_STUB_LATITUDE_E7                173850440  ///< Start of the simulated track
+#define HOST_STUB_LONGITUDE_E7               784866710  ///< Start of the simulated track
+#define HOST_STUB_HEIGHT_MM                  505000 ///< Height of the simulated track
+#define HOST_STUB_TRACK_STEP_E7              25     ///< Movement per position read
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for stub state shared by every sensor task
+typedef struct {
+  pthread_mutex_t lock;         ///< Guards the fields below
+  uint32_t read_time_us;        ///< Duration of one read
+  uint32_t failure_per_mille;   ///< Share of failed reads
+  uint32_t random;              ///< xorshift state
+  uint32_t reads;               ///< Reads so far, drives the readings
+  sl_ubx_nav_pvt_t nav_pvt;     ///< Position handed out by the GNSS stub
+} sl_host_driver_stubs_t;
+
+/// Stub state
+static sl_host_driver_stubs_t sl_host_driver_stubs = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+  .read_time_us = HOST_STUB_DEFAULT_READ_TIME_US,
+  .random = 1,
+};
+
+/**************************************************************************/ /**
+ * @brief Next pseudo random number, call with the lock held.
+ ******************************************************************************/
+static uint32_t sl_host_driver_stubs_random(void)
+{
+  uint32_t value = sl_host_driver_stubs.random;
+
+  value ^= value << 13;
+  value ^= value >> 17;
+  value ^= value << 5;
+  sl_host_driver_stubs.random = value;
+
+  return value;
+}
+
+/**************************************************************************/ /**
+ * @brief Block for one read and decide whether it fails.
+ * @param[out] sequence : read number, drives the reading.
+ * @param[out] noise : in [-1, 1], noise of the reading.
+ * @return SL_STATUS_OK, or SL_STATUS_FAIL for an injected failure.
+ ******************************************************************************/
+static sl_status_t sl_host_driver_stubs_read(uint32_t *sequence, double *noise)
+{
+  struct timespec delay;
+  bool is_failed;
+
+  pthread_mutex_lock(&sl_host_driver_stubs.lock);
+  delay.tv_sec = (time_t)(sl_host_driver_stubs.read_time_us / 1000000);
+  delay.tv_nsec = (long)(sl_host_driver_stubs.read_time_us % 1000000) * 1000;
+  is_failed = (sl_host_driver_stubs_random() % 1000)
+              < sl_host_driver_stubs.failure_per_mille;
+  *noise = ((double)(sl_host_driver_stubs_random() % 2001) / 1000.0) - 1.0;
+  *sequence = sl_host_driver_stubs.reads++;
+  pthread_mutex_unlock(&sl_host_driver_stubs.lock);
+
+  /// Bus transfer blocks the task, other tasks go on
+  while (0 != nanosleep(&delay, &delay)) {
+  }
+
+  return is_failed ? SL_STATUS_FAIL : SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to set how the stubbed reads behave.
+ *****************************************************************************/
+void sl_host_driver_stubs_configure(uint32_t read_time_us,
+                                    uint32_t failure_per_mille,
+                                    uint32_t seed)
+{
+  pthread_mutex_lock(&sl_host_driver_stubs.lock);
+  sl_host_driver_stubs.read_time_us = read_time_us;
+  sl_host_driver_stubs.failure_per_mille =
+    (failure_per_mille > 1000) ? 1000 : failure_per_mille;
+  /// xorshift must not start at 0
+  sl_host_driver_stubs.random = (0 == seed) ? 1 : seed;
+  sl_host_driver_stubs.reads = 0;
+  pthread_mutex_unlock(&sl_host_driver_stubs.lock);
+}
+
+/******************************************************************************
+ *  Function to read relative humidity and temperature.
+ *****************************************************************************/
+sl_status_t sl_si91x_si70xx_read_temp_from_rh(sl_i2c_instance_t i2c_instance,
+                                              uint8_t addr,
+                                              uint32_t *humid_data,
+                                              int32_t *temp_data)
+{
+  uint32_t sequence;
+  double noise;
+
+  (void)i2c_instance;
+  (void)addr;
+
+  if (SL_STATUS_OK != sl_host_driver_stubs_read(&sequence, &noise)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Slow daily swing, the sensor reports whole units to the application
+  *temp_data = (int32_t)lround(24.0 + (3.0 * sin(sequence / 500.0)) + noise);
+  *humid_data = (uint32_t)lround(41.0 - (5.0 * sin(sequence / 500.0)) + noise);
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to read the accelerometer.
+ *****************************************************************************/
+sl_status_t sparkfun_bmi270_read_acc_reading(bmi270_cfg_data_t *cfg, double *acc)
+{
+  uint32_t sequence;
+  double noise;
+
+  (void)cfg;
+
+  if (SL_STATUS_OK != sl_host_driver_stubs_read(&sequence, &noise)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Board lying flat, gravity on z
+  acc[0] = 0.01 * noise;
+  acc[1] = -0.02 * noise;
+  acc[2] = 0.98 + (0.01 * noise);
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to read the gyroscope.
+ *****************************************************************************/
+sl_status_t sparkfun_bmi270_read_gyro_reading(bmi270_cfg_data_t *cfg,
+                                              double *gyro)
+{
+  uint32_t sequence;
+  double noise;
+
+  (void)cfg;
+
+  if (SL_STATUS_OK != sl_host_driver_stubs_read(&sequence, &noise)) {
+    return SL_STATUS_FAIL;
+  }
+
+  gyro[0] = 0.3 * noise;
+  gyro[1] = -0.1 * noise;
+  gyro[2] = 0.05 * noise;
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to read the fix type.
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_get_fix_type(sl_max_m10s_cfg_data_t *cfg,
+                                       uint16_t timeout,
+                                       uint8_t *fix_type)
+{
+  uint32_t sequence;
+  double noise;
+
+  (void)cfg;
+  (void)timeout;
+
+  if (SL_STATUS_OK != sl_host_driver_stubs_read(&sequence, &noise)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Mostly a 3D fix, a 2D fix when few satellites are in view
+  *fix_type = (noise < -0.8) ? 2 : 3;
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to read a position.
+ *****************************************************************************/
+sl_status_t gnss_max_m10s_get_nav_pvt(sl_max_m10s_cfg_data_t *cfg,
+                                      uint16_t timeout)
+{
+  uint32_t sequence;
+  double noise;
+
+  (void)timeout;
+
+  if (SL_STATUS_OK != sl_host_driver_stubs_read(&sequence, &noise)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Asset moves north-east along a straight track
+  pthread_mutex_lock(&sl_host_driver_stubs.lock);
+  sl_host_driver_stubs.nav_pvt.data.lat =
+    HOST_STUB_LATITUDE_E7 + (int32_t)(sequence * HOST_STUB_TRACK_STEP_E7);
+  sl_host_driver_stubs.nav_pvt.data.lon =
+    HOST_STUB_LONGITUDE_E7 + (int32_t)(sequence * HOST_STUB_TRACK_STEP_E7);
+  sl_host_driver_stubs.nav_pvt.data.hMSL =
+    HOST_STUB_HEIGHT_MM + (int32_t)(noise * 1000.0);
+  sl_host_driver_stubs.nav_pvt.data.numSV = (uint8_t)(8 + (int)(3.0 * noise));
+  sl_host_driver_stubs.nav_pvt.data.fixType = 3;
+  pthread_mutex_unlock(&sl_host_driver_stubs.lock);
+
+  cfg->protocol_type = SL_MAX_M10S_PROTOCOL_UBX;
+  cfg->packetUBXNAVPVT = &sl_host_driver_stubs.nav_pvt;
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to read the calendar, host UTC time stands in for SNTP time.
+ *****************************************************************************/
+sl_status_t sl_si91x_calendar_get_date_time(sl_calendar_datetime_config_t *config)
+{
+  struct timespec now;
+  struct tm utc;
+
+  if (NULL == config) {
+    return SL_STATUS_FAIL;
+  }
+
+  clock_gettime(CLOCK_REALTIME, &now);
+  gmtime_r(&now.tv_sec, &utc);
+
+  /// Century holds the first digit of the year as the firmware clock sets
+  /// it, not the year divided by 100
+  config->Century =
+    (uint8_t)((utc.tm_year + 1900) / CLOCK_YEAR_PER_CENTURY_DIGIT);
+  config->Year = (uint8_t)((utc.tm_year + 1900) % 100);
+  config->Month = (sl_calendar_month_t)(utc.tm_mon + 1);
+  config->DayOfWeek = (sl_calendar_days_of_week_t)utc.tm_wday;
+  config->Day = (uint8_t)utc.tm_mday;
+  config->Hour = (uint8_t)utc.tm_hour;
+  config->Minute = (uint8_t)utc.tm_min;
+  config->Second = (uint8_t)utc.tm_sec;
+  config->MilliSeconds = (uint16_t)(now.tv_nsec / 1000000);
+
+  return SL_STATUS_OK;
+}
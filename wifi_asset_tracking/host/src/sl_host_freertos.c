@@ -0,0 +1,632 @@
+/***************************************************************************/ /**
+ * @file sl_host_freertos.c
+ * @brief Host stand-in for the FreeRTOS kernel subset used by the application
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+#include <sl_host_freertos.h>
+
+/// @brief Structure for a task, one POSIX thread
+struct tskTaskControlBlock {
+  pthread_t thread;                                       ///< Thread of the task
+  char name[configMAX_TASK_NAME_LEN];                     ///< Task name
+  TaskFunction_t function;                                ///< Entry function
+  void *parameter;                                        ///< Entry parameter
+  pthread_mutex_t lock;                                   ///< Guards notification state
+  pthread_cond_t notified;                                ///< Signalled on every notification
+  uint32_t value[configTASK_NOTIFICATION_ARRAY_ENTRIES];  ///< Notification values
+  bool pending[configTASK_NOTIFICATION_ARRAY_ENTRIES];    ///< Notified since last wait
+};
+
+/// @brief Structure for a queue, ring of fixed size items
+struct QueueDefinition {
+  pthread_mutex_t lock;         ///< Guards ring state
+  pthread_cond_t changed;       ///< Signalled on every send and receive
+  uint8_t *storage;             ///< Items, NULL for semaphores
+  UBaseType_t length;           ///< Item slots
+  UBaseType_t item_size;        ///< In bytes, 0 for semaphores
+  UBaseType_t head;             ///< Slot of the front item
+  UBaseType_t count;            ///< Items held
+};
+
+/// Critical sections of every task
+static pthread_mutex_t sl_host_freertos_critical;
+
+/// Tick zero, critical section and task lookup are set up once
+static pthread_once_t sl_host_freertos_once = PTHREAD_ONCE_INIT;
+
+/// Monotonic time of tick zero
+static struct timespec sl_host_freertos_start;
+
+/// Task of the calling thread
+static pthread_key_t sl_host_freertos_current;
+
+/**************************************************************************/ /**
+ * @brief Set up tick zero, critical section and task lookup.
+ ******************************************************************************/
+static void sl_host_freertos_init(void)
+{
+  pthread_mutexattr_t attr;
+
+  /// Critical sections nest like on the target
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&sl_host_freertos_critical, &attr);
+  pthread_mutexattr_destroy(&attr);
+
+  clock_gettime(CLOCK_MONOTONIC, &sl_host_freertos_start);
+  pthread_key_create(&sl_host_freertos_current, NULL);
+}
+
+/**************************************************************************/ /**
+ * @brief Condition variable timed on the monotonic clock.
+ ******************************************************************************/
+static void sl_host_freertos_cond_init(pthread_cond_t *cond)
+{
+  pthread_condattr_t attr;
+
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(cond, &attr);
+  pthread_condattr_destroy(&attr);
+}
+
+/**************************************************************************/ /**
+ * @brief Monotonic deadline wait ticks from now.
+ ******************************************************************************/
+static void sl_host_freertos_deadline(TickType_t wait, struct timespec *deadline)
+{
+  uint64_t wait_us = sl_host_freertos_ticks_to_us(wait);
+
+  clock_gettime(CLOCK_MONOTONIC, deadline);
+  deadline->tv_sec += (time_t)(wait_us / 1000000);
+  deadline->tv_nsec += (long)((wait_us % 1000000) * 1000);
+  if (deadline->tv_nsec >= 1000000000L) {
+    deadline->tv_sec++;
+    deadline->tv_nsec -= 1000000000L;
+  }
+}
+
+/**************************************************************************/ /**
+ * @brief Wait on a condition until woken or the deadline passed.
+ * @return false when the deadline passed.
+ ******************************************************************************/
+static bool sl_host_freertos_wait(pthread_cond_t *cond,
+                                  pthread_mutex_t *lock,
+                                  TickType_t wait,
+                                  const struct timespec *deadline)
+{
+  if (0 == wait) {
+    return false;
+  }
+  if (portMAX_DELAY == wait) {
+    pthread_cond_wait(cond, lock);
+    return true;
+  }
+
+  return (0 == pthread_cond_timedwait(cond, lock, deadline));
+}
+
+/**************************************************************************/ /**
+ * @brief Thread entry of a task.
+ ******************************************************************************/
+static void *sl_host_freertos_task_entry(void *argument)
+{
+  TaskHandle_t task = argument;
+
+  pthread_setspecific(sl_host_freertos_current, task);
+  task->function(task->parameter);
+
+  return NULL;
+}
+
+/******************************************************************************
+ *  Function to enter the critical section.
+ *****************************************************************************/
+void vHostEnterCritical(void)
+{
+  pthread_once(&sl_host_freertos_once, sl_host_freertos_init);
+  pthread_mutex_lock(&sl_host_freertos_critical);
+}
+
+/******************************************************************************
+ *  Function to leave the critical section.
+ *****************************************************************************/
+void vHostExitCritical(void)
+{
+  pthread_mutex_unlock(&sl_host_freertos_critical);
+}
+
+/******************************************************************************
+ *  Function to get the free heap.
+ *****************************************************************************/
+size_t xPortGetFreeHeapSize(void)
+{
+  return SIZE_MAX;
+}
+
+/******************************************************************************
+ *  Function to get the least free heap since start.
+ *****************************************************************************/
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+  return SIZE_MAX;
+}
+
+/******************************************************************************
+ *  Function to convert ticks into microseconds.
+ *****************************************************************************/
+uint64_t sl_host_freertos_ticks_to_us(TickType_t ticks)
+{
+  return ((uint64_t)ticks * 1000000) / HOST_FREERTOS_TICKS_PER_SECOND;
+}
+
+/******************************************************************************
+ *  Function to start a task on its own thread.
+ *****************************************************************************/
+BaseType_t xTaskCreate(TaskFunction_t function,
+                       const char *name,
+                       uint32_t stack_depth,
+                       void *parameter,
+                       UBaseType_t priority,
+                       TaskHandle_t *handle)
+{
+  TaskHandle_t task;
+
+  (void)stack_depth;
+  (void)priority;
+  pthread_once(&sl_host_freertos_once, sl_host_freertos_init);
+
+  task = calloc(1, sizeof(*task));
+  if (NULL == task) {
+    return pdFAIL;
+  }
+
+  snprintf(task->name, sizeof(task->name), "%s", name);
+  task->function = function;
+  task->parameter = parameter;
+  pthread_mutex_init(&task->lock, NULL);
+  sl_host_freertos_cond_init(&task->notified);
+
+  /// Handle is set before the task runs, like on the target
+  if (NULL != handle) {
+    *handle = task;
+  }
+  if (0 != pthread_create(&task->thread,
+                          NULL,
+                          sl_host_freertos_task_entry,
+                          task)) {
+    if (NULL != handle) {
+      *handle = NULL;
+    }
+    pthread_cond_destroy(&task->notified);
+    pthread_mutex_destroy(&task->lock);
+    free(task);
+    return pdFAIL;
+  }
+
+  return pdPASS;
+}
+
+/******************************************************************************
+ *  Function to end the calling task.
+ *****************************************************************************/
+void vTaskDelete(TaskHandle_t task)
+{
+  if ((NULL != task) && (xTaskGetCurrentTaskHandle() != task)) {
+    printf("vTaskDelete : only the calling task can be deleted on host\n");
+    return;
+  }
+
+  pthread_exit(NULL);
+}
+
+/******************************************************************************
+ *  Function to wait until a task ended, then release it.
+ *****************************************************************************/
+void sl_host_freertos_join(TaskHandle_t task)
+{
+  if (NULL == task) {
+    return;
+  }
+
+  pthread_join(task->thread, NULL);
+  pthread_cond_destroy(&task->notified);
+  pthread_mutex_destroy(&task->lock);
+  free(task);
+}
+
+/******************************************************************************
+ *  Function to block the calling task.
+ *****************************************************************************/
+void vTaskDelay(TickType_t ticks)
+{
+  uint64_t delay_us = sl_host_freertos_ticks_to_us(ticks);
+  struct timespec delay;
+
+  delay.tv_sec = (time_t)(delay_us / 1000000);
+  delay.tv_nsec = (long)((delay_us % 1000000) * 1000);
+  while (0 != nanosleep(&delay, &delay)) {
+  }
+}
+
+/******************************************************************************
+ *  Function to get the ticks since the kernel was started.
+ *****************************************************************************/
+TickType_t xTaskGetTickCount(void)
+{
+  struct timespec now;
+  uint64_t elapsed_us;
+
+  pthread_once(&sl_host_freertos_once, sl_host_freertos_init);
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  elapsed_us =
+    ((uint64_t)(now.tv_sec - sl_host_freertos_start.tv_sec) * 1000000)
+    + (uint64_t)((now.tv_nsec - sl_host_freertos_start.tv_nsec) / 1000);
+
+  return (TickType_t)((elapsed_us * HOST_FREERTOS_TICKS_PER_SECOND) / 1000000);
+}
+
+/******************************************************************************
+ *  Function to get the calling task.
+ *****************************************************************************/
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+  pthread_once(&sl_host_freertos_once, sl_host_freertos_init);
+  return pthread_getspecific(sl_host_freertos_current);
+}
+
+/******************************************************************************
+ *  Function to get the name of a task.
+ *****************************************************************************/
+char *pcTaskGetName(TaskHandle_t task)
+{
+  if (NULL == task) {
+    task = xTaskGetCurrentTaskHandle();
+  }
+
+  return (NULL == task) ? NULL : task->name;
+}
+
+/******************************************************************************
+ *  Function to get the least unused stack of a task.
+ *****************************************************************************/
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+  (void)task;
+  return 0;
+}
+
+/******************************************************************************
+ *  Function to update a notification value of a task and wake it.
+ *****************************************************************************/
+BaseType_t xTaskGenericNotify(TaskHandle_t task,
+                              UBaseType_t index,
+                              uint32_t value,
+                              eNotifyAction action,
+                              uint32_t *previous)
+{
+  BaseType_t result = pdPASS;
+
+  if ((NULL == task) || (index >= configTASK_NOTIFICATION_ARRAY_ENTRIES)) {
+    return pdFAIL;
+  }
+
+  pthread_mutex_lock(&task->lock);
+  if (NULL != previous) {
+    *previous = task->value[index];
+  }
+
+  switch (action) {
+    case eSetBits:
+      task->value[index] |= value;
+      break;
+    case eIncrement:
+      task->value[index]++;
+      break;
+    case eSetValueWithOverwrite:
+      task->value[index] = value;
+      break;
+    case eSetValueWithoutOverwrite:
+      if (task->pending[index]) {
+        result = pdFAIL;
+      } else {
+        task->value[index] = value;
+      }
+      break;
+    default:
+      break;
+  }
+
+  if (pdPASS == result) {
+    task->pending[index] = true;
+    pthread_cond_broadcast(&task->notified);
+  }
+  pthread_mutex_unlock(&task->lock);
+
+  return result;
+}
+
+/******************************************************************************
+ *  Function to wait until a notification value is non-zero.
+ *****************************************************************************/
+uint32_t ulTaskGenericNotifyTake(UBaseType_t index,
+                                 BaseType_t clear_on_exit,
+                                 TickType_t wait)
+{
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  struct timespec deadline;
+  uint32_t value;
+
+  if ((NULL == task) || (index >= configTASK_NOTIFICATION_ARRAY_ENTRIES)) {
+    return 0;
+  }
+
+  sl_host_freertos_deadline(wait, &deadline);
+  pthread_mutex_lock(&task->lock);
+  while ((0 == task->value[index])
+         && sl_host_freertos_wait(&task->notified, &task->lock, wait, &deadline)) {
+  }
+
+  value = task->value[index];
+  if (0 != value) {
+    task->value[index] = (pdFALSE != clear_on_exit) ? 0 : (value - 1);
+  }
+  task->pending[index] = false;
+  pthread_mutex_unlock(&task->lock);
+
+  return value;
+}
+
+/******************************************************************************
+ *  Function to wait for a notification on an index.
+ *****************************************************************************/
+BaseType_t xTaskNotifyWaitIndexed(UBaseType_t index,
+                                  uint32_t clear_on_entry,
+                                  uint32_t clear_on_exit,
+                                  uint32_t *value,
+                                  TickType_t wait)
+{
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  struct timespec deadline;
+  BaseType_t result = pdFALSE;
+
+  if ((NULL == task) || (index >= configTASK_NOTIFICATION_ARRAY_ENTRIES)) {
+    return pdFALSE;
+  }
+
+  sl_host_freertos_deadline(wait, &deadline);
+  pthread_mutex_lock(&task->lock);
+  if (!task->pending[index]) {
+    task->value[index] &= ~clear_on_entry;
+  }
+  while (!task->pending[index]
+         && sl_host_freertos_wait(&task->notified, &task->lock, wait, &deadline)) {
+  }
+
+  if (NULL != value) {
+    *value = task->value[index];
+  }
+  if (task->pending[index]) {
+    task->value[index] &= ~clear_on_exit;
+    task->pending[index] = false;
+    result = pdTRUE;
+  }
+  pthread_mutex_unlock(&task->lock);
+
+  return result;
+}
+
+/******************************************************************************
+ *  Function to create a queue.
+ *****************************************************************************/
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+  QueueHandle_t queue;
+
+  if (0 == length) {
+    return NULL;
+  }
+
+  queue = calloc(1, sizeof(*queue));
+  if (NULL == queue) {
+    return NULL;
+  }
+
+  if (0 != item_size) {
+    queue->storage = malloc(length * item_size);
+    if (NULL == queue->storage) {
+      free(queue);
+      return NULL;
+    }
+  }
+
+  queue->length = length;
+  queue->item_size = item_size;
+  pthread_mutex_init(&queue->lock, NULL);
+  sl_host_freertos_cond_init(&queue->changed);
+
+  return queue;
+}
+
+/******************************************************************************
+ *  Function to delete a queue.
+ *****************************************************************************/
+void vQueueDelete(QueueHandle_t queue)
+{
+  if (NULL == queue) {
+    return;
+  }
+
+  pthread_cond_destroy(&queue->changed);
+  pthread_mutex_destroy(&queue->lock);
+  free(queue->storage);
+  free(queue);
+}
+
+/******************************************************************************
+ *  Function to copy an item into a queue.
+ *****************************************************************************/
+BaseType_t xQueueGenericSend(QueueHandle_t queue,
+                             const void *item,
+                             TickType_t wait,
+                             BaseType_t position)
+{
+  struct timespec deadline;
+  UBaseType_t slot;
+
+  if (NULL == queue) {
+    return pdFAIL;
+  }
+
+  sl_host_freertos_deadline(wait, &deadline);
+  pthread_mutex_lock(&queue->lock);
+  while ((queue->count == queue->length)
+         && sl_host_freertos_wait(&queue->changed, &queue->lock, wait, &deadline)) {
+  }
+  if (queue->count == queue->length) {
+    pthread_mutex_unlock(&queue->lock);
+    return pdFAIL;
+  }
+
+  if (queueSEND_TO_FRONT == position) {
+    queue->head = (queue->head + queue->length - 1) % queue->length;
+    slot = queue->head;
+  } else {
+    slot = (queue->head + queue->count) % queue->length;
+  }
+  if ((0 != queue->item_size) && (NULL != item)) {
+    memcpy(queue->storage + (slot * queue->item_size), item, queue->item_size);
+  }
+  queue->count++;
+
+  pthread_cond_broadcast(&queue->changed);
+  pthread_mutex_unlock(&queue->lock);
+
+  return pdPASS;
+}
+
+/******************************************************************************
+ *  Function to take or copy the front item of a queue.
+ *****************************************************************************/
+static BaseType_t sl_host_freertos_queue_read(QueueHandle_t queue,
+                                              void *item,
+                                              TickType_t wait,
+                                              bool remove)
+{
+  struct timespec deadline;
+
+  if (NULL == queue) {
+    return pdFAIL;
+  }
+
+  sl_host_freertos_deadline(wait, &deadline);
+  pthread_mutex_lock(&queue->lock);
+  while ((0 == queue->count)
+         && sl_host_freertos_wait(&queue->changed, &queue->lock, wait, &deadline)) {
+  }
+  if (0 == queue->count) {
+    pthread_mutex_unlock(&queue->lock);
+    return pdFAIL;
+  }
+
+  if ((0 != queue->item_size) && (NULL != item)) {
+    memcpy(item,
+           queue->storage + (queue->head * queue->item_size),
+           queue->item_size);
+  }
+  if (remove) {
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    pthread_cond_broadcast(&queue->changed);
+  }
+  pthread_mutex_unlock(&queue->lock);
+
+  return pdPASS;
+}
+
+/******************************************************************************
+ *  Function to take the front item of a queue.
+ *****************************************************************************/
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait)
+{
+  return sl_host_freertos_queue_read(queue, item, wait, true);
+}
+
+/******************************************************************************
+ *  Function to copy the front item of a queue.
+ *****************************************************************************/
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t wait)
+{
+  return sl_host_freertos_queue_read(queue, item, wait, false);
+}
+
+/******************************************************************************
+ *  Function to get the items in a queue.
+ *****************************************************************************/
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+  UBaseType_t count;
+
+  pthread_mutex_lock(&queue->lock);
+  count = queue->count;
+  pthread_mutex_unlock(&queue->lock);
+
+  return count;
+}
+
+/******************************************************************************
+ *  Function to get the free slots of a queue.
+ *****************************************************************************/
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+  UBaseType_t spaces;
+
+  pthread_mutex_lock(&queue->lock);
+  spaces = queue->length - queue->count;
+  pthread_mutex_unlock(&queue->lock);
+
+  return spaces;
+}
+
+/******************************************************************************
+ *  Function to create a mutex, available at start.
+ *****************************************************************************/
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+  SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+
+  if (NULL != mutex) {
+    xSemaphoreGive(mutex);
+  }
+
+  return mutex;
+}
+
+/******************************************************************************
+ *  Function to create a binary semaphore, taken at start.
+ *****************************************************************************/
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+  return xQueueCreate(1, 0);
+}
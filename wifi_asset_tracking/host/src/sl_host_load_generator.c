@@ -0,0 +1,407 @@
+/***************************************************************************/ /**
+ * @file sl_host_load_generator.c
+ * @brief Virtual device load generator publishing firmware telemetry over
+ * the POSIX transport backend
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sl_host_transport_posix.h>
+#include <sl_host_mqtt.h>
+#include <sl_host_payload.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_LOAD_DEFAULT_HOST               "127.0.0.1" ///< Broker host
+#define HOST_LOAD_DEFAULT_PORT               1883   ///< Broker port
+#define HOST_LOAD_DEFAULT_DEVICES            100    ///< Virtual devices
+#define HOST_LOAD_DEFAULT_MESSAGES           100    ///< Messages per device
+#define HOST_LOAD_DEFAULT_WORKERS            8      ///< Worker threads
+#define HOST_LOAD_KEEP_ALIVE                 60     ///< In seconds, MQTT keep alive
+#define HOST_LOAD_MAX_DEVICE_ID_SIZE         32     ///< Virtual device ID length
+#define HOST_LOAD_MAX_TOPIC_SIZE             128    ///< Telemetry topic length
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one virtual device
+typedef struct {
+  char device_id[HOST_LOAD_MAX_DEVICE_ID_SIZE];    ///< MQTT client identifier
+  char topic[HOST_LOAD_MAX_TOPIC_SIZE];            ///< Telemetry topic
+  bool is_connected;                               ///< MQTT session established
+  sl_transport_interface_t transport;              ///< Transport of the device
+  sl_host_transport_posix_context_t socket;        ///< Socket of the device
+  sl_host_mqtt_client_t mqtt;                      ///< MQTT state of the device
+} sl_host_load_device_t;
+
+/// @brief Structure for run configuration
+typedef struct {
+  const char *host_name;        ///< Broker host name
+  uint16_t port;                ///< Broker port
+  uint32_t devices;             ///< Number of virtual devices
+  uint32_t messages;            ///< Messages per device
+  uint32_t workers;             ///< Worker threads
+  uint32_t interval_ms;         ///< Pause between rounds of one worker
+  uint8_t qos;                  ///< Publish QoS, latency needs QoS 1
+  bool use_tls;                 ///< Use TLS transport
+} sl_host_load_config_t;
+
+/// @brief Structure for one worker thread
+typedef struct {
+  pthread_t thread;             ///< Worker thread
+  uint32_t first_device;        ///< First device index served by the worker
+  uint32_t device_count;        ///< Devices served by the worker
+  uint32_t *latency_us;         ///< Publish to PUBACK latencies
+  uint32_t latency_count;       ///< Number of latencies recorded
+  uint64_t published;           ///< Messages published
+  uint64_t payload_bytes;       ///< Payload bytes published
+  uint32_t failures;            ///< Failed connects or publishes
+} sl_host_load_worker_t;
+
+/// Run configuration shared by workers
+static sl_host_load_config_t sl_host_load_config;
+
+/// All virtual devices
+static sl_host_load_device_t *sl_host_load_devices;
+
+/// Workers wait here until every device is connected
+static pthread_barrier_t sl_host_load_barrier;
+
+/**************************************************************************/ /**
+ * @brief Monotonic time in microseconds.
+ ******************************************************************************/
+static uint64_t sl_host_load_now_us(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+/**************************************************************************/ /**
+ * @brief Resident set size of the process in bytes.
+ ******************************************************************************/
+static uint64_t sl_host_load_rss_bytes(void)
+{
+  unsigned long pages = 0;
+  unsigned long resident = 0;
+  FILE *statm = fopen("/proc/self/statm", "r");
+
+  if (NULL == statm) {
+    return 0;
+  }
+  if (2 != fscanf(statm, "%lu %lu", &pages, &resident)) {
+    resident = 0;
+  }
+  fclose(statm);
+
+  return (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE);
+}
+
+/**************************************************************************/ /**
+ * @brief Ascending order of latencies for percentiles.
+ ******************************************************************************/
+static int sl_host_load_compare(const void *first, const void *second)
+{
+  uint32_t a = *(const uint32_t *)first;
+  uint32_t b = *(const uint32_t *)second;
+
+  return (a > b) - (a < b);
+}
+
+/**************************************************************************/ /**
+ * @brief Worker thread: connect own devices, then publish round-robin.
+ ******************************************************************************/
+static void *sl_host_load_worker(void *argument)
+{
+  sl_host_load_worker_t *worker = argument;
+  sl_host_load_device_t *device;
+  char payload[HOST_PAYLOAD_MAX_SIZE];
+  uint32_t payload_len;
+  uint32_t sequence;
+  uint32_t index;
+  uint16_t packet_id;
+  uint64_t start_us;
+
+  for (index = 0; index < worker->device_count; ++index) {
+    device = &sl_host_load_devices[worker->first_device + index];
+
+    if ((SL_STATUS_OK
+         != sl_host_transport_posix_init(&device->transport,
+                                         &device->socket,
+                                         sl_host_load_config.use_tls))
+        || (SL_STATUS_OK
+            != device->transport.connect(device->transport.context,
+                                         sl_host_load_config.host_name,
+                                         sl_host_load_config.port))) {
+      worker->failures++;
+      continue;
+    }
+
+    if (SL_STATUS_OK != sl_host_mqtt_connect(&device->mqtt,
+                                             &device->transport,
+                                             device->device_id,
+                                             NULL,
+                                             HOST_LOAD_KEEP_ALIVE)) {
+      device->transport.disconnect(device->transport.context);
+      worker->failures++;
+      continue;
+    }
+
+    device->is_connected = true;
+  }
+
+  /// Memory is sampled by main thread once every connection is up
+  pthread_barrier_wait(&sl_host_load_barrier);
+  pthread_barrier_wait(&sl_host_load_barrier);
+
+  for (sequence = 0; sequence < sl_host_load_config.messages; ++sequence) {
+    for (index = 0; index < worker->device_count; ++index) {
+      device = &sl_host_load_devices[worker->first_device + index];
+      if (!device->is_connected) {
+        continue;
+      }
+
+      payload_len = sl_host_payload_build(payload,
+                                          worker->first_device + index,
+                                          sequence);
+
+      start_us = sl_host_load_now_us();
+      if (SL_STATUS_OK != sl_host_mqtt_publish(&device->mqtt,
+                                               device->topic,
+                                               (const uint8_t *)payload,
+                                               payload_len,
+                                               sl_host_load_config.qos,
+                                               &packet_id)) {
+        worker->failures++;
+        device->is_connected = false;
+        continue;
+      }
+
+      if (sl_host_load_config.qos > 0) {
+        if (SL_STATUS_OK
+            != sl_host_mqtt_wait_puback(&device->mqtt, packet_id)) {
+          worker->failures++;
+          device->is_connected = false;
+          continue;
+        }
+        worker->latency_us[worker->latency_count++] =
+          (uint32_t)(sl_host_load_now_us() - start_us);
+      }
+
+      worker->published++;
+      worker->payload_bytes += payload_len;
+    }
+
+    if (sl_host_load_config.interval_ms > 0) {
+      usleep(sl_host_load_config.interval_ms * 1000);
+    }
+  }
+
+  for (index = 0; index < worker->device_count; ++index) {
+    device = &sl_host_load_devices[worker->first_device + index];
+    if (device->is_connected) {
+      sl_host_mqtt_disconnect(&device->mqtt);
+    }
+  }
+
+  return NULL;
+}
+
+/**************************************************************************/ /**
+ * @brief Print command line usage.
+ ******************************************************************************/
+static void sl_host_load_usage(const char *name)
+{
+  printf("usage: %s [-H host] [-p port] [-d devices] [-m messages]\n"
+         "          [-w workers] [-i interval_ms] [-q qos] [-t]\n"
+         "  -t  use TLS (build with TLS=1)\n",
+         name);
+}
+
+/**************************************************************************/ /**
+ * @brief Load generator entry point.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  sl_host_load_worker_t *workers;
+  uint32_t *latency_us;
+  uint32_t latency_count = 0;
+  uint64_t published = 0;
+  uint64_t payload_bytes = 0;
+  uint32_t failures = 0;
+  uint64_t rss_before;
+  uint64_t rss_connected;
+  uint64_t start_us;
+  uint64_t elapsed_us;
+  uint32_t share;
+  uint32_t index;
+  int option;
+
+  sl_host_load_config.host_name = HOST_LOAD_DEFAULT_HOST;
+  sl_host_load_config.port = HOST_LOAD_DEFAULT_PORT;
+  sl_host_load_config.devices = HOST_LOAD_DEFAULT_DEVICES;
+  sl_host_load_config.messages = HOST_LOAD_DEFAULT_MESSAGES;
+  sl_host_load_config.workers = HOST_LOAD_DEFAULT_WORKERS;
+  sl_host_load_config.qos = 1;
+
+  while (-1 != (option = getopt(argc, argv, "H:p:d:m:w:i:q:th"))) {
+    switch (option) {
+      case 'H':
+        sl_host_load_config.host_name = optarg;
+        break;
+      case 'p':
+        sl_host_load_config.port = (uint16_t)atoi(optarg);
+        break;
+      case 'd':
+        sl_host_load_config.devices = (uint32_t)atoi(optarg);
+        break;
+      case 'm':
+        sl_host_load_config.messages = (uint32_t)atoi(optarg);
+        break;
+      case 'w':
+        sl_host_load_config.workers = (uint32_t)atoi(optarg);
+        break;
+      case 'i':
+        sl_host_load_config.interval_ms = (uint32_t)atoi(optarg);
+        break;
+      case 'q':
+        sl_host_load_config.qos = (atoi(optarg) > 0) ? 1 : 0;
+        break;
+      case 't':
+        sl_host_load_config.use_tls = true;
+        break;
+      default:
+        sl_host_load_usage(argv[0]);
+        return 1;
+    }
+  }
+
+  if ((0 == sl_host_load_config.devices) || (0 == sl_host_load_config.workers)) {
+    sl_host_load_usage(argv[0]);
+    return 1;
+  }
+  if (sl_host_load_config.workers > sl_host_load_config.devices) {
+    sl_host_load_config.workers = sl_host_load_config.devices;
+  }
+
+  rss_before = sl_host_load_rss_bytes();
+
+  sl_host_load_devices = calloc(sl_host_load_config.devices,
+                                sizeof(sl_host_load_device_t));
+  workers = calloc(sl_host_load_config.workers, sizeof(sl_host_load_worker_t));
+  if ((NULL == sl_host_load_devices) || (NULL == workers)) {
+    printf("sl_host_load_generator : out of memory\n");
+    return 1;
+  }
+
+  for (index = 0; index < sl_host_load_config.devices; ++index) {
+    snprintf(sl_host_load_devices[index].device_id,
+             HOST_LOAD_MAX_DEVICE_ID_SIZE,
+             "virtual-device-%05u",
+             index);
+    snprintf(sl_host_load_devices[index].topic,
+             HOST_LOAD_MAX_TOPIC_SIZE,
+             HOST_MQTT_TELEMETRY_TOPIC_FORMAT,
+             sl_host_load_devices[index].device_id);
+  }
+
+  pthread_barrier_init(&sl_host_load_barrier,
+                       NULL,
+                       sl_host_load_config.workers + 1);
+
+  share = sl_host_load_config.devices / sl_host_load_config.workers;
+  for (index = 0; index < sl_host_load_config.workers; ++index) {
+    workers[index].first_device = index * share;
+    workers[index].device_count = (index == sl_host_load_config.workers - 1)
+                                  ? (sl_host_load_config.devices
+                                     - workers[index].first_device)
+                                  : share;
+    workers[index].latency_us =
+      calloc((size_t)workers[index].device_count
+             * sl_host_load_config.messages + 1,
+             sizeof(uint32_t));
+    pthread_create(&workers[index].thread,
+                   NULL,
+                   sl_host_load_worker,
+                   &workers[index]);
+  }
+
+  /// Sample memory with every connection established, before publishing
+  pthread_barrier_wait(&sl_host_load_barrier);
+  rss_connected = sl_host_load_rss_bytes();
+  start_us = sl_host_load_now_us();
+  pthread_barrier_wait(&sl_host_load_barrier);
+
+  for (index = 0; index < sl_host_load_config.workers; ++index) {
+    pthread_join(workers[index].thread, NULL);
+  }
+  elapsed_us = sl_host_load_now_us() - start_us;
+
+  latency_us = calloc((size_t)sl_host_load_config.devices
+                      * sl_host_load_config.messages + 1,
+                      sizeof(uint32_t));
+  for (index = 0; index < sl_host_load_config.workers; ++index) {
+    memcpy(&latency_us[latency_count],
+           workers[index].latency_us,
+           workers[index].latency_count * sizeof(uint32_t));
+    latency_count += workers[index].latency_count;
+    published += workers[index].published;
+    payload_bytes += workers[index].payload_bytes;
+    failures += workers[index].failures;
+    free(workers[index].latency_us);
+  }
+
+  printf("devices            : %u (%u workers, %s)\n",
+         sl_host_load_config.devices,
+         sl_host_load_config.workers,
+         sl_host_load_config.use_tls ? "tls" : "tcp");
+  printf("published          : %llu messages, %llu payload bytes\n",
+         (unsigned long long)published,
+         (unsigned long long)payload_bytes);
+  printf("failures           : %u\n", failures);
+  printf("throughput         : %.1f messages/s\n",
+         (elapsed_us > 0) ? ((double)published * 1e6 / (double)elapsed_us) : 0.0);
+
+  if (latency_count > 0) {
+    qsort(latency_us, latency_count, sizeof(uint32_t), sl_host_load_compare);
+    printf("latency us         : p50 %u  p90 %u  p99 %u  max %u\n",
+           latency_us[latency_count / 2],
+           latency_us[(latency_count * 90) / 100],
+           latency_us[(latency_count * 99) / 100],
+           latency_us[latency_count - 1]);
+  } else {
+    printf("latency us         : n/a (QoS 0)\n");
+  }
+
+  printf("memory/connection  : %zu bytes state, %llu bytes RSS\n",
+         sizeof(sl_host_load_device_t),
+         (unsigned long long)((rss_connected > rss_before)
+                              ? ((rss_connected - rss_before)
+                                 / sl_host_load_config.devices)
+                              : 0));
+
+  pthread_barrier_destroy(&sl_host_load_barrier);
+  free(latency_us);
+  free(workers);
+  free(sl_host_load_devices);
+
+  return (0 == failures) ? 0 : 2;
+}
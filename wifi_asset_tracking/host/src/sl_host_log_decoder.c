@@ -0,0 +1,249 @@
+/***************************************************************************/ /**
+ * @file sl_host_log_decoder.c
+ * @brief Expands deferred log records of a console capture into text
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sl_wifi_asset_tracking_log_format.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_LOG_LINE_SIZE                   512    ///< Longest console line
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for totals of a self test run
+typedef struct {
+  uint64_t records;         ///< Records checked
+  uint64_t frame_bytes;     ///< Console bytes of binary output
+  uint64_t text_bytes;      ///< Console bytes of text output
+  uint32_t longest_text;    ///< Longest formatted record
+} sl_host_log_stats_t;
+
+/**************************************************************************/ /**
+ * @brief Pseudo random number, same sequence on every host.
+ ******************************************************************************/
+static uint32_t sl_host_log_random(uint32_t *state)
+{
+  *state = (*state * 1103515245u) + 12345u;
+  return *state >> 8;
+}
+
+/**************************************************************************/ /**
+ * @brief Count the conversions of a format, "%%" is not one.
+ ******************************************************************************/
+static uint8_t sl_host_log_count_args(const char *format)
+{
+  uint8_t count = 0;
+
+  while ('\0' != *format) {
+    if ('%' == *format) {
+      format++;
+      if ('%' != *format) {
+        count++;
+      }
+      if ('\0' == *format) {
+        break;
+      }
+    }
+    format++;
+  }
+
+  return count;
+}
+
+/**************************************************************************/ /**
+ * @brief Print a record the way the firmware log task does, with time,
+ * level and module in front.
+ ******************************************************************************/
+static void sl_host_log_print(const sl_log_record_t *record)
+{
+  char text[LOG_TEXT_BUFF_SIZE];
+
+  if (SL_STATUS_OK != sl_log_format_record(record, text, sizeof(text))) {
+    printf("[%6lu.%03lu] %-5s %-6s unknown format %u with %u arguments\n",
+           (unsigned long)(record->time_ms / 1000),
+           (unsigned long)(record->time_ms % 1000),
+           sl_log_get_level_name(record->level),
+           sl_log_get_module_name(record->module),
+           record->format_id,
+           record->arg_count);
+    return;
+  }
+
+  printf("[%6lu.%03lu] %-5s %-6s %s\n",
+         (unsigned long)(record->time_ms / 1000),
+         (unsigned long)(record->time_ms % 1000),
+         sl_log_get_level_name(record->level),
+         sl_log_get_module_name(record->module),
+         text);
+}
+
+/**************************************************************************/ /**
+ * @brief Expand every record line of a console capture, other lines are
+ * passed through.
+ * @return 0 on success.
+ ******************************************************************************/
+static int sl_host_log_decode_file(FILE *file)
+{
+  char line[HOST_LOG_LINE_SIZE];
+  sl_log_record_t record;
+  char *marker;
+
+  while (NULL != fgets(line, sizeof(line), file)) {
+    line[strcspn(line, "\r\n")] = '\0';
+
+    marker = strstr(line, LOG_FRAME_MARKER);
+    if ((NULL != marker) && (SL_STATUS_OK == sl_log_decode_frame(marker, &record))) {
+      sl_host_log_print(&record);
+    } else if ('\0' != line[0]) {
+      printf("%s\n", line);
+    }
+  }
+
+  return 0;
+}
+
+/**************************************************************************/ /**
+ * @brief Encode and decode records of every format with random arguments and
+ * compare console size of binary and text output.
+ * @return 0 on success.
+ ******************************************************************************/
+static int sl_host_log_self_test(uint32_t count,
+                                 uint32_t seed,
+                                 sl_host_log_stats_t *stats)
+{
+  sl_log_record_t record;
+  sl_log_record_t decoded;
+  char frame[LOG_FRAME_MAX_SIZE];
+  char text[LOG_TEXT_BUFF_SIZE];
+  char decoded_text[LOG_TEXT_BUFF_SIZE];
+  uint32_t index;
+  uint8_t arg_index;
+
+  for (index = 0; index < count; ++index) {
+    memset(&record, 0, sizeof(record));
+    record.time_ms = sl_host_log_random(&seed);
+    record.format_id = (uint16_t)(index % SL_LOG_FMT_COUNT);
+    record.module = (uint8_t)(sl_host_log_random(&seed) % SL_LOG_MODULE_COUNT);
+    record.level = (uint8_t)(1 + (sl_host_log_random(&seed)
+                                  % (SL_LOG_LEVEL_COUNT - 1)));
+    record.arg_count =
+      sl_host_log_count_args(sl_log_get_format(record.format_id));
+    if (record.arg_count > LOG_MAX_ARGS) {
+      printf("sl_host_log_decoder : format %u has %u arguments, at most %u\n",
+             record.format_id,
+             record.arg_count,
+             LOG_MAX_ARGS);
+      return 1;
+    }
+    for (arg_index = 0; arg_index < record.arg_count; ++arg_index) {
+      record.args[arg_index] = sl_host_log_random(&seed)
+                               ^ (sl_host_log_random(&seed) << 16);
+    }
+
+    if ((SL_STATUS_OK != sl_log_format_record(&record, text, sizeof(text)))
+        || (SL_STATUS_OK != sl_log_encode_frame(&record, frame, sizeof(frame)))
+        || (SL_STATUS_OK != sl_log_decode_frame(frame, &decoded))
+        || (0 != memcmp(&record, &decoded, sizeof(record)))
+        || (SL_STATUS_OK
+            != sl_log_format_record(&decoded,
+                                    decoded_text,
+                                    sizeof(decoded_text)))
+        || (0 != strcmp(text, decoded_text))) {
+      printf("sl_host_log_decoder : round trip of format %u failed\n",
+             record.format_id);
+      return 1;
+    }
+
+    /// Both outputs are written between "\r\n" pairs by the log task
+    stats->records++;
+    stats->frame_bytes += strlen(frame) + 4;
+    stats->text_bytes += strlen(text) + 4;
+    if (strlen(text) > stats->longest_text) {
+      stats->longest_text = (uint32_t)strlen(text);
+    }
+  }
+
+  return 0;
+}
+
+/**************************************************************************/ /**
+ * @brief Log decoder entry point.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  sl_host_log_stats_t stats = { 0 };
+  uint32_t test_count = 0;
+  uint32_t seed = 1;
+  const char *file_name = NULL;
+  FILE *file = stdin;
+  int status;
+  int option;
+
+  while (-1 != (option = getopt(argc, argv, "f:t:s:h"))) {
+    switch (option) {
+      case 'f':
+        file_name = optarg;
+        break;
+      case 't':
+        test_count = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 's':
+        seed = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      default:
+        printf("usage: %s [-f console.log] [-t records] [-s seed]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  if (0 != test_count) {
+    if (0 != sl_host_log_self_test(test_count, seed, &stats)) {
+      return 1;
+    }
+
+    printf("log records        : %llu of %u formats, longest %u of %u bytes\n",
+           (unsigned long long)stats.records,
+           SL_LOG_FMT_COUNT,
+           stats.longest_text,
+           LOG_TEXT_BUFF_SIZE - 1);
+    printf("console output     : %.1f bytes binary, %.1f bytes text per record\n",
+           (double)stats.frame_bytes / stats.records,
+           (double)stats.text_bytes / stats.records);
+    return 0;
+  }
+
+  if (NULL != file_name) {
+    file = fopen(file_name, "r");
+    if (NULL == file) {
+      perror(file_name);
+      return 1;
+    }
+  }
+
+  status = sl_host_log_decode_file(file);
+
+  if (NULL != file_name) {
+    fclose(file);
+  }
+
+  return status;
+}
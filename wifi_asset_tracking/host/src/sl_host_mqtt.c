@@ -0,0 +1,395 @@
+/***************************************************************************/ /**
+ * @file sl_host_mqtt.c
+ * @brief Minimal MQTT 3.1.1 client used by host tools over the transport
+ * interface
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sl_host_mqtt.h>
+
+/**************************************************************************/ /**
+ * @brief Send a whole buffer on the transport.
+ ******************************************************************************/
+static sl_status_t sl_host_mqtt_send_all(sl_host_mqtt_client_t *client,
+                                         const uint8_t *buffer,
+                                         uint32_t length);
+
+/**************************************************************************/ /**
+ * @brief Receive exactly length bytes before deadline. Bytes beyond buffer
+ * are discarded when buffer is NULL.
+ ******************************************************************************/
+static sl_status_t sl_host_mqtt_recv_all(sl_host_mqtt_client_t *client,
+                                         uint8_t *buffer,
+                                         uint32_t length,
+                                         uint64_t deadline_ms);
+
+/**************************************************************************/ /**
+ * @brief Receive one packet; the body is kept in rx_buffer when it fits.
+ ******************************************************************************/
+static sl_status_t sl_host_mqtt_recv_packet(sl_host_mqtt_client_t *client,
+                                            uint8_t *packet_type,
+                                            uint32_t *body_len,
+                                            uint64_t deadline_ms);
+
+/**************************************************************************/ /**
+ * @brief Append a length-prefixed UTF-8 string.
+ ******************************************************************************/
+static uint32_t sl_host_mqtt_put_string(uint8_t *buffer, const char *string);
+
+/**************************************************************************/ /**
+ * @brief Monotonic time in milliseconds.
+ ******************************************************************************/
+static uint64_t sl_host_mqtt_now_ms(void);
+
+/******************************************************************************
+ *  Function to send CONNECT and wait for CONNACK.
+ *****************************************************************************/
+sl_status_t sl_host_mqtt_connect(sl_host_mqtt_client_t *client,
+                                 const sl_transport_interface_t *transport,
+                                 const char *client_id,
+                                 const char *username,
+                                 uint16_t keep_alive)
+{
+  uint8_t body[HOST_MQTT_TX_BUFFER_SIZE];
+  uint32_t body_len = 0;
+  uint32_t packet_len;
+  uint8_t packet_type;
+  uint32_t ack_len;
+  sl_status_t status;
+
+  client->transport = transport;
+  client->next_packet_id = 1;
+
+  if ((strlen(client_id) + ((NULL != username) ? strlen(username) : 0) + 16)
+      > sizeof(body)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Variable header: protocol name, level 4, flags, keep alive
+  body_len += sl_host_mqtt_put_string(&body[body_len], "MQTT");
+  body[body_len++] = 4;
+  body[body_len++] = (NULL != username) ? 0x82 : 0x02;
+  body[body_len++] = (uint8_t)(keep_alive >> 8);
+  body[body_len++] = (uint8_t)(keep_alive & 0xFF);
+
+  /// Payload: client identifier, user name
+  body_len += sl_host_mqtt_put_string(&body[body_len], client_id);
+  if (NULL != username) {
+    body_len += sl_host_mqtt_put_string(&body[body_len], username);
+  }
+
+  client->tx_buffer[0] = HOST_MQTT_PACKET_CONNECT;
+  packet_len = 1 + sl_host_mqtt_encode_remaining_length(&client->tx_buffer[1],
+                                                        body_len);
+  memcpy(&client->tx_buffer[packet_len], body, body_len);
+  packet_len += body_len;
+
+  status = sl_host_mqtt_send_all(client, client->tx_buffer, packet_len);
+  if (SL_STATUS_OK != status) {
+    return status;
+  }
+
+  status = sl_host_mqtt_recv_packet(client,
+                                    &packet_type,
+                                    &ack_len,
+                                    sl_host_mqtt_now_ms()
+                                    + HOST_MQTT_ACK_TIMEOUT_MS);
+  if (SL_STATUS_OK != status) {
+    return status;
+  }
+
+  /// CONNACK return code 0 is connection accepted
+  if ((HOST_MQTT_PACKET_CONNACK != packet_type) || (2 != ack_len)
+      || (0 != client->rx_buffer[1])) {
+    printf("sl_host_mqtt_connect : %s refused\n", client_id);
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to send PUBLISH.
+ *****************************************************************************/
+sl_status_t sl_host_mqtt_publish(sl_host_mqtt_client_t *client,
+                                 const char *topic,
+                                 const uint8_t *payload,
+                                 uint32_t payload_len,
+                                 uint8_t qos,
+                                 uint16_t *packet_id)
+{
+  uint32_t topic_len = (uint32_t)strlen(topic);
+  uint32_t body_len = 2 + topic_len + payload_len + ((qos > 0) ? 2 : 0);
+  uint32_t packet_len;
+
+  if ((1 + HOST_MQTT_MAX_REMAINING_LENGTH_BYTES + body_len)
+      > sizeof(client->tx_buffer)) {
+    printf("sl_host_mqtt_publish : packet of %u bytes too large\n", body_len);
+    return SL_STATUS_FAIL;
+  }
+
+  client->tx_buffer[0] = HOST_MQTT_PACKET_PUBLISH | ((qos > 0) ? 0x02 : 0x00);
+  packet_len = 1 + sl_host_mqtt_encode_remaining_length(&client->tx_buffer[1],
+                                                        body_len);
+  packet_len += sl_host_mqtt_put_string(&client->tx_buffer[packet_len], topic);
+
+  if (qos > 0) {
+    /// Packet identifier 0 is not allowed
+    if (0 == client->next_packet_id) {
+      client->next_packet_id = 1;
+    }
+    client->tx_buffer[packet_len++] = (uint8_t)(client->next_packet_id >> 8);
+    client->tx_buffer[packet_len++] = (uint8_t)(client->next_packet_id & 0xFF);
+    if (NULL != packet_id) {
+      *packet_id = client->next_packet_id;
+    }
+    client->next_packet_id++;
+  }
+
+  memcpy(&client->tx_buffer[packet_len], payload, payload_len);
+  packet_len += payload_len;
+
+  return sl_host_mqtt_send_all(client, client->tx_buffer, packet_len);
+}
+
+/******************************************************************************
+ *  Function to wait for PUBACK of a QoS 1 publish.
+ *****************************************************************************/
+sl_status_t sl_host_mqtt_wait_puback(sl_host_mqtt_client_t *client,
+                                     uint16_t packet_id)
+{
+  uint64_t deadline_ms = sl_host_mqtt_now_ms() + HOST_MQTT_ACK_TIMEOUT_MS;
+  uint8_t packet_type;
+  uint32_t body_len;
+  sl_status_t status;
+
+  while (1) {
+    status = sl_host_mqtt_recv_packet(client,
+                                      &packet_type,
+                                      &body_len,
+                                      deadline_ms);
+    if (SL_STATUS_OK != status) {
+      return status;
+    }
+
+    /// Acknowledgements of earlier publishes and pings are skipped
+    if ((HOST_MQTT_PACKET_PUBACK == packet_type) && (2 == body_len)
+        && (packet_id
+            == (uint16_t)((client->rx_buffer[0] << 8)
+                          | client->rx_buffer[1]))) {
+      return SL_STATUS_OK;
+    }
+  }
+}
+
+/******************************************************************************
+ *  Function to send DISCONNECT and close the transport.
+ *****************************************************************************/
+void sl_host_mqtt_disconnect(sl_host_mqtt_client_t *client)
+{
+  const uint8_t packet[] = { HOST_MQTT_PACKET_DISCONNECT, 0x00 };
+
+  if (NULL == client->transport) {
+    return;
+  }
+
+  sl_host_mqtt_send_all(client, packet, sizeof(packet));
+  client->transport->disconnect(client->transport->context);
+  client->transport = NULL;
+}
+
+/******************************************************************************
+ *  Function to encode MQTT remaining length.
+ *****************************************************************************/
+uint32_t sl_host_mqtt_encode_remaining_length(uint8_t *buffer, uint32_t length)
+{
+  uint32_t index = 0;
+
+  do {
+    buffer[index] = length % 128;
+    length /= 128;
+    if (length > 0) {
+      buffer[index] |= 0x80;
+    }
+    index++;
+  } while ((length > 0) && (index < HOST_MQTT_MAX_REMAINING_LENGTH_BYTES));
+
+  return index;
+}
+
+/******************************************************************************
+ *  Function to decode MQTT fixed header from a partial stream.
+ *****************************************************************************/
+bool sl_host_mqtt_decode_fixed_header(const uint8_t *buffer,
+                                      uint32_t buffer_len,
+                                      uint32_t *remaining_length,
+                                      uint32_t *header_len)
+{
+  uint32_t multiplier = 1;
+  uint32_t value = 0;
+  uint32_t index;
+
+  for (index = 1; index <= HOST_MQTT_MAX_REMAINING_LENGTH_BYTES; ++index) {
+    if (index >= buffer_len) {
+      return false;
+    }
+    value += (buffer[index] & 0x7F) * multiplier;
+    if (0 == (buffer[index] & 0x80)) {
+      *remaining_length = value;
+      *header_len = index + 1;
+      return true;
+    }
+    multiplier *= 128;
+  }
+
+  return false;
+}
+
+/******************************************************************************
+ *  Send a whole buffer on the transport.
+ *****************************************************************************/
+static sl_status_t sl_host_mqtt_send_all(sl_host_mqtt_client_t *client,
+                                         const uint8_t *buffer,
+                                         uint32_t length)
+{
+  uint32_t sent = 0;
+  int32_t sent_bytes;
+
+  while (sent < length) {
+    sent_bytes = client->transport->send(client->transport->context,
+                                         &buffer[sent],
+                                         length - sent);
+    if (sent_bytes <= 0) {
+      return SL_STATUS_FAIL;
+    }
+    sent += (uint32_t)sent_bytes;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Receive exactly length bytes before deadline.
+ *****************************************************************************/
+static sl_status_t sl_host_mqtt_recv_all(sl_host_mqtt_client_t *client,
+                                         uint8_t *buffer,
+                                         uint32_t length,
+                                         uint64_t deadline_ms)
+{
+  uint8_t discard[HOST_MQTT_RX_BUFFER_SIZE];
+  uint32_t received = 0;
+  uint32_t chunk;
+  int32_t recv_bytes;
+
+  while (received < length) {
+    chunk = length - received;
+    if ((NULL == buffer) && (chunk > sizeof(discard))) {
+      chunk = sizeof(discard);
+    }
+
+    recv_bytes = client->transport->recv(client->transport->context,
+                                         (NULL != buffer)
+                                         ? &buffer[received] : discard,
+                                         chunk);
+    if (recv_bytes < 0) {
+      return SL_STATUS_FAIL;
+    }
+    if ((0 == recv_bytes) && (sl_host_mqtt_now_ms() >= deadline_ms)) {
+      return SL_STATUS_TIMEOUT;
+    }
+    received += (uint32_t)recv_bytes;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Receive one packet.
+ *****************************************************************************/
+static sl_status_t sl_host_mqtt_recv_packet(sl_host_mqtt_client_t *client,
+                                            uint8_t *packet_type,
+                                            uint32_t *body_len,
+                                            uint64_t deadline_ms)
+{
+  uint8_t header[1 + HOST_MQTT_MAX_REMAINING_LENGTH_BYTES];
+  uint32_t header_len = 1;
+  uint32_t kept_len;
+  sl_status_t status;
+
+  status = sl_host_mqtt_recv_all(client, header, 1, deadline_ms);
+
+  /// Remaining length is read byte by byte until its last byte
+  while ((SL_STATUS_OK == status)
+         && (!sl_host_mqtt_decode_fixed_header(header,
+                                               header_len,
+                                               body_len,
+                                               &header_len))) {
+    if (header_len >= sizeof(header)) {
+      return SL_STATUS_FAIL;
+    }
+    status = sl_host_mqtt_recv_all(client,
+                                   &header[header_len],
+                                   1,
+                                   deadline_ms);
+    header_len++;
+  }
+
+  if (SL_STATUS_OK != status) {
+    return status;
+  }
+
+  *packet_type = header[0] & HOST_MQTT_PACKET_TYPE_MASK;
+  kept_len = (*body_len < sizeof(client->rx_buffer))
+             ? *body_len : sizeof(client->rx_buffer);
+
+  status = sl_host_mqtt_recv_all(client,
+                                 client->rx_buffer,
+                                 kept_len,
+                                 deadline_ms);
+  if ((SL_STATUS_OK == status) && (*body_len > kept_len)) {
+    status = sl_host_mqtt_recv_all(client,
+                                   NULL,
+                                   *body_len - kept_len,
+                                   deadline_ms);
+  }
+
+  return status;
+}
+
+/******************************************************************************
+ *  Append a length-prefixed UTF-8 string.
+ *****************************************************************************/
+static uint32_t sl_host_mqtt_put_string(uint8_t *buffer, const char *string)
+{
+  uint32_t length = (uint32_t)strlen(string);
+
+  buffer[0] = (uint8_t)(length >> 8);
+  buffer[1] = (uint8_t)(length & 0xFF);
+  memcpy(&buffer[2], string, length);
+
+  return length + 2;
+}
+
+/******************************************************************************
+ *  Monotonic time in milliseconds.
+ *****************************************************************************/
+static uint64_t sl_host_mqtt_now_ms(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000) + ((uint64_t)now.tv_nsec / 1000000);
+}
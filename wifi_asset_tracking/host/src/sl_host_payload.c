@@ -0,0 +1,104 @@
+/***************************************************************************/ /**
+ * @file sl_host_payload.c
+ * @brief Telemetry messages in the JSON schema published by the firmware
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <sl_host_payload.h>
+
+/// Message types in the order the firmware sensor tasks produce them
+typedef enum {
+  SL_HOST_PAYLOAD_HEAT = 0,
+  SL_HOST_PAYLOAD_IMU,
+  SL_HOST_PAYLOAD_GPS,
+  SL_HOST_PAYLOAD_KEEP_ALIVE,
+  SL_HOST_PAYLOAD_TYPES,
+} sl_host_payload_type_e;
+
+/******************************************************************************
+ *  Function to build one telemetry message of a virtual device.
+ *****************************************************************************/
+uint32_t sl_host_payload_build(char *buffer,
+                               uint32_t device_index,
+                               uint32_t sequence)
+{
+  char timestamp[32];
+  uint32_t seconds = sequence * 2;
+  double jitter = (double)((device_index * 7 + sequence * 13) % 100) / 100.0;
+  int length;
+
+  /// Same layout as sl_json_get_timestamp
+  snprintf(timestamp,
+           sizeof(timestamp),
+           "2024-01-01T%02u:%02u:%02u.%03uZ",
+           (seconds / 3600) % 24,
+           (seconds / 60) % 60,
+           seconds % 60,
+           (sequence * 37) % 1000);
+
+  switch (sequence % SL_HOST_PAYLOAD_TYPES) {
+    case SL_HOST_PAYLOAD_HEAT:
+      length = snprintf(buffer,
+                        HOST_PAYLOAD_MAX_SIZE,
+                        "{\"msgtype\":\"heat\",\"timestamp\":\"%s\","
+                        "\"heat\":{\"temperature\":{\"value\":%.2f,"
+                        "\"unit\":\"C\"},\"humidity\":%.2f}}",
+                        timestamp,
+                        24.0 + jitter,
+                        41.0 + jitter);
+      break;
+
+    case SL_HOST_PAYLOAD_IMU:
+      length = snprintf(buffer,
+                        HOST_PAYLOAD_MAX_SIZE,
+                        "{\"msgtype\":\"imu\",\"timestamp\":\"%s\","
+                        "\"accelero\":[%.2f,%.2f,%.2f],"
+                        "\"gyro\":[%.2f,%.2f,%.2f]}",
+                        timestamp,
+                        0.01 + jitter,
+                        -0.02,
+                        0.98,
+                        0.3,
+                        -0.1 - jitter,
+                        0.05);
+      break;
+
+    case SL_HOST_PAYLOAD_GPS:
+      length = snprintf(buffer,
+                        HOST_PAYLOAD_MAX_SIZE,
+                        "{\"msgtype\":\"gps\",\"timestamp\":\"%s\","
+                        "\"gps\":{\"latitude\":%.6f,\"longitude\":%.6f,"
+                        "\"altitude\":%.2f,\"satellites\":%u}}",
+                        timestamp,
+                        17.385044 + (jitter / 1000.0),
+                        78.486671 + (jitter / 1000.0),
+                        505.0 + jitter,
+                        3 + (device_index % 9));
+      break;
+
+    default:
+      length = snprintf(buffer,
+                        HOST_PAYLOAD_MAX_SIZE,
+                        "{\"msgtype\":\"keep-alive\",\"timestamp\":\"%s\","
+                        "\"keep-alive\":\"yes\",\"interval\":10}",
+                        timestamp);
+      break;
+  }
+
+  if ((length <= 0) || (length >= HOST_PAYLOAD_MAX_SIZE)) {
+    return 0;
+  }
+
+  return (uint32_t)length;
+}
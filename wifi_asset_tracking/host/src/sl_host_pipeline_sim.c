@@ -0,0 +1,1521 @@
+/***************************************************************************/ /**
+ * @file sl_host_pipeline_sim.c
+ * @brief Sensor to cloud pipeline of the firmware on the host FreeRTOS
+ * stand-in, with stubbed sensor drivers and a benchmark report
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_sensor_trace.h>
+#include <sl_si91x_calendar.h>
+#include <sparkfun_bmi270.h>
+#include <gnss_max_m10s_driver.h>
+#include <sl_host_freertos.h>
+#include <sl_host_driver_stubs.h>
+#include <sl_host_transport_posix.h>
+#include <sl_host_mqtt.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_SIM_DEFAULT_HOST                "127.0.0.1" ///< Broker host
+#define HOST_SIM_DEFAULT_DURATION            10     ///< In seconds, run time
+#define HOST_SIM_DEVICE_ID                   "host-sim-device" ///< MQTT client identifier
+#define HOST_SIM_KEEP_ALIVE                  60     ///< In seconds, MQTT keep alive
+#define HOST_SIM_MAX_TOPIC_SIZE              128    ///< Telemetry topic length
+#define HOST_SIM_MONITOR_PERIOD              10     ///< In ms, queue occupancy sampling
+#define HOST_SIM_SERIES_INITIAL_SIZE         1024   ///< Samples a latency series starts with
+#define HOST_SIM_TRACE_INITIAL_SIZE          1024   ///< Records a loaded trace starts with
+#define HOST_SIM_REPLAY_POLL_US              50     ///< Wait for pipeline space of a fast replay
+#define HOST_SIM_REPLAY_LANE_SPACE           2      ///< Free lane entries a fast replay waits for, one for the reading in conversion
+#define HOST_SIM_FNV_OFFSET                  2166136261U ///< FNV-1a offset basis
+#define HOST_SIM_FNV_PRIME                   16777619U   ///< FNV-1a prime
+#define HOST_SIM_STAMPS_SIZE                 (2 * sizeof(uint64_t)) ///< Sample and enqueue time stamps at end of MQTT buffer
+#define HOST_SIM_MAX_JSON_SIZE               (MAX_JSON_MESSAGE_SIZE - HOST_SIM_STAMPS_SIZE) ///< JSON space left before the time stamps
+#define NAME_HOST_SIM_SENSOR_TASK            "sim_sensor"  ///< Sensor task name
+#define NAME_HOST_SIM_JSON_TASK              "sim_json"    ///< JSON converter task name
+#define NAME_HOST_SIM_CLOUD_TASK             "sim_cloud"   ///< Cloud task name
+#define NAME_HOST_SIM_MONITOR_TASK           "sim_monitor" ///< Queue monitor task name
+#define NAME_HOST_SIM_REPLAY_TASK            "sim_replay"  ///< Trace replay task name
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for measured pipeline stages
+typedef enum {
+  SL_HOST_SIM_STAGE_READ = 0,     ///< Driver reads of one sample
+  SL_HOST_SIM_STAGE_HANDOFF,      ///< Sample queued to JSON conversion
+  SL_HOST_SIM_STAGE_LANE,         ///< Publish lane enqueue to dequeue
+  SL_HOST_SIM_STAGE_PUBLISH,      ///< One MQTT publish, PUBACK included with QoS 1
+  SL_HOST_SIM_STAGE_END_TO_END,   ///< Sample queued to published
+  SL_HOST_SIM_STAGE_COUNT,        ///< Number of stages
+} sl_host_sim_stage_e;
+
+/// @brief Structure for run configuration
+typedef struct {
+  const char *host_name;        ///< Broker host name
+  uint16_t port;                ///< Broker port, 0 publishes to a null sink
+  uint8_t qos;                  ///< Publish QoS
+  bool use_tls;                 ///< Use TLS transport
+  bool use_rate_limit;          ///< Publish through the IoT Hub rate limiter
+  uint32_t duration_s;          ///< Run time
+  uint32_t interval_ms[SL_MAX_TYPE]; ///< Sampling interval per sensor, 0 disables
+  uint32_t read_time_us;        ///< Duration of one driver read
+  uint32_t failure_per_mille;   ///< Share of failed driver reads
+  uint32_t sink_time_us;        ///< Duration of one null sink publish
+  uint32_t seed;                ///< Seed of the driver stubs
+  const char *replay_path;      ///< Trace or console capture replayed instead of the driver stubs
+  const char *record_path;      ///< Trace file written with every queued reading
+  bool replay_fast;             ///< Replay as fast as the pipeline takes readings, not in recorded time
+  sl_log_level_e log_level;     ///< Firmware log records printed up to this level
+} sl_host_sim_config_t;
+
+/// @brief Structure for latencies of one stage
+typedef struct {
+  uint32_t *values;             ///< In us
+  uint32_t count;               ///< Values recorded
+  uint32_t capacity;            ///< Values allocated
+} sl_host_sim_series_t;
+
+/// @brief Structure for occupancy of one queue
+typedef struct {
+  uint64_t sum;                 ///< Sum of sampled depths
+  uint32_t peak;                ///< Deepest sample
+} sl_host_sim_occupancy_t;
+
+/// @brief Structure for run results
+typedef struct {
+  pthread_mutex_t lock;                                   ///< Guards the fields below
+  uint32_t counters[SL_METRIC_COUNTER_COUNT];             ///< Firmware counters
+  int32_t gauges[SL_METRIC_GAUGE_COUNT];                  ///< Firmware gauges
+  sl_host_sim_series_t stage[SL_HOST_SIM_STAGE_COUNT];    ///< Stage latencies
+  sl_host_sim_occupancy_t sensor_queue;                   ///< Sensor data queue depth
+  sl_host_sim_occupancy_t lane[SL_PUBLISH_LANE_COUNT];    ///< Publish lane depths
+  uint32_t occupancy_samples;                             ///< Depth samples taken
+  uint32_t rate_limited;                                  ///< Waits for a publish token
+  uint64_t payload_bytes;                                 ///< Payload bytes published
+  uint32_t payload_digest;                                ///< Sum of FNV-1a hashes of published payloads, independent of order
+} sl_host_sim_results_t;
+
+/// @brief Structure for us time stamps of the readings on the sensor queue,
+/// in queue order. The firmware reading only carries a tick count, which is
+/// too coarse for the handoff latency. Guarded by the sensor queue mutex
+typedef struct {
+  uint64_t sample_us[MAX_SIZE_OF_SENSOR_DATA_QUEUE];  ///< Time stamps, oldest at head
+  uint32_t head;                                      ///< Index of the oldest time stamp
+  uint32_t count;                                     ///< Time stamps held
+} sl_host_sim_stamps_t;
+
+/// @brief Structure for trace record and replay
+typedef struct {
+  pthread_mutex_t lock;                 ///< Guards output
+  FILE *output;                         ///< Trace being recorded, NULL when not recording
+  sl_sensor_trace_record_t *records;    ///< Trace being replayed
+  uint32_t count;                       ///< Records in records
+  uint32_t capacity;                    ///< Records allocated
+  volatile uint32_t fed;                ///< Records queued by the replay task
+  volatile bool is_done;                ///< Replay task queued every record
+} sl_host_sim_trace_t;
+
+/// @brief Structure for the MQTT session of the cloud task
+typedef struct {
+  bool is_connected;                          ///< Session established
+  char topic[HOST_SIM_MAX_TOPIC_SIZE];        ///< Telemetry topic
+  sl_transport_interface_t transport;         ///< Transport of the device
+  sl_host_transport_posix_context_t socket;   ///< Socket of the device
+  sl_host_mqtt_client_t mqtt;                 ///< MQTT state of the device
+} sl_host_sim_session_t;
+
+/// Run configuration shared by tasks
+static sl_host_sim_config_t sl_host_sim_config;
+
+/// Run results
+static sl_host_sim_results_t sl_host_sim_results = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/// Trace record and replay state
+static sl_host_sim_trace_t sl_host_sim_trace = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/// Time stamps of the queued readings
+static sl_host_sim_stamps_t sl_host_sim_stamps;
+
+/// Pipeline resources, same roles as on the target
+static sl_wifi_asset_tracking_resource_t sl_host_sim_resource;
+
+/// Cleared to stop every task
+static volatile bool sl_host_sim_running = true;
+
+/// Sensor type of each sensor task
+static const sl_wifi_asset_tracking_sensor_queue_data_type_e
+  sl_host_sim_sensor_types[] = {
+  SL_TEMP_RH_SENSOR,
+  SL_IMU_SENSOR,
+  SL_GNSS_RECEIVER,
+};
+
+/// Report names of the stages
+static const char *const sl_host_sim_stage_names[SL_HOST_SIM_STAGE_COUNT] = {
+  "read",
+  "handoff",
+  "lane wait",
+  "publish",
+  "end to end",
+};
+
+/// Report names of the publish lanes
+static const char *const sl_host_sim_lane_names[SL_PUBLISH_LANE_COUNT] = {
+  "critical",
+  "normal",
+  "bulk",
+};
+
+/// Driver configurations, fixed on host
+static bmi270_cfg_data_t sl_host_sim_bmi_cfg_data;
+static sl_max_m10s_cfg_data_t sl_host_sim_gnss_cfg_data;
+
+/**************************************************************************/ /**
+ * @brief Monotonic time in microseconds.
+ ******************************************************************************/
+static uint64_t sl_host_sim_now_us(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+/**************************************************************************/ /**
+ * @brief Record one latency of a stage.
+ ******************************************************************************/
+static void sl_host_sim_record(sl_host_sim_stage_e stage, uint64_t value_us)
+{
+  sl_host_sim_series_t *series = &sl_host_sim_results.stage[stage];
+  uint32_t *values;
+  uint32_t capacity;
+
+  pthread_mutex_lock(&sl_host_sim_results.lock);
+  if (series->count == series->capacity) {
+    capacity = (0 == series->capacity)
+               ? HOST_SIM_SERIES_INITIAL_SIZE : (series->capacity * 2);
+    values = realloc(series->values, capacity * sizeof(uint32_t));
+    if (NULL == values) {
+      pthread_mutex_unlock(&sl_host_sim_results.lock);
+      return;
+    }
+    series->values = values;
+    series->capacity = capacity;
+  }
+  series->values[series->count++] =
+    (value_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)value_us;
+  pthread_mutex_unlock(&sl_host_sim_results.lock);
+}
+
+/**************************************************************************/ /**
+ * @brief Ascending order of latencies for percentiles.
+ ******************************************************************************/
+static int sl_host_sim_compare(const void *first, const void *second)
+{
+  uint32_t a = *(const uint32_t *)first;
+  uint32_t b = *(const uint32_t *)second;
+
+  return (a > b) - (a < b);
+}
+
+/**************************************************************************/ /**
+ * @brief Time-stamp in the layout of sl_json_get_timestamp.
+ ******************************************************************************/
+static sl_status_t sl_host_sim_get_timestamp(uint8_t *timestamp_buff)
+{
+  sl_calendar_datetime_config_t datetime;
+  int length;
+
+  if (SL_STATUS_OK != sl_si91x_calendar_get_date_time(&datetime)) {
+    return SL_STATUS_FAIL;
+  }
+
+  length = snprintf((char *)timestamp_buff,
+                    MAX_TIMESTAMP_BUFF_SIZE,
+                    "%u0%02u-%02u-%02uT%02u:%02u:%02u.%03uZ",
+                    datetime.Century,
+                    datetime.Year,
+                    datetime.Month,
+                    datetime.Day,
+                    datetime.Hour,
+                    datetime.Minute,
+                    datetime.Second,
+                    datetime.MilliSeconds);
+
+  return ((length > 0) && (length < MAX_TIMESTAMP_BUFF_SIZE))
+         ? SL_STATUS_OK : SL_STATUS_FAIL;
+}
+
+/**************************************************************************/ /**
+ * @brief Driver reads of one sample, under the I2C mutex like on the target.
+ * @return SL_STATUS_OK when the reading is available.
+ ******************************************************************************/
+static sl_status_t sl_host_sim_read_sensor(
+  sl_wifi_asset_tracking_sensor_queue_data_t *reading)
+{
+  sl_status_t status = SL_STATUS_FAIL;
+  uint32_t humidity = 0;
+  int32_t temperature = 0;
+  uint8_t fix_type = 0;
+  sl_ubx_nav_pvt_data_t *position;
+
+  xSemaphoreTake(sl_host_sim_resource.i2c_mutex_handler, portMAX_DELAY);
+  switch (reading->sensor_type) {
+    case SL_TEMP_RH_SENSOR:
+      status = sl_si91x_si70xx_read_temp_from_rh(I2C,
+                                                 SI7021_ADDR,
+                                                 &humidity,
+                                                 &temperature);
+      reading->temp_rh_data.temperature = (double)temperature;
+      reading->temp_rh_data.relative_humidity = (double)humidity;
+      break;
+
+    case SL_IMU_SENSOR:
+      status = sparkfun_bmi270_read_acc_reading(&sl_host_sim_bmi_cfg_data,
+                                                reading->imu_data.accelerometer);
+      if (SL_STATUS_OK == status) {
+        status = sparkfun_bmi270_read_gyro_reading(&sl_host_sim_bmi_cfg_data,
+                                                   reading->imu_data.gyroscope);
+      }
+      break;
+
+    case SL_GNSS_RECEIVER:
+      /// One fix type poll and one position, no retries on host
+      status = gnss_max_m10s_get_fix_type(&sl_host_sim_gnss_cfg_data,
+                                          GNSS_POLL_MAX_TIMEOUT,
+                                          &fix_type);
+      if ((SL_STATUS_OK == status) && ((3 == fix_type) || (2 == fix_type))) {
+        status = gnss_max_m10s_get_nav_pvt(&sl_host_sim_gnss_cfg_data,
+                                           GNSS_POLL_MAX_TIMEOUT);
+      } else {
+        status = SL_STATUS_FAIL;
+      }
+      if (SL_STATUS_OK == status) {
+        position = &sl_host_sim_gnss_cfg_data.packetUBXNAVPVT->data;
+        reading->gnss_data.latitude =
+          (double)position->lat / LAT_LONG_DIVISOR_UBX;
+        reading->gnss_data.longitude =
+          (double)position->lon / LAT_LONG_DIVISOR_UBX;
+        reading->gnss_data.altitude = (double)position->hMSL;
+        reading->gnss_data.no_of_satellites = (int32_t)position->numSV;
+      }
+      break;
+
+    default:
+      break;
+  }
+  xSemaphoreGive(sl_host_sim_resource.i2c_mutex_handler);
+
+  return status;
+}
+
+/**************************************************************************/ /**
+ * @brief Append a reading to the trace being recorded: a length byte, then
+ * the encoded record.
+ ******************************************************************************/
+static void sl_host_sim_trace_write(
+  const sl_wifi_asset_tracking_sensor_queue_data_t *reading)
+{
+  sl_sensor_trace_record_t record;
+  uint8_t buffer[1 + SENSOR_TRACE_RECORD_MAX_SIZE];
+  size_t length;
+
+  if ((SL_STATUS_OK != sl_sensor_trace_from_reading(reading, &record))
+      || (SL_STATUS_OK != sl_sensor_trace_encode(&record,
+                                                 &buffer[1],
+                                                 sizeof(buffer) - 1,
+                                                 &length))) {
+    return;
+  }
+  buffer[0] = (uint8_t)length;
+
+  pthread_mutex_lock(&sl_host_sim_trace.lock);
+  fwrite(buffer, 1, length + 1, sl_host_sim_trace.output);
+  pthread_mutex_unlock(&sl_host_sim_trace.lock);
+}
+
+/**************************************************************************/ /**
+ * @brief Add the time stamp of a reading put on the sensor queue. Sensor
+ * queue mutex must be held.
+ ******************************************************************************/
+static void sl_host_sim_push_stamp(uint64_t sample_us)
+{
+  sl_host_sim_stamps.sample_us[(sl_host_sim_stamps.head
+                                + sl_host_sim_stamps.count)
+                               % MAX_SIZE_OF_SENSOR_DATA_QUEUE] = sample_us;
+  sl_host_sim_stamps.count++;
+}
+
+/**************************************************************************/ /**
+ * @brief Take the time stamp of the reading taken off the sensor queue.
+ * Sensor queue mutex must be held.
+ ******************************************************************************/
+static uint64_t sl_host_sim_pop_stamp(void)
+{
+  uint64_t sample_us;
+
+  if (0 == sl_host_sim_stamps.count) {
+    return 0;
+  }
+  sample_us = sl_host_sim_stamps.sample_us[sl_host_sim_stamps.head];
+  sl_host_sim_stamps.head = (sl_host_sim_stamps.head + 1)
+                            % MAX_SIZE_OF_SENSOR_DATA_QUEUE;
+  sl_host_sim_stamps.count--;
+
+  return sample_us;
+}
+
+/**************************************************************************/ /**
+ * @brief Queue a time-stamped reading for the JSON task and wake it. A full
+ * queue drops the oldest reading, like the firmware sensor tasks.
+ ******************************************************************************/
+static void sl_host_sim_queue_reading(
+  const sl_wifi_asset_tracking_sensor_queue_data_t *reading,
+  uint64_t sample_us)
+{
+  if (NULL != sl_host_sim_trace.output) {
+    sl_host_sim_trace_write(reading);
+  }
+
+  xSemaphoreTake(sl_host_sim_resource.sensor_data_queue_mutex_handler,
+                 portMAX_DELAY);
+  if (pdTRUE
+      == xQueueSend(sl_host_sim_resource.sensor_data_queue_handler,
+                    reading,
+                    0)) {
+    sl_host_sim_push_stamp(sample_us);
+    sl_metrics_increment(SL_METRIC_SENSOR_SAMPLES);
+  } else {
+    sl_metrics_increment(SL_METRIC_SENSOR_QUEUE_DROPS);
+    if (pdTRUE
+        == xQueueReceive(sl_host_sim_resource.sensor_data_queue_handler,
+                         NULL,
+                         0)) {
+      sl_host_sim_pop_stamp();
+      xQueueSend(sl_host_sim_resource.sensor_data_queue_handler,
+                 reading,
+                 0);
+      sl_host_sim_push_stamp(sample_us);
+    }
+  }
+  sl_metrics_raise_gauge(SL_METRIC_SENSOR_QUEUE_PEAK,
+                         (int32_t)uxQueueMessagesWaiting(
+                           sl_host_sim_resource.sensor_data_queue_handler));
+  xSemaphoreGive(sl_host_sim_resource.sensor_data_queue_mutex_handler);
+
+  xTaskNotifyGive(
+    sl_host_sim_resource.task_list.json_data_converter_task_handler);
+}
+
+/**************************************************************************/ /**
+ * @brief Sensor task: read, queue for the JSON task and wake it, then sleep
+ * for the rest of the interval, as the firmware sensor tasks do.
+ ******************************************************************************/
+static void sl_host_sim_sensor_task(void *parameter)
+{
+  sl_wifi_asset_tracking_sensor_queue_data_t reading;
+  uint32_t interval_ms;
+  uint32_t elapsed_ms;
+  uint64_t start_us;
+
+  memset(&reading, 0, sizeof(reading));
+  reading.sensor_type =
+    *(const sl_wifi_asset_tracking_sensor_queue_data_type_e *)parameter;
+  interval_ms = sl_host_sim_config.interval_ms[reading.sensor_type];
+  if (SL_TEMP_RH_SENSOR == reading.sensor_type) {
+    strcpy((char *)reading.temp_rh_data.temperature_unit,
+           TEMPERATURE_UNIT_STRING);
+  }
+
+  while (sl_host_sim_running) {
+    start_us = sl_host_sim_now_us();
+
+    if (SL_STATUS_OK == sl_host_sim_read_sensor(&reading)) {
+      reading.is_sensor_data_available = true;
+    } else {
+      /// Queued anyway, becomes a sensor disconnect notice
+      reading.is_sensor_data_available = false;
+      sl_metrics_increment(SL_METRIC_SENSOR_READ_FAILURES);
+    }
+    sl_host_sim_record(SL_HOST_SIM_STAGE_READ, sl_host_sim_now_us() - start_us);
+
+    if (SL_STATUS_OK != sl_host_sim_get_timestamp(reading.time_stamp)) {
+      continue;
+    }
+    reading.sample_tick = xTaskGetTickCount();
+    sl_host_sim_queue_reading(&reading, sl_host_sim_now_us());
+
+    /// Rest of the interval, a stop request ends the wait early
+    elapsed_ms = (uint32_t)((sl_host_sim_now_us() - start_us) / 1000);
+    if (elapsed_ms < interval_ms) {
+      ulTaskNotifyTake(pdTRUE,
+                       pdMS_TO_TICKS(interval_ms - elapsed_ms)
+                       * TIMER_CLOCK_OFFSET);
+    }
+  }
+
+  vTaskDelete(NULL);
+}
+
+/**************************************************************************/ /**
+ * @brief Check whether a fast replay can queue the next reading without a
+ * drop: sensor queue empty and room on every lane for the reading in
+ * conversion and the next one.
+ ******************************************************************************/
+static bool sl_host_sim_replay_has_space(void)
+{
+  uint8_t lane;
+
+  if (QUEUE_EMPTY
+      != uxQueueMessagesWaiting(sl_host_sim_resource.sensor_data_queue_handler)) {
+    return false;
+  }
+
+  for (lane = 0; lane < SL_PUBLISH_LANE_COUNT; ++lane) {
+    if (uxQueueSpacesAvailable(sl_host_sim_resource.mqtt_lane_queue_handler[lane])
+        < HOST_SIM_REPLAY_LANE_SPACE) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**************************************************************************/ /**
+ * @brief Replay task: queue the readings of a trace in place of the sensor
+ * tasks, at their recorded time offsets or as fast as the pipeline takes
+ * them without drops.
+ ******************************************************************************/
+static void sl_host_sim_replay_task(void *parameter)
+{
+  const sl_sensor_trace_record_t *record;
+  sl_wifi_asset_tracking_sensor_queue_data_t reading;
+  struct timespec poll = { 0, HOST_SIM_REPLAY_POLL_US * 1000 };
+  uint64_t start_us = sl_host_sim_now_us();
+  uint64_t due_us;
+  uint64_t now_us;
+  uint32_t index;
+
+  (void)parameter;
+
+  for (index = 0;
+       sl_host_sim_running && (index < sl_host_sim_trace.count);
+       ++index) {
+    record = &sl_host_sim_trace.records[index];
+    if (SL_STATUS_OK != sl_sensor_trace_to_reading(record, &reading)) {
+      continue;
+    }
+
+    if (sl_host_sim_config.replay_fast) {
+      while (sl_host_sim_running && !sl_host_sim_replay_has_space()) {
+        nanosleep(&poll, NULL);
+      }
+    } else if (record->time_ms > sl_host_sim_trace.records[0].time_ms) {
+      /// Readings of several sensors interleave, late ones go at once
+      due_us = start_us
+               + ((record->time_ms - sl_host_sim_trace.records[0].time_ms)
+                  * 1000);
+      now_us = sl_host_sim_now_us();
+      if (due_us > now_us) {
+        ulTaskNotifyTake(pdTRUE,
+                         pdMS_TO_TICKS((uint32_t)((due_us - now_us) / 1000))
+                         * TIMER_CLOCK_OFFSET);
+      }
+    }
+    if (!sl_host_sim_running) {
+      break;
+    }
+
+    if (!reading.is_sensor_data_available) {
+      sl_metrics_increment(SL_METRIC_SENSOR_READ_FAILURES);
+    }
+    reading.sample_tick = xTaskGetTickCount();
+    sl_host_sim_queue_reading(&reading, sl_host_sim_now_us());
+    sl_host_sim_trace.fed++;
+  }
+
+  sl_host_sim_trace.is_done = true;
+  vTaskDelete(NULL);
+}
+
+/**************************************************************************/ /**
+ * @brief Store the sample and enqueue time stamps of a message behind its
+ * JSON. The firmware message layout is kept, and the stamps travel with the
+ * message through lane drops, replacements and requeues.
+ ******************************************************************************/
+static void sl_host_sim_set_stamps(
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t *message,
+  uint64_t sample_us,
+  uint64_t enqueue_us)
+{
+  memcpy(&message->mqtt_buffer[HOST_SIM_MAX_JSON_SIZE],
+         &sample_us,
+         sizeof(sample_us));
+  memcpy(&message->mqtt_buffer[HOST_SIM_MAX_JSON_SIZE + sizeof(sample_us)],
+         &enqueue_us,
+         sizeof(enqueue_us));
+}
+
+/**************************************************************************/ /**
+ * @brief Read the time stamps stored by sl_host_sim_set_stamps.
+ ******************************************************************************/
+static void sl_host_sim_get_stamps(
+  const sl_wifi_asset_tracking_mqtt_package_queue_data_t *message,
+  uint64_t *sample_us,
+  uint64_t *enqueue_us)
+{
+  memcpy(sample_us,
+         &message->mqtt_buffer[HOST_SIM_MAX_JSON_SIZE],
+         sizeof(*sample_us));
+  memcpy(enqueue_us,
+         &message->mqtt_buffer[HOST_SIM_MAX_JSON_SIZE + sizeof(*sample_us)],
+         sizeof(*enqueue_us));
+}
+
+/**************************************************************************/ /**
+ * @brief JSON message of a reading in the schema of the firmware.
+ * @return message length, 0 when it does not fit.
+ ******************************************************************************/
+static int32_t sl_host_sim_build_json(
+  const sl_wifi_asset_tracking_sensor_queue_data_t *reading,
+  uint8_t *buffer)
+{
+  const char *timestamp = (const char *)reading->time_stamp;
+  int length;
+
+  switch (reading->sensor_type) {
+    case SL_TEMP_RH_SENSOR:
+      length = reading->is_sensor_data_available
+               ? snprintf((char *)buffer,
+                          HOST_SIM_MAX_JSON_SIZE,
+                          "{\"msgtype\":\"heat\",\"timestamp\":\"%s\","
+                          "\"heat\":{\"temperature\":{\"value\":%.2f,"
+                          "\"unit\":\"%s\"},\"humidity\":%.2f}}",
+                          timestamp,
+                          reading->temp_rh_data.temperature,
+                          reading->temp_rh_data.temperature_unit,
+                          reading->temp_rh_data.relative_humidity)
+               : snprintf((char *)buffer,
+                          HOST_SIM_MAX_JSON_SIZE,
+                          "{\"msgtype\":\"heat\",\"timestamp\":\"%s\","
+                          "\"heat\":null}",
+                          timestamp);
+      break;
+
+    case SL_IMU_SENSOR:
+      length = reading->is_sensor_data_available
+               ? snprintf((char *)buffer,
+                          HOST_SIM_MAX_JSON_SIZE,
+                          "{\"msgtype\":\"imu\",\"timestamp\":\"%s\","
+                          "\"accelero\":[%.2f,%.2f,%.2f],"
+                          "\"gyro\":[%.2f,%.2f,%.2f]}",
+                          timestamp,
+                          reading->imu_data.accelerometer[0],
+                          reading->imu_data.accelerometer[1],
+                          reading->imu_data.accelerometer[2],
+                          reading->imu_data.gyroscope[0],
+                          reading->imu_data.gyroscope[1],
+                          reading->imu_data.gyroscope[2])
+               : snprintf((char *)buffer,
+                          HOST_SIM_MAX_JSON_SIZE,
+                          "{\"msgtype\":\"imu\",\"timestamp\":\"%s\","
+                          "\"accelero\":null,\"gyro\":null}",
+                          timestamp);
+      break;
+
+    case SL_GNSS_RECEIVER:
+      length = reading->is_sensor_data_available
+               ? snprintf((char *)buffer,
+                          HOST_SIM_MAX_JSON_SIZE,
+                          "{\"msgtype\":\"gps\",\"timestamp\":\"%s\","
+                          "\"gps\":{\"latitude\":%.6f,\"longitude\":%.6f,"
+                          "\"altitude\":%.2f,\"satellites\":%d}}",
+                          timestamp,
+                          reading->gnss_data.latitude,
+                          reading->gnss_data.longitude,
+                          reading->gnss_data.altitude,
+                          reading->gnss_data.no_of_satellites)
+               : snprintf((char *)buffer,
+                          HOST_SIM_MAX_JSON_SIZE,
+                          "{\"msgtype\":\"gps\",\"timestamp\":\"%s\","
+                          "\"gps\":null}",
+                          timestamp);
+      break;
+
+    default:
+      length = 0;
+      break;
+  }
+
+  if ((length <= 0) || ((size_t)length >= HOST_SIM_MAX_JSON_SIZE)) {
+    return 0;
+  }
+
+  return (int32_t)length;
+}
+
+/**************************************************************************/ /**
+ * @brief JSON task: convert queued readings and put them on their publish
+ * lane, as sl_json_data_converter_task does.
+ ******************************************************************************/
+static void sl_host_sim_json_task(void *parameter)
+{
+  sl_wifi_asset_tracking_sensor_queue_data_t reading;
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t message;
+  sl_publish_lane_e lane;
+  sl_publish_lane_source_e source;
+  uint64_t sample_us;
+
+  (void)parameter;
+
+  while (sl_host_sim_running) {
+    if (QUEUE_EMPTY
+        == uxQueueMessagesWaiting(sl_host_sim_resource.sensor_data_queue_handler)) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+
+    xSemaphoreTake(sl_host_sim_resource.sensor_data_queue_mutex_handler,
+                   portMAX_DELAY);
+    xQueueReceive(sl_host_sim_resource.sensor_data_queue_handler,
+                  &reading,
+                  0);
+    sample_us = sl_host_sim_pop_stamp();
+    xSemaphoreGive(sl_host_sim_resource.sensor_data_queue_mutex_handler);
+    sl_host_sim_record(SL_HOST_SIM_STAGE_HANDOFF,
+                       sl_host_sim_now_us() - sample_us);
+
+    message.mqtt_buffer_len = sl_host_sim_build_json(&reading,
+                                                     message.mqtt_buffer);
+    if (0 == message.mqtt_buffer_len) {
+      sl_metrics_increment(SL_METRIC_JSON_FAILURES);
+      continue;
+    }
+    message.sample_tick = reading.sample_tick;
+
+    /// Lane choice of the firmware converters
+    if (!reading.is_sensor_data_available) {
+      lane = SL_PUBLISH_LANE_CRITICAL;
+    } else if (SL_GNSS_RECEIVER == reading.sensor_type) {
+      lane = SL_PUBLISH_LANE_NORMAL;
+    } else {
+      lane = SL_PUBLISH_LANE_BULK;
+    }
+    if (SL_GNSS_RECEIVER == reading.sensor_type) {
+      source = SL_PUBLISH_LANE_SOURCE_GNSS_RECEIVER;
+    } else if (SL_IMU_SENSOR == reading.sensor_type) {
+      source = SL_PUBLISH_LANE_SOURCE_IMU_SENSOR;
+    } else {
+      source = SL_PUBLISH_LANE_SOURCE_TEMP_RH_SENSOR;
+    }
+    sl_host_sim_set_stamps(&message, sample_us, sl_host_sim_now_us());
+    sl_publish_lane_enqueue(lane, source, &message);
+    sl_metrics_increment(SL_METRIC_JSON_MESSAGES);
+  }
+
+  vTaskDelete(NULL);
+}
+
+/**************************************************************************/ /**
+ * @brief Connect the MQTT session of the cloud task to the broker.
+ ******************************************************************************/
+static sl_status_t sl_host_sim_connect(sl_host_sim_session_t *session)
+{
+  snprintf(session->topic,
+           sizeof(session->topic),
+           HOST_MQTT_TELEMETRY_TOPIC_FORMAT,
+           HOST_SIM_DEVICE_ID);
+
+  if ((SL_STATUS_OK
+       != sl_host_transport_posix_init(&session->transport,
+                                       &session->socket,
+                                       sl_host_sim_config.use_tls))
+      || (SL_STATUS_OK
+          != session->transport.connect(session->transport.context,
+                                        sl_host_sim_config.host_name,
+                                        sl_host_sim_config.port))) {
+    return SL_STATUS_FAIL;
+  }
+
+  if (SL_STATUS_OK != sl_host_mqtt_connect(&session->mqtt,
+                                           &session->transport,
+                                           HOST_SIM_DEVICE_ID,
+                                           NULL,
+                                           HOST_SIM_KEEP_ALIVE)) {
+    session->transport.disconnect(session->transport.context);
+    return SL_STATUS_FAIL;
+  }
+
+  session->is_connected = true;
+  return SL_STATUS_OK;
+}
+
+/**************************************************************************/ /**
+ * @brief Publish one message to the broker, or to the null sink.
+ ******************************************************************************/
+static sl_status_t sl_host_sim_publish(
+  sl_host_sim_session_t *session,
+  const sl_wifi_asset_tracking_mqtt_package_queue_data_t *message)
+{
+  struct timespec delay;
+  uint16_t packet_id;
+
+  if (0 == sl_host_sim_config.port) {
+    delay.tv_sec = (time_t)(sl_host_sim_config.sink_time_us / 1000000);
+    delay.tv_nsec = (long)(sl_host_sim_config.sink_time_us % 1000000) * 1000;
+    while (0 != nanosleep(&delay, &delay)) {
+    }
+    return SL_STATUS_OK;
+  }
+
+  if (!session->is_connected) {
+    return SL_STATUS_FAIL;
+  }
+
+  if ((SL_STATUS_OK
+       != sl_host_mqtt_publish(&session->mqtt,
+                               session->topic,
+                               message->mqtt_buffer,
+                               (uint32_t)message->mqtt_buffer_len,
+                               sl_host_sim_config.qos,
+                               &packet_id))
+      || ((sl_host_sim_config.qos > 0)
+          && (SL_STATUS_OK
+              != sl_host_mqtt_wait_puback(&session->mqtt, packet_id)))) {
+    /// Session is gone, like the firmware the task stays disconnected
+    session->is_connected = false;
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/**************************************************************************/ /**
+ * @brief Cloud task: take messages critical lane first within the rate
+ * limit and publish them, as the firmware cloud task does while connected.
+ ******************************************************************************/
+static void sl_host_sim_cloud_task(void *parameter)
+{
+  sl_host_sim_session_t *session = parameter;
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t message;
+  sl_publish_lane_e lane;
+  uint32_t rate_limit_wait;
+  uint32_t digest;
+  int32_t index;
+  uint64_t start_us;
+  uint64_t sample_us;
+  uint64_t enqueue_us;
+
+  while (sl_host_sim_running) {
+    if (QUEUE_EMPTY == sl_publish_lane_messages_waiting()) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+
+    if (SL_STATUS_OK != sl_publish_lane_dequeue(&message, &lane)) {
+      continue;
+    }
+
+    /// Message is held until a token is free, as in the firmware
+    while (sl_host_sim_running
+           && sl_host_sim_config.use_rate_limit
+           && (SL_STATUS_OK
+               != sl_rate_limit_acquire(sl_publish_lane_messages_waiting() + 1,
+                                        &rate_limit_wait))) {
+      pthread_mutex_lock(&sl_host_sim_results.lock);
+      sl_host_sim_results.rate_limited++;
+      pthread_mutex_unlock(&sl_host_sim_results.lock);
+      /// A stop request ends the wait early
+      ulTaskNotifyTake(pdTRUE,
+                       pdMS_TO_TICKS(rate_limit_wait) * TIMER_CLOCK_OFFSET);
+    }
+    if (!sl_host_sim_running) {
+      break;
+    }
+    sl_host_sim_get_stamps(&message, &sample_us, &enqueue_us);
+    sl_host_sim_record(SL_HOST_SIM_STAGE_LANE,
+                       sl_host_sim_now_us() - enqueue_us);
+
+    start_us = sl_host_sim_now_us();
+    if (SL_STATUS_OK != sl_host_sim_publish(session, &message)) {
+      sl_metrics_increment(SL_METRIC_PUBLISH_FAILURES);
+      continue;
+    }
+    sl_host_sim_record(SL_HOST_SIM_STAGE_PUBLISH,
+                       sl_host_sim_now_us() - start_us);
+
+    if (0 != sample_us) {
+      sl_host_sim_record(SL_HOST_SIM_STAGE_END_TO_END,
+                         sl_host_sim_now_us() - sample_us);
+    }
+    sl_metrics_increment(SL_METRIC_PUBLISHED);
+    sl_publish_lane_record_published(lane, &message);
+    if (sl_host_sim_config.use_rate_limit) {
+      sl_rate_limit_on_published(sl_publish_lane_messages_waiting());
+    }
+
+    digest = HOST_SIM_FNV_OFFSET;
+    for (index = 0; index < message.mqtt_buffer_len; ++index) {
+      digest = (digest ^ message.mqtt_buffer[index]) * HOST_SIM_FNV_PRIME;
+    }
+
+    pthread_mutex_lock(&sl_host_sim_results.lock);
+    sl_host_sim_results.payload_bytes += (uint64_t)message.mqtt_buffer_len;
+    sl_host_sim_results.payload_digest += digest;
+    pthread_mutex_unlock(&sl_host_sim_results.lock);
+  }
+
+  vTaskDelete(NULL);
+}
+
+/**************************************************************************/ /**
+ * @brief Monitor task: sample queue depths for average and peak occupancy.
+ ******************************************************************************/
+static void sl_host_sim_monitor_task(void *parameter)
+{
+  uint32_t depth;
+  uint8_t lane;
+
+  (void)parameter;
+
+  while (sl_host_sim_running) {
+    pthread_mutex_lock(&sl_host_sim_results.lock);
+    depth = (uint32_t)uxQueueMessagesWaiting(
+      sl_host_sim_resource.sensor_data_queue_handler);
+    sl_host_sim_results.sensor_queue.sum += depth;
+    if (depth > sl_host_sim_results.sensor_queue.peak) {
+      sl_host_sim_results.sensor_queue.peak = depth;
+    }
+    for (lane = 0; lane < SL_PUBLISH_LANE_COUNT; ++lane) {
+      depth = (uint32_t)uxQueueMessagesWaiting(
+        sl_host_sim_resource.mqtt_lane_queue_handler[lane]);
+      sl_host_sim_results.lane[lane].sum += depth;
+      if (depth > sl_host_sim_results.lane[lane].peak) {
+        sl_host_sim_results.lane[lane].peak = depth;
+      }
+    }
+    sl_host_sim_results.occupancy_samples++;
+    pthread_mutex_unlock(&sl_host_sim_results.lock);
+
+    ulTaskNotifyTake(pdTRUE,
+                     pdMS_TO_TICKS(HOST_SIM_MONITOR_PERIOD) * TIMER_CLOCK_OFFSET);
+  }
+
+  vTaskDelete(NULL);
+}
+
+/******************************************************************************
+ *  Function to get the pipeline resources.
+ *****************************************************************************/
+sl_wifi_asset_tracking_resource_t * sl_get_wifi_asset_tracking_resource()
+{
+  return &sl_host_sim_resource;
+}
+
+/******************************************************************************
+ *  Function to create an application queue, dynamically on host.
+ *****************************************************************************/
+QueueHandle_t sl_static_create_queue(sl_static_queue_e queue)
+{
+  switch (queue) {
+    case SL_STATIC_QUEUE_SENSOR_DATA:
+      return xQueueCreate(MAX_SIZE_OF_SENSOR_DATA_QUEUE,
+                          sizeof(sl_wifi_asset_tracking_sensor_queue_data_t));
+    case SL_STATIC_QUEUE_LANE_CRITICAL:
+      return xQueueCreate(PUBLISH_LANE_CRITICAL_CAPACITY,
+                          sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t));
+    case SL_STATIC_QUEUE_LANE_NORMAL:
+      return xQueueCreate(PUBLISH_LANE_NORMAL_CAPACITY,
+                          sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t));
+    case SL_STATIC_QUEUE_LANE_BULK:
+      return xQueueCreate(PUBLISH_LANE_BULK_CAPACITY,
+                          sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t));
+    default:
+      return NULL;
+  }
+}
+
+/******************************************************************************
+ *  Function to count an event.
+ *****************************************************************************/
+void sl_metrics_increment(sl_metric_counter_e counter)
+{
+  pthread_mutex_lock(&sl_host_sim_results.lock);
+  sl_host_sim_results.counters[counter]++;
+  pthread_mutex_unlock(&sl_host_sim_results.lock);
+}
+
+/******************************************************************************
+ *  Function to set a gauge.
+ *****************************************************************************/
+void sl_metrics_set_gauge(sl_metric_gauge_e gauge, int32_t value)
+{
+  pthread_mutex_lock(&sl_host_sim_results.lock);
+  sl_host_sim_results.gauges[gauge] = value;
+  pthread_mutex_unlock(&sl_host_sim_results.lock);
+}
+
+/******************************************************************************
+ *  Function to raise a gauge to a new peak.
+ *****************************************************************************/
+void sl_metrics_raise_gauge(sl_metric_gauge_e gauge, int32_t value)
+{
+  pthread_mutex_lock(&sl_host_sim_results.lock);
+  if (value > sl_host_sim_results.gauges[gauge]) {
+    sl_host_sim_results.gauges[gauge] = value;
+  }
+  pthread_mutex_unlock(&sl_host_sim_results.lock);
+}
+
+/******************************************************************************
+ *  Function to observe a latency, the harness measures stages in
+ *  microseconds itself.
+ *****************************************************************************/
+void sl_metrics_observe(sl_metric_histogram_e histogram, uint32_t value)
+{
+  (void)histogram;
+  (void)value;
+}
+
+/******************************************************************************
+ *  Function to check whether a module logs at a level.
+ *****************************************************************************/
+bool sl_log_is_enabled(sl_log_module_e module, sl_log_level_e level)
+{
+  (void)module;
+  return (level <= sl_host_sim_config.log_level);
+}
+
+/******************************************************************************
+ *  Function to print a log record right away, there is no log task on host.
+ *****************************************************************************/
+void sl_log_write(sl_log_module_e module,
+                  sl_log_level_e level,
+                  sl_log_format_id_e format_id,
+                  uint8_t arg_count,
+                  uint32_t arg0,
+                  uint32_t arg1,
+                  uint32_t arg2,
+                  uint32_t arg3)
+{
+  sl_log_record_t record;
+  char text[LOG_TEXT_BUFF_SIZE];
+
+  record.time_ms = (uint32_t)(sl_host_sim_now_us() / 1000);
+  record.format_id = (uint16_t)format_id;
+  record.module = (uint8_t)module;
+  record.level = (uint8_t)level;
+  record.arg_count = arg_count;
+  record.args[0] = arg0;
+  record.args[1] = arg1;
+  record.args[2] = arg2;
+  record.args[3] = arg3;
+
+  if (SL_STATUS_OK == sl_log_format_record(&record, text, sizeof(text))) {
+    printf("%s\n", text);
+  }
+}
+
+/**************************************************************************/ /**
+ * @brief Append a record to the trace to replay.
+ ******************************************************************************/
+static sl_status_t sl_host_sim_trace_append(const sl_sensor_trace_record_t *record)
+{
+  sl_sensor_trace_record_t *records;
+  uint32_t capacity;
+
+  if (sl_host_sim_trace.count == sl_host_sim_trace.capacity) {
+    capacity = (0 == sl_host_sim_trace.capacity)
+               ? HOST_SIM_TRACE_INITIAL_SIZE : (sl_host_sim_trace.capacity * 2);
+    records = realloc(sl_host_sim_trace.records,
+                      capacity * sizeof(sl_sensor_trace_record_t));
+    if (NULL == records) {
+      return SL_STATUS_FAIL;
+    }
+    sl_host_sim_trace.records = records;
+    sl_host_sim_trace.capacity = capacity;
+  }
+  sl_host_sim_trace.records[sl_host_sim_trace.count++] = *record;
+
+  return SL_STATUS_OK;
+}
+
+/**************************************************************************/ /**
+ * @brief Load the trace to replay: a trace file written with -O, or a
+ * console capture of which the SENSOR_TRACE_FRAME_MARKER lines are taken.
+ * @param[in] path : trace or console capture.
+ * @return SL_STATUS_OK when at least one record was loaded.
+ ******************************************************************************/
+static sl_status_t sl_host_sim_trace_load(const char *path)
+{
+  sl_sensor_trace_record_t record;
+  sl_status_t status = SL_STATUS_OK;
+  FILE *input;
+  uint8_t *data;
+  char *line;
+  char *line_end;
+  char *frame;
+  size_t header_size = strlen(SENSOR_TRACE_FILE_MAGIC) + 1;
+  size_t offset;
+  size_t length;
+  long size;
+
+  input = fopen(path, "rb");
+  if (NULL == input) {
+    return SL_STATUS_FAIL;
+  }
+  if ((0 != fseek(input, 0, SEEK_END))
+      || ((size = ftell(input)) < 0)
+      || (0 != fseek(input, 0, SEEK_SET))
+      || (NULL == (data = malloc((size_t)size + 1)))) {
+    fclose(input);
+    return SL_STATUS_FAIL;
+  }
+  if ((size_t)size != fread(data, 1, (size_t)size, input)) {
+    status = SL_STATUS_FAIL;
+  }
+  fclose(input);
+  data[size] = '\0';
+
+  if ((SL_STATUS_OK == status)
+      && ((size_t)size >= header_size)
+      && (0 == memcmp(data,
+                      SENSOR_TRACE_FILE_MAGIC,
+                      strlen(SENSOR_TRACE_FILE_MAGIC)))) {
+    /// Trace file, a length byte before every record
+    if (SENSOR_TRACE_FILE_VERSION != data[header_size - 1]) {
+      status = SL_STATUS_FAIL;
+    }
+    for (offset = header_size;
+         (SL_STATUS_OK == status) && (offset < (size_t)size);
+         offset += 1 + data[offset]) {
+      if (((offset + 1 + data[offset]) > (size_t)size)
+          || (SL_STATUS_OK != sl_sensor_trace_decode(&data[offset + 1],
+                                                     data[offset],
+                                                     &record,
+                                                     &length))
+          || (length != data[offset])) {
+        status = SL_STATUS_FAIL;
+      } else {
+        status = sl_host_sim_trace_append(&record);
+      }
+    }
+  } else if (SL_STATUS_OK == status) {
+    /// Console capture, terminal prefixes before the marker are skipped
+    for (line = (char *)data; '\0' != *line; line = line_end) {
+      line_end = strchr(line, '\n');
+      if (NULL == line_end) {
+        line_end = line + strlen(line);
+      } else {
+        *line_end++ = '\0';
+      }
+
+      frame = strstr(line, SENSOR_TRACE_FRAME_MARKER);
+      if ((NULL != frame)
+          && (SL_STATUS_OK == sl_sensor_trace_decode_frame(frame, &record))
+          && (SL_STATUS_OK != sl_host_sim_trace_append(&record))) {
+        status = SL_STATUS_FAIL;
+        break;
+      }
+    }
+  }
+  free(data);
+
+  return ((SL_STATUS_OK == status) && (0 != sl_host_sim_trace.count))
+         ? SL_STATUS_OK : SL_STATUS_FAIL;
+}
+
+/**************************************************************************/ /**
+ * @brief Check whether a replay is done and every reading left the pipeline,
+ * published, failed or dropped.
+ ******************************************************************************/
+static bool sl_host_sim_replay_is_drained(void)
+{
+  uint32_t *counters = sl_host_sim_results.counters;
+  bool is_drained;
+
+  if (!sl_host_sim_trace.is_done) {
+    return false;
+  }
+
+  pthread_mutex_lock(&sl_host_sim_results.lock);
+  is_drained = ((counters[SL_METRIC_JSON_MESSAGES]
+                 + counters[SL_METRIC_JSON_FAILURES]
+                 + counters[SL_METRIC_SENSOR_QUEUE_DROPS])
+                == sl_host_sim_trace.fed)
+               && ((counters[SL_METRIC_PUBLISHED]
+                    + counters[SL_METRIC_PUBLISH_FAILURES]
+                    + counters[SL_METRIC_LANE_DROPS])
+                   == counters[SL_METRIC_JSON_MESSAGES]);
+  pthread_mutex_unlock(&sl_host_sim_results.lock);
+
+  return is_drained;
+}
+
+/**************************************************************************/ /**
+ * @brief Print the benchmark report.
+ * @param[in] elapsed_us : run time.
+ ******************************************************************************/
+static void sl_host_sim_report(uint64_t elapsed_us)
+{
+  sl_host_sim_results_t *results = &sl_host_sim_results;
+  sl_host_sim_series_t *series;
+  sl_publish_lane_metrics_t lane_metrics;
+  double seconds = (double)elapsed_us / 1e6;
+  uint32_t samples = (0 == results->occupancy_samples)
+                     ? 1 : results->occupancy_samples;
+  uint8_t index;
+
+  printf("run                : %.1f s, %s, rate limit %s\n",
+         seconds,
+         (0 == sl_host_sim_config.port) ? "null sink"
+         : (sl_host_sim_config.use_tls ? "tls" : "tcp"),
+         sl_host_sim_config.use_rate_limit ? "on" : "off");
+  if (NULL != sl_host_sim_config.replay_path) {
+    printf("replay             : %u of %u records, %.1f s of trace, %s\n",
+           sl_host_sim_trace.fed,
+           sl_host_sim_trace.count,
+           (double)(sl_host_sim_trace.records[sl_host_sim_trace.count - 1].time_ms
+                    - sl_host_sim_trace.records[0].time_ms) / 1e3,
+           sl_host_sim_config.replay_fast ? "fast" : "recorded time");
+  } else {
+    printf("intervals ms       : temp/rh %u  imu %u  gnss %u\n",
+           sl_host_sim_config.interval_ms[SL_TEMP_RH_SENSOR],
+           sl_host_sim_config.interval_ms[SL_IMU_SENSOR],
+           sl_host_sim_config.interval_ms[SL_GNSS_RECEIVER]);
+  }
+  printf("throughput /s      : sampled %.1f  converted %.1f  published %.1f"
+         "  (%.0f payload bytes)\n",
+         results->counters[SL_METRIC_SENSOR_SAMPLES] / seconds,
+         results->counters[SL_METRIC_JSON_MESSAGES] / seconds,
+         results->counters[SL_METRIC_PUBLISHED] / seconds,
+         (double)results->payload_bytes / seconds);
+
+  /// Tick based stages resolve one tick, 1/HOST_FREERTOS_TICKS_PER_SECOND s
+  for (index = 0; index < SL_HOST_SIM_STAGE_COUNT; ++index) {
+    series = &results->stage[index];
+    if (0 == series->count) {
+      printf("%-10s us      : n/a\n", sl_host_sim_stage_names[index]);
+      continue;
+    }
+    qsort(series->values, series->count, sizeof(uint32_t), sl_host_sim_compare);
+    printf("%-10s us      : p50 %u  p95 %u  p99 %u  max %u\n",
+           sl_host_sim_stage_names[index],
+           series->values[series->count / 2],
+           series->values[(series->count * 95) / 100],
+           series->values[(series->count * 99) / 100],
+           series->values[series->count - 1]);
+  }
+
+  printf("occupancy          : sensor queue avg %.2f peak %u/%u\n",
+         (double)results->sensor_queue.sum / samples,
+         ((uint32_t)results->gauges[SL_METRIC_SENSOR_QUEUE_PEAK]
+          > results->sensor_queue.peak)
+         ? (uint32_t)results->gauges[SL_METRIC_SENSOR_QUEUE_PEAK]
+         : results->sensor_queue.peak,
+         MAX_SIZE_OF_SENSOR_DATA_QUEUE);
+  for (index = 0; index < SL_PUBLISH_LANE_COUNT; ++index) {
+    sl_publish_lane_get_metrics((sl_publish_lane_e)index, &lane_metrics);
+    printf("lane %-8s      : avg %.2f peak %u  enqueued %u published %u"
+           " dropped %u\n",
+           sl_host_sim_lane_names[index],
+           (double)results->lane[index].sum / samples,
+           results->lane[index].peak,
+           lane_metrics.enqueued,
+           lane_metrics.published,
+           lane_metrics.dropped);
+  }
+
+  printf("drops              : sensor queue %u  lanes %u\n",
+         results->counters[SL_METRIC_SENSOR_QUEUE_DROPS],
+         results->counters[SL_METRIC_LANE_DROPS]);
+  printf("failures           : read %u  json %u  publish %u\n",
+         results->counters[SL_METRIC_SENSOR_READ_FAILURES],
+         results->counters[SL_METRIC_JSON_FAILURES],
+         results->counters[SL_METRIC_PUBLISH_FAILURES]);
+  printf("rate limited       : %u waits, %u messages per minute\n",
+         results->rate_limited,
+         sl_rate_limit_get_rate());
+  /// Same trace and settings without drops give the same digest
+  printf("payload digest     : %08x\n", results->payload_digest);
+}
+
+/**************************************************************************/ /**
+ * @brief Print command line usage.
+ ******************************************************************************/
+static void sl_host_sim_usage(const char *name)
+{
+  printf("usage: %s [-H host] [-p port] [-q qos] [-t] [-d seconds]\n"
+         "          [-T temp_rh_ms] [-I imu_ms] [-G gnss_ms] [-r read_us]\n"
+         "          [-f failures_per_mille] [-w sink_us] [-s seed] [-u] [-v]\n"
+         "          [-R trace] [-x] [-O trace]\n"
+         "  -p  broker port, without it messages go to a null sink\n"
+         "  -T, -I, -G  sampling interval per sensor, 0 disables the sensor\n"
+         "  -R  replay a trace or a console capture with \"#S\" lines instead\n"
+         "      of the driver stubs, until it is published or -d expires\n"
+         "  -x  replay as fast as the pipeline takes readings without drops\n"
+         "  -O  record every queued reading to a trace file\n"
+         "  -u  publish without the IoT Hub rate limiter\n"
+         "  -t  use TLS (build with TLS=1)\n"
+         "  -v  print firmware log records up to debug level\n",
+         name);
+}
+
+/**************************************************************************/ /**
+ * @brief Pipeline simulation entry point.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  sl_host_sim_session_t session;
+  TaskHandle_t sensor_tasks[SL_MAX_TYPE - 1] = { NULL };
+  TaskHandle_t monitor_task = NULL;
+  TaskHandle_t replay_task = NULL;
+  uint64_t start_us;
+  uint64_t elapsed_us;
+  uint8_t index;
+  int option;
+
+  sl_host_sim_config.host_name = HOST_SIM_DEFAULT_HOST;
+  sl_host_sim_config.qos = 1;
+  sl_host_sim_config.use_rate_limit = true;
+  sl_host_sim_config.interval_ms[SL_TEMP_RH_SENSOR] =
+    DEMO_CONFIG_TEMP_RH_SENSOR_SAMPLING_INTERVAL * 1000;
+  sl_host_sim_config.interval_ms[SL_IMU_SENSOR] =
+    DEMO_CONFIG_IMU_SENSOR_SAMPLING_INTERVAL * 1000;
+  sl_host_sim_config.interval_ms[SL_GNSS_RECEIVER] =
+    DEMO_CONFIG_GNSS_RECEIVER_SAMPLING_INTERVAL * 1000;
+  sl_host_sim_config.read_time_us = 2000;
+  sl_host_sim_config.seed = 1;
+  sl_host_sim_config.log_level = SL_LOG_LEVEL_ERROR;
+
+  while (-1 != (option = getopt(argc, argv, "H:p:q:d:T:I:G:r:f:w:s:R:O:xtuvh"))) {
+    switch (option) {
+      case 'H':
+        sl_host_sim_config.host_name = optarg;
+        break;
+      case 'p':
+        sl_host_sim_config.port = (uint16_t)atoi(optarg);
+        break;
+      case 'q':
+        sl_host_sim_config.qos = (atoi(optarg) > 0) ? 1 : 0;
+        break;
+      case 'd':
+        sl_host_sim_config.duration_s = (uint32_t)atoi(optarg);
+        break;
+      case 'T':
+        sl_host_sim_config.interval_ms[SL_TEMP_RH_SENSOR] = (uint32_t)atoi(optarg);
+        break;
+      case 'I':
+        sl_host_sim_config.interval_ms[SL_IMU_SENSOR] = (uint32_t)atoi(optarg);
+        break;
+      case 'G':
+        sl_host_sim_config.interval_ms[SL_GNSS_RECEIVER] = (uint32_t)atoi(optarg);
+        break;
+      case 'r':
+        sl_host_sim_config.read_time_us = (uint32_t)atoi(optarg);
+        break;
+      case 'f':
+        sl_host_sim_config.failure_per_mille = (uint32_t)atoi(optarg);
+        break;
+      case 'w':
+        sl_host_sim_config.sink_time_us = (uint32_t)atoi(optarg);
+        break;
+      case 's':
+        sl_host_sim_config.seed = (uint32_t)atoi(optarg);
+        break;
+      case 'R':
+        sl_host_sim_config.replay_path = optarg;
+        break;
+      case 'O':
+        sl_host_sim_config.record_path = optarg;
+        break;
+      case 'x':
+        sl_host_sim_config.replay_fast = true;
+        break;
+      case 't':
+        sl_host_sim_config.use_tls = true;
+        break;
+      case 'u':
+        sl_host_sim_config.use_rate_limit = false;
+        break;
+      case 'v':
+        sl_host_sim_config.log_level = SL_LOG_LEVEL_DEBUG;
+        break;
+      default:
+        sl_host_sim_usage(argv[0]);
+        return 1;
+    }
+  }
+
+  /// A replay runs until its trace is published unless -d is given
+  if ((0 == sl_host_sim_config.duration_s)
+      && (NULL == sl_host_sim_config.replay_path)) {
+    sl_host_sim_config.duration_s = HOST_SIM_DEFAULT_DURATION;
+  }
+
+  if ((NULL != sl_host_sim_config.replay_path)
+      && (SL_STATUS_OK != sl_host_sim_trace_load(sl_host_sim_config.replay_path))) {
+    printf("sl_host_pipeline_sim : no trace records in %s\n",
+           sl_host_sim_config.replay_path);
+    return 1;
+  }
+
+  if (NULL != sl_host_sim_config.record_path) {
+    sl_host_sim_trace.output = fopen(sl_host_sim_config.record_path, "wb");
+    if (NULL == sl_host_sim_trace.output) {
+      printf("sl_host_pipeline_sim : cannot write %s\n",
+             sl_host_sim_config.record_path);
+      return 1;
+    }
+    fputs(SENSOR_TRACE_FILE_MAGIC, sl_host_sim_trace.output);
+    fputc(SENSOR_TRACE_FILE_VERSION, sl_host_sim_trace.output);
+  }
+
+  sl_host_driver_stubs_configure(sl_host_sim_config.read_time_us,
+                                 sl_host_sim_config.failure_per_mille,
+                                 sl_host_sim_config.seed);
+
+  memset(&session, 0, sizeof(session));
+  if ((0 != sl_host_sim_config.port)
+      && (SL_STATUS_OK != sl_host_sim_connect(&session))) {
+    printf("sl_host_pipeline_sim : broker %s:%u not reachable\n",
+           sl_host_sim_config.host_name,
+           sl_host_sim_config.port);
+    return 1;
+  }
+
+  /// Same resources as app initialization creates on the target
+  sl_host_sim_resource.sensor_data_queue_handler =
+    sl_static_create_queue(SL_STATIC_QUEUE_SENSOR_DATA);
+  sl_host_sim_resource.sensor_data_queue_mutex_handler =
+    xSemaphoreCreateMutex();
+  sl_host_sim_resource.mqtt_package_queue_mutex_handler =
+    xSemaphoreCreateMutex();
+  sl_host_sim_resource.i2c_mutex_handler = xSemaphoreCreateMutex();
+  if ((NULL == sl_host_sim_resource.sensor_data_queue_handler)
+      || (NULL == sl_host_sim_resource.sensor_data_queue_mutex_handler)
+      || (NULL == sl_host_sim_resource.mqtt_package_queue_mutex_handler)
+      || (NULL == sl_host_sim_resource.i2c_mutex_handler)
+      || (SL_STATUS_OK != sl_publish_lane_init())) {
+    printf("sl_host_pipeline_sim : out of memory\n");
+    return 1;
+  }
+  sl_rate_limit_init();
+
+  /// Consumers first, so producers always find their task handles set
+  if ((pdPASS != xTaskCreate(sl_host_sim_cloud_task,
+                             NAME_HOST_SIM_CLOUD_TASK,
+                             0,
+                             &session,
+                             0,
+                             &sl_host_sim_resource.task_list.
+                             azure_cloud_communication_task_handler))
+      || (pdPASS != xTaskCreate(sl_host_sim_json_task,
+                                NAME_HOST_SIM_JSON_TASK,
+                                0,
+                                NULL,
+                                0,
+                                &sl_host_sim_resource.task_list.
+                                json_data_converter_task_handler))
+      || (pdPASS != xTaskCreate(sl_host_sim_monitor_task,
+                                NAME_HOST_SIM_MONITOR_TASK,
+                                0,
+                                NULL,
+                                0,
+                                &monitor_task))) {
+    printf("sl_host_pipeline_sim : task creation failed\n");
+    return 1;
+  }
+
+  start_us = sl_host_sim_now_us();
+  if (NULL != sl_host_sim_config.replay_path) {
+    /// The trace takes the place of every sensor task
+    if (pdPASS != xTaskCreate(sl_host_sim_replay_task,
+                              NAME_HOST_SIM_REPLAY_TASK,
+                              0,
+                              NULL,
+                              0,
+                              &replay_task)) {
+      printf("sl_host_pipeline_sim : task creation failed\n");
+      return 1;
+    }
+    while (!sl_host_sim_replay_is_drained()
+           && ((0 == sl_host_sim_config.duration_s)
+               || ((sl_host_sim_now_us() - start_us)
+                   < ((uint64_t)sl_host_sim_config.duration_s * 1000000)))) {
+      vTaskDelay(pdMS_TO_TICKS(HOST_SIM_MONITOR_PERIOD) * TIMER_CLOCK_OFFSET);
+    }
+  } else {
+    for (index = 0; index < (SL_MAX_TYPE - 1); ++index) {
+      if ((0 == sl_host_sim_config.interval_ms[sl_host_sim_sensor_types[index]])
+          || (pdPASS != xTaskCreate(sl_host_sim_sensor_task,
+                                    NAME_HOST_SIM_SENSOR_TASK,
+                                    0,
+                                    (void *)&sl_host_sim_sensor_types[index],
+                                    0,
+                                    &sensor_tasks[index]))) {
+        sensor_tasks[index] = NULL;
+      }
+    }
+
+    sleep(sl_host_sim_config.duration_s);
+  }
+
+  /// Every task checks the flag once woken
+  sl_host_sim_running = false;
+  for (index = 0; index < (SL_MAX_TYPE - 1); ++index) {
+    xTaskNotifyGive(sensor_tasks[index]);
+    sl_host_freertos_join(sensor_tasks[index]);
+  }
+  xTaskNotifyGive(replay_task);
+  sl_host_freertos_join(replay_task);
+  elapsed_us = sl_host_sim_now_us() - start_us;
+  xTaskNotifyGive(sl_host_sim_resource.task_list.json_data_converter_task_handler);
+  sl_host_freertos_join(sl_host_sim_resource.task_list.json_data_converter_task_handler);
+  xTaskNotifyGive(sl_host_sim_resource.task_list.azure_cloud_communication_task_handler);
+  sl_host_freertos_join(sl_host_sim_resource.task_list.azure_cloud_communication_task_handler);
+  xTaskNotifyGive(monitor_task);
+  sl_host_freertos_join(monitor_task);
+
+  if (session.is_connected) {
+    sl_host_mqtt_disconnect(&session.mqtt);
+  }
+
+  sl_host_sim_report(elapsed_us);
+
+  if (NULL != sl_host_sim_trace.output) {
+    fclose(sl_host_sim_trace.output);
+  }
+  free(sl_host_sim_trace.records);
+  for (index = 0; index < SL_HOST_SIM_STAGE_COUNT; ++index) {
+    free(sl_host_sim_results.stage[index].values);
+  }
+  sl_publish_lane_deinit();
+
+  return ((0 == sl_host_sim_results.counters[SL_METRIC_PUBLISH_FAILURES])
+          && (0 != sl_host_sim_results.counters[SL_METRIC_PUBLISHED])) ? 0 : 2;
+}
@@ -0,0 +1,263 @@
+/***************************************************************************/ /**
+ * @file sl_host_stack_config.c
+ * @brief Generates the task stack size header from a stack profile capture
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_STACK_LINE_SIZE                 512    ///< Longest console line
+#define HOST_STACK_MAX_TASKS                 32     ///< Most tasks of one capture
+#define HOST_STACK_NAME_SIZE                 64     ///< Longest stack size macro
+#define HOST_STACK_MARKER                    "stack_profile : STACK_SIZE_" ///< Start of a task line of sl_stack_profile_report
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for the last reported profile of a task
+typedef struct {
+  char name[HOST_STACK_NAME_SIZE];  ///< Stack size macro
+  unsigned long peak;               ///< In words, most stack used, 0 when not measured
+  unsigned long size;               ///< In words, stack depth of the profiled build
+  unsigned long recommended;        ///< In words, recommended stack depth
+} sl_host_stack_task_t;
+
+/// @brief Structure for all tasks of a capture
+typedef struct {
+  sl_host_stack_task_t task[HOST_STACK_MAX_TASKS];  ///< Tasks in order of first report
+  unsigned int count;                               ///< Tasks found
+} sl_host_stack_profile_t;
+
+/**************************************************************************/ /**
+ * @brief Read task lines of a console capture, a later report of a task
+ * replaces an earlier one.
+ * @return 0 on success.
+ ******************************************************************************/
+static int sl_host_stack_parse(FILE *file, sl_host_stack_profile_t *profile)
+{
+  char line[HOST_STACK_LINE_SIZE];
+  sl_host_stack_task_t task;
+  unsigned int index;
+  char *marker;
+
+  while (NULL != fgets(line, sizeof(line), file)) {
+    marker = strstr(line, HOST_STACK_MARKER);
+    if (NULL == marker) {
+      continue;
+    }
+
+    memset(&task, 0, sizeof(task));
+    if (4 != sscanf(marker + strlen("stack_profile : "),
+                    "%63s peak %lu size %lu recommended %lu",
+                    task.name,
+                    &task.peak,
+                    &task.size,
+                    &task.recommended)) {
+      continue;
+    }
+
+    for (index = 0; index < profile->count; index++) {
+      if (0 == strcmp(profile->task[index].name, task.name)) {
+        break;
+      }
+    }
+    if (index == HOST_STACK_MAX_TASKS) {
+      printf("sl_host_stack_config : more than %d tasks\n", HOST_STACK_MAX_TASKS);
+      return 1;
+    }
+    if (index == profile->count) {
+      profile->count++;
+    }
+    profile->task[index] = task;
+  }
+
+  if (0 == profile->count) {
+    printf("sl_host_stack_config : no stack profile report found\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+/**************************************************************************/ /**
+ * @brief Write the stack size header of a profile.
+ ******************************************************************************/
+static void sl_host_stack_write(FILE *file,
+                                const sl_host_stack_profile_t *profile)
+{
+  unsigned int index;
+
+  fprintf(file,
+          "/***************************************************************************/ /**\n"
+          " * @file sl_wifi_asset_tracking_stack_config.h\n"
+          " * @brief Stack depth of application tasks\n"
+          " *******************************************************************************\n"
+          " * # License\n"
+          " * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>\n"
+          " *******************************************************************************\n"
+          " *\n"
+          " * The licensor of this software is Silicon Laboratories Inc. Your use of this\n"
+          " * software is governed by the terms of Silicon Labs Master Software License\n"
+          " * Agreement (MSLA) available at\n"
+          " * www.silabs.com/about-us/legal/master-software-license-agreement. This\n"
+          " * software is distributed to you in Source Code format and is governed by the\n"
+          " * sections of the MSLA applicable to Source Code.\n"
+          " *\n"
+          " ******************************************************************************/\n"
+          "\n"
+          "#ifndef SL_WIFI_ASSET_TRACKING_STACK_CONFIG_H_\n"
+          "#define SL_WIFI_ASSET_TRACKING_STACK_CONFIG_H_\n"
+          "\n"
+          "/*******************************************************************************\n"
+          " ***************************  Defines / Macros  ********************************\n"
+          " ******************************************************************************/\n"
+          "\n"
+          "/// Generated by sl_host_stack_config from a DEMO_CONFIG_STACK_PROFILE run,\n"
+          "/// regenerate instead of editing. Sizes are in words.\n");
+
+  for (index = 0; index < profile->count; index++) {
+    if (0 == profile->task[index].peak) {
+      fprintf(file,
+              "#define %-45s %-6lu ///< Not profiled\n",
+              profile->task[index].name,
+              profile->task[index].recommended);
+    } else {
+      fprintf(file,
+              "#define %-45s %-6lu ///< Peak %lu of %lu\n",
+              profile->task[index].name,
+              profile->task[index].recommended,
+              profile->task[index].peak,
+              profile->task[index].size);
+    }
+  }
+
+  fprintf(file,
+          "\n"
+          "#endif /* SL_WIFI_ASSET_TRACKING_STACK_CONFIG_H_ */\n"
+          "\n"
+          "/******************************************************************************/\n"
+          "/* EOF                                                                        */\n"
+          "/******************************************************************************/\n");
+}
+
+/**************************************************************************/ /**
+ * @brief Parse a capture with repeated, interleaved and malformed reports
+ * and check that the last report of every task is kept in order.
+ * @return 0 on success.
+ ******************************************************************************/
+static int sl_host_stack_self_test(void)
+{
+  static const char capture[] =
+    "\r\nstack_profile : boots 1, margin 25 %, min margin 64 words\r\n"
+    "\r\nstack_profile : STACK_SIZE_LCD_TASK peak 0 size 1000 recommended 1000\r\n"
+    "\r\nstack_profile : STACK_SIZE_LOG_TASK peak 180 size 1000 recommended 256\r\n"
+    "\r\n[   300.002] INFO  lanes  published on lane 1\r\n"
+    "\r\nstack_profile : STACK_SIZE_CLOCK_TASK peak\r\n"
+    "\r\nstack_profile : STACK_SIZE_LCD_TASK peak 210 size 1000 recommended 288\r\n";
+  sl_host_stack_profile_t profile;
+  FILE *file;
+  int status;
+
+  memset(&profile, 0, sizeof(profile));
+  file = fmemopen((void *)capture, sizeof(capture) - 1, "r");
+  if (NULL == file) {
+    perror("fmemopen");
+    return 1;
+  }
+  status = sl_host_stack_parse(file, &profile);
+  fclose(file);
+
+  if ((0 != status)
+      || (2 != profile.count)
+      || (0 != strcmp("STACK_SIZE_LCD_TASK", profile.task[0].name))
+      || (210 != profile.task[0].peak)
+      || (288 != profile.task[0].recommended)
+      || (0 != strcmp("STACK_SIZE_LOG_TASK", profile.task[1].name))
+      || (256 != profile.task[1].recommended)) {
+    printf("sl_host_stack_config : self test failed\n");
+    return 1;
+  }
+
+  printf("stack config       : self test passed\n");
+  return 0;
+}
+
+/**************************************************************************/ /**
+ * @brief Stack config generator entry point.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  static sl_host_stack_profile_t profile;
+  const char *file_name = NULL;
+  const char *output_name = NULL;
+  FILE *file = stdin;
+  FILE *output = stdout;
+  int status;
+  int option;
+
+  while (-1 != (option = getopt(argc, argv, "f:o:th"))) {
+    switch (option) {
+      case 'f':
+        file_name = optarg;
+        break;
+      case 'o':
+        output_name = optarg;
+        break;
+      case 't':
+        return sl_host_stack_self_test();
+      default:
+        printf("usage: %s [-f console.log] [-o stack_config.h] [-t]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  if (NULL != file_name) {
+    file = fopen(file_name, "r");
+    if (NULL == file) {
+      perror(file_name);
+      return 1;
+    }
+  }
+
+  status = sl_host_stack_parse(file, &profile);
+
+  if (NULL != file_name) {
+    fclose(file);
+  }
+  if (0 != status) {
+    return status;
+  }
+
+  if (NULL != output_name) {
+    output = fopen(output_name, "w");
+    if (NULL == output) {
+      perror(output_name);
+      return 1;
+    }
+  }
+
+  sl_host_stack_write(output, &profile);
+
+  if (NULL != output_name) {
+    fclose(output);
+  }
+
+  return 0;
+}
@@ -0,0 +1,265 @@
+/***************************************************************************/ /**
+ * @file sl_host_transport_posix.c
+ * @brief POSIX TCP/TLS socket backend of the application transport interface
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sl_host_transport_posix.h>
+
+#if SL_HOST_TRANSPORT_TLS
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#endif /// < SL_HOST_TRANSPORT_TLS
+
+/**************************************************************************/ /**
+ * @brief Transport interface callbacks of the POSIX backend.
+ ******************************************************************************/
+static sl_status_t sl_host_transport_posix_connect(void *context,
+                                                   const char *host_name,
+                                                   uint16_t port);
+static int32_t sl_host_transport_posix_send(void *context,
+                                            const void *buffer,
+                                            size_t bytes_to_send);
+static int32_t sl_host_transport_posix_recv(void *context,
+                                            void *buffer,
+                                            size_t bytes_to_recv);
+static void sl_host_transport_posix_disconnect(void *context);
+
+/******************************************************************************
+ *  Function to fill a transport interface with the POSIX backend.
+ *****************************************************************************/
+sl_status_t sl_host_transport_posix_init(sl_transport_interface_t *transport,
+                                         sl_host_transport_posix_context_t *context,
+                                         bool use_tls)
+{
+#if !SL_HOST_TRANSPORT_TLS
+  if (use_tls) {
+    printf("sl_host_transport_posix_init : rebuild with TLS=1 for TLS\n");
+    return SL_STATUS_FAIL;
+  }
+#endif /// < SL_HOST_TRANSPORT_TLS
+
+  memset(context, 0, sizeof(sl_host_transport_posix_context_t));
+  context->socket_id = -1;
+  context->use_tls = use_tls;
+  context->recv_timeout_ms = HOST_TRANSPORT_RECV_TIMEOUT_MS;
+
+  transport->connect = sl_host_transport_posix_connect;
+  transport->send = sl_host_transport_posix_send;
+  transport->recv = sl_host_transport_posix_recv;
+  transport->disconnect = sl_host_transport_posix_disconnect;
+  transport->context = context;
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Open TCP connection, optionally wrapped in TLS.
+ *****************************************************************************/
+static sl_status_t sl_host_transport_posix_connect(void *context,
+                                                   const char *host_name,
+                                                   uint16_t port)
+{
+  sl_host_transport_posix_context_t *posix_context = context;
+  struct addrinfo hints = { 0 };
+  struct addrinfo *result = NULL;
+  struct addrinfo *address;
+  struct timeval timeout = { 0 };
+  char port_string[6];
+  int option = 1;
+
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  snprintf(port_string, sizeof(port_string), "%u", port);
+
+  if (0 != getaddrinfo(host_name, port_string, &hints, &result)) {
+    printf("sl_host_transport_posix_connect : cannot resolve %s\n", host_name);
+    return SL_STATUS_FAIL;
+  }
+
+  for (address = result; NULL != address; address = address->ai_next) {
+    posix_context->socket_id = socket(address->ai_family,
+                                      address->ai_socktype,
+                                      address->ai_protocol);
+    if (posix_context->socket_id < 0) {
+      continue;
+    }
+    if (0 == connect(posix_context->socket_id,
+                     address->ai_addr,
+                     address->ai_addrlen)) {
+      break;
+    }
+    close(posix_context->socket_id);
+    posix_context->socket_id = -1;
+  }
+  freeaddrinfo(result);
+
+  if (posix_context->socket_id < 0) {
+    printf("sl_host_transport_posix_connect : connect to %s:%u failed: %s\n",
+           host_name,
+           port,
+           strerror(errno));
+    return SL_STATUS_FAIL;
+  }
+
+  /// Small MQTT packets, do not let Nagle add latency to the measurements
+  setsockopt(posix_context->socket_id,
+             IPPROTO_TCP,
+             TCP_NODELAY,
+             &option,
+             sizeof(option));
+
+  timeout.tv_sec = posix_context->recv_timeout_ms / 1000;
+  timeout.tv_usec = (posix_context->recv_timeout_ms % 1000) * 1000;
+  setsockopt(posix_context->socket_id,
+             SOL_SOCKET,
+             SO_RCVTIMEO,
+             &timeout,
+             sizeof(timeout));
+
+#if SL_HOST_TRANSPORT_TLS
+  if (posix_context->use_tls) {
+    posix_context->ssl_context = SSL_CTX_new(TLS_client_method());
+    if (NULL == posix_context->ssl_context) {
+      goto error;
+    }
+
+    if (posix_context->verify_peer) {
+      SSL_CTX_set_default_verify_paths(posix_context->ssl_context);
+      SSL_CTX_set_verify(posix_context->ssl_context, SSL_VERIFY_PEER, NULL);
+    }
+
+    posix_context->ssl = SSL_new(posix_context->ssl_context);
+    if (NULL == posix_context->ssl) {
+      goto error;
+    }
+
+    SSL_set_tlsext_host_name(posix_context->ssl, host_name);
+    SSL_set_fd(posix_context->ssl, posix_context->socket_id);
+
+    if (1 != SSL_connect(posix_context->ssl)) {
+      ERR_print_errors_fp(stdout);
+      goto error;
+    }
+  }
+#endif /// < SL_HOST_TRANSPORT_TLS
+
+  return SL_STATUS_OK;
+
+#if SL_HOST_TRANSPORT_TLS
+  error:
+  printf("sl_host_transport_posix_connect : TLS handshake with %s failed\n",
+         host_name);
+  sl_host_transport_posix_disconnect(posix_context);
+  return SL_STATUS_FAIL;
+#endif /// < SL_HOST_TRANSPORT_TLS
+}
+
+/******************************************************************************
+ *  Send on TCP or TLS connection.
+ *****************************************************************************/
+static int32_t sl_host_transport_posix_send(void *context,
+                                            const void *buffer,
+                                            size_t bytes_to_send)
+{
+  sl_host_transport_posix_context_t *posix_context = context;
+
+#if SL_HOST_TRANSPORT_TLS
+  if (posix_context->use_tls) {
+    return SSL_write(posix_context->ssl, buffer, (int)bytes_to_send);
+  }
+#endif /// < SL_HOST_TRANSPORT_TLS
+
+  return (int32_t)send(posix_context->socket_id,
+                       buffer,
+                       bytes_to_send,
+                       MSG_NOSIGNAL);
+}
+
+/******************************************************************************
+ *  Receive on TCP or TLS connection, 0 on timeout as on the SiWx91x socket.
+ *****************************************************************************/
+static int32_t sl_host_transport_posix_recv(void *context,
+                                            void *buffer,
+                                            size_t bytes_to_recv)
+{
+  sl_host_transport_posix_context_t *posix_context = context;
+  ssize_t recv_bytes;
+
+#if SL_HOST_TRANSPORT_TLS
+  if (posix_context->use_tls) {
+    recv_bytes = SSL_read(posix_context->ssl, buffer, (int)bytes_to_recv);
+    if (recv_bytes > 0) {
+      return (int32_t)recv_bytes;
+    }
+    switch (SSL_get_error(posix_context->ssl, (int)recv_bytes)) {
+      case SSL_ERROR_WANT_READ:
+        return 0;
+      case SSL_ERROR_ZERO_RETURN:
+        return SL_TRANSPORT_PEER_CLOSED;
+      default:
+        return -1;
+    }
+  }
+#endif /// < SL_HOST_TRANSPORT_TLS
+
+  recv_bytes = recv(posix_context->socket_id, buffer, bytes_to_recv, 0);
+
+  if (recv_bytes < 0) {
+    if ((EAGAIN == errno) || (EWOULDBLOCK == errno)) {
+      return 0;
+    }
+    return -1;
+  }
+
+  /// Orderly shutdown by peer is an error for the MQTT client
+  if (0 == recv_bytes) {
+    return SL_TRANSPORT_PEER_CLOSED;
+  }
+
+  return (int32_t)recv_bytes;
+}
+
+/******************************************************************************
+ *  Close TCP or TLS connection.
+ *****************************************************************************/
+static void sl_host_transport_posix_disconnect(void *context)
+{
+  sl_host_transport_posix_context_t *posix_context = context;
+
+#if SL_HOST_TRANSPORT_TLS
+  if (NULL != posix_context->ssl) {
+    SSL_shutdown(posix_context->ssl);
+    SSL_free(posix_context->ssl);
+    posix_context->ssl = NULL;
+  }
+  if (NULL != posix_context->ssl_context) {
+    SSL_CTX_free(posix_context->ssl_context);
+    posix_context->ssl_context = NULL;
+  }
+#endif /// < SL_HOST_TRANSPORT_TLS
+
+  if (posix_context->socket_id >= 0) {
+    close(posix_context->socket_id);
+  }
+  posix_context->socket_id = -1;
+}
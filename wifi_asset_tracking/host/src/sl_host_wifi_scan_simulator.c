@@ -0,0 +1,433 @@
+/***************************************************************************/ /**
+ * @file sl_host_wifi_scan_simulator.c
+ * @brief Offline scan lists through the Wi-Fi positioning selection and encoding
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sl_wifi_asset_tracking_wifi_fingerprint.h>
+#include <sl_host_payload.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define HOST_SCAN_MAX_RESULTS                64     ///< Scan results per scan, as many as the SiWx91x reports
+#define HOST_SCAN_DEFAULT_SCANS              10000  ///< Generated scans per run
+#define HOST_SCAN_DEFAULT_APS                24     ///< Generated access points per scan
+#define HOST_SCAN_LINE_SIZE                  128    ///< Longest line of a scan list file
+#define HOST_SCAN_MESSAGE_TEMPLATE \
+  "{\"msgtype\":\"wifiscan\",\"timestamp\":\"2024-01-01T00:00:00.000Z\",\"wifiscan\":\"%s\"}" ///< Layout of the firmware message
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one scan result as reported by the network processor
+typedef struct {
+  uint8_t bssid[WIFI_FINGERPRINT_BSSID_SIZE]; ///< Access point MAC address
+  int8_t rssi;                                ///< In dBm
+  uint8_t channel;                            ///< Wi-Fi channel
+  char ssid[34];                              ///< Terminated SSID
+} sl_host_scan_result_t;
+
+/// @brief Structure for results of one scan
+typedef struct {
+  uint32_t count;                                       ///< Valid entries in result
+  sl_host_scan_result_t result[HOST_SCAN_MAX_RESULTS];  ///< Scan results in reported order
+} sl_host_scan_t;
+
+/// @brief Structure for totals of a run
+typedef struct {
+  uint64_t scans;         ///< Scans checked
+  uint64_t results;       ///< Scan results offered
+  uint64_t selected;      ///< Access points kept
+  uint64_t empty;         ///< Scans without usable access point
+  uint32_t longest_text;  ///< Longest base64 fingerprint
+  uint32_t longest_json;  ///< Longest JSON message
+} sl_host_scan_stats_t;
+
+/**************************************************************************/ /**
+ * @brief Pseudo random number, same sequence on every host.
+ ******************************************************************************/
+static uint32_t sl_host_scan_random(uint32_t *state)
+{
+  *state = (*state * 1103515245u) + 12345u;
+  return *state >> 8;
+}
+
+/**************************************************************************/ /**
+ * @brief Build an office like scan: fixed access points, phone hotspots,
+ * opted out access points and BSSIDs reported on two channels.
+ ******************************************************************************/
+static void sl_host_scan_generate(sl_host_scan_t *scan,
+                                  uint32_t ap_count,
+                                  uint32_t *state)
+{
+  sl_host_scan_result_t *result;
+  uint32_t kind;
+  uint32_t index;
+
+  scan->count = 0;
+  for (index = 0; (index < ap_count) && (scan->count < HOST_SCAN_MAX_RESULTS);
+       ++index) {
+    result = &scan->result[scan->count];
+    kind = sl_host_scan_random(state) % 20;
+
+    if ((kind < 2) && (scan->count > 0)) {
+      /// Same BSSID again with another RSSI
+      *result = scan->result[sl_host_scan_random(state) % scan->count];
+      result->rssi = (int8_t)(-30 - (int)(sl_host_scan_random(state) % 70));
+      scan->count++;
+      continue;
+    }
+
+    /// A small pool of BSSIDs makes ties and repeats across scans likely
+    result->bssid[0] = 0x00;
+    result->bssid[1] = 0x1B;
+    result->bssid[2] = 0x63;
+    result->bssid[3] = (uint8_t)(sl_host_scan_random(state) % 4);
+    result->bssid[4] = (uint8_t)sl_host_scan_random(state);
+    result->bssid[5] = (uint8_t)sl_host_scan_random(state);
+    result->rssi = (int8_t)(-30 - (int)(sl_host_scan_random(state) % 70));
+    result->channel = (uint8_t)(1 + (sl_host_scan_random(state) % 13));
+    snprintf(result->ssid, sizeof(result->ssid), "office-%u", index);
+
+    if (kind < 5) {
+      /// Phone hotspot, locally administered address
+      result->bssid[0] = 0xDA;
+      snprintf(result->ssid, sizeof(result->ssid), "phone-%u", index);
+    } else if (kind < 6) {
+      snprintf(result->ssid, sizeof(result->ssid), "home-%u_nomap", index);
+    } else if (kind < 7) {
+      result->ssid[0] = '\0';
+    }
+
+    scan->count++;
+  }
+}
+
+/**************************************************************************/ /**
+ * @brief Read the next scan of a scan list file. Each line is
+ * "bssid,rssi,channel,ssid", a blank line ends a scan.
+ * @return 1 when a scan was read, 0 at end of file, -1 on a malformed line.
+ ******************************************************************************/
+static int sl_host_scan_read(FILE *file, sl_host_scan_t *scan)
+{
+  char line[HOST_SCAN_LINE_SIZE];
+  unsigned int octet[WIFI_FINGERPRINT_BSSID_SIZE];
+  sl_host_scan_result_t *result;
+  int rssi;
+  unsigned int channel;
+  int consumed;
+  uint32_t index;
+
+  scan->count = 0;
+  while (NULL != fgets(line, sizeof(line), file)) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if ('#' == line[0]) {
+      continue;
+    }
+    if ('\0' == line[0]) {
+      if (scan->count > 0) {
+        return 1;
+      }
+      continue;
+    }
+    if (scan->count >= HOST_SCAN_MAX_RESULTS) {
+      continue;
+    }
+
+    result = &scan->result[scan->count];
+    consumed = 0;
+    if (8 != sscanf(line,
+                    "%x:%x:%x:%x:%x:%x,%d,%u,%n",
+                    &octet[0], &octet[1], &octet[2],
+                    &octet[3], &octet[4], &octet[5],
+                    &rssi, &channel, &consumed)
+        || (0 == consumed)) {
+      printf("sl_host_wifi_scan_simulator : malformed line \"%s\"\n", line);
+      return -1;
+    }
+
+    for (index = 0; index < WIFI_FINGERPRINT_BSSID_SIZE; ++index) {
+      result->bssid[index] = (uint8_t)octet[index];
+    }
+    result->rssi = (int8_t)rssi;
+    result->channel = (uint8_t)channel;
+    snprintf(result->ssid, sizeof(result->ssid), "%s", &line[consumed]);
+    scan->count++;
+  }
+
+  return (scan->count > 0) ? 1 : 0;
+}
+
+/**************************************************************************/ /**
+ * @brief Selection the slow way: strongest reading of each usable BSSID,
+ * earliest reading first on equal RSSI, then the strongest ones.
+ ******************************************************************************/
+static void sl_host_scan_reference(const sl_host_scan_t *scan,
+                                   sl_wifi_fingerprint_t *expected)
+{
+  uint32_t best[HOST_SCAN_MAX_RESULTS];
+  uint32_t best_count = 0;
+  uint32_t index;
+  uint32_t other;
+  uint32_t swap;
+  const sl_host_scan_result_t *result;
+  const char *suffix = WIFI_FINGERPRINT_NOMAP_SUFFIX;
+  size_t ssid_len;
+
+  for (index = 0; index < scan->count; ++index) {
+    result = &scan->result[index];
+    ssid_len = strlen(result->ssid);
+
+    if ((result->rssi < WIFI_FINGERPRINT_MIN_RSSI)
+        || (result->bssid[0] & 0x02)
+        || ((ssid_len >= strlen(suffix))
+            && (0 == strcmp(&result->ssid[ssid_len - strlen(suffix)],
+                            suffix)))) {
+      continue;
+    }
+
+    for (other = 0; other < best_count; ++other) {
+      if (0 == memcmp(scan->result[best[other]].bssid,
+                      result->bssid,
+                      WIFI_FINGERPRINT_BSSID_SIZE)) {
+        break;
+      }
+    }
+
+    if (other == best_count) {
+      best[best_count++] = index;
+    } else if (result->rssi > scan->result[best[other]].rssi) {
+      best[other] = index;
+    }
+  }
+
+  /// Stable sort by RSSI, ties in order of the reading kept
+  for (index = 1; index < best_count; ++index) {
+    for (other = index; other > 0; --other) {
+      if ((scan->result[best[other]].rssi
+           > scan->result[best[other - 1]].rssi)
+          || ((scan->result[best[other]].rssi
+               == scan->result[best[other - 1]].rssi)
+              && (best[other] < best[other - 1]))) {
+        swap = best[other];
+        best[other] = best[other - 1];
+        best[other - 1] = swap;
+      }
+    }
+  }
+
+  sl_wifi_fingerprint_init(expected);
+  for (index = 0; (index < best_count) && (index < WIFI_FINGERPRINT_MAX_APS);
+       ++index) {
+    result = &scan->result[best[index]];
+    memcpy(expected->ap[index].bssid,
+           result->bssid,
+           WIFI_FINGERPRINT_BSSID_SIZE);
+    expected->ap[index].rssi = result->rssi;
+    expected->ap[index].channel = result->channel;
+    expected->ap_count++;
+  }
+}
+
+/**************************************************************************/ /**
+ * @brief Print a fingerprint the way the backend stores it.
+ ******************************************************************************/
+static void sl_host_scan_print(const sl_wifi_fingerprint_t *fingerprint,
+                               const char *text)
+{
+  uint8_t index;
+
+  printf("%s\n", text);
+  for (index = 0; index < fingerprint->ap_count; ++index) {
+    printf("  %02X:%02X:%02X:%02X:%02X:%02X  %4d dBm  channel %u\n",
+           fingerprint->ap[index].bssid[0],
+           fingerprint->ap[index].bssid[1],
+           fingerprint->ap[index].bssid[2],
+           fingerprint->ap[index].bssid[3],
+           fingerprint->ap[index].bssid[4],
+           fingerprint->ap[index].bssid[5],
+           fingerprint->ap[index].rssi,
+           fingerprint->ap[index].channel);
+  }
+}
+
+/**************************************************************************/ /**
+ * @brief Run one scan through selection and encoding and check the result.
+ * @return 0 on success.
+ ******************************************************************************/
+static int sl_host_scan_check(const sl_host_scan_t *scan,
+                              sl_host_scan_stats_t *stats,
+                              int verbose)
+{
+  sl_wifi_fingerprint_t fingerprint;
+  sl_wifi_fingerprint_t expected;
+  sl_wifi_fingerprint_t decoded;
+  char text[WIFI_FINGERPRINT_MAX_TEXT_SIZE];
+  char message[HOST_PAYLOAD_MAX_SIZE + 1];
+  uint32_t index;
+  int length;
+
+  sl_wifi_fingerprint_init(&fingerprint);
+  for (index = 0; index < scan->count; ++index) {
+    sl_wifi_fingerprint_add(&fingerprint,
+                            scan->result[index].bssid,
+                            scan->result[index].rssi,
+                            scan->result[index].channel,
+                            (const uint8_t *)scan->result[index].ssid,
+                            strlen(scan->result[index].ssid));
+  }
+
+  stats->scans++;
+  stats->results += scan->count;
+  stats->selected += fingerprint.ap_count;
+
+  sl_host_scan_reference(scan, &expected);
+  if ((expected.ap_count != fingerprint.ap_count)
+      || (0 != memcmp(expected.ap,
+                      fingerprint.ap,
+                      fingerprint.ap_count * sizeof(fingerprint.ap[0])))) {
+    printf("sl_host_wifi_scan_simulator : selection differs from reference\n");
+    return 1;
+  }
+
+  if (0 == fingerprint.ap_count) {
+    /// Firmware publishes nothing for such a scan
+    stats->empty++;
+    return (SL_STATUS_OK
+            == sl_wifi_fingerprint_encode(&fingerprint, text, sizeof(text)));
+  }
+
+  if ((SL_STATUS_OK
+       != sl_wifi_fingerprint_encode(&fingerprint, text, sizeof(text)))
+      || (SL_STATUS_OK != sl_wifi_fingerprint_decode(text, &decoded))
+      || (decoded.ap_count != fingerprint.ap_count)
+      || (0 != memcmp(decoded.ap,
+                      fingerprint.ap,
+                      fingerprint.ap_count * sizeof(fingerprint.ap[0])))) {
+    printf("sl_host_wifi_scan_simulator : encoding round trip failed\n");
+    return 1;
+  }
+
+  length = snprintf(message, sizeof(message), HOST_SCAN_MESSAGE_TEMPLATE, text);
+  if ((length < 0) || (length >= HOST_PAYLOAD_MAX_SIZE)) {
+    printf("sl_host_wifi_scan_simulator : message of %d bytes does not fit\n",
+           length);
+    return 1;
+  }
+
+  if (strlen(text) > stats->longest_text) {
+    stats->longest_text = (uint32_t)strlen(text);
+  }
+  if ((uint32_t)length > stats->longest_json) {
+    stats->longest_json = (uint32_t)length;
+  }
+
+  if (verbose) {
+    sl_host_scan_print(&fingerprint, text);
+  }
+
+  return 0;
+}
+
+/**************************************************************************/ /**
+ * @brief Scan list simulator entry point.
+ ******************************************************************************/
+int main(int argc, char *argv[])
+{
+  static sl_host_scan_t scan;
+  sl_host_scan_stats_t stats = { 0 };
+  uint32_t scan_count = HOST_SCAN_DEFAULT_SCANS;
+  uint32_t ap_count = HOST_SCAN_DEFAULT_APS;
+  uint32_t seed = 1;
+  uint32_t index;
+  const char *file_name = NULL;
+  FILE *file;
+  int verbose = 0;
+  int option;
+  int status;
+
+  while (-1 != (option = getopt(argc, argv, "f:n:a:s:vh"))) {
+    switch (option) {
+      case 'f':
+        file_name = optarg;
+        break;
+      case 'n':
+        scan_count = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'a':
+        ap_count = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 's':
+        seed = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'v':
+        verbose = 1;
+        break;
+      default:
+        printf("usage: %s [-f scan_list.csv] [-n scans] [-a aps] [-s seed] [-v]\n",
+               argv[0]);
+        return 1;
+    }
+  }
+
+  if (NULL != file_name) {
+    file = fopen(file_name, "r");
+    if (NULL == file) {
+      perror(file_name);
+      return 1;
+    }
+
+    while (1 == (status = sl_host_scan_read(file, &scan))) {
+      if (0 != sl_host_scan_check(&scan, &stats, verbose)) {
+        fclose(file);
+        return 1;
+      }
+    }
+    fclose(file);
+
+    if (status < 0) {
+      return 1;
+    }
+  } else {
+    for (index = 0; index < scan_count; ++index) {
+      sl_host_scan_generate(&scan, ap_count, &seed);
+      if (0 != sl_host_scan_check(&scan, &stats, verbose && (index < 4))) {
+        return 1;
+      }
+    }
+  }
+
+  if (0 == stats.scans) {
+    printf("sl_host_wifi_scan_simulator : no scan\n");
+    return 1;
+  }
+
+  printf("scans              : %llu, %llu without usable access point\n",
+         (unsigned long long)stats.scans,
+         (unsigned long long)stats.empty);
+  printf("access points      : %.1f seen, %.1f kept per scan\n",
+         (double)stats.results / stats.scans,
+         (double)stats.selected / stats.scans);
+  printf("longest message    : %u bytes base64, %u bytes JSON of %u\n",
+         stats.longest_text,
+         stats.longest_json,
+         HOST_PAYLOAD_MAX_SIZE);
+
+  return 0;
+}
@@ -33,48 +33,72 @@ extern "C" {
 #include <sl_wifi_asset_tracking_azure_handler.h>
 #include <sl_wifi_asset_tracking_json_data_handler.h>
 #include <sl_wifi_asset_tracking_lcd.h>
+#include <sl_wifi_asset_tracking_dns_cache.h>
+#include <sl_wifi_asset_tracking_sas_token.h>
+#include <sl_wifi_asset_tracking_publish_lanes.h>
+#include <sl_wifi_asset_tracking_rate_limit.h>
+#include <sl_wifi_asset_tracking_compress.h>
+#include <sl_wifi_asset_tracking_wifi_fingerprint.h>
+#include <sl_wifi_asset_tracking_wifi_rejoin.h>
+#include <sl_wifi_asset_tracking_link_monitor.h>
+#include <sl_wifi_asset_tracking_power_save.h>
+#include <sl_wifi_asset_tracking_clock.h>
+#include <sl_wifi_asset_tracking_device_identity.h>
+#include <sl_wifi_asset_tracking_metrics.h>
+#include <sl_wifi_asset_tracking_log.h>
+#include <sl_wifi_asset_tracking_static_alloc.h>
+#include <sl_wifi_asset_tracking_stack_config.h>
+#include <sl_wifi_asset_tracking_stack_profile.h>
+#include <sl_wifi_asset_tracking_wake_planner.h>
+#include <sl_wifi_asset_tracking_supervisor.h>
+#include <sl_wifi_asset_tracking_event_bus.h>
+#include <sl_wifi_asset_tracking_recovery.h>
 
 /*******************************************************************************
  ***************************  Defines / Macros  ********************************
  ******************************************************************************/
 #define PRIORITY_TEMPERATURE_RH_SENSOR_TASK                             1                           ///< Priority for temperature and humidity reading task
-#define STACK_SIZE_TEMPERATURE_RH_SENSOR_TASK                           1000                        ///< Stack size for temperature and humidity reading task
 #define NAME_TEMPERATURE_RH_SENSOR_TASK \
   "temp_rh_sensor_task"                                                                             ///< String for temperature and humidity reading task
 #define PRIORITY_IMU_SENSOR_TASK                                        1                           ///< Priority for imu sensor reading task
-#define STACK_SIZE_IMU_SENSOR_TASK                                      1000                        ///< Stack size for imu sensor reading task
 #define NAME_IMU_SENSOR_TASK \
   "imu_sensor_task"                                                                                 ///< String for imu sensor reading task
 #define PRIORITY_GNSS_RECEIVER_TASK                                     1                           ///< Priority for GNSS receiver reading task
-#define STACK_SIZE_GNSS_RECEIVER_TASK                                   1000                        ///< Stack size for GNSS receiver reading task
 #define NAME_GNSS_RECEIVER_TASK \
   "gnss_receiver_task"                                                                              ///< String for GNSS receiver reading task
 #define PRIORITY_WIFI_DATA_CAPTURE_TASK                                 1                           ///< Priority for Wi-Fi data capture task
-#define STACK_SIZE_WIFI_DATA_CAPTURE_TASK                               1000                        ///< Stack size for Wi-Fi data capture task
 #define NAME_WIFI_DATA_CAPTURE_TASK \
   "wifi_data_capture_task"                                                                          ///< String for Wi-Fi data capture task
 #define PRIORITY_JSON_DATA_CONVERTER_TASK                               2                           ///< Priority for JSON data converter task
-#define STACK_SIZE_JSON_DATA_CONVERTER_TASK                             1000                        ///< Stack size for JSON data converter task
 #define NAME_JSON_DATA_CONVERTER_TASK \
   "json_data_converter_task"                                                                        ///< String for JSON data converter task
 #define PRIORITY_CLOUD_COMMUNICATION_TASK                               3                           ///< Priority for cloud communication task
-#define STACK_SIZE_CLOUD_COMMUNICATION_TASK                             1000                        ///< Stack size for cloud communication task
 #define NAME_CLOUD_COMMUNICATION_TASK \
   "cloud_communication_task"                                                                        ///< String for cloud communication task
 #define PRIORITY_RECOVERY_TASK                                          4                           ///< Priority for recovery task
-#define STACK_SIZE_RECOVERY_TASK                                        1000                        ///< Stack size for recovery task
 #define NAME_RECOVERY_TASK \
   "recovery_task"                                                                                   ///< String for recovery task
-#define PRIORITY_LCD_TASK                                               4                           ///< Priority for LCD task
-#define STACK_SIZE_LCD_TASK                                             1000                        ///< Stack size for LCD task
+#define PRIORITY_LCD_TASK                                               1                           ///< Priority for LCD task, below connectivity and recovery
 #define NAME_LCD_TASK \
   "lcd_task"                                                                                        ///< String for LCD task
+#define PRIORITY_LINK_MONITOR_TASK                                      2                           ///< Priority for Wi-Fi link monitor task
+#define NAME_LINK_MONITOR_TASK \
+  "link_monitor_task"                                                                               ///< String for Wi-Fi link monitor task
+#define PRIORITY_CLOCK_TASK                                             1                           ///< Priority for clock discipline task
+#define NAME_CLOCK_TASK \
+  "clock_task"                                                                                      ///< String for clock discipline task
+#define PRIORITY_METRICS_TASK                                           1                           ///< Priority for metrics report task
+#define NAME_METRICS_TASK \
+  "metrics_task"                                                                                    ///< String for metrics report task
+#define PRIORITY_LOG_TASK                                               0                           ///< Priority for deferred log task, same as idle task
+#define NAME_LOG_TASK \
+  "log_task"                                                                                        ///< String for deferred log task
+#define PRIORITY_SUPERVISOR_TASK                                        5                           ///< Priority for task supervisor, above every supervised task
+#define NAME_SUPERVISOR_TASK \
+  "supervisor_task"                                                                                 ///< String for task supervisor
 #define MAX_SIZE_OF_SENSOR_DATA_QUEUE                                   10                          ///< Maximum size of sensor data queue
-#define MAX_SIZE_OF_MQTT_PACKAGE_QUEUE \
-  MAX_SIZE_OF_SENSOR_DATA_QUEUE        \
-  * 2                                                                                                      ///< Maximum size for MQTT package queue
-#define MAX_SIZE_OF_LCD_DATA_QUEUE                                      5                           ///< Maximum size for LCD data queue
-#define MAX_LCD_STRING_SIZE                                             80                          ///< Maximum string size for LCD
+#define MAX_SIZE_OF_LCD_DATA_QUEUE                                      16                          ///< Maximum size for LCD data queue
+#define MAX_LCD_STRING_SIZE                                             80                          ///< Maximum string size for LCD, including terminator
 #define MAX_TELEMETRY_PROPERTY_BUFFER_SIZE                              80                          ///< Maximum size for telemetry buffer
 #define NAME_TEMPERATURE_RH_SENSOR_TIMER \
   "temp_rh_sensor_timer"                                                                            ///< String for temperature and humidity sensor timer
@@ -117,19 +141,10 @@ typedef enum {
   SL_CLOUD_SHUTDOWN          = 0x03   ///< If cloud connectivity fails after retry
 } sl_siwx917_wifi_asset_tracking_cloud_connectivity_status_e;
 
-/// @brief Enum for recovery task status
-typedef enum {
-  SL_RECOVERY_INPROGRESS     = 0x00,  ///< If recovery task is busy
-  SL_RECOVERY_IDLE           = 0x01   ///< If recovery task is not in use
-} sl_siwx917_wifi_asset_tracking_recovery_task_status_e;
-
 /// @brief Enum for indexing LCD messages/logs
 typedef enum {
   INDEX_APP_START = 0,
   INDEX_BLANK_LINE,
-  INDEX_SENSOR_SHUTDOWN,
-  INDEX_WIFI_SHUTDOWN,
-  INDEX_CLOUD_SHUTDOWN,
   INDEX_SI7021_NOT_CONNECTED,
   INDEX_BMI270_NOT_CONNECTED,
   INDEX_MAX_M10S_NOT_CONNECTED,
@@ -142,7 +157,8 @@ typedef enum {
   INDEX_WIFI_CONNECTED,
   INDEX_AZURE_CLOUD_CONNECTED,
   INDEX_WIFI_RETRY,
-  INDEX_AZURE_CLOUD_RETRY
+  INDEX_AZURE_CLOUD_RETRY,
+  INDEX_LCD_MESSAGE_COUNT     ///< Number of LCD messages
 } sl_siwx917_wifi_asset_tracking_lcd_logs_indexing_e;
 
 /// @brief Structure for tasks required in wi-fi asset tracking example
@@ -155,6 +171,11 @@ typedef struct {
   TaskHandle_t azure_cloud_communication_task_handler; ///< Azure cloud communication task handler
   TaskHandle_t recovery_task_handler;                  ///< Wi-Fi asset tracking application recovery task handler
   TaskHandle_t lcd_task_handler;                       ///< Wi-Fi asset tracking application LCD task handler
+  TaskHandle_t link_monitor_task_handler;              ///< Wi-Fi link monitor task handler
+  TaskHandle_t clock_task_handler;                     ///< Clock discipline task handler
+  TaskHandle_t metrics_task_handler;                   ///< Metrics report task handler
+  TaskHandle_t log_task_handler;                       ///< Deferred log task handler
+  TaskHandle_t supervisor_task_handler;                ///< Task supervisor handler
 } sl_wifi_asset_tracking_task_list_t;
 
 /// @brief Structure for resources required in wi-fi asset tracking example
@@ -162,18 +183,25 @@ typedef struct {
   int client_socket_id;                           ///< client socket id
   QueueHandle_t sensor_data_queue_handler;        ///< Sensor data queue handler
   QueueHandle_t sensor_data_queue_mutex_handler;  ///< Sensor data queue mutex handler
-  QueueHandle_t mqtt_package_queue_handler;       ///< MQTT package queue handler
+  QueueHandle_t mqtt_lane_queue_handler[SL_PUBLISH_LANE_COUNT]; ///< MQTT package queue handler per publish lane
   QueueHandle_t mqtt_package_queue_mutex_handler; ///< MQTT package queue mutex handler
   QueueHandle_t lcd_queue_handler;                ///< LCD data queue handler
-  QueueHandle_t recovery_status_mutex_handler;    ///< Recovery in progress status mutex handler
   SemaphoreHandle_t i2c_mutex_handler;            ///< I2C transaction mutex handler
+  SemaphoreHandle_t dns_cache_mutex_handler;      ///< DNS cache access mutex handler
+  SemaphoreHandle_t sas_token_mutex_handler;      ///< SAS token cache access mutex handler
+  SemaphoreHandle_t clock_mutex_handler;          ///< SNTP client and clock discipline mutex handler
+  SemaphoreHandle_t wifi_scan_mutex_handler;      ///< Wi-Fi scan mutex handler, one scan at a time
   TimerHandle_t temperature_rh_sensor_timer;      ///< si7021 sensor timer handler
   TimerHandle_t imu_sensor_timer;                 ///< bmi270 sensor timer handler
   TimerHandle_t gnss_sensor_timer;                ///< gnss sensor timer handler
+  TimerHandle_t sas_token_refresh_timer;          ///< SAS token refresh timer handler
+  TimerHandle_t mqtt_keep_alive_timer;            ///< MQTT keep-alive processing timer handler
   sl_wifi_asset_tracking_task_list_t task_list;   ///< Task required in wi-fi asset tracking example
   AzureIoTHubClient_t azure_iot_hub_client;       ///< Azure IoT Hub client resource
   AzureIoTMessageProperties_t azure_msg_property_bag; ///< Azure tele-metry messages properties bag
   uint8_t azure_msg_property_buff[MAX_TELEMETRY_PROPERTY_BUFFER_SIZE]; ///< Azure message property buffer
+  AzureIoTMessageProperties_t azure_msg_compressed_property_bag; ///< Azure tele-metry properties bag of compressed messages
+  uint8_t azure_msg_compressed_property_buff[MAX_TELEMETRY_PROPERTY_BUFFER_SIZE]; ///< Azure compressed message property buffer
 } sl_wifi_asset_tracking_resource_t;
 
 /// @brief Structure for connected sensors status
@@ -181,24 +209,22 @@ typedef struct {
   uint8_t temp_rh_sensor_probe_status;    ///< Holds initialization and probing status of temp and RH sensor
   uint8_t imu_sensor_probe_status;        ///< Holds initialization and probing status of IMU sensor
   uint8_t gnss_receiver_probe_status;     ///< Holds initialization and probing status of GNSS receiver
-  uint8_t temp_rh_sensor_retry_cnt;       ///< Holds retry count for sensor read failure of temp and RH sensor
-  uint8_t imu_sensor_retry_cnt;           ///< Holds retry count for sensor read failure of IMU sensor
-  uint8_t gnss_receiver_retry_cnt;        ///< Holds retry count for sensor read failure of GNSS receiver
 } sl_wifi_asset_tracking_sensor_status_t;
 
 /// @brief Structure for wi-fi asset tracking application status
 typedef struct {
-  bool app_shutdown;                                    ///< Holds status about application shutdown w.r.t LCD
   uint8_t wifi_conn_status;                             ///< Holds status about wi-fi connection
   uint8_t azure_cloud_conn_status;                      ///< Holds status about cloud connection
   bool lcd_init_status;                                 ///< Holds status about LCD initialization
-  uint8_t recovery_progress_status;                     ///< Holds status about whether recovery is in progress or not
   sl_wifi_asset_tracking_sensor_status_t sensor_status; ///< Holds status about all the probed and initialized sensors
 } sl_wifi_asset_tracking_status_t;
 
-/// @brief Structure for LCD data queue object
+/// @brief Structure for LCD data queue object, the string is looked up by the
+/// LCD task
 typedef struct {
-  uint8_t lcd_buffer[MAX_LCD_STRING_SIZE]; ///< LCD string buffer
+  uint8_t msg_index;  ///< sl_siwx917_wifi_asset_tracking_lcd_logs_indexing_e of the string
+  bool has_value;     ///< Value is drawn behind the string
+  int32_t value;      ///< Value drawn behind the string
 } sl_wifi_asset_tracking_lcd_queue_data_t;
 
 // -----------------------------------------------------------------------------
@@ -241,11 +267,6 @@ void sl_wifi_asset_tracking_recovery_task();
  ******************************************************************************/
 sl_status_t sl_deinit_wifi_asset_tracking_resource();
 
-/***************************************************************************/ /**
- * De-initialize the entire application
- ******************************************************************************/
-void sl_stop_wifi_asset_tracking_application();
-
 /***************************************************************************/ /**
  * Getter function for wi-fi asset tracking resource object
  * @return valid wi-fi asset tracking resource instance
@@ -264,6 +285,30 @@ sl_wifi_asset_tracking_status_t * sl_get_wifi_asset_tracking_status();
  ******************************************************************************/
 char ** sl_get_wifi_asset_tracking_lcd_string();
 
+/***************************************************************************/ /**
+ * Setter function for wi-fi connection status, publishes the matching event
+ * when the status changes
+ * @param[in] status : sl_siwx917_wifi_asset_tracking_wifi_connectivity_status_e
+ ******************************************************************************/
+void sl_wifi_asset_tracking_set_wifi_status(uint8_t status);
+
+/***************************************************************************/ /**
+ * Setter function for cloud connection status, publishes the matching event
+ * when the status changes
+ * @param[in] status : sl_siwx917_wifi_asset_tracking_cloud_connectivity_status_e
+ ******************************************************************************/
+void sl_wifi_asset_tracking_set_cloud_status(uint8_t status);
+
+/***************************************************************************/ /**
+ * Setter function for sensor probe status, publishes the matching event
+ * when the status changes
+ * @param[in] sensor : SL_TEMP_RH_SENSOR, SL_IMU_SENSOR or SL_GNSS_RECEIVER
+ * @param[in] status : sl_siwx917_wifi_asset_tracking_sensor_status_e
+ ******************************************************************************/
+void sl_wifi_asset_tracking_set_sensor_status(
+  sl_wifi_asset_tracking_sensor_queue_data_type_e sensor,
+  uint8_t status);
+
 #ifdef __cplusplus
 }
 #endif
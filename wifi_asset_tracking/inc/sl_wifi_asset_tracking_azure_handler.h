@@ -25,12 +25,12 @@ extern "C" {
 #include <sl_status.h>
 #include <azure_iot_hub_client.h>
 #include <sl_transport_tls_socket.h>
+#include <sl_wifi_asset_tracking_transport.h>
 
 /*******************************************************************************
  ***************************  Defines / Macros  ********************************
  ******************************************************************************/
-#define AZURE_CLOUD_CONN_RETRY_COUNT              10    ///< In numbers
-#define AZURE_CLOUD_CONN_DELAY_BETN_RETRY         5000  ///< In ms
+#define AZURE_CLOUD_CONN_DELAY_BETN_RETRY         5000  ///< In ms, first recovery backoff, doubled per failed attempt
 #define QUEUE_EMPTY                               0     ///< Empty queue status
 #define MAX_JSON_MESSAGE_SIZE                     200   ///< Maximum size of JSON message
 #define SSL_CERTIFICATE_INDEX                     0     ///< SSL certificate index
@@ -48,6 +48,33 @@ extern "C" {
  */
 #define TRANSPORT_MQTT_CONNACK_RECV_TIMEOUT_MS    (10 * 1000U)
 
+/**
+ * @brief MQTT keep-alive in seconds, IoT Hub reports the device disconnected
+ *        after 1.5 times this without any packet.
+ * @remark Set azureiotconfigKEEP_ALIVE_TIMEOUT_SECONDS in the project defines
+ *         to change it.
+ */
+#ifndef azureiotconfigKEEP_ALIVE_TIMEOUT_SECONDS
+#define azureiotconfigKEEP_ALIVE_TIMEOUT_SECONDS  (60U)
+#endif
+
+/**
+ * @brief Period in milliseconds of MQTT processing, which sends PINGREQ once
+ *        the connection was idle for the keep-alive and reads PINGRESP.
+ *        A ping goes out up to one period after the keep-alive expired, a
+ *        quarter keeps it well inside the 1.5 times the broker allows.
+ */
+#define MQTT_KEEP_ALIVE_PROCESS_PERIOD            \
+  ((azureiotconfigKEEP_ALIVE_TIMEOUT_SECONDS * 1000U) / 4)
+
+/**
+ * @brief Time in milliseconds one MQTT processing run waits for packets.
+ */
+#define MQTT_PROCESS_LOOP_TIMEOUT_MS              (500U)
+
+#define NAME_MQTT_KEEP_ALIVE_TIMER                \
+  "mqtt_keep_alive_timer"                         ///< String for MQTT keep-alive timer
+
 /**
  * @brief  The content type of the Tele-metry message published in this example.
  * @remark Message properties must be url-encoded.
@@ -70,6 +97,9 @@ extern "C" {
 typedef struct {
   int32_t mqtt_buffer_len;                    ///< MQTT buffer length
   uint8_t mqtt_buffer[MAX_JSON_MESSAGE_SIZE]; ///< MQTT JSON message buffer
+  uint32_t enqueue_tick;                      ///< Tick count when queued on a publish lane
+  uint32_t sample_tick;                       ///< Tick count of the sensor reading, 0 for other messages
+  uint8_t source;                             ///< sl_publish_lane_source_e producer of the message
 } sl_wifi_asset_tracking_mqtt_package_queue_data_t;
 
 /// @brief Structure to store network context
@@ -104,11 +134,11 @@ sl_status_t sl_start_azure_cloud_connection();
 sl_status_t sl_connect_azure_iot_hub();
 
 /**************************************************************************/ /**
- * @brief Function will retry for Azure cloud connection with configured
- * authentication method for five times at every five seconds.
+ * @brief Function will make one attempt of Azure cloud connection with
+ * configured authentication method, the recovery task spaces the attempts.
  * @return The following values are returned:
  * -  \ref SL_STATUS_OK on success
- * -  \ref SL_STATUS_FAIL - on sensor disable failed
+ * -  \ref SL_STATUS_FAIL - on connection failed or wi-fi lost
  ******************************************************************************/
 sl_status_t sl_retry_azure_cloud_connection();
 
@@ -193,6 +223,12 @@ sl_status_t sl_create_telemetry_message_properties();
  ******************************************************************************/
 sl_status_t sl_disconnect_azure_iot_hub();
 
+/**************************************************************************/ /**
+ * @brief Callback function of MQTT keep-alive timer, wakes the cloud task
+ * to process the MQTT connection.
+ ******************************************************************************/
+void on_mqtt_keep_alive_timer_callback();
+
 #ifdef __cplusplus
 }
 #endif
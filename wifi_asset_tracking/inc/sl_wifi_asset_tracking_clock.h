@@ -0,0 +1,114 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_clock.h
+ * @brief Network time discipline of calendar RTC
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_CLOCK_H_
+#define SL_WIFI_ASSET_TRACKING_CLOCK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+#include <sl_si91x_calendar.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define CLOCK_CHECK_INTERVAL                 60000  ///< In ms, clock task checks whether a sync is due at this interval
+#define CLOCK_SYNC_INTERVAL_MIN              900    ///< In seconds, sync interval while the clock is unstable
+#define CLOCK_SYNC_INTERVAL_MAX              86400  ///< In seconds, sync interval limit of a stable clock
+#define CLOCK_STABLE_OFFSET                  20     ///< In ms, sync interval doubles while offsets stay within this
+#define CLOCK_STEP_THRESHOLD                 1000   ///< In ms, larger offsets are stepped instead of slewed
+#define CLOCK_SLEW_RATE                      500    ///< In ppm, rate at which an offset is absorbed
+#define CLOCK_DRIFT_MIN_SPAN                 60000  ///< In ms, shortest span between syncs for a drift sample
+#define CLOCK_DRIFT_FILTER_SHIFT             2      ///< Weight 1/4 of newest sample in drift estimate
+#define CLOCK_DRIFT_ERROR_INITIAL            200000 ///< In ppb, assumed drift error of the RC clock before first estimate
+#define CLOCK_YEAR_PER_CENTURY_DIGIT         1000   ///< Calendar century holds first digit of year, as set from SNTP
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for time quality reported with telemetry
+typedef struct {
+  bool is_synced;               ///< Clock follows network time
+  int32_t offset_ms;            ///< Network time minus local time at last sync
+  uint32_t uncertainty_ms;      ///< Bound of current local time error
+  int32_t drift_ppb;            ///< Estimated RTC rate error, positive when RTC is slow
+  uint32_t sync_interval;       ///< In seconds, wait until next sync
+  uint32_t sync_count;          ///< Successful syncs since boot
+} sl_clock_quality_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Task function which takes SNTP samples on schedule while Wi-Fi is
+ * connected. The wait doubles while the clock stays within
+ * CLOCK_STABLE_OFFSET and halves when it does not.
+ ******************************************************************************/
+void sl_clock_task();
+
+/**************************************************************************/ /**
+ * @brief Function to start discipline from a calendar just set from SNTP.
+ * Call with clock mutex held.
+ * @param[in] exchange_ms : duration of the SNTP exchange used to set it.
+ ******************************************************************************/
+void sl_clock_on_rtc_set(uint32_t exchange_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to check whether the clock follows network time.
+ * @return true after first successful SNTP sample.
+ ******************************************************************************/
+bool sl_clock_is_synced(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get corrected time, calendar RTC with drift and slew
+ * applied.
+ * @param[out] unix_ms : milliseconds since 1970-01-01T00:00:00Z.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when calendar RTC read failed
+ ******************************************************************************/
+sl_status_t sl_clock_get_time(uint64_t *unix_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to get corrected time in calendar format.
+ * @param[out] datetime : corrected date and time.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when calendar RTC read failed
+ ******************************************************************************/
+sl_status_t sl_clock_get_datetime(sl_calendar_datetime_config_t *datetime);
+
+/**************************************************************************/ /**
+ * @brief Function to read time quality.
+ * @param[out] quality : offset, uncertainty and drift of the clock.
+ ******************************************************************************/
+void sl_clock_get_quality(sl_clock_quality_t *quality);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_CLOCK_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,95 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_compress.h
+ * @brief LZ77 telemetry compressor primed with the JSON schema
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_COMPRESS_H_
+#define SL_WIFI_ASSET_TRACKING_COMPRESS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// This header is shared with the host tools, keep it free of SDK includes
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define COMPRESS_CONTENT_ENCODING      "sl-lz77"  ///< Content-Encoding of compressed telemetry
+#define COMPRESS_MAGIC                 0xF5       ///< First byte of compressed body, never valid at start of JSON
+#define COMPRESS_FORMAT_VERSION        0x01       ///< Format and dictionary version, second byte of body
+#define COMPRESS_HEADER_SIZE           2          ///< Magic and version
+#define COMPRESS_MIN_MATCH             3          ///< Shortest back reference
+#define COMPRESS_MAX_MATCH             18         ///< Longest back reference, 4 bit length
+#define COMPRESS_OFFSET_BITS           12         ///< Back reference distance bits
+#define COMPRESS_WINDOW_SIZE           (1 << COMPRESS_OFFSET_BITS) ///< Farthest back reference, dictionary included
+#define COMPRESS_MAX_INPUT_SIZE        512        ///< Largest message compressed in one call
+#define COMPRESS_HASH_BITS             9          ///< Hash table of 2 ^ bits match heads
+#define COMPRESS_MAX_CHAIN             16         ///< Candidates compared per position
+
+/// Worst case size of a compressed message of n bytes
+#define COMPRESS_BOUND(n)              (COMPRESS_HEADER_SIZE + (n) + (((n) + 7) / 8))
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to compress one JSON message. The schema dictionary is
+ * part of the window, so even the first occurrence of a key is a back
+ * reference. Not reentrant, the match tables are static.
+ * @param[in] input : message.
+ * @param[in] input_len : message length, at most COMPRESS_MAX_INPUT_SIZE.
+ * @param[out] output : compressed message.
+ * @param[in] output_size : size of output buffer.
+ * @param[out] output_len : compressed length.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the message is too large or does not get
+ *    smaller, send it uncompressed
+ ******************************************************************************/
+sl_status_t sl_compress_message(const uint8_t *input,
+                                uint32_t input_len,
+                                uint8_t *output,
+                                uint32_t output_size,
+                                uint32_t *output_len);
+
+/**************************************************************************/ /**
+ * @brief Function to restore a message compressed by sl_compress_message.
+ * @param[in] input : compressed message.
+ * @param[in] input_len : compressed length.
+ * @param[out] output : restored message.
+ * @param[in] output_size : size of output buffer.
+ * @param[out] output_len : restored length.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on corrupted input or too small output buffer
+ ******************************************************************************/
+sl_status_t sl_decompress_message(const uint8_t *input,
+                                  uint32_t input_len,
+                                  uint8_t *output,
+                                  uint32_t output_size,
+                                  uint32_t *output_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_COMPRESS_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
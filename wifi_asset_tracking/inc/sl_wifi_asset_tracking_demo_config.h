@@ -22,6 +22,7 @@
 extern "C" {
 #endif
 
+#include <FreeRTOS.h>
 #include <sl_wifi_asset_tracking_sensor.h>
 #include <sl_wifi_asset_tracking_wifi_handler.h>
 
@@ -140,6 +141,115 @@ extern "C" {
  */
 #define DEMO_CONFIG_DEBUG_LOGS                                        1
 
+/**
+ * @brief Enable to compress tele-metry messages before publishing.
+ * Messages are sent with Content-Encoding "sl-lz77" and decompressed by the
+ * dashboard backend.
+ * Default : 0
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_TELEMETRY_COMPRESSION                             0
+
+/**
+ * @brief Enable to scan neighbouring access points when GNSS receiver has no
+ * fix. Strongest access points are sent as "wifiscan" message for the
+ * backend to resolve a position.
+ * Default : 1
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_WIFI_POSITIONING                                  1
+
+/**
+ * @brief Enable to keep the Wi-Fi radio in associated power save between
+ * publish bursts. Queued messages are published together on a cadence of
+ * the listen interval, within the latency cap of their lane.
+ * Default : 1
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_POWER_SAVE                                        1
+
+/**
+ * @brief Low power mode follows FreeRTOS tickless idle, set by
+ * configUSE_TICKLESS_IDLE in the project configuration (.slcp), so one switch
+ * both stops the tick while all tasks are blocked and lets the capture tasks
+ * share wake-ups whose deadlines are within WAKE_PLANNER_TOLERANCE. Set
+ * configUSE_TICKLESS_IDLE to 0 in the .slcp to keep the tick and wake every
+ * capture task on its own deadline.
+ * Default : 1, from configUSE_TICKLESS_IDLE
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#if defined(configUSE_TICKLESS_IDLE) && (0 != configUSE_TICKLESS_IDLE)
+#define DEMO_CONFIG_LOW_POWER_MODE                                    1
+#else
+#define DEMO_CONFIG_LOW_POWER_MODE                                    0
+#endif /// < configUSE_TICKLESS_IDLE
+
+/**
+ * @brief Enable to send a snapshot of the runtime metrics as "diag" messages
+ * every METRICS_REPORT_INTERVAL. Metrics are collected either way and are
+ * printed on the console with debug logs.
+ * Default : 1
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_DIAGNOSTICS                                       1
+
+/**
+ * @brief Enable to print deferred log records as compact "#L" hex lines
+ * instead of text. Expand them on the host with sl_host_log_decoder.
+ * Default : 0
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_LOG_BINARY_OUTPUT                                 0
+
+/**
+ * @brief Enable to print every time-stamped sensor reading as a compact "#S"
+ * hex line on the console. Replay a capture through the host pipeline with
+ * sl_host_pipeline_sim -R.
+ * Default : 0
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_SENSOR_TRACE_OUTPUT                               0
+
+/**
+ * @brief Enable to place stacks, control blocks and queue storage of the
+ * application in static RAM instead of the FreeRTOS heap. Needs
+ * configSUPPORT_STATIC_ALLOCATION.
+ * Default : 1
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_STATIC_ALLOCATION                                 1
+
+/**
+ * @brief Enable to profile task stacks. Stack high-water marks are sampled
+ * with the metrics snapshot and before a sensor task is deleted, the peaks
+ * are kept in NVM3 across reboots, and every snapshot prints the recommended
+ * stack size of each task. All modules log at trace level to exercise the
+ * deepest paths. Turn the console capture into
+ * sl_wifi_asset_tracking_stack_config.h with sl_host_stack_config.
+ * Default : 0
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_STACK_PROFILE                                     0
+
+/**
+ * @brief Enable to run the hardware watchdog. The task supervisor feeds it
+ * only while every task met its check-in deadline. Disable when debugging
+ * with breakpoints, a halted core is not fed either.
+ * Default : 1
+ *
+ * @note Optional argument for wi-fi asset tracking application
+ */
+#define DEMO_CONFIG_WATCHDOG                                          1
+
 /**
  * @brief Configure guaranteed number of samples for sensors and wi-fi as per configuration.
  * 0 : Disable guaranteed number of samples for sensors and wi-fi as per configuration.
@@ -0,0 +1,87 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_device_identity.h
+ * @brief Cached device identity fields for JSON messages
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_DEVICE_IDENTITY_H_
+#define SL_WIFI_ASSET_TRACKING_DEVICE_IDENTITY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define DEVICE_IDENTITY_MAC_BUFF_SIZE        18     ///< MAC address string "XX:XX:XX:XX:XX:XX" with terminator
+#define DEVICE_IDENTITY_SSID_BUFF_SIZE       33     ///< Longest SSID with terminator
+#define DEVICE_IDENTITY_FIRMWARE_BUFF_SIZE   40     ///< Network processor firmware version string with terminator
+#define DEVICE_IDENTITY_REFRESH_ATTEMPTS     3      ///< Reads of the identity after a connection before giving up
+#define DEVICE_IDENTITY_REFRESH_RETRY_DELAY  100    ///< In ms, wait between two reads of the identity
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for identity strings, preformatted to append to messages
+typedef struct {
+  char mac[DEVICE_IDENTITY_MAC_BUFF_SIZE];                    ///< Wi-Fi client MAC address
+  uint32_t mac_len;                                           ///< Length of mac without terminator
+  char ssid[DEVICE_IDENTITY_SSID_BUFF_SIZE];                  ///< SSID of the connected access point
+  uint32_t ssid_len;                                          ///< Length of ssid without terminator
+  char firmware_version[DEVICE_IDENTITY_FIRMWARE_BUFF_SIZE];  ///< Network processor firmware version
+  uint32_t firmware_version_len;                              ///< Length of firmware_version without terminator
+} sl_device_identity_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to fill the identity cache after Wi-Fi is connected. MAC
+ * address and firmware version are fetched on first call only, SSID on every
+ * connection.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when MAC address or firmware version read failed
+ ******************************************************************************/
+sl_status_t sl_device_identity_refresh(void);
+
+/**************************************************************************/ /**
+ * @brief Function to mark the identity cache stale when the connection is
+ * lost, until next sl_device_identity_refresh.
+ ******************************************************************************/
+void sl_device_identity_invalidate(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get the identity cache. Strings are kept in place and
+ * only the SSID is written again on reconnection, serializers append them
+ * without copy.
+ * @return identity cache, NULL when stale.
+ ******************************************************************************/
+const sl_device_identity_t *sl_device_identity_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_DEVICE_IDENTITY_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
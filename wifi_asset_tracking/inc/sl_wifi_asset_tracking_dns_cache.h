@@ -0,0 +1,111 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_dns_cache.h
+ * @brief Host name resolution cache shared by cloud, SNTP and HTTP clients
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_DNS_CACHE_H_
+#define SL_WIFI_ASSET_TRACKING_DNS_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <sl_status.h>
+#include <sl_ip_types.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define DNS_CACHE_MAX_ENTRIES                4        ///< Number of host names that can be cached
+#define DNS_CACHE_MAX_HOST_NAME_LENGTH       96       ///< Maximum host name length including null terminator
+#define DNS_CACHE_DEFAULT_TTL                300000   ///< In ms, lifetime of a resolution before it is revalidated
+#define DNS_CACHE_REVALIDATE_TIMEOUT         3000     ///< In ms, DNS timeout used while a stale entry is available
+#define DNS_CACHE_NVM3_KEY                   0x1000   ///< NVM3 object key used to persist the cache
+#define DNS_CACHE_NVM3_MAGIC                 0x444E5301 ///< Marker and layout version of persisted cache
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one cached host name resolution
+typedef struct {
+  bool is_valid;                                    ///< Entry holds a resolution
+  bool is_stale;                                    ///< Entry was restored from flash or its address failed, revalidate before use
+  char host_name[DNS_CACHE_MAX_HOST_NAME_LENGTH];   ///< Resolved host name
+  sl_ip_address_t address;                          ///< Last known address of host name
+  uint32_t resolved_tick;                           ///< Tick count at last successful resolution
+  uint32_t ttl;                                     ///< In ms, lifetime of the resolution
+} sl_dns_cache_entry_t;
+
+/// @brief Structure for cache entries persisted in NVM3
+typedef struct {
+  uint32_t magic;                                   ///< DNS_CACHE_NVM3_MAGIC
+  struct {
+    char host_name[DNS_CACHE_MAX_HOST_NAME_LENGTH]; ///< Resolved host name, empty when unused
+    uint8_t ipv4[4];                                ///< Last known IPv4 address
+    uint32_t ttl;                                   ///< In ms, lifetime of the resolution
+  } entry[DNS_CACHE_MAX_ENTRIES];                   ///< Persisted entries
+} sl_dns_cache_nvm3_record_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to initialize DNS cache and restore resolutions persisted
+ * by previous boot. Restored entries are treated as stale.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on cache initialization failure
+ ******************************************************************************/
+sl_status_t sl_dns_cache_init(void);
+
+/**************************************************************************/ /**
+ * @brief Function to resolve a host name through the DNS cache.
+ * A fresh entry is returned without any network access. A stale entry is
+ * revalidated with a single short DNS request and served as-is when the
+ * resolver is unreachable (stale-while-revalidate). Without any entry the
+ * resolver is queried up to max_attempts times.
+ * @param[in] host_name : null terminated host name to resolve.
+ * @param[in] timeout : In ms, DNS timeout per request when nothing is cached.
+ * @param[in] max_attempts : Number of DNS requests when nothing is cached.
+ * @param[out] address : resolved IPv4 address.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on resolution failure with no usable entry
+ ******************************************************************************/
+sl_status_t sl_dns_cache_resolve_hostname(const char *host_name,
+                                          uint32_t timeout,
+                                          uint8_t max_attempts,
+                                          sl_ip_address_t *address);
+
+/**************************************************************************/ /**
+ * @brief Function to mark cached resolution of a host name stale, e.g. when a
+ * connection to the cached address failed. Next resolution revalidates it
+ * and still falls back to the cached address when the resolver is
+ * unreachable. The cache is only changed in RAM.
+ * @param[in] host_name : null terminated host name.
+ ******************************************************************************/
+void sl_dns_cache_invalidate(const char *host_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_DNS_CACHE_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
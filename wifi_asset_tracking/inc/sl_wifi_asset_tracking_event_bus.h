@@ -0,0 +1,109 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_event_bus.h
+ * @brief Publish/subscribe of connectivity and sensor state changes
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_EVENT_BUS_H_
+#define SL_WIFI_ASSET_TRACKING_EVENT_BUS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+#include <FreeRTOS.h>
+#include <sl_wifi_asset_tracking_static_alloc.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define EVENT_BUS_MAX_SUBSCRIBERS            8      ///< Entries of the subscriber table
+#define EVENT_BUS_NOTIFY_INDEX               1      ///< Task notification index of event bits, index 0 stays with the data path wake-ups
+#define SL_EVENT_BIT(event)                  (1UL << (event)) ///< Bit of an event in a subscription or wait result
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for events, published when a status changes
+typedef enum {
+  SL_EVENT_WIFI_UP = 0,         ///< Wi-Fi connected
+  SL_EVENT_WIFI_DOWN,           ///< Wi-Fi connection lost
+  SL_EVENT_WIFI_SHUTDOWN,       ///< Wi-Fi connection failed after retries
+  SL_EVENT_CLOUD_UP,            ///< IoT Hub connected
+  SL_EVENT_CLOUD_DOWN,          ///< IoT Hub connection lost
+  SL_EVENT_CLOUD_SHUTDOWN,      ///< IoT Hub connection failed after retries
+  SL_EVENT_SENSOR_UP,           ///< A sensor was probed and works
+  SL_EVENT_SENSOR_LOST,         ///< A sensor failed probing or stopped responding
+  SL_EVENT_COUNT,               ///< Number of events
+} sl_event_e;
+
+/// @brief Enum for delivery of an event to a subscriber
+typedef enum {
+  SL_EVENT_DELIVERY_BITS = 0,   ///< Event bit is set at EVENT_BUS_NOTIFY_INDEX, read with sl_event_bus_wait
+  SL_EVENT_DELIVERY_WAKE,       ///< Notification at index 0 is given, for tasks which re-read the status after every wake-up
+} sl_event_delivery_e;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to clear the subscriber table, call before the tasks run.
+ ******************************************************************************/
+void sl_event_bus_init(void);
+
+/**************************************************************************/ /**
+ * @brief Function to subscribe a task to events. Subscriptions are kept by
+ * task, so a recreated task keeps them and a deleted task is skipped.
+ * Subscribing again adds events to the existing entry.
+ * @param[in] task : subscribing task.
+ * @param[in] events : SL_EVENT_BIT of every event.
+ * @param[in] delivery : how events reach the task.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FULL - when EVENT_BUS_MAX_SUBSCRIBERS tasks subscribed
+ ******************************************************************************/
+sl_status_t sl_event_bus_subscribe(sl_static_task_e task,
+                                   uint32_t events,
+                                   sl_event_delivery_e delivery);
+
+/**************************************************************************/ /**
+ * @brief Function to deliver an event to every subscribed task. Nothing is
+ * allocated or copied, events published before a subscriber waits are kept
+ * in its notification value.
+ * @param[in] event : published event.
+ ******************************************************************************/
+void sl_event_bus_publish(sl_event_e event);
+
+/**************************************************************************/ /**
+ * @brief Function to wait for events of a task subscribed with
+ * SL_EVENT_DELIVERY_BITS.
+ * @param[in] timeout : ticks to wait, portMAX_DELAY without limit.
+ * @return SL_EVENT_BIT of every event published since the last wait, 0 on
+ * timeout.
+ ******************************************************************************/
+uint32_t sl_event_bus_wait(TickType_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_EVENT_BUS_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -23,6 +23,8 @@ extern "C" {
 #endif
 
 #include <sl_wifi_asset_tracking_azure_handler.h>
+#include <sl_wifi_asset_tracking_link_monitor.h>
+#include <sl_wifi_asset_tracking_metrics.h>
 
 /*******************************************************************************
  ***************************  Defines / Macros  ********************************
@@ -67,6 +69,28 @@ extern "C" {
   "keep-alive"                                                                                      ///< String for keep alive message type
 #define JSON_PROPERTY_WIFI \
   "wifi"                                                                                            ///< String for Wi-Fi message type
+#define JSON_PROPERTY_WIFI_SCAN \
+  "wifiscan"                                                                                        ///< String for Wi-Fi scan message type
+#define JSON_PROPERTY_LINK \
+  "link"                                                                                            ///< String for Wi-Fi link event message type
+#define JSON_PROPERTY_STATE \
+  "state"                                                                                           ///< String for link state
+#define JSON_PROPERTY_LINK_UP \
+  "up"                                                                                              ///< String for link state up
+#define JSON_PROPERTY_LINK_DOWN \
+  "down"                                                                                            ///< String for link state down
+#define JSON_PROPERTY_DOWNTIME \
+  "downtime"                                                                                        ///< String for duration of last link loss
+#define JSON_PROPERTY_LOSSES \
+  "losses"                                                                                          ///< String for link losses since boot
+#define JSON_PROPERTY_CLOCK \
+  "clock"                                                                                           ///< String for time quality object
+#define JSON_PROPERTY_OFFSET \
+  "offset"                                                                                          ///< String for clock offset at last sync
+#define JSON_PROPERTY_UNCERTAINTY \
+  "uncertainty"                                                                                     ///< String for clock uncertainty
+#define JSON_PROPERTY_DRIFT \
+  "drift"                                                                                           ///< String for estimated RTC drift in ppm
 #define JSON_PROPERTY_MACID \
   "macid"                                                                                           ///< String for mac ID value
 #define JSON_PROPERTY_SSID \
@@ -77,6 +101,16 @@ extern "C" {
   "session"                                                                                         ///< String for session value
 #define JSON_PROPERTY_NEW_SESSION_TYPE \
   "new"                                                                                             ///< String for new session type
+#define JSON_PROPERTY_FIRMWARE \
+  "firmware"                                                                                        ///< String for network processor firmware version
+#define JSON_PROPERTY_DIAGNOSTICS \
+  "diag"                                                                                            ///< String for diagnostics message type
+#define JSON_PROPERTY_VERSION \
+  "version"                                                                                         ///< String for diagnostics schema version
+#define JSON_PROPERTY_FIRST \
+  "first"                                                                                           ///< String for index of first value in diagnostics message
+#define JSON_PROPERTY_VALUES \
+  "values"                                                                                          ///< String for diagnostics values
 #define JSON_PROPERTY_KEEP_ALIVE_VALUE \
   "yes"                                                                                             ///< String for keep alive message value
 #define JSON_PROPERTY_INTERVAL \
@@ -84,7 +118,7 @@ extern "C" {
 #define JSON_DOUBLE_FRACTION_MAX_SIZE                                        7                      ///< Maximum size for double fraction
 #define JSON_MAX_TIMESTAMP_BUFF_SIZE                                         35                     ///< Maximum timestamp buffer size
 #define JSON_MAX_TIMESTAMP_STRING_SIZE                                       25                     ///< Maximum size for timestamp string
-#define JSON_MAX_MAC_ADDR_BUFF_SIZE                                          18                     ///< Maximum MAC address buffer size
+#define JSON_CLOCK_DRIFT_FRACTION_SIZE                                       3                      ///< Fraction digits of drift in ppm
 
 /*******************************************************************************
  **************************   ENUMS and Structures   ***************************
@@ -148,12 +182,21 @@ sl_status_t sl_json_send_new_session_message();
 
 /**************************************************************************/ /**
  * @brief Function to send keep alive JSON message to MQTT package queue.
+ * Liveness is carried by MQTT PINGREQ, so the message is a heartbeat sent
+ * only when the sampling intervals changed, after sl_json_reset_heartbeat,
+ * or once HEARTBEAT_MAX_INTERVAL passed since the last one.
  * @return  The following values are returned:
- * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_OK on success, also when nothing had to be sent
  * -  \ref SL_STATUS_FAIL - on keep alive message sending failure.
  ******************************************************************************/
 sl_status_t sl_json_send_keep_alive_message();
 
+/**************************************************************************/ /**
+ * @brief Function to send the full heartbeat with the next keep alive check,
+ * used after every new MQTT connection.
+ ******************************************************************************/
+void sl_json_reset_heartbeat();
+
 /**************************************************************************/ /**
  * @brief Function to send wi-fi JSON message to MQTT package queue.
  * @return  The following values are returned:
@@ -162,6 +205,38 @@ sl_status_t sl_json_send_keep_alive_message();
  ******************************************************************************/
 sl_status_t sl_json_send_wifi_message();
 
+/**************************************************************************/ /**
+ * @brief Function to scan neighbouring access points and send them as Wi-Fi
+ * scan JSON message to MQTT package queue, used for positioning when GNSS
+ * has no fix.
+ * @return  The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on scan or message sending failure.
+ ******************************************************************************/
+sl_status_t sl_json_send_wifi_scan_message();
+
+/**************************************************************************/ /**
+ * @brief Function to send Wi-Fi link state change as link JSON message to
+ * MQTT package queue. RSSI is the mean of the monitor window.
+ * @param[in] stats : link statistics at the state change.
+ * @return  The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on message sending failure.
+ ******************************************************************************/
+sl_status_t sl_json_send_link_message(const sl_link_monitor_stats_t *stats);
+
+/**************************************************************************/ /**
+ * @brief Function to send a metrics snapshot as diagnostics JSON messages to
+ * MQTT package queue. Values are sent by position, METRICS_VALUES_PER_MESSAGE
+ * per message, in the order of the metric enums of METRICS_SCHEMA_VERSION.
+ * @param[in] snapshot : metrics snapshot.
+ * @return  The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when a message could not be sent.
+ ******************************************************************************/
+sl_status_t sl_json_send_diagnostics_message(
+  const sl_metrics_snapshot_t *snapshot);
+
 /**************************************************************************/ /**
  * @brief Function to get time-stamp for JSON message.
  * @param[out] timestamp_buff : time-stamp will be filled in this buffer.
@@ -27,6 +27,7 @@ extern "C" {
  ******************************************************************************/
 #define MAX_LCD_SUBSTRING_LENGTH           20    ///< Max length that can be print on one line of LCD
 #define MAX_LCD_LINES                      12    ///< Maximum no. of lines that can be print on LCD without losing data
+#define MAX_LCD_MESSAGE_LINES              4     ///< Maximum no. of lines of one message, MAX_LCD_STRING_SIZE / MAX_LCD_SUBSTRING_LENGTH
 
 /*******************************************************************************
  **************************   ENUMS and Structures   ***************************
@@ -36,12 +37,23 @@ extern "C" {
 // Prototypes
 
 /**************************************************************************/ /**
- * @brief send string message to LCD queue
+ * @brief send message index to LCD queue, the LCD task draws the string
+ * word-wrapped from a layout built at start-up
  * @param[in] lcd_msg_index : Index number of string message to be print as per
  * sl_wifi_asset_tracking_lcd_strings array.
  *****************************************************************************/
 void sl_wifi_asset_tracking_lcd_print(uint8_t lcd_msg_index);
 
+/**************************************************************************/ /**
+ * @brief send message index and a value to LCD queue, the value is drawn in
+ * brackets behind the string
+ * @param[in] lcd_msg_index : Index number of string message to be print as per
+ * sl_wifi_asset_tracking_lcd_strings array.
+ * @param[in] value : Value drawn behind the string, e.g. an attempt number.
+ *****************************************************************************/
+void sl_wifi_asset_tracking_lcd_print_value(uint8_t lcd_msg_index,
+                                            int32_t value);
+
 /***************************************************************************/ /**
  * Create LCD task for wi-fi asset tracking example
  ******************************************************************************/
@@ -0,0 +1,113 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_link_monitor.h
+ * @brief Wi-Fi link health monitor
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_LINK_MONITOR_H_
+#define SL_WIFI_ASSET_TRACKING_LINK_MONITOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define LINK_MONITOR_SAMPLE_INTERVAL         10000  ///< In ms, RSSI is sampled at this interval while connected
+#define LINK_MONITOR_WINDOW_SIZE             12     ///< RSSI samples kept for link quality trend
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for Wi-Fi link state seen by the monitor
+typedef enum {
+  SL_LINK_STATE_DOWN = 0x00,  ///< Not joined, or join lost
+  SL_LINK_STATE_UP   = 0x01   ///< Joined and answering RSSI queries
+} sl_link_state_e;
+
+/// @brief Structure for link quality over the RSSI window
+typedef struct {
+  uint8_t state;            ///< sl_link_state_e
+  uint8_t sample_count;     ///< Valid samples in window
+  int32_t last_rssi;        ///< In dBm, latest sample
+  int32_t average_rssi;     ///< In dBm, mean of window
+  int32_t min_rssi;         ///< In dBm, weakest sample of window
+  int32_t max_rssi;         ///< In dBm, strongest sample of window
+  uint32_t down_count;      ///< Link losses since boot
+  uint32_t last_down_ms;    ///< Duration of last link loss
+} sl_link_monitor_stats_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to subscribe to join events of the network processor. Call
+ * once after Wi-Fi initialization.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when callback registration failed
+ ******************************************************************************/
+sl_status_t sl_link_monitor_init(void);
+
+/**************************************************************************/ /**
+ * @brief Task function which samples RSSI while Wi-Fi is connected, starts
+ * Wi-Fi recovery when the link is lost and publishes link state changes.
+ * Join failure events wake it before the next sample.
+ ******************************************************************************/
+void sl_link_monitor_task();
+
+/**************************************************************************/ /**
+ * @brief Function to mark the link up after a successful join. Takes the
+ * first RSSI sample of the new connection.
+ ******************************************************************************/
+void sl_link_monitor_on_connected(void);
+
+/**************************************************************************/ /**
+ * @brief Function to check the cached link state, without network processor
+ * command.
+ * @return true when the link is up.
+ ******************************************************************************/
+bool sl_link_monitor_is_up(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get the latest RSSI sample, without network processor
+ * command.
+ * @param[out] rssi : in dBm.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the link is down
+ ******************************************************************************/
+sl_status_t sl_link_monitor_get_rssi(int32_t *rssi);
+
+/**************************************************************************/ /**
+ * @brief Function to read link quality over the RSSI window.
+ * @param[out] stats : copy of link statistics.
+ ******************************************************************************/
+void sl_link_monitor_get_stats(sl_link_monitor_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_LINK_MONITOR_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
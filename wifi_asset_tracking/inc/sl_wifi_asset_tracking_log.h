@@ -0,0 +1,138 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_log.h
+ * @brief Deferred logging of hot path log sites
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_LOG_H_
+#define SL_WIFI_ASSET_TRACKING_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+#include <sl_wifi_asset_tracking_log_format.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define LOG_RING_SIZE                        32     ///< Records waiting for the log task, power of 2
+
+/// Record a log site when its module logs at level. Arguments are cast to
+/// 32 bits and must not be pointers, the record is formatted later.
+#define SL_LOG(module, level, format_id, ...)                          \
+  do {                                                                 \
+    if (sl_log_is_enabled((module), (level))) {                        \
+      sl_log_write((module), (level), (format_id),                     \
+                   SL_LOG_ARG_COUNT(__VA_ARGS__),                      \
+                   SL_LOG_ARGS(__VA_ARGS__));                          \
+    }                                                                  \
+  } while (0)
+
+#define SL_LOG_ERROR(module, format_id, ...) \
+  SL_LOG((module), SL_LOG_LEVEL_ERROR, (format_id), ## __VA_ARGS__)  ///< Record an error
+#define SL_LOG_WARN(module, format_id, ...) \
+  SL_LOG((module), SL_LOG_LEVEL_WARN, (format_id), ## __VA_ARGS__)   ///< Record a warning
+#define SL_LOG_INFO(module, format_id, ...) \
+  SL_LOG((module), SL_LOG_LEVEL_INFO, (format_id), ## __VA_ARGS__)   ///< Record a state change
+#define SL_LOG_DEBUG(module, format_id, ...) \
+  SL_LOG((module), SL_LOG_LEVEL_DEBUG, (format_id), ## __VA_ARGS__)  ///< Record a per sample or per message event
+
+/// Argument count and the arguments padded to LOG_MAX_ARGS words
+#define SL_LOG_ARG_COUNT(...) \
+  SL_LOG_ARG_COUNT_(0, ## __VA_ARGS__, 4, 3, 2, 1, 0)
+#define SL_LOG_ARG_COUNT_(zero, a0, a1, a2, a3, count, ...) (count)
+#define SL_LOG_ARGS(...) \
+  SL_LOG_ARGS_(0, ## __VA_ARGS__, 0, 0, 0, 0, 0)
+#define SL_LOG_ARGS_(zero, a0, a1, a2, a3, ...) \
+  (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3)
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to reset the ring and the module levels, call before the
+ * application tasks are created.
+ ******************************************************************************/
+void sl_log_init(void);
+
+/**************************************************************************/ /**
+ * @brief Task function which formats and prints queued records at the
+ * lowest priority, in text or, with DEMO_CONFIG_LOG_BINARY_OUTPUT, as
+ * LOG_FRAME_MARKER lines for the host log decoder.
+ ******************************************************************************/
+void sl_log_task();
+
+/**************************************************************************/ /**
+ * @brief Function to check whether a module logs at a level.
+ * @param[in] module : log module.
+ * @param[in] level : level of the log site.
+ * @return true when the record would be kept.
+ ******************************************************************************/
+bool sl_log_is_enabled(sl_log_module_e module, sl_log_level_e level);
+
+/**************************************************************************/ /**
+ * @brief Function to record a log site without blocking, use SL_LOG. Safe
+ * from any task, not from interrupts. A record is dropped and counted when
+ * the ring is full.
+ * @param[in] module : log module.
+ * @param[in] level : level of the log site.
+ * @param[in] format_id : entry of SL_LOG_FORMAT_LIST.
+ * @param[in] arg_count : valid arguments.
+ * @param[in] arg0 - arg3 : raw arguments.
+ ******************************************************************************/
+void sl_log_write(sl_log_module_e module,
+                  sl_log_level_e level,
+                  sl_log_format_id_e format_id,
+                  uint8_t arg_count,
+                  uint32_t arg0,
+                  uint32_t arg1,
+                  uint32_t arg2,
+                  uint32_t arg3);
+
+/**************************************************************************/ /**
+ * @brief Function to change the level of a module at runtime.
+ * @param[in] module : log module, SL_LOG_MODULE_COUNT for all modules.
+ * @param[in] level : records above this level are not kept.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on an unknown module or level
+ ******************************************************************************/
+sl_status_t sl_log_set_level(sl_log_module_e module, sl_log_level_e level);
+
+/**************************************************************************/ /**
+ * @brief Function to get the level of a module.
+ * @param[in] module : log module.
+ * @return level, SL_LOG_LEVEL_NONE for an unknown module.
+ ******************************************************************************/
+sl_log_level_e sl_log_get_level(sl_log_module_e module);
+
+/**************************************************************************/ /**
+ * @brief Function to get the records dropped on a full ring since boot.
+ * @return dropped records.
+ ******************************************************************************/
+uint32_t sl_log_get_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_LOG_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
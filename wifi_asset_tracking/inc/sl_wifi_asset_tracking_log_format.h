@@ -0,0 +1,258 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_log_format.h
+ * @brief Format table and record encoding of the deferred logger
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_LOG_FORMAT_H_
+#define SL_WIFI_ASSET_TRACKING_LOG_FORMAT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// This header is shared with the host tools, keep it free of SDK includes
+#include <stddef.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define LOG_MAX_ARGS                         4      ///< 32-bit arguments per record
+#define LOG_RECORD_HEADER_SIZE               8      ///< Time, format ID, module, level and argument count
+#define LOG_RECORD_MAX_SIZE                  (LOG_RECORD_HEADER_SIZE + (4 * LOG_MAX_ARGS)) ///< Encoded record with all arguments
+#define LOG_FRAME_MARKER                     "#L"   ///< Start of a binary record line on the console
+#define LOG_FRAME_MAX_SIZE                   (sizeof(LOG_FRAME_MARKER) + (2 * LOG_RECORD_MAX_SIZE)) ///< Terminated hex line of a record
+#define LOG_TEXT_BUFF_SIZE                   160    ///< Formatted record text
+
+/// Format ID and format of every deferred log site. Arguments are stored as
+/// 32-bit words, so only integer conversions (d, i, u, x, X, c) are allowed.
+/// Append new entries at the end, IDs of a released firmware must not move.
+#define SL_LOG_FORMAT_LIST(X) \
+  X(SL_LOG_FMT_LOG_DROPPED, \
+    "sl_log_task : %lu log records dropped") \
+  X(SL_LOG_FMT_CLOUD_WAIT_EMPTY, \
+    "azure_communication_task : publish lanes are empty, waiting for a message") \
+  X(SL_LOG_FMT_CLOUD_RESUME_WIFI_RECOVERY, \
+    "azure_communication_task : Resuming recovery task for Wi-Fi recovery") \
+  X(SL_LOG_FMT_CLOUD_RATE_LIMITED, \
+    "azure_communication_task : publish rate limited, waiting %lu ms") \
+  X(SL_LOG_FMT_CLOUD_LANE_RECEIVED, \
+    "azure_communication_task : Data is received from publish lane %d, %lu bytes") \
+  X(SL_LOG_FMT_CLOUD_COMPRESSED, \
+    "azure_communication_task : JSON compressed from %lu to %lu bytes") \
+  X(SL_LOG_FMT_CLOUD_THROTTLED, \
+    "azure_communication_task : MQTT Publish throttled, message is retried") \
+  X(SL_LOG_FMT_CLOUD_PUBLISH_FAILED, \
+    "azure_communication_task : MQTT Publish sent failed") \
+  X(SL_LOG_FMT_CLOUD_RESUME_AZURE_RECOVERY, \
+    "azure_communication_task : Resuming recovery task for Azure IoT Hub recovery") \
+  X(SL_LOG_FMT_CLOUD_PUBLISHED, \
+    "azure_communication_task : MQTT Publish sent success") \
+  X(SL_LOG_FMT_CLOUD_WAIT_DISCONNECTED, \
+    "azure_communication_task : cloud/wifi is not connected, waiting for recovery") \
+  X(SL_LOG_FMT_LANE_DROPPED_OLDEST, \
+    "sl_publish_lane_enqueue : lane %d full, oldest message dropped") \
+  X(SL_LOG_FMT_LANE_DROPPED_NEWEST, \
+    "sl_publish_lane_enqueue : lane %d full, new message dropped") \
+  X(SL_LOG_FMT_LANE_DROPPED_RETRY, \
+    "sl_publish_lane_requeue : lane %d full, retried message dropped") \
+  X(SL_LOG_FMT_LANE_PUBLISHED, \
+    "sl_publish_lane_record_published : lane %d latency %lu ms, average %lu ms, max %lu ms") \
+  X(SL_LOG_FMT_JSON_WAIT_EMPTY, \
+    "json_task : sensor data queue is empty, waiting for a reading") \
+  X(SL_LOG_FMT_JSON_RECEIVED, \
+    "json_task : Sensor data is received from the sensor data queue for conversion to JSON format") \
+  X(SL_LOG_FMT_JSON_BMI270_ENQUEUED, \
+    "sl_convert_bmi270_reading_to_json_format : JSON format data is sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_GNSS_ENQUEUED, \
+    "sl_convert_gnss_reading_to_json_format : JSON format data is sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_SI7021_ENQUEUED, \
+    "sl_convert_si7021_reading_to_json_format : JSON format data is sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_SESSION_ENQUEUED, \
+    "sl_json_send_new_session_message : JSON format data is sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_WIFI_ENQUEUED, \
+    "sl_json_send_wifi_message : Wi-Fi JSON format data is sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_WIFI_SCAN_ENQUEUED, \
+    "sl_json_send_wifi_scan_message : Wi-Fi scan JSON format data is sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_LINK_ENQUEUED, \
+    "sl_json_send_link_message : link JSON format data is sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_KEEP_ALIVE_ENQUEUED, \
+    "sl_json_send_keep_alive_message : JSON format data is sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_DIAGNOSTICS_ENQUEUED, \
+    "sl_json_send_diagnostics_part : diagnostics values from %lu are sent to the MQTT data queue") \
+  X(SL_LOG_FMT_JSON_TIMESTAMP, \
+    "sl_json_get_timestamp : getjson_time: %02lu:%02lu:%02lu.%03lu") \
+  X(SL_LOG_FMT_SI7021_READ_OK, \
+    "temperature_rh_sensor_task : si7021 Sensor read is successful") \
+  X(SL_LOG_FMT_SI7021_READ_FAILED, \
+    "temperature_rh_sensor_task : si7021 Sensor read is failed") \
+  X(SL_LOG_FMT_SI7021_TIMESTAMP_FAILED, \
+    "temperature_rh_sensor_task : failed to fetch time-stamp, discarding the packet") \
+  X(SL_LOG_FMT_SI7021_QUEUE_FULL, \
+    "temperature_rh_sensor_task : received sensor data as sensor data queue is full") \
+  X(SL_LOG_FMT_SI7021_QUEUED, \
+    "temperature_rh_sensor_task : si7021 sensor data is sent to sensor data queue") \
+  X(SL_LOG_FMT_SI7021_DELAY, \
+    "temperature_rh_sensor_task : delay is : %ld") \
+  X(SL_LOG_FMT_BMI270_ACC_READ_FAILED, \
+    "imu_sensor_task : bmi270 Accelerometer sensor read is failed") \
+  X(SL_LOG_FMT_BMI270_GYRO_READ_FAILED, \
+    "imu_sensor_task : bmi270 gyroscope sensor read is failed") \
+  X(SL_LOG_FMT_BMI270_TIMESTAMP_FAILED, \
+    "imu_sensor_task : failed to fetch time-stamp, discarding the packet") \
+  X(SL_LOG_FMT_BMI270_QUEUE_FULL, \
+    "imu_sensor_task : received sensor data as sensor data queue is full") \
+  X(SL_LOG_FMT_BMI270_QUEUED, \
+    "imu_sensor_task : bmi270 sensor data is sent to sensor data queue") \
+  X(SL_LOG_FMT_BMI270_DELAY, \
+    "imu_sensor_task : delay is : %ld") \
+  X(SL_LOG_FMT_GNSS_FIX_TYPE, \
+    "gnss_receiver_task : fix type is: %d") \
+  X(SL_LOG_FMT_GNSS_POSITION, \
+    "gnss_receiver_task : latitude %ld, longitude %ld (raw), altitude %ld mm, satellites %ld") \
+  X(SL_LOG_FMT_GNSS_DATA_RETRY, \
+    "gnss_receiver_task : Data is not received, retry-count: %d") \
+  X(SL_LOG_FMT_GNSS_DATA_RECEIVED, \
+    "gnss_receiver_task : Data is received, break the fix-type retry loop") \
+  X(SL_LOG_FMT_GNSS_TIMESTAMP_FAILED, \
+    "gnss_receiver_task : failed to fetch time-stamp, discarding the packet") \
+  X(SL_LOG_FMT_GNSS_QUEUE_FULL, \
+    "gnss_receiver_task : received sensor data as sensor data queue is full") \
+  X(SL_LOG_FMT_GNSS_QUEUED, \
+    "gnss_receiver_task : gnss receiver data is sent to sensor data queue") \
+  X(SL_LOG_FMT_GNSS_DELAY, \
+    "gnss_receiver_task : delay is : %ld") \
+  X(SL_LOG_FMT_LINK_RSSI, \
+    "sl_link_monitor_add_sample : RSSI Value: %ld") \
+  X(SL_LOG_FMT_LANE_REPLACED, \
+    "sl_publish_lane : lane %d, older message of source %d dropped")
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enumeration for modules with their own log level
+typedef enum {
+  SL_LOG_MODULE_APP = 0,        ///< Application and deferred logger
+  SL_LOG_MODULE_SENSOR,         ///< Sensor tasks
+  SL_LOG_MODULE_JSON,           ///< JSON data converter
+  SL_LOG_MODULE_LANES,          ///< Publish lanes
+  SL_LOG_MODULE_CLOUD,          ///< Azure cloud communication
+  SL_LOG_MODULE_WIFI,           ///< Wi-Fi handler and link monitor
+  SL_LOG_MODULE_COUNT           ///< Number of modules
+} sl_log_module_e;
+
+/// @brief Enumeration for log levels, a record is kept when its level is at
+/// most the level of its module
+typedef enum {
+  SL_LOG_LEVEL_NONE = 0,        ///< Nothing is logged
+  SL_LOG_LEVEL_ERROR,           ///< Failures which lose data or a connection
+  SL_LOG_LEVEL_WARN,            ///< Recovered failures and drops
+  SL_LOG_LEVEL_INFO,            ///< State changes
+  SL_LOG_LEVEL_DEBUG,           ///< Every sample and message
+  SL_LOG_LEVEL_TRACE,           ///< Message payloads, printed synchronously
+  SL_LOG_LEVEL_COUNT            ///< Number of levels
+} sl_log_level_e;
+
+/// @brief Enumeration for format IDs, index in SL_LOG_FORMAT_LIST
+typedef enum {
+#define SL_LOG_FORMAT_ID(id, format) id,
+  SL_LOG_FORMAT_LIST(SL_LOG_FORMAT_ID)
+#undef SL_LOG_FORMAT_ID
+  SL_LOG_FMT_COUNT              ///< Number of formats
+} sl_log_format_id_e;
+
+/// @brief Structure for one deferred log record
+typedef struct {
+  uint32_t time_ms;             ///< Uptime when the record was written
+  uint16_t format_id;           ///< Entry of SL_LOG_FORMAT_LIST
+  uint8_t module;               ///< Module of the log site
+  uint8_t level;                ///< Level of the log site
+  uint8_t arg_count;            ///< Valid entries in args
+  uint32_t args[LOG_MAX_ARGS];  ///< Raw arguments, signed ones as two's complement
+} sl_log_record_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to get the format of a format ID.
+ * @param[in] format_id : entry of SL_LOG_FORMAT_LIST.
+ * @return format, NULL for an unknown ID.
+ ******************************************************************************/
+const char *sl_log_get_format(uint16_t format_id);
+
+/**************************************************************************/ /**
+ * @brief Function to get the name of a module.
+ * @param[in] module : log module.
+ * @return module name, "?" for an unknown module.
+ ******************************************************************************/
+const char *sl_log_get_module_name(uint8_t module);
+
+/**************************************************************************/ /**
+ * @brief Function to get the name of a level.
+ * @param[in] level : log level.
+ * @return level name, "?" for an unknown level.
+ ******************************************************************************/
+const char *sl_log_get_level_name(uint8_t level);
+
+/**************************************************************************/ /**
+ * @brief Function to expand a record into text.
+ * @param[in] record : log record.
+ * @param[out] text : formatted text, always terminated.
+ * @param[in] text_size : size of text.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the format ID is unknown or the arguments
+ *    do not match the format
+ ******************************************************************************/
+sl_status_t sl_log_format_record(const sl_log_record_t *record,
+                                 char *text,
+                                 size_t text_size);
+
+/**************************************************************************/ /**
+ * @brief Function to encode a record as a console line, LOG_FRAME_MARKER
+ * followed by the little-endian record in hex.
+ * @param[in] record : log record.
+ * @param[out] frame : terminated line without line break.
+ * @param[in] frame_size : size of frame, at least LOG_FRAME_MAX_SIZE.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when frame is too small or the record is invalid
+ ******************************************************************************/
+sl_status_t sl_log_encode_frame(const sl_log_record_t *record,
+                                char *frame,
+                                size_t frame_size);
+
+/**************************************************************************/ /**
+ * @brief Function to decode a console line written by sl_log_encode_frame.
+ * @param[in] frame : line, trailing line break is ignored.
+ * @param[out] record : decoded record.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the line is not a valid record
+ ******************************************************************************/
+sl_status_t sl_log_decode_frame(const char *frame, sl_log_record_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_LOG_FORMAT_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,159 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_metrics.h
+ * @brief Runtime metrics registry and diagnostics snapshot
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_METRICS_H_
+#define SL_WIFI_ASSET_TRACKING_METRICS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define METRICS_REPORT_INTERVAL              300    ///< In seconds, metrics are snapshotted and reported at this interval
+#define METRICS_HISTOGRAM_BUCKETS            6      ///< Buckets per histogram, the last one has no upper bound
+#define METRICS_SCHEMA_VERSION               4      ///< Order of values in diagnostics message, raised on every change of the metric enums
+#define METRICS_VALUES_PER_MESSAGE           8      ///< Values per diagnostics message, keeps it within MAX_JSON_MESSAGE_SIZE
+
+#define METRICS_COUNTER_OFFSET               0      ///< First counter in snapshot values
+#define METRICS_GAUGE_OFFSET                 (METRICS_COUNTER_OFFSET + SL_METRIC_COUNTER_COUNT) ///< First gauge in snapshot values
+#define METRICS_HISTOGRAM_OFFSET             (METRICS_GAUGE_OFFSET + SL_METRIC_GAUGE_COUNT) ///< First histogram bucket in snapshot values
+#define METRICS_VALUE_COUNT                  (METRICS_HISTOGRAM_OFFSET + (SL_METRIC_HISTOGRAM_COUNT * METRICS_HISTOGRAM_BUCKETS)) ///< Values in a snapshot
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for counters, totals since boot
+typedef enum {
+  SL_METRIC_SENSOR_SAMPLES = 0,   ///< Sensor readings queued for JSON conversion
+  SL_METRIC_SENSOR_QUEUE_DROPS,   ///< Sensor readings lost to a full sensor data queue
+  SL_METRIC_SENSOR_READ_FAILURES, ///< Failed sensor and GNSS reads
+  SL_METRIC_JSON_MESSAGES,        ///< Sensor readings converted to JSON
+  SL_METRIC_JSON_FAILURES,        ///< Sensor readings which failed JSON conversion
+  SL_METRIC_LANE_DROPS,           ///< Messages dropped by publish lane drop policies
+  SL_METRIC_PUBLISHED,            ///< Messages published to IoT Hub
+  SL_METRIC_PUBLISH_FAILURES,     ///< Publishes failed on a broken connection
+  SL_METRIC_PUBLISH_THROTTLED,    ///< Publishes refused by IoT Hub and retried
+  SL_METRIC_WIFI_CONNECTS,        ///< Wi-Fi joins, reconnections are the ones after the first
+  SL_METRIC_CLOUD_CONNECTS,       ///< IoT Hub connections, reconnections are the ones after the first
+  SL_METRIC_RECOVERY_ATTEMPTS,    ///< Sensor, Wi-Fi and IoT Hub reinitializations by the recovery task
+  SL_METRIC_RECOVERY_FAILURES,    ///< Recovery attempts which failed and backed off
+  SL_METRIC_COUNTER_COUNT,        ///< Number of counters
+} sl_metric_counter_e;
+
+/// @brief Enum for gauges, current or extreme values
+typedef enum {
+  SL_METRIC_UPTIME = 0,             ///< In seconds, time since boot
+  SL_METRIC_SENSOR_QUEUE_DEPTH,     ///< Readings in sensor data queue at snapshot
+  SL_METRIC_SENSOR_QUEUE_PEAK,      ///< Most readings in sensor data queue since boot
+  SL_METRIC_LANE_DEPTH,             ///< Messages on all publish lanes at snapshot
+  SL_METRIC_LANE_PEAK,              ///< Most messages on all publish lanes since boot
+  SL_METRIC_FREE_HEAP,              ///< In bytes, free FreeRTOS heap at snapshot
+  SL_METRIC_MIN_FREE_HEAP,          ///< In bytes, least free FreeRTOS heap since boot
+  SL_METRIC_MIN_STACK,              ///< In words, least unused stack of all tasks
+  SL_METRIC_RSSI,                   ///< In dBm, last RSSI sample, 0 while link is down
+  SL_METRIC_SUPERVISOR_RESTARTS,    ///< Subsystem restarts by the task supervisor since boot
+  SL_METRIC_RESET_REASON,           ///< sl_supervisor_reset_reason_e of the previous reset
+  SL_METRIC_RESET_TASK,             ///< sl_supervisor_client_e stuck at the previous reset, -1 when none
+  SL_METRIC_RECOVERY_PENDING,       ///< Bits of sl_recovery_subsystem_e not healthy at snapshot
+  SL_METRIC_RECOVERY_BACKOFF,       ///< In ms, longest backoff of a subsystem not healthy at snapshot
+  SL_METRIC_GAUGE_COUNT,            ///< Number of gauges
+} sl_metric_gauge_e;
+
+/// @brief Enum for histograms, bucket bounds are in the metrics source
+typedef enum {
+  SL_METRIC_PUBLISH_LATENCY = 0,  ///< In ms, publish lane enqueue to publish
+  SL_METRIC_PUBLISH_TIME,         ///< In ms, duration of one MQTT publish
+  SL_METRIC_SAMPLE_HANDOFF,       ///< In ms, sensor reading queued to JSON conversion
+  SL_METRIC_SAMPLE_LATENCY,       ///< In ms, sensor reading queued to publish
+  SL_METRIC_RECOVERY_TIME,        ///< In ms, subsystem failure to recovery
+  SL_METRIC_HISTOGRAM_COUNT,      ///< Number of histograms
+} sl_metric_histogram_e;
+
+/// @brief Structure for a snapshot, each value is read atomically but the
+/// snapshot is not one consistent cut
+typedef struct {
+  uint32_t values[METRICS_VALUE_COUNT];   ///< Counters, gauges and histogram buckets, gauges as two's complement
+} sl_metrics_snapshot_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Task function which snapshots metrics every METRICS_REPORT_INTERVAL,
+ * dumps them on the console with debug logs and sends them as diagnostics
+ * messages while IoT Hub is connected.
+ ******************************************************************************/
+void sl_metrics_task();
+
+/**************************************************************************/ /**
+ * @brief Function to add one to a counter. Lock-free, safe from any task.
+ * @param[in] counter : counter.
+ ******************************************************************************/
+void sl_metrics_increment(sl_metric_counter_e counter);
+
+/**************************************************************************/ /**
+ * @brief Function to set a gauge. Lock-free, safe from any task.
+ * @param[in] gauge : gauge.
+ * @param[in] value : new value.
+ ******************************************************************************/
+void sl_metrics_set_gauge(sl_metric_gauge_e gauge, int32_t value);
+
+/**************************************************************************/ /**
+ * @brief Function to raise a peak gauge. Lock-free, safe from any task.
+ * @param[in] gauge : gauge.
+ * @param[in] value : gauge keeps the larger of its value and this one.
+ ******************************************************************************/
+void sl_metrics_raise_gauge(sl_metric_gauge_e gauge, int32_t value);
+
+/**************************************************************************/ /**
+ * @brief Function to count a value in its histogram bucket. Lock-free, safe
+ * from any task.
+ * @param[in] histogram : histogram.
+ * @param[in] value : observed value.
+ ******************************************************************************/
+void sl_metrics_observe(sl_metric_histogram_e histogram, uint32_t value);
+
+/**************************************************************************/ /**
+ * @brief Function to sample uptime, queue depths, heap, stacks and RSSI,
+ * then copy all metrics.
+ * @param[out] snapshot : copy of metrics.
+ ******************************************************************************/
+void sl_metrics_snapshot(sl_metrics_snapshot_t *snapshot);
+
+/**************************************************************************/ /**
+ * @brief Function to print a snapshot with metric names and per-task stack
+ * usage on the console.
+ * @param[in] snapshot : snapshot to print.
+ ******************************************************************************/
+void sl_metrics_dump(const sl_metrics_snapshot_t *snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_METRICS_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
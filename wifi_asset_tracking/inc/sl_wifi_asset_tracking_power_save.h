@@ -0,0 +1,122 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_power_save.h
+ * @brief Wi-Fi power save between publish bursts
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_POWER_SAVE_H_
+#define SL_WIFI_ASSET_TRACKING_POWER_SAVE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define POWER_SAVE_LISTEN_INTERVAL           1000   ///< In ms, network processor wakes for beacons at this interval between bursts
+#define POWER_SAVE_DTIM_ALIGNED              1      ///< Wake on the DTIM beacon nearest to the listen interval
+#define POWER_SAVE_BEACON_RX_TIME            3      ///< In ms, estimated radio-on time of one beacon wake-up
+#define POWER_SAVE_REPORT_INTERVAL           3600   ///< In seconds, radio-on estimate is logged at this interval
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for power save metrics since the first power save entry
+typedef struct {
+  uint32_t bursts;                        ///< Publish bursts, each one wake-up of the radio
+  uint32_t awake_ms;                      ///< Time in high performance profile
+  uint32_t power_save_ms;                 ///< Time in associated power save profile
+  uint32_t radio_on_ms_per_hour;          ///< Estimated radio-on time, awake time plus beacon wake-ups
+} sl_power_save_metrics_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to configure the listen interval. Call after Wi-Fi
+ * initialization and before join, the interval is negotiated at association.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the listen interval is not accepted
+ ******************************************************************************/
+sl_status_t sl_power_save_init(void);
+
+/**************************************************************************/ /**
+ * @brief Function to put the network processor in associated power save. It
+ * sleeps between beacons at POWER_SAVE_LISTEN_INTERVAL and the publish burst
+ * cadence restarts here.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the profile is not accepted
+ ******************************************************************************/
+sl_status_t sl_power_save_enter(void);
+
+/**************************************************************************/ /**
+ * @brief Function to put the network processor in high performance, for a
+ * connection setup or a publish burst.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the profile is not accepted
+ ******************************************************************************/
+sl_status_t sl_power_save_exit(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get the wait before the next publish burst. The burst
+ * is moved earlier to the last step of a fixed cadence, a multiple of
+ * POWER_SAVE_LISTEN_INTERVAL since power save entry, before the deadline.
+ * The cadence is not aligned to the beacons of the access point, whose
+ * phase the network processor does not report.
+ * @param[in] due_ms : time until the first queued message must be sent.
+ * @return wait in ms, 0 to publish now.
+ ******************************************************************************/
+uint32_t sl_power_save_get_burst_delay(uint32_t due_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to start a publish burst, leaves power save.
+ ******************************************************************************/
+void sl_power_save_begin_burst(void);
+
+/**************************************************************************/ /**
+ * @brief Function to end a publish burst once the lanes are empty, enters
+ * power save again.
+ ******************************************************************************/
+void sl_power_save_end_burst(void);
+
+/**************************************************************************/ /**
+ * @brief Function to check whether a publish burst is running.
+ * @return true between sl_power_save_begin_burst and sl_power_save_end_burst.
+ ******************************************************************************/
+bool sl_power_save_is_burst_active(void);
+
+/**************************************************************************/ /**
+ * @brief Function to read power save metrics.
+ * @param[out] metrics : copy of power save metrics.
+ ******************************************************************************/
+void sl_power_save_get_metrics(sl_power_save_metrics_t *metrics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_POWER_SAVE_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,194 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_publish_lanes.h
+ * @brief Priority lanes between JSON producers and the cloud communication task
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_PUBLISH_LANES_H_
+#define SL_WIFI_ASSET_TRACKING_PUBLISH_LANES_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sl_status.h>
+#include <sl_wifi_asset_tracking_azure_handler.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define PUBLISH_LANE_WEIGHT_STRICT           0      ///< Lane weight served before every weighted lane
+
+#define PUBLISH_LANE_CRITICAL_CAPACITY       6      ///< Messages held by critical lane, one per critical source
+#define PUBLISH_LANE_CRITICAL_WEIGHT         PUBLISH_LANE_WEIGHT_STRICT ///< Critical lane always goes first
+#define PUBLISH_LANE_CRITICAL_DROP_POLICY    SL_PUBLISH_LANE_DROP_SAME_SOURCE ///< Latest alert of a source replaces its previous one
+#define PUBLISH_LANE_CRITICAL_LATENCY_CAP    0      ///< In ms, critical messages wake the radio at once
+
+#define PUBLISH_LANE_NORMAL_CAPACITY         6      ///< Messages held by normal lane
+#define PUBLISH_LANE_NORMAL_WEIGHT           3      ///< Normal messages sent per round of weighted lanes
+#define PUBLISH_LANE_NORMAL_DROP_POLICY      SL_PUBLISH_LANE_DROP_OLDEST ///< Drop policy of normal lane
+#define PUBLISH_LANE_NORMAL_LATENCY_CAP      10000  ///< In ms, longest wait of a normal message for a publish burst
+
+#define PUBLISH_LANE_BULK_CAPACITY           10     ///< Messages held by bulk lane
+#define PUBLISH_LANE_BULK_WEIGHT             1      ///< Bulk messages sent per round of weighted lanes
+#define PUBLISH_LANE_BULK_DROP_POLICY        SL_PUBLISH_LANE_DROP_OLDEST ///< Stale samples go first
+#define PUBLISH_LANE_BULK_LATENCY_CAP        15000  ///< In ms, longest wait of a bulk message for a publish burst
+
+#define PUBLISH_LANE_LATENCY_AVERAGE_SHIFT   3      ///< Weight 1/8 of newest sample in moving average latency
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for publish lanes, lower value is higher priority
+typedef enum {
+  SL_PUBLISH_LANE_CRITICAL = 0,  ///< Sensor disconnect notices, session and keep-alive
+  SL_PUBLISH_LANE_NORMAL,        ///< Wi-Fi and GNSS position reports
+  SL_PUBLISH_LANE_BULK,          ///< Routine temperature, humidity and IMU samples
+  SL_PUBLISH_LANE_COUNT,         ///< Number of lanes
+} sl_publish_lane_e;
+
+/// @brief Enum for message dropped when a lane is full
+typedef enum {
+  SL_PUBLISH_LANE_DROP_OLDEST = 0,  ///< Oldest queued message makes room for the new one
+  SL_PUBLISH_LANE_DROP_NEWEST,      ///< New message is rejected
+  SL_PUBLISH_LANE_DROP_SAME_SOURCE, ///< New message replaces the queued one of its source, even when
+                                    ///< the lane is not full, else the oldest makes room
+} sl_publish_lane_drop_policy_e;
+
+/// @brief Enum for producer of a lane message, the critical lane keeps at
+/// most one message per source
+typedef enum {
+  SL_PUBLISH_LANE_SOURCE_TEMP_RH_SENSOR = 0, ///< Si7021 readings and disconnect notices
+  SL_PUBLISH_LANE_SOURCE_IMU_SENSOR,         ///< bmi270 readings and disconnect notices
+  SL_PUBLISH_LANE_SOURCE_GNSS_RECEIVER,      ///< MAX-M10s readings and disconnect notices
+  SL_PUBLISH_LANE_SOURCE_SESSION,            ///< New session message
+  SL_PUBLISH_LANE_SOURCE_WIFI,               ///< Wi-Fi position report
+  SL_PUBLISH_LANE_SOURCE_WIFI_SCAN,          ///< Wi-Fi scan report
+  SL_PUBLISH_LANE_SOURCE_LINK,               ///< Link quality alert
+  SL_PUBLISH_LANE_SOURCE_KEEP_ALIVE,         ///< Keep-alive message
+  SL_PUBLISH_LANE_SOURCE_DIAGNOSTICS,        ///< Diagnostics report
+  SL_PUBLISH_LANE_SOURCE_COUNT,              ///< Number of sources
+} sl_publish_lane_source_e;
+
+/// @brief Structure for per-lane metrics, latency is enqueue to publish
+typedef struct {
+  uint32_t enqueued;             ///< Messages accepted by the lane
+  uint32_t published;            ///< Messages published from the lane
+  uint32_t dropped;              ///< Messages dropped by the drop policy
+  uint32_t last_latency_ms;      ///< Latency of last published message
+  uint32_t average_latency_ms;   ///< Moving average latency
+  uint32_t max_latency_ms;       ///< Worst latency since boot
+} sl_publish_lane_metrics_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to create lane queues and reset metrics.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on queue creation failure
+ ******************************************************************************/
+sl_status_t sl_publish_lane_init(void);
+
+/**************************************************************************/ /**
+ * @brief Function to delete lane queues.
+ ******************************************************************************/
+void sl_publish_lane_deinit(void);
+
+/**************************************************************************/ /**
+ * @brief Function to queue a JSON message on a lane, apply the lane drop
+ * policy and wake the cloud communication task.
+ * @param[in] lane : destination lane.
+ * @param[in] source : producer of the message.
+ * @param[in] data : JSON message, its source and enqueue tick are stamped.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the message is dropped
+ ******************************************************************************/
+sl_status_t sl_publish_lane_enqueue(
+  sl_publish_lane_e lane,
+  sl_publish_lane_source_e source,
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t *data);
+
+/**************************************************************************/ /**
+ * @brief Function to take the next message to publish. Strict lanes are
+ * drained first, weighted lanes share the rest by their weights.
+ * @param[out] data : JSON message.
+ * @param[out] lane : lane the message was taken from.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when all lanes are empty
+ ******************************************************************************/
+sl_status_t sl_publish_lane_dequeue(
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t *data,
+  sl_publish_lane_e *lane);
+
+/**************************************************************************/ /**
+ * @brief Function to put a message that could not be published back at the
+ * head of its lane. The enqueue tick is kept, so latency covers the retry.
+ * On a SL_PUBLISH_LANE_DROP_SAME_SOURCE lane the message is dropped when a
+ * newer one of its source was queued meanwhile.
+ * @param[in] lane : lane the message was taken from.
+ * @param[in] data : JSON message.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the lane refilled meanwhile or a newer message
+ *    of its source is queued, and the message is dropped
+ ******************************************************************************/
+sl_status_t sl_publish_lane_requeue(
+  sl_publish_lane_e lane,
+  const sl_wifi_asset_tracking_mqtt_package_queue_data_t *data);
+
+/**************************************************************************/ /**
+ * @brief Function to update lane latency once a message is published.
+ * @param[in] lane : lane the message was taken from.
+ * @param[in] data : published message.
+ ******************************************************************************/
+void sl_publish_lane_record_published(
+  sl_publish_lane_e lane,
+  const sl_wifi_asset_tracking_mqtt_package_queue_data_t *data);
+
+/**************************************************************************/ /**
+ * @brief Function to get the time until a queued message must be published,
+ * because its lane latency cap is reached or its lane is full.
+ * @return time in ms, 0 when a message is due, UINT32_MAX when all lanes are
+ * empty.
+ ******************************************************************************/
+uint32_t sl_publish_lane_get_due_ms(void);
+
+/**************************************************************************/ /**
+ * @brief Function to count messages queued on all lanes.
+ * @return number of queued messages.
+ ******************************************************************************/
+uint32_t sl_publish_lane_messages_waiting(void);
+
+/**************************************************************************/ /**
+ * @brief Function to read metrics of a lane.
+ * @param[in] lane : lane.
+ * @param[out] metrics : copy of lane metrics.
+ ******************************************************************************/
+void sl_publish_lane_get_metrics(sl_publish_lane_e lane,
+                                 sl_publish_lane_metrics_t *metrics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_PUBLISH_LANES_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,104 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_rate_limit.h
+ * @brief Token bucket publish rate limiter with backpressure to sampling
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_RATE_LIMIT_H_
+#define SL_WIFI_ASSET_TRACKING_RATE_LIMIT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define RATE_LIMIT_MESSAGES_PER_MINUTE       120    ///< Sustained publish rate, keep below the IoT Hub tier quota per device
+#define RATE_LIMIT_MIN_MESSAGES_PER_MINUTE   12     ///< Lowest rate reached by repeated throttling
+#define RATE_LIMIT_BURST_SIZE                20     ///< Messages that can be published back to back
+#define RATE_LIMIT_RECOVERY_STEP             6      ///< Messages per minute restored after each hold period without throttling
+#define RATE_LIMIT_HOLD_PERIOD               30000  ///< In ms, minimum time between two backpressure or rate changes
+#define RATE_LIMIT_MAX_CONSECUTIVE_THROTTLES 5      ///< Throttles in a row handled as link failure
+#define RATE_LIMIT_BACKPRESSURE_THRESHOLD    8      ///< Queued messages above which producers are slowed down
+#define RATE_LIMIT_MAX_BACKPRESSURE_LEVEL    3      ///< Sampling interval is multiplied by 2 ^ level
+#define RATE_LIMIT_TOKEN_SCALE               1000   ///< Tokens are kept in 1/1000 message
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to fill the bucket and reset rate and backpressure.
+ ******************************************************************************/
+void sl_rate_limit_init(void);
+
+/**************************************************************************/ /**
+ * @brief Function to take one publish token from the bucket.
+ * @param[in] queued_messages : messages waiting on the publish lanes.
+ * @param[out] wait_ms : time until the next token, when none is left.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_BUSY - bucket is empty, retry after wait_ms
+ ******************************************************************************/
+sl_status_t sl_rate_limit_acquire(uint32_t queued_messages, uint32_t *wait_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to report a message accepted by the IoT Hub.
+ * @param[in] queued_messages : messages waiting on the publish lanes.
+ ******************************************************************************/
+void sl_rate_limit_on_published(uint32_t queued_messages);
+
+/**************************************************************************/ /**
+ * @brief Function to report a connection closed by the IoT Hub while the
+ * link stayed up. Halves the publish rate, empties the bucket and raises
+ * backpressure.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK - retry the message after reconnection
+ * -  \ref SL_STATUS_FAIL - too many throttles in a row, handle as publish failure
+ ******************************************************************************/
+sl_status_t sl_rate_limit_on_throttled(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get the current backpressure level for producers.
+ * @return level from 0 to RATE_LIMIT_MAX_BACKPRESSURE_LEVEL.
+ ******************************************************************************/
+uint8_t sl_rate_limit_get_backpressure_level(void);
+
+/**************************************************************************/ /**
+ * @brief Function to stretch a sampling interval by the backpressure level.
+ * @param[in] interval_ms : configured sampling interval.
+ * @param[in] max_interval_ms : upper limit of the sampling interval.
+ * @return sampling interval to use, in ms.
+ ******************************************************************************/
+uint32_t sl_rate_limit_scale_interval(uint32_t interval_ms,
+                                      uint32_t max_interval_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to get the current sustained publish rate.
+ * @return messages per minute.
+ ******************************************************************************/
+uint32_t sl_rate_limit_get_rate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_RATE_LIMIT_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,104 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_recovery.h
+ * @brief Recovery state machine with backoff for sensors, Wi-Fi and cloud
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_RECOVERY_H_
+#define SL_WIFI_ASSET_TRACKING_RECOVERY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define RECOVERY_BACKOFF_INITIAL_WIFI        15000  ///< In ms, delay after the first failed Wi-Fi rejoin burst, doubled per failed burst
+#define RECOVERY_BACKOFF_MAX_SENSOR          600000 ///< In ms, retry ceiling of a sensor reinitialization
+#define RECOVERY_BACKOFF_MAX_WIFI            300000 ///< In ms, retry ceiling of a Wi-Fi rejoin burst
+#define RECOVERY_BACKOFF_MAX_CLOUD           300000 ///< In ms, retry ceiling of an IoT Hub connection
+#define RECOVERY_JITTER_PERCENT              25     ///< Share of a delay removed at random, spreads the retries of a fleet
+#define RECOVERY_WAIT_FOREVER                UINT32_MAX ///< Returned by sl_recovery_run when no attempt is scheduled
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for recovered subsystems, in order of recovery
+typedef enum {
+  SL_RECOVERY_SUBSYSTEM_TEMPERATURE_RH_SENSOR = 0, ///< Si7021 temperature and RH sensor
+  SL_RECOVERY_SUBSYSTEM_IMU_SENSOR,                ///< BMI270 IMU sensor
+  SL_RECOVERY_SUBSYSTEM_GNSS_RECEIVER,             ///< MAX-M10S GNSS receiver
+  SL_RECOVERY_SUBSYSTEM_WIFI,                      ///< Wi-Fi connection
+  SL_RECOVERY_SUBSYSTEM_CLOUD,                     ///< IoT Hub connection, needs Wi-Fi
+  SL_RECOVERY_SUBSYSTEM_COUNT,                     ///< Number of subsystems
+} sl_recovery_subsystem_e;
+
+/// @brief Enum for recovery state of a subsystem
+typedef enum {
+  SL_RECOVERY_STATE_HEALTHY = 0,  ///< Working, or not started yet
+  SL_RECOVERY_STATE_BACKOFF,      ///< Failed, next attempt is scheduled
+  SL_RECOVERY_STATE_BLOCKED,      ///< Failed, waits for the subsystem it needs
+} sl_recovery_state_e;
+
+/// @brief Structure for recovery history of a subsystem since boot
+typedef struct {
+  sl_recovery_state_e state;      ///< Current state
+  uint32_t attempts;              ///< Reinitialization attempts
+  uint32_t failures;              ///< Attempts which failed
+  uint32_t recoveries;            ///< Failures which were recovered
+  uint32_t consecutive_failures;  ///< Failed attempts of the current outage
+  uint32_t last_backoff_ms;       ///< Delay before the next or the last attempt
+  uint32_t last_outage_ms;        ///< Failure to recovery, last outage
+  uint32_t max_outage_ms;         ///< Failure to recovery, longest outage
+} sl_recovery_stats_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to run the state machine of every subsystem once. A failed
+ * subsystem leaves HEALTHY and gets its first attempt after its first delay;
+ * every further failed attempt doubles the delay up to the ceiling of the
+ * subsystem, minus up to RECOVERY_JITTER_PERCENT. A subsystem which needs
+ * another one is BLOCKED until that one is healthy and then attempts right
+ * away. Attempts reinitialize the subsystem in place, there is no final
+ * failure. Call from the recovery task only.
+ * @return In ms, time until the next scheduled attempt, RECOVERY_WAIT_FOREVER
+ * when every subsystem is healthy or blocked.
+ ******************************************************************************/
+uint32_t sl_recovery_run(void);
+
+/**************************************************************************/ /**
+ * @brief Function to read the recovery history of a subsystem.
+ * @param[in] subsystem : subsystem.
+ * @param[out] stats : copy of the history.
+ ******************************************************************************/
+void sl_recovery_get_stats(sl_recovery_subsystem_e subsystem,
+                           sl_recovery_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_RECOVERY_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,101 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_sas_token.h
+ * @brief SAS token signature cache and reusable HMAC-SHA256 context
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_SAS_TOKEN_H_
+#define SL_WIFI_ASSET_TRACKING_SAS_TOKEN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SAS_TOKEN_CACHE_WINDOW               300U  ///< In seconds, unit of Azure IoT Hub client time, SAS expiry is aligned to this window so reconnects inside it reuse one signature
+#define SAS_TOKEN_REFRESH_PERIOD             ((SAS_TOKEN_CACHE_WINDOW * 1000U) / 2) ///< In ms, period of background signature refresh
+#define SAS_TOKEN_MAX_MESSAGE_SIZE           160   ///< Maximum size of string-to-sign that can be cached
+#define SAS_TOKEN_MAX_EXPIRY_DIGITS          10    ///< Maximum decimal digits of SAS expiry
+#define SAS_TOKEN_CACHE_SLOTS                2     ///< Current and next window signatures
+#define HMAC_SHA256_BLOCK_SIZE               64    ///< SHA-256 block size in bytes
+#define HMAC_SHA256_DIGEST_SIZE              32    ///< SHA-256 digest size in bytes
+#define HMAC_INNER_PAD                       0x36  ///< HMAC inner pad byte
+#define HMAC_OUTER_PAD                       0x5C  ///< HMAC outer pad byte
+#define NAME_SAS_TOKEN_REFRESH_TIMER \
+  "sas_token_refresh_timer"                        ///< String for SAS token refresh timer
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one cached SAS signature
+typedef struct {
+  bool is_valid;                                 ///< Slot holds a signature
+  uint32_t message_len;                          ///< Length of string-to-sign
+  uint8_t message[SAS_TOKEN_MAX_MESSAGE_SIZE];   ///< String-to-sign ("<resource>\n<expiry>")
+  uint8_t digest[HMAC_SHA256_DIGEST_SIZE];       ///< HMAC-SHA256 of message
+} sl_sas_token_cache_entry_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Time source handed to Azure IoT Hub client, in seconds as the client
+ * expects. It is aligned to SAS_TOKEN_CACHE_WINDOW so that every connect
+ * inside a window produces the same string-to-sign and the cached signature
+ * can be reused.
+ * @return An uint32_t time in seconds, aligned to the cache window.
+ ******************************************************************************/
+uint32_t sl_sas_token_get_time(void);
+
+/**************************************************************************/ /**
+ * @brief Function to compute HMAC-SHA256 of SAS string-to-sign. Signatures
+ * are served from cache when available. Otherwise they are computed from
+ * precomputed inner and outer key pads, so each signature costs one pass
+ * over the message.
+ * @param[in] key : decoded device symmetric key.
+ * @param[in] key_len : length of key.
+ * @param[in] message : string-to-sign.
+ * @param[in] message_len : length of message.
+ * @param[out] digest : HMAC output buffer of HMAC_SHA256_DIGEST_SIZE bytes.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on HMAC computation failure
+ ******************************************************************************/
+sl_status_t sl_sas_token_hmac(const uint8_t *key,
+                              uint32_t key_len,
+                              const uint8_t *message,
+                              uint32_t message_len,
+                              uint8_t *digest);
+
+/**************************************************************************/ /**
+ * @brief Callback function of SAS token refresh timer. Precomputes the
+ * signature of the next cache window before the current one expires.
+ ******************************************************************************/
+void on_sas_token_refresh_timer_callback();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_SAS_TOKEN_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
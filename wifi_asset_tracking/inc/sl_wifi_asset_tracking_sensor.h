@@ -39,8 +39,7 @@ extern "C" {
 #define I2C                                               SL_I2C2 ///< I2C 2 instance
 #define DELAY_PERIODIC_MS1                                2000    ///< sleeptimer1 periodic timeout in ms
 #define UULP_GPIO_1_PIN                                   1       ///< UULP GPIO pin number 1(sensor enable)
-#define SENSOR_MAX_RETRY_COUNT                            3       ///< Maximum retry count for sensor
-#define SENSOR_PER_RETRY_DELAY                            5000    ///< In ms
+#define SENSOR_PER_RETRY_DELAY                            5000    ///< In ms, first recovery backoff of a sensor, doubled per failed attempt
 #define GNSS_PER_RETRY_DELAY                              500     ///< In ms
 #define GNSS_DATA_TIMEOUT_RETRY_DELAY                     200     ///< In ms
 #define GNSS_RETRY_COUNT                                  10      ///< Retry count for GNSS receiver
@@ -99,6 +98,7 @@ typedef struct {
   bool is_sensor_data_available; ///< sensor data status
   sl_wifi_asset_tracking_sensor_queue_data_type_e sensor_type; ///< sensor queue data type
   uint8_t  time_stamp[MAX_TIMESTAMP_BUFF_SIZE]; ///< sensor data time-stamp
+  uint32_t sample_tick; ///< Tick count when the reading was queued
   union {
     sl_temp_rh_data_t temp_rh_data; ///< Si7021 temperature and RH sensor data
     sl_imu_data_t imu_data; ///< bmi270 IMU sensor data
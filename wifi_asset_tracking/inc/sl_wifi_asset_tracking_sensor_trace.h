@@ -0,0 +1,75 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_sensor_trace.h
+ * @brief Recording of sensor readings as a trace for replay on the host
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_SENSOR_TRACE_H_
+#define SL_WIFI_ASSET_TRACKING_SENSOR_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <sl_status.h>
+#include <sl_wifi_asset_tracking_sensor.h>
+#include <sl_wifi_asset_tracking_sensor_trace_format.h>
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to convert a sensor reading into a trace record.
+ * @param[in] reading : time-stamped sensor reading.
+ * @param[out] record : trace record.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the type or the time-stamp is invalid
+ ******************************************************************************/
+sl_status_t sl_sensor_trace_from_reading(
+  const sl_wifi_asset_tracking_sensor_queue_data_t *reading,
+  sl_sensor_trace_record_t *record);
+
+/**************************************************************************/ /**
+ * @brief Function to convert a trace record back into a sensor reading, the
+ * replay side of sl_sensor_trace_from_reading. sample_tick is not set.
+ * @param[in] record : trace record.
+ * @param[out] reading : sensor reading with its recorded time-stamp.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the record is invalid
+ ******************************************************************************/
+sl_status_t sl_sensor_trace_to_reading(
+  const sl_sensor_trace_record_t *record,
+  sl_wifi_asset_tracking_sensor_queue_data_t *reading);
+
+/**************************************************************************/ /**
+ * @brief Function to print a reading as a SENSOR_TRACE_FRAME_MARKER console
+ * line when DEMO_CONFIG_SENSOR_TRACE_OUTPUT is enabled, does nothing
+ * otherwise. Call from the sensor tasks once the reading is time-stamped.
+ * @param[in] reading : time-stamped sensor reading.
+ ******************************************************************************/
+void sl_sensor_trace_record(
+  const sl_wifi_asset_tracking_sensor_queue_data_t *reading);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_SENSOR_TRACE_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,167 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_sensor_trace_format.h
+ * @brief Record encoding of sensor traces for record and replay
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_SENSOR_TRACE_FORMAT_H_
+#define SL_WIFI_ASSET_TRACKING_SENSOR_TRACE_FORMAT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// This header is shared with the host tools, keep it free of SDK includes
+#include <stddef.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SENSOR_TRACE_TYPE_COUNT              4      ///< Sensor types including the invalid one, as sl_wifi_asset_tracking_sensor_queue_data_type_e
+#define SENSOR_TRACE_MAX_VALUES              6      ///< Values of the largest reading, IMU
+#define SENSOR_TRACE_RECORD_MAX_SIZE         (1 + 10 + (5 * SENSOR_TRACE_MAX_VALUES)) ///< Header, time and values as varints
+#define SENSOR_TRACE_FRAME_MARKER            "#S"   ///< Start of a trace record line on the console
+#define SENSOR_TRACE_FRAME_MAX_SIZE          (sizeof(SENSOR_TRACE_FRAME_MARKER) + (2 * SENSOR_TRACE_RECORD_MAX_SIZE)) ///< Terminated hex line of a record
+#define SENSOR_TRACE_TIME_SIZE               25     ///< Terminated time-stamp, 2000-01-01T00:00:00.000Z
+#define SENSOR_TRACE_FILE_MAGIC              "SLST" ///< Start of a trace file, followed by the version
+#define SENSOR_TRACE_FILE_VERSION            1      ///< Trace file version, records follow with a length byte each
+
+/// Scale of the values of a reading, the driver value times the scale is
+/// rounded to an integer
+#define SENSOR_TRACE_SCALE_TEMP_RH           100    ///< Temperature and RH, centi units
+#define SENSOR_TRACE_SCALE_IMU               1000   ///< Accelerometer and gyroscope, milli units
+#define SENSOR_TRACE_SCALE_POSITION          10000000 ///< Latitude and longitude, 1e-7 degrees as UBX
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one recorded sensor reading. Values by sensor type:
+/// temperature and RH: temperature, humidity;
+/// IMU: accelerometer x, y, z, gyroscope x, y, z;
+/// GNSS: latitude, longitude, altitude in mm, satellites.
+typedef struct {
+  uint64_t time_ms;                          ///< Time-stamp of the reading, ms since 2000-01-01T00:00:00Z
+  uint8_t sensor_type;                       ///< Sensor queue data type
+  uint8_t is_available;                      ///< Driver read succeeded, there are no values otherwise
+  int32_t values[SENSOR_TRACE_MAX_VALUES];   ///< Scaled driver values
+} sl_sensor_trace_record_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to get the number of values of a sensor type.
+ * @param[in] sensor_type : sensor queue data type.
+ * @return value count, 0 for an unknown type.
+ ******************************************************************************/
+uint8_t sl_sensor_trace_get_value_count(uint8_t sensor_type);
+
+/**************************************************************************/ /**
+ * @brief Function to encode a record: type and availability in one byte,
+ * then the time and the values as little-endian base 128 varints, signed
+ * values zigzag encoded.
+ * @param[in] record : sensor trace record.
+ * @param[out] buffer : encoded record.
+ * @param[in] buffer_size : size of buffer, SENSOR_TRACE_RECORD_MAX_SIZE is
+ * always enough.
+ * @param[out] length : encoded length.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when buffer is too small or the type is unknown
+ ******************************************************************************/
+sl_status_t sl_sensor_trace_encode(const sl_sensor_trace_record_t *record,
+                                   uint8_t *buffer,
+                                   size_t buffer_size,
+                                   size_t *length);
+
+/**************************************************************************/ /**
+ * @brief Function to decode one record written by sl_sensor_trace_encode.
+ * @param[in] buffer : encoded record, may be followed by other data.
+ * @param[in] buffer_size : bytes available in buffer.
+ * @param[out] record : decoded record.
+ * @param[out] length : bytes of buffer used by the record.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when buffer does not start with a valid record
+ ******************************************************************************/
+sl_status_t sl_sensor_trace_decode(const uint8_t *buffer,
+                                   size_t buffer_size,
+                                   sl_sensor_trace_record_t *record,
+                                   size_t *length);
+
+/**************************************************************************/ /**
+ * @brief Function to encode a record as a console line,
+ * SENSOR_TRACE_FRAME_MARKER followed by the encoded record in hex.
+ * @param[in] record : sensor trace record.
+ * @param[out] frame : terminated line without line break.
+ * @param[in] frame_size : size of frame, at least SENSOR_TRACE_FRAME_MAX_SIZE.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when frame is too small or the record is invalid
+ ******************************************************************************/
+sl_status_t sl_sensor_trace_encode_frame(const sl_sensor_trace_record_t *record,
+                                         char *frame,
+                                         size_t frame_size);
+
+/**************************************************************************/ /**
+ * @brief Function to decode a console line written by
+ * sl_sensor_trace_encode_frame.
+ * @param[in] frame : line, trailing line break is ignored.
+ * @param[out] record : decoded record.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the line is not a valid record
+ ******************************************************************************/
+sl_status_t sl_sensor_trace_decode_frame(const char *frame,
+                                         sl_sensor_trace_record_t *record);
+
+/**************************************************************************/ /**
+ * @brief Function to convert a JSON time-stamp, 2024-01-31T12:00:00.000Z,
+ * into ms since 2000-01-01T00:00:00Z.
+ * @param[in] timestamp : time-stamp of a sensor reading.
+ * @param[out] time_ms : time-stamp in ms.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the time-stamp is malformed or before 2000
+ ******************************************************************************/
+sl_status_t sl_sensor_trace_parse_time(const char *timestamp,
+                                       uint64_t *time_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to convert ms since 2000-01-01T00:00:00Z back into the
+ * JSON time-stamp layout.
+ * @param[in] time_ms : time-stamp in ms.
+ * @param[out] timestamp : terminated time-stamp.
+ * @param[in] timestamp_size : size of timestamp, at least
+ * SENSOR_TRACE_TIME_SIZE.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when timestamp is too small or the year is past 9999
+ ******************************************************************************/
+sl_status_t sl_sensor_trace_format_time(uint64_t time_ms,
+                                        char *timestamp,
+                                        size_t timestamp_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_SENSOR_TRACE_FORMAT_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,45 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_stack_config.h
+ * @brief Stack depth of application tasks
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_STACK_CONFIG_H_
+#define SL_WIFI_ASSET_TRACKING_STACK_CONFIG_H_
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+
+/// Generated by sl_host_stack_config from a DEMO_CONFIG_STACK_PROFILE run,
+/// regenerate instead of editing. Sizes are in words.
+#define STACK_SIZE_TEMPERATURE_RH_SENSOR_TASK         1000   ///< Not profiled
+#define STACK_SIZE_IMU_SENSOR_TASK                    1000   ///< Not profiled
+#define STACK_SIZE_GNSS_RECEIVER_TASK                 1000   ///< Not profiled
+#define STACK_SIZE_WIFI_DATA_CAPTURE_TASK             1000   ///< Not profiled
+#define STACK_SIZE_JSON_DATA_CONVERTER_TASK           1000   ///< Not profiled
+#define STACK_SIZE_CLOUD_COMMUNICATION_TASK           1000   ///< Not profiled
+#define STACK_SIZE_RECOVERY_TASK                      1000   ///< Not profiled
+#define STACK_SIZE_LCD_TASK                           1000   ///< Not profiled
+#define STACK_SIZE_LINK_MONITOR_TASK                  1000   ///< Not profiled
+#define STACK_SIZE_CLOCK_TASK                         1000   ///< Not profiled
+#define STACK_SIZE_METRICS_TASK                       1000   ///< Not profiled
+#define STACK_SIZE_LOG_TASK                           1000   ///< Not profiled
+#define STACK_SIZE_SUPERVISOR_TASK                    1000   ///< Not profiled
+
+#endif /* SL_WIFI_ASSET_TRACKING_STACK_CONFIG_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,98 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_stack_profile.h
+ * @brief Stack high-water profiling and stack size recommendation
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_STACK_PROFILE_H_
+#define SL_WIFI_ASSET_TRACKING_STACK_PROFILE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+#include <sl_wifi_asset_tracking_static_alloc.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define STACK_PROFILE_MARGIN_PERCENT         25       ///< Headroom added to the measured peak
+#define STACK_PROFILE_MIN_MARGIN             64       ///< In words, least headroom added to the measured peak
+#define STACK_PROFILE_ALIGNMENT              32       ///< In words, recommended sizes are a multiple of this
+#define STACK_PROFILE_NVM3_KEY               0x1001   ///< NVM3 object key used to persist the peaks
+#define STACK_PROFILE_NVM3_MAGIC             0x53544B01 ///< Marker and layout version of persisted peaks
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for stack peaks persisted in NVM3
+typedef struct {
+  uint32_t magic;                         ///< STACK_PROFILE_NVM3_MAGIC
+  uint32_t boots;                         ///< Boots the peaks were collected over
+  uint16_t peak[SL_STATIC_TASK_COUNT];    ///< In words, most stack used by each task
+} sl_stack_profile_nvm3_record_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to restore peaks of previous boots and count this boot.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on NVM3 failure, profiling starts from zero
+ ******************************************************************************/
+sl_status_t sl_stack_profile_init(void);
+
+/**************************************************************************/ /**
+ * @brief Function to sample the stack high-water mark of every running task
+ * and persist the peaks when one of them rose.
+ ******************************************************************************/
+void sl_stack_profile_sample(void);
+
+/**************************************************************************/ /**
+ * @brief Function to sample one task, call before the task is deleted so
+ * its peak is not lost.
+ * @param[in] task : application task.
+ ******************************************************************************/
+void sl_stack_profile_sample_task(sl_static_task_e task);
+
+/**************************************************************************/ /**
+ * @brief Function to get the recommended stack depth for a measured peak.
+ * @param[in] peak : In words, most stack used, 0 when not measured.
+ * @param[in] stack_size : In words, current stack depth.
+ * @return In words, peak with margin rounded up to STACK_PROFILE_ALIGNMENT,
+ * or stack_size when the task was never measured.
+ ******************************************************************************/
+uint32_t sl_stack_profile_recommend(uint32_t peak, uint32_t stack_size);
+
+/**************************************************************************/ /**
+ * @brief Function to print peak, current and recommended stack depth of
+ * every task, as read by sl_host_stack_config to generate
+ * sl_wifi_asset_tracking_stack_config.h.
+ ******************************************************************************/
+void sl_stack_profile_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_STACK_PROFILE_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,173 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_static_alloc.h
+ * @brief Static allocation of application tasks, queues, semaphores and timers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_STATIC_ALLOC_H_
+#define SL_WIFI_ASSET_TRACKING_STATIC_ALLOC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+#include <timers.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define STATIC_ALLOC_RAM_BUDGET              (64 * 1024) ///< In bytes, most RAM of static kernel objects, checked at compile time
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for subsystems of the RAM report
+typedef enum {
+  SL_STATIC_SUBSYSTEM_SENSOR = 0, ///< Sensor tasks, sensor data queue, I2C and sensor timers
+  SL_STATIC_SUBSYSTEM_JSON,       ///< JSON data converter task
+  SL_STATIC_SUBSYSTEM_CLOUD,      ///< Cloud task, publish lanes, SAS token and keep-alive
+  SL_STATIC_SUBSYSTEM_WIFI,       ///< Wi-Fi capture and link monitor tasks, DNS cache
+  SL_STATIC_SUBSYSTEM_LCD,        ///< LCD task and LCD data queue
+  SL_STATIC_SUBSYSTEM_SYSTEM,     ///< Recovery, clock, metrics and log tasks
+  SL_STATIC_SUBSYSTEM_COUNT,      ///< Number of subsystems
+} sl_static_subsystem_e;
+
+/// @brief Enum for application tasks
+typedef enum {
+  SL_STATIC_TASK_TEMPERATURE_RH_SENSOR = 0, ///< Temperature and RH sensor data capture task
+  SL_STATIC_TASK_IMU_SENSOR,                ///< IMU sensor data capture task
+  SL_STATIC_TASK_GNSS_RECEIVER,             ///< GNSS receiver data capture task
+  SL_STATIC_TASK_WIFI_DATA_CAPTURE,         ///< Wi-Fi data capture task
+  SL_STATIC_TASK_JSON_DATA_CONVERTER,       ///< JSON data converter task
+  SL_STATIC_TASK_CLOUD_COMMUNICATION,       ///< Azure cloud communication task
+  SL_STATIC_TASK_RECOVERY,                  ///< Recovery task
+  SL_STATIC_TASK_LCD,                       ///< LCD task
+  SL_STATIC_TASK_LINK_MONITOR,              ///< Wi-Fi link monitor task
+  SL_STATIC_TASK_CLOCK,                     ///< Clock discipline task
+  SL_STATIC_TASK_METRICS,                   ///< Metrics report task
+  SL_STATIC_TASK_LOG,                       ///< Deferred log task
+  SL_STATIC_TASK_SUPERVISOR,                ///< Task supervisor
+  SL_STATIC_TASK_COUNT,                     ///< Number of tasks
+} sl_static_task_e;
+
+/// @brief Enum for application queues, lane queues follow sl_publish_lane_e
+typedef enum {
+  SL_STATIC_QUEUE_SENSOR_DATA = 0,  ///< Sensor data queue
+  SL_STATIC_QUEUE_LCD_DATA,         ///< LCD data queue
+  SL_STATIC_QUEUE_LANE_CRITICAL,    ///< MQTT package queue of critical lane
+  SL_STATIC_QUEUE_LANE_NORMAL,      ///< MQTT package queue of normal lane
+  SL_STATIC_QUEUE_LANE_BULK,        ///< MQTT package queue of bulk lane
+  SL_STATIC_QUEUE_COUNT,            ///< Number of queues
+} sl_static_queue_e;
+
+/// @brief Enum for application mutexes and semaphores
+typedef enum {
+  SL_STATIC_SEMAPHORE_SENSOR_DATA_QUEUE = 0,  ///< Sensor data queue mutex
+  SL_STATIC_SEMAPHORE_MQTT_PACKAGE_QUEUE,     ///< MQTT package queue mutex
+  SL_STATIC_SEMAPHORE_I2C,                    ///< I2C transaction binary semaphore
+  SL_STATIC_SEMAPHORE_DNS_CACHE,              ///< DNS cache mutex
+  SL_STATIC_SEMAPHORE_SAS_TOKEN,              ///< SAS token cache mutex
+  SL_STATIC_SEMAPHORE_CLOCK,                  ///< Clock discipline mutex
+  SL_STATIC_SEMAPHORE_WIFI_SCAN,              ///< Wi-Fi scan mutex
+  SL_STATIC_SEMAPHORE_COUNT,                  ///< Number of semaphores
+} sl_static_semaphore_e;
+
+/// @brief Enum for application timers
+typedef enum {
+  SL_STATIC_TIMER_TEMPERATURE_RH_SENSOR = 0,  ///< Temperature and RH sensor timer
+  SL_STATIC_TIMER_IMU_SENSOR,                 ///< IMU sensor timer
+  SL_STATIC_TIMER_GNSS_RECEIVER,              ///< GNSS receiver timer
+  SL_STATIC_TIMER_SAS_TOKEN_REFRESH,          ///< SAS token refresh timer
+  SL_STATIC_TIMER_MQTT_KEEP_ALIVE,            ///< MQTT keep-alive timer
+  SL_STATIC_TIMER_COUNT,                      ///< Number of timers
+} sl_static_timer_e;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to create an application task. With
+ * DEMO_CONFIG_STATIC_ALLOCATION the task always gets the same stack and
+ * control block, so a task deleted and recreated by the recovery task takes
+ * no heap and cannot fail on fragmentation.
+ * @param[in] task : application task.
+ * @param[out] handle : task handle.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on an unknown task, or a task whose previous
+ *    instance is not deleted yet
+ ******************************************************************************/
+sl_status_t sl_static_create_task(sl_static_task_e task, TaskHandle_t *handle);
+
+/**************************************************************************/ /**
+ * @brief Function to get the handle of an application task.
+ * @param[in] task : application task.
+ * @return task handle, NULL for an unknown task or a task not running.
+ ******************************************************************************/
+TaskHandle_t sl_static_get_task_handle(sl_static_task_e task);
+
+/**************************************************************************/ /**
+ * @brief Function to get the configured stack depth of an application task.
+ * @param[in] task : application task.
+ * @return In words, stack depth, 0 for an unknown task.
+ ******************************************************************************/
+uint32_t sl_static_get_task_stack_size(sl_static_task_e task);
+
+/**************************************************************************/ /**
+ * @brief Function to create an application queue with its compile time
+ * length and item size.
+ * @param[in] queue : application queue.
+ * @return queue handle, NULL on failure.
+ ******************************************************************************/
+QueueHandle_t sl_static_create_queue(sl_static_queue_e queue);
+
+/**************************************************************************/ /**
+ * @brief Function to create an application mutex or, for I2C, a binary
+ * semaphore which is given once before it is returned.
+ * @param[in] semaphore : application semaphore.
+ * @return semaphore handle, NULL on failure.
+ ******************************************************************************/
+SemaphoreHandle_t sl_static_create_semaphore(sl_static_semaphore_e semaphore);
+
+/**************************************************************************/ /**
+ * @brief Function to create an application timer with its compile time name,
+ * period, reload mode and callback. The timer is not started.
+ * @param[in] timer : application timer.
+ * @return timer handle, NULL on failure.
+ ******************************************************************************/
+TimerHandle_t sl_static_create_timer(sl_static_timer_e timer);
+
+/**************************************************************************/ /**
+ * @brief Function to print RAM of task stacks, kernel objects and queue
+ * storage per subsystem, and the FreeRTOS heap left for the SDK.
+ ******************************************************************************/
+void sl_static_alloc_report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_STATIC_ALLOC_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
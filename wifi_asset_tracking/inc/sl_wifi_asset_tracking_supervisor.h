@@ -0,0 +1,129 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_supervisor.h
+ * @brief Task check-in supervision, hardware watchdog and reset reason
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_SUPERVISOR_H_
+#define SL_WIFI_ASSET_TRACKING_SUPERVISOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SUPERVISOR_PERIOD                    1000   ///< In ms, check-ins are checked and the watchdog is fed at this interval
+#define SUPERVISOR_MAX_RESTARTS              3      ///< Subsystem restarts of one task before the device is reset
+#define SUPERVISOR_DEADLINE_SENSOR           5000   ///< In ms, longest temperature and RH or IMU sample
+#define SUPERVISOR_DEADLINE_GNSS             30000  ///< In ms, longest GNSS sample with retries and Wi-Fi positioning scan
+#define SUPERVISOR_DEADLINE_WIFI_CAPTURE     15000  ///< In ms, longest Wi-Fi and keep-alive message capture
+#define SUPERVISOR_DEADLINE_JSON             5000   ///< In ms, longest JSON conversion
+#define SUPERVISOR_DEADLINE_CLOUD            30000  ///< In ms, longest publish or keep-alive of the cloud task
+#define SUPERVISOR_WATCHDOG_INTERRUPT_TIME   17     ///< Watchdog interrupt after 2^n cycles of the 32 kHz clock, 4 s
+#define SUPERVISOR_WATCHDOG_RESET_TIME       18     ///< Watchdog system reset after 2^n cycles of the 32 kHz clock, 8 s
+#define SUPERVISOR_RETAINED_SECTION          ".noinit" ///< Linker section which start-up code neither clears nor loads, placed by linker/sl_wifi_asset_tracking_noinit.ld
+#define SUPERVISOR_RETAINED_MAGIC            0x53555052 ///< Marker of a valid retained reset record
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for supervised tasks, in sl_static_task_e order
+typedef enum {
+  SL_SUPERVISOR_CLIENT_TEMPERATURE_RH_SENSOR = 0, ///< Temperature and RH sensor data capture task
+  SL_SUPERVISOR_CLIENT_IMU_SENSOR,                ///< IMU sensor data capture task
+  SL_SUPERVISOR_CLIENT_GNSS_RECEIVER,             ///< GNSS receiver data capture task
+  SL_SUPERVISOR_CLIENT_WIFI_DATA_CAPTURE,         ///< Wi-Fi data capture task
+  SL_SUPERVISOR_CLIENT_JSON_DATA_CONVERTER,       ///< JSON data converter task
+  SL_SUPERVISOR_CLIENT_CLOUD_COMMUNICATION,       ///< Cloud communication task
+  SL_SUPERVISOR_CLIENT_COUNT,                     ///< Number of clients
+} sl_supervisor_client_e;
+
+/// @brief Enum for reason of the previous reset
+typedef enum {
+  SL_SUPERVISOR_RESET_NONE = 0,     ///< Power-on or reset not caused by the supervisor
+  SL_SUPERVISOR_RESET_WATCHDOG,     ///< Hardware watchdog was not fed
+  SL_SUPERVISOR_RESET_TASK_STUCK,   ///< A task stayed overdue after SUPERVISOR_MAX_RESTARTS restarts or has no subsystem restart
+} sl_supervisor_reset_reason_e;
+
+/// @brief Structure for reset record kept in RAM over a reset
+typedef struct {
+  uint32_t magic;     ///< SUPERVISOR_RETAINED_MAGIC
+  uint32_t reason;    ///< sl_supervisor_reset_reason_e
+  uint32_t client;    ///< Overdue task, SL_SUPERVISOR_CLIENT_COUNT when none
+  uint32_t resets;    ///< Supervisor and watchdog resets since power-on
+  uint32_t uptime;    ///< In seconds, uptime at reset
+  uint32_t check;     ///< Inverted XOR of the fields above
+} sl_supervisor_retained_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to read the reset record of the previous boot, publish it
+ * in the metrics and clear it for this boot. Call before the scheduler starts.
+ ******************************************************************************/
+void sl_supervisor_init(void);
+
+/**************************************************************************/ /**
+ * @brief Function to stop the hardware watchdog, call after deleting the
+ * supervisor task.
+ ******************************************************************************/
+void sl_supervisor_deinit(void);
+
+/**************************************************************************/ /**
+ * @brief Task function which checks the deadline of every checked-in task
+ * each SUPERVISOR_PERIOD. An overdue sensor task or cloud task is restarted
+ * through the recovery task, any other overdue task or a task restarted
+ * SUPERVISOR_MAX_RESTARTS times resets the device. The hardware watchdog is
+ * only fed while no task is overdue.
+ ******************************************************************************/
+void sl_supervisor_task();
+
+/**************************************************************************/ /**
+ * @brief Function to start or continue supervised work, the task has to
+ * check in again or check out within its deadline.
+ * @param[in] client : calling task.
+ ******************************************************************************/
+void sl_supervisor_check_in(sl_supervisor_client_e client);
+
+/**************************************************************************/ /**
+ * @brief Function to stop supervision before the task sleeps or waits for
+ * an event without a time limit.
+ * @param[in] client : calling task.
+ ******************************************************************************/
+void sl_supervisor_check_out(sl_supervisor_client_e client);
+
+/**************************************************************************/ /**
+ * @brief Function to read the reset record of the previous boot.
+ * @param[out] record : reset record, reason SL_SUPERVISOR_RESET_NONE after
+ * power-on.
+ ******************************************************************************/
+void sl_supervisor_get_last_reset(sl_supervisor_retained_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_SUPERVISOR_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,143 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_transport.h
+ * @brief Pluggable byte stream transport used by the Azure IoT Hub client
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_TRANSPORT_H_
+#define SL_WIFI_ASSET_TRACKING_TRANSPORT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// This header is shared with the host tools, keep it free of SDK includes
+#include <stddef.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SL_TRANSPORT_PEER_CLOSED (-2)  ///< Send or receive result when the server closed the connection
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+typedef struct NetworkContext NetworkContext_t;  ///< Network Context type
+
+/// @brief Enumeration for the reason the connection was lost
+typedef enum {
+  SL_TRANSPORT_DISCONNECT_NONE = 0,         ///< Connection had no error
+  SL_TRANSPORT_DISCONNECT_ERROR,            ///< Send or receive failed on this side
+  SL_TRANSPORT_DISCONNECT_PEER_CLOSED,      ///< Server closed the connection
+} sl_transport_disconnect_reason_e;
+
+/// @brief Structure for one transport backend, e.g. SiWx91x TLS socket or
+/// POSIX TCP/TLS socket
+typedef struct {
+  sl_status_t (*connect)(void *context,
+                         const char *host_name,
+                         uint16_t port);          ///< Open the connection
+  int32_t (*send)(void *context,
+                  const void *buffer,
+                  size_t bytes_to_send);          ///< Returns bytes sent, negative on error, SL_TRANSPORT_PEER_CLOSED when closed by the server
+  int32_t (*recv)(void *context,
+                  void *buffer,
+                  size_t bytes_to_recv);          ///< Returns bytes received, 0 on timeout, negative on error, SL_TRANSPORT_PEER_CLOSED when closed by the server
+  void (*disconnect)(void *context);              ///< Close the connection
+  void *context;                                  ///< Backend specific connection state
+} sl_transport_interface_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to select the transport backend used by the cloud
+ * connection. The interface must stay valid while it is registered.
+ * @param[in] transport : transport backend.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on invalid transport backend
+ ******************************************************************************/
+sl_status_t sl_transport_register(const sl_transport_interface_t *transport);
+
+/**************************************************************************/ /**
+ * @brief Function to get the registered transport backend.
+ * @return pointer to the transport backend, NULL if none is registered.
+ ******************************************************************************/
+const sl_transport_interface_t *sl_transport_get_interface(void);
+
+/**************************************************************************/ /**
+ * @brief Function to connect the registered transport backend.
+ * @param[in] host_name : null terminated host name.
+ * @param[in] port : server port.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on connection failure or no backend registered
+ ******************************************************************************/
+sl_status_t sl_transport_connect(const char *host_name, uint16_t port);
+
+/**************************************************************************/ /**
+ * @brief Function to disconnect the registered transport backend.
+ ******************************************************************************/
+void sl_transport_disconnect(void);
+
+/**************************************************************************/ /**
+ * @brief Send callback handed to the Azure IoT Hub client.
+ * @param network_context: Pointer to the Network context.
+ * @param buffer: Buffer that contains data to be sent.
+ * @param bytes_to_send: Length of the data to be sent.
+ * @return An int32_t number of bytes successfully sent.
+ ******************************************************************************/
+int32_t sl_transport_send(NetworkContext_t *network_context,
+                          const void *buffer,
+                          size_t bytes_to_send);
+
+/**************************************************************************/ /**
+ * @brief Receive callback handed to the Azure IoT Hub client.
+ * @param network_context: Pointer to the Network context.
+ * @param buffer: Buffer used for receiving data.
+ * @param bytes_to_recv: Size of the buffer.
+ * @return An int32_t number of bytes copied.
+ ******************************************************************************/
+int32_t sl_transport_recv(NetworkContext_t *network_context,
+                          void *buffer,
+                          size_t bytes_to_recv);
+
+/**************************************************************************/ /**
+ * @brief Function to check the connection for send or receive errors since
+ * it was opened. A receive timeout is not an error.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK - connection had no error
+ * -  \ref SL_STATUS_FAIL - send or receive failed, or not connected
+ ******************************************************************************/
+sl_status_t sl_transport_get_link_status(void);
+
+/**************************************************************************/ /**
+ * @brief Function to get why the connection was lost since it was opened.
+ * @return disconnect reason, SL_TRANSPORT_DISCONNECT_NONE while healthy.
+ ******************************************************************************/
+sl_transport_disconnect_reason_e sl_transport_get_disconnect_reason(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_TRANSPORT_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
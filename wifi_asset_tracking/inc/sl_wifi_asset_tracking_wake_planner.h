@@ -0,0 +1,91 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_wake_planner.h
+ * @brief Merges sleep deadlines of capture tasks into shared wake-ups
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_WAKE_PLANNER_H_
+#define SL_WIFI_ASSET_TRACKING_WAKE_PLANNER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+#include <FreeRTOS.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define WAKE_PLANNER_TOLERANCE               500    ///< In ms, a deadline this close to a planned wake-up joins it
+#define WAKE_PLANNER_REPORT_INTERVAL         3600   ///< In seconds, wake-ups and sleep share are logged at this interval
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for tasks which sleep through the wake planner
+typedef enum {
+  SL_WAKE_CLIENT_TEMPERATURE_RH_SENSOR = 0, ///< Temperature and RH sensor data capture task
+  SL_WAKE_CLIENT_IMU_SENSOR,                ///< IMU sensor data capture task
+  SL_WAKE_CLIENT_GNSS_RECEIVER,             ///< GNSS receiver data capture task
+  SL_WAKE_CLIENT_WIFI_DATA_CAPTURE,         ///< Wi-Fi data capture task
+  SL_WAKE_CLIENT_COUNT,                     ///< Number of clients
+} sl_wake_client_e;
+
+/// @brief Structure for wake planner metrics since boot
+typedef struct {
+  uint32_t wakes;             ///< Wake-ups planned for a single client
+  uint32_t merged;            ///< Deadlines moved onto another client's wake-up
+  uint32_t shift_ms;          ///< Sum of absolute deadline moves
+  uint32_t sleep_permille;    ///< Idle share of the last report interval, 0 without run time statistics
+} sl_wake_planner_metrics_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to reset deadlines and metrics, call before the capture
+ * tasks run.
+ ******************************************************************************/
+void sl_wake_planner_init(void);
+
+/**************************************************************************/ /**
+ * @brief Function to sleep a capture task instead of vTaskDelay. With
+ * DEMO_CONFIG_LOW_POWER_MODE, which follows configUSE_TICKLESS_IDLE, the
+ * deadline is moved onto the nearest wake-up already planned by another
+ * client when it is within WAKE_PLANNER_TOLERANCE, so tickless idle sleeps
+ * through one long period instead of several short ones.
+ * @param[in] client : calling capture task.
+ * @param[in] delay : ticks to sleep, as for vTaskDelay.
+ ******************************************************************************/
+void sl_wake_planner_delay(sl_wake_client_e client, TickType_t delay);
+
+/**************************************************************************/ /**
+ * @brief Function to read wake planner metrics.
+ * @param[out] metrics : copy of wake planner metrics.
+ ******************************************************************************/
+void sl_wake_planner_get_metrics(sl_wake_planner_metrics_t *metrics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_WAKE_PLANNER_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -0,0 +1,131 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_wifi_fingerprint.h
+ * @brief Access point selection and encoding for Wi-Fi positioning
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_WIFI_FINGERPRINT_H_
+#define SL_WIFI_ASSET_TRACKING_WIFI_FINGERPRINT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// This header is shared with the host tools, keep it free of SDK includes
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define WIFI_FINGERPRINT_MAX_APS          6        ///< Strongest access points kept per scan
+#define WIFI_FINGERPRINT_MIN_RSSI         (-90)    ///< In dBm, weaker access points are ignored
+#define WIFI_FINGERPRINT_FORMAT_VERSION   0x01     ///< First byte of encoded fingerprint
+#define WIFI_FINGERPRINT_HEADER_SIZE      2        ///< Version and access point count
+#define WIFI_FINGERPRINT_BSSID_SIZE       6        ///< BSSID length in bytes
+#define WIFI_FINGERPRINT_ENTRY_SIZE       (WIFI_FINGERPRINT_BSSID_SIZE + 2) ///< BSSID, RSSI and channel
+#define WIFI_FINGERPRINT_NOMAP_SUFFIX     "_nomap" ///< SSID suffix of access points opted out of positioning
+
+/// Largest encoded fingerprint in bytes
+#define WIFI_FINGERPRINT_MAX_ENCODED_SIZE \
+  (WIFI_FINGERPRINT_HEADER_SIZE + (WIFI_FINGERPRINT_MAX_APS * WIFI_FINGERPRINT_ENTRY_SIZE))
+
+/// Largest base64 text of a fingerprint, terminator included
+#define WIFI_FINGERPRINT_MAX_TEXT_SIZE \
+  ((((WIFI_FINGERPRINT_MAX_ENCODED_SIZE + 2) / 3) * 4) + 1)
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Structure for one access point of a fingerprint
+typedef struct {
+  uint8_t bssid[WIFI_FINGERPRINT_BSSID_SIZE]; ///< Access point MAC address
+  int8_t rssi;                                ///< In dBm
+  uint8_t channel;                            ///< Wi-Fi channel
+} sl_wifi_fingerprint_ap_t;
+
+/// @brief Structure for access points of one scan, strongest first
+typedef struct {
+  uint8_t ap_count;                                    ///< Valid entries in ap
+  sl_wifi_fingerprint_ap_t ap[WIFI_FINGERPRINT_MAX_APS]; ///< Selected access points
+} sl_wifi_fingerprint_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to empty a fingerprint before a scan.
+ * @param[out] fingerprint : fingerprint.
+ ******************************************************************************/
+void sl_wifi_fingerprint_init(sl_wifi_fingerprint_t *fingerprint);
+
+/**************************************************************************/ /**
+ * @brief Function to offer one scan result to a fingerprint. The strongest
+ * WIFI_FINGERPRINT_MAX_APS access points are kept, each BSSID once. Weak,
+ * locally administered (mobile hotspot) and "_nomap" access points are not
+ * useful for positioning and are skipped.
+ * @param[in,out] fingerprint : fingerprint.
+ * @param[in] bssid : access point MAC address.
+ * @param[in] rssi : in dBm.
+ * @param[in] channel : Wi-Fi channel.
+ * @param[in] ssid : SSID, need not be terminated.
+ * @param[in] ssid_len : SSID length.
+ * @return true when the access point is kept.
+ ******************************************************************************/
+bool sl_wifi_fingerprint_add(sl_wifi_fingerprint_t *fingerprint,
+                             const uint8_t *bssid,
+                             int8_t rssi,
+                             uint8_t channel,
+                             const uint8_t *ssid,
+                             size_t ssid_len);
+
+/**************************************************************************/ /**
+ * @brief Function to encode a fingerprint as base64 text for a JSON message.
+ * The binary form is the version, the access point count, then BSSID, RSSI
+ * and channel of each access point.
+ * @param[in] fingerprint : fingerprint.
+ * @param[out] text : terminated base64 text.
+ * @param[in] text_size : size of text, WIFI_FINGERPRINT_MAX_TEXT_SIZE is
+ * always enough.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the fingerprint is empty or text is too small
+ ******************************************************************************/
+sl_status_t sl_wifi_fingerprint_encode(const sl_wifi_fingerprint_t *fingerprint,
+                                       char *text,
+                                       size_t text_size);
+
+/**************************************************************************/ /**
+ * @brief Function to decode base64 text made by sl_wifi_fingerprint_encode.
+ * @param[in] text : terminated base64 text.
+ * @param[out] fingerprint : fingerprint.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on malformed text or unknown version
+ ******************************************************************************/
+sl_status_t sl_wifi_fingerprint_decode(const char *text,
+                                       sl_wifi_fingerprint_t *fingerprint);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_WIFI_FINGERPRINT_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
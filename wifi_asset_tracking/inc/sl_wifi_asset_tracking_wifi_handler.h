@@ -24,19 +24,28 @@ extern "C" {
 
 #include <sl_status.h>
 #include <sl_si91x_calendar.h>
+#include <sl_wifi_types.h>
+#include <sl_wifi_asset_tracking_wifi_fingerprint.h>
 
 /*******************************************************************************
  ***************************  Defines / Macros  ********************************
  ******************************************************************************/
-#define MAX_WIFI_CONN_RETRY_COUNT            5      ///< In numbers
-#define WIFI_CONN_DELAY_BETN_RETRY           15000  ///< In ms
-#define KEEP_ALIVE_INTERVAL                  10     ///< In seconds
+#define MAX_WIFI_CONN_RETRY_COUNT            8      ///< In numbers, delays between them in sl_wifi_rejoin_get_backoff
+#define KEEP_ALIVE_INTERVAL                  60     ///< In seconds, heartbeat state is checked for changes
+#define HEARTBEAT_MAX_INTERVAL               900    ///< In seconds, unchanged heartbeat is repeated after this time
 #define WIFI_PACKET_TYPE                     0x01   ///< Wi-Fi packet type
 #define KEEP_ALIVE_PACKET_TYPE               0x02   ///< Keep alive packet types
 #define MAX_LIMIT_OF_WIFI_SAMPLING_INTERVAL  600    ///< Maximum sampling interval of wi-fi
 #define MIN_LIMIT_OF_WIFI_SAMPLING_INTERVAL  60     ///< Minimum sampling interval of wi-fi
+#define WIFI_SCAN_TIMEOUT                    5000   ///< In ms, wait for positioning scan results
+#define WIFI_SCAN_POLL_INTERVAL              50     ///< In ms, check for scan completion
+#define WIFI_SCAN_ACTIVE_CHANNEL_TIME        20     ///< In ms, dwell per channel of background scan
+#define WIFI_SCAN_PASSIVE_CHANNEL_TIME       100    ///< In ms, dwell per passive (DFS) channel
+#define WIFI_SCAN_CHANNEL_BITMAP_2G4         0x1FFF ///< Channels 1 to 13
 
 #define NTP_SERVER_IP                        "0.pool.ntp.org"       ///< NTP server IP
+#define NTP_SERVER_DNS_TIMEOUT               10000  ///< In ms
+#define NTP_SERVER_DNS_REQ_COUNT             1      ///< Maximum DNS request count for NTP server
 #define SNTP_METHOD                          SL_SNTP_UNICAST_MODE   ///< SNTP method used
 #define SNTP_FLAGS                           0                      ///< SNTP flags
 #define SNTP_DATA_BUFFER_LENGTH              50                     ///< SNTP buffer length
@@ -93,6 +102,10 @@ typedef enum
   SL_NTP_MS, ///< Used to parse milli-seconds from UTC NTP time format
 } sl_ntp_utc_format_e;
 
+/// @brief Handler called for each access point found by sl_scan_wifi
+typedef void (*sl_wifi_scan_result_handler_t)(const sl_wifi_scan_info_t *scan_info,
+                                              void *context);
+
 // -----------------------------------------------------------------------------
 // Prototypes
 
@@ -110,8 +123,9 @@ void sl_capture_wifi_data_task();
 sl_status_t sl_start_wifi_connection();
 
 /**************************************************************************/ /**
- * @brief Function will retry for Wi-Fi connection with configured SSID for five
- * times at every five seconds.
+ * @brief Function will retry for Wi-Fi connection with configured SSID up to
+ * MAX_WIFI_CONN_RETRY_COUNT times with exponential backoff. First attempts
+ * rejoin the cached access point, later ones scan for it.
  * @param [init] : True If recovery during wi-fi connection initialization and
  * False If recovery during runtime
  * @return The following values are returned:
@@ -130,6 +144,19 @@ sl_status_t sl_retry_wifi_connection(bool init);
  ******************************************************************************/
 sl_status_t sl_set_time_and_date_using_sntp();
 
+/**************************************************************************/ /**
+ * @brief Function will setup SNTP and fetch date and time in UTC format from
+ * network without changing calendar RTC. Call with clock mutex held.
+ * @param[out] cal_data : network date and time.
+ * @param[out] exchange_ms : duration of SNTP exchange, bounds the error of
+ * the fetched time.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when network time could not be fetched
+ ******************************************************************************/
+sl_status_t sl_get_time_and_date_using_sntp(sl_cal_date_time_type_t *cal_data,
+                                            uint32_t *exchange_ms);
+
 /**************************************************************************/ /**
  * @brief Function will fetch current RSSI value using SL_WIFI_CLIENT_INTERFACE.
  * @param[out] rssi : output RSSI data
@@ -140,14 +167,33 @@ sl_status_t sl_set_time_and_date_using_sntp();
 sl_status_t sl_get_wifi_rssi(int32_t *rssi);
 
 /**************************************************************************/ /**
- * @brief Function will fetch MAC address using SL_WIFI_CLIENT_INTERFACE and
- * convert into string format.
- * @param[out] mac_addr : output MAC address value in string format
+ * @brief Function will run one scan and pass each access point found to a
+ * handler. Background scan (SL_WIFI_SCAN_TYPE_ADV_SCAN) keeps the current
+ * connection, other scan types need the client to be disconnected.
+ * @param[in] scan_type : scan type.
+ * @param[in] ssid : SSID to probe for, NULL for all access points.
+ * @param[in] handler : called from scan callback context for each access point.
+ * @param[in] context : passed to handler.
  * @return The following values are returned:
  * -  \ref SL_STATUS_OK on success
- * -  \ref SL_STATUS_FAIL - on sensor disable failed
+ * -  \ref SL_STATUS_TIMEOUT - when scan results do not arrive in time
+ * -  \ref SL_STATUS_FAIL - on scan failure
+ ******************************************************************************/
+sl_status_t sl_scan_wifi(sl_wifi_scan_type_t scan_type,
+                         const sl_wifi_ssid_t *ssid,
+                         sl_wifi_scan_result_handler_t handler,
+                         void *context);
+
+/**************************************************************************/ /**
+ * @brief Function will scan neighbouring access points without leaving the
+ * connected access point and keep the strongest ones for positioning.
+ * @param[out] fingerprint : selected access points, strongest first
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_TIMEOUT - when scan results do not arrive in time
+ * -  \ref SL_STATUS_FAIL - on scan failure or no usable access point
  ******************************************************************************/
-sl_status_t sl_get_wifi_mac_address(uint8_t *mac_addr);
+sl_status_t sl_scan_wifi_fingerprint(sl_wifi_fingerprint_t *fingerprint);
 
 /***************************************************************************/ /**
  * De-initlialize the wi-fi connection
@@ -0,0 +1,110 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_wifi_rejoin.h
+ * @brief Wi-Fi join with cached access point and IP lease
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef SL_WIFI_ASSET_TRACKING_WIFI_REJOIN_H_
+#define SL_WIFI_ASSET_TRACKING_WIFI_REJOIN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sl_status.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define WIFI_REJOIN_BACKOFF_INITIAL          250    ///< In ms, delay before the second attempt, doubled per attempt
+#define WIFI_REJOIN_BACKOFF_MAX              15000  ///< In ms, longest delay between two attempts
+#define WIFI_REJOIN_FAST_ATTEMPTS            2      ///< Attempts with the cached access point before a full scan
+#define WIFI_REJOIN_LEASE_VALIDITY           1800   ///< In seconds after DHCP, keep below the DHCP server lease time
+#define WIFI_REJOIN_JOIN_TIMEOUT             8000   ///< In ms, association and authentication of one attempt
+
+/*******************************************************************************
+ **************************   ENUMS and Structures   ***************************
+ ******************************************************************************/
+
+/// @brief Enum for phases of a Wi-Fi join
+typedef enum {
+  SL_WIFI_REJOIN_PHASE_SCAN = 0,  ///< Scan for the configured SSID, skipped on fast path
+  SL_WIFI_REJOIN_PHASE_AUTH,      ///< Association and authentication
+  SL_WIFI_REJOIN_PHASE_DHCP,      ///< DHCP, or cached lease on fast path
+  SL_WIFI_REJOIN_PHASE_COUNT,     ///< Number of phases
+} sl_wifi_rejoin_phase_e;
+
+/// @brief Structure for join metrics since boot
+typedef struct {
+  uint32_t fast_joins;                                    ///< Joins with cached access point
+  uint32_t full_joins;                                    ///< Joins after full scan
+  uint32_t lease_reuses;                                  ///< Joins which skipped DHCP
+  uint32_t failed_attempts;                               ///< Attempts which did not connect
+  uint32_t last_phase_ms[SL_WIFI_REJOIN_PHASE_COUNT];     ///< Duration of each phase of last join
+  uint32_t max_phase_ms[SL_WIFI_REJOIN_PHASE_COUNT];      ///< Longest duration of each phase
+  uint32_t last_reconnect_ms;                             ///< Start of recovery to connected, last reconnection
+  uint32_t max_reconnect_ms;                              ///< Start of recovery to connected, worst case
+} sl_wifi_rejoin_metrics_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/**************************************************************************/ /**
+ * @brief Function to join the configured access point once. The fast path
+ * joins the cached BSSID on its channel without scan and reuses the cached
+ * IP lease while it is valid; the full path scans for the strongest access
+ * point of the configured SSID and runs DHCP. Both paths refresh the cache.
+ * @param[in] is_fast_allowed : false forces the full path.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when a phase failed
+ ******************************************************************************/
+sl_status_t sl_wifi_rejoin_connect(bool is_fast_allowed);
+
+/**************************************************************************/ /**
+ * @brief Function to get the delay before a join attempt.
+ * @param[in] attempt : attempt number, starting at 0.
+ * @return delay in ms, 0 for the first attempt.
+ ******************************************************************************/
+uint32_t sl_wifi_rejoin_get_backoff(uint8_t attempt);
+
+/**************************************************************************/ /**
+ * @brief Function to record the time from start of recovery to connected.
+ * @param[in] reconnect_ms : time to reconnect.
+ ******************************************************************************/
+void sl_wifi_rejoin_on_reconnected(uint32_t reconnect_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to forget the cached access point and IP lease. Called when
+ * a join on the cached access point fails, so the next attempt scans.
+ ******************************************************************************/
+void sl_wifi_rejoin_invalidate(void);
+
+/**************************************************************************/ /**
+ * @brief Function to read join metrics.
+ * @param[out] metrics : copy of join metrics.
+ ******************************************************************************/
+void sl_wifi_rejoin_get_metrics(sl_wifi_rejoin_metrics_t *metrics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_WIFI_ASSET_TRACKING_WIFI_REJOIN_H_ */
+
+/******************************************************************************/
+/* EOF                                                                        */
+/******************************************************************************/
@@ -16,6 +16,7 @@
  ******************************************************************************/
 
 #include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
 
 /**
  * @brief strings printed on LCD for different status.
@@ -23,9 +24,6 @@
 char *sl_wifi_asset_tracking_lcd_strings[] = {
   "Wi-Fi asset tracking application started",
   "   ",
-  "Application shutdown: None of sensors are connected",
-  "Application shutdown: Wi-Fi is not connected",
-  "Application shutdown: Azure IoT Hub is not connected",
   "SI7021: Not connected",
   "BMI270: Not connected",
   "MAX-M10S: Not connected",
@@ -41,6 +39,11 @@ char *sl_wifi_asset_tracking_lcd_strings[] = {
   "Azure IoT Hub: Connection retrying"
 };
 
+_Static_assert((sizeof(sl_wifi_asset_tracking_lcd_strings)
+                / sizeof(sl_wifi_asset_tracking_lcd_strings[0]))
+               == INDEX_LCD_MESSAGE_COUNT,
+               "one LCD string per sl_siwx917_wifi_asset_tracking_lcd_logs_indexing_e");
+
 /**
  * @brief To store wi-fi asset tracking application status.
  */
@@ -60,6 +63,9 @@ sl_status_t sl_start_wifi_asset_tracking_application()
   printf("\r\n********Starting wi-fi asset tracking application********\r\n");
   printf("\r\n*********************************************************\r\n");
 
+  /// Log sites may run as soon as the scheduler starts
+  sl_log_init();
+
   /// create require tasks for scheduler
   if (SL_STATUS_OK != sl_create_wifi_asset_tracking_tasks()) {
     printf(
@@ -74,6 +80,9 @@ sl_status_t sl_start_wifi_asset_tracking_application()
     goto error;
   }
 
+  /// Print RAM taken by application tasks and queues
+  sl_static_alloc_report();
+
   /// By returning Success, main function will start scheduler internally
   return SL_STATUS_OK;
 
@@ -96,90 +105,106 @@ sl_status_t sl_start_wifi_asset_tracking_application()
 sl_status_t sl_create_wifi_asset_tracking_tasks()
 {
   /// Create GNSS receiver data capture task
-  if (pdPASS != xTaskCreate(sl_capture_gnss_receiver_data_task,
-                            NAME_GNSS_RECEIVER_TASK,
-                            STACK_SIZE_GNSS_RECEIVER_TASK,
-                            NULL,
-                            PRIORITY_GNSS_RECEIVER_TASK,
-                            &(sl_wifi_asset_tracking_resource.task_list.
-                              gnss_receiver_task_handler))) {
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_GNSS_RECEIVER,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 gnss_receiver_task_handler))) {
     goto error;
   }
 
   /// Create IMU sensor data capture task
-  if (pdPASS != xTaskCreate(sl_capture_imu_sensor_data_task,
-                            NAME_IMU_SENSOR_TASK,
-                            STACK_SIZE_IMU_SENSOR_TASK,
-                            NULL,
-                            PRIORITY_IMU_SENSOR_TASK,
-                            &(sl_wifi_asset_tracking_resource.task_list.
-                              imu_sensor_task_handler))) {
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_IMU_SENSOR,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 imu_sensor_task_handler))) {
     goto error;
   }
 
   /// Create temperate and RH sensor data capture task
-  if (pdPASS != xTaskCreate(sl_capture_temperature_rh_sensor_data_task,
-                            NAME_TEMPERATURE_RH_SENSOR_TASK,
-                            STACK_SIZE_TEMPERATURE_RH_SENSOR_TASK,
-                            NULL,
-                            PRIORITY_TEMPERATURE_RH_SENSOR_TASK,
-                            &(sl_wifi_asset_tracking_resource.task_list.
-                              temp_rh_sensor_task_handler))) {
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_TEMPERATURE_RH_SENSOR,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 temp_rh_sensor_task_handler))) {
     goto error;
   }
 
   /// Create Wi-Fi data capture task
-  if (pdPASS != xTaskCreate(sl_capture_wifi_data_task,
-                            NAME_WIFI_DATA_CAPTURE_TASK,
-                            STACK_SIZE_WIFI_DATA_CAPTURE_TASK,
-                            NULL,
-                            PRIORITY_WIFI_DATA_CAPTURE_TASK,
-                            &(sl_wifi_asset_tracking_resource.task_list.
-                              wifi_data_capture_task_handler))) {
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_WIFI_DATA_CAPTURE,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 wifi_data_capture_task_handler))) {
     goto error;
   }
 
   /// Create JSON data converter task
-  if (pdPASS != xTaskCreate(sl_json_data_converter_task,
-                            NAME_JSON_DATA_CONVERTER_TASK,
-                            STACK_SIZE_JSON_DATA_CONVERTER_TASK,
-                            NULL,
-                            PRIORITY_JSON_DATA_CONVERTER_TASK,
-                            &(sl_wifi_asset_tracking_resource.task_list.
-                              json_data_converter_task_handler))) {
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_JSON_DATA_CONVERTER,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 json_data_converter_task_handler))) {
     goto error;
   }
 
   /// Create Azure cloud communication task
-  if (pdPASS != xTaskCreate(sl_azure_cloud_communication_task,
-                            NAME_CLOUD_COMMUNICATION_TASK,
-                            STACK_SIZE_CLOUD_COMMUNICATION_TASK,
-                            NULL,
-                            PRIORITY_CLOUD_COMMUNICATION_TASK,
-                            &(sl_wifi_asset_tracking_resource.task_list.
-                              azure_cloud_communication_task_handler))) {
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_CLOUD_COMMUNICATION,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 azure_cloud_communication_task_handler))) {
     goto error;
   }
 
   /// Create recovery task
-  if (pdPASS != xTaskCreate(sl_wifi_asset_tracking_recovery_task,
-                            NAME_RECOVERY_TASK,
-                            STACK_SIZE_RECOVERY_TASK,
-                            NULL,
-                            PRIORITY_RECOVERY_TASK,
-                            &(sl_wifi_asset_tracking_resource.task_list.
-                              recovery_task_handler))) {
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_RECOVERY,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 recovery_task_handler))) {
     goto error;
   }
 
   /// Create LCD task
-  if (pdPASS != xTaskCreate(sl_wifi_asset_tracking_lcd_task,
-                            NAME_LCD_TASK,
-                            STACK_SIZE_LCD_TASK,
-                            NULL,
-                            PRIORITY_LCD_TASK,
-                            &(sl_wifi_asset_tracking_resource.task_list.
-                              lcd_task_handler))) {
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_LCD,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 lcd_task_handler))) {
+    goto error;
+  }
+
+  /// Create Wi-Fi link monitor task
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_LINK_MONITOR,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 link_monitor_task_handler))) {
+    goto error;
+  }
+
+  /// Create clock discipline task
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_CLOCK,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 clock_task_handler))) {
+    goto error;
+  }
+
+  /// Create metrics report task
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_METRICS,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 metrics_task_handler))) {
+    goto error;
+  }
+
+  /// Create deferred log task
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_LOG,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 log_task_handler))) {
+    goto error;
+  }
+
+  /// Create task supervisor
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_SUPERVISOR,
+                               &(sl_wifi_asset_tracking_resource.task_list.
+                                 supervisor_task_handler))) {
     goto error;
   }
 
@@ -203,19 +228,11 @@ sl_status_t sl_init_wifi_asset_tracking_resource()
   sl_wifi_asset_tracking_status.wifi_conn_status = SL_WIFI_NOT_CONNECTED;
   sl_wifi_asset_tracking_status.azure_cloud_conn_status =
     SL_CLOUD_NOT_CONNECTED;
-  sl_wifi_asset_tracking_status.recovery_progress_status = SL_RECOVERY_IDLE;
-  sl_wifi_asset_tracking_status.app_shutdown = false;
   sl_wifi_asset_tracking_status.lcd_init_status = true;
 
-  /// reset retry count
-  sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_retry_cnt = 0;
-  sl_wifi_asset_tracking_status.sensor_status.imu_sensor_retry_cnt = 0;
-  sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_retry_cnt = 0;
-
   /// Create sensor data queue resource
   sl_wifi_asset_tracking_resource.sensor_data_queue_handler =
-    xQueueCreate(MAX_SIZE_OF_SENSOR_DATA_QUEUE,
-                 sizeof(sl_wifi_asset_tracking_sensor_queue_data_t));
+    sl_static_create_queue(SL_STATIC_QUEUE_SENSOR_DATA);
 
   if (NULL == sl_wifi_asset_tracking_resource.sensor_data_queue_handler) {
     goto error;
@@ -223,24 +240,25 @@ sl_status_t sl_init_wifi_asset_tracking_resource()
 
   /// Create sensor data queue mutex
   sl_wifi_asset_tracking_resource.sensor_data_queue_mutex_handler =
-    (QueueHandle_t)xSemaphoreCreateMutex();
+    (QueueHandle_t)sl_static_create_semaphore(
+      SL_STATIC_SEMAPHORE_SENSOR_DATA_QUEUE);
 
   if (NULL == sl_wifi_asset_tracking_resource.sensor_data_queue_mutex_handler) {
     goto error;
   }
 
-  /// Create MQTT package data queue resource
-  sl_wifi_asset_tracking_resource.mqtt_package_queue_handler =
-    xQueueCreate(MAX_SIZE_OF_MQTT_PACKAGE_QUEUE,
-                 sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t));
-
-  if (NULL == sl_wifi_asset_tracking_resource.mqtt_package_queue_handler) {
+  /// Create MQTT package data queue per publish lane
+  if (SL_STATUS_OK != sl_publish_lane_init()) {
     goto error;
   }
 
+  /// Start publishing with a full token bucket
+  sl_rate_limit_init();
+
   /// Create MQTT package data queue mutex
   sl_wifi_asset_tracking_resource.mqtt_package_queue_mutex_handler =
-    (QueueHandle_t)xSemaphoreCreateMutex();
+    (QueueHandle_t)sl_static_create_semaphore(
+      SL_STATIC_SEMAPHORE_MQTT_PACKAGE_QUEUE);
 
   if (NULL
       == sl_wifi_asset_tracking_resource.mqtt_package_queue_mutex_handler) {
@@ -249,68 +267,109 @@ sl_status_t sl_init_wifi_asset_tracking_resource()
 
   /// Create LCD data queue resource
   sl_wifi_asset_tracking_resource.lcd_queue_handler =
-    xQueueCreate(MAX_SIZE_OF_LCD_DATA_QUEUE,
-                 sizeof(sl_wifi_asset_tracking_lcd_queue_data_t));
+    sl_static_create_queue(SL_STATIC_QUEUE_LCD_DATA);
 
   if (NULL == sl_wifi_asset_tracking_resource.lcd_queue_handler) {
     goto error;
   }
 
-  /// Create I2C call mutex
+  /// Create I2C call mutex, given once on creation
   sl_wifi_asset_tracking_resource.i2c_mutex_handler =
-    (SemaphoreHandle_t)xSemaphoreCreateBinary();
+    sl_static_create_semaphore(SL_STATIC_SEMAPHORE_I2C);
 
   if (NULL == sl_wifi_asset_tracking_resource.i2c_mutex_handler) {
     goto error;
   }
 
-  /// Need to give it as it is by default taken
-  xSemaphoreGive(sl_wifi_asset_tracking_resource.i2c_mutex_handler);
+  /// Create DNS cache mutex
+  sl_wifi_asset_tracking_resource.dns_cache_mutex_handler =
+    sl_static_create_semaphore(SL_STATIC_SEMAPHORE_DNS_CACHE);
+
+  if (NULL == sl_wifi_asset_tracking_resource.dns_cache_mutex_handler) {
+    goto error;
+  }
+
+  /// Restore host name resolutions persisted by previous boot
+  if (SL_STATUS_OK != sl_dns_cache_init()) {
+    printf(
+      "\r\nsl_init_wifi_asset_tracking_resource : DNS cache starts empty\r\n");
+  }
+
+  /// Tasks subscribe to status changes when they start
+  sl_event_bus_init();
+
+  /// Capture tasks sleep through the wake planner
+  sl_wake_planner_init();
+
+  /// Read reset reason of previous boot before any task checks in
+  sl_supervisor_init();
+
+#if DEMO_CONFIG_STACK_PROFILE
+  /// Continue stack peaks of previous boots, trace level runs the deepest
+  /// log paths
+  sl_stack_profile_init();
+  sl_log_set_level(SL_LOG_MODULE_COUNT, SL_LOG_LEVEL_TRACE);
+#endif /// < DEMO_CONFIG_STACK_PROFILE
+
+  /// Create SAS token cache mutex
+  sl_wifi_asset_tracking_resource.sas_token_mutex_handler =
+    sl_static_create_semaphore(SL_STATIC_SEMAPHORE_SAS_TOKEN);
+
+  if (NULL == sl_wifi_asset_tracking_resource.sas_token_mutex_handler) {
+    goto error;
+  }
+
+  /// Create clock discipline mutex
+  sl_wifi_asset_tracking_resource.clock_mutex_handler =
+    sl_static_create_semaphore(SL_STATIC_SEMAPHORE_CLOCK);
+
+  if (NULL == sl_wifi_asset_tracking_resource.clock_mutex_handler) {
+    goto error;
+  }
+
+  /// Create Wi-Fi scan mutex
+  sl_wifi_asset_tracking_resource.wifi_scan_mutex_handler =
+    sl_static_create_semaphore(SL_STATIC_SEMAPHORE_WIFI_SCAN);
+
+  if (NULL == sl_wifi_asset_tracking_resource.wifi_scan_mutex_handler) {
+    goto error;
+  }
+
+  /// Create timer to refresh SAS token signature before it expires
+  sl_wifi_asset_tracking_resource.sas_token_refresh_timer =
+    sl_static_create_timer(SL_STATIC_TIMER_SAS_TOKEN_REFRESH);
+
+  if (NULL == sl_wifi_asset_tracking_resource.sas_token_refresh_timer) {
+    goto error;
+  }
 
-  /// Create recovery status mutex
-  sl_wifi_asset_tracking_resource.recovery_status_mutex_handler =
-    (QueueHandle_t)xSemaphoreCreateMutex();
+  /// Create timer to send MQTT PINGREQ while no telemetry is published
+  sl_wifi_asset_tracking_resource.mqtt_keep_alive_timer =
+    sl_static_create_timer(SL_STATIC_TIMER_MQTT_KEEP_ALIVE);
 
-  if (NULL == sl_wifi_asset_tracking_resource.recovery_status_mutex_handler) {
+  if (NULL == sl_wifi_asset_tracking_resource.mqtt_keep_alive_timer) {
     goto error;
   }
 
   /// Create timer for temperature_rh_sensor task
-  sl_wifi_asset_tracking_resource.temperature_rh_sensor_timer = xTimerCreate(
-    NAME_TEMPERATURE_RH_SENSOR_TIMER,
-    (
-      pdMS_TO_TICKS(
-        PERIOD_OF_TEMPERATURE_RH_SENSOR_TIMER) * TIMER_CLOCK_OFFSET),
-    pdFALSE,
-    NULL,
-    on_temperature_rh_sensor_timer_callback);
+  sl_wifi_asset_tracking_resource.temperature_rh_sensor_timer =
+    sl_static_create_timer(SL_STATIC_TIMER_TEMPERATURE_RH_SENSOR);
 
   if (NULL == sl_wifi_asset_tracking_resource.temperature_rh_sensor_timer) {
     goto error;
   }
 
   /// Create timer for IMU sensor task
-  sl_wifi_asset_tracking_resource.imu_sensor_timer = xTimerCreate(
-    NAME_IMU_SENSOR_TIMER,
-    (pdMS_TO_TICKS(
-       PERIOD_OF_IMU_SENSOR_TIMER) * TIMER_CLOCK_OFFSET),
-    pdFALSE,
-    NULL,
-    on_imu_sensor_timer_callback);
+  sl_wifi_asset_tracking_resource.imu_sensor_timer =
+    sl_static_create_timer(SL_STATIC_TIMER_IMU_SENSOR);
 
   if (NULL == sl_wifi_asset_tracking_resource.imu_sensor_timer) {
     goto error;
   }
 
   /// Create timer for GNSS sensor task
-  sl_wifi_asset_tracking_resource.gnss_sensor_timer = xTimerCreate(
-    NAME_GNSS_RECEIVER_TIMER,
-    (
-      pdMS_TO_TICKS(
-        PERIOD_OF_GNSS_RECEIVER_TIMER) * TIMER_CLOCK_OFFSET),
-    pdFALSE,
-    NULL,
-    on_gnss_sensor_timer_callback);
+  sl_wifi_asset_tracking_resource.gnss_sensor_timer =
+    sl_static_create_timer(SL_STATIC_TIMER_GNSS_RECEIVER);
 
   if (NULL == sl_wifi_asset_tracking_resource.gnss_sensor_timer) {
     goto error;
@@ -326,417 +385,29 @@ sl_status_t sl_init_wifi_asset_tracking_resource()
  *****************************************************************************/
 void sl_wifi_asset_tracking_recovery_task()
 {
-  while (1) {
-    /// Sensor related recovery - start
-
-    /// When all sensor are not probed simply suspend the recovery task as this happens when application is just started.
-    /// This condition is true only once in whole application life cycle.
-    if ((SL_SENSOR_NOT_PROBED
-         == sl_wifi_asset_tracking_status.sensor_status.
-         temp_rh_sensor_probe_status)
-        && (SL_SENSOR_NOT_PROBED
-            == sl_wifi_asset_tracking_status.sensor_status.
-            imu_sensor_probe_status)
-        && (SL_SENSOR_NOT_PROBED
-            == sl_wifi_asset_tracking_status.sensor_status.
-            gnss_receiver_probe_status)) {
-      printf(
-        "\r\nrecovery_task : suspend recovery task as all sensors are not in probed state\r\n");
-      vTaskSuspend(
-        sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-      continue;
-    }
-
-    /// When probing of all the sensor is failed
-    if ((SL_SENSOR_SHUTDOWN
-         == sl_wifi_asset_tracking_status.sensor_status.
-         temp_rh_sensor_probe_status)
-        && (SL_SENSOR_SHUTDOWN
-            == sl_wifi_asset_tracking_status.sensor_status.
-            imu_sensor_probe_status)
-        && (SL_SENSOR_SHUTDOWN
-            == sl_wifi_asset_tracking_status.sensor_status.
-            gnss_receiver_probe_status)) {
-      printf(
-        "\r\nrecovery_task : None of sensors got probed/connected, so closing application.\r\n");
-
-      sl_wifi_asset_tracking_lcd_print(INDEX_SENSOR_SHUTDOWN);
-
-      /// gracefully shutdown the application
-      sl_stop_wifi_asset_tracking_application();
-      break;
-    }
-
-    /// When probing of si7021 sensor is failed
-    if (SL_SENSOR_PROBE_FAILED
-        == sl_wifi_asset_tracking_status.sensor_status.
-        temp_rh_sensor_probe_status) {
-      printf(
-        "\r\nrecovery_task : temperature and RH sensor is not probed/disconnected, so deleting temperature and RH sensor task.\r\n");
-
-      sl_wifi_asset_tracking_lcd_print(INDEX_SI7021_NOT_CONNECTED);
-
-      vTaskDelete(
-        sl_wifi_asset_tracking_resource.task_list.temp_rh_sensor_task_handler);
-      sl_wifi_asset_tracking_resource.task_list.temp_rh_sensor_task_handler =
-        NULL;
-      sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_probe_status =
-        SL_SENSOR_SHUTDOWN;
-      continue;
-    }
-
-    /// When si7021 sensor is disconnected in-between running application
-    if (SL_SENSOR_DISCONNECTED
-        == sl_wifi_asset_tracking_status.sensor_status.
-        temp_rh_sensor_probe_status) {
-      printf(
-        "\r\nrecovery_task : Recreating temperature and RH sensor task as temperature and RH sensor got disconnected\r\n");
-
-      vTaskDelete(
-        sl_get_wifi_asset_tracking_resource()->task_list.temp_rh_sensor_task_handler);
-      sl_wifi_asset_tracking_resource.task_list.temp_rh_sensor_task_handler =
-        NULL;
-
-      /// Recreate si7021 sensor data capture task
-      if (pdPASS != xTaskCreate(sl_capture_temperature_rh_sensor_data_task,
-                                NAME_TEMPERATURE_RH_SENSOR_TASK,
-                                STACK_SIZE_TEMPERATURE_RH_SENSOR_TASK,
-                                NULL,
-                                PRIORITY_TEMPERATURE_RH_SENSOR_TASK,
-                                &(sl_wifi_asset_tracking_resource.task_list.
-                                  temp_rh_sensor_task_handler))) {
-        sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_retry_cnt =
-          0;
-        sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_probe_status
-          = SL_SENSOR_SHUTDOWN;
-
-        vTaskSuspend(
-          sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-        continue;
-      }
-
-      ++sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_retry_cnt;
-      sl_wifi_asset_tracking_lcd_print(INDEX_SI7021_RECONNECTING);
-
-      if (SENSOR_MAX_RETRY_COUNT
-          == sl_wifi_asset_tracking_status.sensor_status.
-          temp_rh_sensor_retry_cnt) {
-        sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_retry_cnt =
-          0;
-        sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_probe_status
-          = SL_SENSOR_PROBE_FAILED;
-        continue;
-      } else {
-        sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_probe_status
-          = SL_SENSOR_RECONNECTED;
-      }
-
-      vTaskSuspend(
-        sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-      continue;
-    }
-
-    /// When probing of bmi270 sensor is failed
-    if (SL_SENSOR_PROBE_FAILED
-        == sl_wifi_asset_tracking_status.sensor_status.imu_sensor_probe_status)
-    {
-      printf(
-        "\r\nrecovery_task : IMU sensor is not probed/disconnected, so deleting IMU sensor task.\r\n");
-
-      sl_wifi_asset_tracking_lcd_print(INDEX_BMI270_NOT_CONNECTED);
-
-      vTaskDelete(
-        sl_wifi_asset_tracking_resource.task_list.imu_sensor_task_handler);
-      sl_wifi_asset_tracking_resource.task_list.imu_sensor_task_handler = NULL;
-      sl_wifi_asset_tracking_status.sensor_status.imu_sensor_probe_status =
-        SL_SENSOR_SHUTDOWN;
-
-      continue;
-    }
-
-    /// When bmi270 sensor is disconnected in-between running application
-    if (SL_SENSOR_DISCONNECTED
-        == sl_wifi_asset_tracking_status.sensor_status.imu_sensor_probe_status)
-    {
-      printf(
-        "\r\nrecovery_task : Recreating IMU sensor task as IMU sensor got disconnected\r\n");
-
-      vTaskDelete(
-        sl_get_wifi_asset_tracking_resource()->task_list.imu_sensor_task_handler);
-      sl_wifi_asset_tracking_resource.task_list.imu_sensor_task_handler = NULL;
-
-      /// Recreate bmi270 sensor data capture task
-      if (pdPASS != xTaskCreate(sl_capture_imu_sensor_data_task,
-                                NAME_IMU_SENSOR_TASK,
-                                STACK_SIZE_IMU_SENSOR_TASK,
-                                NULL,
-                                PRIORITY_IMU_SENSOR_TASK,
-                                &(sl_wifi_asset_tracking_resource.task_list.
-                                  imu_sensor_task_handler))) {
-        sl_wifi_asset_tracking_status.sensor_status.imu_sensor_retry_cnt = 0;
-        sl_wifi_asset_tracking_status.sensor_status.imu_sensor_probe_status =
-          SL_SENSOR_SHUTDOWN;
-
-        vTaskSuspend(
-          sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-        continue;
-      }
-
-      ++sl_wifi_asset_tracking_status.sensor_status.imu_sensor_retry_cnt;
-      sl_wifi_asset_tracking_lcd_print(INDEX_BMI270_RECONNECTING);
-
-      if (SENSOR_MAX_RETRY_COUNT
-          == sl_wifi_asset_tracking_status.sensor_status.imu_sensor_retry_cnt) {
-        sl_wifi_asset_tracking_status.sensor_status.imu_sensor_retry_cnt = 0;
-        sl_wifi_asset_tracking_status.sensor_status.imu_sensor_probe_status =
-          SL_SENSOR_PROBE_FAILED;
-        continue;
-      } else {
-        sl_wifi_asset_tracking_status.sensor_status.imu_sensor_probe_status =
-          SL_SENSOR_RECONNECTED;
-      }
-
-      vTaskSuspend(
-        sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-      continue;
-    }
-
-    /// When probing of gnss receiver is failed
-    if (SL_SENSOR_PROBE_FAILED
-        == sl_wifi_asset_tracking_status.sensor_status.
-        gnss_receiver_probe_status) {
-      printf(
-        "\r\nrecovery_task : GNSS receiver is not probed/disconnected, so deleting GNSS receiver task.\r\n");
-
-      sl_wifi_asset_tracking_lcd_print(INDEX_MAX_M10S_NOT_CONNECTED);
-
-      vTaskDelete(
-        sl_wifi_asset_tracking_resource.task_list.gnss_receiver_task_handler);
-      sl_wifi_asset_tracking_resource.task_list.gnss_receiver_task_handler =
-        NULL;
-      sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_probe_status =
-        SL_SENSOR_SHUTDOWN;
-
-      continue;
-    }
+  uint32_t wait_ms;
+
+  /// Status changes of the recovered subsystems, collected as event bits so
+  /// none is lost while an attempt is in progress
+  sl_event_bus_subscribe(SL_STATIC_TASK_RECOVERY,
+                         SL_EVENT_BIT(SL_EVENT_SENSOR_UP)
+                         | SL_EVENT_BIT(SL_EVENT_SENSOR_LOST)
+                         | SL_EVENT_BIT(SL_EVENT_WIFI_UP)
+                         | SL_EVENT_BIT(SL_EVENT_WIFI_DOWN)
+                         | SL_EVENT_BIT(SL_EVENT_CLOUD_UP)
+                         | SL_EVENT_BIT(SL_EVENT_CLOUD_DOWN),
+                         SL_EVENT_DELIVERY_BITS);
 
-    /// When gnss receiver sensor is disconnected in-between running application
-    if (SL_SENSOR_DISCONNECTED
-        == sl_wifi_asset_tracking_status.sensor_status.
-        gnss_receiver_probe_status) {
-      printf(
-        "\r\nrecovery_task : Recreating GNSS receiver task as GNSS receiver got disconnected\r\n");
-
-      vTaskDelete(
-        sl_get_wifi_asset_tracking_resource()->task_list.gnss_receiver_task_handler);
-      sl_wifi_asset_tracking_resource.task_list.gnss_receiver_task_handler =
-        NULL;
-
-      /// Recreate GNSS receiver data capture task
-      if (pdPASS != xTaskCreate(sl_capture_gnss_receiver_data_task,
-                                NAME_GNSS_RECEIVER_TASK,
-                                STACK_SIZE_GNSS_RECEIVER_TASK,
-                                NULL,
-                                PRIORITY_GNSS_RECEIVER_TASK,
-                                &(sl_wifi_asset_tracking_resource.task_list.
-                                  gnss_receiver_task_handler))) {
-        sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_retry_cnt = 0;
-        sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_probe_status =
-          SL_SENSOR_SHUTDOWN;
-
-        vTaskSuspend(
-          sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-        continue;
-      }
-
-      ++sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_retry_cnt;
-      sl_wifi_asset_tracking_lcd_print(INDEX_MAX_M10S_RECONNECTING);
-
-      if (SENSOR_MAX_RETRY_COUNT
-          == sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_retry_cnt)
-      {
-        sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_retry_cnt = 0;
-        sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_probe_status =
-          SL_SENSOR_PROBE_FAILED;
-        continue;
-      } else {
-        sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_probe_status =
-          SL_SENSOR_RECONNECTED;
-      }
-
-      vTaskSuspend(
-        sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-      continue;
-    }
-
-    /// Sensor related recovery - end
-
-    /// Wi-Fi related recovery - start
-
-    /// Initialization of Wi-Fi connection is failed
-    if (SL_WIFI_SHUTDOWN == sl_wifi_asset_tracking_status.wifi_conn_status) {
-      printf(
-        "\r\nrecovery_task : deleting wi-fi capture task and closing application due to wi-fi connection failure.\r\n");
-
-      sl_wifi_asset_tracking_lcd_print(INDEX_WIFI_SHUTDOWN);
-
-      vTaskDelete(
-        sl_wifi_asset_tracking_resource.task_list.wifi_data_capture_task_handler);
-      sl_wifi_asset_tracking_resource.task_list.wifi_data_capture_task_handler =
-        NULL;
-
-      /// gracefully shutdown the application
-      sl_stop_wifi_asset_tracking_application();
-      break;
-    }
-
-    /// When Wi-Fi connection is disconnected in-between running application
-    if (SL_WIFI_DISCONNECTED
-        == sl_wifi_asset_tracking_status.wifi_conn_status) {
-      printf("\r\nrecovery_task : retrying wi-fi connection.\r\n");
-
-      sl_wifi_asset_tracking_status.azure_cloud_conn_status =
-        SL_CLOUD_DISCONNECTED;
-
-      /// Retry to connect WiFi connection before azure cloud communication
-      if (SL_STATUS_OK == sl_retry_wifi_connection(false)) {
-        sl_wifi_asset_tracking_status.wifi_conn_status = SL_WIFI_CONNECTED;
-
-        sl_wifi_asset_tracking_lcd_print(INDEX_WIFI_CONNECTED);
-
-        /// Retry to connect azure cloud communication
-        if (SL_STATUS_OK == sl_retry_azure_cloud_connection()) {
-          sl_wifi_asset_tracking_status.azure_cloud_conn_status =
-            SL_CLOUD_CONNECTED;
-
-          sl_wifi_asset_tracking_lcd_print(INDEX_AZURE_CLOUD_CONNECTED);
-
-          /// Acquire semaphore to update the status of recovery task
-          if (pdTRUE
-              == (xSemaphoreTake(sl_wifi_asset_tracking_resource.
-                                 recovery_status_mutex_handler,
-                                 portMAX_DELAY))) {
-            sl_wifi_asset_tracking_status.recovery_progress_status =
-              SL_RECOVERY_IDLE;
-            xSemaphoreGive(
-              sl_wifi_asset_tracking_resource.recovery_status_mutex_handler);
-          }
-
-          vTaskSuspend(
-            sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-          continue;
-        } else {
-          printf(
-            "\r\nrecovery_task : closing application due to Azure IoT Hub connection failure.\r\n");
-
-          sl_wifi_asset_tracking_lcd_print(INDEX_CLOUD_SHUTDOWN);
-
-          sl_stop_wifi_asset_tracking_application();
-          break;
-        }
-      } else {
-        printf(
-          "\r\nrecovery_task : closing application due to wi-fi connection failure\r\n");
-
-        sl_wifi_asset_tracking_lcd_print(INDEX_WIFI_SHUTDOWN);
-
-        sl_stop_wifi_asset_tracking_application();
-        break;
-      }
-    }
-
-    /// Wi-Fi related recovery - end
-
-    /// Azure cloud related recovery - start
-
-    /// Initialization of azure cloud connection is failed
-    if (SL_CLOUD_SHUTDOWN
-        == sl_wifi_asset_tracking_status.azure_cloud_conn_status) {
-      printf(
-        "\r\nrecovery_task : deleting Azure communication task and closing application due to Azure IoT Hub connection failure.\r\n");
-
-      sl_wifi_asset_tracking_lcd_print(INDEX_CLOUD_SHUTDOWN);
-
-      vTaskDelete(
-        sl_wifi_asset_tracking_resource.task_list.azure_cloud_communication_task_handler);
-      sl_wifi_asset_tracking_resource.task_list.
-      azure_cloud_communication_task_handler = NULL;
-
-      /// gracefully shutdown the application
-      sl_stop_wifi_asset_tracking_application();
-      break;
-    }
-
-    /// When cloud connection is disconnected in-between running application
-    if (SL_CLOUD_DISCONNECTED
-        == sl_wifi_asset_tracking_status.azure_cloud_conn_status) {
-      int32_t rssi = 0;
-      sl_status_t status;
-
-      printf("\r\nrecovery_task : retrying Azure IoT Hub connection.\r\n");
-
-      /// Check whether rssi is getting
-      status = sl_get_wifi_rssi(&rssi);
-
-      if (SL_STATUS_OK != status) {
-        printf(
-          "\r\nrecovery_task : wi-fi also got disconnected, trigger wi-fi recovery along with Azure IoT Hub recovery.\r\n");
-        sl_wifi_asset_tracking_status.wifi_conn_status = SL_WIFI_DISCONNECTED;
-        continue;
-      }
-
-      /// Retry to connect azure cloud communication
-      if (SL_STATUS_OK == sl_retry_azure_cloud_connection()) {
-        sl_wifi_asset_tracking_status.azure_cloud_conn_status =
-          SL_CLOUD_CONNECTED;
-
-        sl_wifi_asset_tracking_lcd_print(INDEX_AZURE_CLOUD_CONNECTED);
-
-        /// Acquire semaphore to update the status of recovery task
-        if (pdTRUE
-            == (xSemaphoreTake(sl_wifi_asset_tracking_resource.
-                               recovery_status_mutex_handler,
-                               portMAX_DELAY))) {
-          sl_wifi_asset_tracking_status.recovery_progress_status =
-            SL_RECOVERY_IDLE;
-          xSemaphoreGive(
-            sl_wifi_asset_tracking_resource.recovery_status_mutex_handler);
-        }
-
-        vTaskSuspend(
-          sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-        continue;
-      } else {
-        if (SL_WIFI_DISCONNECTED
-            == sl_wifi_asset_tracking_status.wifi_conn_status) {
-          printf(
-            "\r\nrecovery_task : closing application due to wi-fi connection failure.\r\n");
-
-          sl_wifi_asset_tracking_lcd_print(INDEX_WIFI_SHUTDOWN);
-        } else {
-          printf(
-            "\r\nrecovery_task : closing application due to Azure IoT Hub connection failure.\r\n");
-
-          sl_wifi_asset_tracking_lcd_print(INDEX_CLOUD_SHUTDOWN);
-        }
-        sl_stop_wifi_asset_tracking_application();
-        break;
-      }
+  while (1) {
+    /// Due attempts run here, the wait ends at the next scheduled one or at
+    /// the next status change
+    wait_ms = sl_recovery_run();
+
+    if (RECOVERY_WAIT_FOREVER == wait_ms) {
+      sl_event_bus_wait(portMAX_DELAY);
+    } else {
+      sl_event_bus_wait(pdMS_TO_TICKS(wait_ms) * TIMER_CLOCK_OFFSET);
     }
-
-    /// Azure cloud related recovery - end
-
-    /// Suspend recovery task - if nothing to do
-    vTaskSuspend(sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-  }
-
-  printf(
-    "\r\nrecovery_task : wi-fi asset tracking application is gracefully shutdown\r\n");
-
-  /// Delete the recovery task
-  if (sl_wifi_asset_tracking_resource.task_list.recovery_task_handler != NULL) {
-    vTaskDelete(sl_wifi_asset_tracking_resource.task_list.recovery_task_handler);
-    sl_wifi_asset_tracking_resource.task_list.recovery_task_handler = NULL;
   }
 }
 
@@ -766,6 +437,18 @@ sl_status_t sl_deinit_wifi_asset_tracking_resource()
     sl_wifi_asset_tracking_resource.gnss_sensor_timer = NULL;
   }
 
+  /// Delete the SAS token refresh timer
+  if (sl_wifi_asset_tracking_resource.sas_token_refresh_timer != NULL) {
+    xTimerDelete(sl_wifi_asset_tracking_resource.sas_token_refresh_timer, 0);
+    sl_wifi_asset_tracking_resource.sas_token_refresh_timer = NULL;
+  }
+
+  /// Delete the MQTT keep-alive timer
+  if (sl_wifi_asset_tracking_resource.mqtt_keep_alive_timer != NULL) {
+    xTimerDelete(sl_wifi_asset_tracking_resource.mqtt_keep_alive_timer, 0);
+    sl_wifi_asset_tracking_resource.mqtt_keep_alive_timer = NULL;
+  }
+
   /// Delete the sensor data queue
   if (sl_wifi_asset_tracking_resource.sensor_data_queue_handler != NULL) {
     vQueueDelete(sl_wifi_asset_tracking_resource.sensor_data_queue_handler);
@@ -779,11 +462,8 @@ sl_status_t sl_deinit_wifi_asset_tracking_resource()
     sl_wifi_asset_tracking_resource.sensor_data_queue_mutex_handler = NULL;
   }
 
-  /// Delete the MQTT package data queue
-  if (sl_wifi_asset_tracking_resource.mqtt_package_queue_handler != NULL) {
-    vQueueDelete(sl_wifi_asset_tracking_resource.mqtt_package_queue_handler);
-    sl_wifi_asset_tracking_resource.mqtt_package_queue_handler = NULL;
-  }
+  /// Delete the MQTT package data queue of every publish lane
+  sl_publish_lane_deinit();
 
   /// Delete the LCD data queue
   if (sl_wifi_asset_tracking_resource.lcd_queue_handler != NULL) {
@@ -805,13 +485,39 @@ sl_status_t sl_deinit_wifi_asset_tracking_resource()
     sl_wifi_asset_tracking_resource.i2c_mutex_handler = NULL;
   }
 
-  /// Delete recovery status mutex
-  if (sl_wifi_asset_tracking_resource.recovery_status_mutex_handler != NULL) {
-    vSemaphoreDelete(
-      sl_wifi_asset_tracking_resource.recovery_status_mutex_handler);
-    sl_wifi_asset_tracking_resource.recovery_status_mutex_handler = NULL;
+  /// Delete DNS cache mutex
+  if (sl_wifi_asset_tracking_resource.dns_cache_mutex_handler != NULL) {
+    vSemaphoreDelete(sl_wifi_asset_tracking_resource.dns_cache_mutex_handler);
+    sl_wifi_asset_tracking_resource.dns_cache_mutex_handler = NULL;
+  }
+
+  /// Delete SAS token cache mutex
+  if (sl_wifi_asset_tracking_resource.sas_token_mutex_handler != NULL) {
+    vSemaphoreDelete(sl_wifi_asset_tracking_resource.sas_token_mutex_handler);
+    sl_wifi_asset_tracking_resource.sas_token_mutex_handler = NULL;
+  }
+
+  /// Delete clock discipline mutex
+  if (sl_wifi_asset_tracking_resource.clock_mutex_handler != NULL) {
+    vSemaphoreDelete(sl_wifi_asset_tracking_resource.clock_mutex_handler);
+    sl_wifi_asset_tracking_resource.clock_mutex_handler = NULL;
   }
 
+  /// Delete Wi-Fi scan mutex
+  if (sl_wifi_asset_tracking_resource.wifi_scan_mutex_handler != NULL) {
+    vSemaphoreDelete(sl_wifi_asset_tracking_resource.wifi_scan_mutex_handler);
+    sl_wifi_asset_tracking_resource.wifi_scan_mutex_handler = NULL;
+  }
+
+  /// Delete the task supervisor first, deleted tasks would look stuck
+  if (sl_wifi_asset_tracking_resource.task_list.supervisor_task_handler
+      != NULL) {
+    vTaskDelete(
+      sl_wifi_asset_tracking_resource.task_list.supervisor_task_handler);
+    sl_wifi_asset_tracking_resource.task_list.supervisor_task_handler = NULL;
+  }
+  sl_supervisor_deinit();
+
   /// Delete the temperature and RH sensor data capture task
   if (sl_wifi_asset_tracking_resource.task_list.temp_rh_sensor_task_handler
       != NULL) {
@@ -864,6 +570,32 @@ sl_status_t sl_deinit_wifi_asset_tracking_resource()
     azure_cloud_communication_task_handler = NULL;
   }
 
+  /// Delete the Wi-Fi link monitor task
+  if (sl_wifi_asset_tracking_resource.task_list.link_monitor_task_handler
+      != NULL) {
+    vTaskDelete(
+      sl_wifi_asset_tracking_resource.task_list.link_monitor_task_handler);
+    sl_wifi_asset_tracking_resource.task_list.link_monitor_task_handler = NULL;
+  }
+
+  /// Delete the clock discipline task
+  if (sl_wifi_asset_tracking_resource.task_list.clock_task_handler != NULL) {
+    vTaskDelete(sl_wifi_asset_tracking_resource.task_list.clock_task_handler);
+    sl_wifi_asset_tracking_resource.task_list.clock_task_handler = NULL;
+  }
+
+  /// Delete the metrics report task
+  if (sl_wifi_asset_tracking_resource.task_list.metrics_task_handler != NULL) {
+    vTaskDelete(sl_wifi_asset_tracking_resource.task_list.metrics_task_handler);
+    sl_wifi_asset_tracking_resource.task_list.metrics_task_handler = NULL;
+  }
+
+  /// Delete the deferred log task
+  if (sl_wifi_asset_tracking_resource.task_list.log_task_handler != NULL) {
+    vTaskDelete(sl_wifi_asset_tracking_resource.task_list.log_task_handler);
+    sl_wifi_asset_tracking_resource.task_list.log_task_handler = NULL;
+  }
+
   /// Delete the LCD task
   if ((sl_get_wifi_asset_tracking_status()->lcd_init_status)
       && (sl_wifi_asset_tracking_resource.task_list.lcd_task_handler != NULL)) {
@@ -877,20 +609,6 @@ sl_status_t sl_deinit_wifi_asset_tracking_resource()
   return status;
 }
 
-/******************************************************************************
- *  Function for de-initialize the entire application
- *****************************************************************************/
-void sl_stop_wifi_asset_tracking_application()
-{
-  sl_disconnect_azure_iot_hub();
-
-  sl_deinit_wifi_connection();
-
-  sl_wifi_asset_tracking_sensors_deinit();
-
-  sl_deinit_wifi_asset_tracking_resource();
-}
-
 /******************************************************************************
  *  Getter function for wi-fi asset tracking resource object
  *****************************************************************************/
@@ -914,3 +632,114 @@ char ** sl_get_wifi_asset_tracking_lcd_string()
 {
   return sl_wifi_asset_tracking_lcd_strings;
 }
+
+/******************************************************************************
+ *  Setter function for wi-fi connection status
+ *****************************************************************************/
+void sl_wifi_asset_tracking_set_wifi_status(uint8_t status)
+{
+  uint8_t previous;
+
+  taskENTER_CRITICAL();
+  previous = sl_wifi_asset_tracking_status.wifi_conn_status;
+  sl_wifi_asset_tracking_status.wifi_conn_status = status;
+  taskEXIT_CRITICAL();
+
+  if (previous == status) {
+    return;
+  }
+
+  switch (status) {
+    case SL_WIFI_CONNECTED:
+      sl_event_bus_publish(SL_EVENT_WIFI_UP);
+      break;
+    case SL_WIFI_DISCONNECTED:
+      sl_event_bus_publish(SL_EVENT_WIFI_DOWN);
+      break;
+    case SL_WIFI_SHUTDOWN:
+      sl_event_bus_publish(SL_EVENT_WIFI_SHUTDOWN);
+      break;
+    default:
+      break;
+  }
+}
+
+/******************************************************************************
+ *  Setter function for cloud connection status
+ *****************************************************************************/
+void sl_wifi_asset_tracking_set_cloud_status(uint8_t status)
+{
+  uint8_t previous;
+
+  taskENTER_CRITICAL();
+  previous = sl_wifi_asset_tracking_status.azure_cloud_conn_status;
+  sl_wifi_asset_tracking_status.azure_cloud_conn_status = status;
+  taskEXIT_CRITICAL();
+
+  if (previous == status) {
+    return;
+  }
+
+  switch (status) {
+    case SL_CLOUD_CONNECTED:
+      sl_event_bus_publish(SL_EVENT_CLOUD_UP);
+      break;
+    case SL_CLOUD_DISCONNECTED:
+      sl_event_bus_publish(SL_EVENT_CLOUD_DOWN);
+      break;
+    case SL_CLOUD_SHUTDOWN:
+      sl_event_bus_publish(SL_EVENT_CLOUD_SHUTDOWN);
+      break;
+    default:
+      break;
+  }
+}
+
+/******************************************************************************
+ *  Setter function for sensor probe status
+ *****************************************************************************/
+void sl_wifi_asset_tracking_set_sensor_status(
+  sl_wifi_asset_tracking_sensor_queue_data_type_e sensor,
+  uint8_t status)
+{
+  uint8_t *probe_status;
+  uint8_t previous;
+
+  switch (sensor) {
+    case SL_TEMP_RH_SENSOR:
+      probe_status =
+        &sl_wifi_asset_tracking_status.sensor_status.temp_rh_sensor_probe_status;
+      break;
+    case SL_IMU_SENSOR:
+      probe_status =
+        &sl_wifi_asset_tracking_status.sensor_status.imu_sensor_probe_status;
+      break;
+    case SL_GNSS_RECEIVER:
+      probe_status =
+        &sl_wifi_asset_tracking_status.sensor_status.gnss_receiver_probe_status;
+      break;
+    default:
+      return;
+  }
+
+  taskENTER_CRITICAL();
+  previous = *probe_status;
+  *probe_status = status;
+  taskEXIT_CRITICAL();
+
+  if (previous == status) {
+    return;
+  }
+
+  switch (status) {
+    case SL_SENSOR_CONNECTED:
+      sl_event_bus_publish(SL_EVENT_SENSOR_UP);
+      break;
+    case SL_SENSOR_PROBE_FAILED:
+    case SL_SENSOR_DISCONNECTED:
+      sl_event_bus_publish(SL_EVENT_SENSOR_LOST);
+      break;
+    default:
+      break;
+  }
+}
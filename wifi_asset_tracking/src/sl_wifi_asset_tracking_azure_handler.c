@@ -15,6 +15,7 @@
  *
  ******************************************************************************/
 #include <stdio.h>
+#include <string.h>
 #include <sl_net.h>
 #include <sl_net_si91x.h>
 #include <sl_net_dns.h>
@@ -24,7 +25,6 @@
 #include <errno.h>
 #include <socket.h>
 #include <sl_si91x_core_utilities.h>
-#include <sl_si91x_hmac.h>
 #include <sl_wifi_asset_tracking_demo_config.h>
 #include <sl_wifi_asset_tracking_azure_handler.h>
 #include <sl_wifi_asset_tracking_app.h>
@@ -47,16 +47,96 @@ extern sl_status_t sl_si91x_delete_credential(sl_net_credential_id_t id,
  */
 static uint8_t sl_mqtt_msg_buffer[DEMO_CONFIG_NETWORK_BUFFER_SIZE];
 
+/**
+ * @brief Set by the keep-alive timer, MQTT connection needs processing.
+ */
+static volatile bool sl_mqtt_is_keep_alive_due;
+
+/**
+ * @brief Transport backend callbacks on SiWx91x TLS socket.
+ */
+static sl_status_t sl_si91x_tls_transport_connect(void *context,
+                                                  const char *host_name,
+                                                  uint16_t port);
+static int32_t sl_si91x_tls_transport_send(void *context,
+                                           const void *buffer,
+                                           size_t bytes_to_send);
+static int32_t sl_si91x_tls_transport_recv(void *context,
+                                           void *buffer,
+                                           size_t bytes_to_recv);
+static void sl_si91x_tls_transport_disconnect(void *context);
+
+/**************************************************************************/ /**
+ * @brief Function will create a tele-metry property bag with Content-Type and
+ * given Content-Encoding.
+ * @param[out] property_bag : property bag.
+ * @param[in] property_buff : buffer backing the property bag.
+ * @param[in] property_buff_size : size of property_buff.
+ * @param[in] content_encoding : url-encoded Content-Encoding value.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on failure
+ ******************************************************************************/
+static sl_status_t sl_create_message_property_bag(
+  AzureIoTMessageProperties_t *property_bag,
+  uint8_t *property_buff,
+  uint32_t property_buff_size,
+  const char *content_encoding);
+
+/**************************************************************************/ /**
+ * @brief Function to process the MQTT connection, sends PINGREQ when it was
+ * idle for the keep-alive and reads PINGRESP. Starts Azure IoT Hub recovery
+ * when the broker stopped answering.
+ ******************************************************************************/
+static void sl_process_mqtt_keep_alive(void);
+
+/**************************************************************************/ /**
+ * @brief Function to check whether the IoT Hub closed the connection while
+ * the Wi-Fi link stayed up, which is how it throttles MQTT clients.
+ * @return true when the server closed the connection.
+ ******************************************************************************/
+static bool sl_is_closed_by_iot_hub(void);
+
+/**
+ * @brief Default transport backend, used unless another one is registered.
+ */
+static const sl_transport_interface_t sl_si91x_tls_transport = {
+  .connect = sl_si91x_tls_transport_connect,
+  .send = sl_si91x_tls_transport_send,
+  .recv = sl_si91x_tls_transport_recv,
+  .disconnect = sl_si91x_tls_transport_disconnect,
+  .context = NULL,
+};
+
 /******************************************************************************
  *  Callback function to start cloud communication from SiWG917 device.
  *****************************************************************************/
 void sl_azure_cloud_communication_task()
 {
   sl_wifi_asset_tracking_mqtt_package_queue_data_t mqtt_data_queue_reading =
-  { 0, { 0 } };
+  { 0, { 0 }, 0, 0 };
+  sl_publish_lane_e publish_lane = SL_PUBLISH_LANE_CRITICAL;
+  uint32_t rate_limit_wait = 0;
+  AzureIoTMessageProperties_t *property_bag;
+  const uint8_t *payload;
+  uint32_t payload_len;
+  TickType_t publish_tick;
+#if DEMO_CONFIG_TELEMETRY_COMPRESSION
+  uint8_t compressed_buffer[COMPRESS_BOUND(MAX_JSON_MESSAGE_SIZE)];
+  uint32_t compressed_len;
+#endif /// < DEMO_CONFIG_TELEMETRY_COMPRESSION
+#if DEMO_CONFIG_POWER_SAVE
+  uint32_t burst_delay;
+#endif /// < DEMO_CONFIG_POWER_SAVE
 
   AzureIoTResult_t msg_result;
-  int32_t rssi;
+
+  /// Connection changes wake the task like a queued message, the status is
+  /// read again after every wake-up
+  sl_event_bus_subscribe(SL_STATIC_TASK_CLOUD_COMMUNICATION,
+                         SL_EVENT_BIT(SL_EVENT_WIFI_UP)
+                         | SL_EVENT_BIT(SL_EVENT_CLOUD_UP),
+                         SL_EVENT_DELIVERY_WAKE);
 
   /// This loop is used to establish connection with Azure cloud after wi-fi connection is successful
   while (1) {
@@ -67,161 +147,179 @@ void sl_azure_cloud_communication_task()
       /// create Azure IoT Hub connection
       if (SL_STATUS_OK == sl_start_azure_cloud_connection()) {
         /// update status flag as connected
-        sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status =
-          SL_CLOUD_CONNECTED;
+        sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_CONNECTED);
 
         sl_wifi_asset_tracking_lcd_print(INDEX_AZURE_CLOUD_CONNECTED);
 
         break;
       } else {
-        if (SL_STATUS_OK != sl_retry_azure_cloud_connection()) {
-          sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status =
-            SL_CLOUD_SHUTDOWN;
-          if (eSuspended
-              == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                               recovery_task_handler)) {
-            vTaskResume(
-              sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-          }
-        } else {
-          /// update status flag as connected
-          sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status =
-            SL_CLOUD_CONNECTED;
-
-          sl_wifi_asset_tracking_lcd_print(INDEX_AZURE_CLOUD_CONNECTED);
-
-          break;
-        }
+        /// Recovery task retries the connection with backoff, the cloud up
+        /// event wakes this task
+        sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_DISCONNECTED);
       }
+    } else if ((SL_WIFI_CONNECTED
+                == sl_get_wifi_asset_tracking_status()->wifi_conn_status)
+               && (SL_CLOUD_CONNECTED
+                   == sl_get_wifi_asset_tracking_status()->
+                   azure_cloud_conn_status)) {
+      /// Task recreated by the supervisor, recovery already reconnected
+      break;
     } else {
-      vTaskSuspend(
-        sl_get_wifi_asset_tracking_resource()->task_list.azure_cloud_communication_task_handler);
+      /// Woken by the wi-fi up event or the first message on a publish lane
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
       continue;
     }
   }
 
   /// This loop is used to send data to Azure cloud once connection is establish
   while (1) {
-    /// Check if MQTT data queue is empty
-    if (QUEUE_EMPTY
-        == uxQueueMessagesWaiting(sl_get_wifi_asset_tracking_resource()->
-                                  mqtt_package_queue_handler)) {
-#if DEMO_CONFIG_DEBUG_LOGS
-      printf(
-        "\r\nazure_communication_task : suspend azure communication task as mqtt_data_queue is empty\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
-      vTaskSuspend(
-        sl_get_wifi_asset_tracking_resource()->task_list.azure_cloud_communication_task_handler);
-    } else {
-      if (SL_STATUS_OK != sl_get_wifi_rssi(&rssi)) {
-        bool recovery_resume_required = false;
-
-        sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status =
-          SL_CLOUD_DISCONNECTED;
-        sl_get_wifi_asset_tracking_status()->wifi_conn_status =
-          SL_WIFI_DISCONNECTED;
-
-        /// Acquire semaphore to update the status of recovery task
-        if (pdTRUE
-            == (xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                               recovery_status_mutex_handler,
-                               portMAX_DELAY))) {
-          if (SL_RECOVERY_IDLE
-              == sl_get_wifi_asset_tracking_status()->recovery_progress_status)
-          {
-            sl_get_wifi_asset_tracking_status()->recovery_progress_status =
-              SL_RECOVERY_INPROGRESS;
-            recovery_resume_required = true;
-          }
+    sl_supervisor_check_in(SL_SUPERVISOR_CLIENT_CLOUD_COMMUNICATION);
 
-          xSemaphoreGive(
-            sl_get_wifi_asset_tracking_resource()->recovery_status_mutex_handler);
-
-          if (recovery_resume_required) {
-            printf(
-              "\r\nazure_communication_task : Resuming recovery task for Wi-Fi recovery\r\n");
+    /// Liveness rides on MQTT keep-alive instead of application messages
+    if (sl_mqtt_is_keep_alive_due) {
+      sl_mqtt_is_keep_alive_due = false;
+      sl_process_mqtt_keep_alive();
+    }
 
-            vTaskResume(
-              sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-          }
-        }
+    /// Check if MQTT data queue is empty
+    if (QUEUE_EMPTY == sl_publish_lane_messages_waiting()) {
+#if DEMO_CONFIG_POWER_SAVE
+      /// Radio sleeps again until the next burst
+      if (sl_power_save_is_burst_active()) {
+        sl_power_save_end_burst();
+      }
+#endif /// < DEMO_CONFIG_POWER_SAVE
+      SL_LOG_DEBUG(SL_LOG_MODULE_CLOUD, SL_LOG_FMT_CLOUD_WAIT_EMPTY);
+      /// Every enqueue and keep-alive notifies, one given since the check
+      /// above is still pending and the wait returns at once
+      sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_CLOUD_COMMUNICATION);
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    } else {
+      /// Link state is kept by the link monitor, no RSSI query per publish
+      if (!sl_link_monitor_is_up()) {
+        sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_DISCONNECTED);
+        sl_wifi_asset_tracking_set_wifi_status(SL_WIFI_DISCONNECTED);
       }
 
       if ((SL_CLOUD_CONNECTED
            == sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status)
           && (SL_WIFI_CONNECTED
               == sl_get_wifi_asset_tracking_status()->wifi_conn_status)) {
-        /// Acquire MQTT data queue mutex and receive data from MQTT data queue
-        if (pdTRUE
-            == (xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                               mqtt_package_queue_mutex_handler,
-                               portMAX_DELAY))) {
-          xQueueReceive(
-            sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_handler,
-            &mqtt_data_queue_reading,
-            0);
-          printf(
-            "\r\nazure_communication_task : Data is received from the MQTT data queue\r\n");
-          xSemaphoreGive(
-            sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+#if DEMO_CONFIG_POWER_SAVE
+        /// Messages gather until a burst cadence step or a lane latency cap,
+        /// then the whole burst is published in one radio wake-up
+        if (!sl_power_save_is_burst_active()) {
+          burst_delay =
+            sl_power_save_get_burst_delay(sl_publish_lane_get_due_ms());
+          if (0 != burst_delay) {
+            sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_CLOUD_COMMUNICATION);
+            ulTaskNotifyTake(pdTRUE,
+                             pdMS_TO_TICKS(burst_delay) * TIMER_CLOCK_OFFSET);
+            continue;
+          }
+          sl_power_save_begin_burst();
+        }
+#endif /// < DEMO_CONFIG_POWER_SAVE
+
+        /// Take the next message, critical lane first
+        if (SL_STATUS_OK
+            != sl_publish_lane_dequeue(&mqtt_data_queue_reading,
+                                       &publish_lane)) {
+          continue;
         }
 
-        /// Print the JSON buffer
-        printf("\r\n\r\nJSON Buffer: %.*s\r\n\r\n",
-               (int)mqtt_data_queue_reading.mqtt_buffer_len,
-               mqtt_data_queue_reading.mqtt_buffer);
+        /// Wait for a publish token to stay within the IoT Hub quota, the
+        /// message is held meanwhile so tokens are only spent on messages
+        while (SL_STATUS_OK
+               != sl_rate_limit_acquire(sl_publish_lane_messages_waiting() + 1,
+                                        &rate_limit_wait)) {
+          SL_LOG_DEBUG(SL_LOG_MODULE_CLOUD,
+                       SL_LOG_FMT_CLOUD_RATE_LIMITED,
+                       rate_limit_wait);
+          sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_CLOUD_COMMUNICATION);
+          vTaskDelay(pdMS_TO_TICKS(rate_limit_wait) * TIMER_CLOCK_OFFSET);
+          sl_supervisor_check_in(SL_SUPERVISOR_CLIENT_CLOUD_COMMUNICATION);
+        }
+        SL_LOG_DEBUG(SL_LOG_MODULE_CLOUD,
+                     SL_LOG_FMT_CLOUD_LANE_RECEIVED,
+                     publish_lane,
+                     mqtt_data_queue_reading.mqtt_buffer_len);
+
+        /// Payload dump blocks on the console, only at trace level
+        if (sl_log_is_enabled(SL_LOG_MODULE_CLOUD, SL_LOG_LEVEL_TRACE)) {
+          printf("\r\n\r\nJSON Buffer: %.*s\r\n\r\n",
+                 (int)mqtt_data_queue_reading.mqtt_buffer_len,
+                 mqtt_data_queue_reading.mqtt_buffer);
+        }
+
+        payload = mqtt_data_queue_reading.mqtt_buffer;
+        payload_len = (uint32_t)mqtt_data_queue_reading.mqtt_buffer_len;
+        property_bag =
+          &(sl_get_wifi_asset_tracking_resource()->azure_msg_property_bag);
+
+#if DEMO_CONFIG_TELEMETRY_COMPRESSION
+        /// Message is sent as it is when compression does not save space
+        if (SL_STATUS_OK
+            == sl_compress_message(mqtt_data_queue_reading.mqtt_buffer,
+                                   payload_len,
+                                   compressed_buffer,
+                                   sizeof(compressed_buffer),
+                                   &compressed_len)) {
+          SL_LOG_DEBUG(SL_LOG_MODULE_CLOUD,
+                       SL_LOG_FMT_CLOUD_COMPRESSED,
+                       payload_len,
+                       compressed_len);
+          payload = compressed_buffer;
+          payload_len = compressed_len;
+          property_bag = &(sl_get_wifi_asset_tracking_resource()->
+                           azure_msg_compressed_property_bag);
+        }
+#endif /// < DEMO_CONFIG_TELEMETRY_COMPRESSION
 
         /// Send JSON pay load to the cloud using MQTT Publish message
+        publish_tick = xTaskGetTickCount();
         msg_result =
           AzureIoTHubClient_SendTelemetry(
             &(sl_get_wifi_asset_tracking_resource()
               ->azure_iot_hub_client),
-            mqtt_data_queue_reading.mqtt_buffer,
-            mqtt_data_queue_reading.mqtt_buffer_len,
-            &(
-              sl_get_wifi_asset_tracking_resource()->azure_msg_property_bag),
+            payload,
+            payload_len,
+            property_bag,
             eAzureIoTHubMessageQoS0,
             NULL);
-        if (msg_result != eAzureIoTSuccess) {
-          bool recovery_resume_required = false;
-
-          printf("\r\nazure_communication_task : MQTT Publish sent failed\r\n");
-          sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status =
-            SL_CLOUD_DISCONNECTED;
-
-          /// Acquire semaphore to update the status of recovery task
-          if (pdTRUE
-              == (xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                                 recovery_status_mutex_handler,
-                                 portMAX_DELAY))) {
-            if (SL_RECOVERY_IDLE
-                == sl_get_wifi_asset_tracking_status()->recovery_progress_status)
-            {
-              sl_get_wifi_asset_tracking_status()->recovery_progress_status =
-                SL_RECOVERY_INPROGRESS;
-              recovery_resume_required = true;
-            }
-
-            xSemaphoreGive(
-              sl_get_wifi_asset_tracking_resource()->recovery_status_mutex_handler);
-
-            if (recovery_resume_required) {
-              printf(
-                "\r\nazure_communication_task : Resuming recovery task for Azure IoT Hub recovery\r\n\r\n");
-              vTaskResume(
-                sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-            }
-          }
+        sl_metrics_observe(SL_METRIC_PUBLISH_TIME,
+                           (uint32_t)(((xTaskGetTickCount() - publish_tick)
+                                       * portTICK_PERIOD_MS)
+                                      / TIMER_CLOCK_OFFSET));
+        /// IoT Hub throttles an MQTT client by closing its connection, so
+        /// only a close by the server while Wi-Fi stays up halves the rate.
+        /// The message is retried once recovery reconnected
+        if ((msg_result != eAzureIoTSuccess)
+            && sl_is_closed_by_iot_hub()
+            && (SL_STATUS_OK == sl_rate_limit_on_throttled())) {
+          SL_LOG_WARN(SL_LOG_MODULE_CLOUD, SL_LOG_FMT_CLOUD_THROTTLED);
+          sl_metrics_increment(SL_METRIC_PUBLISH_THROTTLED);
+          sl_publish_lane_requeue(publish_lane, &mqtt_data_queue_reading);
+          sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_DISCONNECTED);
+        } else if (msg_result != eAzureIoTSuccess) {
+          SL_LOG_ERROR(SL_LOG_MODULE_CLOUD, SL_LOG_FMT_CLOUD_PUBLISH_FAILED);
+          sl_metrics_increment(SL_METRIC_PUBLISH_FAILURES);
+          sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_DISCONNECTED);
         } else {
-          printf("\r\nazure_communication_task : MQTT Publish sent success\r\n");
+          SL_LOG_DEBUG(SL_LOG_MODULE_CLOUD, SL_LOG_FMT_CLOUD_PUBLISHED);
+          sl_metrics_increment(SL_METRIC_PUBLISHED);
+          sl_publish_lane_record_published(publish_lane,
+                                           &mqtt_data_queue_reading);
+          sl_rate_limit_on_published(sl_publish_lane_messages_waiting());
         }
       } else {
         /// Comes here when wi-fi or cloud or both is not connected
-        printf(
-          "\r\nazure_communication_task : suspend azure communication task as cloud/wifi is not connected\r\n");
+        SL_LOG_INFO(SL_LOG_MODULE_CLOUD,
+                    SL_LOG_FMT_CLOUD_WAIT_DISCONNECTED);
 
-        vTaskSuspend(
-          sl_get_wifi_asset_tracking_resource()->task_list.azure_cloud_communication_task_handler);
+        /// Cloud up event wakes the task once recovery reconnected
+        sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_CLOUD_COMMUNICATION);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
       }
     }
   }
@@ -233,6 +331,11 @@ void sl_azure_cloud_communication_task()
  *****************************************************************************/
 sl_status_t sl_start_azure_cloud_connection()
 {
+#if DEMO_CONFIG_POWER_SAVE
+  /// TLS and MQTT handshakes would wait a listen interval per round trip
+  sl_power_save_exit();
+#endif /// < DEMO_CONFIG_POWER_SAVE
+
   /// Flash SSL certificates
   if (SL_STATUS_OK != sl_load_ssl_certificates()) {
     printf(
@@ -240,8 +343,15 @@ sl_status_t sl_start_azure_cloud_connection()
     return SL_STATUS_FAIL;
   }
 
+  /// Fall back to SiWx91x TLS socket when no other transport is registered
+  if (NULL == sl_transport_get_interface()) {
+    sl_transport_register(&sl_si91x_tls_transport);
+  }
+
   /// Create an TLS connection
-  if (SL_STATUS_OK != sl_create_tls_client_connection()) {
+  if (SL_STATUS_OK
+      != sl_transport_connect((const char *)DEMO_CONFIG_IOT_HUB_HOST_NAME,
+                              AZURE_SERVER_PORT)) {
     printf(
       "\r\nsl_start_azure_cloud_connection : Failed to create an TLS connection\r\n");
     return SL_STATUS_FAIL;
@@ -261,6 +371,11 @@ sl_status_t sl_start_azure_cloud_connection()
     return SL_STATUS_FAIL;
   }
 
+#if DEMO_CONFIG_POWER_SAVE
+  /// Radio sleeps between publish bursts from here
+  sl_power_save_enter();
+#endif /// < DEMO_CONFIG_POWER_SAVE
+
   return SL_STATUS_OK;
 }
 
@@ -293,8 +408,8 @@ sl_status_t sl_connect_azure_iot_hub()
 
   /// Fill in transport interface, send and receive function pointers
   azure_transport.pxNetworkContext = &network_context;
-  azure_transport.xSend = sl_tls_sock_send;
-  azure_transport.xRecv = sl_tls_sock_recv;
+  azure_transport.xSend = sl_transport_send;
+  azure_transport.xRecv = sl_transport_recv;
 
   /// Initialize Azure IoT Hub options
   azure_iot_result_status =
@@ -326,7 +441,7 @@ sl_status_t sl_connect_azure_iot_hub()
                            &azure_iot_hub_options,
                            sl_mqtt_msg_buffer,
                            sizeof(sl_mqtt_msg_buffer),
-                           sl_get_unix_time,
+                           sl_sas_token_get_time,
                            &azure_transport);
 
 #if defined(__GNUC__)
@@ -375,6 +490,18 @@ sl_status_t sl_connect_azure_iot_hub()
     return SL_STATUS_FAIL;
   }
 
+  /// Keep signature of next SAS window ready for the following reconnect
+  xTimerStart(sl_get_wifi_asset_tracking_resource()->sas_token_refresh_timer,
+              0);
+
+  /// Keep the idle connection alive with PINGREQ
+  xTimerStart(sl_get_wifi_asset_tracking_resource()->mqtt_keep_alive_timer, 0);
+
+  /// Backend state is published again on every new connection
+  sl_json_reset_heartbeat();
+
+  sl_metrics_increment(SL_METRIC_CLOUD_CONNECTS);
+
   return SL_STATUS_OK;
 }
 
@@ -389,38 +516,34 @@ uint32_t sl_create_crypto_hmac(const uint8_t *pucKey,
                                uint32_t ulOutputLength,
                                uint32_t *pulBytesCopied)
 {
-  sl_si91x_hmac_config_t hmac_config = { 0 };
   sl_status_t status;
 
-  (void)pucKey;
-  (void)ulKeyLength;
-  (void)pucData;
-  (void)ulDataLength;
-  (void)pucOutput;
-  (void)ulOutputLength;
-  (void)pulBytesCopied;
-
-  hmac_config.hmac_mode = SL_SI91X_HMAC_SHA_256;
-  hmac_config.msg_length = ulDataLength;
-  hmac_config.msg = pucData;
-  hmac_config.key_config.B0.key_size = ulKeyLength;
-  hmac_config.key_config.B0.key_type = SL_SI91X_TRANSPARENT_KEY;
-  hmac_config.key_config.B0.key = (uint8_t *)pucKey;
-
-  status = sl_si91x_hmac(&hmac_config, pucOutput);
+  if (ulOutputLength < HMAC_SHA256_DIGEST_SIZE) {
+    printf("\r\nsl_create_crypto_hmac : output buffer too small\r\n");
+    return 1;
+  }
+
+  /// Signature is served from SAS token cache or computed from precomputed pads
+  status = sl_sas_token_hmac(pucKey,
+                             ulKeyLength,
+                             pucData,
+                             ulDataLength,
+                             pucOutput);
   if (status != SL_STATUS_OK) {
     printf("\r\nsl_create_crypto_hmac : HMAC failed, Error Code : 0x%lX\r\n",
            status);
     return 1;
   }
 
-  *pulBytesCopied = 32;
+  *pulBytesCopied = HMAC_SHA256_DIGEST_SIZE;
 
+#if DEMO_CONFIG_DEBUG_LOGS
   printf(
-    "\r\nsl_create_crypto_hmac : ulOutputLength : %ld, pulBytesCopied : %ld\r\n",
-    ulOutputLength,
-    *pulBytesCopied);
+    "\r\nsl_create_crypto_hmac : ulOutputLength : %lu, pulBytesCopied : %lu\r\n",
+    (unsigned long)ulOutputLength,
+    (unsigned long)*pulBytesCopied);
   printf("\r\nsl_create_crypto_hmac : HMAC success\r\n");
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
   return 0;
 }
 
@@ -428,17 +551,49 @@ uint32_t sl_create_crypto_hmac(const uint8_t *pucKey,
  * Function will create properties for tele-metry messages
  ******************************************************************************/
 sl_status_t sl_create_telemetry_message_properties()
+{
+  if (SL_STATUS_OK
+      != sl_create_message_property_bag(
+        &(sl_get_wifi_asset_tracking_resource()->azure_msg_property_bag),
+        sl_get_wifi_asset_tracking_resource()->azure_msg_property_buff,
+        sizeof(sl_get_wifi_asset_tracking_resource()->azure_msg_property_buff),
+        TRANSPORT_MQTT_MESSAGE_CONTENT_ENCODING)) {
+    return SL_STATUS_FAIL;
+  }
+
+#if DEMO_CONFIG_TELEMETRY_COMPRESSION
+  /// Same properties, Content-Encoding tells the backend to decompress
+  if (SL_STATUS_OK
+      != sl_create_message_property_bag(
+        &(sl_get_wifi_asset_tracking_resource()->
+          azure_msg_compressed_property_bag),
+        sl_get_wifi_asset_tracking_resource()->azure_msg_compressed_property_buff,
+        sizeof(sl_get_wifi_asset_tracking_resource()->
+               azure_msg_compressed_property_buff),
+        COMPRESS_CONTENT_ENCODING)) {
+    return SL_STATUS_FAIL;
+  }
+#endif /// < DEMO_CONFIG_TELEMETRY_COMPRESSION
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ * Function will create a property bag with Content-Type and Content-Encoding
+ ******************************************************************************/
+static sl_status_t sl_create_message_property_bag(
+  AzureIoTMessageProperties_t *property_bag,
+  uint8_t *property_buff,
+  uint32_t property_buff_size,
+  const char *content_encoding)
 {
   AzureIoTResult_t azure_iot_status;
 
   /// Create a bag of properties for the tele-metry */
-  azure_iot_status =
-    AzureIoTMessage_PropertiesInit(&(sl_get_wifi_asset_tracking_resource()->
-                                     azure_msg_property_bag),
-                                   sl_get_wifi_asset_tracking_resource()->azure_msg_property_buff,
-                                   0,
-                                   sizeof(sl_get_wifi_asset_tracking_resource()
-                                          ->azure_msg_property_buff));
+  azure_iot_status = AzureIoTMessage_PropertiesInit(property_bag,
+                                                    property_buff,
+                                                    0,
+                                                    property_buff_size);
 
   if (azure_iot_status != eAzureIoTSuccess) {
     return SL_STATUS_FAIL;
@@ -447,8 +602,7 @@ sl_status_t sl_create_telemetry_message_properties()
   /// Sending a default property (Content-Type)
   azure_iot_status =
     AzureIoTMessage_PropertiesAppend(
-      &(sl_get_wifi_asset_tracking_resource()->
-        azure_msg_property_bag),
+      property_bag,
       (uint8_t *)AZ_IOT_MESSAGE_PROPERTIES_CONTENT_TYPE,
       sizeof(
         AZ_IOT_MESSAGE_PROPERTIES_CONTENT_TYPE) - 1,
@@ -463,14 +617,12 @@ sl_status_t sl_create_telemetry_message_properties()
   /// Sending a default property (Content-Encoding)
   azure_iot_status =
     AzureIoTMessage_PropertiesAppend(
-      &(sl_get_wifi_asset_tracking_resource()->
-        azure_msg_property_bag),
+      property_bag,
       (uint8_t *)AZ_IOT_MESSAGE_PROPERTIES_CONTENT_ENCODING,
       sizeof(
         AZ_IOT_MESSAGE_PROPERTIES_CONTENT_ENCODING) - 1,
-      (uint8_t *)TRANSPORT_MQTT_MESSAGE_CONTENT_ENCODING,
-      sizeof(
-        TRANSPORT_MQTT_MESSAGE_CONTENT_ENCODING) - 1);
+      (const uint8_t *)content_encoding,
+      strlen(content_encoding));
 
   if (azure_iot_status != eAzureIoTSuccess) {
     return SL_STATUS_FAIL;
@@ -480,50 +632,36 @@ sl_status_t sl_create_telemetry_message_properties()
 }
 
 /******************************************************************************
- * Function will retry for Azure cloud connection with configured
- * authentication method for five times at every five seconds.
+ * Function will make one attempt of Azure cloud connection with configured
+ * authentication method, the recovery task spaces the attempts.
  ******************************************************************************/
 sl_status_t sl_retry_azure_cloud_connection()
 {
-  uint8_t retry_cnt;
   int32_t rssi = 0;
   sl_status_t status;
 
   sl_disconnect_azure_iot_hub();
 
-  for (retry_cnt = 0; retry_cnt < AZURE_CLOUD_CONN_RETRY_COUNT; ++retry_cnt) {
-    printf(
-      "\r\nsl_retry_azure_cloud_connection : retrying to establish Azure cloud connection\r\n");
-
-    sl_wifi_asset_tracking_lcd_print(INDEX_AZURE_CLOUD_RETRY);
-
-    /// Check whether rssi is getting
-    status = sl_get_wifi_rssi(&rssi);
-
-    if (SL_STATUS_OK != status) {
-      printf(
-        "\r\nsl_retry_azure_cloud_connection : wi-fi also got disconnected.\r\n");
+  printf(
+    "\r\nsl_retry_azure_cloud_connection : retrying to establish Azure cloud connection\r\n");
 
-      sl_get_wifi_asset_tracking_status()->wifi_conn_status =
-        SL_WIFI_DISCONNECTED;
+  sl_wifi_asset_tracking_lcd_print(INDEX_AZURE_CLOUD_RETRY);
 
-      retry_cnt = AZURE_CLOUD_CONN_RETRY_COUNT;
+  /// Check whether rssi is getting
+  status = sl_get_wifi_rssi(&rssi);
 
-      break;
-    }
-
-    if (SL_STATUS_OK != sl_start_azure_cloud_connection()) {
-      sl_disconnect_azure_iot_hub();
+  if (SL_STATUS_OK != status) {
+    printf(
+      "\r\nsl_retry_azure_cloud_connection : wi-fi also got disconnected.\r\n");
 
-      vTaskDelay(pdMS_TO_TICKS(
-                   AZURE_CLOUD_CONN_DELAY_BETN_RETRY) * TIMER_CLOCK_OFFSET);
+    sl_wifi_asset_tracking_set_wifi_status(SL_WIFI_DISCONNECTED);
 
-      continue;
-    }
-    break;
+    return SL_STATUS_FAIL;
   }
 
-  if (AZURE_CLOUD_CONN_RETRY_COUNT == retry_cnt) {
+  if (SL_STATUS_OK != sl_start_azure_cloud_connection()) {
+    sl_disconnect_azure_iot_hub();
+
     return SL_STATUS_FAIL;
   }
 
@@ -629,25 +767,18 @@ sl_status_t sl_load_ssl_certificates()
 sl_status_t sl_create_tls_client_connection(void)
 {
   sl_status_t status;
-  uint8_t count = DNS_REQ_COUNT;
   int socket_return_value = 0;
   socklen_t socket_length = sizeof(struct sockaddr_in);
   struct sockaddr_in server_address = { 0 };
   sl_ip_address_t dns_query_rsp = { 0 };
   sl_si91x_time_value timeout = { 0 };
 
-  /// DNS query to resolve Azure IoT Hub host name
-  do {
-    status = sl_net_dns_resolve_hostname(
-      (const char *)DEMO_CONFIG_IOT_HUB_HOST_NAME,
-      DNS_TIMEOUT,
-      SL_NET_DNS_TYPE_IPV4,
-      &dns_query_rsp);
-    if (status == SL_STATUS_OK) {
-      break;
-    }
-    count--;
-  } while (count != 0);
+  /// Resolve Azure IoT Hub host name, served from DNS cache when possible
+  status = sl_dns_cache_resolve_hostname(
+    (const char *)DEMO_CONFIG_IOT_HUB_HOST_NAME,
+    DNS_TIMEOUT,
+    DNS_REQ_COUNT,
+    &dns_query_rsp);
 
   if (status != SL_STATUS_OK) {
     /// Return failure, if DNS resolution fails
@@ -714,6 +845,9 @@ sl_status_t sl_create_tls_client_connection(void)
       "\r\nsl_create_tls_client_connection : Socket Connect failed with bsd error: %d\r\n",
       errno);
 
+    /// Cached address may be outdated, revalidate it on next attempt
+    sl_dns_cache_invalidate((const char *)DEMO_CONFIG_IOT_HUB_HOST_NAME);
+
     close(sl_get_wifi_asset_tracking_resource()->client_socket_id);
     return SL_STATUS_FAIL;
   }
@@ -746,6 +880,12 @@ int32_t sl_tls_sock_recv(NetworkContext_t *network_context,
       return 0;
     }
   }
+
+  /// Timeouts are reported as errors above, 0 is an orderly close by the
+  /// server
+  if (0 == recv_bytes) {
+    return SL_TRANSPORT_PEER_CLOSED;
+  }
 #if DEMO_CONFIG_DEBUG_LOGS
   printf("\r\nsl_tls_sock_recv : bytes received: %ld\r\n", recv_bytes);
 #endif /// < DEMO_CONFIG_DEBUG_LOGS
@@ -777,17 +917,123 @@ int32_t sl_tls_sock_send(NetworkContext_t *network_context,
  ******************************************************************************/
 sl_status_t sl_disconnect_azure_iot_hub()
 {
+  xTimerStop(sl_get_wifi_asset_tracking_resource()->mqtt_keep_alive_timer, 0);
+
   /// Disconnect Azure IoT Hub Connection
   AzureIoTHubClient_Disconnect(&(sl_get_wifi_asset_tracking_resource()->
                                  azure_iot_hub_client));
 
   /// close TLS socket
+  sl_transport_disconnect();
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Callback function of MQTT keep-alive timer.
+ *****************************************************************************/
+void on_mqtt_keep_alive_timer_callback()
+{
+  sl_mqtt_is_keep_alive_due = true;
+
+  /// Runs in timer daemon context, cloud task does the socket work
+  xTaskNotifyGive(
+    sl_get_wifi_asset_tracking_resource()->task_list.azure_cloud_communication_task_handler);
+}
+
+/******************************************************************************
+ *  Function to process the MQTT connection for keep-alive.
+ *****************************************************************************/
+static void sl_process_mqtt_keep_alive(void)
+{
+  AzureIoTResult_t result;
+
+  if ((SL_CLOUD_CONNECTED
+       != sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status)
+      || (SL_WIFI_CONNECTED
+          != sl_get_wifi_asset_tracking_status()->wifi_conn_status)) {
+    return;
+  }
+
+  result = AzureIoTHubClient_ProcessLoop(
+    &(sl_get_wifi_asset_tracking_resource()->azure_iot_hub_client),
+    MQTT_PROCESS_LOOP_TIMEOUT_MS);
+  if (eAzureIoTSuccess == result) {
+    return;
+  }
+
+  printf(
+    "\r\nsl_process_mqtt_keep_alive : MQTT keep-alive failed, error code: %d\r\n",
+    result);
+
+  /// Throttling is noticed here when the close arrives between publishes
+  if (sl_is_closed_by_iot_hub()) {
+    sl_rate_limit_on_throttled();
+    sl_metrics_increment(SL_METRIC_PUBLISH_THROTTLED);
+  }
+  sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_DISCONNECTED);
+}
+
+/******************************************************************************
+ *  Function to check whether the IoT Hub closed the connection.
+ *****************************************************************************/
+static bool sl_is_closed_by_iot_hub(void)
+{
+  return (SL_TRANSPORT_DISCONNECT_PEER_CLOSED
+          == sl_transport_get_disconnect_reason())
+         && sl_link_monitor_is_up();
+}
+
+/******************************************************************************
+ * Transport backend connect on SiWx91x TLS socket.
+ ******************************************************************************/
+static sl_status_t sl_si91x_tls_transport_connect(void *context,
+                                                  const char *host_name,
+                                                  uint16_t port)
+{
+  UNUSED_PARAMETER(context);
+  UNUSED_PARAMETER(host_name);
+  UNUSED_PARAMETER(port);
+
+  /// Host name and port of the configured IoT Hub are used
+  return sl_create_tls_client_connection();
+}
+
+/******************************************************************************
+ * Transport backend send on SiWx91x TLS socket.
+ ******************************************************************************/
+static int32_t sl_si91x_tls_transport_send(void *context,
+                                           const void *buffer,
+                                           size_t bytes_to_send)
+{
+  UNUSED_PARAMETER(context);
+
+  return sl_tls_sock_send(NULL, buffer, bytes_to_send);
+}
+
+/******************************************************************************
+ * Transport backend receive on SiWx91x TLS socket.
+ ******************************************************************************/
+static int32_t sl_si91x_tls_transport_recv(void *context,
+                                           void *buffer,
+                                           size_t bytes_to_recv)
+{
+  UNUSED_PARAMETER(context);
+
+  return sl_tls_sock_recv(NULL, buffer, bytes_to_recv);
+}
+
+/******************************************************************************
+ * Transport backend disconnect on SiWx91x TLS socket.
+ ******************************************************************************/
+static void sl_si91x_tls_transport_disconnect(void *context)
+{
+  UNUSED_PARAMETER(context);
+
   if (sl_get_wifi_asset_tracking_resource()->client_socket_id >= 0) {
     close(sl_get_wifi_asset_tracking_resource()->client_socket_id);
   }
 
   /// reset socket variable
   sl_get_wifi_asset_tracking_resource()->client_socket_id = -1;
-
-  return SL_STATUS_OK;
 }
@@ -0,0 +1,460 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_clock.c
+ * @brief Network time discipline of calendar RTC
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_clock.h>
+
+/// @brief Structure for clock discipline state. Local time is the calendar
+/// RTC plus a correction which follows the estimated drift and absorbs the
+/// last measured offset at CLOCK_SLEW_RATE, the RTC itself is not written.
+typedef struct {
+  bool is_synced;                 ///< First SNTP sample taken
+  bool is_drift_valid;            ///< Drift estimated from two samples
+  uint64_t ref_rtc_ms;            ///< Calendar RTC time of last sync
+  int64_t ref_correction_ms;      ///< Correction at ref_rtc_ms
+  int32_t slew_ms;                ///< Offset absorbed after ref_rtc_ms
+  int64_t ref_raw_offset_ms;      ///< Network time minus calendar RTC time at last sync
+  int32_t drift_ppb;              ///< Estimated RTC rate error
+  uint32_t drift_error_ppb;       ///< Mean deviation of drift samples from estimate
+  int32_t offset_ms;              ///< Offset measured at last sync
+  uint32_t sample_uncertainty_ms; ///< Half SNTP exchange time of last sync
+  uint32_t sync_interval;         ///< In seconds, wait until next sync
+  uint32_t sync_count;            ///< Successful syncs since boot
+} sl_clock_t;
+
+/// Clock state, written by clock and Wi-Fi tasks under clock mutex
+static sl_clock_t sl_clock;
+
+/**************************************************************************/ /**
+ * @brief Function to take an SNTP sample, update drift estimate and correct
+ * the offset. Offsets up to CLOCK_STEP_THRESHOLD are slewed.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when network time could not be fetched
+ ******************************************************************************/
+static sl_status_t sl_clock_sync(void);
+
+/**************************************************************************/ /**
+ * @brief Function to read calendar RTC as milliseconds since epoch.
+ * @param[out] rtc_ms : calendar RTC time.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when calendar RTC read failed
+ ******************************************************************************/
+static sl_status_t sl_clock_read_rtc_ms(uint64_t *rtc_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to get correction of a calendar RTC time, call with
+ * sl_clock consistent.
+ * @param[in] rtc_ms : calendar RTC time.
+ * @return correction in ms.
+ ******************************************************************************/
+static int64_t sl_clock_get_correction(uint64_t rtc_ms);
+
+/**************************************************************************/ /**
+ * @brief Function to convert a calendar date and time to milliseconds since
+ * epoch.
+ * @param[in] year : full year.
+ * @param[in] month : 1 to 12.
+ * @param[in] day : 1 to 31.
+ * @param[in] ms_of_day : milliseconds since midnight.
+ * @return milliseconds since 1970-01-01T00:00:00Z.
+ ******************************************************************************/
+static uint64_t sl_clock_date_to_ms(uint32_t year,
+                                    uint32_t month,
+                                    uint32_t day,
+                                    uint32_t ms_of_day);
+
+/**************************************************************************/ /**
+ * @brief Function to convert milliseconds since epoch to calendar format.
+ * @param[in] unix_ms : milliseconds since 1970-01-01T00:00:00Z.
+ * @param[out] datetime : date and time.
+ ******************************************************************************/
+static void sl_clock_ms_to_datetime(uint64_t unix_ms,
+                                    sl_calendar_datetime_config_t *datetime);
+
+/******************************************************************************
+ *  Task function which takes SNTP samples on schedule.
+ *****************************************************************************/
+void sl_clock_task()
+{
+  uint64_t rtc_ms;
+  bool is_due;
+
+  while (1) {
+    vTaskDelay(pdMS_TO_TICKS(CLOCK_CHECK_INTERVAL) * TIMER_CLOCK_OFFSET);
+
+    /// Recovery owns the network processor until it reconnects
+    if (SL_WIFI_CONNECTED
+        != sl_get_wifi_asset_tracking_status()->wifi_conn_status) {
+      continue;
+    }
+
+    if (SL_STATUS_OK != sl_clock_read_rtc_ms(&rtc_ms)) {
+      continue;
+    }
+
+    taskENTER_CRITICAL();
+    is_due = (!sl_clock.is_synced)
+             || ((rtc_ms - sl_clock.ref_rtc_ms)
+                 >= ((uint64_t)sl_clock.sync_interval * 1000));
+    taskEXIT_CRITICAL();
+
+    /// Failed sample is retried at next check
+    if (is_due) {
+      sl_clock_sync();
+    }
+  }
+}
+
+/******************************************************************************
+ *  Function to start discipline from a calendar just set from SNTP.
+ *****************************************************************************/
+void sl_clock_on_rtc_set(uint32_t exchange_ms)
+{
+  uint64_t rtc_ms;
+
+  if (SL_STATUS_OK != sl_clock_read_rtc_ms(&rtc_ms)) {
+    return;
+  }
+
+  /// Calendar holds network time now, drift history of old setting is void
+  taskENTER_CRITICAL();
+  sl_clock.ref_rtc_ms = rtc_ms;
+  sl_clock.ref_correction_ms = 0;
+  sl_clock.slew_ms = 0;
+  sl_clock.ref_raw_offset_ms = 0;
+  sl_clock.offset_ms = 0;
+  sl_clock.sample_uncertainty_ms = (exchange_ms / 2) + 1;
+  sl_clock.sync_interval = CLOCK_SYNC_INTERVAL_MIN;
+  sl_clock.sync_count++;
+  sl_clock.is_synced = true;
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to check whether the clock follows network time.
+ *****************************************************************************/
+bool sl_clock_is_synced(void)
+{
+  return sl_clock.is_synced;
+}
+
+/******************************************************************************
+ *  Function to get corrected time.
+ *****************************************************************************/
+sl_status_t sl_clock_get_time(uint64_t *unix_ms)
+{
+  uint64_t rtc_ms;
+
+  if (SL_STATUS_OK != sl_clock_read_rtc_ms(&rtc_ms)) {
+    return SL_STATUS_FAIL;
+  }
+
+  taskENTER_CRITICAL();
+  *unix_ms = (uint64_t)((int64_t)rtc_ms + sl_clock_get_correction(rtc_ms));
+  taskEXIT_CRITICAL();
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to get corrected time in calendar format.
+ *****************************************************************************/
+sl_status_t sl_clock_get_datetime(sl_calendar_datetime_config_t *datetime)
+{
+  uint64_t unix_ms;
+
+  if (SL_STATUS_OK != sl_clock_get_time(&unix_ms)) {
+    return SL_STATUS_FAIL;
+  }
+
+  sl_clock_ms_to_datetime(unix_ms, datetime);
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to read time quality.
+ *****************************************************************************/
+void sl_clock_get_quality(sl_clock_quality_t *quality)
+{
+  uint64_t rtc_ms = 0;
+  uint64_t elapsed_ms = 0;
+  uint64_t slew_done_ms;
+  uint32_t drift_error_ppb;
+  uint32_t slew_left_ms;
+
+  memset(quality, 0, sizeof(*quality));
+
+  if (SL_STATUS_OK != sl_clock_read_rtc_ms(&rtc_ms)) {
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  quality->is_synced = sl_clock.is_synced;
+  quality->offset_ms = sl_clock.offset_ms;
+  quality->drift_ppb = sl_clock.drift_ppb;
+  quality->sync_interval = sl_clock.sync_interval;
+  quality->sync_count = sl_clock.sync_count;
+  if (rtc_ms > sl_clock.ref_rtc_ms) {
+    elapsed_ms = rtc_ms - sl_clock.ref_rtc_ms;
+  }
+  drift_error_ppb = sl_clock.is_drift_valid ? sl_clock.drift_error_ppb
+                    : CLOCK_DRIFT_ERROR_INITIAL;
+  slew_done_ms = (elapsed_ms * CLOCK_SLEW_RATE) / 1000000;
+  slew_left_ms = (uint32_t)abs(sl_clock.slew_ms);
+  slew_left_ms = (slew_done_ms >= slew_left_ms) ? 0
+                 : (slew_left_ms - (uint32_t)slew_done_ms);
+  /// Offset not yet slewed is known error, drift error grows since sync
+  quality->uncertainty_ms = sl_clock.sample_uncertainty_ms + slew_left_ms
+                            + (uint32_t)((elapsed_ms * drift_error_ppb)
+                                         / 1000000000);
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to take an SNTP sample and correct the clock.
+ *****************************************************************************/
+static sl_status_t sl_clock_sync(void)
+{
+  sl_status_t status = SL_STATUS_FAIL;
+  sl_cal_date_time_type_t cal_data;
+  uint32_t exchange_ms;
+  uint64_t rtc_ms;
+  uint64_t ntp_ms;
+  uint64_t span_ms;
+  int64_t raw_offset_ms;
+  int64_t correction_ms;
+  int64_t offset_ms;
+  int32_t sample_ppb;
+  uint32_t deviation_ppb;
+
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        clock_mutex_handler,
+                        portMAX_DELAY)) {
+    return SL_STATUS_FAIL;
+  }
+
+  if (SL_STATUS_OK
+      != sl_get_time_and_date_using_sntp(&cal_data, &exchange_ms)) {
+    goto error;
+  }
+
+  if (SL_STATUS_OK != sl_clock_read_rtc_ms(&rtc_ms)) {
+    goto error;
+  }
+
+  /// Server time is taken as the middle of the exchange
+  ntp_ms = sl_clock_date_to_ms(
+    ((uint32_t)cal_data.century * CLOCK_YEAR_PER_CENTURY_DIGIT) + cal_data.year,
+    cal_data.month,
+    cal_data.day,
+    ((((((uint32_t)cal_data.hour * 60) + cal_data.minute) * 60)
+      + cal_data.second) * 1000) + cal_data.milliseconds)
+           + (exchange_ms / 2);
+  raw_offset_ms = (int64_t)ntp_ms - (int64_t)rtc_ms;
+
+  taskENTER_CRITICAL();
+  correction_ms = sl_clock_get_correction(rtc_ms);
+  offset_ms = raw_offset_ms - correction_ms;
+
+  /// Drift sample is the change of raw offset over span between syncs
+  span_ms = rtc_ms - sl_clock.ref_rtc_ms;
+  if (sl_clock.is_synced && (rtc_ms > sl_clock.ref_rtc_ms)
+      && (span_ms >= CLOCK_DRIFT_MIN_SPAN)) {
+    sample_ppb = (int32_t)(((raw_offset_ms - sl_clock.ref_raw_offset_ms)
+                            * 1000000000) / (int64_t)span_ms);
+    if (sl_clock.is_drift_valid) {
+      deviation_ppb = (uint32_t)abs(sample_ppb - sl_clock.drift_ppb);
+      sl_clock.drift_ppb += (sample_ppb - sl_clock.drift_ppb)
+                            / (1 << CLOCK_DRIFT_FILTER_SHIFT);
+      sl_clock.drift_error_ppb =
+        (uint32_t)((int32_t)sl_clock.drift_error_ppb
+                   + (((int32_t)deviation_ppb
+                       - (int32_t)sl_clock.drift_error_ppb)
+                      / (1 << CLOCK_DRIFT_FILTER_SHIFT)));
+    } else {
+      sl_clock.drift_ppb = sample_ppb;
+      sl_clock.drift_error_ppb = CLOCK_DRIFT_ERROR_INITIAL;
+      sl_clock.is_drift_valid = true;
+    }
+  }
+
+  /// Small offsets are slewed so consecutive timestamps never jump back
+  if ((!sl_clock.is_synced) || (llabs(offset_ms) > CLOCK_STEP_THRESHOLD)) {
+    sl_clock.ref_correction_ms = correction_ms + offset_ms;
+    sl_clock.slew_ms = 0;
+  } else {
+    sl_clock.ref_correction_ms = correction_ms;
+    sl_clock.slew_ms = (int32_t)offset_ms;
+  }
+
+  /// Stable clock needs fewer samples, unstable one more
+  if ((!sl_clock.is_synced) || (llabs(offset_ms) > CLOCK_STABLE_OFFSET)
+      || (!sl_clock.is_drift_valid)) {
+    sl_clock.sync_interval = CLOCK_SYNC_INTERVAL_MIN;
+  } else if (sl_clock.sync_interval < (CLOCK_SYNC_INTERVAL_MAX / 2)) {
+    sl_clock.sync_interval *= 2;
+  } else {
+    sl_clock.sync_interval = CLOCK_SYNC_INTERVAL_MAX;
+  }
+
+  sl_clock.ref_rtc_ms = rtc_ms;
+  sl_clock.ref_raw_offset_ms = raw_offset_ms;
+  sl_clock.offset_ms = (int32_t)offset_ms;
+  sl_clock.sample_uncertainty_ms = (exchange_ms / 2) + 1;
+  sl_clock.sync_count++;
+  sl_clock.is_synced = true;
+  taskEXIT_CRITICAL();
+
+  printf(
+    "\r\nsl_clock_sync : offset %ld ms, drift %ld ppb, next sync in %lu s\r\n",
+    (long)offset_ms,
+    (long)sl_clock.drift_ppb,
+    sl_clock.sync_interval);
+
+  status = SL_STATUS_OK;
+
+  error:
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->clock_mutex_handler);
+  return status;
+}
+
+/******************************************************************************
+ *  Function to read calendar RTC as milliseconds since epoch.
+ *****************************************************************************/
+static sl_status_t sl_clock_read_rtc_ms(uint64_t *rtc_ms)
+{
+  sl_calendar_datetime_config_t datetime;
+  sl_status_t status;
+
+  status = sl_si91x_calendar_get_date_time(&datetime);
+  if (SL_STATUS_OK != status) {
+    printf(
+      "\r\nsl_clock_read_rtc_ms : sl_si91x_calendar_get_date_time: Error Code : %lu \r\n",
+      status);
+    return SL_STATUS_FAIL;
+  }
+
+  *rtc_ms = sl_clock_date_to_ms(
+    ((uint32_t)datetime.Century * CLOCK_YEAR_PER_CENTURY_DIGIT) + datetime.Year,
+    datetime.Month,
+    datetime.Day,
+    ((((((uint32_t)datetime.Hour * 60) + datetime.Minute) * 60)
+      + datetime.Second) * 1000) + datetime.MilliSeconds);
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to get correction of a calendar RTC time.
+ *****************************************************************************/
+static int64_t sl_clock_get_correction(uint64_t rtc_ms)
+{
+  int64_t elapsed_ms;
+  int64_t slew_done_ms;
+
+  if (rtc_ms <= sl_clock.ref_rtc_ms) {
+    return sl_clock.ref_correction_ms;
+  }
+
+  elapsed_ms = (int64_t)(rtc_ms - sl_clock.ref_rtc_ms);
+  slew_done_ms = (elapsed_ms * CLOCK_SLEW_RATE) / 1000000;
+  if (slew_done_ms > abs(sl_clock.slew_ms)) {
+    slew_done_ms = abs(sl_clock.slew_ms);
+  }
+  if (0 > sl_clock.slew_ms) {
+    slew_done_ms = -slew_done_ms;
+  }
+
+  return sl_clock.ref_correction_ms
+         + ((elapsed_ms * sl_clock.drift_ppb) / 1000000000) + slew_done_ms;
+}
+
+/******************************************************************************
+ *  Function to convert a calendar date and time to milliseconds since epoch.
+ *****************************************************************************/
+static uint64_t sl_clock_date_to_ms(uint32_t year,
+                                    uint32_t month,
+                                    uint32_t day,
+                                    uint32_t ms_of_day)
+{
+  uint32_t era;
+  uint32_t year_of_era;
+  uint32_t day_of_year;
+  uint32_t day_of_era;
+
+  /// Count years from March so that leap day is last day of year
+  year -= (month <= 2) ? 1 : 0;
+  era = year / 400;
+  year_of_era = year - (era * 400);
+  day_of_year = (((153 * ((month > 2) ? (month - 3) : (month + 9))) + 2) / 5)
+                + day - 1;
+  day_of_era = (year_of_era * 365) + (year_of_era / 4) - (year_of_era / 100)
+               + day_of_year;
+
+  /// 719468 days from 0000-03-01 to 1970-01-01
+  return ((((uint64_t)era * 146097) + day_of_era - 719468) * 86400000)
+         + ms_of_day;
+}
+
+/******************************************************************************
+ *  Function to convert milliseconds since epoch to calendar format.
+ *****************************************************************************/
+static void sl_clock_ms_to_datetime(uint64_t unix_ms,
+                                    sl_calendar_datetime_config_t *datetime)
+{
+  uint32_t days = (uint32_t)(unix_ms / 86400000);
+  uint32_t ms_of_day = (uint32_t)(unix_ms % 86400000);
+  uint32_t era;
+  uint32_t day_of_era;
+  uint32_t year_of_era;
+  uint32_t day_of_year;
+  uint32_t month_index;
+  uint32_t year;
+
+  /// 1970-01-01 was a Thursday
+  datetime->DayOfWeek = (sl_calendar_days_of_week_t)((days + 4) % 7);
+
+  days += 719468;
+  era = days / 146097;
+  day_of_era = days - (era * 146097);
+  year_of_era = (day_of_era - (day_of_era / 1460) + (day_of_era / 36524)
+                 - (day_of_era / 146096)) / 365;
+  day_of_year = day_of_era
+                - ((365 * year_of_era) + (year_of_era / 4)
+                   - (year_of_era / 100));
+  month_index = ((5 * day_of_year) + 2) / 153;
+  year = year_of_era + (era * 400) + ((month_index >= 10) ? 1 : 0);
+
+  datetime->Day = (uint8_t)(day_of_year - (((153 * month_index) + 2) / 5) + 1);
+  datetime->Month = (sl_calendar_month_t)((month_index < 10)
+                                          ? (month_index + 3)
+                                          : (month_index - 9));
+  datetime->Century = (uint8_t)(year / CLOCK_YEAR_PER_CENTURY_DIGIT);
+  datetime->Year = (uint8_t)(year % 100);
+  datetime->Hour = (uint8_t)(ms_of_day / 3600000);
+  datetime->Minute = (uint8_t)((ms_of_day / 60000) % 60);
+  datetime->Second = (uint8_t)((ms_of_day / 1000) % 60);
+  datetime->MilliSeconds = (uint16_t)(ms_of_day % 1000);
+}
@@ -0,0 +1,310 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_compress.c
+ * @brief LZ77 telemetry compressor primed with the JSON schema
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdbool.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_compress.h>
+
+/*
+ * Format, after the magic and version bytes: groups of one flag byte and up
+ * to eight items, flag bit n (LSB first) tells whether item n is a literal
+ * byte (0) or a two byte back reference (1). A back reference is big endian
+ * ((distance - 1) << 4) | (length - COMPRESS_MIN_MATCH). Distances reach
+ * into the dictionary below, which precedes every message.
+ *
+ * The dictionary is mirrored in the dashboard backend
+ * (compression.constant.ts); any change needs a new COMPRESS_FORMAT_VERSION.
+ */
+static const char sl_compress_dictionary[] =
+  "{\"msgtype\":\"session\",\"session\":\"new\"}"
+  "{\"msgtype\":\"keep-alive\",\"timestamp\":\"2024-01-01T00:00:00.000Z\","
+  "\"keep-alive\":\"yes\",\"interval\":[60,5,1,60]}"
+  "{\"msgtype\":\"wifi\",\"timestamp\":\"\",\"wifi\":{\"macid\":"
+  "\"00:00:00:00:00:00\",\"ssid\":\"\",\"rssi\":-"
+  "{\"msgtype\":\"gps\",\"timestamp\":\"\",\"gps\":{\"latitude\":null,"
+  "\"longitude\":null,\"altitude\":null,\"satellites\":"
+  "{\"msgtype\":\"imu\",\"timestamp\":\"\",\"accelero\":[null,null,null],"
+  "\"gyro\":["
+  "{\"msgtype\":\"heat\",\"timestamp\":\"2024-01-01T00:00:00.000Z\","
+  "\"heat\":{\"temperature\":{\"value\":null,\"unit\":\"C\"},\"humidity\":";
+
+#define COMPRESS_DICTIONARY_SIZE  (sizeof(sl_compress_dictionary) - 1)  ///< Without terminator
+#define COMPRESS_HISTORY_SIZE     (COMPRESS_DICTIONARY_SIZE + COMPRESS_MAX_INPUT_SIZE) ///< Dictionary followed by message
+#define COMPRESS_HASH_SIZE        (1 << COMPRESS_HASH_BITS)               ///< Match heads
+#define COMPRESS_NO_POSITION      0xFFFF                                  ///< End of match chain
+
+/// Dictionary followed by the message being compressed
+static uint8_t sl_compress_history[COMPRESS_HISTORY_SIZE];
+
+/// Latest position of each hash, and the same after priming the dictionary
+static uint16_t sl_compress_head[COMPRESS_HASH_SIZE];
+static uint16_t sl_compress_dictionary_head[COMPRESS_HASH_SIZE];
+
+/// Previous position with the same hash; dictionary part is set once
+static uint16_t sl_compress_prev[COMPRESS_HISTORY_SIZE];
+
+/// Set once dictionary match tables are built
+static bool sl_compress_is_primed;
+
+/**************************************************************************/ /**
+ * @brief Function to hash three bytes.
+ * @param[in] data : first of three bytes.
+ * @return hash table index.
+ ******************************************************************************/
+static uint32_t sl_compress_hash(const uint8_t *data);
+
+/**************************************************************************/ /**
+ * @brief Function to add a position to its hash chain.
+ * @param[in] position : history position with three bytes available.
+ ******************************************************************************/
+static void sl_compress_insert(uint32_t position);
+
+/**************************************************************************/ /**
+ * @brief Function to build match tables of the dictionary once.
+ ******************************************************************************/
+static void sl_compress_prime(void);
+
+/******************************************************************************
+ *  Function to compress one JSON message.
+ *****************************************************************************/
+sl_status_t sl_compress_message(const uint8_t *input,
+                                uint32_t input_len,
+                                uint8_t *output,
+                                uint32_t output_size,
+                                uint32_t *output_len)
+{
+  uint32_t position = COMPRESS_DICTIONARY_SIZE;
+  uint32_t end = COMPRESS_DICTIONARY_SIZE + input_len;
+  uint32_t out = COMPRESS_HEADER_SIZE;
+  uint32_t flag_index = 0;
+  uint32_t item_count = 8;
+  uint32_t best_len;
+  uint32_t best_distance;
+  uint32_t max_len;
+  uint32_t len;
+  uint32_t candidate;
+  uint32_t chain;
+  uint32_t advance;
+  uint32_t reference;
+
+  if ((0 == input_len) || (input_len > COMPRESS_MAX_INPUT_SIZE)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Not worth it unless at least one byte is saved
+  if (output_size >= input_len) {
+    output_size = input_len - 1;
+  }
+  if (output_size <= COMPRESS_HEADER_SIZE) {
+    return SL_STATUS_FAIL;
+  }
+
+  if (!sl_compress_is_primed) {
+    sl_compress_prime();
+  }
+
+  memcpy(&sl_compress_history[COMPRESS_DICTIONARY_SIZE], input, input_len);
+  memcpy(sl_compress_head,
+         sl_compress_dictionary_head,
+         sizeof(sl_compress_head));
+
+  output[0] = COMPRESS_MAGIC;
+  output[1] = COMPRESS_FORMAT_VERSION;
+
+  while (position < end) {
+    /// Start a new group with its flag byte
+    if (8 == item_count) {
+      if (out >= output_size) {
+        return SL_STATUS_FAIL;
+      }
+      flag_index = out++;
+      output[flag_index] = 0;
+      item_count = 0;
+    }
+
+    best_len = 0;
+    best_distance = 0;
+    max_len = end - position;
+    if (max_len > COMPRESS_MAX_MATCH) {
+      max_len = COMPRESS_MAX_MATCH;
+    }
+
+    if (max_len >= COMPRESS_MIN_MATCH) {
+      candidate = sl_compress_head[sl_compress_hash(&sl_compress_history[position])];
+
+      for (chain = 0;
+           (chain < COMPRESS_MAX_CHAIN) && (COMPRESS_NO_POSITION != candidate);
+           ++chain) {
+        len = 0;
+        while ((len < max_len)
+               && (sl_compress_history[candidate + len]
+                   == sl_compress_history[position + len])) {
+          len++;
+        }
+
+        if (len > best_len) {
+          best_len = len;
+          best_distance = position - candidate;
+          if (max_len == len) {
+            break;
+          }
+        }
+
+        candidate = sl_compress_prev[candidate];
+      }
+    }
+
+    if (best_len >= COMPRESS_MIN_MATCH) {
+      if ((out + 2) > output_size) {
+        return SL_STATUS_FAIL;
+      }
+      reference = ((best_distance - 1) << (16 - COMPRESS_OFFSET_BITS))
+                  | (best_len - COMPRESS_MIN_MATCH);
+      output[flag_index] |= (uint8_t)(1 << item_count);
+      output[out++] = (uint8_t)(reference >> 8);
+      output[out++] = (uint8_t)reference;
+      advance = best_len;
+    } else {
+      if (out >= output_size) {
+        return SL_STATUS_FAIL;
+      }
+      output[out++] = sl_compress_history[position];
+      advance = 1;
+    }
+
+    item_count++;
+
+    /// Index every covered position so later matches can start inside it
+    while (advance--) {
+      if ((position + COMPRESS_MIN_MATCH) <= end) {
+        sl_compress_insert(position);
+      }
+      position++;
+    }
+  }
+
+  *output_len = out;
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to restore a compressed message.
+ *****************************************************************************/
+sl_status_t sl_decompress_message(const uint8_t *input,
+                                  uint32_t input_len,
+                                  uint8_t *output,
+                                  uint32_t output_size,
+                                  uint32_t *output_len)
+{
+  uint32_t in = COMPRESS_HEADER_SIZE;
+  uint32_t out = 0;
+  uint32_t distance;
+  uint32_t len;
+  uint8_t flags = 0;
+  uint8_t item_count = 8;
+
+  if ((input_len < COMPRESS_HEADER_SIZE) || (COMPRESS_MAGIC != input[0])
+      || (COMPRESS_FORMAT_VERSION != input[1])) {
+    return SL_STATUS_FAIL;
+  }
+
+  while (in < input_len) {
+    if (8 == item_count) {
+      flags = input[in++];
+      item_count = 0;
+      continue;
+    }
+
+    if (flags & (1 << item_count)) {
+      if ((in + 2) > input_len) {
+        return SL_STATUS_FAIL;
+      }
+      distance = ((((uint32_t)input[in] << 8) | input[in + 1])
+                  >> (16 - COMPRESS_OFFSET_BITS)) + 1;
+      len = (input[in + 1] & ((1 << (16 - COMPRESS_OFFSET_BITS)) - 1))
+            + COMPRESS_MIN_MATCH;
+      in += 2;
+
+      if (((out + len) > output_size)
+          || (distance > (out + COMPRESS_DICTIONARY_SIZE))) {
+        return SL_STATUS_FAIL;
+      }
+
+      /// Byte by byte, the copy may overlap its own output
+      while (len--) {
+        output[out] = (distance > out)
+                      ? (uint8_t)sl_compress_dictionary[COMPRESS_DICTIONARY_SIZE
+                                                        - (distance - out)]
+                      : output[out - distance];
+        out++;
+      }
+    } else {
+      if (out >= output_size) {
+        return SL_STATUS_FAIL;
+      }
+      output[out++] = input[in++];
+    }
+
+    item_count++;
+  }
+
+  *output_len = out;
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to hash three bytes.
+ *****************************************************************************/
+static uint32_t sl_compress_hash(const uint8_t *data)
+{
+  uint32_t value = ((uint32_t)data[0] << 16) | ((uint32_t)data[1] << 8)
+                   | data[2];
+
+  return (value * 2654435761u) >> (32 - COMPRESS_HASH_BITS);
+}
+
+/******************************************************************************
+ *  Function to add a position to its hash chain.
+ *****************************************************************************/
+static void sl_compress_insert(uint32_t position)
+{
+  uint32_t hash = sl_compress_hash(&sl_compress_history[position]);
+
+  sl_compress_prev[position] = sl_compress_head[hash];
+  sl_compress_head[hash] = (uint16_t)position;
+}
+
+/******************************************************************************
+ *  Function to build match tables of the dictionary once.
+ *****************************************************************************/
+static void sl_compress_prime(void)
+{
+  uint32_t position;
+
+  memcpy(sl_compress_history, sl_compress_dictionary, COMPRESS_DICTIONARY_SIZE);
+  memset(sl_compress_head, 0xFF, sizeof(sl_compress_head));
+
+  for (position = 0;
+       (position + COMPRESS_MIN_MATCH) <= COMPRESS_DICTIONARY_SIZE;
+       ++position) {
+    sl_compress_insert(position);
+  }
+
+  memcpy(sl_compress_dictionary_head,
+         sl_compress_head,
+         sizeof(sl_compress_dictionary_head));
+  sl_compress_is_primed = true;
+}
@@ -0,0 +1,169 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_device_identity.c
+ * @brief Cached device identity fields for JSON messages
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi.h>
+#include <sl_net.h>
+#include <sl_net_default_values.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_device_identity.h>
+
+/// @brief Structure for identity cache state
+typedef struct {
+  bool is_valid;                  ///< Identity matches the current connection
+  bool is_boot_fields_set;        ///< MAC address and firmware version are set
+  sl_device_identity_t identity;  ///< Preformatted identity strings
+} sl_device_identity_cache_t;
+
+/// Identity cache, written by the task which connects Wi-Fi while stale
+static sl_device_identity_cache_t sl_device_identity_cache;
+
+/**************************************************************************/ /**
+ * @brief Function to fetch and format fields which do not change until
+ * reboot.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when MAC address or firmware version read failed
+ ******************************************************************************/
+static sl_status_t sl_device_identity_set_boot_fields(void);
+
+/******************************************************************************
+ *  Function to fill the identity cache after Wi-Fi is connected.
+ *****************************************************************************/
+sl_status_t sl_device_identity_refresh(void)
+{
+  sl_status_t status;
+  sl_net_wifi_client_profile_t profile = { 0 };
+  sl_device_identity_t *identity = &sl_device_identity_cache.identity;
+
+  if (!sl_device_identity_cache.is_boot_fields_set) {
+    if (SL_STATUS_OK != sl_device_identity_set_boot_fields()) {
+      return SL_STATUS_FAIL;
+    }
+    sl_device_identity_cache.is_boot_fields_set = true;
+  }
+
+  /// Access point joined may differ from configured one after a rejoin
+  status = sl_net_get_profile(SL_NET_WIFI_CLIENT_INTERFACE,
+                              SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID,
+                              &profile);
+  if ((SL_STATUS_OK == status) && (0 != profile.config.ssid.length)
+      && (profile.config.ssid.length < DEVICE_IDENTITY_SSID_BUFF_SIZE)) {
+    memcpy(identity->ssid,
+           profile.config.ssid.value,
+           profile.config.ssid.length);
+    identity->ssid_len = profile.config.ssid.length;
+  } else {
+    identity->ssid_len = snprintf(identity->ssid,
+                                  DEVICE_IDENTITY_SSID_BUFF_SIZE,
+                                  "%s",
+                                  DEFAULT_WIFI_CLIENT_PROFILE_SSID);
+    if (identity->ssid_len >= DEVICE_IDENTITY_SSID_BUFF_SIZE) {
+      identity->ssid_len = DEVICE_IDENTITY_SSID_BUFF_SIZE - 1;
+    }
+  }
+  identity->ssid[identity->ssid_len] = '\0';
+
+  sl_device_identity_cache.is_valid = true;
+
+#if DEMO_CONFIG_DEBUG_LOGS
+  printf(
+    "\r\nsl_device_identity_refresh : MAC %s, SSID %s, firmware %s\r\n",
+    identity->mac,
+    identity->ssid,
+    identity->firmware_version);
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to mark the identity cache stale.
+ *****************************************************************************/
+void sl_device_identity_invalidate(void)
+{
+  sl_device_identity_cache.is_valid = false;
+}
+
+/******************************************************************************
+ *  Function to get the identity cache.
+ *****************************************************************************/
+const sl_device_identity_t *sl_device_identity_get(void)
+{
+  if (!sl_device_identity_cache.is_valid) {
+    return NULL;
+  }
+
+  return &sl_device_identity_cache.identity;
+}
+
+/******************************************************************************
+ *  Function to fetch and format fields which do not change until reboot.
+ *****************************************************************************/
+static sl_status_t sl_device_identity_set_boot_fields(void)
+{
+  sl_status_t status;
+  sl_mac_address_t mac_address;
+  sl_wifi_firmware_version_t firmware_version = { 0 };
+  sl_device_identity_t *identity = &sl_device_identity_cache.identity;
+
+  status = sl_wifi_get_mac_address(SL_WIFI_CLIENT_INTERFACE, &mac_address);
+  if (SL_STATUS_OK != status) {
+    printf(
+      "\r\nsl_device_identity_set_boot_fields : Failed to get MAC address: 0x%lx\r\n",
+      status);
+    return SL_STATUS_FAIL;
+  }
+
+  status = sl_wifi_get_firmware_version(&firmware_version);
+  if (SL_STATUS_OK != status) {
+    printf(
+      "\r\nsl_device_identity_set_boot_fields : Failed to get firmware version: 0x%lx\r\n",
+      status);
+    return SL_STATUS_FAIL;
+  }
+
+  identity->mac_len = snprintf(identity->mac,
+                               DEVICE_IDENTITY_MAC_BUFF_SIZE,
+                               "%02X:%02X:%02X:%02X:%02X:%02X",
+                               mac_address.octet[0],
+                               mac_address.octet[1],
+                               mac_address.octet[2],
+                               mac_address.octet[3],
+                               mac_address.octet[4],
+                               mac_address.octet[5]);
+
+  identity->firmware_version_len = snprintf(identity->firmware_version,
+                                            DEVICE_IDENTITY_FIRMWARE_BUFF_SIZE,
+                                            "%x%x.%d.%d.%d.%d.%d.%d",
+                                            firmware_version.chip_id,
+                                            firmware_version.rom_id,
+                                            firmware_version.major,
+                                            firmware_version.minor,
+                                            firmware_version.security_version,
+                                            firmware_version.patch_num,
+                                            firmware_version.customer_id,
+                                            firmware_version.build_num);
+
+  printf(
+    "\r\nsl_device_identity_set_boot_fields : MAC address: %s, firmware version: %s\r\n",
+    identity->mac,
+    identity->firmware_version);
+
+  return SL_STATUS_OK;
+}
@@ -0,0 +1,335 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_dns_cache.c
+ * @brief Host name resolution cache shared by cloud, SNTP and HTTP clients
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_net.h>
+#include <sl_net_dns.h>
+#include <nvm3_default.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_dns_cache.h>
+
+/// Cached host name resolutions
+static sl_dns_cache_entry_t sl_dns_cache_entries[DNS_CACHE_MAX_ENTRIES];
+
+/**************************************************************************/ /**
+ * @brief Find cache entry of a host name. Cache mutex must be held.
+ * @param[in] host_name : null terminated host name.
+ * @return pointer to the entry, NULL if host name is not cached.
+ ******************************************************************************/
+static sl_dns_cache_entry_t *sl_dns_cache_find(const char *host_name);
+
+/**************************************************************************/ /**
+ * @brief Store a resolution, reusing the entry of the host name or the oldest
+ * entry. Cache mutex must be held.
+ * @param[in] host_name : null terminated host name.
+ * @param[in] address : resolved address.
+ * @return true if the stored address differs from the previous one.
+ ******************************************************************************/
+static bool sl_dns_cache_store(const char *host_name,
+                               const sl_ip_address_t *address);
+
+/**************************************************************************/ /**
+ * @brief Write all valid entries to NVM3. Cache mutex must be held.
+ ******************************************************************************/
+static void sl_dns_cache_persist(void);
+
+/******************************************************************************
+ *  Function to initialize DNS cache and restore persisted resolutions.
+ *****************************************************************************/
+sl_status_t sl_dns_cache_init(void)
+{
+  sl_dns_cache_nvm3_record_t record;
+  uint32_t object_type;
+  size_t object_size;
+  uint8_t index;
+
+  memset(sl_dns_cache_entries, 0, sizeof(sl_dns_cache_entries));
+
+  if (ECODE_NVM3_OK != nvm3_initDefault()) {
+    printf("\r\nsl_dns_cache_init : NVM3 initialization failed\r\n");
+    return SL_STATUS_FAIL;
+  }
+
+  /// Nothing persisted yet or layout changed, start with an empty cache
+  if ((ECODE_NVM3_OK
+       != nvm3_getObjectInfo(nvm3_defaultHandle,
+                             DNS_CACHE_NVM3_KEY,
+                             &object_type,
+                             &object_size))
+      || (sizeof(record) != object_size)) {
+    return SL_STATUS_OK;
+  }
+
+  if ((ECODE_NVM3_OK
+       != nvm3_readData(nvm3_defaultHandle,
+                        DNS_CACHE_NVM3_KEY,
+                        &record,
+                        sizeof(record)))
+      || (DNS_CACHE_NVM3_MAGIC != record.magic)) {
+    return SL_STATUS_OK;
+  }
+
+  for (index = 0; index < DNS_CACHE_MAX_ENTRIES; ++index) {
+    record.entry[index].host_name[DNS_CACHE_MAX_HOST_NAME_LENGTH - 1] = '\0';
+
+    if ('\0' == record.entry[index].host_name[0]) {
+      continue;
+    }
+
+    /// Age of a restored entry is unknown, so it is stale until revalidated
+    sl_dns_cache_entries[index].is_valid = true;
+    sl_dns_cache_entries[index].is_stale = true;
+    strcpy(sl_dns_cache_entries[index].host_name,
+           record.entry[index].host_name);
+    sl_dns_cache_entries[index].address.type = SL_IPV4;
+    memcpy(sl_dns_cache_entries[index].address.ip.v4.bytes,
+           record.entry[index].ipv4,
+           sizeof(record.entry[index].ipv4));
+    sl_dns_cache_entries[index].ttl = record.entry[index].ttl;
+
+#if DEMO_CONFIG_DEBUG_LOGS
+    printf("\r\nsl_dns_cache_init : restored %s\r\n",
+           sl_dns_cache_entries[index].host_name);
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to resolve a host name through the DNS cache.
+ *****************************************************************************/
+sl_status_t sl_dns_cache_resolve_hostname(const char *host_name,
+                                          uint32_t timeout,
+                                          uint8_t max_attempts,
+                                          sl_ip_address_t *address)
+{
+  sl_status_t status = SL_STATUS_FAIL;
+  sl_dns_cache_entry_t *entry;
+  sl_ip_address_t stale_address = { 0 };
+  bool is_stale_available = false;
+  bool is_changed;
+  uint8_t attempt;
+
+  if ((NULL == host_name) || (NULL == address)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Host names which do not fit in an entry bypass the cache
+  if (strlen(host_name) >= DNS_CACHE_MAX_HOST_NAME_LENGTH) {
+    for (attempt = 0; attempt < max_attempts; ++attempt) {
+      status = sl_net_dns_resolve_hostname(host_name,
+                                           timeout,
+                                           SL_NET_DNS_TYPE_IPV4,
+                                           address);
+      if (SL_STATUS_OK == status) {
+        break;
+      }
+    }
+    return status;
+  }
+
+  if (pdTRUE
+      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        dns_cache_mutex_handler,
+                        portMAX_DELAY)) {
+    entry = sl_dns_cache_find(host_name);
+
+    if (NULL != entry) {
+      if ((!entry->is_stale)
+          && ((xTaskGetTickCount() - entry->resolved_tick)
+              < pdMS_TO_TICKS(entry->ttl))) {
+        /// Fresh entry, no network access required
+        *address = entry->address;
+        xSemaphoreGive(
+          sl_get_wifi_asset_tracking_resource()->dns_cache_mutex_handler);
+        return SL_STATUS_OK;
+      }
+
+      stale_address = entry->address;
+      is_stale_available = true;
+    }
+
+    xSemaphoreGive(
+      sl_get_wifi_asset_tracking_resource()->dns_cache_mutex_handler);
+  }
+
+  /// With a stale address in hand, spend only one short request on revalidation
+  if (is_stale_available) {
+    max_attempts = 1;
+    timeout = DNS_CACHE_REVALIDATE_TIMEOUT;
+  }
+
+  for (attempt = 0; attempt < max_attempts; ++attempt) {
+    status = sl_net_dns_resolve_hostname(host_name,
+                                         timeout,
+                                         SL_NET_DNS_TYPE_IPV4,
+                                         address);
+    if (SL_STATUS_OK == status) {
+      break;
+    }
+  }
+
+  if (SL_STATUS_OK == status) {
+    if (pdTRUE
+        == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                          dns_cache_mutex_handler,
+                          portMAX_DELAY)) {
+      is_changed = sl_dns_cache_store(host_name, address);
+
+      /// Only write flash when an address actually changed
+      if (is_changed) {
+        sl_dns_cache_persist();
+      }
+
+      xSemaphoreGive(
+        sl_get_wifi_asset_tracking_resource()->dns_cache_mutex_handler);
+    }
+    return SL_STATUS_OK;
+  }
+
+  if (is_stale_available) {
+    printf(
+      "\r\nsl_dns_cache_resolve_hostname : resolver unreachable, using cached address of %s\r\n",
+      host_name);
+    *address = stale_address;
+    return SL_STATUS_OK;
+  }
+
+  return SL_STATUS_FAIL;
+}
+
+/******************************************************************************
+ *  Function to mark cached resolution of a host name stale.
+ *****************************************************************************/
+void sl_dns_cache_invalidate(const char *host_name)
+{
+  sl_dns_cache_entry_t *entry;
+
+  if (NULL == host_name) {
+    return;
+  }
+
+  if (pdTRUE
+      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        dns_cache_mutex_handler,
+                        portMAX_DELAY)) {
+    entry = sl_dns_cache_find(host_name);
+
+    /// Address is kept as fallback and persisted value is still the last
+    /// known one, so flash is not written
+    if (NULL != entry) {
+      entry->is_stale = true;
+    }
+
+    xSemaphoreGive(
+      sl_get_wifi_asset_tracking_resource()->dns_cache_mutex_handler);
+  }
+}
+
+/******************************************************************************
+ *  Find cache entry of a host name.
+ *****************************************************************************/
+static sl_dns_cache_entry_t *sl_dns_cache_find(const char *host_name)
+{
+  uint8_t index;
+
+  for (index = 0; index < DNS_CACHE_MAX_ENTRIES; ++index) {
+    if (sl_dns_cache_entries[index].is_valid
+        && (0 == strcmp(sl_dns_cache_entries[index].host_name, host_name))) {
+      return &sl_dns_cache_entries[index];
+    }
+  }
+
+  return NULL;
+}
+
+/******************************************************************************
+ *  Store a resolution in the cache.
+ *****************************************************************************/
+static bool sl_dns_cache_store(const char *host_name,
+                               const sl_ip_address_t *address)
+{
+  sl_dns_cache_entry_t *entry;
+  TickType_t now = xTaskGetTickCount();
+  bool is_changed = true;
+  uint8_t index;
+
+  entry = sl_dns_cache_find(host_name);
+
+  if (NULL != entry) {
+    is_changed = (0 != memcmp(entry->address.ip.v4.bytes,
+                              address->ip.v4.bytes,
+                              sizeof(address->ip.v4.bytes)));
+  } else {
+    /// Use a free entry, else evict the least recently resolved one
+    entry = &sl_dns_cache_entries[0];
+    for (index = 0; index < DNS_CACHE_MAX_ENTRIES; ++index) {
+      if (!sl_dns_cache_entries[index].is_valid) {
+        entry = &sl_dns_cache_entries[index];
+        break;
+      }
+      if ((now - sl_dns_cache_entries[index].resolved_tick)
+          > (now - entry->resolved_tick)) {
+        entry = &sl_dns_cache_entries[index];
+      }
+    }
+    memset(entry, 0, sizeof(sl_dns_cache_entry_t));
+    strcpy(entry->host_name, host_name);
+  }
+
+  entry->is_valid = true;
+  entry->is_stale = false;
+  entry->address = *address;
+  entry->resolved_tick = now;
+  entry->ttl = DNS_CACHE_DEFAULT_TTL;
+
+  return is_changed;
+}
+
+/******************************************************************************
+ *  Write all valid entries to NVM3.
+ *****************************************************************************/
+static void sl_dns_cache_persist(void)
+{
+  sl_dns_cache_nvm3_record_t record;
+  uint8_t index;
+
+  memset(&record, 0, sizeof(record));
+  record.magic = DNS_CACHE_NVM3_MAGIC;
+
+  for (index = 0; index < DNS_CACHE_MAX_ENTRIES; ++index) {
+    if (!sl_dns_cache_entries[index].is_valid) {
+      continue;
+    }
+    strcpy(record.entry[index].host_name,
+           sl_dns_cache_entries[index].host_name);
+    memcpy(record.entry[index].ipv4,
+           sl_dns_cache_entries[index].address.ip.v4.bytes,
+           sizeof(record.entry[index].ipv4));
+    record.entry[index].ttl = sl_dns_cache_entries[index].ttl;
+  }
+
+  if (ECODE_NVM3_OK
+      != nvm3_writeData(nvm3_defaultHandle,
+                        DNS_CACHE_NVM3_KEY,
+                        &record,
+                        sizeof(record))) {
+    printf("\r\nsl_dns_cache_persist : failed to persist DNS cache\r\n");
+  }
+}
@@ -0,0 +1,142 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_event_bus.c
+ * @brief Publish/subscribe of connectivity and sensor state changes
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_event_bus.h>
+
+#if (configTASK_NOTIFICATION_ARRAY_ENTRIES <= EVENT_BUS_NOTIFY_INDEX)
+#error "event bus needs configTASK_NOTIFICATION_ARRAY_ENTRIES above EVENT_BUS_NOTIFY_INDEX"
+#endif
+
+_Static_assert(SL_EVENT_COUNT <= 32, "events are bits of a notification value");
+
+/// @brief Structure for a subscriber table entry
+typedef struct {
+  sl_static_task_e task;          ///< Subscribed task
+  uint32_t events;                ///< SL_EVENT_BIT of subscribed events
+  sl_event_delivery_e delivery;   ///< How events reach the task
+} sl_event_bus_subscriber_t;
+
+/// @brief Structure for event bus state
+typedef struct {
+  sl_event_bus_subscriber_t subscriber[EVENT_BUS_MAX_SUBSCRIBERS];  ///< Subscriber table
+  uint8_t count;                                                    ///< Used entries
+} sl_event_bus_t;
+
+/// Event bus state, the table is only changed and walked in critical sections
+static sl_event_bus_t sl_event_bus;
+
+/******************************************************************************
+ *  Function to clear the subscriber table.
+ *****************************************************************************/
+void sl_event_bus_init(void)
+{
+  memset(&sl_event_bus, 0, sizeof(sl_event_bus));
+}
+
+/******************************************************************************
+ *  Function to subscribe a task to events.
+ *****************************************************************************/
+sl_status_t sl_event_bus_subscribe(sl_static_task_e task,
+                                   uint32_t events,
+                                   sl_event_delivery_e delivery)
+{
+  sl_status_t status = SL_STATUS_OK;
+  uint8_t index;
+
+  taskENTER_CRITICAL();
+  for (index = 0; index < sl_event_bus.count; index++) {
+    if (task == sl_event_bus.subscriber[index].task) {
+      break;
+    }
+  }
+
+  if (index == sl_event_bus.count) {
+    if (EVENT_BUS_MAX_SUBSCRIBERS == sl_event_bus.count) {
+      status = SL_STATUS_FULL;
+    } else {
+      sl_event_bus.subscriber[index].task = task;
+      sl_event_bus.subscriber[index].events = 0;
+      sl_event_bus.count++;
+    }
+  }
+
+  if (SL_STATUS_OK == status) {
+    sl_event_bus.subscriber[index].events |= events;
+    sl_event_bus.subscriber[index].delivery = delivery;
+  }
+  taskEXIT_CRITICAL();
+
+  if (SL_STATUS_OK != status) {
+    printf("\r\nsl_event_bus_subscribe : subscriber table is full\r\n");
+  }
+
+  return status;
+}
+
+/******************************************************************************
+ *  Function to deliver an event to every subscribed task.
+ *****************************************************************************/
+void sl_event_bus_publish(sl_event_e event)
+{
+  TaskHandle_t task_handle;
+  uint8_t index;
+
+  /// Handles are read and notified together, a task deleted meanwhile is
+  /// seen with a NULL handle
+  taskENTER_CRITICAL();
+  for (index = 0; index < sl_event_bus.count; index++) {
+    if (0 == (sl_event_bus.subscriber[index].events & SL_EVENT_BIT(event))) {
+      continue;
+    }
+
+    task_handle = sl_static_get_task_handle(sl_event_bus.subscriber[index].task);
+    if (NULL == task_handle) {
+      continue;
+    }
+
+    if (SL_EVENT_DELIVERY_BITS == sl_event_bus.subscriber[index].delivery) {
+      xTaskNotifyIndexed(task_handle,
+                         EVENT_BUS_NOTIFY_INDEX,
+                         SL_EVENT_BIT(event),
+                         eSetBits);
+    } else {
+      xTaskNotifyGive(task_handle);
+    }
+  }
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to wait for events of the calling task.
+ *****************************************************************************/
+uint32_t sl_event_bus_wait(TickType_t timeout)
+{
+  uint32_t events = 0;
+
+  if (pdTRUE
+      != xTaskNotifyWaitIndexed(EVENT_BUS_NOTIFY_INDEX,
+                                0,
+                                UINT32_MAX,
+                                &events,
+                                timeout)) {
+    return 0;
+  }
+
+  return events;
+}
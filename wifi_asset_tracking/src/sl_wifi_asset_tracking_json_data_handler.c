@@ -18,12 +18,43 @@
 #include <string.h>
 #include <sl_si91x_calendar.h>
 #include <azure_iot_json_writer.h>
-#include <sl_net_default_values.h>
 #include <sl_wifi_asset_tracking_app.h>
 #include <sl_wifi_asset_tracking_json_data_handler.h>
 #include <sl_wifi_asset_tracking_wifi_handler.h>
 #include <sl_wifi_asset_tracking_demo_config.h>
 
+/// Sampling intervals in seconds reported by the last heartbeat
+static int32_t sl_json_heartbeat_intervals[MAX_INTERVAL_VALUES_SIZE];
+
+/// Tick count of the last heartbeat
+static TickType_t sl_json_heartbeat_tick;
+
+/// Cleared to send the full heartbeat with the next keep alive check
+static bool sl_json_is_heartbeat_sent;
+
+/**************************************************************************/ /**
+ * @brief Function to get the sampling intervals currently in use, including
+ * the stretch applied by the publish rate limiter.
+ * @param[out] intervals : wi-fi, temperature and RH, IMU and GNSS intervals
+ * in seconds.
+ ******************************************************************************/
+static void sl_json_get_sampling_intervals(int32_t *intervals);
+
+/**************************************************************************/ /**
+ * @brief Function to send one diagnostics JSON message with up to
+ * METRICS_VALUES_PER_MESSAGE snapshot values.
+ * @param[in] snapshot : metrics snapshot.
+ * @param[in] first : index of first value to send.
+ * @param[in] timestamp_buff : time-stamp of the snapshot.
+ * @return  The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on message sending failure.
+ ******************************************************************************/
+static sl_status_t sl_json_send_diagnostics_part(
+  const sl_metrics_snapshot_t *snapshot,
+  uint32_t first,
+  const uint8_t *timestamp_buff);
+
 /******************************************************************************
  *  Callback function to convert bmi270 data format to JSON data format.
  *****************************************************************************/
@@ -235,23 +266,16 @@ sl_status_t sl_convert_bmi270_reading_to_json_format(
   /// Update length of MQTT buffer
   bmi270_json_data.mqtt_buffer_len = AzureIoTJSONWriter_GetBytesUsed(
     &bmi270_writer);
-
-  /// Acquire MQTT data queue mutex and send data to MQTT data queue
-  if (pdTRUE
-      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                        mqtt_package_queue_mutex_handler,
-                        portMAX_DELAY)) {
-    if (pdTRUE
-        == xQueueSend(sl_get_wifi_asset_tracking_resource()->
-                      mqtt_package_queue_handler,
-                      &bmi270_json_data, 0)) {
-#if DEMO_CONFIG_DEBUG_LOGS
-      printf(
-        "\r\nsl_convert_bmi270_reading_to_json_format : JSON format data is sent to the MQTT data queue\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
-    }
-    xSemaphoreGive(
-      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+  bmi270_json_data.sample_tick = sensor_data_queue_reading->sample_tick;
+
+  /// Sensor disconnect notice goes on the critical lane
+  if (SL_STATUS_OK
+      == sl_publish_lane_enqueue(
+        sensor_data_queue_reading->is_sensor_data_available
+        ? SL_PUBLISH_LANE_BULK : SL_PUBLISH_LANE_CRITICAL,
+        SL_PUBLISH_LANE_SOURCE_IMU_SENSOR,
+        &bmi270_json_data)) {
+    SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_BMI270_ENQUEUED);
   }
 
   return SL_STATUS_OK;
@@ -455,23 +479,16 @@ sl_status_t sl_convert_gnss_reading_to_json_format(
   /// Update length of MQTT buffer
   gnss_json_data.mqtt_buffer_len =
     AzureIoTJSONWriter_GetBytesUsed(&gnss_writer);
-
-  /// Acquire MQTT data queue mutex and send data to MQTT data queue
-  if (pdTRUE
-      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                        mqtt_package_queue_mutex_handler,
-                        portMAX_DELAY)) {
-    if (pdTRUE
-        == xQueueSend(sl_get_wifi_asset_tracking_resource()->
-                      mqtt_package_queue_handler,
-                      &gnss_json_data, 0)) {
-#if DEMO_CONFIG_DEBUG_LOGS
-      printf(
-        "\r\nsl_convert_gnss_reading_to_json_format : JSON format data is sent to the MQTT data queue\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
-    }
-    xSemaphoreGive(
-      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+  gnss_json_data.sample_tick = sensor_data_queue_reading->sample_tick;
+
+  /// Sensor disconnect notice goes on the critical lane
+  if (SL_STATUS_OK
+      == sl_publish_lane_enqueue(
+        sensor_data_queue_reading->is_sensor_data_available
+        ? SL_PUBLISH_LANE_NORMAL : SL_PUBLISH_LANE_CRITICAL,
+        SL_PUBLISH_LANE_SOURCE_GNSS_RECEIVER,
+        &gnss_json_data)) {
+    SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_GNSS_ENQUEUED);
   }
 
   return SL_STATUS_OK;
@@ -690,23 +707,16 @@ sl_status_t sl_convert_si7021_reading_to_json_format(
   /// Update length of MQTT buffer
   si7021_json_data.mqtt_buffer_len = AzureIoTJSONWriter_GetBytesUsed(
     &si7021_writer);
-
-  /// Acquire MQTT data queue mutex and send data to MQTT data queue
-  if (pdTRUE
-      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                        mqtt_package_queue_mutex_handler,
-                        portMAX_DELAY)) {
-    if (pdTRUE
-        == xQueueSend(sl_get_wifi_asset_tracking_resource()->
-                      mqtt_package_queue_handler,
-                      &si7021_json_data, 0)) {
-#if DEMO_CONFIG_DEBUG_LOGS
-      printf(
-        "\r\nsl_convert_si7021_reading_to_json_format : JSON format data is sent to the MQTT data queue\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
-    }
-    xSemaphoreGive(
-      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+  si7021_json_data.sample_tick = sensor_data_queue_reading->sample_tick;
+
+  /// Sensor disconnect notice goes on the critical lane
+  if (SL_STATUS_OK
+      == sl_publish_lane_enqueue(
+        sensor_data_queue_reading->is_sensor_data_available
+        ? SL_PUBLISH_LANE_BULK : SL_PUBLISH_LANE_CRITICAL,
+        SL_PUBLISH_LANE_SOURCE_TEMP_RH_SENSOR,
+        &si7021_json_data)) {
+    SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_SI7021_ENQUEUED);
   }
 
   return SL_STATUS_OK;
@@ -759,42 +769,20 @@ sl_status_t sl_convert_to_json_format(
  *****************************************************************************/
 void sl_json_data_converter_task()
 {
-  sl_wifi_asset_tracking_mqtt_package_queue_data_t mqtt_data_queue_reading;
   sl_wifi_asset_tracking_sensor_queue_data_t sensor_data_queue_reading;
-  sl_status_t status;
   while (1) {
+    sl_supervisor_check_in(SL_SUPERVISOR_CLIENT_JSON_DATA_CONVERTER);
+
     /// Check if sensor data queue is empty
     if (QUEUE_EMPTY
         == uxQueueMessagesWaiting(sl_get_wifi_asset_tracking_resource()->
                                   sensor_data_queue_handler)) {
-#if DEMO_CONFIG_DEBUG_LOGS
-      printf(
-        "\r\njson_task : suspend json task as sensor data queue is empty\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
-      vTaskSuspend(
-        sl_get_wifi_asset_tracking_resource()->task_list.json_data_converter_task_handler);
+      SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_WAIT_EMPTY);
+      /// Sensor tasks notify after every reading, a reading queued since the
+      /// check above left a notification pending and the wait returns at once
+      sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_JSON_DATA_CONVERTER);
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     } else {
-      /// Check whether MQTT data queue is full
-      if (MAX_SIZE_OF_MQTT_PACKAGE_QUEUE
-          == uxQueueMessagesWaiting(sl_get_wifi_asset_tracking_resource()->
-                                    sensor_data_queue_handler)) {
-        /// Acquire MQTT data queue mutex and recieve data from MQTT data queue
-        if (pdTRUE
-            == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                              mqtt_package_queue_mutex_handler,
-                              portMAX_DELAY)) {
-          xQueueReceive(
-            sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_handler,
-            &mqtt_data_queue_reading,
-            0);
-          printf(
-            "\r\njson_task : Data is released from the MQTT data queue as it is full\r\n");
-        }
-
-        xSemaphoreGive(
-          sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
-      }
-
       /// Acquire sensor data queue mutex and receive data from sensor data queue
       if (pdTRUE
           == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
@@ -804,26 +792,24 @@ void sl_json_data_converter_task()
           sl_get_wifi_asset_tracking_resource()->sensor_data_queue_handler,
           &sensor_data_queue_reading,
           0);
-#if DEMO_CONFIG_DEBUG_LOGS
-        printf(
-          "\r\njson_task : Sensor data is received from the sensor data queue for conversion to JSON format\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+        SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_RECEIVED);
       }
 
+      sl_metrics_observe(SL_METRIC_SAMPLE_HANDOFF,
+                         (uint32_t)(((xTaskGetTickCount()
+                                      - sensor_data_queue_reading.sample_tick)
+                                     * portTICK_PERIOD_MS)
+                                    / TIMER_CLOCK_OFFSET));
+
       xSemaphoreGive(
         sl_get_wifi_asset_tracking_resource()->sensor_data_queue_mutex_handler);
 
-      /// Convert sensor data into json format
-      status = sl_convert_to_json_format(&sensor_data_queue_reading);
-
-      if (SL_STATUS_OK == status) {
-        /// Check whether Azure cloud communication task is suspended
-        if (eSuspended
-            == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                             azure_cloud_communication_task_handler)) {
-          vTaskResume(
-            sl_get_wifi_asset_tracking_resource()->task_list.azure_cloud_communication_task_handler);
-        }
+      /// Convert sensor data into json format, publish lane wakes the cloud task
+      if (SL_STATUS_OK
+          == sl_convert_to_json_format(&sensor_data_queue_reading)) {
+        sl_metrics_increment(SL_METRIC_JSON_MESSAGES);
+      } else {
+        sl_metrics_increment(SL_METRIC_JSON_FAILURES);
       }
     }
   }
@@ -838,6 +824,7 @@ sl_status_t sl_json_send_new_session_message()
   AzureIoTJSONWriter_t new_session_writer;
   AzureIoTResult_t writer_status;
   uint8_t timestamp_buff[JSON_MAX_TIMESTAMP_BUFF_SIZE];
+  const sl_device_identity_t *identity = sl_device_identity_get();
 
   /// If failed to fetch time-stamp then discard the packet
   if (SL_STATUS_OK != sl_json_get_timestamp(timestamp_buff)) {
@@ -921,6 +908,25 @@ sl_status_t sl_json_send_new_session_message()
     goto error;
   }
 
+  /// Append firmware version property, once per session
+  if (NULL != identity) {
+    writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+      &new_session_writer,
+      (const
+       uint8_t *)JSON_PROPERTY_FIRMWARE,
+      strlen(
+        JSON_PROPERTY_FIRMWARE),
+      (const
+       uint8_t *)identity->firmware_version,
+      identity->firmware_version_len);
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_new_session_message : Failed to append firmware version property error code: %d\r\n",
+        writer_status);
+      goto error;
+    }
+  }
+
   /// Append close object
   writer_status = AzureIoTJSONWriter_AppendEndObject(&new_session_writer);
   if (writer_status != eAzureIoTSuccess) {
@@ -933,24 +939,16 @@ sl_status_t sl_json_send_new_session_message()
   /// Update length of MQTT buffer
   new_session_message.mqtt_buffer_len = AzureIoTJSONWriter_GetBytesUsed(
     &new_session_writer);
+  new_session_message.sample_tick = 0;
 
-  /// Acquire MQTT data queue mutex
-  if (pdTRUE
-      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                        mqtt_package_queue_mutex_handler,
-                        portMAX_DELAY)) {
-    /// send data to MQTT data queue - If queue is full no need to receive and send it again
-    xQueueSend(
-      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_handler,
-      &new_session_message,
-      0);
-    xSemaphoreGive(
-      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
-  }
-#if DEMO_CONFIG_DEBUG_LOGS
-  printf(
-    "\r\nsl_json_send_new_session_message : JSON format data is sent to the MQTT data queue\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+  /// Session start is published ahead of queued samples
+  if (SL_STATUS_OK
+      != sl_publish_lane_enqueue(SL_PUBLISH_LANE_CRITICAL,
+                                 SL_PUBLISH_LANE_SOURCE_SESSION,
+                                 &new_session_message)) {
+    goto error;
+  }
+  SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_SESSION_ENQUEUED);
 
   return SL_STATUS_OK;
   error:
@@ -966,7 +964,7 @@ sl_status_t sl_json_send_wifi_message()
   AzureIoTJSONWriter_t wifi_data_writer;
   AzureIoTResult_t writer_status;
   uint8_t timestamp_buff[JSON_MAX_TIMESTAMP_BUFF_SIZE];
-  uint8_t mac_address_buff[JSON_MAX_MAC_ADDR_BUFF_SIZE];
+  const sl_device_identity_t *identity;
   int32_t rssi;
 
   /// If failed to fetch time-stamp then return failure
@@ -976,17 +974,18 @@ sl_status_t sl_json_send_wifi_message()
     goto error;
   }
 
-  /// If failed to fetch RSSI then return failure
-  if (SL_STATUS_OK != sl_get_wifi_rssi(&rssi)) {
+  /// RSSI sampled by link monitor, failure when the link is down
+  if (SL_STATUS_OK != sl_link_monitor_get_rssi(&rssi)) {
     printf(
       "\r\nsl_json_send_wifi_message : failed to fetch RSSI, discarding the packet\r\n");
     goto wifi_failure;
   }
 
-  /// If failed to fetch MAC address then return failure
-  if (SL_STATUS_OK != sl_get_wifi_mac_address(mac_address_buff)) {
+  /// Identity is stale while Wi-Fi reconnects
+  identity = sl_device_identity_get();
+  if (NULL == identity) {
     printf(
-      "\r\nsl_json_send_wifi_message : failed to fetch MAC Address, discarding the packet\r\n");
+      "\r\nsl_json_send_wifi_message : device identity is not available, discarding the packet\r\n");
     goto wifi_failure;
   }
 
@@ -1076,9 +1075,8 @@ sl_status_t sl_json_send_wifi_message()
     strlen(
       JSON_PROPERTY_MACID),
     (const
-     uint8_t *)mac_address_buff,
-    strlen((char
-            *)mac_address_buff));
+     uint8_t *)identity->mac,
+    identity->mac_len);
   if (writer_status != eAzureIoTSuccess) {
     printf(
       "\r\nsl_json_send_wifi_message : Failed to append macid key value pair error code: %d\r\n",
@@ -1094,9 +1092,8 @@ sl_status_t sl_json_send_wifi_message()
     strlen(
       JSON_PROPERTY_SSID),
     (const
-     uint8_t *)DEFAULT_WIFI_CLIENT_PROFILE_SSID,
-    strlen(
-      DEFAULT_WIFI_CLIENT_PROFILE_SSID));
+     uint8_t *)identity->ssid,
+    identity->ssid_len);
   if (writer_status != eAzureIoTSuccess) {
     printf(
       "\r\nsl_json_send_wifi_message : Failed to append SSID key value pair error code: %d\r\n",
@@ -1140,43 +1137,354 @@ sl_status_t sl_json_send_wifi_message()
   /// Update length of MQTT buffer
   wifi_data.mqtt_buffer_len =
     AzureIoTJSONWriter_GetBytesUsed(&wifi_data_writer);
+  wifi_data.sample_tick = 0;
+
+  /// Lane drops the oldest message when it is full
+  if (SL_STATUS_OK
+      != sl_publish_lane_enqueue(SL_PUBLISH_LANE_NORMAL,
+                                 SL_PUBLISH_LANE_SOURCE_WIFI,
+                                 &wifi_data)) {
+    goto error;
+  }
+  SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_WIFI_ENQUEUED);
+
+  return SL_STATUS_OK;
+  error:
+  return SL_STATUS_FAIL;
+  wifi_failure:
+  return SL_STATUS_WIFI_CONNECTION_LOST;
+}
+
+/*****************************************************************************
+ * Function to scan neighbouring access points and send them as Wi-Fi scan
+ * JSON message to MQTT package queue.
+ ******************************************************************************/
+sl_status_t sl_json_send_wifi_scan_message()
+{
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t scan_data;
+  AzureIoTJSONWriter_t scan_data_writer;
+  AzureIoTResult_t writer_status;
+  sl_wifi_fingerprint_t fingerprint;
+  uint8_t timestamp_buff[JSON_MAX_TIMESTAMP_BUFF_SIZE];
+  char fingerprint_buff[WIFI_FINGERPRINT_MAX_TEXT_SIZE];
+
+  /// If failed to fetch time-stamp then return failure
+  if (SL_STATUS_OK != sl_json_get_timestamp(timestamp_buff)) {
+    printf(
+      "\r\nsl_json_send_wifi_scan_message : failed to fetch time-stamp, discarding the packet\r\n");
+    goto error;
+  }
+
+  if (SL_STATUS_OK != sl_scan_wifi_fingerprint(&fingerprint)) {
+    goto error;
+  }
+
+  if (SL_STATUS_OK != sl_wifi_fingerprint_encode(&fingerprint,
+                                                 fingerprint_buff,
+                                                 sizeof(fingerprint_buff))) {
+    printf(
+      "\r\nsl_json_send_wifi_scan_message : failed to encode access points\r\n");
+    goto error;
+  }
+
+  /// Initialize the JSON writer
+  writer_status = AzureIoTJSONWriter_Init(&scan_data_writer,
+                                          scan_data.mqtt_buffer,
+                                          sizeof(scan_data.mqtt_buffer));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_wifi_scan_message : Failed to initialize JSON writer error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Construct the JSON message - append begin object
+  writer_status = AzureIoTJSONWriter_AppendBeginObject(&scan_data_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_wifi_scan_message : Append main begin object failed error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append message type property
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+    &scan_data_writer,
+    (const uint8_t *)JSON_PROPERTY_MSGTYPE,
+    strlen(JSON_PROPERTY_MSGTYPE),
+    (const uint8_t *)JSON_PROPERTY_WIFI_SCAN,
+    strlen(JSON_PROPERTY_WIFI_SCAN));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_wifi_scan_message : Failed to append message type error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append time-stamp property
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+    &scan_data_writer,
+    (const uint8_t *)JSON_PROPERTY_TIMESTAMP,
+    strlen(JSON_PROPERTY_TIMESTAMP),
+    (const uint8_t *)timestamp_buff,
+    strlen((char *)timestamp_buff));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_wifi_scan_message : Failed to append time-stamp property error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append encoded access points, decoded by the dashboard backend
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+    &scan_data_writer,
+    (const uint8_t *)JSON_PROPERTY_WIFI_SCAN,
+    strlen(JSON_PROPERTY_WIFI_SCAN),
+    (const uint8_t *)fingerprint_buff,
+    strlen(fingerprint_buff));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_wifi_scan_message : Failed to append access points error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// append close main object
+  writer_status = AzureIoTJSONWriter_AppendEndObject(&scan_data_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_wifi_scan_message : Failed to append main close object error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Update length of MQTT buffer
+  scan_data.mqtt_buffer_len =
+    AzureIoTJSONWriter_GetBytesUsed(&scan_data_writer);
+  scan_data.sample_tick = 0;
+
+  /// Lane drops the oldest message when it is full
+  if (SL_STATUS_OK
+      != sl_publish_lane_enqueue(SL_PUBLISH_LANE_NORMAL,
+                                 SL_PUBLISH_LANE_SOURCE_WIFI_SCAN,
+                                 &scan_data)) {
+    goto error;
+  }
+  SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_WIFI_SCAN_ENQUEUED);
+
+  return SL_STATUS_OK;
+  error:
+  return SL_STATUS_FAIL;
+}
+
+/*****************************************************************************
+ * Function to send Wi-Fi link state change as link JSON message to MQTT
+ * package queue.
+ ******************************************************************************/
+sl_status_t sl_json_send_link_message(const sl_link_monitor_stats_t *stats)
+{
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t link_data;
+  AzureIoTJSONWriter_t link_data_writer;
+  AzureIoTResult_t writer_status;
+  uint8_t timestamp_buff[JSON_MAX_TIMESTAMP_BUFF_SIZE];
+  const char *state;
+
+  /// If failed to fetch time-stamp then return failure
+  if (SL_STATUS_OK != sl_json_get_timestamp(timestamp_buff)) {
+    printf(
+      "\r\nsl_json_send_link_message : failed to fetch time-stamp, discarding the packet\r\n");
+    goto error;
+  }
+
+  state = (SL_LINK_STATE_UP == stats->state)
+          ? JSON_PROPERTY_LINK_UP : JSON_PROPERTY_LINK_DOWN;
+
+  /// Initialize the JSON writer
+  writer_status = AzureIoTJSONWriter_Init(&link_data_writer,
+                                          link_data.mqtt_buffer,
+                                          sizeof(link_data.mqtt_buffer));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to initialize JSON writer error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Construct the JSON message - append begin object
+  writer_status = AzureIoTJSONWriter_AppendBeginObject(&link_data_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Append main begin object failed error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append message type property
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+    &link_data_writer,
+    (const uint8_t *)JSON_PROPERTY_MSGTYPE,
+    strlen(JSON_PROPERTY_MSGTYPE),
+    (const uint8_t *)JSON_PROPERTY_LINK,
+    strlen(JSON_PROPERTY_LINK));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append message type error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append time-stamp property
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+    &link_data_writer,
+    (const uint8_t *)JSON_PROPERTY_TIMESTAMP,
+    strlen(JSON_PROPERTY_TIMESTAMP),
+    (const uint8_t *)timestamp_buff,
+    strlen((char *)timestamp_buff));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append time-stamp property error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append link object
+  writer_status = AzureIoTJSONWriter_AppendPropertyName(&link_data_writer,
+                                                        (const uint8_t *)JSON_PROPERTY_LINK,
+                                                        strlen(JSON_PROPERTY_LINK));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append link property error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
 
-  /// Acquire MQTT data queue mutex
-  if (pdTRUE
-      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                        mqtt_package_queue_mutex_handler,
-                        portMAX_DELAY)) {
-    /// send data to MQTT data queue - If queue is full the receive the data and send it again
-    if (errQUEUE_FULL
-        == xQueueSend(sl_get_wifi_asset_tracking_resource()->
-                      mqtt_package_queue_handler,
-                      &wifi_data, 0)) {
-      sl_wifi_asset_tracking_mqtt_package_queue_data_t mqtt_data;
-      xQueueReceive(
-        sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_handler,
-        &mqtt_data,
-        0);
+  /// Append begin object
+  writer_status = AzureIoTJSONWriter_AppendBeginObject(&link_data_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append begin object for link property error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append state key value pair
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+    &link_data_writer,
+    (const uint8_t *)JSON_PROPERTY_STATE,
+    strlen(JSON_PROPERTY_STATE),
+    (const uint8_t *)state,
+    strlen(state));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append state key value pair error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append RSSI key value pair, only known once a sample is taken
+  if (0 != stats->sample_count) {
+    writer_status = AzureIoTJSONWriter_AppendPropertyWithInt32Value(
+      &link_data_writer,
+      (const uint8_t *)JSON_PROPERTY_RSSI,
+      strlen(JSON_PROPERTY_RSSI),
+      stats->average_rssi);
+    if (writer_status != eAzureIoTSuccess) {
       printf(
-        "\r\nsl_json_send_wifi_message : Data is released from the MQTT data queue as it is full\r\n");
-      xQueueSend(
-        sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_handler,
-        &wifi_data,
-        0);
+        "\r\nsl_json_send_link_message : Failed to append RSSI key value pair error code: %d\r\n",
+        writer_status);
+      goto error;
     }
+  }
+
+  /// Append downtime key value pair
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithInt32Value(
+    &link_data_writer,
+    (const uint8_t *)JSON_PROPERTY_DOWNTIME,
+    strlen(JSON_PROPERTY_DOWNTIME),
+    (int32_t)stats->last_down_ms);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append downtime key value pair error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append losses key value pair
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithInt32Value(
+    &link_data_writer,
+    (const uint8_t *)JSON_PROPERTY_LOSSES,
+    strlen(JSON_PROPERTY_LOSSES),
+    (int32_t)stats->down_count);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append losses key value pair error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// append close inner object
+  writer_status = AzureIoTJSONWriter_AppendEndObject(&link_data_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append inner close object error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
 
-    xSemaphoreGive(
-      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+  /// append close main object
+  writer_status = AzureIoTJSONWriter_AppendEndObject(&link_data_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_link_message : Failed to append main close object error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Update length of MQTT buffer
+  link_data.mqtt_buffer_len =
+    AzureIoTJSONWriter_GetBytesUsed(&link_data_writer);
+  link_data.sample_tick = 0;
+
+  /// Link events are published ahead of queued samples
+  if (SL_STATUS_OK
+      != sl_publish_lane_enqueue(SL_PUBLISH_LANE_CRITICAL,
+                                 SL_PUBLISH_LANE_SOURCE_LINK,
+                                 &link_data)) {
+    goto error;
   }
-#if DEMO_CONFIG_DEBUG_LOGS
-  printf(
-    "\r\nsl_json_send_wifi_message : Wi-Fi JSON format data is sent to the MQTT data queue\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+  SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_LINK_ENQUEUED);
 
   return SL_STATUS_OK;
   error:
   return SL_STATUS_FAIL;
-  wifi_failure:
-  return SL_STATUS_WIFI_CONNECTION_LOST;
+}
+
+/******************************************************************************
+ * Function to send a metrics snapshot as diagnostics JSON messages.
+ ******************************************************************************/
+sl_status_t sl_json_send_diagnostics_message(
+  const sl_metrics_snapshot_t *snapshot)
+{
+  uint8_t timestamp_buff[JSON_MAX_TIMESTAMP_BUFF_SIZE];
+  uint32_t first;
+
+  /// If failed to fetch time-stamp then return failure
+  if (SL_STATUS_OK != sl_json_get_timestamp(timestamp_buff)) {
+    printf(
+      "\r\nsl_json_send_diagnostics_message : failed to fetch time-stamp, discarding the snapshot\r\n");
+    return SL_STATUS_FAIL;
+  }
+
+  /// All parts carry the same time-stamp, so they can be joined again
+  for (first = 0; first < METRICS_VALUE_COUNT;
+       first += METRICS_VALUES_PER_MESSAGE) {
+    if (SL_STATUS_OK
+        != sl_json_send_diagnostics_part(snapshot, first, timestamp_buff)) {
+      return SL_STATUS_FAIL;
+    }
+  }
+
+  return SL_STATUS_OK;
 }
 
 /*****************************************************************************
@@ -1188,6 +1496,21 @@ sl_status_t sl_json_send_keep_alive_message()
   AzureIoTJSONWriter_t keep_alive_writer;
   AzureIoTResult_t writer_status;
   uint8_t timestamp_buff[JSON_MAX_TIMESTAMP_BUFF_SIZE];
+  int32_t intervals[MAX_INTERVAL_VALUES_SIZE];
+  sl_clock_quality_t clock_quality;
+
+  sl_json_get_sampling_intervals(intervals);
+
+  /// Presence is kept by MQTT PINGREQ, only state changes are published
+  if (sl_json_is_heartbeat_sent
+      && (0 == memcmp(intervals,
+                      sl_json_heartbeat_intervals,
+                      sizeof(intervals)))
+      && ((xTaskGetTickCount() - sl_json_heartbeat_tick)
+          < (pdMS_TO_TICKS(HEARTBEAT_MAX_INTERVAL * 1000)
+             * TIMER_CLOCK_OFFSET))) {
+    return SL_STATUS_OK;
+  }
 
   /// If failed to fetch time-stamp then discard the packet
   if (SL_STATUS_OK != sl_json_get_timestamp(timestamp_buff)) {
@@ -1293,50 +1616,14 @@ sl_status_t sl_json_send_keep_alive_message()
 
   /// Append values inside array
   for (uint8_t index = 0; index < MAX_INTERVAL_VALUES_SIZE; ++index) {
-    switch (index) {
-      case 0:
-        writer_status = AzureIoTJSONWriter_AppendInt32(&keep_alive_writer,
-                                                       DEMO_CONFIG_WIFI_SAMPLING_INTERVAL);
-        if (writer_status != eAzureIoTSuccess) {
-          printf(
-            "\r\nsl_json_send_keep_alive_message : Failed to append wi-fi interval  in array error code: %d\r\n",
-            writer_status);
-          goto error;
-        }
-        break;
-
-      case 1:
-        writer_status = AzureIoTJSONWriter_AppendInt32(&keep_alive_writer,
-                                                       DEMO_CONFIG_TEMP_RH_SENSOR_SAMPLING_INTERVAL);
-        if (writer_status != eAzureIoTSuccess) {
-          printf(
-            "\r\nsl_json_send_keep_alive_message : Failed to append temperature and RH sensor interval in array error code: %d\r\n",
-            writer_status);
-          goto error;
-        }
-        break;
-
-      case 2:
-        writer_status = AzureIoTJSONWriter_AppendInt32(&keep_alive_writer,
-                                                       DEMO_CONFIG_IMU_SENSOR_SAMPLING_INTERVAL);
-        if (writer_status != eAzureIoTSuccess) {
-          printf(
-            "\r\nsl_json_send_keep_alive_message : Failed to append IMU sensor interval in array error code: %d\r\n",
-            writer_status);
-          goto error;
-        }
-        break;
-
-      case 3:
-        writer_status = AzureIoTJSONWriter_AppendInt32(&keep_alive_writer,
-                                                       DEMO_CONFIG_GNSS_RECEIVER_SAMPLING_INTERVAL);
-        if (writer_status != eAzureIoTSuccess) {
-          printf(
-            "\r\nsl_json_send_keep_alive_message : Failed to append GNSS receiver interval in array error code: %d\r\n",
-            writer_status);
-          goto error;
-        }
-        break;
+    writer_status = AzureIoTJSONWriter_AppendInt32(&keep_alive_writer,
+                                                   intervals[index]);
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_keep_alive_message : Failed to append interval %u in array error code: %d\r\n",
+        index,
+        writer_status);
+      goto error;
     }
   }
 
@@ -1349,6 +1636,74 @@ sl_status_t sl_json_send_keep_alive_message()
     goto error;
   }
 
+  /// Append time quality, lets the cloud align timelines of devices
+  sl_clock_get_quality(&clock_quality);
+  if (clock_quality.is_synced) {
+    writer_status = AzureIoTJSONWriter_AppendPropertyName(&keep_alive_writer,
+                                                          (const uint8_t *)JSON_PROPERTY_CLOCK,
+                                                          strlen(
+                                                            JSON_PROPERTY_CLOCK));
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_keep_alive_message : Failed to append clock property error code: %d\r\n",
+        writer_status);
+      goto error;
+    }
+
+    writer_status = AzureIoTJSONWriter_AppendBeginObject(&keep_alive_writer);
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_keep_alive_message : Failed to append begin object for clock error code: %d\r\n",
+        writer_status);
+      goto error;
+    }
+
+    writer_status = AzureIoTJSONWriter_AppendPropertyWithInt32Value(
+      &keep_alive_writer,
+      (const uint8_t *)JSON_PROPERTY_OFFSET,
+      strlen(JSON_PROPERTY_OFFSET),
+      clock_quality.offset_ms);
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_keep_alive_message : Failed to append offset key value pair error code: %d\r\n",
+        writer_status);
+      goto error;
+    }
+
+    writer_status = AzureIoTJSONWriter_AppendPropertyWithInt32Value(
+      &keep_alive_writer,
+      (const uint8_t *)JSON_PROPERTY_UNCERTAINTY,
+      strlen(JSON_PROPERTY_UNCERTAINTY),
+      (int32_t)clock_quality.uncertainty_ms);
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_keep_alive_message : Failed to append uncertainty key value pair error code: %d\r\n",
+        writer_status);
+      goto error;
+    }
+
+    writer_status = AzureIoTJSONWriter_AppendPropertyWithDoubleValue(
+      &keep_alive_writer,
+      (const uint8_t *)JSON_PROPERTY_DRIFT,
+      strlen(JSON_PROPERTY_DRIFT),
+      (double)clock_quality.drift_ppb / 1000,
+      JSON_CLOCK_DRIFT_FRACTION_SIZE);
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_keep_alive_message : Failed to append drift key value pair error code: %d\r\n",
+        writer_status);
+      goto error;
+    }
+
+    writer_status = AzureIoTJSONWriter_AppendEndObject(&keep_alive_writer);
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_keep_alive_message : Failed to append end object for clock error code: %d\r\n",
+        writer_status);
+      goto error;
+    }
+  }
+
   /// append close object
   writer_status = AzureIoTJSONWriter_AppendEndObject(&keep_alive_writer);
   if (writer_status != eAzureIoTSuccess) {
@@ -1361,56 +1716,44 @@ sl_status_t sl_json_send_keep_alive_message()
   /// Update length of MQTT buffer
   keep_alive_data.mqtt_buffer_len = AzureIoTJSONWriter_GetBytesUsed(
     &keep_alive_writer);
+  keep_alive_data.sample_tick = 0;
 
-  /// Acquire MQTT data queue mutex
-  if (pdTRUE
-      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                        mqtt_package_queue_mutex_handler,
-                        portMAX_DELAY)) {
-    /// send data to MQTT data queue - If queue is full the receive the data and send it again
-    if (errQUEUE_FULL
-        == xQueueSend(sl_get_wifi_asset_tracking_resource()->
-                      mqtt_package_queue_handler,
-                      &keep_alive_data, 0)) {
-      sl_wifi_asset_tracking_mqtt_package_queue_data_t mqtt_data;
-      xQueueReceive(
-        sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_handler,
-        &mqtt_data,
-        0);
-      printf(
-        "\r\nsl_json_send_keep_alive_message : Data is released from the MQTT data queue as it is full\r\n");
-      xQueueSend(
-        sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_handler,
-        &keep_alive_data,
-        0);
-    }
-
-    xSemaphoreGive(
-      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+  /// Keep-alive is published ahead of queued samples
+  if (SL_STATUS_OK
+      != sl_publish_lane_enqueue(SL_PUBLISH_LANE_CRITICAL,
+                                 SL_PUBLISH_LANE_SOURCE_KEEP_ALIVE,
+                                 &keep_alive_data)) {
+    goto error;
   }
-#if DEMO_CONFIG_DEBUG_LOGS
-  printf(
-    "\r\nsl_json_send_keep_alive_message : JSON format data is sent to the MQTT data queue\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+
+  memcpy(sl_json_heartbeat_intervals, intervals, sizeof(intervals));
+  sl_json_heartbeat_tick = xTaskGetTickCount();
+  sl_json_is_heartbeat_sent = true;
+  SL_LOG_DEBUG(SL_LOG_MODULE_JSON, SL_LOG_FMT_JSON_KEEP_ALIVE_ENQUEUED);
 
   return SL_STATUS_OK;
   error:
   return SL_STATUS_FAIL;
 }
 
+/*****************************************************************************
+ * Function to send the full heartbeat with the next keep alive check.
+ ******************************************************************************/
+void sl_json_reset_heartbeat()
+{
+  sl_json_is_heartbeat_sent = false;
+}
+
 /*****************************************************************************
  * Function to get time-stamp for JSON message.
  ******************************************************************************/
 sl_status_t sl_json_get_timestamp(uint8_t *timestamp_buff)
 {
   sl_calendar_datetime_config_t datetime;
-  sl_status_t status;
 
-  status = sl_si91x_calendar_get_date_time(&datetime);
-  if (status != SL_STATUS_OK) {
-    printf(
-      "\r\nsl_json_get_timestamp : sl_si91x_calendar_get_date_time: Invalid Parameters, Error Code : %lu \n",
-      status);
+  /// Calendar RTC with drift and slew correction of clock discipline
+  if (SL_STATUS_OK != sl_clock_get_datetime(&datetime)) {
+    printf("\r\nsl_json_get_timestamp : Failed to get corrected time\r\n");
     return SL_STATUS_FAIL;
   }
 
@@ -1429,9 +1772,217 @@ sl_status_t sl_json_get_timestamp(uint8_t *timestamp_buff)
 
   /// Max string size is maximum size of time-stamp
   timestamp_buff[JSON_MAX_TIMESTAMP_STRING_SIZE - 1] = '\0';
-#if DEMO_CONFIG_DEBUG_LOGS
-  printf("\r\nsl_json_get_timestamp : getjson_time: %s \r\n", timestamp_buff);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+  SL_LOG_DEBUG(SL_LOG_MODULE_JSON,
+               SL_LOG_FMT_JSON_TIMESTAMP,
+               datetime.Hour,
+               datetime.Minute,
+               datetime.Second,
+               datetime.MilliSeconds);
+
+  return SL_STATUS_OK;
+}
+
+/*****************************************************************************
+ * Function to get the sampling intervals currently in use.
+ ******************************************************************************/
+static void sl_json_get_sampling_intervals(int32_t *intervals)
+{
+  intervals[0] = DEMO_CONFIG_WIFI_SAMPLING_INTERVAL;
+  intervals[1] = (int32_t)(sl_rate_limit_scale_interval(
+                             DEMO_CONFIG_TEMP_RH_SENSOR_SAMPLING_INTERVAL * 1000,
+                             MAX_LIMIT_OF_TEMP_RH_SENSOR_SAMPLING_INTERVAL * 1000)
+                           / 1000);
+  intervals[2] = (int32_t)(sl_rate_limit_scale_interval(
+                             DEMO_CONFIG_IMU_SENSOR_SAMPLING_INTERVAL * 1000,
+                             MAX_LIMIT_OF_IMU_SENSOR_SAMPLING_INTERVAL * 1000)
+                           / 1000);
+  intervals[3] = (int32_t)(sl_rate_limit_scale_interval(
+                             DEMO_CONFIG_GNSS_RECEIVER_SAMPLING_INTERVAL * 1000,
+                             MAX_LIMIT_OF_GNSS_RECEIVER_SAMPLING_INTERVAL * 1000)
+                           / 1000);
+}
+
+/******************************************************************************
+ * Function to send one diagnostics JSON message.
+ ******************************************************************************/
+static sl_status_t sl_json_send_diagnostics_part(
+  const sl_metrics_snapshot_t *snapshot,
+  uint32_t first,
+  const uint8_t *timestamp_buff)
+{
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t diagnostics_data;
+  AzureIoTJSONWriter_t diagnostics_writer;
+  AzureIoTResult_t writer_status;
+  uint32_t index;
+
+  /// Initialize the JSON writer
+  writer_status = AzureIoTJSONWriter_Init(&diagnostics_writer,
+                                          diagnostics_data.mqtt_buffer,
+                                          sizeof(diagnostics_data.mqtt_buffer));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to initialize JSON writer error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Construct the JSON message - append begin object
+  writer_status = AzureIoTJSONWriter_AppendBeginObject(&diagnostics_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Append main begin object failed error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append message type property
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+    &diagnostics_writer,
+    (const uint8_t *)JSON_PROPERTY_MSGTYPE,
+    strlen(JSON_PROPERTY_MSGTYPE),
+    (const uint8_t *)JSON_PROPERTY_DIAGNOSTICS,
+    strlen(JSON_PROPERTY_DIAGNOSTICS));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append message type error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append time-stamp property
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithStringValue(
+    &diagnostics_writer,
+    (const uint8_t *)JSON_PROPERTY_TIMESTAMP,
+    strlen(JSON_PROPERTY_TIMESTAMP),
+    timestamp_buff,
+    strlen((const char *)timestamp_buff));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append time-stamp property error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append diagnostics object
+  writer_status = AzureIoTJSONWriter_AppendPropertyName(&diagnostics_writer,
+                                                        (const uint8_t *)JSON_PROPERTY_DIAGNOSTICS,
+                                                        strlen(JSON_PROPERTY_DIAGNOSTICS));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append diagnostics property error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  writer_status = AzureIoTJSONWriter_AppendBeginObject(&diagnostics_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append begin object for diagnostics error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append schema version and index of first value
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithInt32Value(
+    &diagnostics_writer,
+    (const uint8_t *)JSON_PROPERTY_VERSION,
+    strlen(JSON_PROPERTY_VERSION),
+    METRICS_SCHEMA_VERSION);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append version key value pair error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  writer_status = AzureIoTJSONWriter_AppendPropertyWithInt32Value(
+    &diagnostics_writer,
+    (const uint8_t *)JSON_PROPERTY_FIRST,
+    strlen(JSON_PROPERTY_FIRST),
+    (int32_t)first);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append first key value pair error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Append values array, counters above INT32_MAX are restored by the backend
+  writer_status = AzureIoTJSONWriter_AppendPropertyName(&diagnostics_writer,
+                                                        (const uint8_t *)JSON_PROPERTY_VALUES,
+                                                        strlen(JSON_PROPERTY_VALUES));
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append values property error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  writer_status = AzureIoTJSONWriter_AppendBeginArray(&diagnostics_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append begin of array for values error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  for (index = first;
+       (index < METRICS_VALUE_COUNT)
+       && (index < (first + METRICS_VALUES_PER_MESSAGE)); index++) {
+    writer_status = AzureIoTJSONWriter_AppendInt32(&diagnostics_writer,
+                                                   (int32_t)snapshot->values[index]);
+    if (writer_status != eAzureIoTSuccess) {
+      printf(
+        "\r\nsl_json_send_diagnostics_part : Failed to append value %lu in array error code: %d\r\n",
+        index,
+        writer_status);
+      goto error;
+    }
+  }
+
+  writer_status = AzureIoTJSONWriter_AppendEndArray(&diagnostics_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append end of array for values error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// append close inner object
+  writer_status = AzureIoTJSONWriter_AppendEndObject(&diagnostics_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append inner close object error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// append close main object
+  writer_status = AzureIoTJSONWriter_AppendEndObject(&diagnostics_writer);
+  if (writer_status != eAzureIoTSuccess) {
+    printf(
+      "\r\nsl_json_send_diagnostics_part : Failed to append main close object error code: %d\r\n",
+      writer_status);
+    goto error;
+  }
+
+  /// Update length of MQTT buffer
+  diagnostics_data.mqtt_buffer_len =
+    AzureIoTJSONWriter_GetBytesUsed(&diagnostics_writer);
+  diagnostics_data.sample_tick = 0;
+
+  /// Diagnostics wait for a publish burst behind routine samples
+  if (SL_STATUS_OK
+      != sl_publish_lane_enqueue(SL_PUBLISH_LANE_BULK,
+                                 SL_PUBLISH_LANE_SOURCE_DIAGNOSTICS,
+                                 &diagnostics_data)) {
+    goto error;
+  }
+  SL_LOG_DEBUG(SL_LOG_MODULE_JSON,
+               SL_LOG_FMT_JSON_DIAGNOSTICS_ENQUEUED,
+               first);
 
   return SL_STATUS_OK;
+  error:
+  return SL_STATUS_FAIL;
 }
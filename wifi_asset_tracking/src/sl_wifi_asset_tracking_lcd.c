@@ -28,56 +28,61 @@
 #include <sl_wifi_asset_tracking_app.h>
 #include <sl_wifi_asset_tracking_demo_config.h>
 
+/// @brief Structure for word-wrapped layout of one LCD message
+typedef struct {
+  uint8_t line_count;                     ///< Lines of the message
+  uint8_t start[MAX_LCD_MESSAGE_LINES];   ///< Offset of each line in the message
+  uint8_t length[MAX_LCD_MESSAGE_LINES];  ///< Characters of each line
+} sl_lcd_layout_t;
+
 static uint8_t sl_lcd_current_line = 0; /// Current LCD line number
 static GLIB_Context_t sl_lcd_glib_context; /// LCD glib context
 
+/// Word-wrapped line layout of every LCD message, built once at start-up
+static sl_lcd_layout_t sl_lcd_layout[INDEX_LCD_MESSAGE_COUNT];
+
+/// Wanted content of every LCD line, space padded to full line width
+static char sl_lcd_frame[MAX_LCD_LINES][MAX_LCD_SUBSTRING_LENGTH + 1];
+
+/// Content of every LCD line as last drawn, compared with the wanted one
+static char sl_lcd_shown[MAX_LCD_LINES][MAX_LCD_SUBSTRING_LENGTH + 1];
+
 /**************************************************************************/ /**
- * @brief Print provided string on LCD after breaking provided string into sub
- * strings
- * @param[in] pString : Pointer to the string that is to be print on LCD
+ * @brief Word-wrap every LCD message into lines of MAX_LCD_SUBSTRING_LENGTH
+ * characters, a word longer than a line is broken inside.
  * @return none
  *****************************************************************************/
-static void sl_si91x_lcd_print(char *pString);
+static void sl_si91x_lcd_build_layouts(void);
 
 /**************************************************************************/ /**
- * @brief  Clear present LCD content
- * @param none
+ * @brief Queue a message for the LCD task, the oldest queued message is
+ * dropped when the queue is full.
+ * @param[in] lcd_data : Message to queue.
  * @return none
  *****************************************************************************/
-static void sl_si91x_clear_lcd(void);
+static void sl_si91x_lcd_send(const sl_wifi_asset_tracking_lcd_queue_data_t *lcd_data);
 
 /**************************************************************************/ /**
- * @brief Breaks main string into sub strings
- * @param[in]  str : Pointer to the string that is to be print on LCD.
- * @param[out] sub_str_buf : Pointer to store sub string.
- * @param[in]  start : Start index from where string to be break.
- * @param[in]  end : Index up-to which string to be break.
- * @return The following values are returned:
- * - \ref SL_STATUS_OK on success.
- * - \ref SL_STATUS_FAIL on failure.
- ******************************************************************************/
-static sl_status_t sl_si91x_lcd_substring(const char *str,
-                                          char *sub_str_buf,
-                                          int start,
-                                          int end);
+ * @brief Write lines of a queued message into the line framebuffer, the log
+ * continues at the top once the last line is written.
+ * @param[in] lcd_data : Queued message.
+ * @return none
+ *****************************************************************************/
+static void sl_si91x_lcd_render(const sl_wifi_asset_tracking_lcd_queue_data_t *lcd_data);
 
 /**************************************************************************/ /**
- * @brief  Function to clear present LCD content
- * @return The following values are returned:
- * - \ref SL_STATUS_OK on success.
- * - \ref SL_STATUS_FAIL on failure.
+ * @brief Write one line into the line framebuffer and move to the next line.
+ * @param[in] text : Characters of the line, not null-terminated.
+ * @param[in] length : Characters of the line, MAX_LCD_SUBSTRING_LENGTH at most.
+ * @return none
  *****************************************************************************/
-static void sl_si91x_clear_lcd(void)
-{
-  /// Clears the clipping region by filling it with the background color of the GLIB_Context_t
-  GLIB_clearRegion(&sl_lcd_glib_context);
+static void sl_si91x_lcd_put_line(const char *text, uint8_t length);
 
-  /// Reset the display driver clipping area to the whole display
-  GLIB_resetDisplayClippingArea(&sl_lcd_glib_context);
-
-  /// Apply the clipping region from the GLIB_Context_t in the DMD driver
-  GLIB_applyClippingRegion(&sl_lcd_glib_context);
-}
+/**************************************************************************/ /**
+ * @brief Draw the lines of the framebuffer which differ from the display.
+ * @return Number of lines drawn.
+ *****************************************************************************/
+static uint8_t sl_si91x_lcd_draw_changed_lines(void);
 
 /**************************************************************************/ /**
  * @brief  Function to initialize LCD display
@@ -118,156 +123,53 @@ static sl_status_t sl_wifi_asset_tracking_lcd_init(void)
   /// Use Narrow font
   GLIB_setFont(&sl_lcd_glib_context, (GLIB_Font_t *)&GLIB_FontNarrow6x8);
 
+  /// Cleared display shows blank lines
+  for (uint8_t line = 0; line < MAX_LCD_LINES; line++) {
+    memset(sl_lcd_frame[line], ' ', MAX_LCD_SUBSTRING_LENGTH);
+    sl_lcd_frame[line][MAX_LCD_SUBSTRING_LENGTH] = '\0';
+  }
+  memcpy(sl_lcd_shown, sl_lcd_frame, sizeof(sl_lcd_shown));
+
+  sl_si91x_lcd_build_layouts();
+
   return SL_STATUS_OK;
 
   error:
   return SL_STATUS_FAIL;
 }
 
-/**************************************************************************/ /**
- * @brief  Function to print passed string on LCD
- * param[in] print_str : pointer to a string buffer.
- * @return The following values are returned:
- * - \ref SL_STATUS_OK on success.
- * - \ref SL_STATUS_FAIL on failure.
- *****************************************************************************/
-static void sl_si91x_lcd_print_string(char *print_str)
-{
-  /// Print string to LCD
-  sl_si91x_lcd_print(print_str);
-
-  /// Update LCD Content
-  DMD_updateDisplay();
-}
-
-/**************************************************************************/ /**
- * @brief Utility function to breaks string into substrings
- * @param[in]  str : Pointer to the string that is drawn.
- * @param[out] sub_str_buf : Pointer to the output substring that is created from main string.
- * @param[in]  start : Start index from where string to be break.
- * @param[in]  end : Index up-to which substring to be break
- * @return The following values are returned:
- * -  \ref SL_STATUS_OK On success
- * -  \ref SL_STATUS_FAIL - On initialization failure
+/*******************************************************************************
+ * Function to send message index into LCD data queue
  ******************************************************************************/
-static sl_status_t sl_si91x_lcd_substring(const char *str,
-                                          char *sub_str_buf,
-                                          int start,
-                                          int end)
+void sl_wifi_asset_tracking_lcd_print(
+  sl_siwx917_wifi_asset_tracking_lcd_logs_indexing_e lcd_msg_index)
 {
-  uint8_t substr_length;
-  uint8_t length = strlen(str);
+  sl_wifi_asset_tracking_lcd_queue_data_t lcd_data = { 0 };
 
-  /// Clear sub-string buffer
-  memset(sub_str_buf, '\0', strlen(sub_str_buf));
-
-  /// Validate input
-  if ((start < 0) || (end < 0) || (start >= length) || (end >= length)
-      || (start > end)) {
-    return SL_STATUS_FAIL;   /// Return failure for invalid input
-  }
-
-  /// Find out sub-string length
-  substr_length = end - start + 1;
-
-  /// Copy substring data
-  for (int i = 0; i < substr_length; ++i) {
-    sub_str_buf[i] = str[start + i];
-  }
-
-  /// Null-terminate the substring
-  sub_str_buf[substr_length] = '\0';
-
-  return SL_STATUS_OK;
+  lcd_data.msg_index = lcd_msg_index;
+  sl_si91x_lcd_send(&lcd_data);
 }
 
 /*******************************************************************************
- * Function to print string on LCD and clear LCD if MAX_LCD_LINES are reached
+ * Function to send message index and value into LCD data queue
  ******************************************************************************/
-static void sl_si91x_lcd_print(char *pString)
+void sl_wifi_asset_tracking_lcd_print_value(uint8_t lcd_msg_index,
+                                            int32_t value)
 {
-  sl_status_t status;
-  uint8_t count = 0;
+  sl_wifi_asset_tracking_lcd_queue_data_t lcd_data = { 0 };
 
-  /// Create character buffer of size MAX_LCD_SUBSTRING_LENGTH to store substring
-  char sub_str_buffer[MAX_LCD_SUBSTRING_LENGTH];
-
-  /// Start index from where string to be divided
-  uint8_t start = 0;
-
-  /// End index up-to which string to be divided
-  uint8_t end = MAX_LCD_SUBSTRING_LENGTH - 1;
-
-  /// Storing main string length into variable
-  uint8_t print_str_len = strlen(pString);
-
-  if (print_str_len != 0) {
-    /// No. of lines to be print on LCD
-    uint8_t no_of_lines = print_str_len / MAX_LCD_SUBSTRING_LENGTH;
-
-    if ((print_str_len % MAX_LCD_SUBSTRING_LENGTH) > 0) {
-      ++no_of_lines;
-    }
-
-    /// If line-count is greater than no. of lines left in LCD then,
-    /// clear LCD and again starts from line 0
-    if (no_of_lines > (MAX_LCD_LINES - sl_lcd_current_line)) {
-      /// Update LCD current line variable
-      sl_lcd_current_line = 0;
-
-      /// Clear present LCD content
-      sl_si91x_clear_lcd();
-    }
-
-    while (count < no_of_lines) {
-      /// Checking if substring character length is MAX_LCD_SUBSTRING_LENGTH
-      /// Substring character length is less than MAX_LCD_SUBSTRING_LENGTH
-      if ((count == no_of_lines - 1)
-          && (print_str_len % MAX_LCD_SUBSTRING_LENGTH > 0)) {
-        end = print_str_len - 1;
-        status = sl_si91x_lcd_substring(pString, sub_str_buffer, start, end);
-
-        if (SL_STATUS_OK == status) {
-          /// Draws a string on the specified line on the display
-          GLIB_drawStringOnLine(&sl_lcd_glib_context,
-                                sub_str_buffer,
-                                sl_lcd_current_line++,
-                                GLIB_ALIGN_LEFT,
-                                5,
-                                5,
-                                true);
-        }
-      } else {   /// Substring character length is equal to MAX_LCD_SUBSTRING_LENGTH
-        status = sl_si91x_lcd_substring(pString, sub_str_buffer, start, end);
-
-        if (SL_STATUS_OK == status) {
-          GLIB_drawStringOnLine(&sl_lcd_glib_context,
-                                sub_str_buffer,
-                                sl_lcd_current_line++,
-                                GLIB_ALIGN_LEFT,
-                                5,
-                                5,
-                                true);
-        }
-      }
-
-      /// Incrementing Start and end index for next 20 index
-      start += MAX_LCD_SUBSTRING_LENGTH;
-      end += MAX_LCD_SUBSTRING_LENGTH;
-      ++count;
-    }
-  } else {
-    printf("\r\nsl_si91x_lcd_print : Invalid string passed to print on LCD\r\n");
-  }
+  lcd_data.msg_index = lcd_msg_index;
+  lcd_data.has_value = true;
+  lcd_data.value = value;
+  sl_si91x_lcd_send(&lcd_data);
 }
 
 /*******************************************************************************
- * Function to send string message into LCD data queue
+ * Function to send a message into LCD data queue
  ******************************************************************************/
-void sl_wifi_asset_tracking_lcd_print(
-  sl_siwx917_wifi_asset_tracking_lcd_logs_indexing_e lcd_msg_index)
+static void sl_si91x_lcd_send(const sl_wifi_asset_tracking_lcd_queue_data_t *lcd_data)
 {
-  sl_wifi_asset_tracking_lcd_queue_data_t lcd_string;
+  sl_wifi_asset_tracking_lcd_queue_data_t oldest;
 
   if (!sl_get_wifi_asset_tracking_status()->lcd_init_status) {
 #if DEMO_CONFIG_DEBUG_LOGS
@@ -277,49 +179,33 @@ void sl_wifi_asset_tracking_lcd_print(
     return;
   }
 
-  if (sl_get_wifi_asset_tracking_status()->app_shutdown) {
-    printf(
-      "\r\nsl_wifi_asset_tracking_lcd_print : application is shutdown, so returning\r\n");
+  if (INDEX_LCD_MESSAGE_COUNT <= lcd_data->msg_index) {
+    printf("\r\nsl_wifi_asset_tracking_lcd_print : invalid message index\r\n");
     return;
   }
 
-  if ((INDEX_SENSOR_SHUTDOWN == lcd_msg_index)
-      || (INDEX_WIFI_SHUTDOWN == lcd_msg_index)
-      || (INDEX_CLOUD_SHUTDOWN == lcd_msg_index)) {
-    sl_get_wifi_asset_tracking_status()->app_shutdown = true;
-  }
-
-  strcpy((char *)lcd_string.lcd_buffer,
-         sl_get_wifi_asset_tracking_lcd_string()[lcd_msg_index]);
-
   if (errQUEUE_FULL
       == xQueueSend(sl_get_wifi_asset_tracking_resource()->lcd_queue_handler,
-                    &lcd_string,
+                    lcd_data,
                     0)) {
-    /// Receive LCD data as LCD data queue is full
+    /// Drop the oldest message as LCD data queue is full
     xQueueReceive(sl_get_wifi_asset_tracking_resource()->lcd_queue_handler,
-                  &lcd_string,
+                  &oldest,
                   0);
 
     printf(
       "\r\nsl_wifi_asset_tracking_lcd_print : received LCD data as LCD data queue is full\r\n");
 
-    /// re-write the content
-    strcpy((char *)lcd_string.lcd_buffer,
-           sl_get_wifi_asset_tracking_lcd_string()[lcd_msg_index]);
-
     /// again send latest LCD data to LCD data queue
     xQueueSend(sl_get_wifi_asset_tracking_resource()->lcd_queue_handler,
-               &lcd_string,
+               lcd_data,
                0);
   }
 
 #if DEMO_CONFIG_DEBUG_LOGS
   printf(
-    "\r\nsl_wifi_asset_tracking_lcd_print : LCD string message is sent to LCD data queue\r\n");
+    "\r\nsl_wifi_asset_tracking_lcd_print : LCD message index is sent to LCD data queue\r\n");
 #endif
-
-  vTaskResume(sl_get_wifi_asset_tracking_resource()->task_list.lcd_task_handler);
 }
 
 /******************************************************************************
@@ -327,8 +213,7 @@ void sl_wifi_asset_tracking_lcd_print(
  *****************************************************************************/
 void sl_wifi_asset_tracking_lcd_task()
 {
-  sl_wifi_asset_tracking_lcd_queue_data_t buffer;
-  char string_buffer[MAX_LCD_STRING_SIZE];
+  sl_wifi_asset_tracking_lcd_queue_data_t lcd_data;
 
   /// initialize LCD
   if (SL_STATUS_OK != sl_wifi_asset_tracking_lcd_init()) {
@@ -344,27 +229,182 @@ void sl_wifi_asset_tracking_lcd_task()
   sl_wifi_asset_tracking_lcd_print(INDEX_BLANK_LINE);
 
   while (1) {
-    if (QUEUE_EMPTY
-        == uxQueueMessagesWaiting(sl_get_wifi_asset_tracking_resource()->
-                                  lcd_queue_handler)) {
-#if DEMO_CONFIG_DEBUG_LOGS
-      printf("\r\nlcd_task : suspend LCD task as LCD data queue is empty\r\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
-      vTaskSuspend(
-        sl_get_wifi_asset_tracking_resource()->task_list.lcd_task_handler);
-    } else {
-      xQueueReceive(sl_get_wifi_asset_tracking_resource()->lcd_queue_handler,
-                    &buffer,
-                    0);
-
-      strcpy(string_buffer, (char *)buffer.lcd_buffer);
+    if (pdTRUE
+        != xQueueReceive(sl_get_wifi_asset_tracking_resource()->
+                         lcd_queue_handler,
+                         &lcd_data,
+                         portMAX_DELAY)) {
+      continue;
+    }
 
+    /// Messages queued meanwhile are rendered first, the display is updated
+    /// once for all of them
+    do {
 #if DEMO_CONFIG_DEBUG_LOGS
       printf("\r\nlcd_task : LCD is updated with message : %s\r\n",
-             buffer.lcd_buffer);
+             sl_get_wifi_asset_tracking_lcd_string()[lcd_data.msg_index]);
 #endif /// < DEMO_CONFIG_DEBUG_LOGS
 
-      sl_si91x_lcd_print_string(string_buffer);
+      sl_si91x_lcd_render(&lcd_data);
+    } while (pdTRUE
+             == xQueueReceive(sl_get_wifi_asset_tracking_resource()->
+                              lcd_queue_handler,
+                              &lcd_data,
+                              0));
+
+    if (0 != sl_si91x_lcd_draw_changed_lines()) {
+      /// Update LCD Content
+      DMD_updateDisplay();
+    }
+  }
+}
+
+/*******************************************************************************
+ * Function to word-wrap every LCD message into lines
+ ******************************************************************************/
+static void sl_si91x_lcd_build_layouts(void)
+{
+  const char *message;
+  sl_lcd_layout_t *layout;
+  uint8_t message_length;
+  uint8_t position;
+  uint8_t length;
+
+  for (uint8_t index = 0; index < INDEX_LCD_MESSAGE_COUNT; index++) {
+    message = sl_get_wifi_asset_tracking_lcd_string()[index];
+    message_length = (uint8_t)strnlen(message, MAX_LCD_STRING_SIZE - 1);
+    layout = &sl_lcd_layout[index];
+    layout->line_count = 0;
+    position = 0;
+
+    while ((position < message_length)
+           && (layout->line_count < MAX_LCD_MESSAGE_LINES)) {
+      /// Space a line was broken at is not drawn
+      while ((0 != layout->line_count) && (position < message_length)
+             && (' ' == message[position])) {
+        position++;
+      }
+      if (position == message_length) {
+        break;
+      }
+
+      length = message_length - position;
+      if (length > MAX_LCD_SUBSTRING_LENGTH) {
+        length = MAX_LCD_SUBSTRING_LENGTH;
+
+        /// Break at the last space which fits, unless the line ends at one
+        if (' ' != message[position + length]) {
+          while ((length > 0) && (' ' != message[position + length - 1])) {
+            length--;
+          }
+          if (length <= 1) {
+            length = MAX_LCD_SUBSTRING_LENGTH;
+          } else {
+            length--;
+          }
+        }
+      }
+
+      layout->start[layout->line_count] = position;
+      layout->length[layout->line_count] = length;
+      layout->line_count++;
+      position += length;
+    }
+
+    if (position < message_length) {
+      printf("\r\nsl_si91x_lcd_build_layouts : message %u is truncated\r\n",
+             index);
     }
   }
 }
+
+/*******************************************************************************
+ * Function to write lines of a queued message into the line framebuffer
+ ******************************************************************************/
+static void sl_si91x_lcd_render(const sl_wifi_asset_tracking_lcd_queue_data_t *lcd_data)
+{
+  const sl_lcd_layout_t *layout = &sl_lcd_layout[lcd_data->msg_index];
+  const char *message =
+    sl_get_wifi_asset_tracking_lcd_string()[lcd_data->msg_index];
+  char value_buffer[MAX_LCD_SUBSTRING_LENGTH + 1];
+  char line_buffer[MAX_LCD_SUBSTRING_LENGTH];
+  uint8_t value_length = 0;
+  uint8_t line;
+  int length;
+
+  if (lcd_data->has_value) {
+    length = snprintf(value_buffer,
+                      sizeof(value_buffer),
+                      " (%ld)",
+                      (long)lcd_data->value);
+    if (length > 0) {
+      value_length = (length < (int)sizeof(value_buffer))
+                     ? (uint8_t)length : (uint8_t)(sizeof(value_buffer) - 1);
+    }
+  }
+
+  for (line = 0; line < layout->line_count; line++) {
+    /// Value goes behind the last line when it fits
+    if ((line == (layout->line_count - 1)) && (0 != value_length)
+        && ((layout->length[line] + value_length) <= MAX_LCD_SUBSTRING_LENGTH)) {
+      memcpy(line_buffer, &message[layout->start[line]], layout->length[line]);
+      memcpy(&line_buffer[layout->length[line]], value_buffer, value_length);
+      sl_si91x_lcd_put_line(line_buffer, layout->length[line] + value_length);
+      value_length = 0;
+      continue;
+    }
+
+    sl_si91x_lcd_put_line(&message[layout->start[line]], layout->length[line]);
+  }
+
+  /// Otherwise on a line of its own, without the leading space
+  if (0 != value_length) {
+    sl_si91x_lcd_put_line(&value_buffer[1], value_length - 1);
+  }
+
+  /// Blank line behind the newest message shows where the log continues
+  memset(sl_lcd_frame[sl_lcd_current_line], ' ', MAX_LCD_SUBSTRING_LENGTH);
+}
+
+/*******************************************************************************
+ * Function to write one line into the line framebuffer
+ ******************************************************************************/
+static void sl_si91x_lcd_put_line(const char *text, uint8_t length)
+{
+  memcpy(sl_lcd_frame[sl_lcd_current_line], text, length);
+  memset(&sl_lcd_frame[sl_lcd_current_line][length],
+         ' ',
+         MAX_LCD_SUBSTRING_LENGTH - length);
+
+  /// Log continues at the top instead of clearing the display
+  sl_lcd_current_line = (sl_lcd_current_line + 1) % MAX_LCD_LINES;
+}
+
+/*******************************************************************************
+ * Function to draw the lines which differ from the display
+ ******************************************************************************/
+static uint8_t sl_si91x_lcd_draw_changed_lines(void)
+{
+  uint8_t changed = 0;
+
+  for (uint8_t line = 0; line < MAX_LCD_LINES; line++) {
+    if (0 == memcmp(sl_lcd_frame[line],
+                    sl_lcd_shown[line],
+                    MAX_LCD_SUBSTRING_LENGTH)) {
+      continue;
+    }
+
+    /// Opaque full width line overwrites the previous content
+    GLIB_drawStringOnLine(&sl_lcd_glib_context,
+                          sl_lcd_frame[line],
+                          line,
+                          GLIB_ALIGN_LEFT,
+                          5,
+                          5,
+                          true);
+    memcpy(sl_lcd_shown[line], sl_lcd_frame[line], MAX_LCD_SUBSTRING_LENGTH);
+    changed++;
+  }
+
+  return changed;
+}
@@ -0,0 +1,312 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_link_monitor.c
+ * @brief Wi-Fi link health monitor
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi.h>
+#include <sl_constants.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_link_monitor.h>
+
+/// @brief Structure for link state and RSSI window
+typedef struct {
+  uint8_t state;                                ///< sl_link_state_e
+  bool is_ever_up;                              ///< First join done, later joins are reconnections
+  bool is_event_pending;                        ///< State change not published yet
+  int32_t rssi_window[LINK_MONITOR_WINDOW_SIZE]; ///< Latest RSSI samples, circular
+  uint8_t sample_count;                         ///< Valid samples in rssi_window
+  uint8_t next_sample;                          ///< Index for next sample in rssi_window
+  uint32_t down_count;                          ///< Link losses since boot
+  uint32_t last_down_ms;                        ///< Duration of last link loss
+  TickType_t down_tick;                         ///< Tick of last link loss
+} sl_link_monitor_t;
+
+/// Link state, written from join callback and tasks under critical section
+static sl_link_monitor_t sl_link_monitor;
+
+/**************************************************************************/ /**
+ * @brief Callback function for join events of the network processor. Only
+ * failures are reported once connected, when the network processor gives up
+ * on its own rejoin.
+ * @param[in] event : join event, failure bit set on link loss.
+ * @param[in] result : unused.
+ * @param[in] result_length : unused.
+ * @param[in] arg : unused.
+ * @return SL_STATUS_OK.
+ ******************************************************************************/
+static sl_status_t sl_link_monitor_join_callback(sl_wifi_event_t event,
+                                                 char *result,
+                                                 uint32_t result_length,
+                                                 void *arg);
+
+/**************************************************************************/ /**
+ * @brief Function to mark the link down, once per link loss.
+ ******************************************************************************/
+static void sl_link_monitor_set_down(void);
+
+/**************************************************************************/ /**
+ * @brief Function to add one RSSI sample to the window.
+ * @param[in] rssi : in dBm.
+ ******************************************************************************/
+static void sl_link_monitor_add_sample(int32_t rssi);
+
+/**************************************************************************/ /**
+ * @brief Function to start Wi-Fi recovery after link loss, unless recovery is
+ * already running.
+ ******************************************************************************/
+static void sl_link_monitor_start_recovery(void);
+
+/******************************************************************************
+ *  Function to subscribe to join events of the network processor.
+ *****************************************************************************/
+sl_status_t sl_link_monitor_init(void)
+{
+  sl_status_t status;
+
+  status = sl_wifi_set_join_callback(sl_link_monitor_join_callback, NULL);
+  if (SL_STATUS_OK != status) {
+    printf(
+      "\r\nsl_link_monitor_init : Failed to register join callback: 0x%lx\r\n",
+      status);
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Task function which samples RSSI and publishes link state changes.
+ *****************************************************************************/
+void sl_link_monitor_task()
+{
+  sl_link_monitor_stats_t stats;
+  sl_status_t status;
+  int32_t rssi;
+  bool is_event_pending;
+
+  while (1) {
+    /// Join failure event wakes the task before the next sample
+    ulTaskNotifyTake(pdTRUE,
+                     pdMS_TO_TICKS(LINK_MONITOR_SAMPLE_INTERVAL)
+                     * TIMER_CLOCK_OFFSET);
+
+    /// Recovery owns the network processor until it reconnects
+    if (SL_WIFI_CONNECTED
+        != sl_get_wifi_asset_tracking_status()->wifi_conn_status) {
+      continue;
+    }
+
+    if (sl_link_monitor_is_up()) {
+      status = sl_wifi_get_signal_strength(SL_WIFI_CLIENT_INTERFACE, &rssi);
+      if (SL_STATUS_OK == status) {
+        sl_link_monitor_add_sample(rssi);
+      } else {
+        printf("\r\nlink_monitor_task : Failed to get RSSI Value\r\n");
+        sl_link_monitor_set_down();
+      }
+    }
+
+    if (!sl_link_monitor_is_up()) {
+      sl_link_monitor_start_recovery();
+    }
+
+    taskENTER_CRITICAL();
+    is_event_pending = sl_link_monitor.is_event_pending;
+    taskEXIT_CRITICAL();
+
+    if (is_event_pending) {
+      sl_link_monitor_get_stats(&stats);
+      if (SL_STATUS_OK == sl_json_send_link_message(&stats)) {
+        taskENTER_CRITICAL();
+        sl_link_monitor.is_event_pending = false;
+        taskEXIT_CRITICAL();
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ *  Function to mark the link up after a successful join.
+ *****************************************************************************/
+void sl_link_monitor_on_connected(void)
+{
+  sl_status_t status;
+  int32_t rssi = 0;
+
+  status = sl_wifi_get_signal_strength(SL_WIFI_CLIENT_INTERFACE, &rssi);
+
+  taskENTER_CRITICAL();
+  /// Window restarts with the new connection, access point may have changed
+  sl_link_monitor.sample_count = 0;
+  sl_link_monitor.next_sample = 0;
+  if ((SL_LINK_STATE_DOWN == sl_link_monitor.state)
+      && sl_link_monitor.is_ever_up) {
+    sl_link_monitor.last_down_ms =
+      (uint32_t)(((xTaskGetTickCount() - sl_link_monitor.down_tick)
+                  * portTICK_PERIOD_MS) / TIMER_CLOCK_OFFSET);
+    sl_link_monitor.is_event_pending = true;
+  }
+  sl_link_monitor.state = SL_LINK_STATE_UP;
+  sl_link_monitor.is_ever_up = true;
+  taskEXIT_CRITICAL();
+
+  if (SL_STATUS_OK == status) {
+    sl_link_monitor_add_sample(rssi);
+  }
+
+  /// Publish the reconnection without waiting for the next sample
+  if (NULL
+      != sl_get_wifi_asset_tracking_resource()->task_list.
+      link_monitor_task_handler) {
+    xTaskNotifyGive(
+      sl_get_wifi_asset_tracking_resource()->task_list.link_monitor_task_handler);
+  }
+}
+
+/******************************************************************************
+ *  Function to check the cached link state.
+ *****************************************************************************/
+bool sl_link_monitor_is_up(void)
+{
+  return SL_LINK_STATE_UP == sl_link_monitor.state;
+}
+
+/******************************************************************************
+ *  Function to get the latest RSSI sample.
+ *****************************************************************************/
+sl_status_t sl_link_monitor_get_rssi(int32_t *rssi)
+{
+  sl_status_t status = SL_STATUS_FAIL;
+  uint8_t index;
+
+  taskENTER_CRITICAL();
+  if ((SL_LINK_STATE_UP == sl_link_monitor.state)
+      && (0 != sl_link_monitor.sample_count)) {
+    index = (sl_link_monitor.next_sample + LINK_MONITOR_WINDOW_SIZE - 1)
+            % LINK_MONITOR_WINDOW_SIZE;
+    *rssi = sl_link_monitor.rssi_window[index];
+    status = SL_STATUS_OK;
+  }
+  taskEXIT_CRITICAL();
+
+  return status;
+}
+
+/******************************************************************************
+ *  Function to read link quality over the RSSI window.
+ *****************************************************************************/
+void sl_link_monitor_get_stats(sl_link_monitor_stats_t *stats)
+{
+  int32_t sum = 0;
+  uint8_t index;
+
+  memset(stats, 0, sizeof(*stats));
+
+  taskENTER_CRITICAL();
+  stats->state = sl_link_monitor.state;
+  stats->sample_count = sl_link_monitor.sample_count;
+  stats->down_count = sl_link_monitor.down_count;
+  stats->last_down_ms = sl_link_monitor.last_down_ms;
+
+  for (index = 0; index < sl_link_monitor.sample_count; ++index) {
+    if ((0 == index)
+        || (sl_link_monitor.rssi_window[index] < stats->min_rssi)) {
+      stats->min_rssi = sl_link_monitor.rssi_window[index];
+    }
+    if ((0 == index)
+        || (sl_link_monitor.rssi_window[index] > stats->max_rssi)) {
+      stats->max_rssi = sl_link_monitor.rssi_window[index];
+    }
+    sum += sl_link_monitor.rssi_window[index];
+  }
+
+  if (0 != sl_link_monitor.sample_count) {
+    stats->average_rssi = sum / sl_link_monitor.sample_count;
+    index = (sl_link_monitor.next_sample + LINK_MONITOR_WINDOW_SIZE - 1)
+            % LINK_MONITOR_WINDOW_SIZE;
+    stats->last_rssi = sl_link_monitor.rssi_window[index];
+  }
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Callback function for join events of the network processor.
+ *****************************************************************************/
+static sl_status_t sl_link_monitor_join_callback(sl_wifi_event_t event,
+                                                 char *result,
+                                                 uint32_t result_length,
+                                                 void *arg)
+{
+  UNUSED_PARAMETER(result);
+  UNUSED_PARAMETER(result_length);
+  UNUSED_PARAMETER(arg);
+
+  if (SL_WIFI_CHECK_IF_EVENT_FAILED(event)) {
+    printf("\r\nsl_link_monitor_join_callback : Wi-Fi link lost\r\n");
+    sl_link_monitor_set_down();
+
+    if (NULL
+        != sl_get_wifi_asset_tracking_resource()->task_list.
+        link_monitor_task_handler) {
+      xTaskNotifyGive(
+        sl_get_wifi_asset_tracking_resource()->task_list.link_monitor_task_handler);
+    }
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to mark the link down, once per link loss.
+ *****************************************************************************/
+static void sl_link_monitor_set_down(void)
+{
+  taskENTER_CRITICAL();
+  if (SL_LINK_STATE_UP == sl_link_monitor.state) {
+    sl_link_monitor.state = SL_LINK_STATE_DOWN;
+    sl_link_monitor.down_tick = xTaskGetTickCount();
+    sl_link_monitor.down_count++;
+    sl_link_monitor.is_event_pending = true;
+  }
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to add one RSSI sample to the window.
+ *****************************************************************************/
+static void sl_link_monitor_add_sample(int32_t rssi)
+{
+  taskENTER_CRITICAL();
+  sl_link_monitor.rssi_window[sl_link_monitor.next_sample] = rssi;
+  sl_link_monitor.next_sample =
+    (sl_link_monitor.next_sample + 1) % LINK_MONITOR_WINDOW_SIZE;
+  if (sl_link_monitor.sample_count < LINK_MONITOR_WINDOW_SIZE) {
+    sl_link_monitor.sample_count++;
+  }
+  taskEXIT_CRITICAL();
+
+  SL_LOG_DEBUG(SL_LOG_MODULE_WIFI, SL_LOG_FMT_LINK_RSSI, rssi);
+}
+
+/******************************************************************************
+ *  Function to start Wi-Fi recovery after link loss.
+ *****************************************************************************/
+static void sl_link_monitor_start_recovery(void)
+{
+  sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_DISCONNECTED);
+  sl_wifi_asset_tracking_set_wifi_status(SL_WIFI_DISCONNECTED);
+}
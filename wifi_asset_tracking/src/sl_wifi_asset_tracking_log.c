@@ -0,0 +1,277 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_log.c
+ * @brief Deferred logging of hot path log sites
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_log.h>
+
+#if DEMO_CONFIG_DEBUG_LOGS
+#define LOG_DEFAULT_LEVEL                    SL_LOG_LEVEL_DEBUG ///< Level of every module after boot
+#else
+#define LOG_DEFAULT_LEVEL                    SL_LOG_LEVEL_INFO  ///< Level of every module after boot
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
+
+/// @brief Structure for one ring slot, sequence tells producers and the log
+/// task whose turn it is
+typedef struct {
+  uint32_t sequence;            ///< Position + 1 when written, position + LOG_RING_SIZE when read
+  sl_log_record_t record;       ///< Log record
+} sl_log_slot_t;
+
+/// @brief Structure for deferred logger state. Producers reserve a slot by
+/// advancing head and publish it through its sequence, so no lock is taken
+/// and a preempted producer never blocks another one.
+typedef struct {
+  sl_log_slot_t slot[LOG_RING_SIZE];        ///< Ring of records
+  uint32_t head;                            ///< Next position to write
+  uint32_t tail;                            ///< Next position to read, log task only
+  uint32_t dropped;                         ///< Records lost on a full ring since boot
+  uint32_t dropped_reported;                ///< Drops already reported by the log task
+  bool is_task_waiting;                     ///< Log task sleeps until the next record
+  uint8_t level[SL_LOG_MODULE_COUNT];       ///< Runtime level of every module
+} sl_log_t;
+
+/// Deferred logger state, written by all tasks
+static sl_log_t sl_log;
+
+/**************************************************************************/ /**
+ * @brief Function to take the oldest record, log task only.
+ * @param[out] record : oldest record.
+ * @return true when a record was taken.
+ ******************************************************************************/
+static bool sl_log_read(sl_log_record_t *record);
+
+/**************************************************************************/ /**
+ * @brief Function to print one record in the configured output format.
+ * @param[in] record : log record.
+ ******************************************************************************/
+static void sl_log_print(const sl_log_record_t *record);
+
+/******************************************************************************
+ *  Function to reset the ring and the module levels.
+ *****************************************************************************/
+void sl_log_init(void)
+{
+  uint32_t index;
+
+  memset(&sl_log, 0, sizeof(sl_log));
+  for (index = 0; index < LOG_RING_SIZE; index++) {
+    sl_log.slot[index].sequence = index;
+  }
+  memset(sl_log.level, LOG_DEFAULT_LEVEL, sizeof(sl_log.level));
+}
+
+/******************************************************************************
+ *  Task function which formats and prints queued records.
+ *****************************************************************************/
+void sl_log_task()
+{
+  sl_log_record_t record;
+  uint32_t dropped;
+
+  while (1) {
+    while (sl_log_read(&record)) {
+      sl_log_print(&record);
+    }
+
+    /// Drops are reported once the ring has room again
+    dropped = __atomic_load_n(&sl_log.dropped, __ATOMIC_RELAXED);
+    if (dropped != sl_log.dropped_reported) {
+      memset(&record, 0, sizeof(record));
+      record.time_ms = (uint32_t)((xTaskGetTickCount() * portTICK_PERIOD_MS)
+                                  / TIMER_CLOCK_OFFSET);
+      record.format_id = SL_LOG_FMT_LOG_DROPPED;
+      record.module = SL_LOG_MODULE_APP;
+      record.level = SL_LOG_LEVEL_WARN;
+      record.arg_count = 1;
+      record.args[0] = dropped - sl_log.dropped_reported;
+      sl_log.dropped_reported = dropped;
+      sl_log_print(&record);
+    }
+
+    /// A producer which finds the flag set wakes the task, check the ring
+    /// once more after setting it so no record is left behind
+    __atomic_store_n(&sl_log.is_task_waiting, true, __ATOMIC_SEQ_CST);
+    if ((int32_t)(__atomic_load_n(&sl_log.slot[sl_log.tail
+                                               & (LOG_RING_SIZE - 1)].sequence,
+                                  __ATOMIC_ACQUIRE)
+                  - (sl_log.tail + 1)) < 0) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    __atomic_store_n(&sl_log.is_task_waiting, false, __ATOMIC_RELAXED);
+  }
+}
+
+/******************************************************************************
+ *  Function to check whether a module logs at a level.
+ *****************************************************************************/
+bool sl_log_is_enabled(sl_log_module_e module, sl_log_level_e level)
+{
+  if (module >= SL_LOG_MODULE_COUNT) {
+    return false;
+  }
+
+  return (SL_LOG_LEVEL_NONE != level)
+         && (level <= __atomic_load_n(&sl_log.level[module], __ATOMIC_RELAXED));
+}
+
+/******************************************************************************
+ *  Function to record a log site without blocking.
+ *****************************************************************************/
+void sl_log_write(sl_log_module_e module,
+                  sl_log_level_e level,
+                  sl_log_format_id_e format_id,
+                  uint8_t arg_count,
+                  uint32_t arg0,
+                  uint32_t arg1,
+                  uint32_t arg2,
+                  uint32_t arg3)
+{
+  sl_log_slot_t *slot;
+  uint32_t position;
+  uint32_t sequence;
+  TaskHandle_t log_task;
+
+  position = __atomic_load_n(&sl_log.head, __ATOMIC_RELAXED);
+  while (1) {
+    slot = &sl_log.slot[position & (LOG_RING_SIZE - 1)];
+    sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+
+    if (sequence == position) {
+      /// Slot is free, reserve it unless another producer was faster
+      if (__atomic_compare_exchange_n(&sl_log.head,
+                                      &position,
+                                      position + 1,
+                                      true,
+                                      __ATOMIC_RELAXED,
+                                      __ATOMIC_RELAXED)) {
+        break;
+      }
+    } else if ((int32_t)(sequence - position) < 0) {
+      /// Slot still holds a record of the previous lap, ring is full
+      __atomic_fetch_add(&sl_log.dropped, 1, __ATOMIC_RELAXED);
+      return;
+    } else {
+      position = __atomic_load_n(&sl_log.head, __ATOMIC_RELAXED);
+    }
+  }
+
+  slot->record.time_ms = (uint32_t)((xTaskGetTickCount() * portTICK_PERIOD_MS)
+                                    / TIMER_CLOCK_OFFSET);
+  slot->record.format_id = (uint16_t)format_id;
+  slot->record.module = (uint8_t)module;
+  slot->record.level = (uint8_t)level;
+  slot->record.arg_count = (arg_count > LOG_MAX_ARGS) ? LOG_MAX_ARGS : arg_count;
+  slot->record.args[0] = arg0;
+  slot->record.args[1] = arg1;
+  slot->record.args[2] = arg2;
+  slot->record.args[3] = arg3;
+  __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+
+  log_task = sl_get_wifi_asset_tracking_resource()->task_list.log_task_handler;
+  if ((NULL != log_task)
+      && __atomic_exchange_n(&sl_log.is_task_waiting, false, __ATOMIC_SEQ_CST)) {
+    xTaskNotifyGive(log_task);
+  }
+}
+
+/******************************************************************************
+ *  Function to change the level of a module at runtime.
+ *****************************************************************************/
+sl_status_t sl_log_set_level(sl_log_module_e module, sl_log_level_e level)
+{
+  uint32_t index;
+
+  if ((module > SL_LOG_MODULE_COUNT) || (level >= SL_LOG_LEVEL_COUNT)) {
+    return SL_STATUS_FAIL;
+  }
+
+  for (index = 0; index < SL_LOG_MODULE_COUNT; index++) {
+    if ((SL_LOG_MODULE_COUNT == module) || (index == (uint32_t)module)) {
+      __atomic_store_n(&sl_log.level[index], (uint8_t)level, __ATOMIC_RELAXED);
+    }
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to get the level of a module.
+ *****************************************************************************/
+sl_log_level_e sl_log_get_level(sl_log_module_e module)
+{
+  if (module >= SL_LOG_MODULE_COUNT) {
+    return SL_LOG_LEVEL_NONE;
+  }
+
+  return (sl_log_level_e)__atomic_load_n(&sl_log.level[module],
+                                         __ATOMIC_RELAXED);
+}
+
+/******************************************************************************
+ *  Function to get the records dropped on a full ring since boot.
+ *****************************************************************************/
+uint32_t sl_log_get_dropped(void)
+{
+  return __atomic_load_n(&sl_log.dropped, __ATOMIC_RELAXED);
+}
+
+/******************************************************************************
+ *  Function to take the oldest record.
+ *****************************************************************************/
+static bool sl_log_read(sl_log_record_t *record)
+{
+  sl_log_slot_t *slot = &sl_log.slot[sl_log.tail & (LOG_RING_SIZE - 1)];
+
+  /// Record of a producer which reserved the slot but is not done yet
+  if ((int32_t)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE)
+                - (sl_log.tail + 1)) < 0) {
+    return false;
+  }
+
+  memcpy(record, &slot->record, sizeof(*record));
+  __atomic_store_n(&slot->sequence,
+                   sl_log.tail + LOG_RING_SIZE,
+                   __ATOMIC_RELEASE);
+  sl_log.tail++;
+
+  return true;
+}
+
+/******************************************************************************
+ *  Function to print one record in the configured output format.
+ *****************************************************************************/
+static void sl_log_print(const sl_log_record_t *record)
+{
+#if DEMO_CONFIG_LOG_BINARY_OUTPUT
+  char frame[LOG_FRAME_MAX_SIZE];
+
+  if (SL_STATUS_OK == sl_log_encode_frame(record, frame, sizeof(frame))) {
+    printf("\r\n%s\r\n", frame);
+  }
+#else
+  char text[LOG_TEXT_BUFF_SIZE];
+
+  if (SL_STATUS_OK != sl_log_format_record(record, text, sizeof(text))) {
+    printf("\r\nsl_log_task : record of format %u is not valid\r\n",
+           record->format_id);
+    return;
+  }
+  printf("\r\n%s\r\n", text);
+#endif /// < DEMO_CONFIG_LOG_BINARY_OUTPUT
+}
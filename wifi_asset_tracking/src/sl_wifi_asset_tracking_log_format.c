@@ -0,0 +1,321 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_log_format.c
+ * @brief Format table and record encoding of the deferred logger
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_log_format.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define LOG_FORMAT_SPEC_SIZE                 16     ///< Longest single conversion specification
+
+/// Formats in format ID order, also compiled into the host decoder
+static const char *const sl_log_formats[SL_LOG_FMT_COUNT] = {
+#define SL_LOG_FORMAT_STRING(id, format) format,
+  SL_LOG_FORMAT_LIST(SL_LOG_FORMAT_STRING)
+#undef SL_LOG_FORMAT_STRING
+};
+
+static const char *const sl_log_module_names[SL_LOG_MODULE_COUNT] = {
+  "app",
+  "sensor",
+  "json",
+  "lanes",
+  "cloud",
+  "wifi"
+};
+
+static const char *const sl_log_level_names[SL_LOG_LEVEL_COUNT] = {
+  "NONE",
+  "ERROR",
+  "WARN",
+  "INFO",
+  "DEBUG",
+  "TRACE"
+};
+
+/**************************************************************************/ /**
+ * @brief Function to get the value of a hex digit.
+ * @param[in] digit : character.
+ * @return value, -1 when digit is not a hex digit.
+ ******************************************************************************/
+static int sl_log_hex_value(char digit);
+
+/******************************************************************************
+ *  Function to get the format of a format ID.
+ *****************************************************************************/
+const char *sl_log_get_format(uint16_t format_id)
+{
+  if (format_id >= SL_LOG_FMT_COUNT) {
+    return NULL;
+  }
+
+  return sl_log_formats[format_id];
+}
+
+/******************************************************************************
+ *  Function to get the name of a module.
+ *****************************************************************************/
+const char *sl_log_get_module_name(uint8_t module)
+{
+  if (module >= SL_LOG_MODULE_COUNT) {
+    return "?";
+  }
+
+  return sl_log_module_names[module];
+}
+
+/******************************************************************************
+ *  Function to get the name of a level.
+ *****************************************************************************/
+const char *sl_log_get_level_name(uint8_t level)
+{
+  if (level >= SL_LOG_LEVEL_COUNT) {
+    return "?";
+  }
+
+  return sl_log_level_names[level];
+}
+
+/******************************************************************************
+ *  Function to expand a record into text.
+ *****************************************************************************/
+sl_status_t sl_log_format_record(const sl_log_record_t *record,
+                                 char *text,
+                                 size_t text_size)
+{
+  const char *format;
+  char spec[LOG_FORMAT_SPEC_SIZE];
+  size_t spec_len;
+  size_t text_len = 0;
+  uint8_t arg_index = 0;
+  uint32_t arg;
+  int written;
+
+  if ((0 == text_size) || (record->arg_count > LOG_MAX_ARGS)) {
+    return SL_STATUS_FAIL;
+  }
+  text[0] = '\0';
+
+  format = sl_log_get_format(record->format_id);
+  if (NULL == format) {
+    return SL_STATUS_FAIL;
+  }
+
+  while (('\0' != *format) && (text_len + 1 < text_size)) {
+    if ('%' != *format) {
+      text[text_len++] = *format++;
+      continue;
+    }
+
+    format++;
+    if ('%' == *format) {
+      text[text_len++] = *format++;
+      continue;
+    }
+
+    /// Flags, width and precision are kept, the length is always long
+    spec[0] = '%';
+    spec_len = 1;
+    while (('\0' != *format)
+           && (NULL != strchr("-+ #0123456789.", *format))
+           && (spec_len < LOG_FORMAT_SPEC_SIZE - 3)) {
+      spec[spec_len++] = *format++;
+    }
+    while (('l' == *format) || ('h' == *format)) {
+      format++;
+    }
+
+    if (('\0' == *format) || (arg_index >= record->arg_count)) {
+      goto error;
+    }
+    arg = record->args[arg_index++];
+
+    switch (*format) {
+      case 'd':
+      case 'i':
+        spec[spec_len++] = 'l';
+        spec[spec_len++] = *format;
+        spec[spec_len] = '\0';
+        written = snprintf(&text[text_len],
+                           text_size - text_len,
+                           spec,
+                           (long)(int32_t)arg);
+        break;
+      case 'u':
+      case 'x':
+      case 'X':
+        spec[spec_len++] = 'l';
+        spec[spec_len++] = *format;
+        spec[spec_len] = '\0';
+        written = snprintf(&text[text_len],
+                           text_size - text_len,
+                           spec,
+                           (unsigned long)arg);
+        break;
+      case 'c':
+        spec[spec_len++] = 'c';
+        spec[spec_len] = '\0';
+        written = snprintf(&text[text_len],
+                           text_size - text_len,
+                           spec,
+                           (int)(uint8_t)arg);
+        break;
+      default:
+        goto error;
+    }
+    format++;
+
+    if (written < 0) {
+      goto error;
+    }
+    /// Output is cut at text_size like snprintf does
+    text_len += ((size_t)written < (text_size - text_len))
+                ? (size_t)written : (text_size - text_len - 1);
+  }
+
+  text[text_len] = '\0';
+  return SL_STATUS_OK;
+
+  error:
+  text[text_len] = '\0';
+  return SL_STATUS_FAIL;
+}
+
+/******************************************************************************
+ *  Function to encode a record as a console line.
+ *****************************************************************************/
+sl_status_t sl_log_encode_frame(const sl_log_record_t *record,
+                                char *frame,
+                                size_t frame_size)
+{
+  static const char hex_digits[] = "0123456789ABCDEF";
+  uint8_t binary[LOG_RECORD_MAX_SIZE];
+  size_t binary_len;
+  size_t frame_len;
+  size_t index;
+  uint8_t arg_index;
+
+  if ((frame_size < LOG_FRAME_MAX_SIZE)
+      || (record->arg_count > LOG_MAX_ARGS)
+      || (record->level >= SL_LOG_LEVEL_COUNT)) {
+    return SL_STATUS_FAIL;
+  }
+
+  binary[0] = (uint8_t)record->time_ms;
+  binary[1] = (uint8_t)(record->time_ms >> 8);
+  binary[2] = (uint8_t)(record->time_ms >> 16);
+  binary[3] = (uint8_t)(record->time_ms >> 24);
+  binary[4] = (uint8_t)record->format_id;
+  binary[5] = (uint8_t)(record->format_id >> 8);
+  binary[6] = record->module;
+  binary[7] = (uint8_t)((record->level << 4) | record->arg_count);
+  binary_len = LOG_RECORD_HEADER_SIZE;
+
+  for (arg_index = 0; arg_index < record->arg_count; ++arg_index) {
+    binary[binary_len++] = (uint8_t)record->args[arg_index];
+    binary[binary_len++] = (uint8_t)(record->args[arg_index] >> 8);
+    binary[binary_len++] = (uint8_t)(record->args[arg_index] >> 16);
+    binary[binary_len++] = (uint8_t)(record->args[arg_index] >> 24);
+  }
+
+  memcpy(frame, LOG_FRAME_MARKER, strlen(LOG_FRAME_MARKER));
+  frame_len = strlen(LOG_FRAME_MARKER);
+  for (index = 0; index < binary_len; ++index) {
+    frame[frame_len++] = hex_digits[binary[index] >> 4];
+    frame[frame_len++] = hex_digits[binary[index] & 0x0F];
+  }
+  frame[frame_len] = '\0';
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to decode a console line written by sl_log_encode_frame.
+ *****************************************************************************/
+sl_status_t sl_log_decode_frame(const char *frame, sl_log_record_t *record)
+{
+  uint8_t binary[LOG_RECORD_MAX_SIZE];
+  size_t binary_len = 0;
+  size_t marker_len = strlen(LOG_FRAME_MARKER);
+  uint8_t arg_index;
+  int high;
+  int low;
+
+  if (0 != strncmp(frame, LOG_FRAME_MARKER, marker_len)) {
+    return SL_STATUS_FAIL;
+  }
+  frame += marker_len;
+
+  while (('\0' != frame[0]) && ('\r' != frame[0]) && ('\n' != frame[0])) {
+    high = sl_log_hex_value(frame[0]);
+    low = sl_log_hex_value(frame[1]);
+    if ((high < 0) || (low < 0) || (binary_len >= sizeof(binary))) {
+      return SL_STATUS_FAIL;
+    }
+    binary[binary_len++] = (uint8_t)((high << 4) | low);
+    frame += 2;
+  }
+
+  if (binary_len < LOG_RECORD_HEADER_SIZE) {
+    return SL_STATUS_FAIL;
+  }
+
+  memset(record, 0, sizeof(*record));
+  record->time_ms = (uint32_t)binary[0]
+                    | ((uint32_t)binary[1] << 8)
+                    | ((uint32_t)binary[2] << 16)
+                    | ((uint32_t)binary[3] << 24);
+  record->format_id = (uint16_t)(binary[4] | (binary[5] << 8));
+  record->module = binary[6];
+  record->level = (uint8_t)(binary[7] >> 4);
+  record->arg_count = (uint8_t)(binary[7] & 0x0F);
+
+  if ((record->arg_count > LOG_MAX_ARGS)
+      || (binary_len
+          != (size_t)(LOG_RECORD_HEADER_SIZE + (4 * record->arg_count)))) {
+    return SL_STATUS_FAIL;
+  }
+
+  for (arg_index = 0; arg_index < record->arg_count; ++arg_index) {
+    record->args[arg_index] =
+      (uint32_t)binary[LOG_RECORD_HEADER_SIZE + (4 * arg_index)]
+      | ((uint32_t)binary[LOG_RECORD_HEADER_SIZE + (4 * arg_index) + 1] << 8)
+      | ((uint32_t)binary[LOG_RECORD_HEADER_SIZE + (4 * arg_index) + 2] << 16)
+      | ((uint32_t)binary[LOG_RECORD_HEADER_SIZE + (4 * arg_index) + 3] << 24);
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to get the value of a hex digit.
+ *****************************************************************************/
+static int sl_log_hex_value(char digit)
+{
+  if ((digit >= '0') && (digit <= '9')) {
+    return digit - '0';
+  }
+  if ((digit >= 'A') && (digit <= 'F')) {
+    return digit - 'A' + 10;
+  }
+  if ((digit >= 'a') && (digit <= 'f')) {
+    return digit - 'a' + 10;
+  }
+
+  return -1;
+}
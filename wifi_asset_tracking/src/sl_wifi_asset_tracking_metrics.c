@@ -0,0 +1,307 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_metrics.c
+ * @brief Runtime metrics registry and diagnostics snapshot
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_metrics.h>
+
+/// @brief Structure for metric storage, each value is updated with a single
+/// atomic operation so hot paths take no lock
+typedef struct {
+  uint32_t counters[SL_METRIC_COUNTER_COUNT];                                   ///< Counters
+  int32_t gauges[SL_METRIC_GAUGE_COUNT];                                        ///< Gauges
+  uint32_t histograms[SL_METRIC_HISTOGRAM_COUNT][METRICS_HISTOGRAM_BUCKETS];    ///< Histogram bucket counts
+} sl_metrics_t;
+
+/// Metric storage, written by all tasks
+static sl_metrics_t sl_metrics;
+
+/// Upper bounds of histogram buckets, a value goes to the first bucket whose
+/// bound is not below it and the last bucket takes the rest
+static const uint32_t
+  sl_metrics_bounds[SL_METRIC_HISTOGRAM_COUNT][METRICS_HISTOGRAM_BUCKETS - 1] = {
+  { 100, 500, 1000, 5000, 15000 },       ///< SL_METRIC_PUBLISH_LATENCY
+  { 10, 50, 100, 250, 1000 },            ///< SL_METRIC_PUBLISH_TIME
+  { 10, 50, 100, 500, 1000 },            ///< SL_METRIC_SAMPLE_HANDOFF
+  { 100, 500, 1000, 5000, 15000 },       ///< SL_METRIC_SAMPLE_LATENCY
+  { 1000, 5000, 30000, 120000, 600000 }, ///< SL_METRIC_RECOVERY_TIME
+};
+
+/// Counter names for console dump
+static const char *const sl_metrics_counter_names[SL_METRIC_COUNTER_COUNT] = {
+  "sensor_samples",
+  "sensor_queue_drops",
+  "sensor_read_failures",
+  "json_messages",
+  "json_failures",
+  "lane_drops",
+  "published",
+  "publish_failures",
+  "publish_throttled",
+  "wifi_connects",
+  "cloud_connects",
+  "recovery_attempts",
+  "recovery_failures",
+};
+
+/// Gauge names for console dump
+static const char *const sl_metrics_gauge_names[SL_METRIC_GAUGE_COUNT] = {
+  "uptime",
+  "sensor_queue_depth",
+  "sensor_queue_peak",
+  "lane_depth",
+  "lane_peak",
+  "free_heap",
+  "min_free_heap",
+  "min_stack",
+  "rssi",
+  "supervisor_restarts",
+  "reset_reason",
+  "reset_task",
+  "recovery_pending",
+  "recovery_backoff",
+};
+
+/// Histogram names for console dump
+static const char *const sl_metrics_histogram_names[SL_METRIC_HISTOGRAM_COUNT] = {
+  "publish_latency_ms",
+  "publish_time_ms",
+  "sample_handoff_ms",
+  "sample_latency_ms",
+  "recovery_time_ms",
+};
+
+/******************************************************************************
+ *  Task function which snapshots and reports metrics.
+ *****************************************************************************/
+void sl_metrics_task()
+{
+  sl_metrics_snapshot_t snapshot;
+
+  while (1) {
+    vTaskDelay(pdMS_TO_TICKS(METRICS_REPORT_INTERVAL * 1000)
+               * TIMER_CLOCK_OFFSET);
+
+    sl_metrics_snapshot(&snapshot);
+
+#if DEMO_CONFIG_DEBUG_LOGS
+    sl_metrics_dump(&snapshot);
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
+
+#if DEMO_CONFIG_STACK_PROFILE
+    sl_stack_profile_sample();
+    sl_stack_profile_report();
+#endif /// < DEMO_CONFIG_STACK_PROFILE
+
+#if DEMO_CONFIG_DIAGNOSTICS
+    if ((SL_CLOUD_CONNECTED
+         == sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status)
+        && (SL_WIFI_CONNECTED
+            == sl_get_wifi_asset_tracking_status()->wifi_conn_status)) {
+      sl_json_send_diagnostics_message(&snapshot);
+    }
+#endif /// < DEMO_CONFIG_DIAGNOSTICS
+  }
+}
+
+/******************************************************************************
+ *  Function to add one to a counter.
+ *****************************************************************************/
+void sl_metrics_increment(sl_metric_counter_e counter)
+{
+  __atomic_fetch_add(&sl_metrics.counters[counter], 1, __ATOMIC_RELAXED);
+}
+
+/******************************************************************************
+ *  Function to set a gauge.
+ *****************************************************************************/
+void sl_metrics_set_gauge(sl_metric_gauge_e gauge, int32_t value)
+{
+  __atomic_store_n(&sl_metrics.gauges[gauge], value, __ATOMIC_RELAXED);
+}
+
+/******************************************************************************
+ *  Function to raise a peak gauge.
+ *****************************************************************************/
+void sl_metrics_raise_gauge(sl_metric_gauge_e gauge, int32_t value)
+{
+  int32_t current = __atomic_load_n(&sl_metrics.gauges[gauge],
+                                    __ATOMIC_RELAXED);
+
+  /// A failed exchange reloads current, retried only while value is larger
+  while ((value > current)
+         && (!__atomic_compare_exchange_n(&sl_metrics.gauges[gauge],
+                                          &current,
+                                          value,
+                                          false,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED))) {
+  }
+}
+
+/******************************************************************************
+ *  Function to count a value in its histogram bucket.
+ *****************************************************************************/
+void sl_metrics_observe(sl_metric_histogram_e histogram, uint32_t value)
+{
+  uint8_t bucket = 0;
+
+  while ((bucket < (METRICS_HISTOGRAM_BUCKETS - 1))
+         && (value > sl_metrics_bounds[histogram][bucket])) {
+    bucket++;
+  }
+
+  __atomic_fetch_add(&sl_metrics.histograms[histogram][bucket],
+                     1,
+                     __ATOMIC_RELAXED);
+}
+
+/******************************************************************************
+ *  Function to sample gauges and copy all metrics.
+ *****************************************************************************/
+void sl_metrics_snapshot(sl_metrics_snapshot_t *snapshot)
+{
+  TaskHandle_t task;
+  UBaseType_t stack;
+  UBaseType_t min_stack = 0;
+  int32_t rssi;
+  uint8_t index;
+  uint8_t histogram;
+
+  /// Gauges which are cheaper to read here than to track on hot paths
+  sl_metrics_set_gauge(SL_METRIC_UPTIME,
+                       (int32_t)(((uint64_t)xTaskGetTickCount()
+                                  * portTICK_PERIOD_MS)
+                                 / TIMER_CLOCK_OFFSET / 1000));
+  if (NULL
+      != sl_get_wifi_asset_tracking_resource()->sensor_data_queue_handler) {
+    sl_metrics_set_gauge(SL_METRIC_SENSOR_QUEUE_DEPTH,
+                         (int32_t)uxQueueMessagesWaiting(
+                           sl_get_wifi_asset_tracking_resource()->
+                           sensor_data_queue_handler));
+  }
+  sl_metrics_set_gauge(SL_METRIC_LANE_DEPTH,
+                       (int32_t)sl_publish_lane_messages_waiting());
+  sl_metrics_set_gauge(SL_METRIC_FREE_HEAP, (int32_t)xPortGetFreeHeapSize());
+  sl_metrics_set_gauge(SL_METRIC_MIN_FREE_HEAP,
+                       (int32_t)xPortGetMinimumEverFreeHeapSize());
+
+  for (index = 0; index < SL_STATIC_TASK_COUNT; index++) {
+    task = sl_static_get_task_handle((sl_static_task_e)index);
+    if (NULL == task) {
+      continue;
+    }
+    stack = uxTaskGetStackHighWaterMark(task);
+    if ((0 == min_stack) || (stack < min_stack)) {
+      min_stack = stack;
+    }
+  }
+  sl_metrics_set_gauge(SL_METRIC_MIN_STACK, (int32_t)min_stack);
+
+  if (SL_STATUS_OK != sl_link_monitor_get_rssi(&rssi)) {
+    rssi = 0;
+  }
+  sl_metrics_set_gauge(SL_METRIC_RSSI, rssi);
+
+  for (index = 0; index < SL_METRIC_COUNTER_COUNT; index++) {
+    snapshot->values[METRICS_COUNTER_OFFSET + index] =
+      __atomic_load_n(&sl_metrics.counters[index], __ATOMIC_RELAXED);
+  }
+
+  for (index = 0; index < SL_METRIC_GAUGE_COUNT; index++) {
+    snapshot->values[METRICS_GAUGE_OFFSET + index] =
+      (uint32_t)__atomic_load_n(&sl_metrics.gauges[index], __ATOMIC_RELAXED);
+  }
+
+  for (histogram = 0; histogram < SL_METRIC_HISTOGRAM_COUNT; histogram++) {
+    for (index = 0; index < METRICS_HISTOGRAM_BUCKETS; index++) {
+      snapshot->values[METRICS_HISTOGRAM_OFFSET
+                       + (histogram * METRICS_HISTOGRAM_BUCKETS) + index] =
+        __atomic_load_n(&sl_metrics.histograms[histogram][index],
+                        __ATOMIC_RELAXED);
+    }
+  }
+}
+
+/******************************************************************************
+ *  Function to print a snapshot on the console.
+ *****************************************************************************/
+void sl_metrics_dump(const sl_metrics_snapshot_t *snapshot)
+{
+  TaskHandle_t task;
+  const uint32_t *buckets;
+  uint8_t index;
+  uint8_t histogram;
+
+  printf("\r\nsl_metrics_dump : schema version %d\r\n",
+         METRICS_SCHEMA_VERSION);
+
+  for (index = 0; index < SL_METRIC_COUNTER_COUNT; index++) {
+    printf("  %-22s %lu\r\n",
+           sl_metrics_counter_names[index],
+           snapshot->values[METRICS_COUNTER_OFFSET + index]);
+  }
+
+  for (index = 0; index < SL_METRIC_GAUGE_COUNT; index++) {
+    printf("  %-22s %ld\r\n",
+           sl_metrics_gauge_names[index],
+           (int32_t)snapshot->values[METRICS_GAUGE_OFFSET + index]);
+  }
+
+  for (histogram = 0; histogram < SL_METRIC_HISTOGRAM_COUNT; histogram++) {
+    buckets = &snapshot->values[METRICS_HISTOGRAM_OFFSET
+                                + (histogram * METRICS_HISTOGRAM_BUCKETS)];
+    printf("  %-22s", sl_metrics_histogram_names[histogram]);
+    for (index = 0; index < (METRICS_HISTOGRAM_BUCKETS - 1); index++) {
+      printf(" <=%lu:%lu", sl_metrics_bounds[histogram][index], buckets[index]);
+    }
+    printf(" >%lu:%lu\r\n",
+           sl_metrics_bounds[histogram][METRICS_HISTOGRAM_BUCKETS - 2],
+           buckets[METRICS_HISTOGRAM_BUCKETS - 1]);
+  }
+
+  /// Unused stack in words per task
+  for (index = 0; index < SL_STATIC_TASK_COUNT; index++) {
+    task = sl_static_get_task_handle((sl_static_task_e)index);
+    if (NULL == task) {
+      continue;
+    }
+    printf("  task %-26s stack free %lu\r\n",
+           pcTaskGetName(task),
+           (uint32_t)uxTaskGetStackHighWaterMark(task));
+  }
+
+#if (1 == configGENERATE_RUN_TIME_STATS) && (1 == configUSE_TRACE_FACILITY)
+  {
+    static TaskStatus_t task_status[SL_STATIC_TASK_COUNT + 4];
+    uint32_t total_run_time;
+    UBaseType_t task_count;
+
+    /// CPU share since boot, run time counter is set up by the port
+    task_count = uxTaskGetSystemState(task_status,
+                                      SL_STATIC_TASK_COUNT + 4,
+                                      &total_run_time);
+    total_run_time /= 100;
+    for (index = 0; (index < task_count) && (0 != total_run_time); index++) {
+      printf("  task %-26s cpu %lu %%\r\n",
+             task_status[index].pcTaskName,
+             (uint32_t)(task_status[index].ulRunTimeCounter / total_run_time));
+    }
+  }
+#endif /// < configGENERATE_RUN_TIME_STATS && configUSE_TRACE_FACILITY
+}
@@ -0,0 +1,280 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_power_save.c
+ * @brief Wi-Fi power save between publish bursts
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_power_save.h>
+
+/// @brief Structure for power save state and time accounting
+typedef struct {
+  bool is_started;                ///< Power save entered once, accounting runs
+  bool is_power_save;             ///< Associated power save profile is set
+  bool is_burst_active;           ///< Publish burst is running
+  TickType_t profile_tick;        ///< Tick of last profile change
+  TickType_t cadence_tick;        ///< Origin of publish burst cadence
+  TickType_t report_tick;         ///< Tick of last radio-on report
+  uint32_t bursts;                ///< Publish bursts
+  uint32_t awake_ms;              ///< Time in high performance profile
+  uint32_t power_save_ms;         ///< Time in associated power save profile
+} sl_power_save_t;
+
+/// Power save state, changed by the cloud communication and recovery tasks
+static sl_power_save_t sl_power_save;
+
+/**************************************************************************/ /**
+ * @brief Function to convert ticks elapsed since a tick count to ms.
+ * @param[in] since_tick : start tick count.
+ * @return elapsed time in ms.
+ ******************************************************************************/
+static uint32_t sl_power_save_elapsed_ms(TickType_t since_tick);
+
+/**************************************************************************/ /**
+ * @brief Function to set a performance profile of the network processor.
+ * @param[in] profile : HIGH_PERFORMANCE or ASSOCIATED_POWER_SAVE.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the profile is not accepted
+ ******************************************************************************/
+static sl_status_t sl_power_save_set_profile(sl_performance_profile_t profile);
+
+/******************************************************************************
+ *  Function to configure the listen interval.
+ *****************************************************************************/
+sl_status_t sl_power_save_init(void)
+{
+  sl_status_t status;
+  sl_wifi_listen_interval_t listen_interval = {
+    .listen_interval = POWER_SAVE_LISTEN_INTERVAL
+  };
+
+  memset(&sl_power_save, 0, sizeof(sl_power_save));
+
+  status = sl_wifi_set_listen_interval(SL_WIFI_CLIENT_INTERFACE,
+                                       listen_interval);
+  if (SL_STATUS_OK != status) {
+    printf(
+      "\r\nsl_power_save_init : Failed to set listen interval: 0x%lx\r\n",
+      status);
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to put the network processor in associated power save.
+ *****************************************************************************/
+sl_status_t sl_power_save_enter(void)
+{
+  sl_power_save.is_burst_active = false;
+
+  if (sl_power_save.is_power_save) {
+    return SL_STATUS_OK;
+  }
+
+  if (SL_STATUS_OK != sl_power_save_set_profile(ASSOCIATED_POWER_SAVE)) {
+    return SL_STATUS_FAIL;
+  }
+
+  taskENTER_CRITICAL();
+  if (sl_power_save.is_started) {
+    sl_power_save.awake_ms +=
+      sl_power_save_elapsed_ms(sl_power_save.profile_tick);
+  } else {
+    sl_power_save.is_started = true;
+    sl_power_save.report_tick = xTaskGetTickCount();
+  }
+  sl_power_save.profile_tick = xTaskGetTickCount();
+  sl_power_save.cadence_tick = sl_power_save.profile_tick;
+  sl_power_save.is_power_save = true;
+  taskEXIT_CRITICAL();
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to put the network processor in high performance.
+ *****************************************************************************/
+sl_status_t sl_power_save_exit(void)
+{
+  if (!sl_power_save.is_power_save) {
+    return SL_STATUS_OK;
+  }
+
+  if (SL_STATUS_OK != sl_power_save_set_profile(HIGH_PERFORMANCE)) {
+    return SL_STATUS_FAIL;
+  }
+
+  taskENTER_CRITICAL();
+  sl_power_save.power_save_ms +=
+    sl_power_save_elapsed_ms(sl_power_save.profile_tick);
+  sl_power_save.profile_tick = xTaskGetTickCount();
+  sl_power_save.is_power_save = false;
+  taskEXIT_CRITICAL();
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to get the wait before the next publish burst.
+ *****************************************************************************/
+uint32_t sl_power_save_get_burst_delay(uint32_t due_ms)
+{
+  uint64_t elapsed_ms;
+  uint64_t burst_ms;
+
+  if ((!sl_power_save.is_power_save) || (0 == due_ms)) {
+    return 0;
+  }
+
+  /// The network processor does not report its beacon phase, so bursts
+  /// follow a fixed cadence counted from power save entry. Each burst wakes
+  /// the radio itself; the cadence only keeps bursts at least one listen
+  /// interval apart, so messages gather instead of waking it one by one.
+  /// Sensor deadlines are not an input: a reading reaches a lane only once
+  /// it is sampled, and its lane latency cap then bounds the burst through
+  /// due_ms
+  elapsed_ms = sl_power_save_elapsed_ms(sl_power_save.cadence_tick);
+  burst_ms = ((elapsed_ms + due_ms) / POWER_SAVE_LISTEN_INTERVAL)
+             * POWER_SAVE_LISTEN_INTERVAL;
+
+  if (burst_ms <= elapsed_ms) {
+    return 0;
+  }
+
+  return (uint32_t)(burst_ms - elapsed_ms);
+}
+
+/******************************************************************************
+ *  Function to start a publish burst.
+ *****************************************************************************/
+void sl_power_save_begin_burst(void)
+{
+  sl_power_save.is_burst_active = true;
+
+  taskENTER_CRITICAL();
+  sl_power_save.bursts++;
+  taskEXIT_CRITICAL();
+
+  sl_power_save_exit();
+}
+
+/******************************************************************************
+ *  Function to end a publish burst.
+ *****************************************************************************/
+void sl_power_save_end_burst(void)
+{
+  sl_power_save_metrics_t metrics;
+
+  sl_power_save_enter();
+
+  if (sl_power_save_elapsed_ms(sl_power_save.report_tick)
+      >= (POWER_SAVE_REPORT_INTERVAL * 1000)) {
+    sl_power_save.report_tick = xTaskGetTickCount();
+    sl_power_save_get_metrics(&metrics);
+    printf(
+      "\r\nsl_power_save_end_burst : %lu bursts, awake %lu ms, power save %lu ms, radio-on %lu ms per hour\r\n",
+      metrics.bursts,
+      metrics.awake_ms,
+      metrics.power_save_ms,
+      metrics.radio_on_ms_per_hour);
+  }
+}
+
+/******************************************************************************
+ *  Function to check whether a publish burst is running.
+ *****************************************************************************/
+bool sl_power_save_is_burst_active(void)
+{
+  return sl_power_save.is_burst_active;
+}
+
+/******************************************************************************
+ *  Function to read power save metrics.
+ *****************************************************************************/
+void sl_power_save_get_metrics(sl_power_save_metrics_t *metrics)
+{
+  uint64_t radio_on_ms;
+  uint64_t total_ms;
+
+  memset(metrics, 0, sizeof(*metrics));
+
+  taskENTER_CRITICAL();
+  metrics->bursts = sl_power_save.bursts;
+  metrics->awake_ms = sl_power_save.awake_ms;
+  metrics->power_save_ms = sl_power_save.power_save_ms;
+  if (sl_power_save.is_started) {
+    if (sl_power_save.is_power_save) {
+      metrics->power_save_ms +=
+        sl_power_save_elapsed_ms(sl_power_save.profile_tick);
+    } else {
+      metrics->awake_ms += sl_power_save_elapsed_ms(sl_power_save.profile_tick);
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  total_ms = (uint64_t)metrics->awake_ms + metrics->power_save_ms;
+  if (0 == total_ms) {
+    return;
+  }
+
+  /// Upper estimate, the radio is counted on for the whole burst
+  radio_on_ms = metrics->awake_ms
+                + (((uint64_t)metrics->power_save_ms
+                    / POWER_SAVE_LISTEN_INTERVAL) * POWER_SAVE_BEACON_RX_TIME);
+  metrics->radio_on_ms_per_hour =
+    (uint32_t)((radio_on_ms * 3600000u) / total_ms);
+}
+
+/******************************************************************************
+ *  Function to convert ticks elapsed since a tick count to ms.
+ *****************************************************************************/
+static uint32_t sl_power_save_elapsed_ms(TickType_t since_tick)
+{
+  return (uint32_t)(((xTaskGetTickCount() - since_tick) * portTICK_PERIOD_MS)
+                    / TIMER_CLOCK_OFFSET);
+}
+
+/******************************************************************************
+ *  Function to set a performance profile of the network processor.
+ *****************************************************************************/
+static sl_status_t sl_power_save_set_profile(sl_performance_profile_t profile)
+{
+  sl_status_t status;
+  sl_wifi_performance_profile_t performance_profile = {
+    .profile = profile,
+    .dtim_aligned_type = POWER_SAVE_DTIM_ALIGNED,
+    .listen_interval = POWER_SAVE_LISTEN_INTERVAL
+  };
+
+  status = sl_wifi_set_performance_profile(&performance_profile);
+  if (SL_STATUS_OK != status) {
+    printf(
+      "\r\nsl_power_save_set_profile : Failed to set performance profile %d: 0x%lx\r\n",
+      profile,
+      status);
+    return SL_STATUS_FAIL;
+  }
+#if DEMO_CONFIG_DEBUG_LOGS
+  printf("\r\nsl_power_save_set_profile : performance profile %d\r\n",
+         profile);
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
+
+  return SL_STATUS_OK;
+}
@@ -0,0 +1,557 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_publish_lanes.c
+ * @brief Priority lanes between JSON producers and the cloud communication task
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_publish_lanes.h>
+
+/// Largest lane capacity, sizes the enqueue tick ring of every lane
+#define PUBLISH_LANE_MAX_CAPACITY                                      \
+  ((PUBLISH_LANE_CRITICAL_CAPACITY > PUBLISH_LANE_NORMAL_CAPACITY)     \
+   ? ((PUBLISH_LANE_CRITICAL_CAPACITY > PUBLISH_LANE_BULK_CAPACITY)    \
+      ? PUBLISH_LANE_CRITICAL_CAPACITY : PUBLISH_LANE_BULK_CAPACITY)   \
+   : ((PUBLISH_LANE_NORMAL_CAPACITY > PUBLISH_LANE_BULK_CAPACITY)      \
+      ? PUBLISH_LANE_NORMAL_CAPACITY : PUBLISH_LANE_BULK_CAPACITY))
+
+/// @brief Structure for static lane configuration, lane capacity sizes the
+/// static lane queue storage
+typedef struct {
+  uint8_t weight;                            ///< PUBLISH_LANE_WEIGHT_STRICT or share
+  sl_publish_lane_drop_policy_e drop_policy; ///< Message dropped when full
+  uint32_t latency_cap;                      ///< In ms, longest wait for a publish burst
+} sl_publish_lane_config_t;
+
+/// Lane configuration, indexed by sl_publish_lane_e
+static const sl_publish_lane_config_t sl_publish_lane_config[SL_PUBLISH_LANE_COUNT] = {
+  { PUBLISH_LANE_CRITICAL_WEIGHT, PUBLISH_LANE_CRITICAL_DROP_POLICY, PUBLISH_LANE_CRITICAL_LATENCY_CAP },
+  { PUBLISH_LANE_NORMAL_WEIGHT, PUBLISH_LANE_NORMAL_DROP_POLICY, PUBLISH_LANE_NORMAL_LATENCY_CAP },
+  { PUBLISH_LANE_BULK_WEIGHT, PUBLISH_LANE_BULK_DROP_POLICY, PUBLISH_LANE_BULK_LATENCY_CAP },
+};
+
+/// Messages a weighted lane may still send in the current round
+static uint8_t sl_publish_lane_credit[SL_PUBLISH_LANE_COUNT];
+
+/// Per-lane metrics
+static sl_publish_lane_metrics_t sl_publish_lane_metrics[SL_PUBLISH_LANE_COUNT];
+
+/// @brief Structure for enqueue ticks of queued messages, in lane order
+typedef struct {
+  uint32_t enqueue_tick[PUBLISH_LANE_MAX_CAPACITY]; ///< Circular, oldest message at head
+  uint8_t head;                                     ///< Index of oldest message
+  uint8_t count;                                    ///< Messages queued on the lane
+} sl_publish_lane_ticks_t;
+
+/// Enqueue ticks of every lane, used under MQTT package queue mutex
+static sl_publish_lane_ticks_t sl_publish_lane_ticks[SL_PUBLISH_LANE_COUNT];
+
+/// Copy of a queued message while a lane is scanned for a source, used under
+/// MQTT package queue mutex
+static sl_wifi_asset_tracking_mqtt_package_queue_data_t sl_publish_lane_scan_data;
+
+/**************************************************************************/ /**
+ * @brief Function to find the queued message of a source. Each message is
+ * taken from the head and put back at the tail, so the lane order is kept.
+ * Called with the MQTT package queue mutex held.
+ * @param[in] queue : lane queue.
+ * @param[in] source : sl_publish_lane_source_e to look for.
+ * @param[in] data : message replacing the queued one, NULL to only look.
+ * It takes the enqueue tick of the replaced message, so the lane stays in
+ * enqueue order and latency covers the whole wait of the source.
+ * @return true when a message of the source is queued.
+ ******************************************************************************/
+static bool sl_publish_lane_find_source(
+  QueueHandle_t queue,
+  uint8_t source,
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t *data);
+
+/**************************************************************************/ /**
+ * @brief Function to add the enqueue tick of a message to a lane, called
+ * with the MQTT package queue mutex held.
+ * @param[in] lane : lane.
+ * @param[in] tick : enqueue tick of the message.
+ * @param[in] is_oldest : true for a message put back at the head of the lane,
+ * false for a message at the tail.
+ ******************************************************************************/
+static void sl_publish_lane_push_tick(sl_publish_lane_e lane,
+                                      uint32_t tick,
+                                      bool is_oldest);
+
+/**************************************************************************/ /**
+ * @brief Function to remove the enqueue tick of the oldest message of a lane,
+ * called with the MQTT package queue mutex held.
+ * @param[in] lane : lane.
+ ******************************************************************************/
+static void sl_publish_lane_pop_tick(sl_publish_lane_e lane);
+
+/******************************************************************************
+ *  Function to create lane queues and reset metrics.
+ *****************************************************************************/
+sl_status_t sl_publish_lane_init(void)
+{
+  uint8_t lane;
+
+  memset(sl_publish_lane_metrics, 0, sizeof(sl_publish_lane_metrics));
+  memset(sl_publish_lane_ticks, 0, sizeof(sl_publish_lane_ticks));
+
+  for (lane = 0; lane < SL_PUBLISH_LANE_COUNT; ++lane) {
+    sl_publish_lane_credit[lane] = sl_publish_lane_config[lane].weight;
+
+    sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane] =
+      sl_static_create_queue(SL_STATIC_QUEUE_LANE_CRITICAL + lane);
+
+    if (NULL
+        == sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane])
+    {
+      printf("\r\nsl_publish_lane_init : lane %d queue creation failed\r\n",
+             lane);
+      return SL_STATUS_FAIL;
+    }
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to delete lane queues.
+ *****************************************************************************/
+void sl_publish_lane_deinit(void)
+{
+  uint8_t lane;
+
+  for (lane = 0; lane < SL_PUBLISH_LANE_COUNT; ++lane) {
+    if (NULL
+        != sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane])
+    {
+      vQueueDelete(
+        sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane]);
+      sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane] =
+        NULL;
+    }
+  }
+}
+
+/******************************************************************************
+ *  Function to queue a JSON message on a lane.
+ *****************************************************************************/
+sl_status_t sl_publish_lane_enqueue(
+  sl_publish_lane_e lane,
+  sl_publish_lane_source_e source,
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t *data)
+{
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t dropped_data;
+  QueueHandle_t queue;
+  sl_status_t status = SL_STATUS_OK;
+  bool is_replaced = false;
+
+  if (lane >= SL_PUBLISH_LANE_COUNT) {
+    return SL_STATUS_FAIL;
+  }
+
+  queue = sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane];
+  data->source = (uint8_t)source;
+  data->enqueue_tick = xTaskGetTickCount();
+
+  /// Acquire MQTT data queue mutex and send data to the lane
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        mqtt_package_queue_mutex_handler,
+                        portMAX_DELAY)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// A newer message of a source supersedes its queued one
+  if (SL_PUBLISH_LANE_DROP_SAME_SOURCE
+      == sl_publish_lane_config[lane].drop_policy) {
+    is_replaced = sl_publish_lane_find_source(queue, data->source, data);
+  }
+
+  if (is_replaced) {
+    sl_publish_lane_metrics[lane].dropped++;
+    sl_publish_lane_metrics[lane].enqueued++;
+    sl_metrics_increment(SL_METRIC_LANE_DROPS);
+    SL_LOG_INFO(SL_LOG_MODULE_LANES, SL_LOG_FMT_LANE_REPLACED, lane, source);
+  } else {
+    if (0 == uxQueueSpacesAvailable(queue)) {
+      sl_publish_lane_metrics[lane].dropped++;
+      sl_metrics_increment(SL_METRIC_LANE_DROPS);
+
+      if (SL_PUBLISH_LANE_DROP_NEWEST
+          != sl_publish_lane_config[lane].drop_policy) {
+        xQueueReceive(queue, &dropped_data, 0);
+        sl_publish_lane_pop_tick(lane);
+        SL_LOG_WARN(SL_LOG_MODULE_LANES, SL_LOG_FMT_LANE_DROPPED_OLDEST, lane);
+      } else {
+        SL_LOG_WARN(SL_LOG_MODULE_LANES, SL_LOG_FMT_LANE_DROPPED_NEWEST, lane);
+        status = SL_STATUS_FAIL;
+      }
+    }
+
+    if (SL_STATUS_OK == status) {
+      xQueueSend(queue, data, 0);
+      sl_publish_lane_push_tick(lane, data->enqueue_tick, false);
+      sl_publish_lane_metrics[lane].enqueued++;
+      sl_metrics_raise_gauge(SL_METRIC_LANE_PEAK,
+                             (int32_t)sl_publish_lane_messages_waiting());
+    }
+  }
+
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+
+  /// Wake Azure cloud communication task, waiting for a message or a wake
+  /// window, the notification is counted so none is lost. A replaced message
+  /// was already notified
+  if ((SL_STATUS_OK == status) && !is_replaced) {
+    xTaskNotifyGive(
+      sl_get_wifi_asset_tracking_resource()->task_list.azure_cloud_communication_task_handler);
+  }
+
+  return status;
+}
+
+/******************************************************************************
+ *  Function to take the next message to publish.
+ *****************************************************************************/
+sl_status_t sl_publish_lane_dequeue(
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t *data,
+  sl_publish_lane_e *lane)
+{
+  QueueHandle_t *queues =
+    sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler;
+  sl_status_t status = SL_STATUS_FAIL;
+  bool is_weighted_pending = false;
+  uint8_t round;
+  uint8_t index;
+
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        mqtt_package_queue_mutex_handler,
+                        portMAX_DELAY)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Strict lanes in priority order
+  for (index = 0; index < SL_PUBLISH_LANE_COUNT; ++index) {
+    if ((PUBLISH_LANE_WEIGHT_STRICT == sl_publish_lane_config[index].weight)
+        && (pdTRUE == xQueueReceive(queues[index], data, 0))) {
+      sl_publish_lane_pop_tick((sl_publish_lane_e)index);
+      *lane = (sl_publish_lane_e)index;
+      status = SL_STATUS_OK;
+      goto error;
+    }
+  }
+
+  /// Weighted lanes; a second round starts with fresh credits
+  for (round = 0; round < 2; ++round) {
+    for (index = 0; index < SL_PUBLISH_LANE_COUNT; ++index) {
+      if ((PUBLISH_LANE_WEIGHT_STRICT == sl_publish_lane_config[index].weight)
+          || (0 == uxQueueMessagesWaiting(queues[index]))) {
+        continue;
+      }
+
+      is_weighted_pending = true;
+
+      if ((sl_publish_lane_credit[index] > 0)
+          && (pdTRUE == xQueueReceive(queues[index], data, 0))) {
+        sl_publish_lane_credit[index]--;
+        sl_publish_lane_pop_tick((sl_publish_lane_e)index);
+        *lane = (sl_publish_lane_e)index;
+        status = SL_STATUS_OK;
+        goto error;
+      }
+    }
+
+    if (!is_weighted_pending) {
+      break;
+    }
+
+    /// Every waiting lane used its share, start the next round
+    for (index = 0; index < SL_PUBLISH_LANE_COUNT; ++index) {
+      sl_publish_lane_credit[index] = sl_publish_lane_config[index].weight;
+    }
+  }
+
+  error:
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+  return status;
+}
+
+/******************************************************************************
+ *  Function to put a message back at the head of its lane.
+ *****************************************************************************/
+sl_status_t sl_publish_lane_requeue(
+  sl_publish_lane_e lane,
+  const sl_wifi_asset_tracking_mqtt_package_queue_data_t *data)
+{
+  sl_status_t status = SL_STATUS_FAIL;
+
+  if (lane >= SL_PUBLISH_LANE_COUNT) {
+    return SL_STATUS_FAIL;
+  }
+
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        mqtt_package_queue_mutex_handler,
+                        portMAX_DELAY)) {
+    return SL_STATUS_FAIL;
+  }
+
+  if ((SL_PUBLISH_LANE_DROP_SAME_SOURCE
+       == sl_publish_lane_config[lane].drop_policy)
+      && sl_publish_lane_find_source(
+        sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane],
+        data->source,
+        NULL)) {
+    sl_publish_lane_metrics[lane].dropped++;
+    sl_metrics_increment(SL_METRIC_LANE_DROPS);
+    SL_LOG_INFO(SL_LOG_MODULE_LANES,
+                SL_LOG_FMT_LANE_REPLACED,
+                lane,
+                data->source);
+  } else if (pdTRUE
+             == xQueueSendToFront(
+               sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane],
+               data,
+               0)) {
+    sl_publish_lane_push_tick(lane, data->enqueue_tick, true);
+    status = SL_STATUS_OK;
+  } else {
+    sl_publish_lane_metrics[lane].dropped++;
+    sl_metrics_increment(SL_METRIC_LANE_DROPS);
+    SL_LOG_WARN(SL_LOG_MODULE_LANES, SL_LOG_FMT_LANE_DROPPED_RETRY, lane);
+  }
+
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+
+  return status;
+}
+
+/******************************************************************************
+ *  Function to find the queued message of a source.
+ *****************************************************************************/
+static bool sl_publish_lane_find_source(
+  QueueHandle_t queue,
+  uint8_t source,
+  sl_wifi_asset_tracking_mqtt_package_queue_data_t *data)
+{
+  UBaseType_t count = uxQueueMessagesWaiting(queue);
+  bool is_found = false;
+
+  while (count-- > 0) {
+    xQueueReceive(queue, &sl_publish_lane_scan_data, 0);
+
+    if (!is_found && (source == sl_publish_lane_scan_data.source)) {
+      is_found = true;
+      if (NULL != data) {
+        data->enqueue_tick = sl_publish_lane_scan_data.enqueue_tick;
+        xQueueSend(queue, data, 0);
+        continue;
+      }
+    }
+
+    xQueueSend(queue, &sl_publish_lane_scan_data, 0);
+  }
+
+  return is_found;
+}
+
+/******************************************************************************
+ *  Function to add the enqueue tick of a message to a lane.
+ *****************************************************************************/
+static void sl_publish_lane_push_tick(sl_publish_lane_e lane,
+                                      uint32_t tick,
+                                      bool is_oldest)
+{
+  sl_publish_lane_ticks_t *ticks = &sl_publish_lane_ticks[lane];
+
+  if (ticks->count >= PUBLISH_LANE_MAX_CAPACITY) {
+    return;
+  }
+
+  if (is_oldest) {
+    ticks->head = (uint8_t)((ticks->head + PUBLISH_LANE_MAX_CAPACITY - 1)
+                            % PUBLISH_LANE_MAX_CAPACITY);
+    ticks->enqueue_tick[ticks->head] = tick;
+  } else {
+    ticks->enqueue_tick[(ticks->head + ticks->count)
+                        % PUBLISH_LANE_MAX_CAPACITY] = tick;
+  }
+  ticks->count++;
+}
+
+/******************************************************************************
+ *  Function to remove the enqueue tick of the oldest message of a lane.
+ *****************************************************************************/
+static void sl_publish_lane_pop_tick(sl_publish_lane_e lane)
+{
+  sl_publish_lane_ticks_t *ticks = &sl_publish_lane_ticks[lane];
+
+  if (0 == ticks->count) {
+    return;
+  }
+
+  ticks->head = (uint8_t)((ticks->head + 1) % PUBLISH_LANE_MAX_CAPACITY);
+  ticks->count--;
+}
+
+/******************************************************************************
+ *  Function to update lane latency once a message is published.
+ *****************************************************************************/
+void sl_publish_lane_record_published(
+  sl_publish_lane_e lane,
+  const sl_wifi_asset_tracking_mqtt_package_queue_data_t *data)
+{
+  sl_publish_lane_metrics_t *metrics;
+  uint32_t latency_ms;
+
+  if (lane >= SL_PUBLISH_LANE_COUNT) {
+    return;
+  }
+
+  latency_ms = (uint32_t)(((xTaskGetTickCount() - data->enqueue_tick)
+                           * portTICK_PERIOD_MS) / TIMER_CLOCK_OFFSET);
+  sl_metrics_observe(SL_METRIC_PUBLISH_LATENCY, latency_ms);
+
+  /// Sensor readings also count the time spent before the publish lane
+  if (0 != data->sample_tick) {
+    sl_metrics_observe(SL_METRIC_SAMPLE_LATENCY,
+                       (uint32_t)(((xTaskGetTickCount() - data->sample_tick)
+                                   * portTICK_PERIOD_MS) / TIMER_CLOCK_OFFSET));
+  }
+
+  if (pdTRUE
+      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        mqtt_package_queue_mutex_handler,
+                        portMAX_DELAY)) {
+    metrics = &sl_publish_lane_metrics[lane];
+
+    if (0 == metrics->published) {
+      metrics->average_latency_ms = latency_ms;
+    } else {
+      metrics->average_latency_ms = metrics->average_latency_ms
+                                    - (metrics->average_latency_ms
+                                       >> PUBLISH_LANE_LATENCY_AVERAGE_SHIFT)
+                                    + (latency_ms
+                                       >> PUBLISH_LANE_LATENCY_AVERAGE_SHIFT);
+    }
+
+    metrics->published++;
+    metrics->last_latency_ms = latency_ms;
+    if (latency_ms > metrics->max_latency_ms) {
+      metrics->max_latency_ms = latency_ms;
+    }
+
+    xSemaphoreGive(
+      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+  }
+
+  SL_LOG_DEBUG(SL_LOG_MODULE_LANES,
+               SL_LOG_FMT_LANE_PUBLISHED,
+               lane,
+               latency_ms,
+               sl_publish_lane_metrics[lane].average_latency_ms,
+               sl_publish_lane_metrics[lane].max_latency_ms);
+}
+
+/******************************************************************************
+ *  Function to get the time until a queued message must be published.
+ *****************************************************************************/
+uint32_t sl_publish_lane_get_due_ms(void)
+{
+  QueueHandle_t *queues =
+    sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler;
+  sl_publish_lane_ticks_t *ticks;
+  uint32_t due_ms = UINT32_MAX;
+  uint32_t age_ms;
+  uint8_t lane;
+
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        mqtt_package_queue_mutex_handler,
+                        portMAX_DELAY)) {
+    return 0;
+  }
+
+  for (lane = 0; lane < SL_PUBLISH_LANE_COUNT; ++lane) {
+    ticks = &sl_publish_lane_ticks[lane];
+    if (0 == ticks->count) {
+      continue;
+    }
+
+    /// A full lane would drop by its policy, publish before that
+    if (0 == uxQueueSpacesAvailable(queues[lane])) {
+      due_ms = 0;
+      break;
+    }
+
+    age_ms = (uint32_t)(((xTaskGetTickCount()
+                          - ticks->enqueue_tick[ticks->head])
+                         * portTICK_PERIOD_MS) / TIMER_CLOCK_OFFSET);
+    if (age_ms >= sl_publish_lane_config[lane].latency_cap) {
+      due_ms = 0;
+      break;
+    }
+
+    if ((sl_publish_lane_config[lane].latency_cap - age_ms) < due_ms) {
+      due_ms = sl_publish_lane_config[lane].latency_cap - age_ms;
+    }
+  }
+
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+
+  return due_ms;
+}
+
+/******************************************************************************
+ *  Function to count messages queued on all lanes.
+ *****************************************************************************/
+uint32_t sl_publish_lane_messages_waiting(void)
+{
+  uint32_t count = 0;
+  uint8_t lane;
+
+  for (lane = 0; lane < SL_PUBLISH_LANE_COUNT; ++lane) {
+    count += uxQueueMessagesWaiting(
+      sl_get_wifi_asset_tracking_resource()->mqtt_lane_queue_handler[lane]);
+  }
+
+  return count;
+}
+
+/******************************************************************************
+ *  Function to read metrics of a lane.
+ *****************************************************************************/
+void sl_publish_lane_get_metrics(sl_publish_lane_e lane,
+                                 sl_publish_lane_metrics_t *metrics)
+{
+  if ((lane >= SL_PUBLISH_LANE_COUNT) || (NULL == metrics)) {
+    return;
+  }
+
+  if (pdTRUE
+      == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        mqtt_package_queue_mutex_handler,
+                        portMAX_DELAY)) {
+    *metrics = sl_publish_lane_metrics[lane];
+    xSemaphoreGive(
+      sl_get_wifi_asset_tracking_resource()->mqtt_package_queue_mutex_handler);
+  }
+}
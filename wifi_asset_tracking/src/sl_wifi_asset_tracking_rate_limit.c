@@ -0,0 +1,246 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_rate_limit.c
+ * @brief Token bucket publish rate limiter with backpressure to sampling
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_rate_limit.h>
+
+/// Tokens in the bucket, in 1/RATE_LIMIT_TOKEN_SCALE message
+static uint32_t sl_rate_limit_tokens;
+
+/// Current sustained publish rate in messages per minute
+static uint32_t sl_rate_limit_rate = RATE_LIMIT_MESSAGES_PER_MINUTE;
+
+/// Tick of last bucket refill
+static TickType_t sl_rate_limit_refill_tick;
+
+/// Tick of last rate or backpressure change
+static TickType_t sl_rate_limit_change_tick;
+
+/// Backpressure level read by the sensor tasks
+static volatile uint8_t sl_rate_limit_backpressure_level;
+
+/// Throttled publishes since the last accepted one
+static uint8_t sl_rate_limit_consecutive_throttles;
+
+/**************************************************************************/ /**
+ * @brief Function to convert ticks elapsed since a tick count to ms.
+ * @param[in] since_tick : start tick count.
+ * @return elapsed time in ms.
+ ******************************************************************************/
+static uint32_t sl_rate_limit_elapsed_ms(TickType_t since_tick);
+
+/**************************************************************************/ /**
+ * @brief Function to add the tokens earned since the last refill.
+ ******************************************************************************/
+static void sl_rate_limit_refill(void);
+
+/**************************************************************************/ /**
+ * @brief Function to move backpressure and rate one step, at most once per
+ * RATE_LIMIT_HOLD_PERIOD.
+ * @param[in] queued_messages : messages waiting on the publish lanes.
+ * @param[in] is_starved : true when a publish had to wait for a token.
+ ******************************************************************************/
+static void sl_rate_limit_adjust(uint32_t queued_messages, bool is_starved);
+
+/******************************************************************************
+ *  Function to fill the bucket and reset rate and backpressure.
+ *****************************************************************************/
+void sl_rate_limit_init(void)
+{
+  sl_rate_limit_tokens = RATE_LIMIT_BURST_SIZE * RATE_LIMIT_TOKEN_SCALE;
+  sl_rate_limit_rate = RATE_LIMIT_MESSAGES_PER_MINUTE;
+  sl_rate_limit_refill_tick = xTaskGetTickCount();
+  sl_rate_limit_change_tick = sl_rate_limit_refill_tick;
+  sl_rate_limit_backpressure_level = 0;
+  sl_rate_limit_consecutive_throttles = 0;
+}
+
+/******************************************************************************
+ *  Function to take one publish token from the bucket.
+ *****************************************************************************/
+sl_status_t sl_rate_limit_acquire(uint32_t queued_messages, uint32_t *wait_ms)
+{
+  sl_rate_limit_refill();
+
+  if (sl_rate_limit_tokens >= RATE_LIMIT_TOKEN_SCALE) {
+    sl_rate_limit_tokens -= RATE_LIMIT_TOKEN_SCALE;
+    return SL_STATUS_OK;
+  }
+
+  /// Producers are faster than the publish budget
+  sl_rate_limit_adjust(queued_messages, true);
+
+  /// Missing tokens refill at sl_rate_limit_rate messages per 60000 ms
+  *wait_ms = (((RATE_LIMIT_TOKEN_SCALE - sl_rate_limit_tokens) * 60000U)
+              / (RATE_LIMIT_TOKEN_SCALE * sl_rate_limit_rate)) + 1;
+
+  return SL_STATUS_BUSY;
+}
+
+/******************************************************************************
+ *  Function to report a message accepted by the IoT Hub.
+ *****************************************************************************/
+void sl_rate_limit_on_published(uint32_t queued_messages)
+{
+  sl_rate_limit_consecutive_throttles = 0;
+  sl_rate_limit_adjust(queued_messages, false);
+}
+
+/******************************************************************************
+ *  Function to report a connection closed by the IoT Hub.
+ *****************************************************************************/
+sl_status_t sl_rate_limit_on_throttled(void)
+{
+  if (++sl_rate_limit_consecutive_throttles
+      > RATE_LIMIT_MAX_CONSECUTIVE_THROTTLES) {
+    sl_rate_limit_consecutive_throttles = 0;
+    return SL_STATUS_FAIL;
+  }
+
+  /// Multiplicative decrease, recovered step by step in sl_rate_limit_adjust
+  sl_rate_limit_rate /= 2;
+  if (sl_rate_limit_rate < RATE_LIMIT_MIN_MESSAGES_PER_MINUTE) {
+    sl_rate_limit_rate = RATE_LIMIT_MIN_MESSAGES_PER_MINUTE;
+  }
+
+  sl_rate_limit_tokens = 0;
+  sl_rate_limit_refill_tick = xTaskGetTickCount();
+  sl_rate_limit_change_tick = sl_rate_limit_refill_tick;
+
+  if (sl_rate_limit_backpressure_level < RATE_LIMIT_MAX_BACKPRESSURE_LEVEL) {
+    sl_rate_limit_backpressure_level++;
+  }
+
+  printf(
+    "\r\nsl_rate_limit_on_throttled : rate %lu messages per minute, backpressure level %u\r\n",
+    (unsigned long)sl_rate_limit_rate,
+    sl_rate_limit_backpressure_level);
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to get the current backpressure level for producers.
+ *****************************************************************************/
+uint8_t sl_rate_limit_get_backpressure_level(void)
+{
+  return sl_rate_limit_backpressure_level;
+}
+
+/******************************************************************************
+ *  Function to stretch a sampling interval by the backpressure level.
+ *****************************************************************************/
+uint32_t sl_rate_limit_scale_interval(uint32_t interval_ms,
+                                      uint32_t max_interval_ms)
+{
+  uint32_t scaled_interval_ms =
+    interval_ms << sl_rate_limit_backpressure_level;
+
+  if (scaled_interval_ms > max_interval_ms) {
+    scaled_interval_ms =
+      (interval_ms > max_interval_ms) ? interval_ms : max_interval_ms;
+  }
+
+  return scaled_interval_ms;
+}
+
+/******************************************************************************
+ *  Function to get the current sustained publish rate.
+ *****************************************************************************/
+uint32_t sl_rate_limit_get_rate(void)
+{
+  return sl_rate_limit_rate;
+}
+
+/******************************************************************************
+ *  Function to convert ticks elapsed since a tick count to ms.
+ *****************************************************************************/
+static uint32_t sl_rate_limit_elapsed_ms(TickType_t since_tick)
+{
+  return (uint32_t)(((xTaskGetTickCount() - since_tick) * portTICK_PERIOD_MS)
+                    / TIMER_CLOCK_OFFSET);
+}
+
+/******************************************************************************
+ *  Function to add the tokens earned since the last refill.
+ *****************************************************************************/
+static void sl_rate_limit_refill(void)
+{
+  uint64_t earned_tokens;
+
+  /// Tokens per ms is rate / 60000, in RATE_LIMIT_TOKEN_SCALE units
+  earned_tokens = ((uint64_t)sl_rate_limit_elapsed_ms(sl_rate_limit_refill_tick)
+                   * sl_rate_limit_rate * RATE_LIMIT_TOKEN_SCALE) / 60000;
+
+  /// Keep the fraction for the next call when nothing was earned yet
+  if (0 == earned_tokens) {
+    return;
+  }
+
+  sl_rate_limit_refill_tick = xTaskGetTickCount();
+
+  if ((sl_rate_limit_tokens + earned_tokens)
+      > (RATE_LIMIT_BURST_SIZE * RATE_LIMIT_TOKEN_SCALE)) {
+    sl_rate_limit_tokens = RATE_LIMIT_BURST_SIZE * RATE_LIMIT_TOKEN_SCALE;
+  } else {
+    sl_rate_limit_tokens += (uint32_t)earned_tokens;
+  }
+}
+
+/******************************************************************************
+ *  Function to move backpressure and rate one step.
+ *****************************************************************************/
+static void sl_rate_limit_adjust(uint32_t queued_messages, bool is_starved)
+{
+  uint8_t previous_level = sl_rate_limit_backpressure_level;
+
+  if (sl_rate_limit_elapsed_ms(sl_rate_limit_change_tick)
+      < RATE_LIMIT_HOLD_PERIOD) {
+    return;
+  }
+
+  if (is_starved) {
+    /// Queues keep growing while waiting for tokens, slow down sampling
+    if ((queued_messages > RATE_LIMIT_BACKPRESSURE_THRESHOLD)
+        && (sl_rate_limit_backpressure_level
+            < RATE_LIMIT_MAX_BACKPRESSURE_LEVEL)) {
+      sl_rate_limit_backpressure_level++;
+    }
+  } else {
+    /// Additive increase back to the configured rate
+    if (sl_rate_limit_rate < RATE_LIMIT_MESSAGES_PER_MINUTE) {
+      sl_rate_limit_rate += RATE_LIMIT_RECOVERY_STEP;
+      if (sl_rate_limit_rate > RATE_LIMIT_MESSAGES_PER_MINUTE) {
+        sl_rate_limit_rate = RATE_LIMIT_MESSAGES_PER_MINUTE;
+      }
+    }
+
+    if ((queued_messages <= (RATE_LIMIT_BACKPRESSURE_THRESHOLD / 2))
+        && (sl_rate_limit_backpressure_level > 0)) {
+      sl_rate_limit_backpressure_level--;
+    }
+  }
+
+  sl_rate_limit_change_tick = xTaskGetTickCount();
+
+  if (previous_level != sl_rate_limit_backpressure_level) {
+    printf(
+      "\r\nsl_rate_limit_adjust : backpressure level %u, rate %lu messages per minute\r\n",
+      sl_rate_limit_backpressure_level,
+      (unsigned long)sl_rate_limit_rate);
+  }
+}
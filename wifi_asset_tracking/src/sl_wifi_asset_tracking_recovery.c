@@ -0,0 +1,530 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_recovery.c
+ * @brief Recovery state machine with backoff for sensors, Wi-Fi and cloud
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_recovery.h>
+
+/// @brief Structure for compile time configuration of a subsystem
+typedef struct {
+  const char *name;                           ///< Subsystem name for logs
+  uint32_t first_delay;                       ///< In ms, delay from failure to the first attempt
+  uint32_t backoff_initial;                   ///< In ms, delay after the first failed attempt
+  uint32_t backoff_max;                       ///< In ms, retry ceiling
+  sl_recovery_subsystem_e depends_on;         ///< Subsystem which has to be healthy first, SL_RECOVERY_SUBSYSTEM_COUNT when none
+  bool (*is_failed)(sl_recovery_subsystem_e subsystem);           ///< Reads the status of the subsystem
+  sl_status_t (*reinit)(sl_recovery_subsystem_e subsystem);       ///< One attempt, sets the status on success
+} sl_recovery_subsystem_config_t;
+
+/// @brief Structure for recovery state
+typedef struct {
+  sl_recovery_stats_t stats[SL_RECOVERY_SUBSYSTEM_COUNT];     ///< History and state per subsystem
+  uint32_t failed_ms[SL_RECOVERY_SUBSYSTEM_COUNT];            ///< Start of the current outage
+  uint32_t next_attempt_ms[SL_RECOVERY_SUBSYSTEM_COUNT];      ///< Time of the next attempt in BACKOFF
+  uint32_t jitter_state;                                      ///< Xorshift state of the jitter
+  bool jitter_seeded;                                         ///< MAC address folded into the jitter
+} sl_recovery_t;
+
+/**************************************************************************/ /**
+ * @brief Function to check whether a sensor failed probing or stopped
+ * responding.
+ * @param[in] subsystem : sensor subsystem.
+ * @return true when the sensor needs a reinitialization.
+ ******************************************************************************/
+static bool sl_recovery_is_sensor_failed(sl_recovery_subsystem_e subsystem);
+
+/**************************************************************************/ /**
+ * @brief Function to check whether the Wi-Fi connection is lost.
+ * @param[in] subsystem : SL_RECOVERY_SUBSYSTEM_WIFI.
+ * @return true when Wi-Fi is disconnected.
+ ******************************************************************************/
+static bool sl_recovery_is_wifi_failed(sl_recovery_subsystem_e subsystem);
+
+/**************************************************************************/ /**
+ * @brief Function to check whether the IoT Hub connection is lost.
+ * @param[in] subsystem : SL_RECOVERY_SUBSYSTEM_CLOUD.
+ * @return true when the cloud is disconnected.
+ ******************************************************************************/
+static bool sl_recovery_is_cloud_failed(sl_recovery_subsystem_e subsystem);
+
+/**************************************************************************/ /**
+ * @brief Function to reinitialize a sensor on the I2C bus, the sensor task
+ * keeps running and samples again once the sensor is connected.
+ * @param[in] subsystem : sensor subsystem.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the sensor did not respond
+ ******************************************************************************/
+static sl_status_t sl_recovery_reinit_sensor(sl_recovery_subsystem_e subsystem);
+
+/**************************************************************************/ /**
+ * @brief Function to run one burst of Wi-Fi rejoin attempts.
+ * @param[in] subsystem : SL_RECOVERY_SUBSYSTEM_WIFI.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when no attempt of the burst connected
+ ******************************************************************************/
+static sl_status_t sl_recovery_reinit_wifi(sl_recovery_subsystem_e subsystem);
+
+/**************************************************************************/ /**
+ * @brief Function to connect to IoT Hub once.
+ * @param[in] subsystem : SL_RECOVERY_SUBSYSTEM_CLOUD.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the connection failed
+ ******************************************************************************/
+static sl_status_t sl_recovery_reinit_cloud(sl_recovery_subsystem_e subsystem);
+
+/**************************************************************************/ /**
+ * @brief Function to mark a subsystem healthy and record its outage.
+ * @param[in] subsystem : recovered subsystem.
+ * @param[in] now : time of recovery in ms.
+ ******************************************************************************/
+static void sl_recovery_on_recovered(sl_recovery_subsystem_e subsystem,
+                                     uint32_t now);
+
+/**************************************************************************/ /**
+ * @brief Function to get the jittered delay before the next attempt.
+ * @param[in] subsystem : failed subsystem.
+ * @return delay in ms.
+ ******************************************************************************/
+static uint32_t sl_recovery_get_backoff(sl_recovery_subsystem_e subsystem);
+
+/**************************************************************************/ /**
+ * @brief Function to get the time since boot.
+ * @return time in ms, wraps after 49 days.
+ ******************************************************************************/
+static uint32_t sl_recovery_get_time_ms(void);
+
+/**************************************************************************/ /**
+ * @brief Function to publish the pending subsystems and the longest scheduled
+ * delay as gauges.
+ ******************************************************************************/
+static void sl_recovery_update_gauges(void);
+
+static const sl_recovery_subsystem_config_t
+  sl_recovery_subsystem_config[SL_RECOVERY_SUBSYSTEM_COUNT] = {
+  { "temperature and RH sensor", SENSOR_PER_RETRY_DELAY,
+    SENSOR_PER_RETRY_DELAY, RECOVERY_BACKOFF_MAX_SENSOR,
+    SL_RECOVERY_SUBSYSTEM_COUNT,
+    sl_recovery_is_sensor_failed, sl_recovery_reinit_sensor },
+  { "IMU sensor", SENSOR_PER_RETRY_DELAY,
+    SENSOR_PER_RETRY_DELAY, RECOVERY_BACKOFF_MAX_SENSOR,
+    SL_RECOVERY_SUBSYSTEM_COUNT,
+    sl_recovery_is_sensor_failed, sl_recovery_reinit_sensor },
+  { "GNSS receiver", SENSOR_PER_RETRY_DELAY,
+    SENSOR_PER_RETRY_DELAY, RECOVERY_BACKOFF_MAX_SENSOR,
+    SL_RECOVERY_SUBSYSTEM_COUNT,
+    sl_recovery_is_sensor_failed, sl_recovery_reinit_sensor },
+  { "wi-fi", 0,
+    RECOVERY_BACKOFF_INITIAL_WIFI, RECOVERY_BACKOFF_MAX_WIFI,
+    SL_RECOVERY_SUBSYSTEM_COUNT,
+    sl_recovery_is_wifi_failed, sl_recovery_reinit_wifi },
+  { "Azure IoT Hub", 0,
+    AZURE_CLOUD_CONN_DELAY_BETN_RETRY, RECOVERY_BACKOFF_MAX_CLOUD,
+    SL_RECOVERY_SUBSYSTEM_WIFI,
+    sl_recovery_is_cloud_failed, sl_recovery_reinit_cloud }
+};
+
+/// Recovery state, written by the recovery task only, stats are read in
+/// critical sections
+static sl_recovery_t sl_recovery;
+
+/******************************************************************************
+ *  Function to run the state machine of every subsystem once.
+ *****************************************************************************/
+uint32_t sl_recovery_run(void)
+{
+  const sl_recovery_subsystem_config_t *config;
+  sl_recovery_stats_t *stats;
+  sl_recovery_subsystem_e subsystem;
+  sl_recovery_subsystem_e depends_on;
+  uint32_t wait_ms = RECOVERY_WAIT_FOREVER;
+  uint32_t now;
+  int32_t remaining;
+
+  for (subsystem = 0; subsystem < SL_RECOVERY_SUBSYSTEM_COUNT; subsystem++) {
+    config = &sl_recovery_subsystem_config[subsystem];
+    stats = &sl_recovery.stats[subsystem];
+    depends_on = config->depends_on;
+    now = sl_recovery_get_time_ms();
+
+    if (SL_RECOVERY_STATE_HEALTHY == stats->state) {
+      if (!config->is_failed(subsystem)) {
+        continue;
+      }
+
+      printf("\r\nsl_recovery_run : %s failed\r\n", config->name);
+
+      /// A subsystem which needs another one starts blocked, its first
+      /// attempt follows right away once the needed one is healthy
+      taskENTER_CRITICAL();
+      stats->consecutive_failures = 0;
+      if (SL_RECOVERY_SUBSYSTEM_COUNT != depends_on) {
+        stats->state = SL_RECOVERY_STATE_BLOCKED;
+        stats->last_backoff_ms = 0;
+      } else {
+        stats->state = SL_RECOVERY_STATE_BACKOFF;
+        stats->last_backoff_ms = sl_recovery_get_backoff(subsystem);
+      }
+      taskEXIT_CRITICAL();
+      sl_recovery.failed_ms[subsystem] = now;
+      sl_recovery.next_attempt_ms[subsystem] = now + stats->last_backoff_ms;
+    } else if (!config->is_failed(subsystem)) {
+      /// Recovered by another path, e.g. the network processor rejoined
+      sl_recovery_on_recovered(subsystem, now);
+      continue;
+    }
+
+    if ((SL_RECOVERY_SUBSYSTEM_COUNT != depends_on)
+        && ((SL_RECOVERY_STATE_HEALTHY != sl_recovery.stats[depends_on].state)
+            || sl_recovery_subsystem_config[depends_on].is_failed(depends_on))) {
+      stats->state = SL_RECOVERY_STATE_BLOCKED;
+      continue;
+    }
+
+    if (SL_RECOVERY_STATE_BLOCKED == stats->state) {
+      stats->state = SL_RECOVERY_STATE_BACKOFF;
+      sl_recovery.next_attempt_ms[subsystem] = now;
+    }
+
+    remaining = (int32_t)(sl_recovery.next_attempt_ms[subsystem] - now);
+    if (remaining > 0) {
+      if ((uint32_t)remaining < wait_ms) {
+        wait_ms = (uint32_t)remaining;
+      }
+      continue;
+    }
+
+    printf("\r\nsl_recovery_run : %s attempt %lu\r\n",
+           config->name,
+           stats->consecutive_failures + 1);
+
+    taskENTER_CRITICAL();
+    stats->attempts++;
+    taskEXIT_CRITICAL();
+    sl_metrics_increment(SL_METRIC_RECOVERY_ATTEMPTS);
+
+    if (SL_STATUS_OK == config->reinit(subsystem)) {
+      sl_recovery_on_recovered(subsystem, sl_recovery_get_time_ms());
+      continue;
+    }
+
+    sl_metrics_increment(SL_METRIC_RECOVERY_FAILURES);
+
+    /// Delay doubles with every failure and counts from the end of the
+    /// attempt, a Wi-Fi burst takes a while
+    now = sl_recovery_get_time_ms();
+    taskENTER_CRITICAL();
+    stats->failures++;
+    stats->consecutive_failures++;
+    stats->last_backoff_ms = sl_recovery_get_backoff(subsystem);
+    taskEXIT_CRITICAL();
+    sl_recovery.next_attempt_ms[subsystem] = now + stats->last_backoff_ms;
+
+    printf(
+      "\r\nsl_recovery_run : %s failed %lu times, next attempt in %lu ms\r\n",
+      config->name,
+      stats->consecutive_failures,
+      stats->last_backoff_ms);
+
+    if (stats->last_backoff_ms < wait_ms) {
+      wait_ms = stats->last_backoff_ms;
+    }
+  }
+
+  sl_recovery_update_gauges();
+
+  return wait_ms;
+}
+
+/******************************************************************************
+ *  Function to read the recovery history of a subsystem.
+ *****************************************************************************/
+void sl_recovery_get_stats(sl_recovery_subsystem_e subsystem,
+                           sl_recovery_stats_t *stats)
+{
+  if (subsystem >= SL_RECOVERY_SUBSYSTEM_COUNT) {
+    memset(stats, 0, sizeof(*stats));
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  *stats = sl_recovery.stats[subsystem];
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to check whether a sensor needs a reinitialization.
+ *****************************************************************************/
+static bool sl_recovery_is_sensor_failed(sl_recovery_subsystem_e subsystem)
+{
+  sl_wifi_asset_tracking_sensor_status_t *sensor_status =
+    &(sl_get_wifi_asset_tracking_status()->sensor_status);
+  uint8_t probe_status;
+
+  switch (subsystem) {
+    case SL_RECOVERY_SUBSYSTEM_TEMPERATURE_RH_SENSOR:
+      probe_status = sensor_status->temp_rh_sensor_probe_status;
+      break;
+    case SL_RECOVERY_SUBSYSTEM_IMU_SENSOR:
+      probe_status = sensor_status->imu_sensor_probe_status;
+      break;
+    case SL_RECOVERY_SUBSYSTEM_GNSS_RECEIVER:
+      probe_status = sensor_status->gnss_receiver_probe_status;
+      break;
+    default:
+      return false;
+  }
+
+  return ((SL_SENSOR_PROBE_FAILED == probe_status)
+          || (SL_SENSOR_DISCONNECTED == probe_status));
+}
+
+/******************************************************************************
+ *  Function to check whether the Wi-Fi connection is lost.
+ *****************************************************************************/
+static bool sl_recovery_is_wifi_failed(sl_recovery_subsystem_e subsystem)
+{
+  UNUSED_PARAMETER(subsystem);
+
+  return (SL_WIFI_DISCONNECTED
+          == sl_get_wifi_asset_tracking_status()->wifi_conn_status);
+}
+
+/******************************************************************************
+ *  Function to check whether the IoT Hub connection is lost.
+ *****************************************************************************/
+static bool sl_recovery_is_cloud_failed(sl_recovery_subsystem_e subsystem)
+{
+  UNUSED_PARAMETER(subsystem);
+
+  return (SL_CLOUD_DISCONNECTED
+          == sl_get_wifi_asset_tracking_status()->azure_cloud_conn_status);
+}
+
+/******************************************************************************
+ *  Function to reinitialize a sensor on the I2C bus.
+ *****************************************************************************/
+static sl_status_t sl_recovery_reinit_sensor(sl_recovery_subsystem_e subsystem)
+{
+  sl_wifi_asset_tracking_sensor_queue_data_type_e sensor;
+  sl_siwx917_wifi_asset_tracking_lcd_logs_indexing_e lcd_connected;
+  sl_status_t status = SL_STATUS_FAIL;
+
+  switch (subsystem) {
+    case SL_RECOVERY_SUBSYSTEM_TEMPERATURE_RH_SENSOR:
+      sensor = SL_TEMP_RH_SENSOR;
+      lcd_connected = INDEX_SI7021_CONNECTED;
+      sl_wifi_asset_tracking_lcd_print_value(
+        INDEX_SI7021_RECONNECTING,
+        (int32_t)(sl_recovery.stats[subsystem].consecutive_failures + 1));
+      break;
+    case SL_RECOVERY_SUBSYSTEM_IMU_SENSOR:
+      sensor = SL_IMU_SENSOR;
+      lcd_connected = INDEX_BMI270_CONNECTED;
+      sl_wifi_asset_tracking_lcd_print_value(
+        INDEX_BMI270_RECONNECTING,
+        (int32_t)(sl_recovery.stats[subsystem].consecutive_failures + 1));
+      break;
+    case SL_RECOVERY_SUBSYSTEM_GNSS_RECEIVER:
+      sensor = SL_GNSS_RECEIVER;
+      lcd_connected = INDEX_MAX_M10S_CONNECTED;
+      sl_wifi_asset_tracking_lcd_print_value(
+        INDEX_MAX_M10S_RECONNECTING,
+        (int32_t)(sl_recovery.stats[subsystem].consecutive_failures + 1));
+      break;
+    default:
+      return SL_STATUS_FAIL;
+  }
+
+  /// A sensor task stuck on the bus is recreated by the supervisor, the
+  /// attempt fails instead of waiting for it
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        i2c_mutex_handler,
+                        pdMS_TO_TICKS(SENSOR_PER_RETRY_DELAY)
+                        * TIMER_CLOCK_OFFSET)) {
+    return SL_STATUS_FAIL;
+  }
+
+  switch (sensor) {
+    case SL_TEMP_RH_SENSOR:
+      status = sl_init_si7021_temperature_and_rh_sensor();
+      break;
+    case SL_IMU_SENSOR:
+      status = sl_init_bmi270_imu_sensor();
+      break;
+    default:
+      status = sl_init_max_m10s_gnss_receiver();
+      break;
+  }
+
+  xSemaphoreGive(sl_get_wifi_asset_tracking_resource()->i2c_mutex_handler);
+
+  if (SL_STATUS_OK != status) {
+    return SL_STATUS_FAIL;
+  }
+
+  sl_wifi_asset_tracking_set_sensor_status(sensor, SL_SENSOR_CONNECTED);
+  sl_wifi_asset_tracking_lcd_print(lcd_connected);
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to run one burst of Wi-Fi rejoin attempts.
+ *****************************************************************************/
+static sl_status_t sl_recovery_reinit_wifi(sl_recovery_subsystem_e subsystem)
+{
+  UNUSED_PARAMETER(subsystem);
+
+  /// The IoT Hub session does not survive the link, it is reconnected once
+  /// Wi-Fi is back
+  sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_DISCONNECTED);
+
+  /// Time is set from SNTP on the first connection only
+  if (SL_STATUS_OK != sl_retry_wifi_connection(!sl_clock_is_synced())) {
+    return SL_STATUS_FAIL;
+  }
+
+  sl_wifi_asset_tracking_set_wifi_status(SL_WIFI_CONNECTED);
+  sl_wifi_asset_tracking_lcd_print(INDEX_WIFI_CONNECTED);
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to connect to IoT Hub once.
+ *****************************************************************************/
+static sl_status_t sl_recovery_reinit_cloud(sl_recovery_subsystem_e subsystem)
+{
+  UNUSED_PARAMETER(subsystem);
+
+  if (SL_STATUS_OK != sl_retry_azure_cloud_connection()) {
+    return SL_STATUS_FAIL;
+  }
+
+  sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_CONNECTED);
+  sl_wifi_asset_tracking_lcd_print(INDEX_AZURE_CLOUD_CONNECTED);
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to mark a subsystem healthy and record its outage.
+ *****************************************************************************/
+static void sl_recovery_on_recovered(sl_recovery_subsystem_e subsystem,
+                                     uint32_t now)
+{
+  sl_recovery_stats_t *stats = &sl_recovery.stats[subsystem];
+  uint32_t outage_ms = now - sl_recovery.failed_ms[subsystem];
+
+  taskENTER_CRITICAL();
+  stats->state = SL_RECOVERY_STATE_HEALTHY;
+  stats->recoveries++;
+  stats->consecutive_failures = 0;
+  stats->last_outage_ms = outage_ms;
+  if (outage_ms > stats->max_outage_ms) {
+    stats->max_outage_ms = outage_ms;
+  }
+  taskEXIT_CRITICAL();
+  sl_metrics_observe(SL_METRIC_RECOVERY_TIME, outage_ms);
+
+  printf("\r\nsl_recovery_on_recovered : %s recovered after %lu ms\r\n",
+         sl_recovery_subsystem_config[subsystem].name,
+         outage_ms);
+}
+
+/******************************************************************************
+ *  Function to get the jittered delay before the next attempt.
+ *****************************************************************************/
+static uint32_t sl_recovery_get_backoff(sl_recovery_subsystem_e subsystem)
+{
+  const sl_recovery_subsystem_config_t *config =
+    &sl_recovery_subsystem_config[subsystem];
+  const sl_device_identity_t *identity = sl_device_identity_get();
+  uint32_t failures = sl_recovery.stats[subsystem].consecutive_failures;
+  uint32_t delay = config->backoff_initial;
+  uint32_t index;
+
+  if (0 == failures) {
+    delay = config->first_delay;
+  } else {
+    while ((--failures > 0) && (delay < config->backoff_max)) {
+      delay *= 2;
+    }
+  }
+  if (delay > config->backoff_max) {
+    delay = config->backoff_max;
+  }
+
+  /// Devices which lost the same access point retry at different times,
+  /// the MAC address keeps their sequences apart. The identity cache is
+  /// stale while Wi-Fi is down, so it is folded in once when available and
+  /// the tick count alone stirs the state until then
+  sl_recovery.jitter_state ^= (uint32_t)xTaskGetTickCount();
+  if ((!sl_recovery.jitter_seeded) && (NULL != identity)) {
+    for (index = 0; index < identity->mac_len; index++) {
+      sl_recovery.jitter_state = (sl_recovery.jitter_state * 31)
+                                 + (uint8_t)identity->mac[index];
+    }
+    sl_recovery.jitter_seeded = true;
+  }
+  if (0 == sl_recovery.jitter_state) {
+    sl_recovery.jitter_state = 1;
+  }
+  sl_recovery.jitter_state ^= sl_recovery.jitter_state << 13;
+  sl_recovery.jitter_state ^= sl_recovery.jitter_state >> 17;
+  sl_recovery.jitter_state ^= sl_recovery.jitter_state << 5;
+
+  return delay - (sl_recovery.jitter_state
+                  % ((delay / 100) * RECOVERY_JITTER_PERCENT + 1));
+}
+
+/******************************************************************************
+ *  Function to get the time since boot.
+ *****************************************************************************/
+static uint32_t sl_recovery_get_time_ms(void)
+{
+  return (uint32_t)((xTaskGetTickCount() * portTICK_PERIOD_MS)
+                    / TIMER_CLOCK_OFFSET);
+}
+
+/******************************************************************************
+ *  Function to publish the recovery gauges.
+ *****************************************************************************/
+static void sl_recovery_update_gauges(void)
+{
+  sl_recovery_subsystem_e subsystem;
+  uint32_t pending = 0;
+  uint32_t backoff = 0;
+
+  for (subsystem = 0; subsystem < SL_RECOVERY_SUBSYSTEM_COUNT; subsystem++) {
+    if (SL_RECOVERY_STATE_HEALTHY == sl_recovery.stats[subsystem].state) {
+      continue;
+    }
+
+    pending |= (1UL << subsystem);
+    if (sl_recovery.stats[subsystem].last_backoff_ms > backoff) {
+      backoff = sl_recovery.stats[subsystem].last_backoff_ms;
+    }
+  }
+
+  sl_metrics_set_gauge(SL_METRIC_RECOVERY_PENDING, (int32_t)pending);
+  sl_metrics_set_gauge(SL_METRIC_RECOVERY_BACKOFF, (int32_t)backoff);
+}
@@ -0,0 +1,416 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_sas_token.c
+ * @brief SAS token signature cache and reusable HMAC-SHA256 context
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <mbedtls/sha256.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_sas_token.h>
+
+/// SHA-256 state after absorbing (key ^ ipad), reused by every signature
+static mbedtls_sha256_context sl_sas_token_inner_context;
+
+/// SHA-256 state after absorbing (key ^ opad), reused by every signature
+static mbedtls_sha256_context sl_sas_token_outer_context;
+
+/// Key the pad contexts were computed from
+static uint8_t sl_sas_token_key[HMAC_SHA256_BLOCK_SIZE];
+
+/// Length of key the pad contexts were computed from, 0 if not computed yet
+static uint32_t sl_sas_token_key_len;
+
+/// Signatures of current and next cache window
+static sl_sas_token_cache_entry_t sl_sas_token_cache[SAS_TOKEN_CACHE_SLOTS];
+
+/// Slot to be replaced by next signature stored in cache
+static uint8_t sl_sas_token_next_slot;
+
+/// Last string-to-sign requested by the Azure client, used for refresh
+static sl_sas_token_cache_entry_t sl_sas_token_last_request;
+
+/// Lifetime of the SAS token, learnt from last string-to-sign
+static uint32_t sl_sas_token_lifetime;
+
+/**************************************************************************/ /**
+ * @brief Precompute inner and outer pad contexts of a key. Cache mutex must be
+ * held.
+ * @param[in] key : HMAC key.
+ * @param[in] key_len : length of key.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on SHA-256 failure
+ ******************************************************************************/
+static sl_status_t sl_sas_token_set_key(const uint8_t *key, uint32_t key_len);
+
+/**************************************************************************/ /**
+ * @brief Compute HMAC-SHA256 of a message from the pad contexts. Cache mutex
+ * must be held.
+ * @param[in] message : message to sign.
+ * @param[in] message_len : length of message.
+ * @param[out] digest : HMAC output buffer of HMAC_SHA256_DIGEST_SIZE bytes.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - on SHA-256 failure
+ ******************************************************************************/
+static sl_status_t sl_sas_token_sign(const uint8_t *message,
+                                     uint32_t message_len,
+                                     uint8_t *digest);
+
+/**************************************************************************/ /**
+ * @brief Find cached signature of a message. Cache mutex must be held.
+ * @param[in] message : string-to-sign.
+ * @param[in] message_len : length of message.
+ * @return pointer to the entry, NULL if message is not cached.
+ ******************************************************************************/
+static sl_sas_token_cache_entry_t *sl_sas_token_find(const uint8_t *message,
+                                                     uint32_t message_len);
+
+/**************************************************************************/ /**
+ * @brief Store a signature in cache, replacing the older slot. Cache mutex
+ * must be held.
+ * @param[in] message : string-to-sign.
+ * @param[in] message_len : length of message.
+ * @param[in] digest : HMAC-SHA256 of message.
+ ******************************************************************************/
+static void sl_sas_token_store(const uint8_t *message,
+                               uint32_t message_len,
+                               const uint8_t *digest);
+
+/**************************************************************************/ /**
+ * @brief Parse the decimal expiry following '\n' in a string-to-sign.
+ * @param[in] message : string-to-sign.
+ * @param[in] message_len : length of message.
+ * @param[out] resource_len : length of "<resource>\n" prefix.
+ * @param[out] expiry : parsed expiry.
+ * @return true if the message has the expected layout.
+ ******************************************************************************/
+static bool sl_sas_token_parse_expiry(const uint8_t *message,
+                                      uint32_t message_len,
+                                      uint32_t *resource_len,
+                                      uint32_t *expiry);
+
+/******************************************************************************
+ *  Time source aligned to SAS token cache window.
+ *****************************************************************************/
+uint32_t sl_sas_token_get_time(void)
+{
+  /// sl_get_unix_time is in ms, SAS expiry and the window are in seconds
+  uint32_t time = sl_get_unix_time() / 1000U;
+
+  return time - (time % SAS_TOKEN_CACHE_WINDOW);
+}
+
+/******************************************************************************
+ *  Function to compute HMAC-SHA256 of SAS string-to-sign.
+ *****************************************************************************/
+sl_status_t sl_sas_token_hmac(const uint8_t *key,
+                              uint32_t key_len,
+                              const uint8_t *message,
+                              uint32_t message_len,
+                              uint8_t *digest)
+{
+  sl_status_t status = SL_STATUS_FAIL;
+  sl_sas_token_cache_entry_t *entry;
+  uint32_t resource_len;
+  uint32_t expiry;
+
+  if ((NULL == key) || (NULL == message) || (NULL == digest)
+      || (0 == key_len) || (key_len > HMAC_SHA256_BLOCK_SIZE)) {
+    return SL_STATUS_FAIL;
+  }
+
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        sas_token_mutex_handler,
+                        portMAX_DELAY)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// Pads depend only on the key, recompute them when the key changes
+  if ((key_len != sl_sas_token_key_len)
+      || (0 != memcmp(sl_sas_token_key, key, key_len))) {
+    if (SL_STATUS_OK != sl_sas_token_set_key(key, key_len)) {
+      goto error;
+    }
+  }
+
+  /// Remember request and token lifetime for the refresh timer
+  if ((message_len <= SAS_TOKEN_MAX_MESSAGE_SIZE)
+      && sl_sas_token_parse_expiry(message,
+                                   message_len,
+                                   &resource_len,
+                                   &expiry)) {
+    memcpy(sl_sas_token_last_request.message, message, message_len);
+    sl_sas_token_last_request.message_len = message_len;
+    sl_sas_token_last_request.is_valid = true;
+    sl_sas_token_lifetime = expiry - sl_sas_token_get_time();
+  }
+
+  entry = sl_sas_token_find(message, message_len);
+
+  if (NULL != entry) {
+#if DEMO_CONFIG_DEBUG_LOGS
+    printf("\r\nsl_sas_token_hmac : cached signature reused\r\n");
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
+    memcpy(digest, entry->digest, HMAC_SHA256_DIGEST_SIZE);
+    status = SL_STATUS_OK;
+    goto error;
+  }
+
+  status = sl_sas_token_sign(message, message_len, digest);
+
+  if (SL_STATUS_OK == status) {
+    sl_sas_token_store(message, message_len, digest);
+  }
+
+  error:
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->sas_token_mutex_handler);
+  return status;
+}
+
+/******************************************************************************
+ *  Callback function of SAS token refresh timer.
+ *****************************************************************************/
+void on_sas_token_refresh_timer_callback()
+{
+  uint8_t message[SAS_TOKEN_MAX_MESSAGE_SIZE + 1];
+  uint8_t digest[HMAC_SHA256_DIGEST_SIZE];
+  uint32_t resource_len;
+  uint32_t expiry;
+  int length;
+
+  /// Runs in timer daemon context, never block behind a signing client
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        sas_token_mutex_handler,
+                        0)) {
+    return;
+  }
+
+  if ((!sl_sas_token_last_request.is_valid)
+      || (0 == sl_sas_token_key_len)
+      || (!sl_sas_token_parse_expiry(sl_sas_token_last_request.message,
+                                     sl_sas_token_last_request.message_len,
+                                     &resource_len,
+                                     &expiry))) {
+    goto error;
+  }
+
+  /// Expiry the Azure client will request once the next window starts
+  expiry = sl_sas_token_get_time() + SAS_TOKEN_CACHE_WINDOW
+           + sl_sas_token_lifetime;
+
+  memcpy(message, sl_sas_token_last_request.message, resource_len);
+  length = snprintf((char *)&message[resource_len],
+                    sizeof(message) - resource_len,
+                    "%lu",
+                    (unsigned long)expiry);
+
+  if ((length <= 0)
+      || ((resource_len + (uint32_t)length) > SAS_TOKEN_MAX_MESSAGE_SIZE)) {
+    goto error;
+  }
+
+  if (NULL != sl_sas_token_find(message, resource_len + length)) {
+    goto error;
+  }
+
+  if (SL_STATUS_OK
+      == sl_sas_token_sign(message, resource_len + length, digest)) {
+    sl_sas_token_store(message, resource_len + length, digest);
+#if DEMO_CONFIG_DEBUG_LOGS
+    printf("\r\non_sas_token_refresh_timer_callback : next signature ready\r\n");
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
+  }
+
+  error:
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->sas_token_mutex_handler);
+}
+
+/******************************************************************************
+ *  Precompute inner and outer pad contexts of a key.
+ *****************************************************************************/
+static sl_status_t sl_sas_token_set_key(const uint8_t *key, uint32_t key_len)
+{
+  uint8_t pad[HMAC_SHA256_BLOCK_SIZE];
+  uint8_t index;
+
+  /// Pads of a new key invalidate every cached signature
+  memset(sl_sas_token_cache, 0, sizeof(sl_sas_token_cache));
+  sl_sas_token_key_len = 0;
+
+  mbedtls_sha256_free(&sl_sas_token_inner_context);
+  mbedtls_sha256_free(&sl_sas_token_outer_context);
+  mbedtls_sha256_init(&sl_sas_token_inner_context);
+  mbedtls_sha256_init(&sl_sas_token_outer_context);
+
+  memset(pad, HMAC_INNER_PAD, sizeof(pad));
+  for (index = 0; index < key_len; ++index) {
+    pad[index] ^= key[index];
+  }
+
+  if ((0 != mbedtls_sha256_starts(&sl_sas_token_inner_context, 0))
+      || (0 != mbedtls_sha256_update(&sl_sas_token_inner_context,
+                                     pad,
+                                     sizeof(pad)))) {
+    printf("\r\nsl_sas_token_set_key : inner pad failed\r\n");
+    return SL_STATUS_FAIL;
+  }
+
+  memset(pad, HMAC_OUTER_PAD, sizeof(pad));
+  for (index = 0; index < key_len; ++index) {
+    pad[index] ^= key[index];
+  }
+
+  if ((0 != mbedtls_sha256_starts(&sl_sas_token_outer_context, 0))
+      || (0 != mbedtls_sha256_update(&sl_sas_token_outer_context,
+                                     pad,
+                                     sizeof(pad)))) {
+    printf("\r\nsl_sas_token_set_key : outer pad failed\r\n");
+    return SL_STATUS_FAIL;
+  }
+
+  memset(pad, 0, sizeof(pad));
+  memset(sl_sas_token_key, 0, sizeof(sl_sas_token_key));
+  memcpy(sl_sas_token_key, key, key_len);
+  sl_sas_token_key_len = key_len;
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Compute HMAC-SHA256 of a message from the pad contexts.
+ *****************************************************************************/
+static sl_status_t sl_sas_token_sign(const uint8_t *message,
+                                     uint32_t message_len,
+                                     uint8_t *digest)
+{
+  mbedtls_sha256_context context;
+  uint8_t inner_digest[HMAC_SHA256_DIGEST_SIZE];
+  sl_status_t status = SL_STATUS_FAIL;
+
+  mbedtls_sha256_init(&context);
+
+  /// H((key ^ ipad) || message), key block already absorbed
+  mbedtls_sha256_clone(&context, &sl_sas_token_inner_context);
+  if ((0 != mbedtls_sha256_update(&context, message, message_len))
+      || (0 != mbedtls_sha256_finish(&context, inner_digest))) {
+    goto error;
+  }
+
+  /// H((key ^ opad) || inner digest), key block already absorbed
+  mbedtls_sha256_clone(&context, &sl_sas_token_outer_context);
+  if ((0 != mbedtls_sha256_update(&context,
+                                  inner_digest,
+                                  sizeof(inner_digest)))
+      || (0 != mbedtls_sha256_finish(&context, digest))) {
+    goto error;
+  }
+
+  status = SL_STATUS_OK;
+
+  error:
+  mbedtls_sha256_free(&context);
+  memset(inner_digest, 0, sizeof(inner_digest));
+  if (SL_STATUS_OK != status) {
+    printf("\r\nsl_sas_token_sign : HMAC failed\r\n");
+  }
+  return status;
+}
+
+/******************************************************************************
+ *  Find cached signature of a message.
+ *****************************************************************************/
+static sl_sas_token_cache_entry_t *sl_sas_token_find(const uint8_t *message,
+                                                     uint32_t message_len)
+{
+  uint8_t index;
+
+  for (index = 0; index < SAS_TOKEN_CACHE_SLOTS; ++index) {
+    if (sl_sas_token_cache[index].is_valid
+        && (message_len == sl_sas_token_cache[index].message_len)
+        && (0 == memcmp(sl_sas_token_cache[index].message,
+                        message,
+                        message_len))) {
+      return &sl_sas_token_cache[index];
+    }
+  }
+
+  return NULL;
+}
+
+/******************************************************************************
+ *  Store a signature in cache.
+ *****************************************************************************/
+static void sl_sas_token_store(const uint8_t *message,
+                               uint32_t message_len,
+                               const uint8_t *digest)
+{
+  sl_sas_token_cache_entry_t *entry;
+
+  /// Messages which do not fit in a slot are signed every time
+  if (message_len > SAS_TOKEN_MAX_MESSAGE_SIZE) {
+    return;
+  }
+
+  entry = &sl_sas_token_cache[sl_sas_token_next_slot];
+  sl_sas_token_next_slot = (sl_sas_token_next_slot + 1)
+                           % SAS_TOKEN_CACHE_SLOTS;
+
+  memcpy(entry->message, message, message_len);
+  entry->message_len = message_len;
+  memcpy(entry->digest, digest, HMAC_SHA256_DIGEST_SIZE);
+  entry->is_valid = true;
+}
+
+/******************************************************************************
+ *  Parse the decimal expiry of a string-to-sign.
+ *****************************************************************************/
+static bool sl_sas_token_parse_expiry(const uint8_t *message,
+                                      uint32_t message_len,
+                                      uint32_t *resource_len,
+                                      uint32_t *expiry)
+{
+  const uint8_t *separator;
+  uint32_t index;
+  uint32_t value = 0;
+
+  separator = memchr(message, '\n', message_len);
+
+  if (NULL == separator) {
+    return false;
+  }
+
+  *resource_len = (uint32_t)(separator - message) + 1;
+
+  if ((message_len == *resource_len)
+      || ((message_len - *resource_len) > SAS_TOKEN_MAX_EXPIRY_DIGITS)) {
+    return false;
+  }
+
+  for (index = *resource_len; index < message_len; ++index) {
+    if ((message[index] < '0') || (message[index] > '9')) {
+      return false;
+    }
+    value = (value * 10) + (message[index] - '0');
+  }
+
+  *expiry = value;
+  return true;
+}
@@ -18,6 +18,7 @@
 #include <sl_wifi_asset_tracking_sensor.h>
 #include <sl_wifi_asset_tracking_app.h>
 #include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_sensor_trace.h>
 #include "sparkfun_bmi270.h"
 #include "gnss_max_m10s_driver.h"
 
@@ -255,18 +256,10 @@ void sl_capture_temperature_rh_sensor_data_task()
          TEMPERATURE_UNIT_STRING);
   si7021_reading.sensor_type = SL_TEMP_RH_SENSOR;
 
-  if ((SL_SENSOR_NOT_PROBED
-       == sl_get_wifi_asset_tracking_status()->sensor_status.
-       temp_rh_sensor_probe_status)
-      || (SL_SENSOR_RECONNECTED
-          == sl_get_wifi_asset_tracking_status()->sensor_status.
-          temp_rh_sensor_probe_status)) {
-    if (SL_SENSOR_RECONNECTED
-        == sl_get_wifi_asset_tracking_status()->sensor_status.
-        temp_rh_sensor_probe_status) {
-      vTaskDelay(pdMS_TO_TICKS(SENSOR_PER_RETRY_DELAY) * TIMER_CLOCK_OFFSET);
-    }
-
+  /// Probed once, the recovery task reinitializes a failed sensor in place
+  if (SL_SENSOR_NOT_PROBED
+      == sl_get_wifi_asset_tracking_status()->sensor_status.
+      temp_rh_sensor_probe_status) {
     if (SL_STATUS_OK == sl_disable_onboard_si7021_sensor()) {
       if (pdTRUE
           == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
@@ -279,41 +272,35 @@ void sl_capture_temperature_rh_sensor_data_task()
 
         if (SL_STATUS_OK == status) {
           /// make sensor status flag as working
-          sl_get_wifi_asset_tracking_status()->sensor_status.
-          temp_rh_sensor_probe_status = SL_SENSOR_CONNECTED;
+          sl_wifi_asset_tracking_set_sensor_status(SL_TEMP_RH_SENSOR,
+                                                   SL_SENSOR_CONNECTED);
 
           sl_wifi_asset_tracking_lcd_print(INDEX_SI7021_CONNECTED);
-
-          sl_get_wifi_asset_tracking_status()->sensor_status.
-          temp_rh_sensor_retry_cnt = 0;
         } else {
-          sl_get_wifi_asset_tracking_status()->sensor_status.
-          temp_rh_sensor_probe_status = SL_SENSOR_PROBE_FAILED;
+          sl_wifi_asset_tracking_set_sensor_status(SL_TEMP_RH_SENSOR,
+                                                   SL_SENSOR_PROBE_FAILED);
 
           sl_wifi_asset_tracking_lcd_print(INDEX_SI7021_NOT_CONNECTED);
-
-          if (eSuspended
-              == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                               recovery_task_handler)) {
-            vTaskResume(
-              sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-          }
         }
       }
     }
   }
 
-  /// If wi-fi not in initialized state then only suspend temperature and RH sensor task
+  /// If wi-fi not in initialized state then wait for the wi-fi up event,
+  /// subscribing before the check keeps an event published meanwhile
+  sl_event_bus_subscribe(SL_STATIC_TASK_TEMPERATURE_RH_SENSOR,
+                         SL_EVENT_BIT(SL_EVENT_WIFI_UP),
+                         SL_EVENT_DELIVERY_WAKE);
   if (SL_WIFI_NOT_CONNECTED
       == sl_get_wifi_asset_tracking_status()->wifi_conn_status) {
     printf(
-      "\r\ntemperature_rh_sensor_task : suspending task as sensor got probed but wi-fi is not connected\r\n");
-    vTaskSuspend(
-      sl_get_wifi_asset_tracking_resource()->task_list.temp_rh_sensor_task_handler);
+      "\r\ntemperature_rh_sensor_task : waiting as sensor got probed but wi-fi is not connected\r\n");
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
   }
 
   while (1) {
     initial_tick_count = xTaskGetTickCount();
+    sl_supervisor_check_in(SL_SUPERVISOR_CLIENT_TEMPERATURE_RH_SENSOR);
 
     if (SL_SENSOR_CONNECTED
         == sl_get_wifi_asset_tracking_status()->sensor_status.
@@ -338,14 +325,12 @@ void sl_capture_temperature_rh_sensor_data_task()
 
       if (status != SL_STATUS_OK) {
         si7021_reading.is_sensor_data_available = false;
-        printf("\r\ntemperature_rh_sensor_task : si7021 Sensor read is failed\n");
+        sl_metrics_increment(SL_METRIC_SENSOR_READ_FAILURES);
+        SL_LOG_ERROR(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_SI7021_READ_FAILED);
       } else {
         si7021_reading.is_sensor_data_available = true;
 
-#if DEMO_CONFIG_DEBUG_LOGS
-        printf(
-          "\r\ntemperature_rh_sensor_task : si7021 Sensor read is successful\n");
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+        SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_SI7021_READ_OK);
       }
     } else {
       si7021_reading.is_sensor_data_available = false;
@@ -354,14 +339,17 @@ void sl_capture_temperature_rh_sensor_data_task()
 
     /// If failed to fetch time-stamp then discard the packet
     if (SL_STATUS_OK != sl_json_get_timestamp(si7021_reading.time_stamp)) {
-      printf(
-        "\r\ntemperature_rh_sensor_task :  failed to fetch time-stamp, discarding the packet\r\n");
+      SL_LOG_WARN(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_SI7021_TIMESTAMP_FAILED);
       goto taskdelay;
     }
 
     si7021_reading.temp_rh_data.temperature = (double)temperature;
     si7021_reading.temp_rh_data.relative_humidity = (double)humidity;
 
+    /// Sample to publish latency is measured from here
+    si7021_reading.sample_tick = xTaskGetTickCount();
+    sl_sensor_trace_record(&si7021_reading);
+
     /// Acquire sensor data queue mutex and send data to sensor data queue
     if (pdTRUE
         == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
@@ -371,14 +359,16 @@ void sl_capture_temperature_rh_sensor_data_task()
           == xQueueSend(sl_get_wifi_asset_tracking_resource()->
                         sensor_data_queue_handler,
                         &si7021_reading, 0)) {
+        sl_metrics_increment(SL_METRIC_SENSOR_SAMPLES);
       } else {
+        sl_metrics_increment(SL_METRIC_SENSOR_QUEUE_DROPS);
+
         /// Receive sensor data as sensor data queue is full
         if (pdTRUE
             == xQueueReceive(sl_get_wifi_asset_tracking_resource()->
                              sensor_data_queue_handler,
                              &si7021_reading, 0)) {
-          printf(
-            "\r\ntemperature_rh_sensor_task : received sensor data as sensor data queue is full\r\n");
+          SL_LOG_WARN(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_SI7021_QUEUE_FULL);
 
           /// again send latest si7021 latest data to sensor data queue
           xQueueSend(
@@ -387,27 +377,32 @@ void sl_capture_temperature_rh_sensor_data_task()
             0);
         }
       }
-      printf(
-        "\r\ntemperature_rh_sensor_task : si7021 sensor data is sent to sensor data queue\r\n");
+
+      sl_metrics_raise_gauge(SL_METRIC_SENSOR_QUEUE_PEAK,
+                             (int32_t)uxQueueMessagesWaiting(
+                               sl_get_wifi_asset_tracking_resource()->
+                               sensor_data_queue_handler));
+
+      SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_SI7021_QUEUED);
 
       xSemaphoreGive(
         sl_get_wifi_asset_tracking_resource()->sensor_data_queue_mutex_handler);
     }
 
-    /// check whether JSON data converter task is suspended or not
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         json_data_converter_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.json_data_converter_task_handler);
-    }
+    /// Notifications are counted, the wake-up is kept even when the JSON
+    /// task is not waiting yet
+    xTaskNotifyGive(
+      sl_get_wifi_asset_tracking_resource()->task_list.json_data_converter_task_handler);
 
     taskdelay:
 
     later_tick_count = xTaskGetTickCount();
 
-    /// Sampling interval and setting a offset
-    task_delay = pdMS_TO_TICKS(temp_sampling_interval) * TIMER_CLOCK_OFFSET;
+    /// Sampling interval stretched by publish backpressure and setting a offset
+    task_delay = pdMS_TO_TICKS(sl_rate_limit_scale_interval(
+                                 temp_sampling_interval,
+                                 MAX_LIMIT_OF_TEMP_RH_SENSOR_SAMPLING_INTERVAL * 1000))
+                 * TIMER_CLOCK_OFFSET;
 
 #if ENABLE_SAMPLING_JITTER
     processing_diff = (later_tick_count - initial_tick_count)
@@ -434,11 +429,10 @@ void sl_capture_temperature_rh_sensor_data_task()
     UNUSED_VARIABLE(processing_diff);
 #endif /// < ENABLE_SAMPLING_JITTER
 
-#if DEMO_CONFIG_DEBUG_LOGS
-    printf("\r\ntemperature_rh_sensor_task : delay is : %ld\r\n", task_delay);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+    SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_SI7021_DELAY, task_delay);
 
-    vTaskDelay(task_delay);
+    sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_TEMPERATURE_RH_SENSOR);
+    sl_wake_planner_delay(SL_WAKE_CLIENT_TEMPERATURE_RH_SENSOR, task_delay);
   }
 }
 
@@ -459,18 +453,10 @@ void sl_capture_imu_sensor_data_task()
   /// Appending sensor type
   bmi270_reading.sensor_type = SL_IMU_SENSOR;
 
-  if ((SL_SENSOR_NOT_PROBED
-       == sl_get_wifi_asset_tracking_status()->sensor_status.
-       imu_sensor_probe_status)
-      || (SL_SENSOR_RECONNECTED
-          == sl_get_wifi_asset_tracking_status()->sensor_status.
-          imu_sensor_probe_status)) {
-    if (SL_SENSOR_RECONNECTED
-        == sl_get_wifi_asset_tracking_status()->sensor_status.
-        imu_sensor_probe_status) {
-      vTaskDelay(pdMS_TO_TICKS(SENSOR_PER_RETRY_DELAY) * TIMER_CLOCK_OFFSET);
-    }
-
+  /// Probed once, the recovery task reinitializes a failed sensor in place
+  if (SL_SENSOR_NOT_PROBED
+      == sl_get_wifi_asset_tracking_status()->sensor_status.
+      imu_sensor_probe_status) {
     if (pdTRUE
         == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
                           i2c_mutex_handler,
@@ -482,40 +468,34 @@ void sl_capture_imu_sensor_data_task()
       /// Initialize the bmi270 sensor
       if (SL_STATUS_OK == status) {
         /// make sensor status flag as working
-        sl_get_wifi_asset_tracking_status()->sensor_status.
-        imu_sensor_probe_status = SL_SENSOR_CONNECTED;
+        sl_wifi_asset_tracking_set_sensor_status(SL_IMU_SENSOR,
+                                                 SL_SENSOR_CONNECTED);
 
         sl_wifi_asset_tracking_lcd_print(INDEX_BMI270_CONNECTED);
-
-        sl_get_wifi_asset_tracking_status()->sensor_status.imu_sensor_retry_cnt
-          = 0;
       } else {
-        sl_get_wifi_asset_tracking_status()->sensor_status.
-        imu_sensor_probe_status = SL_SENSOR_PROBE_FAILED;
+        sl_wifi_asset_tracking_set_sensor_status(SL_IMU_SENSOR,
+                                                 SL_SENSOR_PROBE_FAILED);
 
         sl_wifi_asset_tracking_lcd_print(INDEX_BMI270_NOT_CONNECTED);
-
-        if (eSuspended
-            == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                             recovery_task_handler)) {
-          vTaskResume(
-            sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-        }
       }
     }
   }
 
-  /// If wi-fi not in initialized state then only suspend IMU sensor task
+  /// If wi-fi not in initialized state then wait for the wi-fi up event,
+  /// subscribing before the check keeps an event published meanwhile
+  sl_event_bus_subscribe(SL_STATIC_TASK_IMU_SENSOR,
+                         SL_EVENT_BIT(SL_EVENT_WIFI_UP),
+                         SL_EVENT_DELIVERY_WAKE);
   if (SL_WIFI_NOT_CONNECTED
       == sl_get_wifi_asset_tracking_status()->wifi_conn_status) {
     printf(
-      "\r\nimu_sensor_task : suspending task as sensor got probed but wi-fi is not connected\r\n");
-    vTaskSuspend(
-      sl_get_wifi_asset_tracking_resource()->task_list.imu_sensor_task_handler);
+      "\r\nimu_sensor_task : waiting as sensor got probed but wi-fi is not connected\r\n");
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
   }
 
   while (1) {
     initial_tick_count = xTaskGetTickCount();
+    sl_supervisor_check_in(SL_SUPERVISOR_CLIENT_IMU_SENSOR);
 
     if (SL_SENSOR_CONNECTED
         == sl_get_wifi_asset_tracking_status()->sensor_status.
@@ -534,8 +514,8 @@ void sl_capture_imu_sensor_data_task()
 
       if (acc_status != SL_STATUS_OK) {
         bmi270_reading.is_sensor_data_available = false;
-        printf(
-          "\r\nimu_sensor_task : bmi270 Accelerometer sensor read is failed\n");
+        sl_metrics_increment(SL_METRIC_SENSOR_READ_FAILURES);
+        SL_LOG_ERROR(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_BMI270_ACC_READ_FAILED);
       } else {
         if (pdTRUE
             == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
@@ -552,8 +532,9 @@ void sl_capture_imu_sensor_data_task()
         }
         if (gyro_status != SL_STATUS_OK) {
           bmi270_reading.is_sensor_data_available = false;
-          printf(
-            "\r\nimu_sensor_task : bmi270 gyroscope sensor read is failed\n");
+          sl_metrics_increment(SL_METRIC_SENSOR_READ_FAILURES);
+          SL_LOG_ERROR(SL_LOG_MODULE_SENSOR,
+                       SL_LOG_FMT_BMI270_GYRO_READ_FAILED);
         } else {
           bmi270_reading.is_sensor_data_available = true;
         }
@@ -565,11 +546,14 @@ void sl_capture_imu_sensor_data_task()
 
     /// If failed to fetch time-stamp then discard the packet
     if (SL_STATUS_OK != sl_json_get_timestamp(bmi270_reading.time_stamp)) {
-      printf(
-        "\r\nimu_sensor_task : failed to fetch time-stamp, discarding the packet\r\n");
+      SL_LOG_WARN(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_BMI270_TIMESTAMP_FAILED);
       goto taskdelay;
     }
 
+    /// Sample to publish latency is measured from here
+    bmi270_reading.sample_tick = xTaskGetTickCount();
+    sl_sensor_trace_record(&bmi270_reading);
+
     /// Acquire sensor data queue mutex and send data to sensor data queue
     if (pdTRUE
         == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
@@ -579,14 +563,16 @@ void sl_capture_imu_sensor_data_task()
           == xQueueSend(sl_get_wifi_asset_tracking_resource()->
                         sensor_data_queue_handler,
                         &bmi270_reading, 0)) {
+        sl_metrics_increment(SL_METRIC_SENSOR_SAMPLES);
       } else {
+        sl_metrics_increment(SL_METRIC_SENSOR_QUEUE_DROPS);
+
         /// Receive sensor data as sensor data queue is full
         if (pdTRUE
             == xQueueReceive(sl_get_wifi_asset_tracking_resource()->
                              sensor_data_queue_handler,
                              &bmi270_reading, 0)) {
-          printf(
-            "\r\nimu_sensor_task : received sensor data as sensor data queue is full\r\n");
+          SL_LOG_WARN(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_BMI270_QUEUE_FULL);
           /// again send latest bmi270 latest data to sensor data queue
           xQueueSend(
             sl_get_wifi_asset_tracking_resource()->sensor_data_queue_handler,
@@ -595,27 +581,31 @@ void sl_capture_imu_sensor_data_task()
         }
       }
 
-      printf(
-        "\r\nimu_sensor_task : bmi270 sensor data is sent to sensor data queue\r\n");
+      sl_metrics_raise_gauge(SL_METRIC_SENSOR_QUEUE_PEAK,
+                             (int32_t)uxQueueMessagesWaiting(
+                               sl_get_wifi_asset_tracking_resource()->
+                               sensor_data_queue_handler));
+
+      SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_BMI270_QUEUED);
 
       xSemaphoreGive(
         sl_get_wifi_asset_tracking_resource()->sensor_data_queue_mutex_handler);
     }
 
-    /// check whether JSON data converter task is suspended or not
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         json_data_converter_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.json_data_converter_task_handler);
-    }
+    /// Notifications are counted, the wake-up is kept even when the JSON
+    /// task is not waiting yet
+    xTaskNotifyGive(
+      sl_get_wifi_asset_tracking_resource()->task_list.json_data_converter_task_handler);
 
     taskdelay:
 
     later_tick_count = xTaskGetTickCount();
 
-    /// Sampling interval and setting a offset
-    task_delay = pdMS_TO_TICKS(imu_sampling_interval) * TIMER_CLOCK_OFFSET;
+    /// Sampling interval stretched by publish backpressure and setting a offset
+    task_delay = pdMS_TO_TICKS(sl_rate_limit_scale_interval(
+                                 imu_sampling_interval,
+                                 MAX_LIMIT_OF_IMU_SENSOR_SAMPLING_INTERVAL * 1000))
+                 * TIMER_CLOCK_OFFSET;
 
 #if ENABLE_SAMPLING_JITTER
     processing_diff = (later_tick_count - initial_tick_count)
@@ -641,11 +631,10 @@ void sl_capture_imu_sensor_data_task()
     UNUSED_VARIABLE(processing_diff);
 #endif /// < ENABLE_SAMPLING_JITTER
 
-#if DEMO_CONFIG_DEBUG_LOGS
-    printf("\r\nimu_sensor_task : delay is : %ld\r\n", task_delay);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+    SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_BMI270_DELAY, task_delay);
 
-    vTaskDelay(task_delay);
+    sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_IMU_SENSOR);
+    sl_wake_planner_delay(SL_WAKE_CLIENT_IMU_SENSOR, task_delay);
   }
 }
 
@@ -666,18 +655,10 @@ void sl_capture_gnss_receiver_data_task()
   /// Appending sensor type
   gnss_reading.sensor_type = SL_GNSS_RECEIVER;
 
-  if ((SL_SENSOR_NOT_PROBED
-       == sl_get_wifi_asset_tracking_status()->sensor_status.
-       gnss_receiver_probe_status)
-      || (SL_SENSOR_RECONNECTED
-          == sl_get_wifi_asset_tracking_status()->sensor_status.
-          gnss_receiver_probe_status)) {
-    if (SL_SENSOR_RECONNECTED
-        == sl_get_wifi_asset_tracking_status()->sensor_status.
-        gnss_receiver_probe_status) {
-      vTaskDelay(pdMS_TO_TICKS(SENSOR_PER_RETRY_DELAY) * TIMER_CLOCK_OFFSET);
-    }
-
+  /// Probed once, the recovery task reinitializes a failed sensor in place
+  if (SL_SENSOR_NOT_PROBED
+      == sl_get_wifi_asset_tracking_status()->sensor_status.
+      gnss_receiver_probe_status) {
     if (pdTRUE
         == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
                           i2c_mutex_handler,
@@ -689,40 +670,34 @@ void sl_capture_gnss_receiver_data_task()
 
       if (SL_STATUS_OK == status) {
         /// make sensor status flag as working
-        sl_get_wifi_asset_tracking_status()->sensor_status.
-        gnss_receiver_probe_status = SL_SENSOR_CONNECTED;
+        sl_wifi_asset_tracking_set_sensor_status(SL_GNSS_RECEIVER,
+                                                 SL_SENSOR_CONNECTED);
 
         sl_wifi_asset_tracking_lcd_print(INDEX_MAX_M10S_CONNECTED);
-
-        sl_get_wifi_asset_tracking_status()->sensor_status.
-        gnss_receiver_retry_cnt = 0;
       } else {
-        sl_get_wifi_asset_tracking_status()->sensor_status.
-        gnss_receiver_probe_status = SL_SENSOR_PROBE_FAILED;
+        sl_wifi_asset_tracking_set_sensor_status(SL_GNSS_RECEIVER,
+                                                 SL_SENSOR_PROBE_FAILED);
 
         sl_wifi_asset_tracking_lcd_print(INDEX_MAX_M10S_NOT_CONNECTED);
-
-        if (eSuspended
-            == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                             recovery_task_handler)) {
-          vTaskResume(
-            sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-        }
       }
     }
   }
 
-  /// If wi-fi not in initialized state then only suspend GNNS receiver task
+  /// If wi-fi not in initialized state then wait for the wi-fi up event,
+  /// subscribing before the check keeps an event published meanwhile
+  sl_event_bus_subscribe(SL_STATIC_TASK_GNSS_RECEIVER,
+                         SL_EVENT_BIT(SL_EVENT_WIFI_UP),
+                         SL_EVENT_DELIVERY_WAKE);
   if (SL_WIFI_NOT_CONNECTED
       == sl_get_wifi_asset_tracking_status()->wifi_conn_status) {
     printf(
-      "\r\ngnss_receiver_task : suspending task as sensor got probed but wi-fi is not connected\r\n");
-    vTaskSuspend(
-      sl_get_wifi_asset_tracking_resource()->task_list.gnss_receiver_task_handler);
+      "\r\ngnss_receiver_task : waiting as sensor got probed but wi-fi is not connected\r\n");
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
   }
 
   while (1) {
     initial_tick_count = xTaskGetTickCount();
+    sl_supervisor_check_in(SL_SUPERVISOR_CLIENT_GNSS_RECEIVER);
 
     if (SL_SENSOR_CONNECTED
         == sl_get_wifi_asset_tracking_status()->sensor_status.
@@ -748,9 +723,7 @@ void sl_capture_gnss_receiver_data_task()
           xSemaphoreGive(
             sl_get_wifi_asset_tracking_resource()->i2c_mutex_handler);
         }
-#if DEMO_CONFIG_DEBUG_LOGS
-        printf("\r\ngnss_receiver_task : fix type is: %d\r\n", fix_type);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+        SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_GNSS_FIX_TYPE, fix_type);
 
         if (((SL_MAX_M10S_PROTOCOL_UBX == gnss_cfg_data.protocol_type)
              && ((3 == fix_type) || (2 == fix_type)))
@@ -784,10 +757,6 @@ void sl_capture_gnss_receiver_data_task()
                            == gnss_cfg_data.protocol_type) {
                   gnss_reading.gnss_data.latitude /= LAT_LONG_DIVISOR_NMEA;
                 }
-#if DEMO_CONFIG_DEBUG_LOGS
-                printf("\r\ngnss_receiver_task : latitude is : %.7lf\r\n",
-                       gnss_reading.gnss_data.latitude);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
 
                 gnss_reading.gnss_data.longitude =
                   (double)gnss_cfg_data.packetUBXNAVPVT->data.lon;
@@ -798,35 +767,29 @@ void sl_capture_gnss_receiver_data_task()
                            == gnss_cfg_data.protocol_type) {
                   gnss_reading.gnss_data.longitude /= LAT_LONG_DIVISOR_NMEA;
                 }
-#if DEMO_CONFIG_DEBUG_LOGS
-                printf("\r\ngnss_receiver_task : longitude is : %.7lf\r\n",
-                       gnss_reading.gnss_data.longitude);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
 
                 gnss_reading.gnss_data.altitude =
                   (double)gnss_cfg_data.packetUBXNAVPVT->data.hMSL;
-#if DEMO_CONFIG_DEBUG_LOGS
-                printf("\r\ngnss_receiver_task : altitude is : %lf\r\n",
-                       gnss_reading.gnss_data.altitude);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
 
                 gnss_reading.gnss_data.no_of_satellites =
                   (int32_t)gnss_cfg_data.packetUBXNAVPVT->data.numSV;
-#if DEMO_CONFIG_DEBUG_LOGS
-                printf("\r\ngnss_receiver_task : satellite is : %ld\r\n",
-                       gnss_reading.gnss_data.no_of_satellites);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+
+                /// Raw receiver values, floating point is not deferred
+                SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR,
+                             SL_LOG_FMT_GNSS_POSITION,
+                             gnss_cfg_data.packetUBXNAVPVT->data.lat,
+                             gnss_cfg_data.packetUBXNAVPVT->data.lon,
+                             gnss_cfg_data.packetUBXNAVPVT->data.hMSL,
+                             gnss_reading.gnss_data.no_of_satellites);
 
                 gnss_reading.is_sensor_data_available = true;
                 break;
               } else {
                 gnss_max_m10s_delay(GNSS_DATA_TIMEOUT_RETRY_DELAY);
 
-#if DEMO_CONFIG_DEBUG_LOGS
-                printf(
-                  "\r\ngnss_receiver_task : Data is not received, retry-count: %d\r\n",
-                  data_retry_count);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+                SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR,
+                             SL_LOG_FMT_GNSS_DATA_RETRY,
+                             data_retry_count);
                 continue;
               }
             }
@@ -834,8 +797,7 @@ void sl_capture_gnss_receiver_data_task()
         }
 
         if (true == gnss_reading.is_sensor_data_available) {
-          printf(
-            "\r\ngnss_receiver_task : Data is received, break the fix-type retry loop\r\n");
+          SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_GNSS_DATA_RECEIVED);
           break;
         }
 
@@ -847,9 +809,21 @@ void sl_capture_gnss_receiver_data_task()
       if (GNSS_RETRY_COUNT == retry_count) {
         retry_count = 0;
         gnss_reading.is_sensor_data_available = false;
+        sl_metrics_increment(SL_METRIC_SENSOR_READ_FAILURES);
         printf(
           "\r\ngnss_receiver_task : GNSS receiver read failed due to fix type not found, fix_type:%u\n",
           fix_type);
+
+#if DEMO_CONFIG_WIFI_POSITIONING
+        /// Neighbouring access points let the backend locate the device
+        if (SL_WIFI_CONNECTED
+            == sl_get_wifi_asset_tracking_status()->wifi_conn_status) {
+          if (SL_STATUS_OK != sl_json_send_wifi_scan_message()) {
+            printf(
+              "\r\ngnss_receiver_task : Wi-Fi positioning scan is not sent\r\n");
+          }
+        }
+#endif /// < DEMO_CONFIG_WIFI_POSITIONING
         goto taskdelay;
       }
     } else {
@@ -859,11 +833,14 @@ void sl_capture_gnss_receiver_data_task()
 
     /// If failed to fetch time-stamp then discard the packet
     if (SL_STATUS_OK != sl_json_get_timestamp(gnss_reading.time_stamp)) {
-      printf(
-        "\r\ngnss_receiver_task : failed to fetch time-stamp, discarding the packet\r\n");
+      SL_LOG_WARN(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_GNSS_TIMESTAMP_FAILED);
       goto taskdelay;
     }
 
+    /// Sample to publish latency is measured from here
+    gnss_reading.sample_tick = xTaskGetTickCount();
+    sl_sensor_trace_record(&gnss_reading);
+
     /// Acquire sensor data queue mutex and send data to sensor data queue
     if (pdTRUE
         == xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
@@ -873,14 +850,16 @@ void sl_capture_gnss_receiver_data_task()
           == xQueueSend(sl_get_wifi_asset_tracking_resource()->
                         sensor_data_queue_handler,
                         &gnss_reading, 0)) {
+        sl_metrics_increment(SL_METRIC_SENSOR_SAMPLES);
       } else {
+        sl_metrics_increment(SL_METRIC_SENSOR_QUEUE_DROPS);
+
         /// Recieve sensor data as sensor data queue is full
         if (pdTRUE
             == xQueueReceive(sl_get_wifi_asset_tracking_resource()->
                              sensor_data_queue_handler,
                              &gnss_reading, 0)) {
-          printf(
-            "\r\ngnss_receiver_task : received sensor data as sensor data queue is full\r\n");
+          SL_LOG_WARN(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_GNSS_QUEUE_FULL);
           /// again send latest si7021 latest data to sensor data queue
           xQueueSend(
             sl_get_wifi_asset_tracking_resource()->sensor_data_queue_handler,
@@ -889,27 +868,31 @@ void sl_capture_gnss_receiver_data_task()
         }
       }
 
-      printf(
-        "\r\ngnss_receiver_task : gnss receiver data is sent to sensor data queue\r\n");
+      sl_metrics_raise_gauge(SL_METRIC_SENSOR_QUEUE_PEAK,
+                             (int32_t)uxQueueMessagesWaiting(
+                               sl_get_wifi_asset_tracking_resource()->
+                               sensor_data_queue_handler));
+
+      SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_GNSS_QUEUED);
 
       xSemaphoreGive(
         sl_get_wifi_asset_tracking_resource()->sensor_data_queue_mutex_handler);
     }
 
-    /// check whether JSON data converter task is suspended or not
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         json_data_converter_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.json_data_converter_task_handler);
-    }
+    /// Notifications are counted, the wake-up is kept even when the JSON
+    /// task is not waiting yet
+    xTaskNotifyGive(
+      sl_get_wifi_asset_tracking_resource()->task_list.json_data_converter_task_handler);
 
     taskdelay:
 
     later_tick_count = xTaskGetTickCount();
 
-    /// Sampling interval and setting a offset
-    task_delay = pdMS_TO_TICKS(gnss_sampling_interval) * TIMER_CLOCK_OFFSET;
+    /// Sampling interval stretched by publish backpressure and setting a offset
+    task_delay = pdMS_TO_TICKS(sl_rate_limit_scale_interval(
+                                 gnss_sampling_interval,
+                                 MAX_LIMIT_OF_GNSS_RECEIVER_SAMPLING_INTERVAL * 1000))
+                 * TIMER_CLOCK_OFFSET;
 
 #if ENABLE_SAMPLING_JITTER
     processing_diff = (later_tick_count - initial_tick_count)
@@ -936,11 +919,10 @@ void sl_capture_gnss_receiver_data_task()
     UNUSED_VARIABLE(processing_diff);
 #endif /// < ENABLE_SAMPLING_JITTER
 
-#if DEMO_CONFIG_DEBUG_LOGS
-    printf("\r\ngnss_receiver_task : delay is : %ld\r\n", task_delay);
-#endif /// < DEMO_CONFIG_DEBUG_LOGS
+    SL_LOG_DEBUG(SL_LOG_MODULE_SENSOR, SL_LOG_FMT_GNSS_DELAY, task_delay);
 
-    vTaskDelay(task_delay);
+    sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_GNSS_RECEIVER);
+    sl_wake_planner_delay(SL_WAKE_CLIENT_GNSS_RECEIVER, task_delay);
   }
 }
 
@@ -956,30 +938,13 @@ void on_temperature_rh_sensor_timer_callback()
   if (SL_SENSOR_NOT_PROBED
       == sl_get_wifi_asset_tracking_status()->sensor_status.
       temp_rh_sensor_probe_status) {
-    sl_get_wifi_asset_tracking_status()->sensor_status.
-    temp_rh_sensor_probe_status = SL_SENSOR_PROBE_FAILED;
-
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         recovery_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-    }
-  } else if ((SL_SENSOR_CONNECTED
-              == sl_get_wifi_asset_tracking_status()->sensor_status.
-              temp_rh_sensor_probe_status)
-             || (SL_SENSOR_RECONNECTED
-                 == sl_get_wifi_asset_tracking_status()->sensor_status.
-                 temp_rh_sensor_probe_status)) {
-    sl_get_wifi_asset_tracking_status()->sensor_status.
-    temp_rh_sensor_probe_status = SL_SENSOR_DISCONNECTED;
-
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         recovery_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-    }
+    sl_wifi_asset_tracking_set_sensor_status(SL_TEMP_RH_SENSOR,
+                                             SL_SENSOR_PROBE_FAILED);
+  } else if (SL_SENSOR_CONNECTED
+             == sl_get_wifi_asset_tracking_status()->sensor_status.
+             temp_rh_sensor_probe_status) {
+    sl_wifi_asset_tracking_set_sensor_status(SL_TEMP_RH_SENSOR,
+                                             SL_SENSOR_DISCONNECTED);
   }
 }
 
@@ -995,30 +960,13 @@ void on_imu_sensor_timer_callback()
   if (SL_SENSOR_NOT_PROBED
       == sl_get_wifi_asset_tracking_status()->sensor_status.
       imu_sensor_probe_status) {
-    sl_get_wifi_asset_tracking_status()->sensor_status.imu_sensor_probe_status =
-      SL_SENSOR_PROBE_FAILED;
-
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         recovery_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-    }
-  } else if ((SL_SENSOR_CONNECTED
-              == sl_get_wifi_asset_tracking_status()->sensor_status.
-              imu_sensor_probe_status)
-             || (SL_SENSOR_RECONNECTED
-                 == sl_get_wifi_asset_tracking_status()->sensor_status.
-                 imu_sensor_probe_status)) {
-    sl_get_wifi_asset_tracking_status()->sensor_status.imu_sensor_probe_status =
-      SL_SENSOR_DISCONNECTED;
-
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         recovery_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-    }
+    sl_wifi_asset_tracking_set_sensor_status(SL_IMU_SENSOR,
+                                             SL_SENSOR_PROBE_FAILED);
+  } else if (SL_SENSOR_CONNECTED
+             == sl_get_wifi_asset_tracking_status()->sensor_status.
+             imu_sensor_probe_status) {
+    sl_wifi_asset_tracking_set_sensor_status(SL_IMU_SENSOR,
+                                             SL_SENSOR_DISCONNECTED);
   }
 }
 
@@ -1034,29 +982,12 @@ void on_gnss_sensor_timer_callback()
   if (SL_SENSOR_NOT_PROBED
       == sl_get_wifi_asset_tracking_status()->sensor_status.
       gnss_receiver_probe_status) {
-    sl_get_wifi_asset_tracking_status()->sensor_status.
-    gnss_receiver_probe_status = SL_SENSOR_PROBE_FAILED;
-
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         recovery_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-    }
-  } else if ((SL_SENSOR_CONNECTED
-              == sl_get_wifi_asset_tracking_status()->sensor_status.
-              gnss_receiver_probe_status)
-             || (SL_SENSOR_RECONNECTED
-                 == sl_get_wifi_asset_tracking_status()->sensor_status.
-                 gnss_receiver_probe_status)) {
-    sl_get_wifi_asset_tracking_status()->sensor_status.
-    gnss_receiver_probe_status = SL_SENSOR_DISCONNECTED;
-
-    if (eSuspended
-        == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                         recovery_task_handler)) {
-      vTaskResume(
-        sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-    }
+    sl_wifi_asset_tracking_set_sensor_status(SL_GNSS_RECEIVER,
+                                             SL_SENSOR_PROBE_FAILED);
+  } else if (SL_SENSOR_CONNECTED
+             == sl_get_wifi_asset_tracking_status()->sensor_status.
+             gnss_receiver_probe_status) {
+    sl_wifi_asset_tracking_set_sensor_status(SL_GNSS_RECEIVER,
+                                             SL_SENSOR_DISCONNECTED);
   }
 }
@@ -0,0 +1,180 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_sensor_trace.c
+ * @brief Recording of sensor readings as a trace for replay on the host
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_sensor_trace.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+
+_Static_assert(SL_MAX_TYPE == SENSOR_TRACE_TYPE_COUNT,
+               "trace value counts follow the sensor queue data types");
+
+/**************************************************************************/ /**
+ * @brief Function to scale a driver value to a rounded trace value.
+ * @param[in] value : driver value.
+ * @param[in] scale : SENSOR_TRACE_SCALE_* of the value, 1 for raw integers.
+ * @return trace value, saturated to 32 bits.
+ ******************************************************************************/
+static int32_t sl_sensor_trace_scale(double value, double scale);
+
+/******************************************************************************
+ *  Function to convert a sensor reading into a trace record.
+ *****************************************************************************/
+sl_status_t sl_sensor_trace_from_reading(
+  const sl_wifi_asset_tracking_sensor_queue_data_t *reading,
+  sl_sensor_trace_record_t *record)
+{
+  uint8_t axis;
+
+  memset(record, 0, sizeof(*record));
+  if ((0 == sl_sensor_trace_get_value_count((uint8_t)reading->sensor_type))
+      || (SL_STATUS_OK
+          != sl_sensor_trace_parse_time((const char *)reading->time_stamp,
+                                        &record->time_ms))) {
+    return SL_STATUS_FAIL;
+  }
+
+  record->sensor_type = (uint8_t)reading->sensor_type;
+  record->is_available = reading->is_sensor_data_available ? 1 : 0;
+  if (!reading->is_sensor_data_available) {
+    return SL_STATUS_OK;
+  }
+
+  switch (reading->sensor_type) {
+    case SL_TEMP_RH_SENSOR:
+      record->values[0] =
+        sl_sensor_trace_scale(reading->temp_rh_data.temperature,
+                              SENSOR_TRACE_SCALE_TEMP_RH);
+      record->values[1] =
+        sl_sensor_trace_scale(reading->temp_rh_data.relative_humidity,
+                              SENSOR_TRACE_SCALE_TEMP_RH);
+      break;
+
+    case SL_IMU_SENSOR:
+      for (axis = 0; axis < MAX_ACCLEROMETER_VALUES_SIZE; ++axis) {
+        record->values[axis] =
+          sl_sensor_trace_scale(reading->imu_data.accelerometer[axis],
+                                SENSOR_TRACE_SCALE_IMU);
+        record->values[MAX_ACCLEROMETER_VALUES_SIZE + axis] =
+          sl_sensor_trace_scale(reading->imu_data.gyroscope[axis],
+                                SENSOR_TRACE_SCALE_IMU);
+      }
+      break;
+
+    default:
+      record->values[0] = sl_sensor_trace_scale(reading->gnss_data.latitude,
+                                                SENSOR_TRACE_SCALE_POSITION);
+      record->values[1] = sl_sensor_trace_scale(reading->gnss_data.longitude,
+                                                SENSOR_TRACE_SCALE_POSITION);
+      record->values[2] = sl_sensor_trace_scale(reading->gnss_data.altitude, 1);
+      record->values[3] = reading->gnss_data.no_of_satellites;
+      break;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to convert a trace record back into a sensor reading.
+ *****************************************************************************/
+sl_status_t sl_sensor_trace_to_reading(
+  const sl_sensor_trace_record_t *record,
+  sl_wifi_asset_tracking_sensor_queue_data_t *reading)
+{
+  uint8_t axis;
+
+  memset(reading, 0, sizeof(*reading));
+  if ((0 == sl_sensor_trace_get_value_count(record->sensor_type))
+      || (SL_STATUS_OK
+          != sl_sensor_trace_format_time(record->time_ms,
+                                         (char *)reading->time_stamp,
+                                         sizeof(reading->time_stamp)))) {
+    return SL_STATUS_FAIL;
+  }
+
+  reading->sensor_type =
+    (sl_wifi_asset_tracking_sensor_queue_data_type_e)record->sensor_type;
+  reading->is_sensor_data_available = (0 != record->is_available);
+
+  switch (reading->sensor_type) {
+    case SL_TEMP_RH_SENSOR:
+      strcpy((char *)reading->temp_rh_data.temperature_unit,
+             TEMPERATURE_UNIT_STRING);
+      reading->temp_rh_data.temperature =
+        (double)record->values[0] / SENSOR_TRACE_SCALE_TEMP_RH;
+      reading->temp_rh_data.relative_humidity =
+        (double)record->values[1] / SENSOR_TRACE_SCALE_TEMP_RH;
+      break;
+
+    case SL_IMU_SENSOR:
+      for (axis = 0; axis < MAX_ACCLEROMETER_VALUES_SIZE; ++axis) {
+        reading->imu_data.accelerometer[axis] =
+          (double)record->values[axis] / SENSOR_TRACE_SCALE_IMU;
+        reading->imu_data.gyroscope[axis] =
+          (double)record->values[MAX_ACCLEROMETER_VALUES_SIZE + axis]
+          / SENSOR_TRACE_SCALE_IMU;
+      }
+      break;
+
+    default:
+      reading->gnss_data.latitude =
+        (double)record->values[0] / SENSOR_TRACE_SCALE_POSITION;
+      reading->gnss_data.longitude =
+        (double)record->values[1] / SENSOR_TRACE_SCALE_POSITION;
+      reading->gnss_data.altitude = (double)record->values[2];
+      reading->gnss_data.no_of_satellites = record->values[3];
+      break;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to print a reading as a trace console line.
+ *****************************************************************************/
+void sl_sensor_trace_record(
+  const sl_wifi_asset_tracking_sensor_queue_data_t *reading)
+{
+#if DEMO_CONFIG_SENSOR_TRACE_OUTPUT
+  sl_sensor_trace_record_t record;
+  char frame[SENSOR_TRACE_FRAME_MAX_SIZE];
+
+  if ((SL_STATUS_OK == sl_sensor_trace_from_reading(reading, &record))
+      && (SL_STATUS_OK
+          == sl_sensor_trace_encode_frame(&record, frame, sizeof(frame)))) {
+    printf("\r\n%s\r\n", frame);
+  }
+#else
+  (void)reading;
+#endif /// < DEMO_CONFIG_SENSOR_TRACE_OUTPUT
+}
+
+/******************************************************************************
+ *  Function to scale a driver value to a rounded trace value.
+ *****************************************************************************/
+static int32_t sl_sensor_trace_scale(double value, double scale)
+{
+  double scaled = value * scale;
+
+  if (scaled >= (double)INT32_MAX) {
+    return INT32_MAX;
+  }
+  if (scaled <= (double)INT32_MIN) {
+    return INT32_MIN;
+  }
+
+  return (int32_t)((scaled >= 0) ? (scaled + 0.5) : (scaled - 0.5));
+}
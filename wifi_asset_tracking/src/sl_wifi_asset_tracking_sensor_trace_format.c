@@ -0,0 +1,434 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_sensor_trace_format.c
+ * @brief Record encoding of sensor traces for record and replay
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_sensor_trace_format.h>
+
+/*******************************************************************************
+ ***************************  Defines / Macros  ********************************
+ ******************************************************************************/
+#define SENSOR_TRACE_EPOCH_YEAR              2000   ///< Year of time 0
+#define SENSOR_TRACE_MAX_YEAR                9999   ///< Last year with four digits
+#define SENSOR_TRACE_MS_PER_DAY              86400000ULL ///< Milliseconds of a day
+
+/// Values per sensor type, in sl_wifi_asset_tracking_sensor_queue_data_type_e
+/// order, the invalid type first
+static const uint8_t sl_sensor_trace_value_counts[SENSOR_TRACE_TYPE_COUNT] = {
+  0,
+  2,
+  6,
+  4
+};
+
+/// Days of each month in a common year
+static const uint8_t sl_sensor_trace_month_days[12] = {
+  31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+/**************************************************************************/ /**
+ * @brief Function to append a varint.
+ * @param[in] value : value.
+ * @param[out] buffer : encoded value.
+ * @param[in] buffer_size : bytes available in buffer.
+ * @return bytes written, 0 when buffer is too small.
+ ******************************************************************************/
+static size_t sl_sensor_trace_put_varint(uint64_t value,
+                                         uint8_t *buffer,
+                                         size_t buffer_size);
+
+/**************************************************************************/ /**
+ * @brief Function to read a varint.
+ * @param[in] buffer : encoded value.
+ * @param[in] buffer_size : bytes available in buffer.
+ * @param[out] value : value.
+ * @return bytes read, 0 when the varint is truncated or too long.
+ ******************************************************************************/
+static size_t sl_sensor_trace_get_varint(const uint8_t *buffer,
+                                         size_t buffer_size,
+                                         uint64_t *value);
+
+/**************************************************************************/ /**
+ * @brief Function to get the days of a month.
+ * @param[in] year : year.
+ * @param[in] month : month, 1 to 12.
+ * @return days of the month.
+ ******************************************************************************/
+static uint32_t sl_sensor_trace_days_of_month(uint32_t year, uint32_t month);
+
+/**************************************************************************/ /**
+ * @brief Function to get the value of a hex digit.
+ * @param[in] digit : character.
+ * @return value, -1 when digit is not a hex digit.
+ ******************************************************************************/
+static int sl_sensor_trace_hex_value(char digit);
+
+/******************************************************************************
+ *  Function to get the number of values of a sensor type.
+ *****************************************************************************/
+uint8_t sl_sensor_trace_get_value_count(uint8_t sensor_type)
+{
+  if (sensor_type >= SENSOR_TRACE_TYPE_COUNT) {
+    return 0;
+  }
+
+  return sl_sensor_trace_value_counts[sensor_type];
+}
+
+/******************************************************************************
+ *  Function to encode a record.
+ *****************************************************************************/
+sl_status_t sl_sensor_trace_encode(const sl_sensor_trace_record_t *record,
+                                   uint8_t *buffer,
+                                   size_t buffer_size,
+                                   size_t *length)
+{
+  uint8_t value_count = sl_sensor_trace_get_value_count(record->sensor_type);
+  uint32_t zigzag;
+  size_t written;
+  size_t used;
+  uint8_t index;
+
+  if ((0 == value_count) || (0 == buffer_size)) {
+    return SL_STATUS_FAIL;
+  }
+
+  buffer[0] = (uint8_t)((record->sensor_type << 4)
+                        | (record->is_available ? 1 : 0));
+  used = 1;
+
+  written = sl_sensor_trace_put_varint(record->time_ms,
+                                       &buffer[used],
+                                       buffer_size - used);
+  if (0 == written) {
+    return SL_STATUS_FAIL;
+  }
+  used += written;
+
+  /// A failed read carries no values
+  if (!record->is_available) {
+    value_count = 0;
+  }
+
+  for (index = 0; index < value_count; ++index) {
+    /// Zigzag keeps small negative values short
+    zigzag = ((uint32_t)record->values[index] << 1)
+             ^ (uint32_t)(record->values[index] >> 31);
+    written = sl_sensor_trace_put_varint(zigzag,
+                                         &buffer[used],
+                                         buffer_size - used);
+    if (0 == written) {
+      return SL_STATUS_FAIL;
+    }
+    used += written;
+  }
+
+  *length = used;
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to decode one record written by sl_sensor_trace_encode.
+ *****************************************************************************/
+sl_status_t sl_sensor_trace_decode(const uint8_t *buffer,
+                                   size_t buffer_size,
+                                   sl_sensor_trace_record_t *record,
+                                   size_t *length)
+{
+  uint8_t value_count;
+  uint64_t value;
+  size_t read;
+  size_t used;
+  uint8_t index;
+
+  if ((0 == buffer_size) || (0 != (buffer[0] & 0x0E))) {
+    return SL_STATUS_FAIL;
+  }
+
+  memset(record, 0, sizeof(*record));
+  record->sensor_type = (uint8_t)(buffer[0] >> 4);
+  record->is_available = (uint8_t)(buffer[0] & 0x01);
+  value_count = sl_sensor_trace_get_value_count(record->sensor_type);
+  if (0 == value_count) {
+    return SL_STATUS_FAIL;
+  }
+  used = 1;
+
+  read = sl_sensor_trace_get_varint(&buffer[used],
+                                    buffer_size - used,
+                                    &record->time_ms);
+  if (0 == read) {
+    return SL_STATUS_FAIL;
+  }
+  used += read;
+
+  if (!record->is_available) {
+    value_count = 0;
+  }
+
+  for (index = 0; index < value_count; ++index) {
+    read = sl_sensor_trace_get_varint(&buffer[used],
+                                      buffer_size - used,
+                                      &value);
+    if ((0 == read) || (value > UINT32_MAX)) {
+      return SL_STATUS_FAIL;
+    }
+    used += read;
+    record->values[index] = (int32_t)((uint32_t)(value >> 1)
+                                      ^ (0U - (uint32_t)(value & 1)));
+  }
+
+  *length = used;
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to encode a record as a console line.
+ *****************************************************************************/
+sl_status_t sl_sensor_trace_encode_frame(const sl_sensor_trace_record_t *record,
+                                         char *frame,
+                                         size_t frame_size)
+{
+  static const char hex_digits[] = "0123456789ABCDEF";
+  uint8_t binary[SENSOR_TRACE_RECORD_MAX_SIZE];
+  size_t binary_len;
+  size_t frame_len;
+  size_t index;
+
+  if ((frame_size < SENSOR_TRACE_FRAME_MAX_SIZE)
+      || (SL_STATUS_OK != sl_sensor_trace_encode(record,
+                                                 binary,
+                                                 sizeof(binary),
+                                                 &binary_len))) {
+    return SL_STATUS_FAIL;
+  }
+
+  memcpy(frame, SENSOR_TRACE_FRAME_MARKER, strlen(SENSOR_TRACE_FRAME_MARKER));
+  frame_len = strlen(SENSOR_TRACE_FRAME_MARKER);
+  for (index = 0; index < binary_len; ++index) {
+    frame[frame_len++] = hex_digits[binary[index] >> 4];
+    frame[frame_len++] = hex_digits[binary[index] & 0x0F];
+  }
+  frame[frame_len] = '\0';
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to decode a console line written by sl_sensor_trace_encode_frame.
+ *****************************************************************************/
+sl_status_t sl_sensor_trace_decode_frame(const char *frame,
+                                         sl_sensor_trace_record_t *record)
+{
+  uint8_t binary[SENSOR_TRACE_RECORD_MAX_SIZE];
+  size_t binary_len = 0;
+  size_t marker_len = strlen(SENSOR_TRACE_FRAME_MARKER);
+  size_t record_len;
+  int high;
+  int low;
+
+  if (0 != strncmp(frame, SENSOR_TRACE_FRAME_MARKER, marker_len)) {
+    return SL_STATUS_FAIL;
+  }
+  frame += marker_len;
+
+  while (('\0' != frame[0]) && ('\r' != frame[0]) && ('\n' != frame[0])) {
+    high = sl_sensor_trace_hex_value(frame[0]);
+    low = sl_sensor_trace_hex_value(frame[1]);
+    if ((high < 0) || (low < 0) || (binary_len >= sizeof(binary))) {
+      return SL_STATUS_FAIL;
+    }
+    binary[binary_len++] = (uint8_t)((high << 4) | low);
+    frame += 2;
+  }
+
+  /// The whole line is one record
+  if ((SL_STATUS_OK != sl_sensor_trace_decode(binary,
+                                              binary_len,
+                                              record,
+                                              &record_len))
+      || (record_len != binary_len)) {
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to convert a JSON time-stamp into ms since 2000.
+ *****************************************************************************/
+sl_status_t sl_sensor_trace_parse_time(const char *timestamp,
+                                       uint64_t *time_ms)
+{
+  unsigned int year;
+  unsigned int month;
+  unsigned int day;
+  unsigned int hour;
+  unsigned int minute;
+  unsigned int second;
+  unsigned int millisecond;
+  uint64_t days = 0;
+  uint32_t index;
+
+  if ((7 != sscanf(timestamp,
+                   "%4u-%2u-%2uT%2u:%2u:%2u.%3uZ",
+                   &year,
+                   &month,
+                   &day,
+                   &hour,
+                   &minute,
+                   &second,
+                   &millisecond))
+      || (year < SENSOR_TRACE_EPOCH_YEAR)
+      || (month < 1) || (month > 12)
+      || (day < 1) || (day > sl_sensor_trace_days_of_month(year, month))
+      || (hour > 23) || (minute > 59) || (second > 59)) {
+    return SL_STATUS_FAIL;
+  }
+
+  /// February and the other eleven months make the year
+  for (index = SENSOR_TRACE_EPOCH_YEAR; index < year; ++index) {
+    days += sl_sensor_trace_days_of_month(index, 2) + 337;
+  }
+  for (index = 1; index < month; ++index) {
+    days += sl_sensor_trace_days_of_month(year, index);
+  }
+  days += day - 1;
+
+  *time_ms = (days * SENSOR_TRACE_MS_PER_DAY)
+             + ((((uint64_t)hour * 60 + minute) * 60 + second) * 1000)
+             + millisecond;
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to convert ms since 2000 into the JSON time-stamp layout.
+ *****************************************************************************/
+sl_status_t sl_sensor_trace_format_time(uint64_t time_ms,
+                                        char *timestamp,
+                                        size_t timestamp_size)
+{
+  uint64_t days = time_ms / SENSOR_TRACE_MS_PER_DAY;
+  uint32_t day_ms = (uint32_t)(time_ms % SENSOR_TRACE_MS_PER_DAY);
+  uint32_t year = SENSOR_TRACE_EPOCH_YEAR;
+  uint32_t month = 1;
+  uint32_t year_days;
+
+  if (timestamp_size < SENSOR_TRACE_TIME_SIZE) {
+    return SL_STATUS_FAIL;
+  }
+
+  while (days >= (year_days = sl_sensor_trace_days_of_month(year, 2) + 337)) {
+    days -= year_days;
+    if (++year > SENSOR_TRACE_MAX_YEAR) {
+      return SL_STATUS_FAIL;
+    }
+  }
+  while (days >= sl_sensor_trace_days_of_month(year, month)) {
+    days -= sl_sensor_trace_days_of_month(year, month);
+    month++;
+  }
+
+  snprintf(timestamp,
+           timestamp_size,
+           "%04u-%02u-%02uT%02u:%02u:%02u.%03uZ",
+           (unsigned int)year,
+           (unsigned int)month,
+           (unsigned int)(days + 1),
+           (unsigned int)(day_ms / 3600000),
+           (unsigned int)((day_ms / 60000) % 60),
+           (unsigned int)((day_ms / 1000) % 60),
+           (unsigned int)(day_ms % 1000));
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to append a varint.
+ *****************************************************************************/
+static size_t sl_sensor_trace_put_varint(uint64_t value,
+                                         uint8_t *buffer,
+                                         size_t buffer_size)
+{
+  size_t used = 0;
+
+  do {
+    if (used == buffer_size) {
+      return 0;
+    }
+    buffer[used++] = (uint8_t)((value & 0x7F) | ((value > 0x7F) ? 0x80 : 0));
+    value >>= 7;
+  } while (0 != value);
+
+  return used;
+}
+
+/******************************************************************************
+ *  Function to read a varint.
+ *****************************************************************************/
+static size_t sl_sensor_trace_get_varint(const uint8_t *buffer,
+                                         size_t buffer_size,
+                                         uint64_t *value)
+{
+  size_t used = 0;
+  uint8_t shift = 0;
+
+  *value = 0;
+  while ((used < buffer_size) && (shift < 64)) {
+    *value |= (uint64_t)(buffer[used] & 0x7F) << shift;
+    if (0 == (buffer[used++] & 0x80)) {
+      return used;
+    }
+    shift += 7;
+  }
+
+  return 0;
+}
+
+/******************************************************************************
+ *  Function to get the days of a month.
+ *****************************************************************************/
+static uint32_t sl_sensor_trace_days_of_month(uint32_t year, uint32_t month)
+{
+  bool is_leap = ((0 == (year % 4)) && (0 != (year % 100)))
+                 || (0 == (year % 400));
+
+  if ((2 == month) && is_leap) {
+    return 29;
+  }
+
+  return sl_sensor_trace_month_days[month - 1];
+}
+
+/******************************************************************************
+ *  Function to get the value of a hex digit.
+ *****************************************************************************/
+static int sl_sensor_trace_hex_value(char digit)
+{
+  if ((digit >= '0') && (digit <= '9')) {
+    return digit - '0';
+  }
+  if ((digit >= 'A') && (digit <= 'F')) {
+    return digit - 'A' + 10;
+  }
+  if ((digit >= 'a') && (digit <= 'f')) {
+    return digit - 'a' + 10;
+  }
+
+  return -1;
+}
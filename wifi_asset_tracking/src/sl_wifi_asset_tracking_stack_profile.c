@@ -0,0 +1,215 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_stack_profile.c
+ * @brief Stack high-water profiling and stack size recommendation
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <nvm3_default.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_stack_profile.h>
+
+/// @brief Structure for stack profile state
+typedef struct {
+  sl_stack_profile_nvm3_record_t record;  ///< Peaks of this and previous boots
+  bool is_changed;                        ///< A peak rose since last persist
+  bool is_persistent;                     ///< NVM3 is usable
+} sl_stack_profile_t;
+
+/// Stack profile state, peaks are updated in critical sections as the
+/// metrics and recovery tasks both sample
+static sl_stack_profile_t sl_stack_profile;
+
+/// Stack size macro of every task, in sl_static_task_e order
+static const char *const sl_stack_profile_macros[SL_STATIC_TASK_COUNT] = {
+  "STACK_SIZE_TEMPERATURE_RH_SENSOR_TASK",
+  "STACK_SIZE_IMU_SENSOR_TASK",
+  "STACK_SIZE_GNSS_RECEIVER_TASK",
+  "STACK_SIZE_WIFI_DATA_CAPTURE_TASK",
+  "STACK_SIZE_JSON_DATA_CONVERTER_TASK",
+  "STACK_SIZE_CLOUD_COMMUNICATION_TASK",
+  "STACK_SIZE_RECOVERY_TASK",
+  "STACK_SIZE_LCD_TASK",
+  "STACK_SIZE_LINK_MONITOR_TASK",
+  "STACK_SIZE_CLOCK_TASK",
+  "STACK_SIZE_METRICS_TASK",
+  "STACK_SIZE_LOG_TASK",
+  "STACK_SIZE_SUPERVISOR_TASK"
+};
+
+/**************************************************************************/ /**
+ * @brief Write the peaks to NVM3.
+ ******************************************************************************/
+static void sl_stack_profile_persist(void);
+
+/******************************************************************************
+ *  Function to restore peaks of previous boots and count this boot.
+ *****************************************************************************/
+sl_status_t sl_stack_profile_init(void)
+{
+  sl_stack_profile_nvm3_record_t record;
+  uint32_t object_type;
+  size_t object_size;
+
+  memset(&sl_stack_profile, 0, sizeof(sl_stack_profile));
+  sl_stack_profile.record.magic = STACK_PROFILE_NVM3_MAGIC;
+
+  if (ECODE_NVM3_OK != nvm3_initDefault()) {
+    printf("\r\nsl_stack_profile_init : NVM3 initialization failed\r\n");
+    return SL_STATUS_FAIL;
+  }
+  sl_stack_profile.is_persistent = true;
+
+  /// Nothing persisted yet or layout changed, start from zero
+  if ((ECODE_NVM3_OK
+       == nvm3_getObjectInfo(nvm3_defaultHandle,
+                             STACK_PROFILE_NVM3_KEY,
+                             &object_type,
+                             &object_size))
+      && (sizeof(record) == object_size)
+      && (ECODE_NVM3_OK
+          == nvm3_readData(nvm3_defaultHandle,
+                           STACK_PROFILE_NVM3_KEY,
+                           &record,
+                           sizeof(record)))
+      && (STACK_PROFILE_NVM3_MAGIC == record.magic)) {
+    memcpy(&sl_stack_profile.record, &record, sizeof(record));
+  }
+
+  sl_stack_profile.record.boots++;
+  sl_stack_profile_persist();
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to sample every running task and persist raised peaks.
+ *****************************************************************************/
+void sl_stack_profile_sample(void)
+{
+  uint8_t index;
+
+  for (index = 0; index < SL_STATIC_TASK_COUNT; index++) {
+    sl_stack_profile_sample_task((sl_static_task_e)index);
+  }
+
+  if (sl_stack_profile.is_changed) {
+    sl_stack_profile_persist();
+  }
+}
+
+/******************************************************************************
+ *  Function to sample one task.
+ *****************************************************************************/
+void sl_stack_profile_sample_task(sl_static_task_e task)
+{
+  TaskHandle_t handle = sl_static_get_task_handle(task);
+  uint32_t stack_size = sl_static_get_task_stack_size(task);
+  uint32_t used;
+
+  if (NULL == handle) {
+    return;
+  }
+
+  /// High-water mark is the least free stack in words since task creation
+  used = stack_size - (uint32_t)uxTaskGetStackHighWaterMark(handle);
+
+  taskENTER_CRITICAL();
+  if (used > sl_stack_profile.record.peak[task]) {
+    sl_stack_profile.record.peak[task] = (uint16_t)used;
+    sl_stack_profile.is_changed = true;
+  }
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to get the recommended stack depth for a measured peak.
+ *****************************************************************************/
+uint32_t sl_stack_profile_recommend(uint32_t peak, uint32_t stack_size)
+{
+  uint32_t margin;
+
+  if (0 == peak) {
+    return stack_size;
+  }
+
+  margin = (peak * STACK_PROFILE_MARGIN_PERCENT) / 100;
+  if (margin < STACK_PROFILE_MIN_MARGIN) {
+    margin = STACK_PROFILE_MIN_MARGIN;
+  }
+
+  return ((peak + margin + STACK_PROFILE_ALIGNMENT - 1)
+          / STACK_PROFILE_ALIGNMENT) * STACK_PROFILE_ALIGNMENT;
+}
+
+/******************************************************************************
+ *  Function to print peak, current and recommended stack depth per task.
+ *****************************************************************************/
+void sl_stack_profile_report(void)
+{
+  uint32_t stack_size;
+  uint32_t recommended;
+  uint32_t total_size = 0;
+  uint32_t total_recommended = 0;
+  uint8_t index;
+
+  printf("\r\nstack_profile : boots %lu, margin %d %%, min margin %d words\r\n",
+         (unsigned long)sl_stack_profile.record.boots,
+         STACK_PROFILE_MARGIN_PERCENT,
+         STACK_PROFILE_MIN_MARGIN);
+
+  for (index = 0; index < SL_STATIC_TASK_COUNT; index++) {
+    stack_size = sl_static_get_task_stack_size((sl_static_task_e)index);
+    recommended =
+      sl_stack_profile_recommend(sl_stack_profile.record.peak[index],
+                                 stack_size);
+    total_size += stack_size;
+    total_recommended += recommended;
+
+    printf("\r\nstack_profile : %s peak %u size %lu recommended %lu\r\n",
+           sl_stack_profile_macros[index],
+           sl_stack_profile.record.peak[index],
+           (unsigned long)stack_size,
+           (unsigned long)recommended);
+  }
+
+  printf("\r\nstack_profile : total %lu words, recommended %lu words\r\n",
+         (unsigned long)total_size,
+         (unsigned long)total_recommended);
+}
+
+/******************************************************************************
+ *  Write the peaks to NVM3.
+ *****************************************************************************/
+static void sl_stack_profile_persist(void)
+{
+  sl_stack_profile_nvm3_record_t record;
+
+  if (!sl_stack_profile.is_persistent) {
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  memcpy(&record, &sl_stack_profile.record, sizeof(record));
+  sl_stack_profile.is_changed = false;
+  taskEXIT_CRITICAL();
+
+  if (ECODE_NVM3_OK
+      != nvm3_writeData(nvm3_defaultHandle,
+                        STACK_PROFILE_NVM3_KEY,
+                        &record,
+                        sizeof(record))) {
+    printf("\r\nsl_stack_profile_persist : failed to persist stack peaks\r\n");
+  }
+}
@@ -0,0 +1,432 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_static_alloc.c
+ * @brief Static allocation of application tasks, queues, semaphores and timers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_static_alloc.h>
+
+#if DEMO_CONFIG_STATIC_ALLOCATION
+#if (1 != configSUPPORT_STATIC_ALLOCATION)
+#error "DEMO_CONFIG_STATIC_ALLOCATION needs configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+/// @brief Structure for every statically allocated kernel object of the
+/// application. Sizes are compile time constants, so its size is the RAM
+/// taken by the application tasks and queues.
+typedef struct {
+  StackType_t temperature_rh_sensor_stack[STACK_SIZE_TEMPERATURE_RH_SENSOR_TASK]; ///< Temperature and RH sensor task stack
+  StackType_t imu_sensor_stack[STACK_SIZE_IMU_SENSOR_TASK];                       ///< IMU sensor task stack
+  StackType_t gnss_receiver_stack[STACK_SIZE_GNSS_RECEIVER_TASK];                 ///< GNSS receiver task stack
+  StackType_t wifi_data_capture_stack[STACK_SIZE_WIFI_DATA_CAPTURE_TASK];         ///< Wi-Fi data capture task stack
+  StackType_t json_data_converter_stack[STACK_SIZE_JSON_DATA_CONVERTER_TASK];     ///< JSON data converter task stack
+  StackType_t cloud_communication_stack[STACK_SIZE_CLOUD_COMMUNICATION_TASK];     ///< Cloud communication task stack
+  StackType_t recovery_stack[STACK_SIZE_RECOVERY_TASK];                           ///< Recovery task stack
+  StackType_t lcd_stack[STACK_SIZE_LCD_TASK];                                     ///< LCD task stack
+  StackType_t link_monitor_stack[STACK_SIZE_LINK_MONITOR_TASK];                   ///< Link monitor task stack
+  StackType_t clock_stack[STACK_SIZE_CLOCK_TASK];                                 ///< Clock discipline task stack
+  StackType_t metrics_stack[STACK_SIZE_METRICS_TASK];                             ///< Metrics report task stack
+  StackType_t log_stack[STACK_SIZE_LOG_TASK];                                     ///< Deferred log task stack
+  StackType_t supervisor_stack[STACK_SIZE_SUPERVISOR_TASK];                       ///< Task supervisor stack
+  StaticTask_t task[SL_STATIC_TASK_COUNT];                                        ///< Task control blocks
+  uint8_t sensor_data_storage[MAX_SIZE_OF_SENSOR_DATA_QUEUE
+                              * sizeof(sl_wifi_asset_tracking_sensor_queue_data_t)];       ///< Sensor data queue items
+  uint8_t lcd_data_storage[MAX_SIZE_OF_LCD_DATA_QUEUE
+                           * sizeof(sl_wifi_asset_tracking_lcd_queue_data_t)];             ///< LCD data queue items
+  uint8_t lane_critical_storage[PUBLISH_LANE_CRITICAL_CAPACITY
+                                * sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t)]; ///< Critical lane items
+  uint8_t lane_normal_storage[PUBLISH_LANE_NORMAL_CAPACITY
+                              * sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t)];   ///< Normal lane items
+  uint8_t lane_bulk_storage[PUBLISH_LANE_BULK_CAPACITY
+                            * sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t)];     ///< Bulk lane items
+  StaticQueue_t queue[SL_STATIC_QUEUE_COUNT];                                     ///< Queue control blocks
+  StaticSemaphore_t semaphore[SL_STATIC_SEMAPHORE_COUNT];                         ///< Semaphore control blocks
+  StaticTimer_t timer[SL_STATIC_TIMER_COUNT];                                     ///< Timer control blocks
+  bool is_task_created[SL_STATIC_TASK_COUNT];                                     ///< Control block was handed to a task before
+} sl_static_alloc_t;
+
+_Static_assert(sizeof(sl_static_alloc_t) <= STATIC_ALLOC_RAM_BUDGET,
+               "static kernel objects exceed STATIC_ALLOC_RAM_BUDGET");
+
+/// Statically allocated kernel objects
+static sl_static_alloc_t sl_static_alloc;
+
+#define STATIC_ALLOC_STACK(member)           (sl_static_alloc.member)  ///< Stack of a task
+#define STATIC_ALLOC_STORAGE(member)         (sl_static_alloc.member)  ///< Item storage of a queue
+#else
+#define STATIC_ALLOC_STACK(member)           (NULL)                    ///< Stack is taken from heap
+#define STATIC_ALLOC_STORAGE(member)         (NULL)                    ///< Item storage is taken from heap
+#endif /// < DEMO_CONFIG_STATIC_ALLOCATION
+
+_Static_assert((SL_STATIC_QUEUE_LANE_CRITICAL + SL_PUBLISH_LANE_COUNT)
+               == SL_STATIC_QUEUE_COUNT,
+               "a queue is needed for every publish lane");
+
+/// @brief Structure for compile time configuration of a task
+typedef struct {
+  TaskFunction_t function;          ///< Task function
+  const char *name;                 ///< Task name
+  uint32_t stack_size;              ///< In words, stack depth
+  UBaseType_t priority;             ///< Task priority
+  StackType_t *stack;               ///< Static stack, NULL without static allocation
+  sl_static_subsystem_e subsystem;  ///< Subsystem of RAM report
+} sl_static_task_config_t;
+
+/// @brief Structure for compile time configuration of a queue
+typedef struct {
+  UBaseType_t length;               ///< Items held by the queue
+  UBaseType_t item_size;            ///< In bytes, size of one item
+  uint8_t *storage;                 ///< Static item storage, NULL without static allocation
+  sl_static_subsystem_e subsystem;  ///< Subsystem of RAM report
+} sl_static_queue_config_t;
+
+/// @brief Structure for compile time configuration of a semaphore
+typedef struct {
+  bool is_binary;                   ///< Binary semaphore instead of mutex
+  sl_static_subsystem_e subsystem;  ///< Subsystem of RAM report
+} sl_static_semaphore_config_t;
+
+/// @brief Structure for compile time configuration of a timer
+typedef struct {
+  const char *name;                       ///< Timer name
+  uint32_t period;                        ///< In ms, timer period
+  UBaseType_t auto_reload;                ///< pdTRUE for a periodic timer
+  TimerCallbackFunction_t callback;       ///< Timer callback
+  sl_static_subsystem_e subsystem;        ///< Subsystem of RAM report
+} sl_static_timer_config_t;
+
+static const sl_static_task_config_t sl_static_task_config[SL_STATIC_TASK_COUNT] = {
+  { sl_capture_temperature_rh_sensor_data_task, NAME_TEMPERATURE_RH_SENSOR_TASK,
+    STACK_SIZE_TEMPERATURE_RH_SENSOR_TASK, PRIORITY_TEMPERATURE_RH_SENSOR_TASK,
+    STATIC_ALLOC_STACK(temperature_rh_sensor_stack), SL_STATIC_SUBSYSTEM_SENSOR },
+  { sl_capture_imu_sensor_data_task, NAME_IMU_SENSOR_TASK,
+    STACK_SIZE_IMU_SENSOR_TASK, PRIORITY_IMU_SENSOR_TASK,
+    STATIC_ALLOC_STACK(imu_sensor_stack), SL_STATIC_SUBSYSTEM_SENSOR },
+  { sl_capture_gnss_receiver_data_task, NAME_GNSS_RECEIVER_TASK,
+    STACK_SIZE_GNSS_RECEIVER_TASK, PRIORITY_GNSS_RECEIVER_TASK,
+    STATIC_ALLOC_STACK(gnss_receiver_stack), SL_STATIC_SUBSYSTEM_SENSOR },
+  { sl_capture_wifi_data_task, NAME_WIFI_DATA_CAPTURE_TASK,
+    STACK_SIZE_WIFI_DATA_CAPTURE_TASK, PRIORITY_WIFI_DATA_CAPTURE_TASK,
+    STATIC_ALLOC_STACK(wifi_data_capture_stack), SL_STATIC_SUBSYSTEM_WIFI },
+  { sl_json_data_converter_task, NAME_JSON_DATA_CONVERTER_TASK,
+    STACK_SIZE_JSON_DATA_CONVERTER_TASK, PRIORITY_JSON_DATA_CONVERTER_TASK,
+    STATIC_ALLOC_STACK(json_data_converter_stack), SL_STATIC_SUBSYSTEM_JSON },
+  { sl_azure_cloud_communication_task, NAME_CLOUD_COMMUNICATION_TASK,
+    STACK_SIZE_CLOUD_COMMUNICATION_TASK, PRIORITY_CLOUD_COMMUNICATION_TASK,
+    STATIC_ALLOC_STACK(cloud_communication_stack), SL_STATIC_SUBSYSTEM_CLOUD },
+  { sl_wifi_asset_tracking_recovery_task, NAME_RECOVERY_TASK,
+    STACK_SIZE_RECOVERY_TASK, PRIORITY_RECOVERY_TASK,
+    STATIC_ALLOC_STACK(recovery_stack), SL_STATIC_SUBSYSTEM_SYSTEM },
+  { sl_wifi_asset_tracking_lcd_task, NAME_LCD_TASK,
+    STACK_SIZE_LCD_TASK, PRIORITY_LCD_TASK,
+    STATIC_ALLOC_STACK(lcd_stack), SL_STATIC_SUBSYSTEM_LCD },
+  { sl_link_monitor_task, NAME_LINK_MONITOR_TASK,
+    STACK_SIZE_LINK_MONITOR_TASK, PRIORITY_LINK_MONITOR_TASK,
+    STATIC_ALLOC_STACK(link_monitor_stack), SL_STATIC_SUBSYSTEM_WIFI },
+  { sl_clock_task, NAME_CLOCK_TASK,
+    STACK_SIZE_CLOCK_TASK, PRIORITY_CLOCK_TASK,
+    STATIC_ALLOC_STACK(clock_stack), SL_STATIC_SUBSYSTEM_SYSTEM },
+  { sl_metrics_task, NAME_METRICS_TASK,
+    STACK_SIZE_METRICS_TASK, PRIORITY_METRICS_TASK,
+    STATIC_ALLOC_STACK(metrics_stack), SL_STATIC_SUBSYSTEM_SYSTEM },
+  { sl_log_task, NAME_LOG_TASK,
+    STACK_SIZE_LOG_TASK, PRIORITY_LOG_TASK,
+    STATIC_ALLOC_STACK(log_stack), SL_STATIC_SUBSYSTEM_SYSTEM },
+  { sl_supervisor_task, NAME_SUPERVISOR_TASK,
+    STACK_SIZE_SUPERVISOR_TASK, PRIORITY_SUPERVISOR_TASK,
+    STATIC_ALLOC_STACK(supervisor_stack), SL_STATIC_SUBSYSTEM_SYSTEM }
+};
+
+static const sl_static_queue_config_t sl_static_queue_config[SL_STATIC_QUEUE_COUNT] = {
+  { MAX_SIZE_OF_SENSOR_DATA_QUEUE, sizeof(sl_wifi_asset_tracking_sensor_queue_data_t),
+    STATIC_ALLOC_STORAGE(sensor_data_storage), SL_STATIC_SUBSYSTEM_SENSOR },
+  { MAX_SIZE_OF_LCD_DATA_QUEUE, sizeof(sl_wifi_asset_tracking_lcd_queue_data_t),
+    STATIC_ALLOC_STORAGE(lcd_data_storage), SL_STATIC_SUBSYSTEM_LCD },
+  { PUBLISH_LANE_CRITICAL_CAPACITY, sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t),
+    STATIC_ALLOC_STORAGE(lane_critical_storage), SL_STATIC_SUBSYSTEM_CLOUD },
+  { PUBLISH_LANE_NORMAL_CAPACITY, sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t),
+    STATIC_ALLOC_STORAGE(lane_normal_storage), SL_STATIC_SUBSYSTEM_CLOUD },
+  { PUBLISH_LANE_BULK_CAPACITY, sizeof(sl_wifi_asset_tracking_mqtt_package_queue_data_t),
+    STATIC_ALLOC_STORAGE(lane_bulk_storage), SL_STATIC_SUBSYSTEM_CLOUD }
+};
+
+static const sl_static_semaphore_config_t sl_static_semaphore_config[SL_STATIC_SEMAPHORE_COUNT] = {
+  { false, SL_STATIC_SUBSYSTEM_SENSOR },
+  { false, SL_STATIC_SUBSYSTEM_CLOUD },
+  { true, SL_STATIC_SUBSYSTEM_SENSOR },
+  { false, SL_STATIC_SUBSYSTEM_WIFI },
+  { false, SL_STATIC_SUBSYSTEM_CLOUD },
+  { false, SL_STATIC_SUBSYSTEM_SYSTEM },
+  { false, SL_STATIC_SUBSYSTEM_WIFI }
+};
+
+static const sl_static_timer_config_t sl_static_timer_config[SL_STATIC_TIMER_COUNT] = {
+  { NAME_TEMPERATURE_RH_SENSOR_TIMER, PERIOD_OF_TEMPERATURE_RH_SENSOR_TIMER,
+    pdFALSE, on_temperature_rh_sensor_timer_callback, SL_STATIC_SUBSYSTEM_SENSOR },
+  { NAME_IMU_SENSOR_TIMER, PERIOD_OF_IMU_SENSOR_TIMER,
+    pdFALSE, on_imu_sensor_timer_callback, SL_STATIC_SUBSYSTEM_SENSOR },
+  { NAME_GNSS_RECEIVER_TIMER, PERIOD_OF_GNSS_RECEIVER_TIMER,
+    pdFALSE, on_gnss_sensor_timer_callback, SL_STATIC_SUBSYSTEM_SENSOR },
+  { NAME_SAS_TOKEN_REFRESH_TIMER, SAS_TOKEN_REFRESH_PERIOD,
+    pdTRUE, on_sas_token_refresh_timer_callback, SL_STATIC_SUBSYSTEM_CLOUD },
+  { NAME_MQTT_KEEP_ALIVE_TIMER, MQTT_KEEP_ALIVE_PROCESS_PERIOD,
+    pdTRUE, on_mqtt_keep_alive_timer_callback, SL_STATIC_SUBSYSTEM_CLOUD }
+};
+
+static const char *const sl_static_subsystem_names[SL_STATIC_SUBSYSTEM_COUNT] = {
+  "sensor",
+  "json",
+  "cloud",
+  "wifi",
+  "lcd",
+  "system"
+};
+
+/******************************************************************************
+ *  Function to create an application task.
+ *****************************************************************************/
+sl_status_t sl_static_create_task(sl_static_task_e task, TaskHandle_t *handle)
+{
+  const sl_static_task_config_t *config;
+
+  if (task >= SL_STATIC_TASK_COUNT) {
+    return SL_STATUS_FAIL;
+  }
+  config = &sl_static_task_config[task];
+
+#if DEMO_CONFIG_STATIC_ALLOCATION
+  /// A task deleted by another task gives its control block back at once.
+  /// Application tasks are never recreated after deleting themselves, which
+  /// would leave the control block to the idle task.
+  if (sl_static_alloc.is_task_created[task]
+      && (eDeleted != eTaskGetState((TaskHandle_t)&sl_static_alloc.task[task]))) {
+    printf("\r\nsl_static_create_task : %s is not deleted yet\r\n",
+           config->name);
+    return SL_STATUS_FAIL;
+  }
+
+  *handle = xTaskCreateStatic(config->function,
+                              config->name,
+                              config->stack_size,
+                              NULL,
+                              config->priority,
+                              config->stack,
+                              &sl_static_alloc.task[task]);
+  if (NULL == *handle) {
+    return SL_STATUS_FAIL;
+  }
+  sl_static_alloc.is_task_created[task] = true;
+#else
+  if (pdPASS != xTaskCreate(config->function,
+                            config->name,
+                            config->stack_size,
+                            NULL,
+                            config->priority,
+                            handle)) {
+    return SL_STATUS_FAIL;
+  }
+#endif /// < DEMO_CONFIG_STATIC_ALLOCATION
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to get the handle of an application task.
+ *****************************************************************************/
+TaskHandle_t sl_static_get_task_handle(sl_static_task_e task)
+{
+  sl_wifi_asset_tracking_task_list_t *task_list =
+    &(sl_get_wifi_asset_tracking_resource()->task_list);
+
+  switch (task) {
+    case SL_STATIC_TASK_TEMPERATURE_RH_SENSOR:
+      return task_list->temp_rh_sensor_task_handler;
+    case SL_STATIC_TASK_IMU_SENSOR:
+      return task_list->imu_sensor_task_handler;
+    case SL_STATIC_TASK_GNSS_RECEIVER:
+      return task_list->gnss_receiver_task_handler;
+    case SL_STATIC_TASK_WIFI_DATA_CAPTURE:
+      return task_list->wifi_data_capture_task_handler;
+    case SL_STATIC_TASK_JSON_DATA_CONVERTER:
+      return task_list->json_data_converter_task_handler;
+    case SL_STATIC_TASK_CLOUD_COMMUNICATION:
+      return task_list->azure_cloud_communication_task_handler;
+    case SL_STATIC_TASK_RECOVERY:
+      return task_list->recovery_task_handler;
+    case SL_STATIC_TASK_LCD:
+      return task_list->lcd_task_handler;
+    case SL_STATIC_TASK_LINK_MONITOR:
+      return task_list->link_monitor_task_handler;
+    case SL_STATIC_TASK_CLOCK:
+      return task_list->clock_task_handler;
+    case SL_STATIC_TASK_METRICS:
+      return task_list->metrics_task_handler;
+    case SL_STATIC_TASK_LOG:
+      return task_list->log_task_handler;
+    case SL_STATIC_TASK_SUPERVISOR:
+      return task_list->supervisor_task_handler;
+    default:
+      return NULL;
+  }
+}
+
+/******************************************************************************
+ *  Function to get the configured stack depth of an application task.
+ *****************************************************************************/
+uint32_t sl_static_get_task_stack_size(sl_static_task_e task)
+{
+  if (task >= SL_STATIC_TASK_COUNT) {
+    return 0;
+  }
+
+  return sl_static_task_config[task].stack_size;
+}
+
+/******************************************************************************
+ *  Function to create an application queue.
+ *****************************************************************************/
+QueueHandle_t sl_static_create_queue(sl_static_queue_e queue)
+{
+  if (queue >= SL_STATIC_QUEUE_COUNT) {
+    return NULL;
+  }
+
+#if DEMO_CONFIG_STATIC_ALLOCATION
+  return xQueueCreateStatic(sl_static_queue_config[queue].length,
+                            sl_static_queue_config[queue].item_size,
+                            sl_static_queue_config[queue].storage,
+                            &sl_static_alloc.queue[queue]);
+#else
+  return xQueueCreate(sl_static_queue_config[queue].length,
+                      sl_static_queue_config[queue].item_size);
+#endif /// < DEMO_CONFIG_STATIC_ALLOCATION
+}
+
+/******************************************************************************
+ *  Function to create an application mutex or binary semaphore.
+ *****************************************************************************/
+SemaphoreHandle_t sl_static_create_semaphore(sl_static_semaphore_e semaphore)
+{
+  SemaphoreHandle_t handle;
+
+  if (semaphore >= SL_STATIC_SEMAPHORE_COUNT) {
+    return NULL;
+  }
+
+  if (!sl_static_semaphore_config[semaphore].is_binary) {
+#if DEMO_CONFIG_STATIC_ALLOCATION
+    return xSemaphoreCreateMutexStatic(&sl_static_alloc.semaphore[semaphore]);
+#else
+    return xSemaphoreCreateMutex();
+#endif /// < DEMO_CONFIG_STATIC_ALLOCATION
+  }
+
+#if DEMO_CONFIG_STATIC_ALLOCATION
+  handle = xSemaphoreCreateBinaryStatic(&sl_static_alloc.semaphore[semaphore]);
+#else
+  handle = xSemaphoreCreateBinary();
+#endif /// < DEMO_CONFIG_STATIC_ALLOCATION
+
+  /// Need to give it as it is by default taken
+  if (NULL != handle) {
+    xSemaphoreGive(handle);
+  }
+
+  return handle;
+}
+
+/******************************************************************************
+ *  Function to create an application timer.
+ *****************************************************************************/
+TimerHandle_t sl_static_create_timer(sl_static_timer_e timer)
+{
+  const sl_static_timer_config_t *config;
+
+  if (timer >= SL_STATIC_TIMER_COUNT) {
+    return NULL;
+  }
+  config = &sl_static_timer_config[timer];
+
+#if DEMO_CONFIG_STATIC_ALLOCATION
+  return xTimerCreateStatic(config->name,
+                            pdMS_TO_TICKS(config->period) * TIMER_CLOCK_OFFSET,
+                            config->auto_reload,
+                            NULL,
+                            config->callback,
+                            &sl_static_alloc.timer[timer]);
+#else
+  return xTimerCreate(config->name,
+                      pdMS_TO_TICKS(config->period) * TIMER_CLOCK_OFFSET,
+                      config->auto_reload,
+                      NULL,
+                      config->callback);
+#endif /// < DEMO_CONFIG_STATIC_ALLOCATION
+}
+
+/******************************************************************************
+ *  Function to print RAM of application kernel objects per subsystem.
+ *****************************************************************************/
+void sl_static_alloc_report(void)
+{
+  uint32_t stack[SL_STATIC_SUBSYSTEM_COUNT] = { 0 };
+  uint32_t objects[SL_STATIC_SUBSYSTEM_COUNT] = { 0 };
+  uint32_t storage[SL_STATIC_SUBSYSTEM_COUNT] = { 0 };
+  uint32_t total = 0;
+  uint32_t index;
+
+  for (index = 0; index < SL_STATIC_TASK_COUNT; index++) {
+    stack[sl_static_task_config[index].subsystem] +=
+      sl_static_task_config[index].stack_size * sizeof(StackType_t);
+    objects[sl_static_task_config[index].subsystem] += sizeof(StaticTask_t);
+  }
+  for (index = 0; index < SL_STATIC_QUEUE_COUNT; index++) {
+    storage[sl_static_queue_config[index].subsystem] +=
+      sl_static_queue_config[index].length
+      * sl_static_queue_config[index].item_size;
+    objects[sl_static_queue_config[index].subsystem] += sizeof(StaticQueue_t);
+  }
+  for (index = 0; index < SL_STATIC_SEMAPHORE_COUNT; index++) {
+    objects[sl_static_semaphore_config[index].subsystem] +=
+      sizeof(StaticSemaphore_t);
+  }
+  for (index = 0; index < SL_STATIC_TIMER_COUNT; index++) {
+    objects[sl_static_timer_config[index].subsystem] += sizeof(StaticTimer_t);
+  }
+
+#if DEMO_CONFIG_STATIC_ALLOCATION
+  printf("\r\nram_report : static allocation, bytes per subsystem\r\n");
+#else
+  printf("\r\nram_report : heap allocation, bytes per subsystem\r\n");
+#endif /// < DEMO_CONFIG_STATIC_ALLOCATION
+  printf("\r\nram_report : %-8s %8s %8s %8s %8s\r\n",
+         "subsys", "stacks", "objects", "queues", "total");
+
+  for (index = 0; index < SL_STATIC_SUBSYSTEM_COUNT; index++) {
+    printf("\r\nram_report : %-8s %8lu %8lu %8lu %8lu\r\n",
+           sl_static_subsystem_names[index],
+           (unsigned long)stack[index],
+           (unsigned long)objects[index],
+           (unsigned long)storage[index],
+           (unsigned long)(stack[index] + objects[index] + storage[index]));
+    total += stack[index] + objects[index] + storage[index];
+  }
+
+  printf("\r\nram_report : total %lu of budget %lu, heap free %lu, least free %lu\r\n",
+         (unsigned long)total,
+         (unsigned long)STATIC_ALLOC_RAM_BUDGET,
+         (unsigned long)xPortGetFreeHeapSize(),
+         (unsigned long)xPortGetMinimumEverFreeHeapSize());
+}
@@ -0,0 +1,534 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_supervisor.c
+ * @brief Task check-in supervision, hardware watchdog and reset reason
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <si91x_device.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_supervisor.h>
+#if DEMO_CONFIG_WATCHDOG
+#include <sl_si91x_watchdog_timer.h>
+#endif /// < DEMO_CONFIG_WATCHDOG
+
+_Static_assert((SL_STATIC_TASK_CLOUD_COMMUNICATION + 1)
+               == SL_SUPERVISOR_CLIENT_COUNT,
+               "supervisor clients follow the first application tasks");
+
+/// @brief Enum for handling of an overdue task
+typedef enum {
+  SL_SUPERVISOR_ACTION_RESTART_SENSOR = 0,  ///< Sensor task is recreated and recovery reinitializes the sensor
+  SL_SUPERVISOR_ACTION_RESTART_CLOUD,       ///< Cloud task is recreated and recovery reconnects
+  SL_SUPERVISOR_ACTION_RESET,               ///< Device is reset
+} sl_supervisor_action_e;
+
+/// @brief Structure for compile time configuration of a client
+typedef struct {
+  const char *name;                 ///< Task name
+  uint32_t deadline;                ///< In ms, longest time checked in
+  sl_supervisor_action_e action;    ///< Handling when the deadline is missed
+} sl_supervisor_client_config_t;
+
+/// @brief Structure for supervisor state
+typedef struct {
+  TickType_t check_in_tick[SL_SUPERVISOR_CLIENT_COUNT];   ///< Tick of last check-in
+  bool is_checked_in[SL_SUPERVISOR_CLIENT_COUNT];         ///< Client runs supervised work
+  uint8_t restarts[SL_SUPERVISOR_CLIENT_COUNT];           ///< Subsystem restarts per client
+  uint32_t total_restarts;                                ///< Subsystem restarts of all clients
+  sl_supervisor_client_e overdue_client;                  ///< Last overdue client, written to the reset record by the watchdog interrupt
+  sl_supervisor_retained_t last_reset;                    ///< Reset record of the previous boot
+} sl_supervisor_t;
+
+static const sl_supervisor_client_config_t
+  sl_supervisor_client_config[SL_SUPERVISOR_CLIENT_COUNT] = {
+  { NAME_TEMPERATURE_RH_SENSOR_TASK, SUPERVISOR_DEADLINE_SENSOR,
+    SL_SUPERVISOR_ACTION_RESTART_SENSOR },
+  { NAME_IMU_SENSOR_TASK, SUPERVISOR_DEADLINE_SENSOR,
+    SL_SUPERVISOR_ACTION_RESTART_SENSOR },
+  { NAME_GNSS_RECEIVER_TASK, SUPERVISOR_DEADLINE_GNSS,
+    SL_SUPERVISOR_ACTION_RESTART_SENSOR },
+  { NAME_WIFI_DATA_CAPTURE_TASK, SUPERVISOR_DEADLINE_WIFI_CAPTURE,
+    SL_SUPERVISOR_ACTION_RESET },
+  { NAME_JSON_DATA_CONVERTER_TASK, SUPERVISOR_DEADLINE_JSON,
+    SL_SUPERVISOR_ACTION_RESET },
+  { NAME_CLOUD_COMMUNICATION_TASK, SUPERVISOR_DEADLINE_CLOUD,
+    SL_SUPERVISOR_ACTION_RESTART_CLOUD }
+};
+
+/// Supervisor state, check-ins are written by the clients in critical
+/// sections
+static sl_supervisor_t sl_supervisor;
+
+/// Reset record, kept over a software or watchdog reset
+static sl_supervisor_retained_t sl_supervisor_retained
+__attribute__((section(SUPERVISOR_RETAINED_SECTION)));
+
+/**************************************************************************/ /**
+ * @brief Function to check whether a checked-in client missed its deadline.
+ * A client whose task was deleted is checked out.
+ * @param[in] client : supervised task.
+ * @return true when the deadline is missed.
+ ******************************************************************************/
+static bool sl_supervisor_is_overdue(sl_supervisor_client_e client);
+
+/**************************************************************************/ /**
+ * @brief Function to restart the subsystem of an overdue client or reset the
+ * device. A client holding an application mutex is never restarted.
+ * @param[in] client : overdue task.
+ ******************************************************************************/
+static void sl_supervisor_handle_overdue(sl_supervisor_client_e client);
+
+/**************************************************************************/ /**
+ * @brief Function to check whether a task holds an application mutex. A mutex
+ * can only be given back by its holder, so it would stay taken forever once
+ * the holder is deleted.
+ * @param[in] task : task to check.
+ * @return true when the task holds a mutex.
+ ******************************************************************************/
+static bool sl_supervisor_holds_mutex(TaskHandle_t task);
+
+/**************************************************************************/ /**
+ * @brief Function to recreate a sensor task and mark the sensor disconnected,
+ * the recovery task reinitializes the sensor. The task holds no mutex, which
+ * the caller checked. The I2C binary semaphore it may hold is given back by
+ * the I2C timeout timer of the sensor, which is left running for that.
+ * @param[in] client : overdue sensor task.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the sensor task cannot be recreated
+ ******************************************************************************/
+static sl_status_t sl_supervisor_restart_sensor(sl_supervisor_client_e client);
+
+/**************************************************************************/ /**
+ * @brief Function to recreate the cloud task and let the recovery task
+ * reconnect to IoT Hub. The task holds no mutex, which the caller checked.
+ * Its socket is closed and its IoT Hub client deinitialized, as it may have
+ * been deleted inside a publish or TLS record.
+ * @return The following values are returned:
+ * -  \ref SL_STATUS_OK on success
+ * -  \ref SL_STATUS_FAIL - when the cloud task cannot be recreated
+ ******************************************************************************/
+static sl_status_t sl_supervisor_restart_cloud(void);
+
+/**************************************************************************/ /**
+ * @brief Function to write the reset record and reset the device.
+ * @param[in] client : overdue task.
+ ******************************************************************************/
+static void sl_supervisor_reset(sl_supervisor_client_e client);
+
+/**************************************************************************/ /**
+ * @brief Function to write the reset record.
+ * @param[in] reason : reason of the coming reset.
+ * @param[in] client : overdue task, SL_SUPERVISOR_CLIENT_COUNT when none.
+ * @param[in] tick : current tick count, read by the caller as the watchdog
+ * interrupt needs the ISR variant.
+ ******************************************************************************/
+static void sl_supervisor_record(sl_supervisor_reset_reason_e reason,
+                                 sl_supervisor_client_e client,
+                                 TickType_t tick);
+
+/**************************************************************************/ /**
+ * @brief Function to compute the check field of a reset record.
+ * @param[in] record : reset record.
+ * @return inverted XOR of the record fields.
+ ******************************************************************************/
+static uint32_t sl_supervisor_get_check(const sl_supervisor_retained_t *record);
+
+#if DEMO_CONFIG_WATCHDOG
+/**************************************************************************/ /**
+ * @brief Callback function of the watchdog interrupt, the system reset
+ * follows when the watchdog is still not fed.
+ ******************************************************************************/
+static void sl_supervisor_on_watchdog_timeout(void);
+#endif /// < DEMO_CONFIG_WATCHDOG
+
+/******************************************************************************
+ *  Function to read and clear the reset record of the previous boot.
+ *****************************************************************************/
+void sl_supervisor_init(void)
+{
+  memset(&sl_supervisor, 0, sizeof(sl_supervisor));
+  sl_supervisor.overdue_client = SL_SUPERVISOR_CLIENT_COUNT;
+
+  /// RAM content is random after power-on
+  if ((SUPERVISOR_RETAINED_MAGIC == sl_supervisor_retained.magic)
+      && (sl_supervisor_get_check(&sl_supervisor_retained)
+          == sl_supervisor_retained.check)) {
+    memcpy(&sl_supervisor.last_reset,
+           &sl_supervisor_retained,
+           sizeof(sl_supervisor.last_reset));
+  } else {
+    sl_supervisor.last_reset.client = SL_SUPERVISOR_CLIENT_COUNT;
+  }
+
+#if DEMO_CONFIG_WATCHDOG
+  /// Watchdog reset without record, the interrupt did not run
+  if ((SL_SUPERVISOR_RESET_NONE == sl_supervisor.last_reset.reason)
+      && sl_si91x_watchdog_get_timer_system_reset_status()) {
+    sl_supervisor.last_reset.reason = SL_SUPERVISOR_RESET_WATCHDOG;
+    sl_supervisor.last_reset.resets++;
+  }
+#endif /// < DEMO_CONFIG_WATCHDOG
+
+  /// Record of this boot only keeps the reset count until a reset is due
+  sl_supervisor_retained.magic = SUPERVISOR_RETAINED_MAGIC;
+  sl_supervisor_retained.resets = sl_supervisor.last_reset.resets;
+  sl_supervisor_record(SL_SUPERVISOR_RESET_NONE,
+                       SL_SUPERVISOR_CLIENT_COUNT,
+                       xTaskGetTickCount());
+
+  if (SL_SUPERVISOR_RESET_NONE != sl_supervisor.last_reset.reason) {
+    printf(
+      "\r\nsl_supervisor_init : previous reset reason %lu, task %s, uptime %lu s, %lu resets since power-on\r\n",
+      sl_supervisor.last_reset.reason,
+      (sl_supervisor.last_reset.client < SL_SUPERVISOR_CLIENT_COUNT)
+      ? sl_supervisor_client_config[sl_supervisor.last_reset.client].name
+      : "none",
+      sl_supervisor.last_reset.uptime,
+      sl_supervisor.last_reset.resets);
+  }
+
+  /// Sent with the diagnostics messages of this boot
+  sl_metrics_set_gauge(SL_METRIC_RESET_REASON,
+                       (int32_t)sl_supervisor.last_reset.reason);
+  sl_metrics_set_gauge(SL_METRIC_RESET_TASK,
+                       (sl_supervisor.last_reset.client
+                        < SL_SUPERVISOR_CLIENT_COUNT)
+                       ? (int32_t)sl_supervisor.last_reset.client : -1);
+}
+
+/******************************************************************************
+ *  Function to stop the hardware watchdog.
+ *****************************************************************************/
+void sl_supervisor_deinit(void)
+{
+#if DEMO_CONFIG_WATCHDOG
+  if (SL_STATUS_OK != sl_si91x_watchdog_stop_timer()) {
+    printf("\r\nsl_supervisor_deinit : watchdog stop failed\r\n");
+  }
+#endif /// < DEMO_CONFIG_WATCHDOG
+}
+
+/******************************************************************************
+ *  Task function which supervises check-ins and feeds the watchdog.
+ *****************************************************************************/
+void sl_supervisor_task()
+{
+  bool is_healthy;
+  uint8_t index;
+
+#if DEMO_CONFIG_WATCHDOG
+  watchdog_timer_config_t watchdog_config = {
+    .interrupt_time = SUPERVISOR_WATCHDOG_INTERRUPT_TIME,
+    .system_reset_time = SUPERVISOR_WATCHDOG_RESET_TIME,
+    .window_time = 0
+  };
+
+  sl_si91x_watchdog_init_timer();
+  if ((SL_STATUS_OK != sl_si91x_watchdog_set_configuration(&watchdog_config))
+      || (SL_STATUS_OK
+          != sl_si91x_watchdog_register_timeout_callback(
+            sl_supervisor_on_watchdog_timeout))) {
+    printf("\r\nsl_supervisor_task : watchdog configuration failed\r\n");
+  } else {
+    sl_si91x_watchdog_start_timer();
+  }
+#endif /// < DEMO_CONFIG_WATCHDOG
+
+  while (1) {
+    vTaskDelay(pdMS_TO_TICKS(SUPERVISOR_PERIOD) * TIMER_CLOCK_OFFSET);
+
+    is_healthy = true;
+    for (index = 0; index < SL_SUPERVISOR_CLIENT_COUNT; index++) {
+      if (sl_supervisor_is_overdue((sl_supervisor_client_e)index)) {
+        is_healthy = false;
+        sl_supervisor_handle_overdue((sl_supervisor_client_e)index);
+      }
+    }
+
+#if DEMO_CONFIG_WATCHDOG
+    /// A missed kick is tolerated until SUPERVISOR_WATCHDOG_INTERRUPT_TIME
+    if (is_healthy) {
+      sl_si91x_watchdog_kick_watchdog_timer();
+    }
+#else
+    (void)is_healthy;
+#endif /// < DEMO_CONFIG_WATCHDOG
+  }
+}
+
+/******************************************************************************
+ *  Function to start or continue supervised work.
+ *****************************************************************************/
+void sl_supervisor_check_in(sl_supervisor_client_e client)
+{
+  taskENTER_CRITICAL();
+  sl_supervisor.check_in_tick[client] = xTaskGetTickCount();
+  sl_supervisor.is_checked_in[client] = true;
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to stop supervision until the next check-in.
+ *****************************************************************************/
+void sl_supervisor_check_out(sl_supervisor_client_e client)
+{
+  taskENTER_CRITICAL();
+  sl_supervisor.is_checked_in[client] = false;
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to read the reset record of the previous boot.
+ *****************************************************************************/
+void sl_supervisor_get_last_reset(sl_supervisor_retained_t *record)
+{
+  memcpy(record, &sl_supervisor.last_reset, sizeof(*record));
+}
+
+/******************************************************************************
+ *  Function to check whether a checked-in client missed its deadline.
+ *****************************************************************************/
+static bool sl_supervisor_is_overdue(sl_supervisor_client_e client)
+{
+  bool is_overdue = false;
+
+  taskENTER_CRITICAL();
+  if (NULL == sl_static_get_task_handle((sl_static_task_e)client)) {
+    sl_supervisor.is_checked_in[client] = false;
+  } else if (sl_supervisor.is_checked_in[client]) {
+    is_overdue = ((((xTaskGetTickCount() - sl_supervisor.check_in_tick[client])
+                    * portTICK_PERIOD_MS) / TIMER_CLOCK_OFFSET)
+                  > sl_supervisor_client_config[client].deadline);
+  }
+  taskEXIT_CRITICAL();
+
+  return is_overdue;
+}
+
+/******************************************************************************
+ *  Function to restart the subsystem of an overdue client or reset.
+ *****************************************************************************/
+static void sl_supervisor_handle_overdue(sl_supervisor_client_e client)
+{
+  TaskHandle_t task;
+  sl_status_t status;
+
+  sl_supervisor.overdue_client = client;
+
+  printf("\r\nsl_supervisor_task : %s missed its %lu ms deadline\r\n",
+         sl_supervisor_client_config[client].name,
+         sl_supervisor_client_config[client].deadline);
+
+  /// Suspended first, so the task cannot take a mutex between the check and
+  /// its deletion. Mutexes held by the task would be orphaned by its restart
+  task = sl_static_get_task_handle((sl_static_task_e)client);
+  if (NULL != task) {
+    vTaskSuspend(task);
+  }
+
+  if ((SL_SUPERVISOR_ACTION_RESET == sl_supervisor_client_config[client].action)
+      || (sl_supervisor.restarts[client] >= SUPERVISOR_MAX_RESTARTS)
+      || sl_supervisor_holds_mutex(task)) {
+    sl_supervisor_reset(client);
+    return;
+  }
+
+  /// Restarted task checks in again once it runs
+  sl_supervisor_check_out(client);
+  sl_supervisor.restarts[client]++;
+  sl_supervisor.total_restarts++;
+  sl_metrics_set_gauge(SL_METRIC_SUPERVISOR_RESTARTS,
+                       (int32_t)sl_supervisor.total_restarts);
+
+  if (SL_SUPERVISOR_ACTION_RESTART_SENSOR
+      == sl_supervisor_client_config[client].action) {
+    status = sl_supervisor_restart_sensor(client);
+  } else {
+    status = sl_supervisor_restart_cloud();
+  }
+
+  if (SL_STATUS_OK != status) {
+    sl_supervisor_reset(client);
+  }
+}
+
+/******************************************************************************
+ *  Function to check whether a task holds an application mutex.
+ *****************************************************************************/
+static bool sl_supervisor_holds_mutex(TaskHandle_t task)
+{
+  sl_wifi_asset_tracking_resource_t *resource =
+    sl_get_wifi_asset_tracking_resource();
+  SemaphoreHandle_t mutexes[] = {
+    resource->sensor_data_queue_mutex_handler,
+    resource->mqtt_package_queue_mutex_handler,
+    resource->dns_cache_mutex_handler,
+    resource->sas_token_mutex_handler,
+    resource->clock_mutex_handler,
+    resource->wifi_scan_mutex_handler
+  };
+  uint8_t index;
+
+  if (NULL == task) {
+    return false;
+  }
+
+  for (index = 0; index < (sizeof(mutexes) / sizeof(mutexes[0])); index++) {
+    if ((NULL != mutexes[index])
+        && (task == xSemaphoreGetMutexHolder(mutexes[index]))) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/******************************************************************************
+ *  Function to recreate a sensor task and mark the sensor disconnected.
+ *****************************************************************************/
+static sl_status_t sl_supervisor_restart_sensor(sl_supervisor_client_e client)
+{
+  sl_wifi_asset_tracking_task_list_t *task_list =
+    &(sl_get_wifi_asset_tracking_resource()->task_list);
+  sl_wifi_asset_tracking_sensor_queue_data_type_e sensor_type;
+  TaskHandle_t *task_handle;
+
+  switch (client) {
+    case SL_SUPERVISOR_CLIENT_TEMPERATURE_RH_SENSOR:
+      task_handle = &(task_list->temp_rh_sensor_task_handler);
+      sensor_type = SL_TEMP_RH_SENSOR;
+      break;
+    case SL_SUPERVISOR_CLIENT_IMU_SENSOR:
+      task_handle = &(task_list->imu_sensor_task_handler);
+      sensor_type = SL_IMU_SENSOR;
+      break;
+    case SL_SUPERVISOR_CLIENT_GNSS_RECEIVER:
+      task_handle = &(task_list->gnss_receiver_task_handler);
+      sensor_type = SL_GNSS_RECEIVER;
+      break;
+    default:
+      return SL_STATUS_FAIL;
+  }
+
+  printf("\r\nsl_supervisor_task : restarting %s\r\n",
+         sl_supervisor_client_config[client].name);
+
+#if DEMO_CONFIG_STACK_PROFILE
+  sl_stack_profile_sample_task((sl_static_task_e)client);
+#endif /// < DEMO_CONFIG_STACK_PROFILE
+  vTaskDelete(*task_handle);
+  *task_handle = NULL;
+
+  /// Recreated task skips the probe, recovery reinitializes the sensor in
+  /// place like after an I2C timeout of the sensor timers. The sensor lost
+  /// event notifies the recovery task, it is never resumed from here
+  sl_wifi_asset_tracking_set_sensor_status(sensor_type, SL_SENSOR_DISCONNECTED);
+
+  if (SL_STATUS_OK
+      != sl_static_create_task((sl_static_task_e)client, task_handle)) {
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to recreate the cloud task and let recovery reconnect.
+ *****************************************************************************/
+static sl_status_t sl_supervisor_restart_cloud(void)
+{
+  sl_wifi_asset_tracking_task_list_t *task_list =
+    &(sl_get_wifi_asset_tracking_resource()->task_list);
+
+  printf("\r\nsl_supervisor_task : restarting %s\r\n",
+         NAME_CLOUD_COMMUNICATION_TASK);
+
+  /// Keep-alive timer notifies the task, stop it before the task goes
+  xTimerStop(sl_get_wifi_asset_tracking_resource()->mqtt_keep_alive_timer, 0);
+  vTaskDelete(task_list->azure_cloud_communication_task_handler);
+  task_list->azure_cloud_communication_task_handler = NULL;
+
+  /// The deleted task may have stopped inside a publish or TLS record, so its
+  /// socket and client state are dropped here, without an MQTT disconnect.
+  /// Recovery, which the cloud down event notifies, opens a new session
+  sl_transport_disconnect();
+  AzureIoTHubClient_Deinit(&(sl_get_wifi_asset_tracking_resource()->
+                             azure_iot_hub_client));
+  sl_wifi_asset_tracking_set_cloud_status(SL_CLOUD_DISCONNECTED);
+
+  if (SL_STATUS_OK
+      != sl_static_create_task(SL_STATIC_TASK_CLOUD_COMMUNICATION,
+                               &(task_list->
+                                 azure_cloud_communication_task_handler))) {
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to write the reset record and reset the device.
+ *****************************************************************************/
+static void sl_supervisor_reset(sl_supervisor_client_e client)
+{
+  printf("\r\nsl_supervisor_task : %s is stuck, resetting device\r\n",
+         sl_supervisor_client_config[client].name);
+
+  taskENTER_CRITICAL();
+  sl_supervisor_retained.resets++;
+  sl_supervisor_record(SL_SUPERVISOR_RESET_TASK_STUCK,
+                       client,
+                       xTaskGetTickCount());
+  NVIC_SystemReset();
+}
+
+/******************************************************************************
+ *  Function to write the reset record.
+ *****************************************************************************/
+static void sl_supervisor_record(sl_supervisor_reset_reason_e reason,
+                                 sl_supervisor_client_e client,
+                                 TickType_t tick)
+{
+  sl_supervisor_retained.reason = reason;
+  sl_supervisor_retained.client = client;
+  sl_supervisor_retained.uptime =
+    (uint32_t)(((tick * portTICK_PERIOD_MS) / TIMER_CLOCK_OFFSET) / 1000);
+  sl_supervisor_retained.check =
+    sl_supervisor_get_check(&sl_supervisor_retained);
+}
+
+/******************************************************************************
+ *  Function to compute the check field of a reset record.
+ *****************************************************************************/
+static uint32_t sl_supervisor_get_check(const sl_supervisor_retained_t *record)
+{
+  return ~(record->magic ^ record->reason ^ record->client ^ record->resets
+           ^ record->uptime);
+}
+
+#if DEMO_CONFIG_WATCHDOG
+/******************************************************************************
+ *  Callback function of the watchdog interrupt.
+ *****************************************************************************/
+static void sl_supervisor_on_watchdog_timeout(void)
+{
+  sl_supervisor_retained.resets++;
+  sl_supervisor_record(SL_SUPERVISOR_RESET_WATCHDOG,
+                       sl_supervisor.overdue_client,
+                       xTaskGetTickCountFromISR());
+}
+#endif /// < DEMO_CONFIG_WATCHDOG
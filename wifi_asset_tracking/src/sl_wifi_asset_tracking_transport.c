@@ -0,0 +1,173 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_transport.c
+ * @brief Pluggable byte stream transport used by the Azure IoT Hub client
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <sl_wifi_asset_tracking_transport.h>
+
+/// Transport backend used by the cloud connection
+static const sl_transport_interface_t *sl_transport_active;
+
+/// Connection state since last connect
+static sl_status_t sl_transport_link_status = SL_STATUS_FAIL;
+
+/// Why the connection was lost since last connect
+static sl_transport_disconnect_reason_e sl_transport_disconnect_reason =
+  SL_TRANSPORT_DISCONNECT_NONE;
+
+/**************************************************************************/ /**
+ * @brief Function to record a failed send or receive.
+ * @param[in] result : negative result of the transport backend.
+ ******************************************************************************/
+static void sl_transport_set_failed(int32_t result);
+
+/******************************************************************************
+ *  Function to select the transport backend used by the cloud connection.
+ *****************************************************************************/
+sl_status_t sl_transport_register(const sl_transport_interface_t *transport)
+{
+  if ((NULL == transport) || (NULL == transport->connect)
+      || (NULL == transport->send) || (NULL == transport->recv)
+      || (NULL == transport->disconnect)) {
+    printf("\r\nsl_transport_register : invalid transport backend\r\n");
+    return SL_STATUS_FAIL;
+  }
+
+  sl_transport_active = transport;
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to get the registered transport backend.
+ *****************************************************************************/
+const sl_transport_interface_t *sl_transport_get_interface(void)
+{
+  return sl_transport_active;
+}
+
+/******************************************************************************
+ *  Function to connect the registered transport backend.
+ *****************************************************************************/
+sl_status_t sl_transport_connect(const char *host_name, uint16_t port)
+{
+  if (NULL == sl_transport_active) {
+    printf("\r\nsl_transport_connect : no transport backend registered\r\n");
+    return SL_STATUS_FAIL;
+  }
+
+  sl_transport_disconnect_reason = SL_TRANSPORT_DISCONNECT_NONE;
+  sl_transport_link_status = sl_transport_active->connect(
+    sl_transport_active->context,
+    host_name,
+    port);
+
+  return sl_transport_link_status;
+}
+
+/******************************************************************************
+ *  Function to disconnect the registered transport backend.
+ *****************************************************************************/
+void sl_transport_disconnect(void)
+{
+  sl_transport_link_status = SL_STATUS_FAIL;
+
+  if (NULL != sl_transport_active) {
+    sl_transport_active->disconnect(sl_transport_active->context);
+  }
+}
+
+/******************************************************************************
+ *  Send callback handed to the Azure IoT Hub client.
+ *****************************************************************************/
+int32_t sl_transport_send(NetworkContext_t *network_context,
+                          const void *buffer,
+                          size_t bytes_to_send)
+{
+  int32_t sent_bytes;
+
+  (void)network_context;
+
+  if (NULL == sl_transport_active) {
+    return -1;
+  }
+
+  sent_bytes = sl_transport_active->send(sl_transport_active->context,
+                                        buffer,
+                                        bytes_to_send);
+
+  if (sent_bytes < 0) {
+    sl_transport_set_failed(sent_bytes);
+  }
+
+  return sent_bytes;
+}
+
+/******************************************************************************
+ *  Receive callback handed to the Azure IoT Hub client.
+ *****************************************************************************/
+int32_t sl_transport_recv(NetworkContext_t *network_context,
+                          void *buffer,
+                          size_t bytes_to_recv)
+{
+  int32_t recv_bytes;
+
+  (void)network_context;
+
+  if (NULL == sl_transport_active) {
+    return -1;
+  }
+
+  recv_bytes = sl_transport_active->recv(sl_transport_active->context,
+                                        buffer,
+                                        bytes_to_recv);
+
+  if (recv_bytes < 0) {
+    sl_transport_set_failed(recv_bytes);
+  }
+
+  return recv_bytes;
+}
+
+/******************************************************************************
+ *  Function to check the connection for send or receive errors.
+ *****************************************************************************/
+sl_status_t sl_transport_get_link_status(void)
+{
+  return sl_transport_link_status;
+}
+
+/******************************************************************************
+ *  Function to get why the connection was lost.
+ *****************************************************************************/
+sl_transport_disconnect_reason_e sl_transport_get_disconnect_reason(void)
+{
+  return sl_transport_disconnect_reason;
+}
+
+/******************************************************************************
+ *  Function to record a failed send or receive.
+ *****************************************************************************/
+static void sl_transport_set_failed(int32_t result)
+{
+  sl_transport_link_status = SL_STATUS_FAIL;
+
+  /// First failure is the cause, later ones follow from it
+  if (SL_TRANSPORT_DISCONNECT_NONE != sl_transport_disconnect_reason) {
+    return;
+  }
+  sl_transport_disconnect_reason = (SL_TRANSPORT_PEER_CLOSED == result)
+                                   ? SL_TRANSPORT_DISCONNECT_PEER_CLOSED
+                                   : SL_TRANSPORT_DISCONNECT_ERROR;
+}
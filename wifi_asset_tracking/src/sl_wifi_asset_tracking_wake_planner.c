@@ -0,0 +1,169 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_wake_planner.c
+ * @brief Merges sleep deadlines of capture tasks into shared wake-ups
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_wake_planner.h>
+
+/// @brief Structure for wake planner state
+typedef struct {
+  TickType_t deadline[SL_WAKE_CLIENT_COUNT];  ///< Planned wake-up of a sleeping client
+  bool is_sleeping[SL_WAKE_CLIENT_COUNT];     ///< Client is blocked until its deadline
+  TickType_t report_tick;                     ///< Tick of last report
+#if (1 == configGENERATE_RUN_TIME_STATS)
+  uint32_t report_idle_time;                  ///< Idle task run time at last report
+  uint32_t report_total_time;                 ///< Run time counter at last report
+#endif /// < configGENERATE_RUN_TIME_STATS
+  sl_wake_planner_metrics_t metrics;          ///< Metrics since boot
+} sl_wake_planner_t;
+
+/// Wake planner state, deadlines are shared by all capture tasks and only
+/// changed in critical sections
+static sl_wake_planner_t sl_wake_planner;
+
+/**************************************************************************/ /**
+ * @brief Function to log wake-ups and idle share once per
+ * WAKE_PLANNER_REPORT_INTERVAL.
+ ******************************************************************************/
+static void sl_wake_planner_report(void);
+
+/******************************************************************************
+ *  Function to reset deadlines and metrics.
+ *****************************************************************************/
+void sl_wake_planner_init(void)
+{
+  memset(&sl_wake_planner, 0, sizeof(sl_wake_planner));
+  /// Runs before the scheduler starts, tick and run time counters are 0
+  sl_wake_planner.report_tick = xTaskGetTickCount();
+}
+
+/******************************************************************************
+ *  Function to sleep a capture task until its, possibly merged, deadline.
+ *****************************************************************************/
+void sl_wake_planner_delay(sl_wake_client_e client, TickType_t delay)
+{
+  TickType_t now;
+  TickType_t deadline;
+#if DEMO_CONFIG_LOW_POWER_MODE
+  TickType_t tolerance = pdMS_TO_TICKS(WAKE_PLANNER_TOLERANCE)
+                         * TIMER_CLOCK_OFFSET;
+  TickType_t best_distance = tolerance + 1;
+  TickType_t distance;
+  int32_t offset;
+  uint8_t index;
+#endif /// < DEMO_CONFIG_LOW_POWER_MODE
+
+  sl_wake_planner_report();
+
+  taskENTER_CRITICAL();
+  now = xTaskGetTickCount();
+  deadline = now + delay;
+
+#if DEMO_CONFIG_LOW_POWER_MODE
+  /// Join the closest wake-up another client already sleeps towards, tick
+  /// counts are compared as signed offsets so wrap-around is harmless
+  for (index = 0; index < SL_WAKE_CLIENT_COUNT; index++) {
+    if ((index == client) || !sl_wake_planner.is_sleeping[index]) {
+      continue;
+    }
+    offset = (int32_t)(sl_wake_planner.deadline[index] - (now + delay));
+    distance = (TickType_t)((offset < 0) ? -offset : offset);
+    if ((distance < best_distance)
+        && ((int32_t)(sl_wake_planner.deadline[index] - now) >= 0)) {
+      best_distance = distance;
+      deadline = sl_wake_planner.deadline[index];
+    }
+  }
+
+  if (best_distance <= tolerance) {
+    sl_wake_planner.metrics.merged++;
+    sl_wake_planner.metrics.shift_ms +=
+      (uint32_t)((best_distance * portTICK_PERIOD_MS) / TIMER_CLOCK_OFFSET);
+  } else {
+    sl_wake_planner.metrics.wakes++;
+  }
+#else
+  sl_wake_planner.metrics.wakes++;
+#endif /// < DEMO_CONFIG_LOW_POWER_MODE
+
+  sl_wake_planner.deadline[client] = deadline;
+  sl_wake_planner.is_sleeping[client] = true;
+  taskEXIT_CRITICAL();
+
+  vTaskDelay(deadline - now);
+
+  taskENTER_CRITICAL();
+  sl_wake_planner.is_sleeping[client] = false;
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to read wake planner metrics.
+ *****************************************************************************/
+void sl_wake_planner_get_metrics(sl_wake_planner_metrics_t *metrics)
+{
+  taskENTER_CRITICAL();
+  memcpy(metrics, &sl_wake_planner.metrics, sizeof(*metrics));
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to log wake-ups and idle share once per report interval.
+ *****************************************************************************/
+static void sl_wake_planner_report(void)
+{
+  sl_wake_planner_metrics_t metrics;
+#if (1 == configGENERATE_RUN_TIME_STATS)
+  uint32_t idle_time;
+  uint32_t total_time;
+#endif /// < configGENERATE_RUN_TIME_STATS
+
+  taskENTER_CRITICAL();
+  if ((((xTaskGetTickCount() - sl_wake_planner.report_tick) * portTICK_PERIOD_MS)
+       / TIMER_CLOCK_OFFSET) < (WAKE_PLANNER_REPORT_INTERVAL * 1000)) {
+    taskEXIT_CRITICAL();
+    return;
+  }
+  sl_wake_planner.report_tick = xTaskGetTickCount();
+
+#if (1 == configGENERATE_RUN_TIME_STATS)
+  /// Idle task runs, and tickless idle sleeps, whenever no task is ready, so
+  /// its share of the run time is the share of the interval spent asleep
+  idle_time = ulTaskGetIdleRunTimeCounter();
+  total_time = portGET_RUN_TIME_COUNTER_VALUE();
+  if (total_time != sl_wake_planner.report_total_time) {
+    sl_wake_planner.metrics.sleep_permille =
+      (uint32_t)(((uint64_t)(idle_time - sl_wake_planner.report_idle_time)
+                  * 1000)
+                 / (total_time - sl_wake_planner.report_total_time));
+  }
+  sl_wake_planner.report_idle_time = idle_time;
+  sl_wake_planner.report_total_time = total_time;
+#endif /// < configGENERATE_RUN_TIME_STATS
+
+  memcpy(&metrics, &sl_wake_planner.metrics, sizeof(metrics));
+  taskEXIT_CRITICAL();
+
+  printf(
+    "\r\nsl_wake_planner_report : %lu wakes, %lu merged, shifted %lu ms, sleep %lu.%lu %%\r\n",
+    metrics.wakes,
+    metrics.merged,
+    metrics.shift_ms,
+    metrics.sleep_permille / 10,
+    metrics.sleep_permille % 10);
+}
@@ -0,0 +1,286 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_wifi_fingerprint.c
+ * @brief Access point selection and encoding for Wi-Fi positioning
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <string.h>
+#include <sl_wifi_asset_tracking_wifi_fingerprint.h>
+
+/// Base64 alphabet of RFC 4648
+static const char sl_wifi_fingerprint_base64[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**************************************************************************/ /**
+ * @brief Function to check whether an access point is useful for positioning.
+ * @param[in] bssid : access point MAC address.
+ * @param[in] rssi : in dBm.
+ * @param[in] ssid : SSID.
+ * @param[in] ssid_len : SSID length.
+ * @return true when the access point can be used.
+ ******************************************************************************/
+static bool sl_wifi_fingerprint_is_usable(const uint8_t *bssid,
+                                          int8_t rssi,
+                                          const uint8_t *ssid,
+                                          size_t ssid_len);
+
+/**************************************************************************/ /**
+ * @brief Function to get the value of one base64 character.
+ * @param[in] character : base64 character.
+ * @return value from 0 to 63, or -1 when not a base64 character.
+ ******************************************************************************/
+static int sl_wifi_fingerprint_base64_value(char character);
+
+/******************************************************************************
+ *  Function to empty a fingerprint before a scan.
+ *****************************************************************************/
+void sl_wifi_fingerprint_init(sl_wifi_fingerprint_t *fingerprint)
+{
+  memset(fingerprint, 0, sizeof(*fingerprint));
+}
+
+/******************************************************************************
+ *  Function to offer one scan result to a fingerprint.
+ *****************************************************************************/
+bool sl_wifi_fingerprint_add(sl_wifi_fingerprint_t *fingerprint,
+                             const uint8_t *bssid,
+                             int8_t rssi,
+                             uint8_t channel,
+                             const uint8_t *ssid,
+                             size_t ssid_len)
+{
+  uint8_t index;
+  uint8_t position;
+
+  if (!sl_wifi_fingerprint_is_usable(bssid, rssi, ssid, ssid_len)) {
+    return false;
+  }
+
+  /// Same BSSID can be reported on more than one channel, keep the strongest
+  for (index = 0; index < fingerprint->ap_count; ++index) {
+    if (0 == memcmp(fingerprint->ap[index].bssid,
+                    bssid,
+                    WIFI_FINGERPRINT_BSSID_SIZE)) {
+      if (rssi <= fingerprint->ap[index].rssi) {
+        return false;
+      }
+      memmove(&fingerprint->ap[index],
+              &fingerprint->ap[index + 1],
+              (fingerprint->ap_count - index - 1) * sizeof(fingerprint->ap[0]));
+      fingerprint->ap_count--;
+      break;
+    }
+  }
+
+  /// Entries stay sorted strongest first, the first one seen wins a tie
+  for (position = 0; position < fingerprint->ap_count; ++position) {
+    if (rssi > fingerprint->ap[position].rssi) {
+      break;
+    }
+  }
+
+  if (position >= WIFI_FINGERPRINT_MAX_APS) {
+    return false;
+  }
+
+  if (fingerprint->ap_count < WIFI_FINGERPRINT_MAX_APS) {
+    fingerprint->ap_count++;
+  }
+
+  memmove(&fingerprint->ap[position + 1],
+          &fingerprint->ap[position],
+          (fingerprint->ap_count - position - 1) * sizeof(fingerprint->ap[0]));
+
+  memcpy(fingerprint->ap[position].bssid, bssid, WIFI_FINGERPRINT_BSSID_SIZE);
+  fingerprint->ap[position].rssi = rssi;
+  fingerprint->ap[position].channel = channel;
+
+  return true;
+}
+
+/******************************************************************************
+ *  Function to encode a fingerprint as base64 text.
+ *****************************************************************************/
+sl_status_t sl_wifi_fingerprint_encode(const sl_wifi_fingerprint_t *fingerprint,
+                                       char *text,
+                                       size_t text_size)
+{
+  uint8_t binary[WIFI_FINGERPRINT_MAX_ENCODED_SIZE];
+  uint32_t binary_len = WIFI_FINGERPRINT_HEADER_SIZE;
+  uint32_t text_len = 0;
+  uint32_t group;
+  uint32_t index;
+  uint8_t ap;
+
+  if ((0 == fingerprint->ap_count)
+      || (fingerprint->ap_count > WIFI_FINGERPRINT_MAX_APS)) {
+    return SL_STATUS_FAIL;
+  }
+
+  binary[0] = WIFI_FINGERPRINT_FORMAT_VERSION;
+  binary[1] = fingerprint->ap_count;
+
+  for (ap = 0; ap < fingerprint->ap_count; ++ap) {
+    memcpy(&binary[binary_len],
+           fingerprint->ap[ap].bssid,
+           WIFI_FINGERPRINT_BSSID_SIZE);
+    binary_len += WIFI_FINGERPRINT_BSSID_SIZE;
+    binary[binary_len++] = (uint8_t)fingerprint->ap[ap].rssi;
+    binary[binary_len++] = fingerprint->ap[ap].channel;
+  }
+
+  if (text_size < ((((binary_len + 2) / 3) * 4) + 1)) {
+    return SL_STATUS_FAIL;
+  }
+
+  for (index = 0; index < binary_len; index += 3) {
+    group = (uint32_t)binary[index] << 16;
+    if ((index + 1) < binary_len) {
+      group |= (uint32_t)binary[index + 1] << 8;
+    }
+    if ((index + 2) < binary_len) {
+      group |= binary[index + 2];
+    }
+
+    text[text_len++] = sl_wifi_fingerprint_base64[(group >> 18) & 0x3F];
+    text[text_len++] = sl_wifi_fingerprint_base64[(group >> 12) & 0x3F];
+    text[text_len++] = ((index + 1) < binary_len)
+                       ? sl_wifi_fingerprint_base64[(group >> 6) & 0x3F] : '=';
+    text[text_len++] = ((index + 2) < binary_len)
+                       ? sl_wifi_fingerprint_base64[group & 0x3F] : '=';
+  }
+  text[text_len] = '\0';
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to decode base64 text made by sl_wifi_fingerprint_encode.
+ *****************************************************************************/
+sl_status_t sl_wifi_fingerprint_decode(const char *text,
+                                       sl_wifi_fingerprint_t *fingerprint)
+{
+  uint8_t binary[WIFI_FINGERPRINT_MAX_ENCODED_SIZE];
+  uint32_t binary_len = 0;
+  uint32_t text_len = (uint32_t)strlen(text);
+  uint32_t group;
+  uint32_t index;
+  uint32_t offset;
+  int value;
+  int pad;
+  uint8_t ap;
+
+  if ((0 == text_len) || (0 != (text_len % 4))
+      || (text_len >= WIFI_FINGERPRINT_MAX_TEXT_SIZE)) {
+    return SL_STATUS_FAIL;
+  }
+
+  for (index = 0; index < text_len; index += 4) {
+    group = 0;
+    pad = 0;
+    for (offset = 0; offset < 4; ++offset) {
+      if (('=' == text[index + offset]) && ((index + 4) == text_len)
+          && (offset >= 2)) {
+        pad++;
+        value = 0;
+      } else if (pad > 0) {
+        return SL_STATUS_FAIL;
+      } else {
+        value = sl_wifi_fingerprint_base64_value(text[index + offset]);
+        if (value < 0) {
+          return SL_STATUS_FAIL;
+        }
+      }
+      group = (group << 6) | (uint32_t)value;
+    }
+
+    binary[binary_len++] = (uint8_t)(group >> 16);
+    if (pad < 2) {
+      binary[binary_len++] = (uint8_t)(group >> 8);
+    }
+    if (pad < 1) {
+      binary[binary_len++] = (uint8_t)group;
+    }
+  }
+
+  if ((binary_len < WIFI_FINGERPRINT_HEADER_SIZE)
+      || (WIFI_FINGERPRINT_FORMAT_VERSION != binary[0])
+      || (0 == binary[1]) || (binary[1] > WIFI_FINGERPRINT_MAX_APS)
+      || (binary_len != (WIFI_FINGERPRINT_HEADER_SIZE
+                         + ((uint32_t)binary[1] * WIFI_FINGERPRINT_ENTRY_SIZE)))) {
+    return SL_STATUS_FAIL;
+  }
+
+  fingerprint->ap_count = binary[1];
+  offset = WIFI_FINGERPRINT_HEADER_SIZE;
+  for (ap = 0; ap < fingerprint->ap_count; ++ap) {
+    memcpy(fingerprint->ap[ap].bssid,
+           &binary[offset],
+           WIFI_FINGERPRINT_BSSID_SIZE);
+    offset += WIFI_FINGERPRINT_BSSID_SIZE;
+    fingerprint->ap[ap].rssi = (int8_t)binary[offset++];
+    fingerprint->ap[ap].channel = binary[offset++];
+  }
+
+  return SL_STATUS_OK;
+}
+
+/******************************************************************************
+ *  Function to check whether an access point is useful for positioning.
+ *****************************************************************************/
+static bool sl_wifi_fingerprint_is_usable(const uint8_t *bssid,
+                                          int8_t rssi,
+                                          const uint8_t *ssid,
+                                          size_t ssid_len)
+{
+  const size_t suffix_len = sizeof(WIFI_FINGERPRINT_NOMAP_SUFFIX) - 1;
+  static const uint8_t zero_bssid[WIFI_FINGERPRINT_BSSID_SIZE] = { 0 };
+
+  if (rssi < WIFI_FINGERPRINT_MIN_RSSI) {
+    return false;
+  }
+
+  /// Locally administered addresses move with phones and hotspots
+  if ((bssid[0] & 0x02)
+      || (0 == memcmp(bssid, zero_bssid, WIFI_FINGERPRINT_BSSID_SIZE))) {
+    return false;
+  }
+
+  if ((ssid_len >= suffix_len)
+      && (0 == memcmp(&ssid[ssid_len - suffix_len],
+                      WIFI_FINGERPRINT_NOMAP_SUFFIX,
+                      suffix_len))) {
+    return false;
+  }
+
+  return true;
+}
+
+/******************************************************************************
+ *  Function to get the value of one base64 character.
+ *****************************************************************************/
+static int sl_wifi_fingerprint_base64_value(char character)
+{
+  const char *found;
+
+  if ('\0' == character) {
+    return -1;
+  }
+
+  found = strchr(sl_wifi_fingerprint_base64, character);
+  if (NULL == found) {
+    return -1;
+  }
+
+  return (int)(found - sl_wifi_fingerprint_base64);
+}
@@ -78,6 +78,48 @@ static char *sl_month_name_utc_format[] = { "Jan", "Feb", "Mar", "Apr", "May",
                                             "Jun", "Jul", "Aug", "Sep", "Oct",
                                             "Nov", "Dec" };
 
+/// Scan state below is owned by the task holding the Wi-Fi scan mutex
+
+/// Called for each access point of pending scan, NULL when no scan is pending
+static volatile sl_wifi_scan_result_handler_t sl_scan_result_handler = NULL;
+
+/// Context passed to scan result handler
+static void *volatile sl_scan_result_context = NULL;
+
+/// Set by scan callback once results of pending scan are in
+static volatile bool sl_is_scan_done = false;
+
+/// Status of pending scan reported by scan callback
+static volatile sl_status_t sl_scan_status = SL_STATUS_OK;
+
+/**************************************************************************/ /**
+ * @brief Callback function to collect scan results.
+ * @param[in] event : scan event, failure bit set on scan failure.
+ * @param[in] result : scan results.
+ * @param[in] result_length : length of result in bytes.
+ * @param[in] arg : unused.
+ * @return SL_STATUS_OK.
+ ******************************************************************************/
+static sl_status_t sl_wifi_scan_callback_handler(sl_wifi_event_t event,
+                                                 sl_wifi_scan_result_t *result,
+                                                 uint32_t result_length,
+                                                 void *arg);
+
+/**************************************************************************/ /**
+ * @brief Scan result handler which offers access points to a fingerprint.
+ * @param[in] scan_info : one scanned access point.
+ * @param[in] context : fingerprint.
+ ******************************************************************************/
+static void sl_wifi_fingerprint_scan_handler(const sl_wifi_scan_info_t *scan_info,
+                                             void *context);
+
+/**************************************************************************/ /**
+ * @brief Function to refresh the device identity after a connection. Wi-Fi
+ * messages are skipped while the identity is stale, so a failed read is
+ * retried.
+ ******************************************************************************/
+static void sl_wifi_refresh_device_identity(void);
+
 /******************************************************************************
  *  Callback function to capture Wi-Fi data at configured interval.
  *****************************************************************************/
@@ -88,7 +130,7 @@ void sl_capture_wifi_data_task()
   uint32_t task_delay = 0;
   uint32_t ka_interval = KEEP_ALIVE_INTERVAL * 1000;
   uint32_t wifi_interval = DEMO_CONFIG_WIFI_SAMPLING_INTERVAL * 1000;
-  sl_status_t ka_status = SL_STATUS_OK, wifi_status = SL_STATUS_OK;
+  sl_status_t wifi_status = SL_STATUS_OK;
   TickType_t initial_tick_count = 0, later_tick_count = 0;
   TickType_t processing_diff = 0;
 
@@ -96,7 +138,7 @@ void sl_capture_wifi_data_task()
       == sl_get_wifi_asset_tracking_status()->wifi_conn_status) {
     if (SL_STATUS_OK == sl_start_wifi_connection()) {
       /// Set Wi-Fi status flag as connected
-      sl_get_wifi_asset_tracking_status()->wifi_conn_status = SL_WIFI_CONNECTED;
+      sl_wifi_asset_tracking_set_wifi_status(SL_WIFI_CONNECTED);
 
       sl_wifi_asset_tracking_lcd_print(INDEX_WIFI_CONNECTED);
 
@@ -104,61 +146,21 @@ void sl_capture_wifi_data_task()
       next_packet_send |= WIFI_PACKET_TYPE;
       next_packet_send |= KEEP_ALIVE_PACKET_TYPE;
     } else {
-      if (SL_STATUS_OK != sl_retry_wifi_connection(true)) {
-        sl_get_wifi_asset_tracking_status()->wifi_conn_status =
-          SL_WIFI_SHUTDOWN;
-
-        if (eSuspended
-            == eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                             recovery_task_handler)) {
-          vTaskResume(
-            sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-        }
-      } else {
-        /// Set Wi-Fi status flag as connected
-        sl_get_wifi_asset_tracking_status()->wifi_conn_status =
-          SL_WIFI_CONNECTED;
-
-        sl_wifi_asset_tracking_lcd_print(INDEX_WIFI_CONNECTED);
-
-        /// Initially set Wi-Fi and keep alive packet types
-        next_packet_send |= WIFI_PACKET_TYPE;
-        next_packet_send |= KEEP_ALIVE_PACKET_TYPE;
-      }
+      /// Recovery task retries the connection with backoff
+      sl_wifi_asset_tracking_set_wifi_status(SL_WIFI_DISCONNECTED);
     }
   }
 
-  /// Here comes only if wi-fi is connected
-  if (sl_get_wifi_asset_tracking_resource()->task_list.
-      temp_rh_sensor_task_handler != NULL) {
-    printf("\r\nwifi_task: resuming temperature and RH sensor task\r\n");
-    vTaskResume(
-      sl_get_wifi_asset_tracking_resource()->task_list.temp_rh_sensor_task_handler);
-  }
-
-  if (sl_get_wifi_asset_tracking_resource()->task_list.imu_sensor_task_handler
-      != NULL) {
-    printf("\r\nwifi_task: resuming imu sensor task\r\n");
-    vTaskResume(
-      sl_get_wifi_asset_tracking_resource()->task_list.imu_sensor_task_handler);
-  }
-
-  if (sl_get_wifi_asset_tracking_resource()->task_list.
-      gnss_receiver_task_handler != NULL) {
-    printf("\r\nwifi_task: resuming gnss receiver task\r\n");
-    vTaskResume(
-      sl_get_wifi_asset_tracking_resource()->task_list.gnss_receiver_task_handler);
-  }
-
   while (1) {
     initial_tick_count = xTaskGetTickCount();
+    sl_supervisor_check_in(SL_SUPERVISOR_CLIENT_WIFI_DATA_CAPTURE);
 
     /// If wi-fi is in connected state
     if (SL_WIFI_CONNECTED
         == sl_get_wifi_asset_tracking_status()->wifi_conn_status) {
       /// if keep alive packet type is set then send keep alive packet
       if (next_packet_send & KEEP_ALIVE_PACKET_TYPE) {
-        ka_status = sl_json_send_keep_alive_message();
+        sl_json_send_keep_alive_message();
       }
 
       /// if wi-fi packet type is set then send wi-fi packet
@@ -167,34 +169,7 @@ void sl_capture_wifi_data_task()
 
         /// If failed to frame wi-fi packet then call for wi-fi recovery
         if (SL_STATUS_WIFI_CONNECTION_LOST == wifi_status) {
-          bool recovery_resume_required = false;
-
-          sl_get_wifi_asset_tracking_status()->wifi_conn_status =
-            SL_WIFI_DISCONNECTED;
-
-          /// Acquire semaphore to update the status of recovery task
-          if (pdTRUE
-              == (xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
-                                 recovery_status_mutex_handler,
-                                 portMAX_DELAY))) {
-            if (SL_RECOVERY_IDLE
-                == sl_get_wifi_asset_tracking_status()->recovery_progress_status)
-            {
-              sl_get_wifi_asset_tracking_status()->recovery_progress_status =
-                SL_RECOVERY_INPROGRESS;
-              recovery_resume_required = true;
-            }
-
-            xSemaphoreGive(
-              sl_get_wifi_asset_tracking_resource()->recovery_status_mutex_handler);
-
-            if (recovery_resume_required) {
-              printf(
-                "\r\nwifi_task : Resuming recovery task for Wi-Fi recovery\r\n");
-              vTaskResume(
-                sl_get_wifi_asset_tracking_resource()->task_list.recovery_task_handler);
-            }
-          }
+          sl_wifi_asset_tracking_set_wifi_status(SL_WIFI_DISCONNECTED);
         }
       }
 
@@ -233,17 +208,6 @@ void sl_capture_wifi_data_task()
         last_wifi_time += wifi_interval;
         next_packet_send |= WIFI_PACKET_TYPE;
       }
-
-      /// If JSON message send success to MQTT package queue then wake-up azure cloud task
-      if ((SL_STATUS_OK == ka_status) || (SL_STATUS_OK == wifi_status)) {
-        /// check whether MQTT task is suspended or not - If suspended then resume it
-        if (eSuspended
-            == (eTaskGetState(sl_get_wifi_asset_tracking_resource()->task_list.
-                              azure_cloud_communication_task_handler))) {
-          vTaskResume(
-            sl_get_wifi_asset_tracking_resource()->task_list.azure_cloud_communication_task_handler);
-        }
-      }
     }
 
     later_tick_count = xTaskGetTickCount();
@@ -280,7 +244,8 @@ void sl_capture_wifi_data_task()
     printf("\r\nwifi_task : delay is : %ld\r\n", task_delay);
 #endif /// < DEMO_CONFIG_DEBUG_LOGS
 
-    vTaskDelay(task_delay);
+    sl_supervisor_check_out(SL_SUPERVISOR_CLIENT_WIFI_DATA_CAPTURE);
+    sl_wake_planner_delay(SL_WAKE_CLIENT_WIFI_DATA_CAPTURE, task_delay);
   }
 }
 
@@ -326,8 +291,16 @@ sl_status_t sl_start_wifi_connection()
 #endif /// < DEMO_CONFIG_DEBUG_LOGS
 #endif
 
-  status = sl_net_up(SL_NET_WIFI_CLIENT_INTERFACE,
-                     SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID);
+  /// Link loss after join is reported to the link monitor
+  sl_link_monitor_init();
+
+#if DEMO_CONFIG_POWER_SAVE
+  /// Listen interval is negotiated at association
+  sl_power_save_init();
+#endif /// < DEMO_CONFIG_POWER_SAVE
+
+  /// Full join, also fills the cache for later rejoins
+  status = sl_wifi_rejoin_connect(false);
   if (status != SL_STATUS_OK) {
     printf(
       "sl_start_wifi_connection : Error while connecting to Access point: 0x%lx\r\n",
@@ -366,7 +339,11 @@ sl_status_t sl_start_wifi_connection()
     return SL_STATUS_FAIL;
   }
 
-  sl_get_wifi_asset_tracking_status()->wifi_conn_status = true;
+  sl_wifi_asset_tracking_set_wifi_status(SL_WIFI_CONNECTED);
+
+  sl_link_monitor_on_connected();
+  sl_wifi_refresh_device_identity();
+  sl_metrics_increment(SL_METRIC_WIFI_CONNECTS);
 
   return SL_STATUS_OK;
 }
@@ -647,23 +624,24 @@ static sl_status_t sl_init_rtc_calendar(sl_cal_date_time_type_t *cal_data)
 
 /******************************************************************************
  * Function will setup SNTP and fetch date and time in UTC format from
- * network and configure calendar RTC using fetched data.
+ * network without changing calendar RTC.
  ******************************************************************************/
-sl_status_t sl_set_time_and_date_using_sntp()
+sl_status_t sl_get_time_and_date_using_sntp(sl_cal_date_time_type_t *cal_data,
+                                            uint32_t *exchange_ms)
 {
   sl_status_t status;
   sl_ip_address_t address = { 0 };
   sl_sntp_client_config_t config = { 0 };
   uint8_t data[SNTP_DATA_BUFFER_LENGTH] = { 0 };
-  sl_cal_date_time_type_t cal_data;
+  TickType_t start_tick;
 
-  status = sl_net_dns_resolve_hostname(NTP_SERVER_IP,
-                                       10000,
-                                       SL_NET_DNS_TYPE_IPV4,
-                                       &address);
+  status = sl_dns_cache_resolve_hostname(NTP_SERVER_IP,
+                                         NTP_SERVER_DNS_TIMEOUT,
+                                         NTP_SERVER_DNS_REQ_COUNT,
+                                         &address);
 
   if (SL_STATUS_OK == status) {
-    printf("\r\nsl_set_time_and_date_using_sntp : IP address : %u.%u.%u.%u\r\n",
+    printf("\r\nsl_get_time_and_date_using_sntp : IP address : %u.%u.%u.%u\r\n",
            address.ip.v4.bytes[0],
            address.ip.v4.bytes[1],
            address.ip.v4.bytes[2],
@@ -676,20 +654,22 @@ sl_status_t sl_set_time_and_date_using_sntp()
     config.flags = SNTP_FLAGS;
   } else {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : Failed to resolve DNS for NTP Server: %s status:0x%lx\r\n",
+      "\r\nsl_get_time_and_date_using_sntp : Failed to resolve DNS for NTP Server: %s status:0x%lx\r\n",
       NTP_SERVER_IP,
       status);
     goto error;
   }
 
+  /// Exchange time bounds the error of the fetched time
+  start_tick = xTaskGetTickCount();
   status = sl_sntp_client_start(&config, SNTP_API_TIMEOUT);
 
   if (SL_STATUS_OK == status) {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : SNTP Client started successfully\r\n");
+      "\r\nsl_get_time_and_date_using_sntp : SNTP Client started successfully\r\n");
   } else {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : Failed to start SNTP client: 0x%lx\r\n",
+      "\r\nsl_get_time_and_date_using_sntp : Failed to start SNTP client: 0x%lx\r\n",
       status);
     goto error;
   }
@@ -697,13 +677,15 @@ sl_status_t sl_set_time_and_date_using_sntp()
   status = sl_sntp_client_get_time_date(data,
                                         SNTP_DATA_BUFFER_LENGTH,
                                         SNTP_API_TIMEOUT);
+  *exchange_ms = (uint32_t)(((xTaskGetTickCount() - start_tick)
+                             * portTICK_PERIOD_MS) / TIMER_CLOCK_OFFSET);
 
   if (SL_STATUS_OK == status) {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : SNTP Client got TIME and DATE successfully\r\n");
+      "\r\nsl_get_time_and_date_using_sntp : SNTP Client got TIME and DATE successfully\r\n");
   } else {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : Failed to get date and time from ntp server : 0x%lx \r\n",
+      "\r\nsl_get_time_and_date_using_sntp : Failed to get date and time from ntp server : 0x%lx \r\n",
       status);
     goto error;
   }
@@ -714,10 +696,10 @@ sl_status_t sl_set_time_and_date_using_sntp()
 
   if (SL_STATUS_OK == status) {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : SNTP Client stopped successfully\r\n");
+      "\r\nsl_get_time_and_date_using_sntp : SNTP Client stopped successfully\r\n");
   } else {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : Failed to stop SNTP client: 0x%lx\r\n",
+      "\r\nsl_get_time_and_date_using_sntp : Failed to stop SNTP client: 0x%lx\r\n",
       status);
     goto error;
   }
@@ -726,14 +708,54 @@ sl_status_t sl_set_time_and_date_using_sntp()
   data[strlen((const char *)data)] = '\0';
 
   /// Network time fetched successfully then convert it to calendar time format
-  status = sl_convert_ntp_to_calendar_time_format(&cal_data, (char *)data);
+  status = sl_convert_ntp_to_calendar_time_format(cal_data, (char *)data);
 
   if (SL_STATUS_OK == status) {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : Conversion of network time to calendar time is successful\r\n");
+      "\r\nsl_get_time_and_date_using_sntp : Conversion of network time to calendar time is successful\r\n");
   } else {
     printf(
-      "\r\nsl_set_time_and_date_using_sntp : Unable to convert network time to calendar time - setting default values\r\n");
+      "\r\nsl_get_time_and_date_using_sntp : Unable to convert network time to calendar time\r\n");
+    goto error;
+  }
+
+  return SL_STATUS_OK;
+  error:
+  return SL_STATUS_FAIL;
+}
+
+/******************************************************************************
+ * Function will setup SNTP and fetch date and time in UTC format from
+ * network and configure calendar RTC using fetched data.
+ ******************************************************************************/
+sl_status_t sl_set_time_and_date_using_sntp()
+{
+  sl_cal_date_time_type_t cal_data;
+  uint32_t exchange_ms = 0;
+
+  /// Calendar keeps time across reconnects, clock task resyncs it on schedule
+  if (sl_clock_is_synced()) {
+    return SL_STATUS_OK;
+  }
+
+  /// SNTP client is shared with clock task
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        clock_mutex_handler,
+                        portMAX_DELAY)) {
+    return SL_STATUS_FAIL;
+  }
+
+  if (sl_clock_is_synced()) {
+    xSemaphoreGive(
+      sl_get_wifi_asset_tracking_resource()->clock_mutex_handler);
+    return SL_STATUS_OK;
+  }
+
+  if (SL_STATUS_OK
+      != sl_get_time_and_date_using_sntp(&cal_data, &exchange_ms)) {
+    printf(
+      "\r\nsl_set_time_and_date_using_sntp : Unable to get network time - setting default values\r\n");
     goto error;
   }
 
@@ -742,8 +764,15 @@ sl_status_t sl_set_time_and_date_using_sntp()
     goto error;
   }
 
+  sl_clock_on_rtc_set(exchange_ms);
+
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->clock_mutex_handler);
+
   return SL_STATUS_OK;
   error:
+  xSemaphoreGive(
+    sl_get_wifi_asset_tracking_resource()->clock_mutex_handler);
 
   /// set default values
   cal_data.century = DEF_CAL_CENTURY;
@@ -760,8 +789,7 @@ sl_status_t sl_set_time_and_date_using_sntp()
 }
 
 /******************************************************************************
- * Function will retry for Wi-Fi connection with configured SSID for five times
- * at every five seconds.
+ * Function will bring the Wi-Fi interface down and de-initialize it.
  ******************************************************************************/
 sl_status_t sl_deinit_wifi_connection()
 {
@@ -789,75 +817,93 @@ sl_status_t sl_deinit_wifi_connection()
 }
 
 /******************************************************************************
- * Function will retry for Wi-Fi connection with configured SSID for five times
- * at every five seconds.
+ * Function will retry for Wi-Fi connection with configured SSID with
+ * exponential backoff, cached access point first.
  ******************************************************************************/
 sl_status_t sl_retry_wifi_connection(bool init)
 {
   uint8_t wifi_retry;
-  sl_status_t status;
+  uint32_t backoff;
+  sl_status_t status = SL_STATUS_FAIL;
   sl_net_wifi_client_profile_t profile = { 0 };
   sl_ip_address_t ip_address = { 0 };
   int32_t rssi;
+  TickType_t start_tick = xTaskGetTickCount();
 
 #if DEMO_CONFIG_DEBUG_LOGS
   printf("\r\nsl_retry_wifi_connection : initialization flag : %d\r\n", init);
 #endif /// < DEMO_CONFIG_DEBUG_LOGS
 
+  /// SSID is read again once joined
+  sl_device_identity_invalidate();
+
   for (wifi_retry = 0; wifi_retry < MAX_WIFI_CONN_RETRY_COUNT; ++wifi_retry) {
+    backoff = sl_wifi_rejoin_get_backoff(wifi_retry);
+    if (0 != backoff) {
+      vTaskDelay(pdMS_TO_TICKS(backoff) * TIMER_CLOCK_OFFSET);
+    }
+
     printf(
       "\r\nsl_retry_wifi_connection : retrying to establish wi-fi connection\r\n");
 
-    sl_wifi_asset_tracking_lcd_print(INDEX_WIFI_RETRY);
+    sl_wifi_asset_tracking_lcd_print_value(INDEX_WIFI_RETRY,
+                                           (int32_t)(wifi_retry + 1));
+
+    if (!init) {
+      /// Network processor may have rejoined on its own meanwhile
+      if (SL_STATUS_OK == (status = sl_get_wifi_rssi(&rssi))) {
+        break;
+      }
+
+      /// Stop rejoin of network processor before joining from here
+      sl_wifi_disconnect(SL_WIFI_CLIENT_INTERFACE);
+    }
+
+    status = sl_wifi_rejoin_connect(wifi_retry < WIFI_REJOIN_FAST_ATTEMPTS);
+    if (SL_STATUS_OK != status) {
+      continue;
+    }
+    printf("\r\nsl_retry_wifi_connection : Connected to Access point\r\n");
+
     if (init) {
-      if (SL_STATUS_OK
-          != (status =
-                sl_net_up(SL_NET_WIFI_CLIENT_INTERFACE,
-                          SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID))) {
-        vTaskDelay(pdMS_TO_TICKS(
-                     WIFI_CONN_DELAY_BETN_RETRY) * TIMER_CLOCK_OFFSET);
-        continue;
-      } else {
-        printf("\r\nsl_retry_wifi_connection : Connected to Access point\r\n");
-
-        status = sl_net_get_profile(SL_NET_WIFI_CLIENT_INTERFACE,
-                                    SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID,
-                                    &profile);
-        if (status != SL_STATUS_OK) {
-          printf(
-            "\r\nsl_retry_wifi_connection : Failed to get client profile: 0x%lx\r\n",
-            status);
-
-          sl_net_down(SL_NET_WIFI_CLIENT_INTERFACE);
-          continue;
-        }
+      status = sl_net_get_profile(SL_NET_WIFI_CLIENT_INTERFACE,
+                                  SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID,
+                                  &profile);
+      if (status != SL_STATUS_OK) {
         printf(
-          "\r\nsl_retry_wifi_connection : Getting client profile is successful\r\n");
-
-        ip_address.type = SL_IPV4;
-        memcpy(&ip_address.ip.v4.bytes,
-               &profile.ip.ip.v4.ip_address.bytes,
-               sizeof(sl_ipv4_address_t));
-        printf("\r\nsl_retry_wifi_connection : IP address is ");
-        print_sl_ip_address(&ip_address);
-        printf("\r\n");
-
-        if (SL_STATUS_OK != sl_set_time_and_date_using_sntp()) {
-          sl_net_down(SL_NET_WIFI_CLIENT_INTERFACE);
-          continue;
-        }
+          "\r\nsl_retry_wifi_connection : Failed to get client profile: 0x%lx\r\n",
+          status);
 
-        break;
+        sl_wifi_disconnect(SL_WIFI_CLIENT_INTERFACE);
+        continue;
       }
-    } else {
-      if (SL_STATUS_OK != (status = sl_get_wifi_rssi(&rssi))) {
-        vTaskDelay(pdMS_TO_TICKS(
-                     WIFI_CONN_DELAY_BETN_RETRY) * TIMER_CLOCK_OFFSET);
+      printf(
+        "\r\nsl_retry_wifi_connection : Getting client profile is successful\r\n");
+
+      ip_address.type = SL_IPV4;
+      memcpy(&ip_address.ip.v4.bytes,
+             &profile.ip.ip.v4.ip_address.bytes,
+             sizeof(sl_ipv4_address_t));
+      printf("\r\nsl_retry_wifi_connection : IP address is ");
+      print_sl_ip_address(&ip_address);
+      printf("\r\n");
+
+      if (SL_STATUS_OK != (status = sl_set_time_and_date_using_sntp())) {
+        sl_wifi_disconnect(SL_WIFI_CLIENT_INTERFACE);
         continue;
       }
-
-      break;
     }
+
+    break;
+  }
+
+  if (SL_STATUS_OK == status) {
+    sl_link_monitor_on_connected();
+    sl_wifi_refresh_device_identity();
+    sl_metrics_increment(SL_METRIC_WIFI_CONNECTS);
+    sl_wifi_rejoin_on_reconnected(
+      (uint32_t)(((xTaskGetTickCount() - start_tick) * portTICK_PERIOD_MS)
+                 / TIMER_CLOCK_OFFSET));
   }
 
   return status;
@@ -884,33 +930,184 @@ sl_status_t sl_get_wifi_rssi(int32_t *rssi)
 }
 
 /******************************************************************************
- * Function will fetch MAC address using SL_WIFI_CLIENT_INTERFACE and convert
- * into string format.
- ******************************************************************************/
-sl_status_t sl_get_wifi_mac_address(uint8_t *mac_addr)
+ *  Function will run one scan and pass each access point found to a handler.
+ *****************************************************************************/
+sl_status_t sl_scan_wifi(sl_wifi_scan_type_t scan_type,
+                         const sl_wifi_ssid_t *ssid,
+                         sl_wifi_scan_result_handler_t handler,
+                         void *context)
+{
+  sl_status_t status;
+  uint32_t wait_time = 0;
+  sl_wifi_scan_configuration_t scan_config = { 0 };
+  sl_wifi_advanced_scan_configuration_t advanced_scan_config = { 0 };
+
+  /// GNSS fallback and rejoin scans may overlap, one scan at a time
+  if (pdTRUE
+      != xSemaphoreTake(sl_get_wifi_asset_tracking_resource()->
+                        wifi_scan_mutex_handler,
+                        portMAX_DELAY)) {
+    return SL_STATUS_FAIL;
+  }
+
+  if (SL_WIFI_SCAN_TYPE_ADV_SCAN == scan_type) {
+    /// Foreground scan is refused while connected, background scan visits
+    /// other channels between beacons of the connected access point
+    advanced_scan_config.active_channel_time = WIFI_SCAN_ACTIVE_CHANNEL_TIME;
+    advanced_scan_config.passive_channel_time = WIFI_SCAN_PASSIVE_CHANNEL_TIME;
+    advanced_scan_config.enable_instant_scan = 1;
+    advanced_scan_config.enable_multi_probe = 0;
+
+    status = sl_wifi_set_advanced_scan_configuration(&advanced_scan_config);
+    if (SL_STATUS_OK != status) {
+      printf("\r\nsl_scan_wifi : Failed to configure scan: 0x%lx\r\n", status);
+      xSemaphoreGive(
+        sl_get_wifi_asset_tracking_resource()->wifi_scan_mutex_handler);
+      return SL_STATUS_FAIL;
+    }
+  }
+
+  sl_is_scan_done = false;
+  sl_scan_status = SL_STATUS_OK;
+  sl_scan_result_context = context;
+  sl_scan_result_handler = handler;
+  sl_wifi_set_scan_callback(sl_wifi_scan_callback_handler, NULL);
+
+  scan_config.type = scan_type;
+  scan_config.channel_bitmap_2g4 = WIFI_SCAN_CHANNEL_BITMAP_2G4;
+
+  status = sl_wifi_start_scan(SL_WIFI_CLIENT_2_4GHZ_INTERFACE,
+                              ssid,
+                              &scan_config);
+  if ((SL_STATUS_OK != status) && (SL_STATUS_IN_PROGRESS != status)) {
+    printf("\r\nsl_scan_wifi : Failed to start scan: 0x%lx\r\n", status);
+    status = SL_STATUS_FAIL;
+    goto error;
+  }
+
+  while ((!sl_is_scan_done) && (wait_time < WIFI_SCAN_TIMEOUT)) {
+    vTaskDelay(pdMS_TO_TICKS(WIFI_SCAN_POLL_INTERVAL) * TIMER_CLOCK_OFFSET);
+    wait_time += WIFI_SCAN_POLL_INTERVAL;
+  }
+
+  if (!sl_is_scan_done) {
+    printf("\r\nsl_scan_wifi : Scan timed out\r\n");
+    status = SL_STATUS_TIMEOUT;
+  } else if (SL_STATUS_OK != sl_scan_status) {
+    printf("\r\nsl_scan_wifi : Scan failed: 0x%lx\r\n", sl_scan_status);
+    status = SL_STATUS_FAIL;
+  } else {
+    status = SL_STATUS_OK;
+  }
+
+  error:
+  /// Late results must not reach a handler whose caller has returned
+  sl_scan_result_handler = NULL;
+  if (SL_WIFI_SCAN_TYPE_ADV_SCAN == scan_type) {
+    sl_wifi_stop_scan(SL_WIFI_CLIENT_2_4GHZ_INTERFACE);
+  }
+  sl_wifi_set_scan_callback(NULL, NULL);
+
+  xSemaphoreGive(sl_get_wifi_asset_tracking_resource()->wifi_scan_mutex_handler);
+
+  return status;
+}
+
+/******************************************************************************
+ *  Function will scan neighbouring access points without leaving the
+ *  connected access point and keep the strongest ones for positioning.
+ *****************************************************************************/
+sl_status_t sl_scan_wifi_fingerprint(sl_wifi_fingerprint_t *fingerprint)
 {
-  sl_mac_address_t mac_address;
   sl_status_t status;
 
-  status = sl_wifi_get_mac_address(SL_WIFI_CLIENT_INTERFACE, &mac_address);
+  sl_wifi_fingerprint_init(fingerprint);
+
+  status = sl_scan_wifi(SL_WIFI_SCAN_TYPE_ADV_SCAN,
+                        NULL,
+                        sl_wifi_fingerprint_scan_handler,
+                        fingerprint);
   if (SL_STATUS_OK != status) {
-    printf("\r\nsl_get_wifi_mac_address : Failed to get MAC address\r\n");
+    return status;
+  }
+
+  if (0 == fingerprint->ap_count) {
+    printf("\r\nsl_scan_wifi_fingerprint : No usable access point\r\n");
     return SL_STATUS_FAIL;
   }
 
-  snprintf((char *)mac_addr,
-           JSON_MAX_MAC_ADDR_BUFF_SIZE,
-           "%2X:%2X:%2X:%2X:%2X:%2X",
-           mac_address.octet[0],
-           mac_address.octet[1],
-           mac_address.octet[2],
-           mac_address.octet[3],
-           mac_address.octet[4],
-           mac_address.octet[5]);
+#if DEMO_CONFIG_DEBUG_LOGS
+  printf("\r\nsl_scan_wifi_fingerprint : %u access points selected\r\n",
+         fingerprint->ap_count);
+#endif /// < DEMO_CONFIG_DEBUG_LOGS
+
+  return SL_STATUS_OK;
+}
 
-  mac_addr[JSON_MAX_MAC_ADDR_BUFF_SIZE - 1] = '\0';
+/******************************************************************************
+ *  Callback function to collect scan results.
+ *****************************************************************************/
+static sl_status_t sl_wifi_scan_callback_handler(sl_wifi_event_t event,
+                                                 sl_wifi_scan_result_t *result,
+                                                 uint32_t result_length,
+                                                 void *arg)
+{
+  sl_wifi_scan_result_handler_t handler = sl_scan_result_handler;
+  uint32_t index;
 
-  printf("\r\nsl_get_wifi_mac_address : MAC address: %s\r\n", mac_addr);
+  UNUSED_PARAMETER(result_length);
+  UNUSED_PARAMETER(arg);
+
+  if (NULL == handler) {
+    return SL_STATUS_OK;
+  }
+
+  if (SL_WIFI_CHECK_IF_EVENT_FAILED(event)) {
+    sl_scan_status = (NULL != result) ? *(sl_status_t *)result : SL_STATUS_FAIL;
+  } else if (NULL != result) {
+    for (index = 0; index < result->scan_count; ++index) {
+      handler(&result->scan_info[index], sl_scan_result_context);
+    }
+  }
+
+  sl_is_scan_done = true;
 
   return SL_STATUS_OK;
 }
+
+/******************************************************************************
+ *  Scan result handler which offers access points to a fingerprint.
+ *****************************************************************************/
+static void sl_wifi_fingerprint_scan_handler(const sl_wifi_scan_info_t *scan_info,
+                                             void *context)
+{
+  /// Network processor reports RSSI as magnitude
+  sl_wifi_fingerprint_add((sl_wifi_fingerprint_t *)context,
+                          scan_info->bssid,
+                          (int8_t)(-(int)scan_info->rssi_val),
+                          scan_info->rf_channel,
+                          scan_info->ssid,
+                          strnlen((const char *)scan_info->ssid,
+                                  sizeof(scan_info->ssid)));
+}
+
+/******************************************************************************
+ *  Function to refresh the device identity after a connection.
+ *****************************************************************************/
+static void sl_wifi_refresh_device_identity(void)
+{
+  uint8_t attempt;
+
+  for (attempt = 0; attempt < DEVICE_IDENTITY_REFRESH_ATTEMPTS; attempt++) {
+    if (SL_STATUS_OK == sl_device_identity_refresh()) {
+      return;
+    }
+    vTaskDelay(pdMS_TO_TICKS(DEVICE_IDENTITY_REFRESH_RETRY_DELAY)
+               * TIMER_CLOCK_OFFSET);
+  }
+
+  /// Stays stale until the next connection refreshes it again
+  printf(
+    "\r\nsl_wifi_refresh_device_identity : device identity not available after %u attempts, Wi-Fi messages are skipped\r\n",
+    DEVICE_IDENTITY_REFRESH_ATTEMPTS);
+}
@@ -0,0 +1,323 @@
+/***************************************************************************/ /**
+ * @file sl_wifi_asset_tracking_wifi_rejoin.c
+ * @brief Wi-Fi join with cached access point and IP lease
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2023 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <sl_wifi.h>
+#include <sl_net.h>
+#include <sl_net_si91x.h>
+#include <sl_net_wifi_types.h>
+#include <sl_wifi_asset_tracking_app.h>
+#include <sl_wifi_asset_tracking_demo_config.h>
+#include <sl_wifi_asset_tracking_wifi_rejoin.h>
+
+/// @brief Structure for access point and IP lease of last join
+typedef struct {
+  bool is_valid;                  ///< BSSID and channel are known
+  bool is_lease_valid;            ///< IP lease is known
+  sl_mac_address_t bssid;         ///< Access point joined last
+  uint16_t channel;               ///< Channel of that access point
+  sl_net_ipv4_config_t lease;     ///< Address, gateway and netmask given by DHCP
+  TickType_t lease_tick;          ///< Tick of the DHCP exchange
+} sl_wifi_rejoin_cache_t;
+
+/// @brief Structure for strongest access point of the configured SSID
+typedef struct {
+  const sl_wifi_ssid_t *ssid;     ///< Configured SSID
+  bool is_found;                  ///< An access point was seen
+  uint8_t rssi_val;               ///< RSSI magnitude, lower is stronger
+  sl_mac_address_t bssid;         ///< Access point MAC address
+  uint16_t channel;               ///< Access point channel
+} sl_wifi_rejoin_candidate_t;
+
+/// Access point and lease of last join, kept in RAM only
+static sl_wifi_rejoin_cache_t sl_wifi_rejoin_cache;
+
+/// Join metrics since boot
+static sl_wifi_rejoin_metrics_t sl_wifi_rejoin_metrics;
+
+/// Names of join phases for logs
+static const char *sl_wifi_rejoin_phase_name[SL_WIFI_REJOIN_PHASE_COUNT] = {
+  "scan", "auth", "dhcp"
+};
+
+/**************************************************************************/ /**
+ * @brief Function to convert ticks elapsed since a tick count to ms.
+ * @param[in] since_tick : start tick count.
+ * @return elapsed time in ms.
+ ******************************************************************************/
+static uint32_t sl_wifi_rejoin_elapsed_ms(TickType_t since_tick);
+
+/**************************************************************************/ /**
+ * @brief Scan result handler which keeps the strongest access point of the
+ * configured SSID.
+ * @param[in] scan_info : one scanned access point.
+ * @param[in] context : candidate.
+ ******************************************************************************/
+static void sl_wifi_rejoin_scan_handler(const sl_wifi_scan_info_t *scan_info,
+                                        void *context);
+
+/**************************************************************************/ /**
+ * @brief Function to add the phase durations of a join to the metrics.
+ * @param[in] phase_ms : duration of each phase.
+ * @param[in] is_fast : join used the cached access point.
+ * @param[in] is_lease_reused : join skipped DHCP.
+ ******************************************************************************/
+static void sl_wifi_rejoin_update_metrics(const uint32_t *phase_ms,
+                                          bool is_fast,
+                                          bool is_lease_reused);
+
+/******************************************************************************
+ *  Function to join the configured access point once.
+ *****************************************************************************/
+sl_status_t sl_wifi_rejoin_connect(bool is_fast_allowed)
+{
+  sl_status_t status;
+  sl_net_wifi_client_profile_t profile = { 0 };
+  sl_wifi_rejoin_candidate_t candidate = { 0 };
+  uint32_t phase_ms[SL_WIFI_REJOIN_PHASE_COUNT] = { 0 };
+  TickType_t phase_tick;
+  bool is_fast = is_fast_allowed && sl_wifi_rejoin_cache.is_valid;
+  bool is_lease_reused = false;
+
+  status = sl_net_get_profile(SL_NET_WIFI_CLIENT_INTERFACE,
+                              SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID,
+                              &profile);
+  if (SL_STATUS_OK != status) {
+    printf(
+      "\r\nsl_wifi_rejoin_connect : Failed to get client profile: 0x%lx\r\n",
+      status);
+    goto error;
+  }
+
+  if (!is_fast) {
+    phase_tick = xTaskGetTickCount();
+    candidate.ssid = &profile.config.ssid;
+    status = sl_scan_wifi(SL_WIFI_SCAN_TYPE_ACTIVE,
+                          &profile.config.ssid,
+                          sl_wifi_rejoin_scan_handler,
+                          &candidate);
+    phase_ms[SL_WIFI_REJOIN_PHASE_SCAN] = sl_wifi_rejoin_elapsed_ms(phase_tick);
+
+    if ((SL_STATUS_OK != status) || (!candidate.is_found)) {
+      printf("\r\nsl_wifi_rejoin_connect : Access point not found\r\n");
+      goto error;
+    }
+
+    sl_wifi_rejoin_cache.bssid = candidate.bssid;
+    sl_wifi_rejoin_cache.channel = candidate.channel;
+    sl_wifi_rejoin_cache.is_valid = true;
+  }
+
+  /// Pinned BSSID and channel let the network processor skip its own scan
+  profile.config.bssid = sl_wifi_rejoin_cache.bssid;
+  profile.config.channel.channel = sl_wifi_rejoin_cache.channel;
+
+  phase_tick = xTaskGetTickCount();
+  status = sl_wifi_connect(SL_WIFI_CLIENT_INTERFACE,
+                           &profile.config,
+                           WIFI_REJOIN_JOIN_TIMEOUT);
+  phase_ms[SL_WIFI_REJOIN_PHASE_AUTH] = sl_wifi_rejoin_elapsed_ms(phase_tick);
+
+  if (SL_STATUS_OK != status) {
+    printf("\r\nsl_wifi_rejoin_connect : %s join failed: 0x%lx\r\n",
+           is_fast ? "Fast" : "Full",
+           status);
+    /// Access point moved to another channel, was replaced or refused the
+    /// authentication, next attempt scans again
+    if (is_fast) {
+      sl_wifi_rejoin_invalidate();
+    }
+    goto error;
+  }
+
+  /// Lease is reused only on the access point which it was obtained through
+  if (is_fast && sl_wifi_rejoin_cache.is_lease_valid
+      && (sl_wifi_rejoin_elapsed_ms(sl_wifi_rejoin_cache.lease_tick)
+          < (WIFI_REJOIN_LEASE_VALIDITY * 1000))) {
+    profile.ip.mode = SL_IP_MANAGEMENT_STATIC_IP;
+    profile.ip.ip.v4 = sl_wifi_rejoin_cache.lease;
+    is_lease_reused = true;
+  } else {
+    profile.ip.mode = SL_IP_MANAGEMENT_DHCP;
+  }
+  profile.ip.type = SL_IPV4;
+
+  phase_tick = xTaskGetTickCount();
+  status = sl_si91x_configure_ip_address(&profile.ip,
+                                         SL_SI91X_WIFI_CLIENT_VAP_ID);
+  phase_ms[SL_WIFI_REJOIN_PHASE_DHCP] = sl_wifi_rejoin_elapsed_ms(phase_tick);
+
+  if (SL_STATUS_OK != status) {
+    printf("\r\nsl_wifi_rejoin_connect : IP configuration failed: 0x%lx\r\n",
+           status);
+    if (is_lease_reused) {
+      sl_wifi_rejoin_cache.is_lease_valid = false;
+    }
+    sl_wifi_disconnect(SL_WIFI_CLIENT_INTERFACE);
+    goto error;
+  }
+
+  if (!is_lease_reused) {
+    sl_wifi_rejoin_cache.lease = profile.ip.ip.v4;
+    sl_wifi_rejoin_cache.lease_tick = xTaskGetTickCount();
+    sl_wifi_rejoin_cache.is_lease_valid = true;
+  }
+
+  /// Profile keeps the address for readers as after sl_net_up, but not the
+  /// pinned access point or static mode
+  memset(&profile.config.bssid, 0, sizeof(profile.config.bssid));
+  profile.config.channel.channel = 0;
+  profile.ip.mode = SL_IP_MANAGEMENT_DHCP;
+  sl_net_set_profile(SL_NET_WIFI_CLIENT_INTERFACE,
+                     SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID,
+                     &profile);
+
+  sl_wifi_rejoin_update_metrics(phase_ms, is_fast, is_lease_reused);
+
+  return SL_STATUS_OK;
+
+  error:
+  taskENTER_CRITICAL();
+  sl_wifi_rejoin_metrics.failed_attempts++;
+  taskEXIT_CRITICAL();
+  return SL_STATUS_FAIL;
+}
+
+/******************************************************************************
+ *  Function to get the delay before a join attempt.
+ *****************************************************************************/
+uint32_t sl_wifi_rejoin_get_backoff(uint8_t attempt)
+{
+  uint32_t delay = WIFI_REJOIN_BACKOFF_INITIAL;
+
+  if (0 == attempt) {
+    return 0;
+  }
+
+  while ((--attempt > 0) && (delay < WIFI_REJOIN_BACKOFF_MAX)) {
+    delay *= 2;
+  }
+
+  return (delay < WIFI_REJOIN_BACKOFF_MAX) ? delay : WIFI_REJOIN_BACKOFF_MAX;
+}
+
+/******************************************************************************
+ *  Function to record the time from start of recovery to connected.
+ *****************************************************************************/
+void sl_wifi_rejoin_on_reconnected(uint32_t reconnect_ms)
+{
+  taskENTER_CRITICAL();
+  sl_wifi_rejoin_metrics.last_reconnect_ms = reconnect_ms;
+  if (reconnect_ms > sl_wifi_rejoin_metrics.max_reconnect_ms) {
+    sl_wifi_rejoin_metrics.max_reconnect_ms = reconnect_ms;
+  }
+  taskEXIT_CRITICAL();
+
+  printf("\r\nsl_wifi_rejoin_on_reconnected : reconnected in %lu ms\r\n",
+         reconnect_ms);
+}
+
+/******************************************************************************
+ *  Function to forget the cached access point and IP lease.
+ *****************************************************************************/
+void sl_wifi_rejoin_invalidate(void)
+{
+  memset(&sl_wifi_rejoin_cache, 0, sizeof(sl_wifi_rejoin_cache));
+}
+
+/******************************************************************************
+ *  Function to read join metrics.
+ *****************************************************************************/
+void sl_wifi_rejoin_get_metrics(sl_wifi_rejoin_metrics_t *metrics)
+{
+  taskENTER_CRITICAL();
+  *metrics = sl_wifi_rejoin_metrics;
+  taskEXIT_CRITICAL();
+}
+
+/******************************************************************************
+ *  Function to convert ticks elapsed since a tick count to ms.
+ *****************************************************************************/
+static uint32_t sl_wifi_rejoin_elapsed_ms(TickType_t since_tick)
+{
+  return (uint32_t)(((xTaskGetTickCount() - since_tick) * portTICK_PERIOD_MS)
+                    / TIMER_CLOCK_OFFSET);
+}
+
+/******************************************************************************
+ *  Scan result handler which keeps the strongest access point of the
+ *  configured SSID.
+ *****************************************************************************/
+static void sl_wifi_rejoin_scan_handler(const sl_wifi_scan_info_t *scan_info,
+                                        void *context)
+{
+  sl_wifi_rejoin_candidate_t *candidate = (sl_wifi_rejoin_candidate_t *)context;
+
+  if ((strnlen((const char *)scan_info->ssid, sizeof(scan_info->ssid))
+       != candidate->ssid->length)
+      || (0 != memcmp(scan_info->ssid,
+                      candidate->ssid->value,
+                      candidate->ssid->length))) {
+    return;
+  }
+
+  if ((!candidate->is_found) || (scan_info->rssi_val < candidate->rssi_val)) {
+    candidate->is_found = true;
+    candidate->rssi_val = scan_info->rssi_val;
+    memcpy(candidate->bssid.octet,
+           scan_info->bssid,
+           sizeof(candidate->bssid.octet));
+    candidate->channel = scan_info->rf_channel;
+  }
+}
+
+/******************************************************************************
+ *  Function to add the phase durations of a join to the metrics.
+ *****************************************************************************/
+static void sl_wifi_rejoin_update_metrics(const uint32_t *phase_ms,
+                                          bool is_fast,
+                                          bool is_lease_reused)
+{
+  uint8_t phase;
+
+  taskENTER_CRITICAL();
+  if (is_fast) {
+    sl_wifi_rejoin_metrics.fast_joins++;
+  } else {
+    sl_wifi_rejoin_metrics.full_joins++;
+  }
+  if (is_lease_reused) {
+    sl_wifi_rejoin_metrics.lease_reuses++;
+  }
+  for (phase = 0; phase < SL_WIFI_REJOIN_PHASE_COUNT; ++phase) {
+    sl_wifi_rejoin_metrics.last_phase_ms[phase] = phase_ms[phase];
+    if (phase_ms[phase] > sl_wifi_rejoin_metrics.max_phase_ms[phase]) {
+      sl_wifi_rejoin_metrics.max_phase_ms[phase] = phase_ms[phase];
+    }
+  }
+  taskEXIT_CRITICAL();
+
+  printf("\r\nsl_wifi_rejoin_connect : %s join, %s %lu ms, %s %lu ms, %s %lu ms%s\r\n",
+         is_fast ? "fast" : "full",
+         sl_wifi_rejoin_phase_name[SL_WIFI_REJOIN_PHASE_SCAN],
+         phase_ms[SL_WIFI_REJOIN_PHASE_SCAN],
+         sl_wifi_rejoin_phase_name[SL_WIFI_REJOIN_PHASE_AUTH],
+         phase_ms[SL_WIFI_REJOIN_PHASE_AUTH],
+         sl_wifi_rejoin_phase_name[SL_WIFI_REJOIN_PHASE_DHCP],
+         phase_ms[SL_WIFI_REJOIN_PHASE_DHCP],
+         is_lease_reused ? " (cached lease)" : "");
+}